@@ -1,94 +1,247 @@
 #include <Windows.h>
+#include <atomic>
 #include <string>
-#include <fstream>
-#include <filesystem>
+#include <memory>
+#include <new>
+#include <optional>
+#include <format>
 #include <hook/hook_manager.hpp>
 #include <hook/hook_factory.hpp>
+#include <hook/hot_reload.hpp>
+#include <config/mod_bundle.hpp>
+#include <context/mod_context.hpp>
 #include <util/logger.hpp>
+#include <util/startup_trace.hpp>
+#include <util/injector_handoff.hpp>
+#include <util/metrics_publisher.hpp>
 #include <plugin/plugin_manager.hpp>
+#ifdef APP_HOOK_STATIC_MEMORY_PLUGIN
+#include "../../memory_plugin/include/memory_plugin.hpp"
+#endif
+
+// Set in DLL_PROCESS_DETACH when the whole process is exiting, before the
+// CRT runs the destructors of the globals
+bool g_process_exiting = false;
+
+// This DLL, and the extra reference that keeps it loaded until AppHookUnload
+HMODULE g_module = nullptr;
+HMODULE g_self_reference = nullptr;
+
+// Set by AppHookUnload once every thread is stopped and the hooks are undone
+bool g_torn_down = false;
+
+/**
+ * @brief Global object that is not destroyed when the process exits
+ *
+ * An exiting process has already stopped every other thread and is about to
+ * unmap its memory: waiting for worker threads, undoing patches and freeing
+ * each task would only slow the exit down (or wait forever on a thread that is
+ * gone). The object is destroyed normally when the DLL is unloaded from a
+ * process that keeps running.
+ */
+template <typename T>
+class ExitSkipped {
+public:
+    ExitSkipped() { ::new (static_cast<void*>(storage_)) T(); }
+    
+    ~ExitSkipped() {
+        if (!g_process_exiting) {
+            get().~T();
+        }
+    }
+    
+    ExitSkipped(const ExitSkipped&) = delete;
+    ExitSkipped& operator=(const ExitSkipped&) = delete;
+    
+    T& get() noexcept { return *std::launder(reinterpret_cast<T*>(storage_)); }
+    
+private:
+    alignas(T) unsigned char storage_[sizeof(T)];
+};
 
 // Global hook manager
-app_hook::hook::HookManager g_hook_manager;
+ExitSkipped<app_hook::hook::HookManager> g_hook_manager_storage;
+app_hook::hook::HookManager& g_hook_manager = g_hook_manager_storage.get();
 
 // Global plugin manager
-app_hook::plugin::PluginManager g_plugin_manager;
+ExitSkipped<app_hook::plugin::PluginManager> g_plugin_manager_storage;
+app_hook::plugin::PluginManager& g_plugin_manager = g_plugin_manager_storage.get();
+
+// Applies config and binary edits live when the injector asks for hot reload
+std::unique_ptr<app_hook::hook::HotReloader> g_hot_reloader;
+
+// Publishes hook, task, memory and plugin counters for app_injector --stats
+ExitSkipped<app_hook::util::MetricsPublisher> g_metrics_publisher_storage;
+app_hook::util::MetricsPublisher& g_metrics_publisher = g_metrics_publisher_storage.get();
+
+// Logging runs on a background writer so hooked calls never wait on disk I/O
+const app_hook::util::LoggingOptions g_logging_options{
+    .async = true,
+    .queue_capacity = 8192,
+    .overflow = app_hook::util::LogOverflowPolicy::drop,
+    .flush_interval = std::chrono::milliseconds(250)
+};
+
+// Startup timeline, written next to the log once InstallHooks is done
+constexpr const char* kStartupTracePath = "logs/startup_trace.json";
 
 /**
- * @brief Read configuration from injector config file
- * @param configDir [out] Configuration directory path
- * @param pluginDir [out] Plugin directory path
- * @return true if config file was read successfully, false otherwise
+ * @brief Writes the startup trace once, on whichever path InstallHooks leaves
  */
-bool ReadInjectorConfig(std::string& configDir, std::string& pluginDir) {
-    try {
-        // Look for config file in temp directory
-        std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "ffscript_loader";
-        std::filesystem::path configFile = tempDir / "injector_config.txt";
-        
-        if (!std::filesystem::exists(configFile)) {
-            return false;
+class StartupTraceWriter {
+public:
+    ~StartupTraceWriter() {
+        write();
+    }
+    
+    /**
+     * @brief Stop recording and write the trace file
+     */
+    void write() {
+        if (written_) {
+            return;
         }
+        written_ = true;
         
-        std::ifstream inFile(configFile);
-        if (!inFile.is_open()) {
-            return false;
+        auto& trace = app_hook::util::StartupTrace::instance();
+        trace.set_enabled(false);  // Hooks added later are not part of startup
+        if (trace.write_chrome_trace(kStartupTracePath)) {
+            LOG_INFO("Startup trace written to {} ({} span(s))", kStartupTracePath, trace.events().size());
+        } else {
+            LOG_WARNING("Failed to write startup trace to {}", kStartupTracePath);
         }
-        
-        std::string line;
-        while (std::getline(inFile, line)) {
-            size_t equalPos = line.find('=');
-            if (equalPos != std::string::npos) {
-                std::string key = line.substr(0, equalPos);
-                std::string value = line.substr(equalPos + 1);
-                
-                if (key == "config_dir") {
-                    configDir = value;
-                } else if (key == "plugin_dir") {
-                    pluginDir = value;
-                }
-            }
+    }
+    
+private:
+    bool written_ = false;
+};
+
+/**
+ * @brief Get the name of the event set once the hooks are installed
+ * @return Event name (must match HooksReadyEventName in the injector)
+ */
+std::string HooksReadyEventName() {
+    return std::format("Local\\app_hook_ready_{}", GetCurrentProcessId());
+}
+
+/**
+ * @brief Releases an injector started with --launch, which holds the game suspended until then
+ * @note Set on failure too, so the game still starts; without --launch there is no event
+ */
+class HooksReadySignal {
+public:
+    ~HooksReadySignal() {
+        signal();
+    }
+    
+    /**
+     * @brief Set the event once
+     */
+    void signal() {
+        if (signaled_) {
+            return;
         }
+        signaled_ = true;
         
-        return true;
-    }
-    catch (const std::exception& e) {
-        return false;
+        if (HANDLE event = OpenEventA(EVENT_MODIFY_STATE, FALSE, HooksReadyEventName().c_str())) {
+            SetEvent(event);
+            CloseHandle(event);
+            LOG_INFO("Signaled the injector that startup is done");
+        }
     }
-}
+    
+private:
+    bool signaled_ = false;
+};
+
+// Settings from the injector, copied in DllMain before the install thread starts
+std::optional<app_hook::util::InjectorHandoff> g_handoff;
 
 /**
- * @brief Get configuration directory from injector config or use default
- * @return Configuration directory path
+ * @brief Copy the settings the injector shared for this process
+ * @return Settings, or std::nullopt if the DLL was not loaded by the injector
+ * @note Safe in DllMain: only kernel32 calls, no library loads
  */
-std::string GetConfigDirectory() {
-    std::string configDir, pluginDir;
-    if (ReadInjectorConfig(configDir, pluginDir) && !configDir.empty()) {
-        return configDir;
-    } else {
-        // Fall back to default
-        return "config";
+std::optional<app_hook::util::InjectorHandoff> ReadInjectorHandoff() {
+    const std::string name = app_hook::util::handoff_mapping_name(GetCurrentProcessId());
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+    if (!mapping) {
+        return std::nullopt;
+    }
+    
+    std::optional<app_hook::util::InjectorHandoff> handoff;
+    if (const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+        MEMORY_BASIC_INFORMATION info{};
+        const SIZE_T size = VirtualQuery(view, &info, sizeof(info)) == sizeof(info) ? info.RegionSize : 0;
+        if (auto decoded = app_hook::util::decode_handoff({static_cast<const std::uint8_t*>(view), size})) {
+            handoff = std::move(*decoded);
+        }
+        UnmapViewOfFile(view);
     }
+    CloseHandle(mapping);
+    return handoff;
 }
 
 /**
- * @brief Get plugin directory from injector config or use default
- * @return Plugin directory path
+ * @brief Start publishing live metrics into the shared-memory block of this process
+ * @note Plugins do not change after startup, so their state is captured once
  */
-std::string GetPluginDirectory() {
-    std::string configDir, pluginDir;
-    if (ReadInjectorConfig(configDir, pluginDir) && !pluginDir.empty()) {
-        return pluginDir;
-    } else {
-        // Fall back to default
-        return "tasks";
+void StartMetricsPublisher() {
+    using namespace app_hook::util;
+    if (!g_metrics_publisher.open(metrics_mapping_name(GetCurrentProcessId()))) {
+        return;
     }
+    
+    std::vector<PluginMetrics> plugins;
+    for (const auto& name : g_plugin_manager.get_loaded_plugin_names()) {
+        auto& plugin = plugins.emplace_back();
+        plugin.loaded = 1;
+        copy_metrics_name(plugin.name, name);
+    }
+    for (const auto& manifest : g_plugin_manager.skipped_plugins()) {
+        copy_metrics_name(plugins.emplace_back().name, manifest.name);
+    }
+    
+    g_metrics_publisher.start([plugins = std::move(plugins)](MetricsFrame& frame) {
+        for (const auto& hook : g_hook_manager.stats()) {
+            const auto address = static_cast<std::uint32_t>(hook.address);
+            frame.hooks.push_back({address, static_cast<std::uint32_t>(hook.tasks.size()), hook.timing.calls,
+                                   hook.timing.total_ns, hook.timing.max_ns, hook.timing.failures});
+            for (const auto& task : hook.tasks) {
+                auto& metrics = frame.tasks.emplace_back();
+                metrics.hook_address = address;
+                metrics.calls = task.timing.calls;
+                metrics.total_ns = task.timing.total_ns;
+                metrics.max_ns = task.timing.max_ns;
+                metrics.failures = task.timing.failures;
+                copy_metrics_name(metrics.name, task.name);
+            }
+        }
+        for (const auto& entry : g_plugin_manager.memory_report().entries) {
+            auto& metrics = frame.memory.emplace_back();
+            metrics.count = entry.count;
+            metrics.bytes = entry.bytes;
+            metrics.committed_bytes = entry.committed_bytes;
+            metrics.reserved_bytes = entry.reserved_bytes;
+            copy_metrics_name(metrics.category, entry.category);
+        }
+        frame.plugins = plugins;
+    });
 }
 
 void InstallHooks() {
+    using app_hook::util::TraceScope;
+    StartupTraceWriter trace_writer;
+    HooksReadySignal ready_signal;
+    app_hook::util::StartupTrace::instance().mark("install_thread_started", "startup");
+    
     // Initialize logging first
-    if (!app_hook::util::initialize_logging("logs/app_hook.log", 1)) {  // 1 = debug level
-        MessageBoxA(NULL, "Failed to initialize logging system", "Logger Error", MB_OK);
-        return;
+    {
+        TraceScope trace("initialize_logging", "startup");
+        if (!app_hook::util::initialize_logging("logs/app_hook.log", 1, g_logging_options)) {  // 1 = debug level
+            MessageBoxA(NULL, "Failed to initialize logging system", "Logger Error", MB_OK);
+            return;
+        }
     }
     
     LOG_INFO("================================");
@@ -99,18 +252,18 @@ void InstallHooks() {
     
     LOG_INFO("Initializing hook system...");
     
-    // Get configuration paths from injector config file or defaults
-    const std::string config_dir = GetConfigDirectory();
-    const std::string plugin_dir = GetPluginDirectory();
-    
-    // Check if configuration was loaded from injector
-    std::string injectorConfigDir, injectorPluginDir;
-    bool configFromInjector = ReadInjectorConfig(injectorConfigDir, injectorPluginDir);
+    // Get configuration paths from the injector or defaults
+    const bool configFromInjector = g_handoff.has_value();
+    const std::string config_dir = configFromInjector && !g_handoff->config_dir.empty() ? g_handoff->config_dir : "config";
+    const std::string plugin_dir = configFromInjector && !g_handoff->plugin_dir.empty() ? g_handoff->plugin_dir : "tasks";
     
     if (configFromInjector) {
         LOG_INFO("Configuration loaded from injector:");
         LOG_INFO("  Config directory: {} (from injector)", config_dir);
         LOG_INFO("  Plugin directory: {} (from injector)", plugin_dir);
+        LOG_INFO("  Hot reload: {}", g_handoff->hot_reload ? "enabled" : "disabled");
+        LOG_INFO("  Pack bundle: {}", g_handoff->pack_bundle ? "yes" : "no");
+        LOG_INFO("  Trigger trace: {}", g_handoff->trace_path.empty() ? "off" : g_handoff->trace_path);
     } else {
         LOG_INFO("Using default configuration (no injector config found):");
         LOG_INFO("  Config directory: {} (default)", config_dir);
@@ -127,6 +280,7 @@ void InstallHooks() {
     
     try {
         LOG_INFO("About to initialize plugin manager...");
+        TraceScope trace("initialize_plugin_manager", "startup");
         if (auto result = g_plugin_manager.initialize("data", std::move(config_registry)); result != app_hook::plugin::PluginResult::Success) {
             LOG_ERROR("Failed to initialize plugin manager with result: {}", static_cast<int>(result));
             MessageBoxA(NULL, "Failed to initialize plugin manager\nCheck logs/app_hook.log for details", "Plugin Error", MB_OK);
@@ -145,14 +299,41 @@ void InstallHooks() {
         return;
     }
     
-    // Load plugins from tasks directory
+    // Let plugins query hook timing statistics
+    g_plugin_manager.set_hook_stats_provider([] { return g_hook_manager.stats(); });
+    
+    // Stubs, trampolines and task configs show up in the memory footprint report
+    g_plugin_manager.add_memory_source("hooks", [] { return g_hook_manager.memory_usage(); });
+    
+    // A packed mod replaces the loose files; packing reads the loose files to rebuild it
+    const bool pack_bundle = configFromInjector && g_handoff->pack_bundle;
+    std::shared_ptr<const app_hook::config::ModBundle> bundle;
+    if (!pack_bundle) {
+        TraceScope trace("open_bundle", "startup", config_dir);
+        if (auto opened = app_hook::config::ModBundle::open(config_dir)) {
+            bundle = std::move(*opened);
+            g_plugin_manager.set_bundle(bundle);
+        }
+    }
+    
+#ifdef APP_HOOK_STATIC_MEMORY_PLUGIN
+    // Linked in: added ahead of the DLLs so a leftover memory_plugin.dll is not loaded twice
+    if (auto result = g_plugin_manager.add_builtin_plugin(memory_plugin::create_builtin_plugin());
+        result != app_hook::plugin::PluginResult::Success) {
+        LOG_ERROR("Failed to add the built-in memory plugin: {}", app_hook::plugin::to_string(result));
+    }
+#endif
+    
+    // Load the plugins the enabled tasks need; plugin manifests are read before any DLL
+    const std::string tasks_config_path = config_dir + "/tasks.toml";
     LOG_INFO("Loading plugins from directory: {}/", plugin_dir);
     std::size_t loaded_plugins = 0;
     
     try {
-        LOG_INFO("About to call load_plugins_from_directory...");
-        loaded_plugins = g_plugin_manager.load_plugins_from_directory(plugin_dir);
-        LOG_INFO("load_plugins_from_directory returned: {}", loaded_plugins);
+        LOG_INFO("About to call load_plugins_for_tasks...");
+        TraceScope trace("load_plugins", "startup", plugin_dir);
+        loaded_plugins = g_plugin_manager.load_plugins_for_tasks(plugin_dir, tasks_config_path);
+        LOG_INFO("load_plugins_for_tasks returned: {}", loaded_plugins);
     }
     catch (const std::exception& e) {
         LOG_ERROR("Exception during plugin loading: {}", e.what());
@@ -165,11 +346,13 @@ void InstallHooks() {
         return;
     }
     
-    LOG_INFO("Loaded {} plugin(s) successfully", loaded_plugins);
+    LOG_INFO("Loaded {} plugin(s) successfully, skipped {} unused", loaded_plugins,
+             g_plugin_manager.skipped_plugins().size());
     
     // Initialize plugins with configuration
     LOG_INFO("About to initialize plugins with configuration...");
     try {
+        TraceScope trace("initialize_plugins", "startup", config_dir);
         if (auto result = g_plugin_manager.initialize_plugins(config_dir); result != app_hook::plugin::PluginResult::Success) {
             LOG_ERROR("Failed to initialize plugins with result: {}", static_cast<int>(result));
             MessageBoxA(NULL, "Failed to initialize plugins\nCheck logs/app_hook.log for details", "Plugin Error", MB_OK);
@@ -189,12 +372,16 @@ void InstallHooks() {
     }
     
     // Load configuration and create hooks
-    const std::string tasks_config_path = config_dir + "/tasks.toml";
     LOG_INFO("Loading tasks configuration from: {}", tasks_config_path);
     
     try {
         LOG_INFO("About to create hooks from configuration...");
-        if (auto result = app_hook::hook::HookFactory::create_hooks_from_tasks(tasks_config_path, g_hook_manager); !result) {
+        TraceScope trace("create_hooks", "startup", tasks_config_path);
+        if (configFromInjector && g_handoff->hot_reload) {
+            g_hot_reloader = std::make_unique<app_hook::hook::HotReloader>(tasks_config_path);
+        }
+        if (auto result = app_hook::hook::HookFactory::create_hooks_from_tasks(
+                tasks_config_path, g_hook_manager, g_hot_reloader.get(), bundle, pack_bundle); !result) {
             LOG_ERROR("Failed to create hooks from configuration");
             MessageBoxA(NULL, "Failed to create hooks from configuration\nCheck logs/app_hook.log for details", "Config Error", MB_OK);
             return;
@@ -218,7 +405,8 @@ void InstallHooks() {
     // Install all hooks
     LOG_INFO("Installing hooks...");
     try {
-        if (auto result = g_hook_manager.install_all(); !result) {
+        TraceScope trace("install_hooks", "startup");
+        if (auto result = g_hook_manager.install_all(app_hook::hook::InstallMode::batched); !result) {
             LOG_ERROR("Failed to install hooks");
             MessageBoxA(NULL, "Failed to install hooks\nCheck logs/app_hook.log for details", "Hook Error", MB_OK);
             return;
@@ -241,6 +429,31 @@ void InstallHooks() {
     
     LOG_INFO("Successfully installed {} hook(s) with {} task(s)", hook_count, task_count);
     
+    // Tasks keep only what they run with; a hot reload brings complete configs again
+    const auto released = g_hook_manager.compact();
+    LOG_INFO("Released {} byte(s) of task configuration", released);
+    
+    StartMetricsPublisher();
+    
+    if (configFromInjector && !g_handoff->trace_path.empty()) {
+        g_hook_manager.recorder().start();
+    }
+    
+    // Watch only once the hooks exist: a reload updates the installed tasks
+    if (g_hot_reloader && !g_hot_reloader->start()) {
+        g_hot_reloader.reset();
+    }
+    
+    // The origin is DLL_PROCESS_ATTACH, so this span is the whole critical path
+    auto& startup_trace = app_hook::util::StartupTrace::instance();
+    const auto hooks_active_us = startup_trace.now_us();
+    startup_trace.record({"injection_to_hooks_active", "startup", {}, 0, hooks_active_us,
+                          static_cast<std::uint32_t>(GetCurrentThreadId())});
+    startup_trace.mark("hooks_active", "startup");
+    LOG_INFO("Hooks active {:.1f} ms after injection", hooks_active_us / 1000.0);
+    trace_writer.write();  // Before the message box, which blocks until dismissed
+    ready_signal.signal();
+    
     const std::string success_msg = "Hooks installed successfully!\n" +
                                   std::to_string(hook_count) + " hook(s) with " +
                                   std::to_string(task_count) + " task(s)\n\n" +
@@ -251,9 +464,34 @@ void InstallHooks() {
 }
 
 void UninstallHooks() {
+    // Taken before anything is released so the totals show what the game carried
+    try {
+        app_hook::util::log_memory_report(g_plugin_manager.memory_report());
+    }
+    catch (const std::exception& e) {
+        LOG_WARNING("Failed to collect the memory report: {}", e.what());
+    }
+    
+    // The publisher reads the hooks, so it stops before they go
+    g_metrics_publisher.stop();
+    
+    // The reloader points into the hooks' tasks, so it goes first
+    if (g_hot_reloader) {
+        g_hot_reloader->stop();
+        g_hot_reloader.reset();
+    }
+    
+    // Written while the hook table still exists; the game thread may be mid-call at worst
+    if (g_hook_manager.recorder().recording()) {
+        (void)g_hook_manager.write_trace(g_handoff->trace_path);
+    }
+    
     LOG_INFO("Uninstalling hooks...");
     g_hook_manager.uninstall_all();
     
+    // Its destructor runs under the loader lock, where the workers cannot be joined
+    g_hook_manager.worker_pool().stop();
+    
     // Unload plugins
     LOG_INFO("Unloading plugins...");
     g_plugin_manager.unload_all_plugins();
@@ -264,18 +502,98 @@ void UninstallHooks() {
     app_hook::util::shutdown_logging();
 }
 
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID) {
+/**
+ * @brief Let go of everything when the process is exiting
+ * @note Only the outputs asked for are written (trigger trace, call profile) and
+ *       the log queue is flushed; hooks, plugins and mod context regions are left
+ *       to the OS instead of being undone and freed one by one. The memory report
+ *       UninstallHooks logs is not written either: its plugin sources take locks
+ *       that a thread stopped by the exit may hold.
+ */
+void DetachFromExitingProcess() {
+    g_process_exiting = true;
+    
+    // Its watcher thread is gone; the reloader is left with the rest
+    (void)g_hot_reloader.release();
+    
+    if (g_hook_manager.recorder().recording()) {
+        (void)g_hook_manager.write_trace(g_handoff->trace_path);
+    }
+    
+    // Modules detaching after this one may still call hooked code, whose tasks
+    // would reach the context and logger being destroyed
+    const bool disabled = g_hook_manager.disable_for_exit();
+    app_hook::context::ModContext::instance().skip_teardown();
+    LOG_INFO("DLL_PROCESS_DETACH - process exiting ({}), teardown and memory report skipped",
+             disabled ? "hooks disabled" : "no hook enabled");
+    
+    app_hook::util::flush_logging_at_exit();
+}
+
+/**
+ * @brief Undo the hooks and unload the DLL from a process that keeps running
+ * @param parameter Unused
+ * @return 1 if an unload is already running; otherwise does not return
+ * @note Started by app_injector --unload. Threads are joined and hooks undone
+ *       here rather than in DllMain, which runs under the loader lock.
+ */
+extern "C" __declspec(dllexport) DWORD WINAPI AppHookUnload(LPVOID /*parameter*/) {
+    static std::atomic<bool> unloading{false};
+    if (unloading.exchange(true)) {
+        return 1;
+    }
+    
+    LOG_INFO("AppHookUnload - unloading DLL from process");
+    try {
+        UninstallHooks();
+    }
+    catch (const std::exception& e) {
+        LOG_ERROR("Exception during unload: {}", e.what());
+    }
+    catch (...) {
+        LOG_ERROR("Unknown exception during unload");
+    }
+    g_torn_down = true;
+    
+    // Drop our own reference, then the injector's, and leave without returning into the DLL
+    if (g_self_reference) {
+        FreeLibrary(g_self_reference);
+    }
+    FreeLibraryAndExitThread(g_module, 0);
+}
+
+// The injector looks the export up by its plain name; stdcall would decorate it
+#if defined(_M_IX86)
+#pragma comment(linker, "/EXPORT:AppHookUnload=_AppHookUnload@4")
+#endif
+
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID reserved) {
     switch (reason) {
         case DLL_PROCESS_ATTACH: {
             try {
+                // Start of the startup timeline
+                app_hook::util::StartupTrace::instance().reset();
+                
+                // The injector closes the shared block once LoadLibrary returns
+                g_handoff = ReadInjectorHandoff();
+                
                 // Quick logging initialization for DllMain logging
-                app_hook::util::initialize_logging("logs/app_hook.log", 1);  // 1 = debug level
+                app_hook::util::initialize_logging("logs/app_hook.log", 1, g_logging_options);  // 1 = debug level
                 
                 LOG_INFO("DLL_PROCESS_ATTACH - DLL loaded into process");
                 LOG_INFO("Module handle: 0x{:X}", reinterpret_cast<uintptr_t>(hModule));
                 
                 DisableThreadLibraryCalls(hModule);
                 
+                // A stray FreeLibrary would otherwise unload the DLL under the loader
+                // lock with its threads running; AppHookUnload (app_injector --unload)
+                // gives the reference back
+                g_module = hModule;
+                if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS,
+                                        reinterpret_cast<LPCWSTR>(&DllMain), &g_self_reference)) {
+                    LOG_WARNING("Failed to pin the DLL, error: {}", GetLastError());
+                }
+                
                 LOG_INFO("About to create InstallHooks thread...");
                 HANDLE thread = CreateThread(nullptr, 0, (LPTHREAD_START_ROUTINE)InstallHooks, nullptr, 0, nullptr);
                 if (thread == NULL) {
@@ -300,8 +618,19 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD reason, LPVOID) {
             
         case DLL_PROCESS_DETACH:
             try {
-                LOG_INFO("DLL_PROCESS_DETACH - DLL being unloaded from process");
-                UninstallHooks();
+                // Non-null when the process is terminating rather than unloading the DLL
+                if (reserved != nullptr) {
+                    DetachFromExitingProcess();
+                    break;
+                }
+                if (g_torn_down) {
+                    break;  // AppHookUnload already did the work
+                }
+                // Only an unbalanced FreeLibrary gets here, the DLL holds a reference to
+                // itself. The threads cannot be joined under the loader lock, so nothing
+                // is undone; use app_injector --unload for a full teardown
+                LOG_WARNING("DLL_PROCESS_DETACH - unloaded without AppHookUnload, teardown skipped");
+                DetachFromExitingProcess();
             }
             catch (const std::exception& e) {
                 // Log the error but don't show message box during shutdown
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include "hook/hook_manager.hpp"
+#include <memory>
+
+namespace app_hook::hook {
+
+namespace {
+
+// Task doing nothing but being called through the vtable
+class EmptyTask : public task::IHookTask {
+public:
+    task::TaskResult execute() override { return {}; }
+    std::string name() const override { return "empty"; }
+    std::string description() const override { return "Empty task"; }
+};
+
+// Final task called through a direct thunk
+class DirectEmptyTask final : public task::IHookTask {
+public:
+    task::TaskResult execute() override { return {}; }
+    task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    std::string name() const override { return "direct"; }
+    std::string description() const override { return "Direct empty task"; }
+};
+
+template<typename Task>
+std::unique_ptr<Hook> make_hook(std::int64_t tasks, int& trampoline_target) {
+    auto hook = std::make_unique<Hook>(0x401000);
+    for (std::int64_t i = 0; i < tasks; ++i) {
+        hook->add_task(std::make_unique<Task>());
+    }
+    hook->set_trampoline(&trampoline_target);
+    return hook;
+}
+
+} // namespace
+
+/// Full detour path: run the task program and hand back the trampoline
+template<typename Task>
+void BM_DispatchHook(benchmark::State& state) {
+    int trampoline_target = 0;
+    auto hook = make_hook<Task>(state.range(0), trampoline_target);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(dispatch_hook(hook.get()));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_DispatchHook<EmptyTask>)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK(BM_DispatchHook<DirectEmptyTask>)->RangeMultiplier(4)->Range(1, 256);
+
+void BM_ExecuteTasks(benchmark::State& state) {
+    int trampoline_target = 0;
+    auto hook = make_hook<EmptyTask>(state.range(0), trampoline_target);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(hook->execute_tasks());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ExecuteTasks)->RangeMultiplier(4)->Range(1, 256);
+
+} // namespace app_hook::hook
@@ -0,0 +1,56 @@
+#include <benchmark/benchmark.h>
+#include "bench_support.hpp"
+#include "memory/copy_memory.hpp"
+#include "memory/load_in_memory.hpp"
+#include "memory/memory_region.hpp"
+#include "context/mod_context.hpp"
+#include <vector>
+
+namespace app_hook::memory {
+
+/// Copy of a region into the arena; the block is reused after the first run
+void BM_CopyMemory(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    std::vector<std::uint8_t> source(size, 0x5A);
+    
+    CopyMemoryConfig config("bench_copy_" + std::to_string(size), "Benchmark copy");
+    config.set_address(reinterpret_cast<std::uintptr_t>(source.data()));
+    config.set_copy_after(0x401000);
+    config.set_original_size(size);
+    config.set_new_size(size * 2);
+    config.set_write_in_context({true, "bench.copy.region"});
+    CopyMemoryTask task(std::move(config));
+    for (auto _ : state) {
+        if (!task.execute()) {
+            state.SkipWithError("region was not copied");
+            break;
+        }
+    }
+    (void)context::ModContext::instance().remove_data("bench.copy.region");
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_CopyMemory)->RangeMultiplier(16)->Range(256, 16 << 20)->Unit(benchmark::kMicrosecond);
+
+/// Binary read from disk into a region
+void BM_LoadInMemory(benchmark::State& state) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    bench::TempFile binary("bench_load_" + std::to_string(size) + ".bin", std::string(size, '\x5A'));
+    auto& context = context::ModContext::instance();
+    context.store_data("bench.load.region", MemoryRegion(size * 2, size, 0x401000, "Benchmark load region"));
+    
+    LoadInMemoryConfig config("bench_load_" + std::to_string(size), "Benchmark load");
+    config.set_binary_path(binary.path());
+    config.set_read_from_context("bench.load.region");
+    LoadInMemoryTask task(std::move(config));
+    for (auto _ : state) {
+        if (!task.execute()) {
+            state.SkipWithError("binary was not loaded");
+            break;
+        }
+    }
+    (void)context.remove_data("bench.load.region");
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadInMemory)->RangeMultiplier(16)->Range(256, 16 << 20)->Unit(benchmark::kMicrosecond);
+
+} // namespace app_hook::memory
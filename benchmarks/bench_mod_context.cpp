@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include "context/mod_context.hpp"
+#include <string>
+#include <vector>
+
+namespace app_hook::context {
+
+namespace {
+
+constexpr int kKeys = 64;
+
+/// @brief Context shared by the threads of a benchmark, filled once
+ModContext& shared_context() {
+    static ModContext context;
+    static const bool filled = [] {
+        for (int i = 0; i < kKeys; ++i) {
+            context.store_data("bench.key." + std::to_string(i), i);
+        }
+        return true;
+    }();
+    (void)filled;
+    return context;
+}
+
+std::vector<std::string> key_names() {
+    std::vector<std::string> keys;
+    for (int i = 0; i < kKeys; ++i) {
+        keys.push_back("bench.key." + std::to_string(i));
+    }
+    return keys;
+}
+
+} // namespace
+
+void BM_GetDataByName(benchmark::State& state) {
+    auto& context = shared_context();
+    const auto keys = key_names();
+    std::size_t i = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.get_data<int>(keys[i++ % keys.size()]));
+    }
+}
+BENCHMARK(BM_GetDataByName)->ThreadRange(1, 8)->UseRealTime();
+
+void BM_GetInternedKey(benchmark::State& state) {
+    auto& context = shared_context();
+    std::vector<ContextKey> keys;
+    for (const auto& name : key_names()) {
+        keys.push_back(context.intern(name));
+    }
+    std::size_t i = static_cast<std::size_t>(state.thread_index());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(context.get<int>(keys[i++ % keys.size()]));
+    }
+}
+BENCHMARK(BM_GetInternedKey)->ThreadRange(1, 8)->UseRealTime();
+
+/// Writers replace values while the other threads read them
+void BM_StoreDataContended(benchmark::State& state) {
+    auto& context = shared_context();
+    const auto keys = key_names();
+    std::size_t i = static_cast<std::size_t>(state.thread_index());
+    int value = 0;
+    for (auto _ : state) {
+        const auto& key = keys[i++ % keys.size()];
+        if (state.thread_index() == 0) {
+            context.store_data(key, ++value);
+        } else {
+            benchmark::DoNotOptimize(context.get_data<int>(key));
+        }
+    }
+}
+BENCHMARK(BM_StoreDataContended)->ThreadRange(1, 8)->UseRealTime();
+
+} // namespace app_hook::context
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include "bench_support.hpp"
+#include "config/patch_config_loader.hpp"
+#include "memory/patch_memory.hpp"
+#include "memory/patch_transaction.hpp"
+#include "context/mod_context.hpp"
+#include <format>
+
+namespace app_hook::memory {
+
+namespace {
+
+/// Spacing of the generated instructions in the scratch code
+constexpr std::uintptr_t kInstructionStride = 16;
+
+/// @brief Patch set of n instructions spread over scratch code
+CompiledPatchSet make_patch_set(std::uintptr_t base, std::int64_t n) {
+    CompiledPatchSet patches;
+    patches.reserve(static_cast<std::size_t>(n), static_cast<std::size_t>(n) * 6);
+    for (std::int64_t i = 0; i < n; ++i) {
+        (void)patches.add_hex(base + static_cast<std::uintptr_t>(i) * kInstructionStride, "8D 86 XX XX XX XX",
+                              static_cast<std::int32_t>(i * 4));
+    }
+    return patches;
+}
+
+/// @brief Patch file in the format of config_ff8/tasks/magic_patch.toml
+std::string make_patch_file(std::int64_t n) {
+    std::string text = std::format("[metadata]\nscript_version = \"1.0.0\"\nmemory_base = \"0x01CF4064\"\n"
+                                   "total_instructions = {}\n\nreadFromContext = \"bench.patch.region\"\n\n", n);
+    for (std::int64_t i = 0; i < n; ++i) {
+        text += std::format("[instructions.0x{:08X}]\nbytes = \"8D 86 XX XX XX XX\"\noffset = \"0x{:X}\"\n\n",
+                            0x00401000 + i * kInstructionStride, i * 4);
+    }
+    return text;
+}
+
+} // namespace
+
+void BM_CompileInstructionBytes(benchmark::State& state) {
+    for (auto _ : state) {
+        CompiledPatchSet patches;
+        benchmark::DoNotOptimize(patches.add_hex(0x401000, "66 8B A8 XX XX XX XX 8A 04 85 XX XX XX XX", 0x28));
+        benchmark::DoNotOptimize(patches.pool().data());
+    }
+}
+BENCHMARK(BM_CompileInstructionBytes);
+
+void BM_LoadPatchFile(benchmark::State& state) {
+    bench::TempFile file("bench_patch_" + std::to_string(state.range(0)) + ".toml", make_patch_file(state.range(0)));
+    ::memory_plugin::PatchConfigLoader loader;
+    for (auto _ : state) {
+        auto configs = loader.load_configs(config::ConfigType::Patch, file.path(), "bench_patch");
+        if (!configs) {
+            state.SkipWithError("patch file did not parse");
+            break;
+        }
+        benchmark::DoNotOptimize(configs->data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_LoadPatchFile)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+
+/// Steady-state apply: the original bytes were saved by the first run
+void BM_PatchMemoryApply(benchmark::State& state) {
+    bench::ScratchCode code(static_cast<std::size_t>(state.range(0)) * kInstructionStride + 4096);
+    auto& context = context::ModContext::instance();
+    context.store_data("bench.patch.region", MemoryRegion(4096, 1024, 0x401000, "Benchmark region"));
+    
+    PatchConfig config("bench_patch", "Benchmark patch");
+    config.set_read_from_context("bench.patch.region");
+    config.set_compiled(make_patch_set(code.address(), state.range(0)));
+    PatchMemoryTask task(std::move(config));
+    for (auto _ : state) {
+        if (!task.execute()) {
+            state.SkipWithError("patches were not applied");
+            break;
+        }
+    }
+    task.rollback();
+    (void)context.remove_data("bench.patch.region");
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PatchMemoryApply)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+
+/// First apply (saving the original bytes) followed by a full rollback
+void BM_PatchTransactionCommitRollback(benchmark::State& state) {
+    bench::ScratchCode code(static_cast<std::size_t>(state.range(0)) * kInstructionStride + 4096);
+    const auto patches = make_patch_set(code.address(), state.range(0));
+    for (auto _ : state) {
+        PatchTransaction transaction;
+        if (!transaction.commit(patches, patches.instructions(), 0x10000000)) {
+            state.SkipWithError("patches were not applied");
+            break;
+        }
+        benchmark::DoNotOptimize(transaction.rollback());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_PatchTransactionCommitRollback)->RangeMultiplier(8)->Range(8, 4096)->Unit(benchmark::kMicrosecond);
+
+} // namespace app_hook::memory
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace app_hook::bench {
+
+/// @brief Executable scratch pages standing in for game code
+class ScratchCode {
+public:
+    explicit ScratchCode(std::size_t size)
+        : size_(size),
+          data_(static_cast<std::uint8_t*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READ))) {}
+
+    ~ScratchCode() {
+        if (data_) {
+            VirtualFree(data_, 0, MEM_RELEASE);
+        }
+    }
+
+    ScratchCode(const ScratchCode&) = delete;
+    ScratchCode& operator=(const ScratchCode&) = delete;
+
+    [[nodiscard]] std::uintptr_t address() const noexcept { return reinterpret_cast<std::uintptr_t>(data_); }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    std::size_t size_;
+    std::uint8_t* data_;
+};
+
+/// @brief File in the temp directory, removed with the object
+class TempFile {
+public:
+    TempFile(const std::string& name, const std::string& content)
+        : path_(std::filesystem::temp_directory_path() / name) {
+        std::ofstream file(path_, std::ios::binary);
+        file << content;
+    }
+
+    ~TempFile() {
+        std::error_code error;
+        std::filesystem::remove(path_, error);
+    }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+
+    [[nodiscard]] std::string path() const { return path_.string(); }
+
+private:
+    std::filesystem::path path_;
+};
+
+} // namespace app_hook::bench
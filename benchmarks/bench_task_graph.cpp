@@ -0,0 +1,42 @@
+#include <benchmark/benchmark.h>
+#include "config/task_loader.hpp"
+#include <string>
+#include <vector>
+
+namespace app_hook::config {
+
+namespace {
+
+/// @brief Tasks where each one is followed by the next kFanOut tasks
+std::vector<TaskInfo> make_tasks(std::int64_t n) {
+    constexpr std::int64_t kFanOut = 4;
+    std::vector<TaskInfo> tasks(static_cast<std::size_t>(n));
+    for (std::int64_t i = 0; i < n; ++i) {
+        auto& task = tasks[static_cast<std::size_t>(i)];
+        task.name = "Task " + std::to_string(i);
+        task.config_file = "tasks/task_" + std::to_string(i) + ".toml";
+        task.type = ConfigType::Memory;
+        for (std::int64_t j = i + 1; j < n && j <= i + kFanOut; ++j) {
+            task.follow_by.push_back("task_" + std::to_string(j));
+        }
+    }
+    return tasks;
+}
+
+} // namespace
+
+void BM_BuildExecutionOrder(benchmark::State& state) {
+    const auto tasks = make_tasks(state.range(0));
+    for (auto _ : state) {
+        auto order = TaskLoader::build_execution_order(tasks);
+        if (!order) {
+            state.SkipWithError("task graph has a cycle");
+            break;
+        }
+        benchmark::DoNotOptimize(order->data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BuildExecutionOrder)->RangeMultiplier(8)->Range(8, 32768)->Unit(benchmark::kMicrosecond);
+
+} // namespace app_hook::config
@@ -0,0 +1,61 @@
+#include <benchmark/benchmark.h>
+#include "hook/trigger_trace.hpp"
+#include <cstdlib>
+#include <memory>
+
+namespace app_hook::hook {
+
+namespace {
+
+/// @brief Recorded session: APP_HOOK_TRACE if set, otherwise a synthetic one
+///
+/// The synthetic trace has 16 hooks of 2 tasks hit round-robin by 4 threads,
+/// with one failure in 64 triggers and one every_n hook.
+const TriggerTrace& session_trace() {
+    static const TriggerTrace trace = [] {
+        if (const char* path = std::getenv("APP_HOOK_TRACE")) {
+            if (auto recorded = TriggerTrace::read(path)) {
+                return std::move(*recorded);
+            }
+        }
+
+        TriggerTrace synthetic;
+        synthetic.frequency = 10'000'000;
+        for (std::uint32_t i = 0; i < 16; ++i) {
+            synthetic.hooks.push_back({0x401000 + i * 0x100, 2, i == 0 ? TriggerPolicy::every_n : TriggerPolicy::always,
+                                       0, i == 0 ? 4u : 1u});
+        }
+        for (std::uint64_t i = 0; i < 65'536; ++i) {
+            const auto hook = static_cast<std::uint32_t>(i % synthetic.hooks.size());
+            std::uint32_t outcome = i % 64 == 0 ? task_outcome_bit(1) : 0;
+            if (hook == 0 && (i / synthetic.hooks.size()) % 4 != 0) {
+                outcome = kTriggerSkipped;
+            }
+            synthetic.records.push_back({i * 100, synthetic.hooks[hook].address, static_cast<std::uint32_t>(i % 4),
+                                         500, outcome});
+        }
+        return synthetic;
+    }();
+    return trace;
+}
+
+} // namespace
+
+void BM_ReplayTrace(benchmark::State& state) {
+    const auto& trace = session_trace();
+    TraceReplayer replayer(trace);
+    std::uint64_t mismatches = 0;
+    for (auto _ : state) {
+        const auto result = replayer.run();
+        mismatches += result.mismatches;
+        state.PauseTiming();
+        replayer.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(trace.records.size()));
+    state.counters["threads"] = static_cast<double>(trace.threads().size());
+    state.counters["mismatches"] = static_cast<double>(mismatches);
+}
+BENCHMARK(BM_ReplayTrace)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace app_hook::hook
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "config_common.hpp"
+#include "../util/pe_image.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace app_hook::config {
+
+/// @brief Addresses of named sites in one build of the executable
+///
+/// A mod ships one map file per known build, in the address_maps directory of
+/// the config directory:
+///
+///     [build]
+///     name = "FF8 2013 EN"
+///     timestamp = "0x5203E1C3"   # PE TimeDateStamp
+///     checksum = "0x0021D6E4"    # optional, PE header checksum
+///     imageSize = "0x1D5C000"    # optional, SizeOfImage
+///
+///     [symbols]
+///     K_MAGIC = "0x1CF3E48"
+///     copy_site = "0x4A8D43"
+///
+/// At startup the host picks the map whose build matches the executable's PE
+/// stamp, and loaders look symbols up in it instead of scanning for patterns.
+class AddressMap {
+public:
+    /// @brief Directory of the map files inside the config directory
+    static constexpr const char* kDirectory = "address_maps";
+
+    /// @brief Read a map file
+    /// @param path Map file path
+    /// @return Map, or the reason the file cannot be used
+    [[nodiscard]] static ConfigResult<AddressMap> read(const std::filesystem::path& path);
+
+    /// @brief Find the map of a build among the map files of a directory
+    /// @param directory Directory of map files (*.toml)
+    /// @param stamp PE stamp of the executable
+    /// @return Map of the build, or nullopt if no readable file matches it
+    [[nodiscard]] static std::optional<AddressMap> select(const std::filesystem::path& directory,
+                                                          const util::ModuleStamp& stamp);
+
+    /// @brief Summarize the map files of a directory by name, size and write time
+    /// @param directory Directory of map files
+    /// @return Fingerprint, 0 if the directory has no map files
+    /// @note Lets caches that bake looked-up addresses notice edited maps
+    [[nodiscard]] static std::uint64_t fingerprint(const std::filesystem::path& directory);
+
+    /// @brief Check if the map was made for a build
+    [[nodiscard]] bool matches(const util::ModuleStamp& stamp) const noexcept {
+        return stamp.timestamp == timestamp_ && (!checksum_ || *checksum_ == stamp.checksum) &&
+               (!image_size_ || *image_size_ == stamp.image_size);
+    }
+
+    /// @brief Look up a symbol
+    /// @return Address, or 0 if the map does not name it
+    [[nodiscard]] std::uintptr_t find(std::string_view symbol) const noexcept {
+        const auto it = symbols_.find(symbol);
+        return it != symbols_.end() ? it->second : 0;
+    }
+
+    /// @brief Get the display name of the build
+    [[nodiscard]] const std::string& build() const noexcept { return build_; }
+
+    /// @brief Get the number of symbols
+    [[nodiscard]] std::size_t size() const noexcept { return symbols_.size(); }
+
+private:
+    /// @brief Transparent hash so string_view symbols are looked up without a copy
+    struct SymbolHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    std::string build_;
+    std::uint32_t timestamp_ = 0;
+    std::optional<std::uint32_t> checksum_;     ///< Unset: any checksum
+    std::optional<std::uint32_t> image_size_;   ///< Unset: any image size
+    std::unordered_map<std::string, std::uintptr_t, SymbolHash, std::equal_to<>> symbols_;
+};
+
+} // namespace app_hook::config
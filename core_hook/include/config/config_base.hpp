@@ -3,8 +3,10 @@
 #include <string>
 #include <memory>
 #include <string_view>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace app_hook::config {
 
@@ -14,11 +16,26 @@ enum class ConfigType : std::uint8_t {
     Memory,     ///< Memory expansion configuration
     Patch,      ///< Instruction patch configuration
     Load,       ///< Load binary data configuration
-    Script,     ///< Script configuration (future)
+    Script,     ///< Lua script configuration (lua_plugin)
     Audio,      ///< Audio configuration (future)
-    Graphics    ///< Graphics configuration (future)
+    Graphics,   ///< Graphics configuration (future)
+    Delta,      ///< Byte edits applied to a copied region
+    Profile,    ///< Call counting probes (core, no plugin)
+    Frame,      ///< Frame anchor draining deferred tasks (core, no plugin)
+    Text        ///< Encoded string table written into a region
 };
 
+/// @brief Number of ConfigType values (keep in sync with the last enumerator)
+inline constexpr std::size_t kConfigTypeCount = static_cast<std::size_t>(ConfigType::Text) + 1;
+
+/// @brief Get the registry slot of a configuration type
+/// @param type Configuration type
+/// @return Index in [0, kConfigTypeCount), or kConfigTypeCount if out of range
+[[nodiscard]] constexpr std::size_t to_index(ConfigType type) noexcept {
+    const auto index = static_cast<std::size_t>(type);
+    return index < kConfigTypeCount ? index : kConfigTypeCount;
+}
+
 /// @brief Convert ConfigType to string representation
 /// @param type Configuration type
 /// @return String representation of the type
@@ -30,6 +47,10 @@ enum class ConfigType : std::uint8_t {
         case ConfigType::Script:   return "script";
         case ConfigType::Audio:    return "audio";
         case ConfigType::Graphics: return "graphics";
+        case ConfigType::Delta:    return "delta";
+        case ConfigType::Profile:  return "profile";
+        case ConfigType::Frame:    return "frame";
+        case ConfigType::Text:     return "text";
         case ConfigType::Unknown:  
         default:                   return "unknown";
     }
@@ -45,6 +66,10 @@ enum class ConfigType : std::uint8_t {
     if (type_str == "script")   return ConfigType::Script;
     if (type_str == "audio")    return ConfigType::Audio;
     if (type_str == "graphics") return ConfigType::Graphics;
+    if (type_str == "delta")    return ConfigType::Delta;
+    if (type_str == "profile")  return ConfigType::Profile;
+    if (type_str == "frame")    return ConfigType::Frame;
+    if (type_str == "text")     return ConfigType::Text;
     return ConfigType::Unknown;
 }
 
@@ -118,6 +143,12 @@ public:
     /// @return Unique identifier
     [[nodiscard]] const std::string& key() const noexcept { return key_; }
 
+    /// @brief Get the stable type ID of the concrete configuration class
+    /// @return Name task creators are registered under, or empty if the class declares none
+    /// @note Derived classes declare a static kTypeId and return it here, which
+    ///       lets the TaskFactory find their creator with a single hash lookup
+    [[nodiscard]] virtual std::string_view type_id() const noexcept { return {}; }
+
     /// @brief Get configuration name
     /// @return Display name
     [[nodiscard]] const std::string& name() const noexcept { return name_; }
@@ -187,6 +218,28 @@ public:
                " (enabled: " + (enabled_ ? "true" : "false") + ")";
     }
 
+    /// @brief Get the memory held by this configuration
+    /// @return Size of the object plus the heap bytes it owns
+    /// @note Derived classes holding data return sizeof(*this) + heap_bytes() plus their own buffers
+    [[nodiscard]] virtual std::size_t footprint_bytes() const noexcept {
+        return sizeof(ConfigBase) + heap_bytes();
+    }
+
+    /// @brief Give back the capacity the loader left in the configuration's buffers
+    /// @note Called once the task holding the configuration is installed; derived
+    ///       classes also shrink their own buffers
+    virtual void compact() {
+        key_.shrink_to_fit();
+        name_.shrink_to_fit();
+        description_.shrink_to_fit();
+        write_in_context_.name.shrink_to_fit();
+        read_from_context_.shrink_to_fit();
+    }
+
+    /// @brief Get the data files the configuration's task reads at run time
+    /// @return File paths as configured, packed into mod bundles next to the configs
+    [[nodiscard]] virtual std::vector<std::string> data_files() const { return {}; }
+
     /// @brief Check if this configuration is an address trigger
     /// @return True if this config implements AddressTrigger interface
     [[nodiscard]] bool is_address_trigger() const noexcept {
@@ -203,6 +256,12 @@ public:
     }
 
 protected:
+    /// @brief Get the heap bytes owned by the base class strings
+    [[nodiscard]] std::size_t heap_bytes() const noexcept {
+        return key_.capacity() + name_.capacity() + description_.capacity() +
+               write_in_context_.name.capacity() + read_from_context_.capacity();
+    }
+
     /// @brief Configuration type
     ConfigType type_;
     
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "config_common.hpp"
+#include "config_base.hpp"
+#include "mod_bundle.hpp"
+#include "task_loader.hpp"
+#include "../util/byte_stream.hpp"
+#include "../util/pe_image.hpp"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief Identity of a config file's contents
+struct FileFingerprint {
+    std::int64_t mtime = 0;   ///< Last write time, in file clock ticks
+    std::uint64_t size = 0;   ///< File size in bytes
+    std::uint64_t hash = 0;   ///< FNV-1a hash of the file contents
+};
+
+/// @brief Binary snapshot of parsed tasks.toml and plugin config files
+///
+/// Stored as a single file in the config directory. Each entry is keyed by the
+/// path of its source file and holds that file's fingerprint, the name and cache
+/// version of the loader that produced it, the task it was loaded for, and the
+/// serialized result. At launch a file whose modification time and size match
+/// its entry is served from the snapshot without being parsed; if only the time
+/// changed, the contents are hashed and the entry is kept when the hash still
+/// matches. Loaders that do not implement the cache hooks of ConfigLoaderBase
+/// are always parsed. The file also records the PE stamp of the executable:
+/// addresses resolved from signatures bake into the payloads, so the whole
+/// snapshot is dropped when the executable changes. For the same reason it
+/// is dropped when a file of the address maps changes. load_tasks and
+/// load_configs may be called concurrently.
+class ConfigCache {
+public:
+    /// @brief Name of the cache file inside the config directory
+    static constexpr const char* kFileName = "config.cache";
+
+    /// @brief Open the cache of a config directory
+    /// @param config_dir Directory holding tasks.toml and the config files
+    /// @note A missing, stale or corrupt cache file is ignored
+    explicit ConfigCache(const std::filesystem::path& config_dir);
+
+    // Non-copyable and non-movable (owns a mutex)
+    ConfigCache(const ConfigCache&) = delete;
+    ConfigCache& operator=(const ConfigCache&) = delete;
+    ConfigCache(ConfigCache&&) = delete;
+    ConfigCache& operator=(ConfigCache&&) = delete;
+
+    /// @brief Load task information, from the snapshot when tasks.toml is unchanged
+    /// @param tasks_file_path Path to the tasks.toml file
+    /// @return Vector of task information or error
+    [[nodiscard]] ConfigResult<std::vector<TaskInfo>> load_tasks(const std::string& tasks_file_path);
+
+    /// @brief Load configurations, from the snapshot when the file is unchanged
+    /// @param type Configuration type to load
+    /// @param config_file Path to the configuration file
+    /// @param task_name Name of the task (for logging and key generation)
+    /// @return Vector of configuration objects or error
+    [[nodiscard]] ConfigResult<std::vector<ConfigPtr>>
+    load_configs(ConfigType type, const std::string& config_file, const std::string& task_name);
+
+    /// @brief Write the snapshot if anything changed
+    /// @return False if the cache file could not be written
+    /// @note Entries not used since the cache was opened are dropped; call once
+    ///       all loads have finished
+    bool save();
+
+    /// @brief Serve files from a mod bundle ahead of the snapshot
+    /// @param bundle Bundle of the same config directory
+    /// @note Files the bundle holds are neither stat'ed nor parsed; an entry
+    ///       written by another loader or loader version falls through
+    void attach_bundle(std::shared_ptr<const ModBundle> bundle) { bundle_ = std::move(bundle); }
+
+    /// @brief Pack the snapshot and some binaries into a mod bundle
+    /// @param blobs Paths of the binaries to pack, as their tasks were configured
+    /// @return False if the bundle could not be written
+    /// @note Call after save(), so only the files of this launch are packed
+    bool write_bundle(std::span<const std::string> blobs) const;
+
+    /// @brief Get the number of files served from the snapshot or the bundle
+    [[nodiscard]] std::size_t hits() const noexcept { return hits_; }
+
+    /// @brief Get the number of files that had to be parsed
+    [[nodiscard]] std::size_t misses() const noexcept { return misses_; }
+
+    /// @brief Get the path of the cache file
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return path_; }
+
+private:
+    using Payload = std::shared_ptr<const std::vector<std::uint8_t>>;
+
+    /// @brief Snapshot of one source file
+    struct Entry {
+        FileFingerprint fingerprint;
+        std::string loader;
+        std::uint32_t version = 0;
+        std::string task;
+        Payload payload;
+        bool used = false;
+    };
+
+    /// @brief Find the payload of a file if its entry is still valid
+    /// @param file_path Source file path
+    /// @param loader Expected loader name
+    /// @param version Expected loader cache version
+    /// @param task Expected task name
+    /// @param current Receives the fingerprint of the file on disk
+    /// @return Payload of the valid entry or nullptr
+    /// @note The file is stat'ed and hashed without holding mutex_
+    [[nodiscard]] Payload lookup(const std::string& file_path, const std::string& loader,
+                                std::uint32_t version, const std::string& task,
+                                std::optional<FileFingerprint>& current);
+
+    /// @brief Record a fresh snapshot of a file
+    void store(const std::string& file_path, const FileFingerprint& fingerprint, std::string loader,
+               std::uint32_t version, std::string task, std::vector<std::uint8_t> payload);
+
+    /// @brief Read the cache file
+    void read();
+
+    /// @brief Get the modification time and size of a file
+    [[nodiscard]] static std::optional<FileFingerprint> stat_file(const std::string& file_path);
+
+    /// @brief Hash the contents of a file
+    [[nodiscard]] static std::optional<std::uint64_t> hash_file(const std::string& file_path);
+
+    /// @brief Serialize task information
+    static void write_tasks(util::ByteWriter& out, const std::vector<TaskInfo>& tasks);
+
+    /// @brief Deserialize task information
+    [[nodiscard]] static std::optional<std::vector<TaskInfo>> read_tasks(util::ByteReader& in);
+
+    std::filesystem::path path_;
+    std::shared_ptr<const ModBundle> bundle_;
+    util::ModuleStamp module_stamp_;  ///< Stamp of the executable the payloads were made for
+    std::uint64_t address_maps_ = 0;  ///< Fingerprint of the address map files the payloads were made with
+    std::unordered_map<std::string, Entry> entries_;
+    bool dirty_ = false;
+    mutable std::mutex mutex_;  ///< Guards entries_ and dirty_
+    std::atomic<std::size_t> hits_{0};
+    std::atomic<std::size_t> misses_{0};
+};
+
+} // namespace app_hook::config
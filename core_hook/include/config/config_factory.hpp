@@ -4,15 +4,19 @@
 #include "config_loader_base.hpp"
 #include "config_common.hpp"
 #include "../util/logger.hpp"
+#include <array>
 #include <vector>
 #include <memory>
 #include <unordered_map>
 #include <functional>
+#include <shared_mutex>
 
 namespace app_hook::config {
 
 /// @brief Factory for creating configuration objects
-/// @note Handles polymorphic creation based on configuration type using registered loaders
+/// @note Handles polymorphic creation based on configuration type using registered loaders.
+///       load_configs may be called from several threads at once, so loaders must be
+///       safe for concurrent load_configs calls; registration takes an exclusive lock.
 class ConfigFactory {
 public:
     ConfigFactory() = default;
@@ -51,14 +55,32 @@ public:
     /// @return True if supported by any registered loader
     [[nodiscard]] static bool is_type_supported(ConfigType type);
 
+    /// @brief Get the loader handling a configuration type
+    /// @param type Configuration type
+    /// @return Pointer to loader or nullptr if not found
+    /// @note The pointer stays valid until the loader is unregistered
+    [[nodiscard]] static ConfigLoaderBase* get_loader(ConfigType type);
+
 private:
     /// @brief Map of registered configuration loaders
     static std::unordered_map<std::string, ConfigLoaderPtr> loaders_;
+    
+    /// @brief Loader handling each configuration type, indexed by to_index(type)
+    /// @note Filled from supported_types() at registration so lookups never call it
+    static std::array<ConfigLoaderBase*, kConfigTypeCount> loaders_by_type_;
+    
+    /// @brief Guards loaders_ and loaders_by_type_ (shared for lookups and loads)
+    static std::shared_mutex mutex_;
 
-    /// @brief Find loader that supports the given type
+    /// @brief Find loader that supports the given type (caller holds mutex_)
     /// @param type Configuration type
     /// @return Pointer to loader or nullptr if not found
-    [[nodiscard]] static ConfigLoaderBase* find_loader_for_type(ConfigType type);
+    [[nodiscard]] static ConfigLoaderBase* find_loader_for_type(ConfigType type) noexcept;
+    
+    /// @brief Point the type slots claimed by a loader at it (caller holds mutex_ exclusively)
+    /// @param loader Loader to index
+    /// @param replace Whether to take over slots already held by another loader
+    static void index_loader(ConfigLoaderBase* loader, bool replace);
 };
 
 } // namespace app_hook::config 
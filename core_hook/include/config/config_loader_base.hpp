@@ -2,6 +2,8 @@
 
 #include "config_base.hpp"
 #include "config_common.hpp"
+#include "../util/byte_stream.hpp"
+#include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
@@ -36,8 +38,83 @@ public:
     /// @brief Get loader version
     /// @return Version string
     virtual std::string get_version() const = 0;
+
+    /// @brief Get the version of this loader's config cache format
+    /// @return Format version (bump it whenever serialize_configs changes), or 0 if
+    ///         the configs of this loader are not cached
+    virtual std::uint32_t cache_version() const { return 0; }
+
+    /// @brief Serialize configurations produced by load_configs for the config cache
+    /// @param configs Configurations to serialize
+    /// @param out Writer receiving the snapshot
+    /// @return False if the configurations cannot be cached
+    virtual bool serialize_configs(const std::vector<ConfigPtr>& configs, util::ByteWriter& out) const {
+        (void)configs;
+        (void)out;
+        return false;
+    }
+
+    /// @brief Rebuild configurations from a snapshot written by serialize_configs
+    /// @param type Configuration type
+    /// @param in Reader over the snapshot
+    /// @param task_name Name of the task (for logging and key generation)
+    /// @return Vector of configuration objects, or an error to fall back to load_configs
+    /// @note Side effects load_configs has besides parsing (queuing preloads, for
+    ///       instance) must happen here too
+    virtual ConfigResult<std::vector<ConfigPtr>> deserialize_configs(
+        ConfigType type,
+        util::ByteReader& in,
+        const std::string& task_name
+    ) {
+        (void)type;
+        (void)in;
+        (void)task_name;
+        return std::unexpected(ConfigError::invalid_format);
+    }
 };
 
+/// @brief Write the ConfigBase fields of a configuration to a cache snapshot
+/// @param out Writer receiving the fields
+/// @param config Configuration to write
+inline void write_config_base(util::ByteWriter& out, const ConfigBase& config) {
+    out.write_string(config.key());
+    out.write_string(config.name());
+    out.write_string(config.description());
+    out.write(config.enabled());
+    out.write(config.write_in_context().enabled);
+    out.write_string(config.write_in_context().name);
+    out.write_string(config.read_from_context());
+}
+
+/// @brief Read the key and name written by write_config_base
+/// @param in Reader over the snapshot
+/// @param key Configuration key
+/// @param name Display name
+/// @return False if the snapshot is truncated
+inline bool read_config_identity(util::ByteReader& in, std::string& key, std::string& name) {
+    return in.read_string(key) && in.read_string(name);
+}
+
+/// @brief Read the remaining ConfigBase fields written by write_config_base
+/// @param in Reader over the snapshot
+/// @param config Configuration built from read_config_identity
+/// @return False if the snapshot is truncated
+inline bool read_config_fields(util::ByteReader& in, ConfigBase& config) {
+    std::string description;
+    bool enabled = true;
+    WriteContextConfig write_in_context;
+    std::string read_from_context;
+    if (!in.read_string(description) || !in.read(enabled) || !in.read(write_in_context.enabled) ||
+        !in.read_string(write_in_context.name) || !in.read_string(read_from_context)) {
+        return false;
+    }
+    config.set_description(std::move(description));
+    config.set_enabled(enabled);
+    config.set_write_in_context(std::move(write_in_context));
+    config.set_read_from_context(std::move(read_from_context));
+    return true;
+}
+
 /// @brief Smart pointer type for config loaders
 using ConfigLoaderPtr = std::unique_ptr<ConfigLoaderBase>;
 
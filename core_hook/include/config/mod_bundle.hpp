@@ -0,0 +1,169 @@
+#pragma once
+
+#include "config_common.hpp"
+#include "../util/pe_image.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief What a bundle entry holds
+enum class BundleEntryKind : std::uint8_t {
+    tasks = 1,    ///< Serialized tasks.toml (ConfigCache task format)
+    configs = 2,  ///< A config file as serialized by its loader's cache hooks
+    blob = 3      ///< Raw contents of a binary a task copies into memory
+};
+
+/// @brief One entry of a bundle's table of contents
+struct BundleEntry {
+    BundleEntryKind kind = BundleEntryKind::blob;
+    std::string key;                  ///< Config file relative to the config dir, or blob path
+    std::string loader;               ///< Loader that serialized a configs entry
+    std::uint32_t version = 0;        ///< Loader cache version of a configs entry
+    std::string task;                 ///< Task a configs entry was loaded for
+    std::span<const std::uint8_t> data;  ///< Bytes inside the mapped bundle
+};
+
+/// @brief Read-only, memory-mapped mod bundle
+///
+/// A bundle packs a whole mod into one file: tasks.toml and every config file
+/// in the binary form their loaders' cache hooks produce, plus the binaries
+/// LoadInMemory tasks copy. Layout:
+///
+///     header   magic "AHMB", format version, PE stamp of the executable,
+///              entry count, table of contents size
+///     toc      per entry: kind, key, loader, loader version, task,
+///              data offset and size
+///     data     payloads 16-byte aligned, blobs page aligned
+///
+/// Opening maps the file and indexes the table of contents; entries are then
+/// read in place, so payloads deserialize straight from the view and blobs are
+/// copied from it without a read. Config file keys are relative to the config
+/// directory, blob keys are the normalized path the task was given.
+class ModBundle {
+public:
+    /// @brief Name of the bundle file inside the config directory
+    static constexpr const char* kFileName = "mod.bundle";
+
+    /// @brief Alignment of blob data in the file (and so in the view)
+    static constexpr std::size_t kBlobAlignment = 4096;
+
+    /// @brief Alignment of payload data in the file
+    static constexpr std::size_t kPayloadAlignment = 16;
+
+    /// @brief Map the bundle of a config directory
+    /// @param config_dir Directory holding the bundle
+    /// @return Bundle, file_not_found if there is none, or invalid_format if it
+    ///         is corrupt or was packed for another build of the executable
+    [[nodiscard]] static ConfigResult<std::shared_ptr<const ModBundle>> open(const std::filesystem::path& config_dir);
+
+    ~ModBundle();
+
+    // Non-copyable and non-movable (owns the view the entries point into)
+    ModBundle(const ModBundle&) = delete;
+    ModBundle& operator=(const ModBundle&) = delete;
+    ModBundle(ModBundle&&) = delete;
+    ModBundle& operator=(ModBundle&&) = delete;
+
+    /// @brief Find an entry
+    /// @param kind Entry kind
+    /// @param key Entry key (see config_key and blob_key)
+    /// @return Entry, or nullptr
+    [[nodiscard]] const BundleEntry* find(BundleEntryKind kind, std::string_view key) const;
+
+    /// @brief Find the entry of a config file (or of tasks.toml with BundleEntryKind::tasks)
+    /// @param kind Entry kind
+    /// @param file Config file path
+    [[nodiscard]] const BundleEntry* find_file(BundleEntryKind kind, const std::filesystem::path& file) const {
+        return find(kind, config_key(config_dir_, file));
+    }
+
+    /// @brief Get the bytes of a packed binary
+    /// @param path Binary path as the task was configured
+    /// @return Bytes in the view, or an empty span if the bundle does not hold it
+    [[nodiscard]] std::span<const std::uint8_t> blob(const std::string& path) const {
+        const auto* entry = find(BundleEntryKind::blob, blob_key(path));
+        return entry ? entry->data : std::span<const std::uint8_t>{};
+    }
+
+    /// @brief Get the table of contents
+    [[nodiscard]] const std::vector<BundleEntry>& entries() const noexcept { return entries_; }
+
+    /// @brief Get the stamp of the executable the bundle was packed for
+    [[nodiscard]] const util::ModuleStamp& stamp() const noexcept { return stamp_; }
+
+    /// @brief Get the size of the mapped file
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /// @brief Get the key of a config file
+    /// @param config_dir Config directory
+    /// @param file Config file path
+    /// @return Path relative to config_dir in generic form
+    [[nodiscard]] static std::string config_key(const std::filesystem::path& config_dir, const std::filesystem::path& file);
+
+    /// @brief Get the key of a binary
+    /// @param path Binary path as the task was configured
+    /// @return Normalized path in generic form
+    [[nodiscard]] static std::string blob_key(const std::filesystem::path& path);
+
+private:
+    ModBundle() = default;
+
+    /// @brief Index the table of contents of the mapped file
+    /// @return false if the file is not a bundle or is truncated
+    bool index();
+
+    std::filesystem::path config_dir_;
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+    const std::uint8_t* view_ = nullptr;
+    std::size_t size_ = 0;
+    util::ModuleStamp stamp_;
+    std::vector<BundleEntry> entries_;
+    std::unordered_map<std::string, std::size_t> index_;  ///< kind + key -> entry
+};
+
+/// @brief Builds a bundle file from serialized entries
+class BundleWriter {
+public:
+    /// @brief Add an entry
+    /// @param kind Entry kind
+    /// @param key Entry key (see ModBundle::config_key and ModBundle::blob_key)
+    /// @param data Entry bytes
+    /// @param loader Loader that serialized a configs entry
+    /// @param version Loader cache version of a configs entry
+    /// @param task Task a configs entry was loaded for
+    void add(BundleEntryKind kind, std::string key, std::vector<std::uint8_t> data,
+             std::string loader = {}, std::uint32_t version = 0, std::string task = {});
+
+    /// @brief Get the number of entries added
+    [[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+
+    /// @brief Write the bundle file
+    /// @param path Bundle file path
+    /// @param stamp Stamp of the executable the payloads were made for
+    /// @return true if the file was written
+    /// @note Written next to the target and renamed over it, like the caches
+    bool write(const std::filesystem::path& path, const util::ModuleStamp& stamp) const;
+
+private:
+    struct Pending {
+        BundleEntryKind kind;
+        std::string key;
+        std::string loader;
+        std::uint32_t version;
+        std::string task;
+        std::vector<std::uint8_t> data;
+    };
+
+    std::vector<Pending> entries_;
+};
+
+} // namespace app_hook::config
@@ -4,12 +4,70 @@
 #include "config_base.hpp"
 #include "config_factory.hpp"
 #include <toml++/toml.h>
+#include <cstdint>
+#include <limits>
 #include <vector>
+#include <span>
 #include <string>
 #include <optional>
+#include <string_view>
+#include <unordered_map>
 
 namespace app_hook::config {
 
+/// @brief When a task runs relative to its hook
+enum class TaskExecution {
+    hooked,  ///< Run inside the hooked call (default)
+    eager,   ///< Run once at install time, without installing a detour
+    async,   ///< Queued to the worker pool by the hook; the hooked call does not wait
+    deferred ///< Queued by the hook and run on the game thread by the frame anchor, within its budget
+};
+
+/// @brief Parse an execution mode name from tasks.toml
+/// @param value Mode name ("hook"/"inline", "eager", "async" or "deferred")
+/// @return Parsed mode or nullopt if unknown
+[[nodiscard]] inline std::optional<TaskExecution> execution_from_string(std::string_view value) noexcept {
+    if (value == "hook" || value == "hooked" || value == "inline") return TaskExecution::hooked;
+    if (value == "eager") return TaskExecution::eager;
+    if (value == "async") return TaskExecution::async;
+    if (value == "deferred") return TaskExecution::deferred;
+    return std::nullopt;
+}
+
+/// @brief Which calls of its hook run a task
+enum class TaskPolicy {
+    always,         ///< Every call (default)
+    once,           ///< The first call, whatever its result; the hook is then removed
+    until_success,  ///< Every call until the tasks succeed; the hook is then removed
+    every_n         ///< The first call and every Nth call after it (sampling)
+};
+
+/// @brief Parse a policy name from tasks.toml
+/// @param value Policy name ("always", "once", "until_success" or "every_n")
+/// @return Parsed policy or nullopt if unknown
+[[nodiscard]] inline std::optional<TaskPolicy> policy_from_string(std::string_view value) noexcept {
+    if (value == "always") return TaskPolicy::always;
+    if (value == "once") return TaskPolicy::once;
+    if (value == "until_success") return TaskPolicy::until_success;
+    if (value == "every_n") return TaskPolicy::every_n;
+    return std::nullopt;
+}
+
+/// @brief Which registers the stub of a task's hook saves
+enum class TaskStub {
+    minimal,  ///< Only what the call into the hook manager can change (default)
+    full      ///< Every register, for tasks that read or write the hooked code's registers
+};
+
+/// @brief Parse a stub kind name from tasks.toml
+/// @param value Stub name ("minimal" or "full")
+/// @return Parsed stub kind or nullopt if unknown
+[[nodiscard]] inline std::optional<TaskStub> stub_from_string(std::string_view value) noexcept {
+    if (value == "minimal") return TaskStub::minimal;
+    if (value == "full") return TaskStub::full;
+    return std::nullopt;
+}
+
 /// @brief Task metadata from tasks.toml
 struct TaskInfo {
     std::string name;                    ///< Display name of the task
@@ -18,9 +76,15 @@ struct TaskInfo {
     ConfigType type;                     ///< Type of configuration
     std::vector<std::string> follow_by;  ///< Tasks to execute after this one completes
     bool enabled;                        ///< Whether the task is enabled
+    TaskPolicy policy;                   ///< Which calls of the task's hook run it
+    std::uint32_t every_n;               ///< Call period of TaskPolicy::every_n
+    TaskExecution execution;             ///< Whether the task runs in its hook or at install time
+    TaskStub stub;                       ///< Registers saved by the stub of the task's hook
     
     /// @brief Constructor
-    TaskInfo() : type(ConfigType::Unknown), enabled(true) {}
+    TaskInfo()
+        : type(ConfigType::Unknown), enabled(true), policy(TaskPolicy::always), every_n(1),
+          execution(TaskExecution::hooked), stub(TaskStub::minimal) {}
     
     /// @brief Check if this task info is valid
     [[nodiscard]] constexpr bool is_valid() const noexcept {
@@ -38,6 +102,81 @@ struct TaskInfo {
     }
 };
 
+/// @brief Dependency graph of the tasks declared in tasks.toml
+///
+/// Every task is interned to a dense integer ID in declaration order, and its
+/// key (config file name without directory or ".toml") is derived once. followBy
+/// edges are stored as flat adjacency arrays in both directions. build() sorts
+/// the graph with Kahn's algorithm, one level at a time: the tasks of a level
+/// only depend on tasks of earlier levels, so the tasks within a level are
+/// independent of each other and may be processed in parallel.
+class TaskGraph {
+public:
+    /// @brief Dense task identifier (index into the task list)
+    using TaskId = std::uint32_t;
+    
+    /// @brief Build the graph of a task list
+    /// @param tasks Tasks to index (must outlive the graph)
+    /// @return Sorted graph or invalid_format if followBy forms a cycle
+    /// @note Unknown followBy names are ignored with a warning; when two tasks
+    ///       share a key, the first one declared is kept
+    [[nodiscard]] static ConfigResult<TaskGraph> build(std::span<const TaskInfo> tasks);
+    
+    /// @brief Derive a task key from its config file path
+    /// @param config_file Path to the config file
+    /// @return File name without directory and ".toml" extension
+    [[nodiscard]] static std::string key_from_file(std::string_view config_file);
+    
+    /// @brief Get the number of tasks in the graph
+    [[nodiscard]] std::size_t size() const noexcept { return ids_.size(); }
+    
+    /// @brief Get a task by ID
+    [[nodiscard]] const TaskInfo& task(TaskId id) const noexcept { return tasks_[ids_[id]]; }
+    
+    /// @brief Get the key of a task
+    [[nodiscard]] const std::string& key(TaskId id) const noexcept { return keys_[id]; }
+    
+    /// @brief Find a task by key
+    /// @return Task ID or nullopt if no task has this key
+    [[nodiscard]] std::optional<TaskId> find(const std::string& key) const;
+    
+    /// @brief Get the tasks listed in a task's followBy
+    [[nodiscard]] std::span<const TaskId> followers(TaskId id) const noexcept {
+        return std::span(follower_ids_).subspan(follower_offsets_[id], follower_offsets_[id + 1] - follower_offsets_[id]);
+    }
+    
+    /// @brief Get the tasks whose followBy lists a task, in declaration order
+    [[nodiscard]] std::span<const TaskId> parents(TaskId id) const noexcept {
+        return std::span(parent_ids_).subspan(parent_offsets_[id], parent_offsets_[id + 1] - parent_offsets_[id]);
+    }
+    
+    /// @brief Get every task in execution order (parents before followers)
+    [[nodiscard]] std::span<const TaskId> order() const noexcept { return order_; }
+    
+    /// @brief Get the number of dependency levels
+    [[nodiscard]] std::size_t level_count() const noexcept { return level_offsets_.size() - 1; }
+    
+    /// @brief Get the tasks of one dependency level, which are independent of each other
+    /// @param level Level index (level 0 holds the tasks without parents)
+    [[nodiscard]] std::span<const TaskId> level(std::size_t level) const noexcept {
+        return std::span(order_).subspan(level_offsets_[level], level_offsets_[level + 1] - level_offsets_[level]);
+    }
+    
+private:
+    TaskGraph() = default;
+    
+    std::span<const TaskInfo> tasks_;
+    std::vector<std::uint32_t> ids_;         ///< Task ID -> index into tasks_
+    std::vector<std::string> keys_;
+    std::unordered_map<std::string, TaskId> index_;
+    std::vector<std::uint32_t> follower_offsets_;
+    std::vector<TaskId> follower_ids_;
+    std::vector<std::uint32_t> parent_offsets_;
+    std::vector<TaskId> parent_ids_;
+    std::vector<TaskId> order_;
+    std::vector<std::uint32_t> level_offsets_;
+};
+
 /// @brief Loader for task configuration files
 /// @note Handles loading and parsing of tasks.toml files
 class TaskLoader {
@@ -107,12 +246,14 @@ public:
     /// @brief Load all configurations from tasks using the generic factory
     /// @param tasks_file_path Path to the main tasks.toml file
     /// @return Vector of configuration objects or error
+    /// @note Task files are parsed concurrently; configs keep the task order
     [[nodiscard]] static ConfigResult<std::vector<ConfigPtr>> 
     load_configs_from_tasks(const std::string& tasks_file_path);
 
     /// @brief Build execution order respecting followBy dependencies
     /// @param tasks Vector of task information
     /// @return Vector of task keys in execution order or error if cycles detected
+    /// @note Shorthand for TaskGraph::build when only the keys are needed
     [[nodiscard]] static ConfigResult<std::vector<std::string>>
     build_execution_order(const std::vector<TaskInfo>& tasks);
 
@@ -189,6 +330,55 @@ private:
             task_info.enabled = true; // Default to enabled
         }
         
+        // Parse once field ("disable_after" is accepted as an alias): retry until success
+        for (const char* once_key : {"once", "disable_after"}) {
+            if (auto once = task_table->get(once_key)) {
+                if (auto once_val = once->value<bool>()) {
+                    task_info.policy = *once_val ? TaskPolicy::until_success : TaskPolicy::always;
+                }
+            }
+        }
+        
+        // Parse policy field (takes precedence over once)
+        if (auto policy = task_table->get("policy")) {
+            if (auto policy_str = policy->value<std::string>()) {
+                if (auto parsed = policy_from_string(*policy_str)) {
+                    task_info.policy = *parsed;
+                } else {
+                    LOG_WARNING("Task '{}' has unknown policy '{}', using 'always'", key_str, *policy_str);
+                }
+            }
+        }
+        if (auto every_n = task_table->get("every_n")) {
+            if (auto period = every_n->value<std::int64_t>(); period && *period >= 1 && *period <= std::numeric_limits<std::uint32_t>::max()) {
+                task_info.every_n = static_cast<std::uint32_t>(*period);
+            } else {
+                LOG_WARNING("Task '{}' has an invalid every_n, running on every call", key_str);
+            }
+        }
+        
+        // Parse execution field
+        if (auto execution = task_table->get("execution")) {
+            if (auto execution_str = execution->value<std::string>()) {
+                if (auto mode = execution_from_string(*execution_str)) {
+                    task_info.execution = *mode;
+                } else {
+                    LOG_WARNING("Task '{}' has unknown execution mode '{}', using 'hook'", key_str, *execution_str);
+                }
+            }
+        }
+        
+        // Parse stub field
+        if (auto stub = task_table->get("stub")) {
+            if (auto stub_str = stub->value<std::string>()) {
+                if (auto kind = stub_from_string(*stub_str)) {
+                    task_info.stub = *kind;
+                } else {
+                    LOG_WARNING("Task '{}' has unknown stub '{}', using 'minimal'", key_str, *stub_str);
+                }
+            }
+        }
+        
         return task_info;
     }
 };
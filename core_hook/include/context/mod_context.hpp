@@ -1,10 +1,18 @@
 #pragma once
 
 #include "util/logger.hpp"
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
+#include <string_view>
 #include <any>
 #include <typeinfo>
 #include <type_traits>
@@ -12,136 +20,529 @@
 
 namespace app_hook::context {
 
+/// @brief Interned handle of a ModContext key
+/// @note Obtained once from ModContext::intern and valid for the lifetime of
+///       that context; the slot stays reserved even when its data is removed
+class ContextKey {
+public:
+    /// @brief Construct an invalid handle
+    constexpr ContextKey() noexcept = default;
+
+    /// @brief Check if the handle refers to a slot
+    [[nodiscard]] constexpr bool valid() const noexcept { return slot_ != kInvalidSlot; }
+
+    /// @brief Check if the handle refers to a slot
+    [[nodiscard]] constexpr explicit operator bool() const noexcept { return valid(); }
+
+    /// @brief Get the slot index
+    [[nodiscard]] constexpr std::uint32_t slot() const noexcept { return slot_; }
+
+    [[nodiscard]] constexpr bool operator==(const ContextKey&) const noexcept = default;
+
+private:
+    friend class ModContext;
+
+    static constexpr std::uint32_t kInvalidSlot = ~std::uint32_t{0};
+
+    constexpr explicit ContextKey(std::uint32_t slot) noexcept : slot_(slot) {}
+
+    std::uint32_t slot_ = kInvalidSlot;
+};
+
 /// @brief Thread-safe generic context for mod operations
 /// @note Stores any type of data using std::any for maximum flexibility
 /// @note For move-only types, data is wrapped in shared_ptr automatically
+///
+/// Every key is interned to a slot the first time it is used. The string-keyed
+/// API hashes the key under a shared lock to find the slot; hot paths intern
+/// their key once and then use get/store with the ContextKey, which index the
+/// slot table directly. A stored value is described by the typeid of the object
+/// and a pointer to it, recorded at store time, so typed reads compare type_info
+/// instead of probing std::any.
+///
+/// The context is read-mostly: slots are append-only and each publishes an
+/// immutable cell, so handle reads and key iteration take no lock at all, and
+/// string lookups only take the lock shared. Writers (store, remove, interning a
+/// new key) serialize on the exclusive lock and never block lock-free readers.
+///
+/// A replaced cell, value included, is reclaimed by epochs: it is freed by a
+/// later write once no ReadGuard entered before the replacement is still held.
+/// Readers of a slot other threads may store to hold a guard while they use the
+/// value; hook dispatch holds one on the global instance around its tasks.
 class ModContext {
 public:
+    /// @brief Keeps the values read from a context alive while held
+    /// @note Two atomic adds on a per-thread counter; guards may nest
+    class ReadGuard {
+    public:
+        ~ReadGuard() { counter_->fetch_sub(1, std::memory_order_seq_cst); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard(ReadGuard&&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+    private:
+        friend class ModContext;
+
+        explicit ReadGuard(std::atomic<std::uint32_t>* counter) noexcept : counter_(counter) {}
+
+        std::atomic<std::uint32_t>* counter_;
+    };
+
+    /// @brief Memory held by the values of one stored type
+    struct TypeUsage {
+        const std::type_info* type = nullptr;  ///< Stored type (the pointee for shared_ptr values)
+        std::size_t count = 0;                 ///< Number of keys holding the type
+        std::size_t bytes = 0;                 ///< Object and owned heap bytes of those values
+    };
+
     ModContext() = default;
-    ~ModContext() = default;
-    
+
+    ~ModContext() {
+        if (skip_teardown_) {
+            for (auto& retired : retired_) {
+                (void)retired.cell.release();
+            }
+            return;
+        }
+        for (auto& chunk : chunks_) {
+            if (auto* slots = chunk.load(std::memory_order_relaxed)) {
+                for (std::size_t i = 0; i < kChunkSize; ++i) {
+                    delete slots[i].cell.load(std::memory_order_relaxed);
+                }
+                delete[] slots;
+            }
+        }
+    }
+
     // Non-copyable, non-movable singleton-like
     ModContext(const ModContext&) = delete;
     ModContext& operator=(const ModContext&) = delete;
     ModContext(ModContext&&) = delete;
     ModContext& operator=(ModContext&&) = delete;
-    
+
+    /// @brief Intern a key
+    /// @param key Data key (e.g., "ff8.magic.k_magic_data")
+    /// @return Handle of the key's slot, or an invalid handle if the table is full
+    [[nodiscard]] ContextKey intern(const std::string& key) {
+        if (const auto existing = find_key(key)) {
+            return existing;
+        }
+        std::unique_lock lock{mutex_};
+        return intern_locked(key);
+    }
+
+    /// @brief Find an interned key without creating it
+    /// @param key Data key
+    /// @return Handle of the key's slot, or an invalid handle if never interned
+    [[nodiscard]] ContextKey find_key(const std::string& key) const {
+        std::shared_lock lock{mutex_};
+        const auto it = index_.find(key);
+        return it != index_.end() ? ContextKey{it->second} : ContextKey{};
+    }
+
+    /// @brief Get the string of an interned key
+    /// @param key Handle from intern
+    /// @return Key string (empty for an invalid handle)
+    [[nodiscard]] const std::string& key_name(ContextKey key) const noexcept {
+        static const std::string empty;
+        const auto* slot = find_slot(key);
+        return slot ? slot->key : empty;
+    }
+
+    /// @brief Store data in an interned slot
+    /// @tparam T Type of data to store
+    /// @param key Handle from intern
+    /// @param data Data to store
+    /// @return false if the handle is invalid
+    template<typename T>
+    bool store(ContextKey key, T&& data) {
+        auto* slot = find_slot(key);
+        if (!slot) {
+            return false;
+        }
+        auto cell = make_cell(std::forward<T>(data));
+        std::unique_lock lock{mutex_};
+        replace_cell(*slot, std::move(cell));
+        return true;
+    }
+
+    /// @brief Get data from an interned slot
+    /// @tparam T Expected type of the data
+    /// @param key Handle from intern
+    /// @return Pointer to data of type T, or nullptr if empty or wrong type
+    /// @note Lock-free. When other threads may store to or remove the slot, call it
+    ///       under a ReadGuard: the pointer stays valid while the guard is held
+    template<typename T>
+    [[nodiscard]] T* get(ContextKey key) const noexcept {
+        const auto* slot = find_slot(key);
+        if (!slot) {
+            return nullptr;
+        }
+        // Ordered after the guard's count, which a writer checks after its exchange
+        const auto* cell = slot->cell.load(std::memory_order_seq_cst);
+        if (!cell) {
+            return nullptr;
+        }
+        if (cell->type && *cell->type == typeid(T)) {
+            return static_cast<T*>(cell->object);
+        }
+        if (cell->inner_type && *cell->inner_type == typeid(T)) {
+            return static_cast<T*>(cell->inner);
+        }
+        return nullptr;
+    }
+
+    /// @brief Check if an interned slot holds data
+    /// @param key Handle from intern
+    /// @return true if data exists
+    [[nodiscard]] bool has(ContextKey key) const noexcept {
+        const auto* slot = find_slot(key);
+        return slot && slot->cell.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /// @brief Remove the data of an interned slot
+    /// @param key Handle from intern (stays valid)
+    /// @return true if data was removed
+    bool remove(ContextKey key) {
+        auto* slot = find_slot(key);
+        if (!slot) {
+            return false;
+        }
+        std::unique_lock lock{mutex_};
+        return replace_cell(*slot, nullptr);
+    }
+
     /// @brief Store data with the given key
     /// @tparam T Type of data to store
     /// @param key Data key (e.g., "ff8.magic.k_magic_data")
     /// @param data Data to store
     template<typename T>
     void store_data(const std::string& key, T&& data) {
-        std::lock_guard lock{mutex_};
-        
         // For move-only types, wrap in shared_ptr
         if constexpr (!std::is_copy_constructible_v<std::decay_t<T>>) {
             LOG_DEBUG("Storing move-only type for key: {}", key);
-            data_[key] = std::make_shared<std::decay_t<T>>(std::forward<T>(data));
         } else {
             LOG_DEBUG("Storing copyable type for key: {}", key);
-            data_[key] = std::forward<T>(data);
+        }
+        auto cell = make_cell(std::forward<T>(data));
+
+        std::unique_lock lock{mutex_};
+        if (auto* slot = find_slot(intern_locked(key))) {
+            replace_cell(*slot, std::move(cell));
+        } else {
+            LOG_ERROR("ModContext is full - cannot store key: {}", key);
         }
     }
-    
+
     /// @brief Get data by key
     /// @tparam T Expected type of the data
     /// @param key Data key
     /// @return Pointer to data of type T, or nullptr if not found or wrong type
     template<typename T>
     [[nodiscard]] T* get_data(const std::string& key) {
-        std::lock_guard lock{mutex_};
-        if (auto it = data_.find(key); it != data_.end()) {
-            try {
-                // Try direct access first
-                if (auto* direct = std::any_cast<T>(&it->second)) {
-                    return direct;
-                }
-                // Try shared_ptr access for move-only types
-                if (auto* shared = std::any_cast<std::shared_ptr<T>>(&it->second)) {
-                    return shared->get();
-                }
-            } catch (const std::bad_any_cast&) {
-                // Type mismatch
-                LOG_ERROR("Type mismatch for key: {}", key);
-            }
-        }
-        return nullptr;
+        return get<T>(find_key(key));
     }
-    
+
     /// @brief Get const data by key
     /// @tparam T Expected type of the data
     /// @param key Data key
     /// @return Const pointer to data of type T, or nullptr if not found or wrong type
     template<typename T>
     [[nodiscard]] const T* get_data(const std::string& key) const {
-        std::lock_guard lock{mutex_};
-        if (auto it = data_.find(key); it != data_.end()) {
-            try {
-                // Try direct access first
-                if (const auto* direct = std::any_cast<T>(&it->second)) {
-                    return direct;
-                }
-                // Try shared_ptr access for move-only types
-                if (const auto* shared = std::any_cast<std::shared_ptr<T>>(&it->second)) {
-                    return shared->get();
-                }
-            } catch (const std::bad_any_cast&) {
-                // Type mismatch
-            }
-        }
-        return nullptr;
+        return get<T>(find_key(key));
     }
-    
+
     /// @brief Check if data exists with the given key
     /// @param key Data key
     /// @return true if data exists
     [[nodiscard]] bool has_data(const std::string& key) const {
-        std::lock_guard lock{mutex_};
-        return data_.contains(key);
+        return has(find_key(key));
     }
-    
+
     /// @brief Get the type info of stored data
     /// @param key Data key
     /// @return Type info of the stored data, or nullptr if key not found
     [[nodiscard]] const std::type_info* get_data_type(const std::string& key) const {
-        std::lock_guard lock{mutex_};
-        if (auto it = data_.find(key); it != data_.end()) {
-            return &it->second.type();
+        std::shared_lock lock{mutex_};
+        const auto it = index_.find(key);
+        if (it == index_.end()) {
+            return nullptr;
         }
-        return nullptr;
+        const auto* cell = find_slot(ContextKey{it->second})->cell.load(std::memory_order_acquire);
+        return cell ? &cell->value.type() : nullptr;
     }
-    
+
     /// @brief Remove data with the given key
     /// @param key Data key
     /// @return true if data was removed
     [[nodiscard]] bool remove_data(const std::string& key) {
-        std::lock_guard lock{mutex_};
-        return data_.erase(key) > 0;
+        std::unique_lock lock{mutex_};
+        const auto it = index_.find(key);
+        return it != index_.end() && replace_cell(*find_slot(ContextKey{it->second}), nullptr);
+    }
+
+    /// @brief Visit every key holding data, without locking or copying keys
+    /// @tparam F Callable as fn(const std::string& key, ContextKey handle)
+    /// @param prefix Only visit keys starting with this prefix (empty for all)
+    /// @param fn Visitor; may store to or remove the visited key
+    /// @note Keys interned while iterating may or may not be visited
+    template<typename F>
+    void for_each_key(std::string_view prefix, F&& fn) const {
+        const auto count = slot_count_.load(std::memory_order_acquire);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const auto& slot = *find_slot(ContextKey{i});
+            if (slot.cell.load(std::memory_order_acquire) && std::string_view{slot.key}.starts_with(prefix)) {
+                fn(slot.key, ContextKey{i});
+            }
+        }
     }
-    
+
     /// @brief Get all keys in the context
     /// @return Vector of all stored keys
+    /// @note Prefer for_each_key, which does not copy
     [[nodiscard]] std::vector<std::string> get_all_keys() const {
-        std::lock_guard lock{mutex_};
         std::vector<std::string> keys;
-        keys.reserve(data_.size());
-        for (const auto& [key, _] : data_) {
-            keys.push_back(key);
-        }
+        keys.reserve(slot_count_.load(std::memory_order_acquire));
+        for_each_key({}, [&keys](const std::string& key, ContextKey) { keys.push_back(key); });
         return keys;
     }
-    
+
+    /// @brief Get the memory held by stored values, grouped by type
+    /// @return One entry per stored type, in order of first appearance
+    /// @note Lock-free like for_each_key; a value counts sizeof(T) plus the heap it owns
+    ///       when T has footprint_bytes(), is a shared_ptr or is a contiguous container
+    [[nodiscard]] std::vector<TypeUsage> usage_by_type() const {
+        const auto guard = read_guard();
+        std::vector<TypeUsage> usage;
+        for_each_key({}, [this, &usage](const std::string&, ContextKey key) {
+            const auto* cell = find_slot(key)->cell.load(std::memory_order_acquire);
+            if (!cell) {
+                return;
+            }
+            const auto* type = cell->inner_type ? cell->inner_type : cell->type;
+            auto it = std::find_if(usage.begin(), usage.end(),
+                                   [type](const TypeUsage& entry) { return *entry.type == *type; });
+            if (it == usage.end()) {
+                it = usage.insert(usage.end(), TypeUsage{type, 0, 0});
+            }
+            ++it->count;
+            it->bytes += cell->bytes;
+        });
+        return usage;
+    }
+
+    /// @brief Enter a read of values other threads may replace
+    /// @return Guard keeping every value read while it is held alive
+    [[nodiscard]] ReadGuard read_guard() const noexcept {
+        auto& stripe = readers_[reader_stripe()];
+        for (;;) {
+            // Counted under the epoch it entered; a writer that advanced the epoch
+            // meanwhile may have missed the count, so it enters again
+            const auto epoch = epoch_.load(std::memory_order_seq_cst);
+            auto& counter = stripe.count[epoch & 1];
+            counter.fetch_add(1, std::memory_order_seq_cst);
+            if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+                return ReadGuard{&counter};
+            }
+            counter.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    /// @brief Get the number of replaced cells not freed yet
+    /// @return Retired cells waiting for their readers to leave
+    [[nodiscard]] std::size_t retired_count() const {
+        std::shared_lock lock{mutex_};
+        return retired_.size();
+    }
+
+    /// @brief Get the memory held by the context itself
+    /// @return Slot table, key strings, key index and retired cells, values excluded
+    [[nodiscard]] std::size_t table_bytes() const {
+        std::shared_lock lock{mutex_};
+        std::size_t bytes = retired_.capacity() * sizeof(Retired) + retired_.size() * sizeof(Cell);
+        for (const auto& chunk : chunks_) {
+            if (chunk.load(std::memory_order_acquire)) {
+                bytes += kChunkSize * sizeof(Slot);
+            }
+        }
+        for (const auto& [key, slot] : index_) {
+            // Each key is held twice: by its slot and by the index node
+            bytes += 2 * key.capacity() + sizeof(std::pair<const std::string, std::uint32_t>) + 2 * sizeof(void*);
+        }
+        return bytes + index_.bucket_count() * sizeof(void*);
+    }
+
+    /// @brief Leave the stored values in place when the context is destroyed
+    /// @note For a process that is exiting: its memory is about to go away, so
+    ///       freeing every region and buffer one by one only delays the exit
+    void skip_teardown() noexcept { skip_teardown_ = true; }
+
     /// @brief Get the global instance
     [[nodiscard]] static ModContext& instance() {
         static ModContext instance;
-        LOG_DEBUG("ModContext instance : 0x{:X}", reinterpret_cast<uintptr_t>(&instance));
         return instance;
     }
-    
+
 private:
-    mutable std::mutex mutex_;
-    std::unordered_map<std::string, std::any> data_;
+    /// @brief Stored value with its resolved object pointers
+    /// @note Immutable once published to a slot
+    struct Cell {
+        std::any value;
+        void* object = nullptr;                     ///< The stored object inside value
+        const std::type_info* type = nullptr;       ///< Type of *object
+        void* inner = nullptr;                      ///< Pointee when the object is a shared_ptr
+        const std::type_info* inner_type = nullptr; ///< Type of *inner
+        std::size_t bytes = 0;                      ///< Object and owned heap bytes (see usage_by_type)
+    };
+
+    /// @brief One interned key
+    struct Slot {
+        std::string key;
+        std::atomic<Cell*> cell{nullptr};
+    };
+
+    /// @brief Replaced cell and the epoch it was replaced in
+    struct Retired {
+        std::unique_ptr<Cell> cell;
+        std::uint64_t epoch = 0;
+    };
+
+    /// @brief Guards held by the threads of one stripe, by epoch parity
+    struct alignas(64) ReaderStripe {
+        std::array<std::atomic<std::uint32_t>, 2> count{};
+    };
+
+    static constexpr std::size_t kReaderStripes = 16;
+
+    /// @brief Get the reader stripe of the calling thread
+    [[nodiscard]] static std::size_t reader_stripe() noexcept {
+        static std::atomic<std::size_t> next{0};
+        thread_local const std::size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % kReaderStripes;
+        return stripe;
+    }
+
+    template<typename T> struct is_shared_ptr : std::false_type {};
+    template<typename T> struct is_shared_ptr<std::shared_ptr<T>> : std::true_type { using element = T; };
+
+    /// @brief Estimate the memory held by a value
+    template<typename Value>
+    [[nodiscard]] static std::size_t footprint_of(const Value& value) noexcept {
+        if constexpr (requires { { value.footprint_bytes() } -> std::convertible_to<std::size_t>; }) {
+            return value.footprint_bytes();
+        } else if constexpr (is_shared_ptr<Value>::value) {
+            using Element = std::remove_cv_t<typename is_shared_ptr<Value>::element>;
+            if constexpr (std::is_void_v<Element> || std::is_array_v<Element>) {
+                return sizeof(Value);
+            } else {
+                return sizeof(Value) + (value ? footprint_of(*value) : 0);
+            }
+        } else if constexpr (requires { value.capacity(); value.data(); typename Value::value_type; }) {
+            return sizeof(Value) + value.capacity() * sizeof(typename Value::value_type);
+        } else {
+            return sizeof(Value);
+        }
+    }
+
+    static constexpr std::size_t kChunkBits = 8;
+    static constexpr std::size_t kChunkSize = std::size_t{1} << kChunkBits;
+    static constexpr std::size_t kMaxChunks = 4096;  ///< Up to one million keys
+
+    /// @brief Build the cell of a value
+    template<typename T>
+    [[nodiscard]] static std::unique_ptr<Cell> make_cell(T&& data) {
+        using Value = std::decay_t<T>;
+        auto cell = std::make_unique<Cell>();
+        if constexpr (!std::is_copy_constructible_v<Value>) {
+            // std::any needs copyable contents
+            cell->value = std::make_shared<Value>(std::forward<T>(data));
+            resolve(*cell, std::any_cast<std::shared_ptr<Value>>(&cell->value));
+        } else {
+            cell->value = std::forward<T>(data);
+            resolve(*cell, std::any_cast<Value>(&cell->value));
+        }
+        return cell;
+    }
+
+    /// @brief Record the object pointers of a cell
+    template<typename Value>
+    static void resolve(Cell& cell, Value* object) noexcept {
+        cell.object = object;
+        cell.type = &typeid(Value);
+        cell.bytes = footprint_of(*object);
+        if constexpr (is_shared_ptr<Value>::value) {
+            cell.inner = const_cast<void*>(static_cast<const void*>(object->get()));
+            cell.inner_type = &typeid(typename Value::element_type);
+        }
+    }
+
+    /// @brief Get the slot of a handle without locking
+    [[nodiscard]] Slot* find_slot(ContextKey key) const noexcept {
+        if (!key.valid() || key.slot() >= slot_count_.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        auto* chunk = chunks_[key.slot() >> kChunkBits].load(std::memory_order_acquire);
+        return chunk ? &chunk[key.slot() & (kChunkSize - 1)] : nullptr;
+    }
+
+    /// @brief Find or create the slot of a key (caller holds mutex_ exclusively)
+    [[nodiscard]] ContextKey intern_locked(const std::string& key) {
+        if (const auto it = index_.find(key); it != index_.end()) {
+            return ContextKey{it->second};
+        }
+
+        const auto slot = slot_count_.load(std::memory_order_relaxed);
+        const auto chunk = slot >> kChunkBits;
+        if (chunk >= kMaxChunks) {
+            return {};
+        }
+        if (!chunks_[chunk].load(std::memory_order_relaxed)) {
+            chunks_[chunk].store(new Slot[kChunkSize], std::memory_order_release);
+        }
+        chunks_[chunk].load(std::memory_order_relaxed)[slot & (kChunkSize - 1)].key = key;
+        index_.emplace(key, slot);
+        slot_count_.store(slot + 1, std::memory_order_release);
+        return ContextKey{slot};
+    }
+
+    /// @brief Publish a new cell in a slot (caller holds mutex_ exclusively)
+    /// @return true if the slot held a value
+    bool replace_cell(Slot& slot, std::unique_ptr<Cell> cell) {
+        auto* previous = slot.cell.exchange(cell.release(), std::memory_order_seq_cst);
+        if (!previous) {
+            return false;
+        }
+        // A guarded reader may still use the value: the cell is freed whole, later
+        retired_.push_back(Retired{std::unique_ptr<Cell>(previous), epoch_.load(std::memory_order_seq_cst)});
+        reclaim_locked();
+        return true;
+    }
+
+    /// @brief Free the retired cells no reader can see, then advance the epoch
+    /// @note Caller holds mutex_ exclusively. Guards are only ever held in the
+    ///       current epoch or the one before it: once the one before has none, the
+    ///       cells retired up to it are unreachable and the epoch can move on
+    void reclaim_locked() {
+        const auto epoch = epoch_.load(std::memory_order_seq_cst);
+        const auto previous = (epoch - 1) & 1;
+        for (const auto& stripe : readers_) {
+            if (stripe.count[previous].load(std::memory_order_seq_cst) != 0) {
+                return;
+            }
+        }
+        std::erase_if(retired_, [epoch](const Retired& retired) { return retired.epoch < epoch; });
+        epoch_.store(epoch + 1, std::memory_order_seq_cst);
+    }
+
+    mutable std::shared_mutex mutex_;                       ///< Shared for lookups, exclusive for writes
+    std::unordered_map<std::string, std::uint32_t> index_;  ///< Key -> slot (guarded by mutex_)
+    std::array<std::atomic<Slot*>, kMaxChunks> chunks_{};
+    std::atomic<std::uint32_t> slot_count_{0};
+    std::vector<Retired> retired_;                          ///< Replaced cells (guarded by mutex_)
+    std::atomic<std::uint64_t> epoch_{1};                   ///< Reclamation epoch, advanced by writers
+    mutable std::array<ReaderStripe, kReaderStripes> readers_{};
+    bool skip_teardown_ = false;                            ///< Destructor leaves the cells alone
 };
 
 } // namespace app_hook::context
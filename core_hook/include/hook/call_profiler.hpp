@@ -0,0 +1,164 @@
+#pragma once
+
+#include "../config/config_common.hpp"
+#include "stub_arena.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace app_hook::hook {
+
+/// @brief Counters updated by the profiling stub of one address
+/// @note The stub increments each 64-bit counter as two locked 32-bit adds, so a
+///       reader may briefly see the low half wrap before the high half catches up;
+///       read them with CallProfiler::read_counter
+struct alignas(64) ProbeCounters {
+    std::uint64_t calls = 0;        ///< Times the address was reached
+    std::uint64_t ticks = 0;        ///< Time stamp counter ticks spent in timed calls, callees included
+    void* trampoline = nullptr;     ///< Original code, resumed by the timed entry routine
+};
+
+/// @brief Settings of a profile task, read from its config file
+struct ProfileOptions {
+    std::vector<std::uintptr_t> addresses;  ///< Addresses to count, sorted and unique
+    bool timing = false;                    ///< Also time calls (addresses must be function entries)
+    std::string report_path = "logs/call_profile.toml";
+};
+
+/// @brief Calls and time measured at one address
+struct ProfileEntry {
+    std::uintptr_t address = 0;
+    std::uint64_t calls = 0;
+    double calls_per_second = 0.0;
+    double time_share = 0.0;      ///< Share of the wall time spent in the calls (0 without timing)
+    std::uint64_t mean_ns = 0;    ///< Mean duration of a call (0 without timing)
+};
+
+/// @brief Result of a profiling run, most called address first
+struct ProfileReport {
+    double seconds = 0.0;         ///< Length of the profiling window
+    bool timed = false;
+    std::size_t skipped = 0;      ///< Addresses that could not be probed
+    std::vector<ProfileEntry> entries;
+};
+
+/// @brief Counts calls to a list of addresses without going through dispatch_hook
+///
+/// Each address gets its own stub in a StubArena: two locked adds on its
+/// ProbeCounters, then a jump to the MinHook trampoline. No C++ runs on a call.
+/// With timing on, the stub instead hands over to a shared entry routine that
+/// pushes the return address and an rdtsc reading onto a per-thread shadow stack
+/// and swaps the return address for an exit routine, which adds the elapsed
+/// ticks and returns to the caller. Timed addresses must therefore be function
+/// entries. A call left by an exception, SEH unwind or longjmp is counted but not
+/// timed; each frame records its stack address, and the next timed entry or
+/// return on the thread drops frames that are no longer on the stack. The shared
+/// routines and shadow stacks live until the process exits, since a timed call
+/// may still be on a stack when profiling stops.
+///
+/// Probes are installed after the hooks, on addresses no hook claimed, and
+/// removed by stop(), which writes the report.
+class CallProfiler {
+public:
+    /// @brief Calls per second from which the report flags a hot address
+    static constexpr double kHotCallsPerSecond = 10'000.0;
+
+    /// @brief Bytes a probe overwrites at its address (MinHook's jmp)
+    static constexpr std::uintptr_t kPatchSize = 5;
+
+    CallProfiler() = default;
+    ~CallProfiler() { release(); }
+
+    // Non-copyable, non-movable (stubs hold pointers to the counters)
+    CallProfiler(const CallProfiler&) = delete;
+    CallProfiler& operator=(const CallProfiler&) = delete;
+    CallProfiler(CallProfiler&&) = delete;
+    CallProfiler& operator=(CallProfiler&&) = delete;
+
+    /// @brief Read a profile task's config file
+    /// @param path Config file path; ida_csv is resolved next to it
+    /// @return Options, or the reason the file cannot be used
+    [[nodiscard]] static config::ConfigResult<ProfileOptions> load_options(const std::filesystem::path& path);
+
+    /// @brief Extract the addresses of an IDA CSV export
+    /// @param text CSV text, separated by tabs, commas or semicolons
+    /// @param column Column holding the address (hex, with or without 0x)
+    /// @return Sorted unique addresses; rows whose column is not an address are skipped
+    [[nodiscard]] static std::vector<std::uintptr_t> parse_ida_csv(std::string_view text, std::size_t column = 0);
+
+    /// @brief Get the stub code of a probe, before it is bound to its counters
+    /// @param timed Stub of a timed probe
+    /// @return Stub bytes (counter, probe and jump operands are zero)
+    [[nodiscard]] static std::span<const std::uint8_t> probe_stub_code(bool timed) noexcept;
+
+    /// @brief Read a counter updated by a stub
+    [[nodiscard]] static std::uint64_t read_counter(const std::uint64_t& counter) noexcept;
+
+    /// @brief Add the addresses and settings of a profile task
+    /// @param options Options of the task
+    /// @note Call before install(); timing and the report path apply to every probe
+    void add(const ProfileOptions& options);
+
+    /// @brief Get the number of addresses to profile
+    [[nodiscard]] std::size_t probe_count() const noexcept { return addresses_.size(); }
+
+    /// @brief Check if calls are timed
+    [[nodiscard]] bool timed() const noexcept { return timed_; }
+
+    /// @brief Create and enable every probe in one batch
+    /// @param hooked Addresses already hooked, left to the hooks' own statistics
+    /// @return Number of probes installed
+    /// @note MinHook must be initialized. Addresses within kPatchSize bytes of a hook
+    ///       or of a lower probe are skipped, since their patches would overlap
+    std::size_t install(std::span<const std::uintptr_t> hooked = {});
+
+    /// @brief Disable the probes and write the report
+    /// @return True if there was nothing to report or the report was written
+    bool stop();
+
+    /// @brief Build the report of the installed probes
+    [[nodiscard]] ProfileReport report() const;
+
+    /// @brief Sort samples into a report
+    /// @param addresses Probed addresses
+    /// @param counters Counters of each address
+    /// @param seconds Length of the profiling window
+    /// @param ticks_per_second Time stamp counter frequency (0 without timing)
+    [[nodiscard]] static ProfileReport make_report(std::span<const std::uintptr_t> addresses,
+                                                   std::span<const ProbeCounters> counters,
+                                                   double seconds, double ticks_per_second);
+
+    /// @brief Format a report as TOML
+    [[nodiscard]] static std::string format_report(const ProfileReport& report);
+
+    /// @brief Free the stubs and, when no timed call is in flight, the counters
+    /// @note Called once MinHook no longer routes calls to the stubs
+    void release();
+
+private:
+    /// @brief Probe installed at one address
+    struct Probe {
+        std::uintptr_t address = 0;
+        void* stub = nullptr;
+    };
+
+    std::vector<std::uintptr_t> addresses_;     ///< Sorted addresses to profile
+    std::vector<Probe> probes_;                 ///< Installed probes
+    std::unique_ptr<ProbeCounters[]> counters_; ///< Counters of probes_, same order
+    StubArena stubs_;
+    bool timed_ = false;
+    bool running_ = false;
+    std::size_t skipped_ = 0;
+    std::string report_path_ = ProfileOptions{}.report_path;
+    std::uint64_t start_qpc_ = 0;
+    std::uint64_t start_tsc_ = 0;
+    double seconds_ = 0.0;
+    double ticks_per_second_ = 0.0;
+};
+
+} // namespace app_hook::hook
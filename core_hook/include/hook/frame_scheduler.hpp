@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../config/config_common.hpp"
+#include "../task/hook_task.hpp"
+#include "hook_stats.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+
+namespace app_hook::hook {
+
+/// @brief Settings of a frame task, read from its config file
+struct FrameOptions {
+    std::uintptr_t anchor = 0;          ///< Address of the game's present/flip routine
+    std::uint32_t budget_us = 2'000;    ///< Time deferred tasks may take per frame
+};
+
+/// @brief Frame statistics of the anchor
+struct FrameStats {
+    std::uint64_t frames = 0;           ///< Anchor calls seen
+    TimingSnapshot framework;           ///< Time spent in hooks per frame, deferred work included
+    TimingSnapshot deferred;            ///< Time spent draining deferred work per frame
+    std::uint64_t deferred_runs = 0;    ///< Deferred jobs run
+    std::uint64_t over_budget = 0;      ///< Frames whose drain went past the budget
+    std::size_t pending = 0;            ///< Deferred jobs still queued
+};
+
+/// @brief Spreads deferrable hook work across frames
+///
+/// A frame task hooks the game's present/flip routine (the anchor). Hooks with
+/// tasks whose execution is "deferred" queue them here instead of running them
+/// in the hooked call, and each anchor call drains the queue on the game thread
+/// until the frame's budget is spent. A job is a hook's whole deferred chain and
+/// is never split, so one frame always runs at least one job even if it takes
+/// longer than the budget. A hook triggered again while its job is still queued
+/// is not queued twice.
+///
+/// The anchor also closes a frame's accounting: dispatch_hook adds the time of
+/// every hooked call, and each anchor call records the sum since the previous one.
+class FrameScheduler {
+public:
+    /// @brief Deferred job: a function and its state (no allocation per trigger)
+    struct Job {
+        void (*fn)(void* state);
+        void* state;
+    };
+
+    FrameScheduler() = default;
+
+    // Non-copyable, non-movable (the anchor task holds a pointer to the scheduler)
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+    FrameScheduler(FrameScheduler&&) = delete;
+    FrameScheduler& operator=(FrameScheduler&&) = delete;
+
+    /// @brief Read a frame task's config file
+    /// @param path Config file path
+    /// @return Options, or the reason the file cannot be used
+    [[nodiscard]] static config::ConfigResult<FrameOptions> load_options(const std::filesystem::path& path);
+
+    /// @brief Set the anchor and budget
+    /// @param options Options of the frame task
+    /// @note Call before the hooks are installed; the anchor hook itself is added by the caller
+    void configure(const FrameOptions& options) noexcept;
+
+    /// @brief Check if an anchor drains deferred work
+    [[nodiscard]] bool active() const noexcept { return anchor_ != 0; }
+
+    /// @brief Get the anchor address
+    /// @return Anchor address, 0 if no frame task configured one
+    [[nodiscard]] std::uintptr_t anchor() const noexcept { return anchor_; }
+
+    /// @brief Get the per-frame budget
+    [[nodiscard]] std::uint32_t budget_us() const noexcept { return budget_us_; }
+
+    /// @brief Queue a job for the next frames
+    /// @param job Job to run on the anchor's thread
+    /// @return false if no anchor is configured (the caller runs the job itself)
+    bool defer(Job job);
+
+    /// @brief Add the time of one hooked call to the current frame
+    /// @param ticks Duration in performance counter ticks
+    void add_framework_time(std::uint64_t ticks) noexcept {
+        if (active()) {
+            frame_ticks_.fetch_add(ticks, std::memory_order_relaxed);
+        }
+    }
+
+    /// @brief Close a frame and drain deferred jobs within the budget
+    /// @note Called by the anchor hook's task on the game thread
+    void on_frame();
+
+    /// @brief Get the number of queued jobs
+    [[nodiscard]] std::size_t pending() const;
+
+    /// @brief Take a snapshot of the frame statistics
+    [[nodiscard]] FrameStats stats() const;
+
+    /// @brief Drop the queued jobs and log the frame statistics
+    /// @return Number of jobs dropped
+    /// @note Called once the hooks no longer run, before they are destroyed
+    std::size_t shutdown();
+
+private:
+    std::uintptr_t anchor_ = 0;
+    std::uint32_t budget_us_ = FrameOptions{}.budget_us;
+    std::atomic<std::uint64_t> frame_ticks_{0};     ///< Hooked-call time since the last anchor call
+    mutable std::mutex mutex_;                      ///< Guards queue_
+    std::deque<Job> queue_;
+    TimingCounters framework_;
+    TimingCounters deferred_;
+    std::atomic<std::uint64_t> deferred_runs_{0};
+    std::atomic<std::uint64_t> over_budget_{0};
+};
+
+/// @brief Task of the anchor hook: closes the frame and drains deferred work
+class FrameAnchorTask final : public task::IHookTask {
+public:
+    /// @brief Construct an anchor task
+    /// @param scheduler Scheduler drained on each frame
+    explicit FrameAnchorTask(FrameScheduler& scheduler) noexcept : scheduler_(scheduler) {}
+
+    /// @brief Run one frame of the scheduler
+    /// @return Always succeeds
+    [[nodiscard]] task::TaskResult execute() override {
+        scheduler_.on_frame();
+        return {};
+    }
+
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+
+    [[nodiscard]] std::string name() const override { return "FrameAnchor"; }
+
+    [[nodiscard]] std::string description() const override {
+        return "Drain deferred hook work within the frame budget";
+    }
+
+private:
+    FrameScheduler& scheduler_;
+};
+
+} // namespace app_hook::hook
@@ -2,9 +2,11 @@
 
 #include "../config/config_loader.hpp"
 #include "../config/task_loader.hpp"
+#include "../config/config_cache.hpp"
 #include "../task/hook_task.hpp"
 #include "../task/task_factory.hpp"
 #include "hook_manager.hpp"
+#include "hot_reload.hpp"
 #include <vector>
 #include <unordered_map>
 #include <expected>
@@ -19,7 +21,8 @@ enum class FactoryError {
     config_load_failed,
     invalid_config,
     hook_creation_failed,
-    task_creation_failed
+    task_creation_failed,
+    task_execution_failed
 };
 
 /// @brief Result type for hook factory operations
@@ -41,10 +44,17 @@ public:
     /// @brief Create hooks from tasks configuration and add them to the manager
     /// @param tasks_path Path to tasks configuration file  
     /// @param manager Hook manager to add hooks to
+    /// @param reloader Hot reloader recording the created tasks (optional)
+    /// @param bundle Mod bundle of the config directory, serving the files it holds (optional)
+    /// @param pack_bundle Pack this launch's configs and data files into the config
+    ///        directory's mod bundle once the hooks exist
     /// @return Result of operation
     [[nodiscard]] static FactoryResult create_hooks_from_tasks(
         const std::string& tasks_path,
-        HookManager& manager);
+        HookManager& manager,
+        HotReloader* reloader = nullptr,
+        std::shared_ptr<const config::ModBundle> bundle = nullptr,
+        bool pack_bundle = false);
 
     /// @brief Create hooks from generic configurations and add them to the manager
     /// @param configs Vector of configurations to create hooks from
@@ -55,24 +65,49 @@ public:
         HookManager& manager);
     
 private:
-    /// @brief Process a single task with dependency handling
+    /// @brief Marker recorded for tasks that ran at install time instead of on a hook
+    static constexpr std::uintptr_t kEagerAddress = ~std::uintptr_t{0};
+    
+    /// @brief Upper bound on the threads parsing config files at install time
+    static constexpr std::size_t kMaxParseThreads = 8;
+    
+    /// @brief Load the configurations of a task
     /// @param task Task information
-    /// @param task_hook_addresses Map tracking where each task was hooked
-    /// @param task_info_map Map of task keys to task information for followBy lookup
-    /// @param manager Hook manager to add tasks to
+    /// @param cache Config cache serving unchanged config files
     /// @param config_dir Config directory to resolve relative paths
+    /// @return Configurations of the task or error
+    /// @note Called concurrently for different tasks
+    [[nodiscard]] static config::ConfigResult<std::vector<config::ConfigPtr>> load_task_configs(
+        const config::TaskInfo& task,
+        config::ConfigCache& cache,
+        const std::string& config_dir);
+    
+    /// @brief Process a single task with dependency handling
+    /// @param graph Task graph being processed in order
+    /// @param id Task to process
+    /// @param configs Configurations loaded for the task
+    /// @param task_hook_addresses Hook address of each task by ID (0 if not hooked)
+    /// @param task_dispatch Dispatch of each task by ID; worker and deferred are inherited by followers
+    /// @param manager Hook manager to add tasks to
+    /// @param reloader Hot reloader recording the created tasks, or nullptr
     /// @return Result of operation
     [[nodiscard]] static FactoryResult process_task_with_dependencies(
-        const config::TaskInfo& task,
-        std::unordered_map<std::string, std::uintptr_t>& task_hook_addresses,
-        const std::unordered_map<std::string, const config::TaskInfo*>& task_info_map,
+        const config::TaskGraph& graph,
+        config::TaskGraph::TaskId id,
+        const std::vector<config::ConfigPtr>& configs,
+        std::vector<std::uintptr_t>& task_hook_addresses,
+        std::vector<TaskDispatch>& task_dispatch,
         HookManager& manager,
-        const std::string& config_dir);
+        HotReloader* reloader);
     
-    /// @brief Extract task key from config file path
-    /// @param config_file Path to config file
-    /// @return Task key
-    [[nodiscard]] static std::string get_task_key_from_file(const std::string& config_file);
+    /// @brief Create and run a task immediately, without a hook
+    /// @param config Configuration of the task
+    /// @param task_key Key of the task the config belongs to
+    /// @param manager Hook manager keeping the task, to roll it back at uninstall
+    /// @param reloader Hot reloader recording the task, or nullptr
+    /// @return Result of operation
+    [[nodiscard]] static FactoryResult run_eager_task(const config::ConfigPtr& config, const std::string& task_key,
+                                                      HookManager& manager, HotReloader* reloader);
     
     /// @brief Create tasks for a specific address using the TaskFactory
     /// @param address Hook address
@@ -84,6 +119,13 @@ private:
         const std::vector<config::ConfigPtr>& configs,
         HookManager& manager);
 
+    /// @brief Give a hook the trigger policy of a task attached to it
+    /// @param task Task metadata carrying the policy
+    /// @param hook Hook the task was added to
+    /// @note The first task with a policy other than always sets it; later conflicting ones are ignored.
+    ///       A task asking for the full stub switches the hook to it
+    static void apply_task_policy(const config::TaskInfo& task, Hook& hook);
+
     /// @brief Extract hook address from a configuration
     /// @param config Configuration to extract address from
     /// @return Hook address or 0 if not found
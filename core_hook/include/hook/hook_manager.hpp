@@ -2,18 +2,36 @@
 
 #include "../task/hook_task.hpp"
 #include "../util/logger.hpp"
+#include "../util/memory_report.hpp"
+#include "../util/worker_pool.hpp"
+#include "call_profiler.hpp"
+#include "frame_scheduler.hpp"
+#include "hook_stats.hpp"
+#include "task_program.hpp"
+#include "trigger_trace.hpp"
+#include "trigger_policy.hpp"
 #include <MinHook.h>
 #include <unordered_map>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
 #include <cstdint>
 #include <expected>
+#include <span>
 
 namespace app_hook::hook {
 
+class Hook;
+class HookManager;
+
 // Forward declarations
-void* get_or_create_hook_handler(std::uintptr_t address);
-void* execute_hook_by_address(void* address);
+void* get_or_create_hook_handler(std::uintptr_t address, Hook* hook);
+void* dispatch_hook(Hook* hook);
+void* dispatch_hook_with_context(Hook* hook, task::CpuContext* context);
+void release_hook_handler(std::uintptr_t address);
+void release_hook_handlers();
 
 /// @brief Error codes for hook operations
 enum class HookError {
@@ -30,49 +48,151 @@ enum class HookError {
 /// @brief Hook operation result type
 using HookResult = std::expected<void, HookError>;
 
+/// @brief How HookManager::install_all enables the hooks it creates
+enum class InstallMode {
+    sequential,  ///< Create and enable each hook in turn (one thread freeze per hook)
+    batched      ///< Create every hook, queue all enables and apply them at once
+};
+
+/// @brief Which registers the stub generated for a hook saves around dispatch_hook
+enum class StubKind {
+    minimal,  ///< EAX, ECX, EDX and EFLAGS: dispatch_hook is cdecl and keeps the others
+    full      ///< Every general register and EFLAGS, passed to the tasks as a CpuContext
+};
+
+/// @brief Get the stub code of a kind, before it is bound to a hook
+/// @param kind Stub kind
+/// @return Stub bytes (the Hook*, call and jmp operands are zero)
+[[nodiscard]] std::span<const std::uint8_t> hook_stub_code(StubKind kind) noexcept;
+
 /// @brief Represents a single hook point with multiple chained tasks
 class Hook {
 public:
-    explicit Hook(std::uintptr_t address) : address_(address), trampoline_(nullptr) {}
+    explicit Hook(std::uintptr_t address) : address_(address), trampoline_(nullptr), handler_(nullptr) {}
     
     ~Hook() = default;
     
-    // Non-copyable but movable
+    // Non-copyable, non-movable (stubs hold a pointer to the hook)
     Hook(const Hook&) = delete;
     Hook& operator=(const Hook&) = delete;
-    Hook(Hook&&) = default;
-    Hook& operator=(Hook&&) = default;
+    Hook(Hook&&) = delete;
+    Hook& operator=(Hook&&) = delete;
     
     /// @brief Add a task to this hook
     /// @param task Task to add
-    void add_task(task::HookTaskPtr task) {
+    /// @param dispatch Run the task inline or on the owner's worker pool
+    /// @note Recompiles the task program; tasks are only added before install
+    void add_task(task::HookTaskPtr task, TaskDispatch dispatch = TaskDispatch::inline_call) {
         if (task) {
             tasks_.push_back(std::move(task));
+            task_stats_.push_back(std::make_unique<TimingCounters>());
+            dispatch_.push_back(dispatch);
+            if (tasks_.back()->needs_registers()) {
+                stub_kind_ = StubKind::full;
+            }
+            program_ = TaskProgram::compile(tasks_, task_stats_, dispatch_);
         }
     }
     
     /// @brief Execute all tasks chained to this hook
-    void execute_tasks() {
-        LOG_DEBUG("Hook at 0x{:X}: Executing {} task(s)", address_, tasks_.size());
+    /// @return true if every inline task succeeded
+    /// @note Worker and deferred tasks are queued first and report failures through their stats
+    bool execute_tasks() { return run_tasks() == 0; }
+    
+    /// @brief Execute all tasks chained to this hook and report which inline tasks failed
+    /// @param context Registers of the hooked code (full stub only), given to the inline tasks
+    /// @return Outcome bits (task_outcome_bit) of the failed inline tasks, 0 if all succeeded
+    std::uint32_t run_tasks(task::CpuContext* context = nullptr) {
+        if (program_.worker_entries() != 0) {
+            submit_worker_tasks();
+        }
+        if (program_.deferred_entries() != 0) {
+            defer_tasks();
+        }
         
-        for (size_t i = 0; i < tasks_.size(); ++i) {
-            const auto& task = tasks_[i];
-            LOG_DEBUG("Hook at 0x{:X}: Executing task {} of {}: '{}'", 
-                     address_, i + 1, tasks_.size(), task->name());
-            
-            if (auto result = task->execute(); !result) {
-                LOG_ERROR("Hook at 0x{:X}: Task '{}' failed with error code: {}", 
-                         address_, task->name(), static_cast<int>(result.error()));
-                // Log error but continue with other tasks
-            } else {
-                LOG_DEBUG("Hook at 0x{:X}: Task '{}' completed successfully", 
-                         address_, task->name());
+        std::uint32_t failed = 0;
+        const auto entries = program_.entries();
+        for (std::size_t i = 0; i < entries.size(); ++i) {
+            if (entries[i].dispatch == TaskDispatch::inline_call && !run_entry(entries[i], context)) {
+                failed |= task_outcome_bit(i);
             }
         }
-        
-        LOG_DEBUG("Hook at 0x{:X}: Completed execution of all {} task(s)", address_, tasks_.size());
+        return failed;
     }
     
+    /// @brief Get the compiled task program run by this hook
+    /// @return Task program
+    [[nodiscard]] const TaskProgram& program() const noexcept { return program_; }
+    
+    /// @brief Get the dispatch timing counters of this hook
+    /// @return Hook-level counters (time spent in dispatch, tasks included)
+    [[nodiscard]] TimingCounters& timing() noexcept { return stats_; }
+    
+    /// @brief Take a snapshot of this hook's statistics
+    /// @return Hook and per-task statistics
+    [[nodiscard]] HookStats stats() const {
+        HookStats result{address_, stats_.snapshot(), {}};
+        result.tasks.reserve(tasks_.size());
+        for (std::size_t i = 0; i < tasks_.size(); ++i) {
+            result.tasks.push_back(TaskStats{std::string(program_.name(i)), task_stats_[i]->snapshot()});
+        }
+        return result;
+    }
+    
+    /// @brief Reset this hook's statistics
+    void reset_stats() noexcept {
+        stats_.reset();
+        for (auto& counters : task_stats_) {
+            counters->reset();
+        }
+    }
+    
+    /// @brief Set which triggers run the hook's tasks
+    /// @param policy Trigger policy
+    /// @param period Call period of TriggerPolicy::every_n
+    void set_policy(TriggerPolicy policy, std::uint32_t period = 1) noexcept { gate_.configure(policy, period); }
+    
+    /// @brief Get the trigger policy
+    /// @return Policy set by set_policy (always by default)
+    [[nodiscard]] TriggerPolicy policy() const noexcept { return gate_.policy(); }
+    
+    /// @brief Mark this hook as run-once: it is removed after its first successful run
+    /// @param once true for TriggerPolicy::until_success, false for always
+    void set_once(bool once) noexcept { set_policy(once ? TriggerPolicy::until_success : TriggerPolicy::always); }
+    
+    /// @brief Check if this hook retires after running
+    /// @return true for the once and until_success policies
+    [[nodiscard]] bool once() const noexcept { return gate_.retires(); }
+    
+    /// @brief Get the gate deciding which triggers run the tasks
+    /// @return Trigger gate
+    [[nodiscard]] TriggerGate& gate() noexcept { return gate_; }
+    
+    /// @brief Check if a run-once hook has completed and no longer runs its tasks
+    /// @return true if the hook is retired
+    [[nodiscard]] bool retired() const noexcept { return gate_.retired(); }
+    
+    /// @brief Set the manager that owns this hook
+    /// @param owner Owning manager, notified when a run-once hook retires
+    void set_owner(HookManager* owner) noexcept { owner_ = owner; }
+    
+    /// @brief Get the manager that owns this hook
+    /// @return Owning manager or nullptr
+    [[nodiscard]] HookManager* owner() const noexcept { return owner_; }
+    
+    /// @brief Set which registers the hook's stub saves
+    /// @param kind Stub kind; full is kept once a task needs registers
+    /// @note Read when the hook is created, so set it before install
+    void set_stub_kind(StubKind kind) noexcept {
+        if (stub_kind_ != StubKind::full) {
+            stub_kind_ = kind;
+        }
+    }
+    
+    /// @brief Get which registers the hook's stub saves
+    /// @return Stub kind (minimal unless a task or the config asks for full)
+    [[nodiscard]] StubKind stub_kind() const noexcept { return stub_kind_; }
+    
     /// @brief Get the hook address
     /// @return Hook address
     [[nodiscard]] std::uintptr_t address() const noexcept { return address_; }
@@ -101,11 +221,74 @@ public:
     /// @return true if there are tasks
     [[nodiscard]] bool has_tasks() const noexcept { return !tasks_.empty(); }
     
+    /// @brief Undo the effects of the hook's tasks, last task first
+    void rollback_tasks() {
+        for (auto it = tasks_.rbegin(); it != tasks_.rend(); ++it) {
+            (*it)->rollback();
+        }
+    }
+    
+    /// @brief Release the configuration data the hook's tasks no longer need
+    void compact_tasks() {
+        for (auto& task : tasks_) {
+            task->compact();
+        }
+    }
+    
+    /// @brief Get the memory held by the configurations of the hook's tasks
+    /// @return Sum of the tasks' config_bytes()
+    [[nodiscard]] std::size_t config_bytes() const noexcept {
+        std::size_t bytes = 0;
+        for (const auto& task : tasks_) {
+            bytes += task->config_bytes();
+        }
+        return bytes;
+    }
+    
 private:
+    /// @brief Run one program entry and record its timing
+    /// @param entry Entry to run
+    /// @param context Registers of the hooked code, nullptr off the hooked thread
+    /// @return true if the task succeeded
+    bool run_entry(const TaskProgramEntry& entry, task::CpuContext* context = nullptr) {
+        const auto start = read_timestamp();
+        auto result = entry.fn(entry.state, context);
+        entry.counters->record(read_timestamp() - start);
+        
+        if (!result) [[unlikely]] {
+            entry.counters->record_failure();
+            LOG_ERROR("Hook at 0x{:X}: Task '{}' failed with error code: {}", 
+                     address_, entry.name, static_cast<int>(result.error()));
+            // Log error but continue with other tasks
+            return false;
+        }
+        return true;
+    }
+    
+    /// @brief Queue this trigger's worker tasks as one ordered job
+    /// @note Runs them on the calling thread when the hook has no owner
+    void submit_worker_tasks();
+    
+    /// @brief Queue this hook's deferred tasks for the next frames, unless already queued
+    /// @note Runs them on the calling thread when the owner has no frame anchor
+    void defer_tasks();
+    
+    /// @brief Run the deferred tasks (frame scheduler job)
+    /// @param state Hook whose tasks to run
+    static void run_deferred_tasks(void* state);
+    
     std::uintptr_t address_;
     void* trampoline_;
     void* handler_;
     std::vector<task::HookTaskPtr> tasks_;
+    std::vector<std::unique_ptr<TimingCounters>> task_stats_;
+    std::vector<TaskDispatch> dispatch_;
+    TaskProgram program_;
+    TimingCounters stats_;
+    HookManager* owner_ = nullptr;
+    TriggerGate gate_;
+    StubKind stub_kind_ = StubKind::minimal;
+    std::atomic<bool> deferred_queued_{false};  ///< A frame job for the deferred tasks is pending
 };
 
 /// @brief Manages multiple hooks and their lifecycle
@@ -133,8 +316,10 @@ public:
     /// @brief Add a task to a hook at the specified address
     /// @param address Hook address
     /// @param task Task to add
+    /// @param dispatch Run the task inline or on the worker pool
     /// @return Result of operation
-    [[nodiscard]] HookResult add_task_to_hook(std::uintptr_t address, task::HookTaskPtr task) {
+    [[nodiscard]] HookResult add_task_to_hook(std::uintptr_t address, task::HookTaskPtr task,
+                                              TaskDispatch dispatch = TaskDispatch::inline_call) {
         if (!task) {
             return {};
         }
@@ -144,38 +329,63 @@ public:
         if (it == hooks_.end()) {
             // Create new hook
             auto hook = std::make_unique<Hook>(address);
-            hook->add_task(std::move(task));
+            hook->set_owner(this);
+            hook->add_task(std::move(task), dispatch);
             hooks_[address] = std::move(hook);
+            hook_order_.push_back(address);
         } else {
             // Add to existing hook
-            it->second->add_task(std::move(task));
+            it->second->add_task(std::move(task), dispatch);
         }
         
         return {};
     }
     
+    /// @brief Keep a task that ran at install time instead of on a hook
+    /// @param task Executed task
+    /// @return The kept task
+    /// @note Detached tasks are rolled back by uninstall_all, after the hooks' tasks
+    task::IHookTask* add_detached_task(task::HookTaskPtr task) {
+        detached_tasks_.push_back(std::move(task));
+        return detached_tasks_.back().get();
+    }
+    
     /// @brief Install all hooks
+    /// @param mode Sequential enables, or a single queued apply that rolls back on failure
     /// @return Result of installation
-    [[nodiscard]] HookResult install_all() {
+    [[nodiscard]] HookResult install_all(InstallMode mode = InstallMode::sequential) {
         if (!initialized_) {
             if (auto result = initialize(); !result) {
                 return result;
             }
         }
         
-        for (auto& [address, hook] : hooks_) {
-            if (hook->has_tasks()) {
-                if (auto result = install_hook(*hook); !result) {
-                    return result;
+        if (mode == InstallMode::batched) {
+            if (auto result = install_all_batched(); !result) {
+                return result;
+            }
+        } else {
+            for (auto& [address, hook] : hooks_) {
+                if (hook->has_tasks()) {
+                    if (auto result = install_hook(*hook); !result) {
+                        return result;
+                    }
                 }
             }
         }
         
+        // Probes go on the addresses the hooks left free
+        if (profiler_.probe_count() != 0) {
+            profiler_.install(hook_order_);
+        }
         return {};
     }
     
     /// @brief Uninstall all hooks
     void uninstall_all() {
+        // Writes the call profile while the game's code is still there
+        profiler_.stop();
+        
         for (auto& [address, hook] : hooks_) {
             MH_DisableHook(reinterpret_cast<LPVOID>(address));
         }
@@ -184,10 +394,61 @@ public:
             MH_Uninitialize();
             initialized_ = false;
         }
+        profiler_.release();
         
+        // Queued deferred jobs point at the hooks
+        frame_scheduler_.shutdown();
+        
+        // Queued worker tasks still reference the hooks' task objects
+        worker_pool_.wait_idle();
+        
+        // Nothing runs the tasks anymore: undo them newest first, so code
+        // patched twice ends up with its original bytes
+        for (auto it = hook_order_.rbegin(); it != hook_order_.rend(); ++it) {
+            hooks_.at(*it)->rollback_tasks();
+        }
+        hook_order_.clear();
+        
+        // Detached tasks ran at install time, before any hook
+        for (auto it = detached_tasks_.rbegin(); it != detached_tasks_.rend(); ++it) {
+            (*it)->rollback();
+        }
+        detached_tasks_.clear();
+        
+        // Every stub lives in one arena; free it in one go
+        release_hook_handlers();
         hooks_.clear();
     }
     
+    /// @brief Stop the hooks of a process that is exiting, without tearing them down
+    /// @return true if hooks or profiler probes were enabled and got disabled
+    /// @note One MH_DisableHook(MH_ALL_HOOKS) call, made only when something is
+    ///       enabled, replaces the per-hook disables; nothing is rolled back or
+    ///       released, since the process memory is about to go away. The call
+    ///       profile is still written. The manager must not be destroyed afterwards:
+    ///       its worker threads were stopped by the exit and cannot be waited for.
+    bool disable_for_exit();
+    
+    /// @brief Release the configuration data the installed tasks no longer need
+    /// @return Configuration bytes given back
+    /// @note The loader's configs and TOML trees are gone once hooks are created; this
+    ///       trims the copies the tasks keep (e.g. a patch task's unsorted patch list)
+    std::size_t compact() {
+        std::size_t before = 0;
+        std::size_t after = 0;
+        for (auto& [address, hook] : hooks_) {
+            before += hook->config_bytes();
+            hook->compact_tasks();
+            after += hook->config_bytes();
+        }
+        for (auto& task : detached_tasks_) {
+            before += task->config_bytes();
+            task->compact();
+            after += task->config_bytes();
+        }
+        return before > after ? before - after : 0;
+    }
+    
     /// @brief Get hook by address
     /// @param address Hook address
     /// @return Pointer to hook or nullptr if not found
@@ -210,6 +471,33 @@ public:
         return count;
     }
     
+    /// @brief Get the number of tasks that ran at install time without a hook
+    /// @return Detached task count
+    [[nodiscard]] std::size_t detached_task_count() const noexcept { return detached_tasks_.size(); }
+    
+    /// @brief Get timing statistics of every hook
+    /// @return Per-hook and per-task statistics
+    [[nodiscard]] std::vector<HookStats> stats() const {
+        std::vector<HookStats> result;
+        result.reserve(hooks_.size());
+        for (const auto& [address, hook] : hooks_) {
+            result.push_back(hook->stats());
+        }
+        return result;
+    }
+    
+    /// @brief Get the memory held by hooks, their stubs, trampolines and task configurations
+    /// @return "hook.stubs", "hook.trampolines", "hook.objects" and "hook.configs" entries
+    /// @note Trampolines live in MinHook's own pages and are estimated from its slot size
+    [[nodiscard]] std::vector<util::MemoryUsage> memory_usage() const;
+    
+    /// @brief Reset the timing statistics of every hook
+    void reset_stats() noexcept {
+        for (auto& [address, hook] : hooks_) {
+            hook->reset_stats();
+        }
+    }
+    
     /// @brief Execute all tasks manually (for testing purposes)
     /// @return Number of tasks executed
     [[nodiscard]] std::size_t execute_all_tasks_manually() {
@@ -228,15 +516,63 @@ public:
     /// @return Result of installation
     [[nodiscard]] HookResult install_hook(Hook& hook);
     
+    /// @brief Disable a retired run-once hook
+    /// @param hook Hook whose tasks completed; called from inside the hooked call
+    /// @note Runs on the triggering thread. The trampoline and stub are kept until
+    ///       uninstall_all, since other threads may still be executing them
+    void retire_hook(Hook& hook);
+    
+    /// @brief Get the pool running worker-dispatched tasks
+    /// @return Worker pool
+    [[nodiscard]] util::WorkerPool& worker_pool() noexcept { return worker_pool_; }
+    
+    /// @brief Get the call profiler fed by profile tasks
+    /// @return Call profiler; its probes are installed by install_all()
+    [[nodiscard]] CallProfiler& profiler() noexcept { return profiler_; }
+    
+    /// @brief Get the recorder of hook triggers
+    /// @return Trigger recorder; idle until started
+    [[nodiscard]] TriggerRecorder& recorder() noexcept { return recorder_; }
+    
+    /// @brief Stop recording triggers and write the trace
+    /// @param path Trace file path
+    /// @return Success, or the write error
+    /// @note Call once the hooks no longer run, or accept a possibly torn last record
+    std::expected<void, TraceError> write_trace(const std::filesystem::path& path);
+    
+    /// @brief Get the scheduler running deferred tasks from the frame anchor
+    /// @return Frame scheduler; inactive until a frame task configures it
+    [[nodiscard]] FrameScheduler& frame_scheduler() noexcept { return frame_scheduler_; }
+    
 private:
-    /// @brief Create a hook handler function for the specified address
-    /// @param address Hook address
+    /// @brief Create all hooks, queue their enables and apply them in one pass
+    /// @return Result of installation; on failure every hook of the batch is removed
+    [[nodiscard]] HookResult install_all_batched();
+    
+    /// @brief Create the MinHook detour for a hook and patch its stub, without enabling it
+    /// @param hook Hook to create
+    /// @return Result of creation
+    [[nodiscard]] HookResult create_hook(Hook& hook);
+    
+    /// @brief Remove a hook from MinHook and free its stub
+    /// @param hook Hook to remove; may be only partly created
+    void remove_hook(Hook& hook);
+    
+    /// @brief Create a hook handler stub bound to the specified hook
+    /// @param hook Hook the stub dispatches to
     /// @return Function pointer to hook handler
-    [[nodiscard]] void* create_hook_handler(std::uintptr_t address);
+    [[nodiscard]] void* create_hook_handler(Hook& hook);
     
 private:
     std::unordered_map<std::uintptr_t, std::unique_ptr<Hook>> hooks_;
+    std::vector<std::uintptr_t> hook_order_;  ///< Hook addresses in creation order
+    std::vector<task::HookTaskPtr> detached_tasks_;  ///< Tasks run at install time, in run order
     bool initialized_ = false;
+    
+    util::WorkerPool worker_pool_;
+    CallProfiler profiler_;
+    FrameScheduler frame_scheduler_;
+    TriggerRecorder recorder_;
 };
 
 } // namespace app_hook::hook
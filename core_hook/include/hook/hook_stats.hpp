@@ -0,0 +1,125 @@
+#pragma once
+
+#include <Windows.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace app_hook::hook {
+
+/// @brief Number of log2 latency buckets (bucket i holds durations in [2^(i-1), 2^i) ns)
+inline constexpr std::size_t kLatencyBuckets = 32;
+
+/// @brief Read the high-resolution performance counter
+/// @return Current counter value in ticks
+[[nodiscard]] inline std::uint64_t read_timestamp() noexcept {
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<std::uint64_t>(counter.QuadPart);
+}
+
+/// @brief Convert performance counter ticks to nanoseconds
+/// @param ticks Tick count
+/// @return Duration in nanoseconds
+[[nodiscard]] inline std::uint64_t ticks_to_ns(std::uint64_t ticks) noexcept {
+    static const std::uint64_t frequency = [] {
+        LARGE_INTEGER freq;
+        QueryPerformanceFrequency(&freq);
+        return static_cast<std::uint64_t>(freq.QuadPart);
+    }();
+    return ticks * 1'000'000'000ull / frequency;
+}
+
+/// @brief Immutable copy of a timing counter set
+struct TimingSnapshot {
+    std::uint64_t calls = 0;                              ///< Number of recorded calls
+    std::uint64_t total_ns = 0;                           ///< Sum of all durations
+    std::uint64_t min_ns = 0;                             ///< Shortest duration (0 if no calls)
+    std::uint64_t max_ns = 0;                             ///< Longest duration
+    std::uint64_t failures = 0;                           ///< Number of failed runs
+    std::array<std::uint32_t, kLatencyBuckets> histogram{}; ///< log2 latency histogram
+    
+    /// @brief Get the mean duration
+    /// @return Mean duration in nanoseconds, 0 if no calls
+    [[nodiscard]] std::uint64_t mean_ns() const noexcept {
+        return calls ? total_ns / calls : 0;
+    }
+};
+
+/// @brief Lock-free call counters, padded to a cache line to avoid false sharing
+struct alignas(64) TimingCounters {
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> total_ns{0};
+    std::atomic<std::uint64_t> min_ns{std::numeric_limits<std::uint64_t>::max()};
+    std::atomic<std::uint64_t> max_ns{0};
+    std::atomic<std::uint64_t> failures{0};
+    std::array<std::atomic<std::uint32_t>, kLatencyBuckets> histogram{};
+    
+    /// @brief Record one call
+    /// @param ticks Duration in performance counter ticks
+    void record(std::uint64_t ticks) noexcept {
+        const std::uint64_t ns = ticks_to_ns(ticks);
+        calls.fetch_add(1, std::memory_order_relaxed);
+        total_ns.fetch_add(ns, std::memory_order_relaxed);
+        
+        auto current_min = min_ns.load(std::memory_order_relaxed);
+        while (ns < current_min && !min_ns.compare_exchange_weak(current_min, ns, std::memory_order_relaxed)) {}
+        auto current_max = max_ns.load(std::memory_order_relaxed);
+        while (ns > current_max && !max_ns.compare_exchange_weak(current_max, ns, std::memory_order_relaxed)) {}
+        
+        const auto bucket = std::min<std::size_t>(std::bit_width(ns), kLatencyBuckets - 1);
+        histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /// @brief Record a failed run (in addition to its duration)
+    void record_failure() noexcept {
+        failures.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    /// @brief Copy the counters
+    /// @return Snapshot of the current values
+    [[nodiscard]] TimingSnapshot snapshot() const noexcept {
+        TimingSnapshot result;
+        result.calls = calls.load(std::memory_order_relaxed);
+        result.total_ns = total_ns.load(std::memory_order_relaxed);
+        result.min_ns = result.calls ? min_ns.load(std::memory_order_relaxed) : 0;
+        result.max_ns = max_ns.load(std::memory_order_relaxed);
+        result.failures = failures.load(std::memory_order_relaxed);
+        for (std::size_t i = 0; i < kLatencyBuckets; ++i) {
+            result.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+    
+    /// @brief Reset all counters to zero
+    void reset() noexcept {
+        calls.store(0, std::memory_order_relaxed);
+        total_ns.store(0, std::memory_order_relaxed);
+        min_ns.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+        failures.store(0, std::memory_order_relaxed);
+        for (auto& bucket : histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/// @brief Timing statistics of one task on a hook
+struct TaskStats {
+    std::string name;        ///< Task name
+    TimingSnapshot timing;   ///< Time spent in the task's execute()
+};
+
+/// @brief Timing statistics of one hook
+struct HookStats {
+    std::uintptr_t address;        ///< Hooked address
+    TimingSnapshot timing;         ///< Time spent in dispatch, tasks included
+    std::vector<TaskStats> tasks;  ///< Per-task statistics in execution order
+};
+
+} // namespace app_hook::hook
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "../config/config_base.hpp"
+#include "../config/task_loader.hpp"
+#include "../task/hook_task.hpp"
+#include "../util/file_watcher.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace app_hook::hook {
+
+/// @brief What a hot reload did with one changed file
+struct ReloadReport {
+    std::filesystem::path file;        ///< Changed file
+    bool matched = false;              ///< The file is a task config or a file a task watches
+    bool parse_failed = false;         ///< The config file could not be parsed; nothing changed
+    std::size_t unchanged = 0;         ///< Configs identical to the ones applied
+    std::size_t updated = 0;           ///< Configs applied in place
+    std::size_t rerun = 0;             ///< Configs executed again (stale followers)
+    std::size_t restart_required = 0;  ///< Changes that only a restart applies
+
+    /// @brief Check if part of the change waits for a restart
+    [[nodiscard]] bool needs_restart() const noexcept { return parse_failed || restart_required != 0; }
+};
+
+/// @brief Applies edits of task config files and mod binaries while the game runs
+///
+/// HookFactory records every task it creates. When a file changes, only the
+/// tasks using it are touched: a config file is parsed again (bypassing the
+/// config cache) and each config is handed to its task by key, which rewrites
+/// only what differs; a changed binary is re-read by the tasks watching it.
+/// Tasks whose output moved (a resized region, a reloaded binary with a new
+/// size) have their followBy tasks executed again. Added or removed configs,
+/// changes to tasks.toml and tasks that cannot reload are logged as needing a
+/// restart, which stays the slow path.
+/// @note Development feature: tasks are updated from the watcher thread while
+///       their hooks may run, so reloadable tasks lock against execute()
+class HotReloader {
+public:
+    /// @brief Constructor
+    /// @param tasks_path tasks.toml the hooks were created from; its directory is the config directory
+    explicit HotReloader(std::filesystem::path tasks_path);
+
+    /// @brief Stops watching
+    ~HotReloader();
+
+    // Non-copyable, non-movable (the watcher calls back into the reloader)
+    HotReloader(const HotReloader&) = delete;
+    HotReloader& operator=(const HotReloader&) = delete;
+    HotReloader(HotReloader&&) = delete;
+    HotReloader& operator=(HotReloader&&) = delete;
+
+    /// @brief Record a task, before its configs
+    /// @param task Task information
+    /// @param key Task key
+    /// @param config_file Resolved path of the task's config file
+    /// @param followers Keys of the tasks that follow it
+    void track_task(const config::TaskInfo& task, const std::string& key,
+                    const std::filesystem::path& config_file, std::vector<std::string> followers);
+
+    /// @brief Record a config of the last task tracked under a key
+    /// @param task_key Key of the task the config belongs to
+    /// @param config Configuration the task was created from
+    /// @param hook_task Task running the config, on a hook or detached (ran at install time)
+    void track_config(const std::string& task_key, config::ConfigPtr config, task::IHookTask* hook_task);
+
+    /// @brief Apply a changed file
+    /// @param path Changed file
+    /// @return What was reloaded
+    ReloadReport reload_file(const std::filesystem::path& path);
+
+    /// @brief Watch the config directory and the files the tasks read
+    /// @return false if nothing could be watched
+    bool start();
+
+    /// @brief Stop watching
+    /// @note Joins the watcher thread (see join_background_thread)
+    void stop();
+
+    /// @brief Get the number of tracked tasks
+    [[nodiscard]] std::size_t task_count() const;
+
+    /// @brief Get the number of tracked configs
+    [[nodiscard]] std::size_t config_count() const;
+
+private:
+    struct TrackedConfig {
+        config::ConfigPtr config;
+        task::IHookTask* task = nullptr;  ///< Owned by the hook manager
+    };
+
+    struct TrackedTask {
+        config::TaskInfo info;
+        std::string key;
+        std::filesystem::path config_file;   ///< Normalized
+        std::vector<std::string> followers;
+        std::vector<TrackedConfig> configs;
+    };
+
+    std::filesystem::path tasks_path_;       ///< Normalized
+    std::filesystem::path config_dir_;       ///< Normalized
+    std::vector<TrackedTask> tasks_;         ///< In dependency order
+    std::unique_ptr<util::FileWatcher> watcher_;
+    mutable std::mutex mutex_;
+
+    /// @brief Parse a task's config file again and hand each config to its task
+    /// @param task Task whose config file changed
+    /// @param report Report to fill
+    /// @param stale Keys of the tasks to execute again
+    void reload_config_file(TrackedTask& task, ReloadReport& report, std::vector<std::string>& stale);
+
+    /// @brief Count an outcome and queue the followers its task left stale
+    void record_outcome(task::ReloadOutcome outcome, const TrackedTask& task, ReloadReport& report,
+                        std::vector<std::string>& stale);
+
+    /// @brief Execute stale tasks and everything that follows them, in dependency order
+    void rerun(std::vector<std::string> stale, ReloadReport& report);
+
+    /// @brief Get the files a config's task reads besides its config file
+    [[nodiscard]] static std::vector<std::string> watched_files(const TrackedConfig& tracked);
+
+    /// @brief Find a tracked task by key
+    [[nodiscard]] TrackedTask* find_task(const std::string& key);
+};
+
+/// @brief Normalize a path for hot reload comparisons
+/// @param path Path, relative to the working directory if not absolute
+/// @return Absolute, lexically normal path
+[[nodiscard]] std::filesystem::path normalize_watch_path(const std::filesystem::path& path);
+
+/// @brief Compare normalized paths the way the file system does (ignoring case)
+[[nodiscard]] bool same_watch_path(const std::filesystem::path& a, const std::filesystem::path& b);
+
+} // namespace app_hook::hook
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace app_hook::hook {
+
+/// @brief Packs hook stubs into shared executable pages instead of one VirtualAlloc per stub
+///
+/// The arena reserves address space in allocation-granularity chunks and commits
+/// pages on demand. Stubs are handed out as cache-line aligned slots; released slots
+/// are kept on a free list and reused. Committed pages stay executable at all times
+/// and are only made writable between begin_write() and end_write().
+class StubArena {
+public:
+    /// @brief Size of one stub slot (one cache line)
+    static constexpr std::size_t kSlotSize = 64;
+    
+    /// @brief Address space reserved per chunk (Windows allocation granularity)
+    static constexpr std::size_t kChunkSize = 64 * 1024;
+    
+    /// @brief Size of a committed page
+    static constexpr std::size_t kPageSize = 4096;
+    
+    StubArena() = default;
+    ~StubArena() { release(); }
+    
+    // Non-copyable, non-movable
+    StubArena(const StubArena&) = delete;
+    StubArena& operator=(const StubArena&) = delete;
+    StubArena(StubArena&&) = delete;
+    StubArena& operator=(StubArena&&) = delete;
+    
+    /// @brief Allocate a stub slot
+    /// @param size Number of bytes needed (at most kSlotSize)
+    /// @return Cache-line aligned slot, or nullptr on failure
+    /// @note Must be called between begin_write() and end_write() if the slot is written
+    [[nodiscard]] void* allocate(std::size_t size);
+    
+    /// @brief Return a slot to the free list
+    /// @param slot Slot previously returned by allocate()
+    void deallocate(void* slot);
+    
+    /// @brief Make all committed pages writable (and still executable) for patching
+    void begin_write();
+    
+    /// @brief Flip all committed pages back to RX and flush the instruction cache
+    void end_write();
+    
+    /// @brief Free every chunk in one go
+    void release();
+    
+    /// @brief Get the number of slots currently handed out
+    /// @return Live slot count
+    [[nodiscard]] std::size_t slot_count() const noexcept { return live_slots_; }
+    
+    /// @brief Get the highest number of slots handed out at once
+    /// @return Peak slot count (kept across release())
+    [[nodiscard]] std::size_t peak_slot_count() const noexcept { return peak_slots_; }
+    
+    /// @brief Get the number of committed bytes
+    /// @return Committed bytes across all chunks
+    [[nodiscard]] std::size_t committed_bytes() const noexcept;
+    
+    /// @brief Get the number of reserved bytes
+    /// @return Reserved bytes across all chunks
+    [[nodiscard]] std::size_t reserved_bytes() const noexcept { return chunks_.size() * kChunkSize; }
+    
+private:
+    struct Chunk {
+        std::uint8_t* base = nullptr;
+        std::size_t used = 0;       ///< Bytes handed out by the bump pointer
+        std::size_t committed = 0;  ///< Bytes committed from base
+    };
+    
+    /// @brief Reserve a new chunk
+    /// @return true if the chunk was reserved
+    bool add_chunk();
+    
+    /// @brief Commit pages so that the chunk covers at least end bytes
+    /// @return true on success
+    bool commit_to(Chunk& chunk, std::size_t end);
+    
+    /// @brief Apply a protection to every committed page
+    void protect_all(DWORD protection);
+    
+    std::vector<Chunk> chunks_;
+    std::vector<void*> free_slots_;
+    std::size_t live_slots_ = 0;
+    std::size_t peak_slots_ = 0;
+    bool writing_ = false;
+};
+
+} // namespace app_hook::hook
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "../task/hook_task.hpp"
+#include "hook_stats.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace app_hook::hook {
+
+/// @brief Where a hook runs one of its tasks
+enum class TaskDispatch {
+    inline_call,  ///< On the hooked thread, before the original function resumes
+    worker,       ///< Queued to the manager's worker pool; the hooked call does not wait
+    deferred      ///< Queued to the manager's frame scheduler; run on the game thread within a frame budget
+};
+
+/// @brief One step of a compiled task program
+struct TaskProgramEntry {
+    task::TaskResult (*fn)(void* state, task::CpuContext* context);  ///< Task entry point
+    void* state;                ///< Task object passed to fn
+    TimingCounters* counters;   ///< Per-task timing counters
+    const char* name;           ///< Task name, resolved at compile time
+    TaskDispatch dispatch;      ///< Thread the task runs on
+};
+
+/// @brief Flat form of a hook's task chain, walked by the trigger path
+/// @note Entries and their names share a single allocation, so running a hook
+///       touches one contiguous block instead of chasing task pointers and
+///       calling name() on every trigger. The task objects themselves stay
+///       owned by the hook.
+class TaskProgram {
+public:
+    TaskProgram() = default;
+
+    /// @brief Compile a task chain into a program
+    /// @param tasks Tasks in execution order
+    /// @param counters Timing counters, one per task
+    /// @param dispatch Dispatch mode, one per task
+    /// @return Compiled program
+    [[nodiscard]] static TaskProgram compile(std::span<const task::HookTaskPtr> tasks,
+                                             std::span<const std::unique_ptr<TimingCounters>> counters,
+                                             std::span<const TaskDispatch> dispatch) {
+        TaskProgram program;
+        if (tasks.empty()) {
+            return program;
+        }
+
+        std::vector<std::string> names;
+        names.reserve(tasks.size());
+        std::size_t names_size = 0;
+        for (const auto& task : tasks) {
+            names.push_back(task->name());
+            names_size += names.back().size() + 1;
+        }
+
+        const std::size_t entries_size = tasks.size() * sizeof(TaskProgramEntry);
+        program.storage_ = std::make_unique<std::byte[]>(entries_size + names_size);
+        program.size_ = tasks.size();
+
+        auto* entries = reinterpret_cast<TaskProgramEntry*>(program.storage_.get());
+        char* name_cursor = reinterpret_cast<char*>(program.storage_.get() + entries_size);
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const auto thunk = tasks[i]->thunk();
+            std::memcpy(name_cursor, names[i].c_str(), names[i].size() + 1);
+            new (&entries[i]) TaskProgramEntry{thunk.fn, thunk.state, counters[i].get(), name_cursor, dispatch[i]};
+            name_cursor += names[i].size() + 1;
+            program.worker_entries_ += dispatch[i] == TaskDispatch::worker ? 1 : 0;
+            program.deferred_entries_ += dispatch[i] == TaskDispatch::deferred ? 1 : 0;
+        }
+
+        return program;
+    }
+
+    /// @brief Get the program entries in execution order
+    /// @return View of the entries
+    [[nodiscard]] std::span<const TaskProgramEntry> entries() const noexcept {
+        return {reinterpret_cast<const TaskProgramEntry*>(storage_.get()), size_};
+    }
+
+    /// @brief Get the name of an entry
+    /// @param index Entry index
+    /// @return Task name
+    [[nodiscard]] std::string_view name(std::size_t index) const noexcept {
+        return entries()[index].name;
+    }
+
+    /// @brief Get the number of entries
+    /// @return Number of entries
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /// @brief Check if the program has no entries
+    /// @return true if empty
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    
+    /// @brief Get the number of entries dispatched to the worker pool
+    /// @return Worker entry count
+    [[nodiscard]] std::size_t worker_entries() const noexcept { return worker_entries_; }
+    
+    /// @brief Get the number of entries deferred to the frame scheduler
+    /// @return Deferred entry count
+    [[nodiscard]] std::size_t deferred_entries() const noexcept { return deferred_entries_; }
+
+private:
+    std::unique_ptr<std::byte[]> storage_;
+    std::size_t size_ = 0;
+    std::size_t worker_entries_ = 0;
+    std::size_t deferred_entries_ = 0;
+};
+
+} // namespace app_hook::hook
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace app_hook::hook {
+
+/// @brief Which triggers of a hook run its tasks
+enum class TriggerPolicy : std::uint8_t {
+    always,         ///< Every call runs the tasks (default)
+    once,           ///< The first call runs the tasks, then the hook retires whatever the result
+    until_success,  ///< Calls run the tasks until they all succeed, then the hook retires
+    every_n         ///< The first call and every Nth call after it run the tasks
+};
+
+/// @brief Lock-free gate deciding whether one trigger of a hook runs its tasks
+/// @note The policy is set before install and only read afterwards, so the
+///       always path is a plain load and a predicted branch. A run-once gate
+///       resolves concurrent first calls with a single CAS; once it has retired
+///       (or while a run is in flight), callers see it with one acquire load and
+///       go straight to the trampoline without writing the shared cache line.
+///       every_n counts calls with one relaxed fetch_add; the period slips by
+///       one call each time the 32-bit counter wraps.
+class TriggerGate {
+public:
+    /// @brief Set the policy (before the hook is installed)
+    /// @param policy Trigger policy
+    /// @param period Call period of every_n (1 runs every call)
+    void configure(TriggerPolicy policy, std::uint32_t period = 1) noexcept {
+        policy_ = policy == TriggerPolicy::every_n && period <= 1 ? TriggerPolicy::always : policy;
+        period_ = period == 0 ? 1 : period;
+        calls_.store(0, std::memory_order_relaxed);
+        state_.store(State::armed, std::memory_order_relaxed);
+    }
+
+    /// @brief Get the policy
+    [[nodiscard]] TriggerPolicy policy() const noexcept { return policy_; }
+
+    /// @brief Get the call period of every_n
+    [[nodiscard]] std::uint32_t period() const noexcept { return period_; }
+
+    /// @brief Check if the policy retires the hook after a run
+    [[nodiscard]] bool retires() const noexcept {
+        return policy_ == TriggerPolicy::once || policy_ == TriggerPolicy::until_success;
+    }
+
+    /// @brief Decide whether this trigger runs the tasks
+    /// @return true if the caller should run them (and then call leave)
+    [[nodiscard]] bool enter() noexcept {
+        switch (policy_) {
+            case TriggerPolicy::always:
+                return true;
+            case TriggerPolicy::every_n:
+                return calls_.fetch_add(1, std::memory_order_relaxed) % period_ == 0;
+            case TriggerPolicy::once:
+            case TriggerPolicy::until_success:
+                break;
+        }
+        // Read first: a retired or busy gate must not bounce the line between callers
+        auto expected = state_.load(std::memory_order_acquire);
+        return expected == State::armed &&
+               state_.compare_exchange_strong(expected, State::running, std::memory_order_acq_rel);
+    }
+
+    /// @brief Finish a run started by enter
+    /// @param succeeded true if every task succeeded
+    /// @return true if the gate retired with this run
+    bool leave(bool succeeded) noexcept {
+        if (!retires()) {
+            return false;
+        }
+        const bool retire = succeeded || policy_ == TriggerPolicy::once;
+        state_.store(retire ? State::retired : State::armed, std::memory_order_release);
+        return retire;
+    }
+
+    /// @brief Check if the gate no longer lets any call through
+    [[nodiscard]] bool retired() const noexcept {
+        return state_.load(std::memory_order_acquire) == State::retired;
+    }
+
+private:
+    /// @brief Run state of a retiring gate
+    enum class State : std::uint8_t { armed, running, retired };
+
+    TriggerPolicy policy_ = TriggerPolicy::always;
+    std::uint32_t period_ = 1;
+    std::atomic<std::uint32_t> calls_{0};
+    std::atomic<State> state_{State::armed};
+};
+
+} // namespace app_hook::hook
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "trigger_policy.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace app_hook::hook {
+
+class HookManager;
+
+/// @brief One hook trigger seen by dispatch_hook
+struct TriggerRecord {
+    std::uint64_t time = 0;       ///< Performance counter ticks since recording started
+    std::uint32_t address = 0;    ///< Hooked address (x86)
+    std::uint32_t thread_id = 0;  ///< Thread that made the hooked call
+    std::uint32_t duration = 0;   ///< Ticks spent running the tasks (0 if the gate skipped the call)
+    std::uint32_t outcome = 0;    ///< Bit i: task i failed; kTriggerSkipped: the gate skipped the call
+};
+
+static_assert(sizeof(TriggerRecord) == 24, "records are written as-is");
+
+/// @brief Outcome bit of a trigger whose tasks the gate skipped
+inline constexpr std::uint32_t kTriggerSkipped = 1u << 31;
+
+/// @brief Number of tasks with their own outcome bit; later tasks share the last one
+inline constexpr std::uint32_t kTriggerOutcomeTasks = 31;
+
+/// @brief Get the outcome bit of a task
+/// @param index Task index on its hook
+[[nodiscard]] constexpr std::uint32_t task_outcome_bit(std::size_t index) noexcept {
+    return 1u << (index < kTriggerOutcomeTasks ? index : kTriggerOutcomeTasks - 1);
+}
+
+/// @brief Hook of a trace, with what replay needs to rebuild it
+struct TraceHook {
+    std::uint32_t address = 0;
+    std::uint16_t tasks = 0;                            ///< Number of tasks on the hook
+    TriggerPolicy policy = TriggerPolicy::always;
+    std::uint8_t reserved = 0;
+    std::uint32_t period = 1;                           ///< Call period of every_n
+};
+
+static_assert(sizeof(TraceHook) == 12, "hooks are written as-is");
+
+/// @brief Error types for trace files
+enum class TraceError {
+    file_not_found,
+    truncated,        ///< File shorter than its header declares
+    bad_magic,        ///< Not a trigger trace
+    write_failed
+};
+
+/// @brief Hook triggers of a recording session
+///
+/// File layout: a header (magic "AHTR", version, counter frequency, hook,
+/// record and dropped counts), the hook table, then the records sorted by time.
+struct TriggerTrace {
+    std::uint64_t frequency = 0;            ///< Performance counter ticks per second
+    std::uint64_t dropped = 0;              ///< Triggers not recorded (buffer full)
+    std::vector<TraceHook> hooks;
+    std::vector<TriggerRecord> records;
+
+    /// @brief Read a trace file
+    /// @param path Trace file path
+    /// @return Trace or error
+    [[nodiscard]] static std::expected<TriggerTrace, TraceError> read(const std::filesystem::path& path);
+
+    /// @brief Write the trace
+    /// @param path Trace file path
+    /// @return Success or write_failed
+    [[nodiscard]] std::expected<void, TraceError> write(const std::filesystem::path& path) const;
+
+    /// @brief Get the distinct thread IDs, in order of their first trigger
+    [[nodiscard]] std::vector<std::uint32_t> threads() const;
+};
+
+/// @brief Records hook triggers into a preallocated buffer
+///
+/// record() claims a slot with one fetch_add and writes it, so concurrent
+/// hooked calls never wait on each other; when the buffer is full the trigger
+/// is only counted as dropped. When not recording, dispatch_hook pays one
+/// relaxed load.
+class TriggerRecorder {
+public:
+    /// @brief Default buffer size (24 MB)
+    static constexpr std::size_t kDefaultCapacity = 1u << 20;
+
+    TriggerRecorder() = default;
+
+    // Non-copyable, non-movable (hooked calls write into the buffer)
+    TriggerRecorder(const TriggerRecorder&) = delete;
+    TriggerRecorder& operator=(const TriggerRecorder&) = delete;
+    TriggerRecorder(TriggerRecorder&&) = delete;
+    TriggerRecorder& operator=(TriggerRecorder&&) = delete;
+
+    /// @brief Allocate the buffer and start recording
+    /// @param capacity Records kept before triggers are dropped
+    /// @return false if already recording or the buffer cannot be allocated
+    bool start(std::size_t capacity = kDefaultCapacity);
+
+    /// @brief Check if triggers are being recorded
+    [[nodiscard]] bool recording() const noexcept { return recording_.load(std::memory_order_relaxed); }
+
+    /// @brief Record one trigger
+    /// @param address Hooked address
+    /// @param start Performance counter value when the call entered dispatch
+    /// @param duration Ticks spent running the tasks
+    /// @param outcome Failed task bits, or kTriggerSkipped
+    void record(std::uintptr_t address, std::uint64_t start, std::uint64_t duration, std::uint32_t outcome) noexcept;
+
+    /// @brief Stop recording and take the records, sorted by time
+    /// @param hooks Hook table of the trace
+    /// @return Trace of the session (empty if not recording)
+    /// @note A call still in record() when stop() runs may leave its slot half written;
+    ///       the buffer is kept until the next start() or the recorder's destruction
+    [[nodiscard]] TriggerTrace stop(std::vector<TraceHook> hooks);
+
+private:
+    std::atomic<bool> recording_{false};
+    std::unique_ptr<TriggerRecord[]> buffer_;
+    std::size_t capacity_ = 0;
+    std::atomic<std::size_t> next_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::uint64_t origin_ = 0;        ///< Counter value when recording started
+};
+
+/// @brief Settings of a trace replay
+struct ReplayOptions {
+    double speed = 0.0;               ///< Playback rate (1 = recorded pace, 0 = as fast as possible)
+    std::size_t scratch_bytes = 64;   ///< Scratch memory each replay task writes on a run
+};
+
+/// @brief Result of a trace replay
+struct ReplayResult {
+    double seconds = 0.0;             ///< Wall time of the replay
+    std::size_t threads = 0;          ///< Replay threads (one per recorded thread)
+    std::uint64_t triggers = 0;       ///< Triggers dispatched
+    std::uint64_t mismatches = 0;     ///< Triggers whose replayed outcome differs from the recording
+};
+
+/// @brief Feeds a trace into a HookManager without touching game code
+///
+/// Every hook of the trace is rebuilt at its recorded address (no detour is
+/// installed) with its policy and as many replay tasks as it had; a replay
+/// task writes its hook's scratch memory and fails exactly when the recorded
+/// task failed. Each recorded thread gets a replay thread that dispatches its
+/// triggers in order, at the recorded times scaled by the speed, so dispatch,
+/// policy and context changes can be measured against real play sessions.
+class TraceReplayer {
+public:
+    /// @brief Build the hooks of a trace
+    /// @param trace Trace to replay (must outlive the replayer)
+    /// @param options Replay settings
+    explicit TraceReplayer(const TriggerTrace& trace, ReplayOptions options = {});
+    ~TraceReplayer();
+
+    // Non-copyable, non-movable (replay tasks point at the scratch memory)
+    TraceReplayer(const TraceReplayer&) = delete;
+    TraceReplayer& operator=(const TraceReplayer&) = delete;
+    TraceReplayer(TraceReplayer&&) = delete;
+    TraceReplayer& operator=(TraceReplayer&&) = delete;
+
+    /// @brief Replay every trigger once
+    /// @return Replay figures
+    /// @note The hooks' gates and statistics carry over between runs; call reset() to start afresh
+    ReplayResult run();
+
+    /// @brief Re-arm the hooks' gates and clear their statistics
+    void reset();
+
+    /// @brief Get the manager holding the rebuilt hooks
+    [[nodiscard]] HookManager& manager() noexcept { return *manager_; }
+
+private:
+    const TriggerTrace& trace_;
+    ReplayOptions options_;
+    std::unique_ptr<HookManager> manager_;
+    std::unique_ptr<std::uint8_t[]> scratch_;   ///< scratch_bytes per hook
+};
+
+} // namespace app_hook::hook
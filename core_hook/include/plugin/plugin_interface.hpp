@@ -5,18 +5,22 @@
 #include <memory>
 #include <functional>
 #include <cstdint>
+#include <atomic>
 #include <source_location>
+#include <span>
 
 // Include the actual headers for config types  
 #include "config/config_base.hpp"
 #include "config/config_loader_base.hpp"
 #include "task/hook_task.hpp"
 #include "context/mod_context.hpp"
+#include "hook/hook_stats.hpp"
+#include "util/memory_report.hpp"
 
 namespace app_hook::plugin {
 
 /// @brief Plugin API version for compatibility checking
-constexpr std::uint32_t PLUGIN_API_VERSION = 1;
+constexpr std::uint32_t PLUGIN_API_VERSION = 7;
 
 /// @brief Plugin information structure
 struct PluginInfo {
@@ -95,6 +99,61 @@ public:
     /// @brief Get access to the host's ModContext instance
     /// @return Reference to the host's ModContext
     virtual ::app_hook::context::ModContext& get_mod_context() = 0;
+    
+    /// @brief Get timing statistics of every installed hook and its tasks
+    /// @return Per-hook and per-task call counts, durations and latency histograms
+    virtual std::vector<::app_hook::hook::HookStats> get_hook_stats() const = 0;
+    
+    /// @brief Add a source to the memory footprint report
+    /// @param name Source name (a second registration under the same name replaces the first)
+    /// @param source Function returning the plugin's categories, prefixed with the plugin's name
+    /// @note The function lives in the plugin DLL: unregister it in IPlugin::shutdown
+    virtual void register_memory_source(const std::string& name, ::app_hook::util::MemorySource source) = 0;
+    
+    /// @brief Remove a source added with register_memory_source
+    /// @param name Source name
+    virtual void unregister_memory_source(const std::string& name) = 0;
+    
+    /// @brief Get the memory footprint of the framework, its plugins and the address space
+    /// @return Usage of every registered category with peaks, plus free space and fragmentation
+    virtual ::app_hook::util::MemoryReport get_memory_report() const = 0;
+    
+    /// @brief Resolve signature patterns against the game executable's code
+    /// @param patterns Pattern strings ("8D 86 & ?? ?? ?? ?? 8B", see util::Signature)
+    /// @return One address per pattern, 0 for patterns that are invalid, missing or ambiguous
+    /// @note Batch a file's patterns: misses share one scan, and results are cached on
+    ///       disk for this build of the executable
+    virtual std::vector<std::uintptr_t> resolve_signatures(const std::vector<std::string>& patterns) = 0;
+    
+    /// @brief Look up a named address in the address map of the running executable's build
+    /// @param symbol Symbol name ("K_MAGIC", see config::AddressMap)
+    /// @return Address, or 0 if no map matches this build or the map does not name the symbol
+    /// @note Try it before resolve_signatures: a hit costs a hash lookup instead of a scan
+    virtual std::uintptr_t resolve_symbol(const std::string& symbol) = 0;
+    
+    /// @brief Get the bytes of a binary packed into the mod bundle
+    /// @param path Binary path as the task was configured
+    /// @return Bytes in the mapped bundle, or an empty span if no bundle holds the file
+    /// @note The bytes stay valid until the host unloads; read them instead of the file
+    virtual std::span<const std::uint8_t> bundle_blob(const std::string& path) = 0;
+    
+    /// @brief Check if a message at this level would be logged
+    /// @param level Log level (0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical)
+    /// @return true if the host's logger accepts the level
+    /// @note Inline and non-virtual: the PLUGIN_LOG_* macros test it before formatting
+    [[nodiscard]] bool is_enabled(int level) const noexcept {
+        return level >= min_log_level_.load(std::memory_order_relaxed);
+    }
+    
+protected:
+    /// @brief Set the minimum level reported by is_enabled()
+    /// @param level Log level (0=trace ... 5=critical, 6=off)
+    void set_min_log_level(int level) noexcept {
+        min_log_level_.store(level, std::memory_order_relaxed);
+    }
+    
+private:
+    std::atomic<int> min_log_level_{0};
 };
 
 /// @brief Plugin interface - implemented by plugins
@@ -146,11 +205,32 @@ using DestroyPluginFunc = void(*)(IPlugin*);
         delete plugin; \
     }
 
+/// @brief Lowest plugin log level compiled into the plugin (0=trace ... 5=critical)
+/// @note Release builds drop trace and debug calls entirely; define it before
+///       including this header to override
+#ifndef PLUGIN_LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define PLUGIN_LOG_ACTIVE_LEVEL 2
+#else
+#define PLUGIN_LOG_ACTIVE_LEVEL 0
+#endif
+#endif
+
+/// @brief Log through the host if the level is compiled in and enabled
+/// @note Arguments are only formatted when the message is actually logged
+#define PLUGIN_LOG_AT(level, ...) \
+    do { \
+        if constexpr ((level) >= PLUGIN_LOG_ACTIVE_LEVEL) { \
+            if (host_ && host_->is_enabled(level)) \
+                host_->log_message_with_location(level, std::format(__VA_ARGS__), std::source_location::current()); \
+        } \
+    } while (0)
+
 /// @brief Plugin logging macros - use these in plugins to log through host
 /// @note These require a 'host_' member variable of type IPluginHost*
-#define PLUGIN_LOG_TRACE(...)   if (host_) host_->log_message_with_location(0, std::format(__VA_ARGS__), std::source_location::current())
-#define PLUGIN_LOG_DEBUG(...)   if (host_) host_->log_message_with_location(1, std::format(__VA_ARGS__), std::source_location::current())
-#define PLUGIN_LOG_INFO(...)    if (host_) host_->log_message_with_location(2, std::format(__VA_ARGS__), std::source_location::current())
-#define PLUGIN_LOG_WARN(...)    if (host_) host_->log_message_with_location(3, std::format(__VA_ARGS__), std::source_location::current())
-#define PLUGIN_LOG_ERROR(...)   if (host_) host_->log_message_with_location(4, std::format(__VA_ARGS__), std::source_location::current())
-#define PLUGIN_LOG_CRITICAL(...) if (host_) host_->log_message_with_location(5, std::format(__VA_ARGS__), std::source_location::current()) 
\ No newline at end of file
+#define PLUGIN_LOG_TRACE(...)    PLUGIN_LOG_AT(0, __VA_ARGS__)
+#define PLUGIN_LOG_DEBUG(...)    PLUGIN_LOG_AT(1, __VA_ARGS__)
+#define PLUGIN_LOG_INFO(...)     PLUGIN_LOG_AT(2, __VA_ARGS__)
+#define PLUGIN_LOG_WARN(...)     PLUGIN_LOG_AT(3, __VA_ARGS__)
+#define PLUGIN_LOG_ERROR(...)    PLUGIN_LOG_AT(4, __VA_ARGS__)
+#define PLUGIN_LOG_CRITICAL(...) PLUGIN_LOG_AT(5, __VA_ARGS__) 
\ No newline at end of file
@@ -1,21 +1,28 @@
 #pragma once
 
 #include "plugin_interface.hpp"
+#include "plugin_manifest.hpp"
 #include "config/config_base.hpp"
 #include "config/config_loader_base.hpp"
+#include "config/mod_bundle.hpp"
+#include "config/address_map.hpp"
+#include "util/signature_resolver.hpp"
 #include <Windows.h>
+#include <filesystem>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <string>
 #include <memory>
 #include <functional>
 #include <optional>
+#include <span>
 
 namespace app_hook::plugin {
 
 /// @brief Plugin instance wrapper
 struct PluginInstance {
-    HMODULE module_handle;              ///< DLL module handle
+    HMODULE module_handle;              ///< DLL module handle (null for built-in plugins)
     std::unique_ptr<IPlugin> plugin;    ///< Plugin interface
     PluginInfo info;                    ///< Plugin information
     std::string file_path;              ///< Path to plugin DLL
@@ -39,6 +46,21 @@ public:
     /// @brief Set base data path for plugins
     /// @param path Base path for plugin data
     void set_data_path(const std::string& path);
+    
+    /// @brief Set the source of hook statistics returned by get_hook_stats()
+    /// @param provider Function returning the current hook statistics
+    void set_hook_stats_provider(std::function<std::vector<::app_hook::hook::HookStats>()> provider);
+    
+    /// @brief Set the directory holding the signature cache and the address maps
+    /// @param config_dir Config directory (signatures.cache and address_maps/ are kept there)
+    void set_signature_cache_dir(const std::filesystem::path& config_dir);
+    
+    /// @brief Set the mod bundle served by bundle_blob()
+    /// @param bundle Mapped bundle, or nullptr to serve loose files
+    void set_bundle(std::shared_ptr<const ::app_hook::config::ModBundle> bundle);
+    
+    /// @brief Refresh the level reported by is_enabled() from the host logger
+    void sync_log_level();
 
     // IPluginHost interface
     PluginResult register_config(std::unique_ptr<::app_hook::config::ConfigBase> config) override;
@@ -50,10 +72,25 @@ public:
     void log_message_with_location(int level, const std::string& message, const std::source_location& location) override;
     std::pair<void*, std::uint32_t> get_process_info() const override;
     ::app_hook::context::ModContext& get_mod_context() override;
+    std::vector<::app_hook::hook::HookStats> get_hook_stats() const override;
+    void register_memory_source(const std::string& name, ::app_hook::util::MemorySource source) override;
+    void unregister_memory_source(const std::string& name) override;
+    ::app_hook::util::MemoryReport get_memory_report() const override;
+    std::vector<std::uintptr_t> resolve_signatures(const std::vector<std::string>& patterns) override;
+    std::uintptr_t resolve_symbol(const std::string& symbol) override;
+    std::span<const std::uint8_t> bundle_blob(const std::string& path) override;
 
 private:
     std::function<void(std::unique_ptr<::app_hook::config::ConfigBase>)> config_registry_;
+    std::function<std::vector<::app_hook::hook::HookStats>()> hook_stats_provider_;
     std::string data_path_;
+    ::app_hook::util::MemoryAccounting memory_accounting_;
+    std::filesystem::path signature_cache_dir_;
+    std::once_flag signature_resolver_once_;
+    std::unique_ptr<::app_hook::util::SignatureResolver> signature_resolver_;  ///< Created on first use
+    std::once_flag address_map_once_;
+    std::optional<::app_hook::config::AddressMap> address_map_;  ///< Map of this build, selected on first use
+    std::shared_ptr<const ::app_hook::config::ModBundle> bundle_;
 };
 
 /// @brief Plugin manager for loading and managing plugins
@@ -77,16 +114,54 @@ public:
         std::function<void(std::unique_ptr<::app_hook::config::ConfigBase>)> config_registry
     );
 
+    /// @brief Set the source of hook statistics exposed to plugins
+    /// @param provider Function returning the current hook statistics
+    void set_hook_stats_provider(std::function<std::vector<::app_hook::hook::HookStats>()> provider);
+
+    /// @brief Add a host-side source to the memory footprint report
+    /// @param name Source name
+    /// @param source Function returning the source's categories
+    void add_memory_source(const std::string& name, ::app_hook::util::MemorySource source);
+
+    /// @brief Get the memory footprint report shared with plugins
+    /// @return Usage of every registered category and the address space
+    [[nodiscard]] ::app_hook::util::MemoryReport memory_report() const;
+
+    /// @brief Serve the binaries of a mod bundle to plugins
+    /// @param bundle Mapped bundle (set before the plugins initialize)
+    void set_bundle(std::shared_ptr<const ::app_hook::config::ModBundle> bundle);
+
     /// @brief Load a plugin from a DLL file
     /// @param plugin_path Path to the plugin DLL
     /// @return Success if loaded
     [[nodiscard]] PluginResult load_plugin(const std::string& plugin_path);
 
+    /// @brief Add a plugin linked into the host
+    /// @param plugin Plugin instance, initialized with the loaded plugins
+    /// @return Success if added, AlreadyLoaded if a plugin of the same name is loaded
+    /// @note Add built-in plugins before loading the DLLs, so a stale copy of the
+    ///       plugin's DLL is turned away as already loaded
+    [[nodiscard]] PluginResult add_builtin_plugin(std::unique_ptr<IPlugin> plugin);
+
     /// @brief Load all plugins from a directory
     /// @param plugin_directory Directory containing plugin DLLs
     /// @return Number of plugins loaded
     [[nodiscard]] std::size_t load_plugins_from_directory(const std::string& plugin_directory);
 
+    /// @brief Load the plugins of a directory that the enabled tasks need
+    /// @param plugin_directory Directory containing plugin DLLs
+    /// @param tasks_path Path to tasks.toml
+    /// @return Number of plugins loaded
+    /// @note A DLL with a manifest (see PluginManifest) is loaded only if an enabled task
+    ///       uses one of its config types; a DLL without one is always loaded. If tasks.toml
+    ///       cannot be read, every plugin is loaded.
+    [[nodiscard]] std::size_t load_plugins_for_tasks(const std::string& plugin_directory,
+                                                     const std::string& tasks_path);
+
+    /// @brief Get the plugins whose manifest showed no enabled task needs them
+    /// @return Manifests of the DLLs left unloaded by load_plugins_for_tasks
+    [[nodiscard]] std::span<const PluginManifest> skipped_plugins() const noexcept;
+
     /// @brief Initialize all loaded plugins
     /// @param config_path Base configuration path
     /// @return Success if all plugins initialized
@@ -124,12 +199,21 @@ private:
     /// @return Plugin instance or nullptr if failed
     [[nodiscard]] std::unique_ptr<PluginInstance> load_plugin_dll(const std::string& dll_path);
 
+    /// @brief Load the DLLs of a directory selected by a predicate
+    /// @param plugin_directory Directory containing plugin DLLs
+    /// @param should_load Called for each DLL, returns false to leave it unloaded
+    /// @return Number of plugins loaded
+    [[nodiscard]] std::size_t load_plugins_matching(
+        const std::string& plugin_directory,
+        const std::function<bool(const std::filesystem::path&)>& should_load);
+
     /// @brief Validate plugin API version
     /// @param plugin Plugin to validate
     /// @return True if compatible
     [[nodiscard]] bool validate_plugin_version(const IPlugin* plugin) const;
 
     std::unordered_map<std::string, std::unique_ptr<PluginInstance>> plugins_;
+    std::vector<PluginManifest> skipped_plugins_;
     std::unique_ptr<PluginHost> host_;
     bool initialized_;
 };
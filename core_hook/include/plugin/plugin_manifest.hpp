@@ -0,0 +1,48 @@
+#pragma once
+
+#include "config/config_base.hpp"
+#include "config/config_common.hpp"
+#include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace app_hook::plugin {
+
+/// @brief Sidecar description of a plugin, read without loading its DLL
+///
+/// A plugin ships "<dll name>.plugin.toml" next to its DLL:
+///
+///     [plugin]
+///     name = "Memory Operations Plugin"
+///     config_types = ["memory", "patch", "load"]
+///     task_creators = ["app_hook::config::CopyMemoryConfig"]
+///
+/// The plugin manager reads every manifest first and only loads the DLLs whose
+/// config types are used by an enabled task. A DLL without a manifest is
+/// always loaded, as before.
+struct PluginManifest {
+    std::filesystem::path dll_path;                 ///< DLL the manifest describes
+    std::string name;                               ///< Plugin name (informational)
+    std::vector<config::ConfigType> config_types;   ///< Config types the plugin registers loaders for
+    std::vector<std::string> task_creators;         ///< Config type IDs the plugin registers task creators for
+
+    /// @brief Check if the plugin registers a loader for a config type
+    [[nodiscard]] bool provides(config::ConfigType type) const noexcept;
+
+    /// @brief Check if the plugin is needed by any of the given config types
+    [[nodiscard]] bool provides_any(std::span<const config::ConfigType> types) const noexcept;
+};
+
+/// @brief Get the manifest path of a plugin DLL
+/// @param dll_path Plugin DLL
+/// @return "<dir>/<stem>.plugin.toml"
+[[nodiscard]] std::filesystem::path manifest_path_for(const std::filesystem::path& dll_path);
+
+/// @brief Read the manifest of a plugin DLL
+/// @param dll_path Plugin DLL
+/// @return Manifest, file_not_found if the DLL has none, or parse_error / invalid_format
+/// @note Unknown config type names are rejected so a typo cannot silently skip a needed plugin
+[[nodiscard]] config::ConfigResult<PluginManifest> load_plugin_manifest(const std::filesystem::path& dll_path);
+
+} // namespace app_hook::plugin
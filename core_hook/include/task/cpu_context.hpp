@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace app_hook::task {
+
+/// @brief Registers of the hooked code, as the full-context stub saved them
+///
+/// The stub runs pushfd after pushad, so the frame on its stack is EFLAGS then
+/// the pushad block in push-reverse order. Tasks get a reference into that
+/// frame: reading a field reads the register at the hook site, and writing one
+/// sets the value the register has when the original code resumes.
+struct CpuContext {
+    std::uint32_t eflags;
+    std::uint32_t edi;
+    std::uint32_t esi;
+    std::uint32_t ebp;
+    std::uint32_t esp;  ///< Stack pointer at the hook site; popad skips it, so writes are ignored
+    std::uint32_t ebx;
+    std::uint32_t edx;
+    std::uint32_t ecx;
+    std::uint32_t eax;
+
+    /// @brief Read a dword on the hooked code's stack
+    /// @param index Dword index from the stack pointer (0: the return address at a function entry)
+    /// @return Stack slot
+    [[nodiscard]] std::uint32_t& stack(std::size_t index) const noexcept {
+        return reinterpret_cast<std::uint32_t*>(static_cast<std::uintptr_t>(esp))[index];
+    }
+};
+
+static_assert(sizeof(CpuContext) == 36, "CpuContext must match the pushfd + pushad frame");
+
+} // namespace app_hook::task
@@ -1,10 +1,15 @@
 #pragma once
 
+#include "cpu_context.hpp"
 #include <concepts>
+#include <cstddef>
 #include <string>
 #include <memory>
 #include <expected>
 #include <system_error>
+#include <vector>
+
+namespace app_hook::config { class ConfigBase; }
 
 namespace app_hook::task {
 
@@ -19,12 +24,30 @@ enum class TaskError {
     patch_failed,
     unknown_error,
     file_not_found,
-    file_read_error
+    file_read_error,
+    script_error
 };
 
 /// @brief Task result type
 using TaskResult = std::expected<void, TaskError>;
 
+/// @brief What a task did with a hot-reloaded configuration or file
+enum class ReloadOutcome {
+    unchanged,         ///< Nothing the task uses changed
+    updated,           ///< Later runs use the change, and effects already in memory were reapplied
+    dependents_stale,  ///< Updated, but data the following tasks built on moved: they must run again
+    restart_required   ///< The change cannot be applied in place
+};
+
+/// @brief Direct entry point of a task: a plain function and the object it runs on
+/// @note Lets the hook dispatch loop call a task without a virtual lookup. The
+///       context is the hooked code's registers, or nullptr when the hook's
+///       stub did not save them or the task runs off the hooked thread.
+struct TaskThunk {
+    TaskResult (*fn)(void* state, CpuContext* context);
+    void* state;
+};
+
 /// @brief Base concept for hook tasks
 template<typename T>
 concept HookTask = requires(T t) {
@@ -42,6 +65,16 @@ public:
     /// @return Task result indicating success or failure
     [[nodiscard]] virtual TaskResult execute() = 0;
     
+    /// @brief Execute the task with the registers of the hooked code
+    /// @param context Registers saved by the full-context stub, written back when the code resumes
+    /// @return Task result indicating success or failure
+    /// @note Only called for inline tasks of hooks with the full stub; tasks reading
+    ///       registers override it along with needs_registers(). Runs execute() by default
+    [[nodiscard]] virtual TaskResult execute(CpuContext& context) {
+        (void)context;
+        return execute();
+    }
+    
     /// @brief Get the task name
     /// @return Task name
     [[nodiscard]] virtual std::string name() const = 0;
@@ -54,12 +87,82 @@ public:
     /// @param host Plugin host to use for logging
     virtual void setHost(void* host) {}
     
+    /// @brief Get the memory held by the task's configuration
+    /// @return Object and heap bytes of the configuration the task owns (0 if it owns none)
+    [[nodiscard]] virtual std::size_t config_bytes() const noexcept { return 0; }
+    
+    /// @brief Release configuration data execute() no longer needs
+    /// @note Called by HookManager::compact once the hooks are installed; reload(),
+    ///       rollback() and execute() keep working afterwards
+    virtual void compact() {}
+    
+    /// @brief Take over a configuration reparsed from the task's changed config file
+    /// @param updated Configuration with the task's key, of the task's config type
+    /// @return How the change was applied; tasks that cannot reload require a restart
+    /// @note Called on the hot reload thread while the hook may be running, so tasks
+    ///       that reload must synchronize with execute()
+    [[nodiscard]] virtual ReloadOutcome reload(const config::ConfigBase& updated) {
+        (void)updated;
+        return ReloadOutcome::restart_required;
+    }
+    
+    /// @brief Get the files the task reads besides its config file (e.g. a binary it loads)
+    /// @return Paths watched by hot reload
+    [[nodiscard]] virtual std::vector<std::string> watched_files() const { return {}; }
+    
+    /// @brief Re-read the watched files after one of them changed
+    /// @param path Changed file, one of watched_files()
+    /// @return How the change was applied
+    /// @note Called on the hot reload thread, like reload()
+    [[nodiscard]] virtual ReloadOutcome refresh_file(const std::string& path) {
+        (void)path;
+        return ReloadOutcome::restart_required;
+    }
+    
+    /// @brief Undo what execute() left in the process (e.g. restore patched code)
+    /// @note Called by HookManager::uninstall_all once the hook can no longer run the task
+    virtual void rollback() {}
+    
+    /// @brief Check if the task reads or writes the registers of the hooked code
+    /// @return True to give the task's hook the full-context stub (every register saved)
+    [[nodiscard]] virtual bool needs_registers() const noexcept { return false; }
+    
+    /// @brief Get the entry point used by compiled task programs
+    /// @return Thunk calling execute() or execute(CpuContext&) through the vtable;
+    ///         final task types may return make_direct_thunk(this) instead
+    [[nodiscard]] virtual TaskThunk thunk() noexcept {
+        return {&IHookTask::invoke_virtual, this};
+    }
+    
 protected:
+    /// @brief Build a thunk that calls T's execute without virtual dispatch
+    /// @tparam T Concrete (preferably final) task type
+    /// @param task Task to call
+    /// @return Direct thunk for the task; it passes the registers to types that take them
+    template<typename T>
+    [[nodiscard]] static TaskThunk make_direct_thunk(T* task) noexcept {
+        return {[](void* state, CpuContext* context) -> TaskResult {
+            auto* self = static_cast<T*>(state);
+            if constexpr (requires(T& t, CpuContext& c) { { t.T::execute(c) } -> std::same_as<TaskResult>; }) {
+                if (context) {
+                    return self->T::execute(*context);
+                }
+            }
+            return self->T::execute();
+        }, task};
+    }
+    
     IHookTask() = default;
     IHookTask(const IHookTask&) = default;
     IHookTask& operator=(const IHookTask&) = default;
     IHookTask(IHookTask&&) = default;
     IHookTask& operator=(IHookTask&&) = default;
+    
+private:
+    static TaskResult invoke_virtual(void* state, CpuContext* context) {
+        auto* task = static_cast<IHookTask*>(state);
+        return context ? task->execute(*context) : task->execute();
+    }
 };
 
 /// @brief Unique pointer to a hook task
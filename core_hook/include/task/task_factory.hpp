@@ -2,11 +2,15 @@
 
 #include "hook_task.hpp"
 #include "../config/config_base.hpp"
+#include <array>
+#include <concepts>
 #include <functional>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <expected>
+#include <typeindex>
 
 
 
@@ -17,7 +21,30 @@ namespace app_hook::task {
 /// @return Created task or nullptr if failed
 using TaskCreatorFunc = std::function<HookTaskPtr(const config::ConfigBase& config)>;
 
+/// @brief Creator of a task type linked into the host
+/// @param config Configuration of the creator's config class
+/// @param host Plugin host set on the created task
+using BuiltinTaskCreator = HookTaskPtr (*)(const config::ConfigBase& config, void* host);
+
+/// @brief Config class a built-in creator can be registered for
+template<typename ConfigT>
+concept BuiltinConfig = std::derived_from<ConfigT, config::ConfigBase> && requires {
+    { ConfigT::kConfigType } -> std::convertible_to<config::ConfigType>;
+    { ConfigT::kTypeId } -> std::convertible_to<std::string_view>;
+};
+
 /// @brief Generic task factory that supports plugin registration
+///
+/// Creators are registered under the type ID of the configuration class they
+/// handle (ConfigBase::type_id()), so finding the creator of a config is one hash
+/// lookup. A creator is only invoked for configs whose type ID matches its name
+/// and may static_cast to the concrete class. Configs that declare no type ID
+/// are matched once by RTTI name and the result is cached per dynamic type.
+///
+/// Plugins linked into the host register built-in creators instead: a plain
+/// function per config type, found by indexing on ConfigBase::type() and
+/// confirmed by comparing the address of the type ID, so creating one of their
+/// tasks takes neither a string lookup nor a std::function call.
 class TaskFactory {
 public:
     /// @brief Get the singleton instance
@@ -27,11 +54,29 @@ public:
 
 
     /// @brief Register a task creator for a specific config type
-    /// @param config_type_name Name of the configuration type (e.g., "CopyMemoryConfig")
+    /// @param config_type_name Type ID of the configuration class (e.g., CopyMemoryConfig::kTypeId)
     /// @param creator Function to create tasks from this config type
     /// @return True if registered successfully
     bool register_task_creator(const std::string& config_type_name, TaskCreatorFunc creator);
 
+    /// @brief Register the creator of a task type linked into the host
+    /// @tparam ConfigT Config class, declaring its kConfigType and kTypeId
+    /// @tparam TaskT Task constructed from the config
+    /// @param host Plugin host set on every created task
+    /// @note Only one built-in creator per ConfigType; configs of that type with
+    ///       another type ID (e.g. from a plugin DLL) go through the named creators
+    template<BuiltinConfig ConfigT, HookTask TaskT>
+    void register_builtin_creator(void* host) {
+        builtin_creators_[config::to_index(ConfigT::kConfigType)] = {
+            ConfigT::kTypeId.data(), host,
+            [](const config::ConfigBase& config, void* task_host) -> HookTaskPtr {
+                auto task = make_task<TaskT>(static_cast<const ConfigT&>(config));
+                task->setHost(task_host);
+                return task;
+            }};
+        note_builtin_creator(ConfigT::kTypeId);
+    }
+
     /// @brief Create a task from a configuration
     /// @param config Configuration to create task from
     /// @return Created task or nullptr if no creator found
@@ -59,7 +104,34 @@ private:
     TaskFactory(TaskFactory&&) = delete;
     TaskFactory& operator=(TaskFactory&&) = delete;
 
-    std::unordered_map<std::string, TaskCreatorFunc> creators_;
+    /// @brief Transparent hash so string_view type IDs are looked up without a copy
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept { return std::hash<std::string_view>{}(name); }
+    };
+
+    /// @brief Find the creator for a config without a declared type ID
+    /// @param config Configuration to match by RTTI name
+    /// @return Creator or nullptr if none matches
+    const TaskCreatorFunc* resolve_legacy(const config::ConfigBase& config);
+
+    /// @brief Log the registration of a built-in creator
+    void note_builtin_creator(std::string_view type_id);
+
+    /// @brief Built-in creator of one config type
+    struct BuiltinEntry {
+        const char* type_id = nullptr;     ///< Address of the config class's kTypeId characters
+        void* host = nullptr;
+        BuiltinTaskCreator create = nullptr;
+    };
+
+    /// @brief Built-in creators indexed by config::to_index (the extra slot catches out-of-range types)
+    std::array<BuiltinEntry, config::kConfigTypeCount + 1> builtin_creators_{};
+
+    std::unordered_map<std::string, TaskCreatorFunc, NameHash, std::equal_to<>> creators_;
+    
+    /// @brief RTTI matches of configs without a type ID (nullptr: no creator)
+    std::unordered_map<std::type_index, const TaskCreatorFunc*> legacy_creators_;
 };
 
 /// @brief Helper macro to register a task creator
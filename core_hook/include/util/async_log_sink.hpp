@@ -0,0 +1,150 @@
+#pragma once
+
+#include <spdlog/sinks/sink.h>
+#include <spdlog/details/log_msg.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief What a logging call does when the async queue is full
+enum class LogOverflowPolicy {
+    drop,   ///< Discard the record and count it (never stalls the caller)
+    block   ///< Spin until the writer frees a slot
+};
+
+/// @brief Spdlog sink that hands records to a background writer thread
+///
+/// Producers copy each record into a slot of a bounded lock-free MPMC ring
+/// (Vyukov's algorithm); logging from a hooked call costs one slot claim and a
+/// copy of the payload. The writer thread forwards records to the wrapped sinks
+/// in batches and flushes them on an interval, right away for errors, and
+/// whenever it runs out of records. It then blocks until a producer pushes into
+/// the ring it found empty; producers skip the wake-up while it is busy.
+class AsyncLogSink final : public spdlog::sinks::sink {
+public:
+    /// @brief Payload bytes stored inline in a slot; longer messages use a heap string
+    static constexpr std::size_t kInlinePayload = 256;
+    
+    /// @brief Constructor
+    /// @param logger_name Name of the logger feeding this sink (records don't carry it)
+    /// @param sinks Sinks the writer thread forwards records to (must be thread-safe)
+    /// @param capacity Queue capacity in records (rounded up to a power of two)
+    /// @param policy Behavior when the queue is full
+    /// @param flush_interval Maximum delay between a record and its flush
+    AsyncLogSink(std::string logger_name,
+                 std::vector<spdlog::sink_ptr> sinks,
+                 std::size_t capacity,
+                 LogOverflowPolicy policy,
+                 std::chrono::milliseconds flush_interval);
+    
+    /// @brief Stops the writer and drains any remaining records
+    ~AsyncLogSink() override;
+    
+    // Non-copyable, non-movable
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+    AsyncLogSink(AsyncLogSink&&) = delete;
+    AsyncLogSink& operator=(AsyncLogSink&&) = delete;
+    
+    /// @brief Start the background writer thread
+    void start();
+    
+    /// @brief Stop the background writer thread and drain the queue
+    void stop();
+    
+    /// @brief Write every queued record on the calling thread and flush the sinks
+    /// @return Number of records written
+    std::size_t drain();
+    
+    /// @brief Let go of the writer thread without waiting for it, then drain the queue
+    /// @return Number of records written
+    /// @note For a terminating process, whose other threads are already gone: the
+    ///       writer may have been stopped holding its lock, in which case nothing is
+    ///       written. Later stop() calls only repeat the attempt.
+    std::size_t abandon();
+    
+    /// @brief Get the number of records discarded by the drop policy
+    /// @return Dropped record count
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+    
+    /// @brief Get the queue capacity
+    /// @return Capacity in records
+    [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+    
+    // spdlog::sinks::sink interface
+    void log(const spdlog::details::log_msg& msg) override;
+    void flush() override;
+    void set_pattern(const std::string& pattern) override;
+    void set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) override;
+    
+private:
+    /// @brief Copy of a log record that does not reference caller memory
+    struct Record {
+        spdlog::log_clock::time_point time;
+        spdlog::source_loc source;
+        spdlog::level::level_enum level = spdlog::level::info;
+        std::size_t thread_id = 0;
+        std::size_t length = 0;
+        std::array<char, kInlinePayload> inline_payload{};
+        std::string long_payload;
+    };
+    
+    /// @brief Queue cell with its sequence number
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence{0};
+        Record record;
+    };
+    
+    /// @brief Claim a slot and copy the record into it
+    /// @return false if the queue is full
+    bool try_push(const spdlog::details::log_msg& msg);
+    
+    /// @brief Pop one record and forward it to the sinks
+    /// @return false if the queue is empty
+    bool try_pop_and_write();
+    
+    /// @brief Writer thread body
+    void run();
+    
+    /// @brief Block the writer until a producer or stop() wakes it
+    /// @note Returns at once if records arrived after the writer last looked
+    void wait_for_records();
+    
+    /// @brief Wake the writer blocked in wait_for_records
+    void wake_writer();
+    
+    /// @brief Check if the next record to pop is not published yet
+    [[nodiscard]] bool empty() const noexcept;
+    
+    /// @brief Flush every wrapped sink
+    void flush_sinks();
+    
+    std::vector<spdlog::sink_ptr> sinks_;
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_;
+    LogOverflowPolicy policy_;
+    std::chrono::milliseconds flush_interval_;
+    std::string logger_name_;
+    
+    alignas(64) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<std::size_t> dequeue_pos_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<bool> flush_requested_{false};
+    std::atomic<bool> running_{false};
+    std::atomic<bool> abandoned_{false};
+    std::atomic<std::uint32_t> wake_{0};        ///< Bumped to wake the writer
+    std::atomic<bool> writer_idle_{false};      ///< The writer found the ring empty and waits on wake_
+    
+    std::mutex consumer_mutex_;  ///< Held by whoever forwards records (writer or drain)
+    std::thread writer_;
+};
+
+} // namespace app_hook::util
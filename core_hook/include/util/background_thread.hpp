@@ -0,0 +1,19 @@
+#pragma once
+
+#include <thread>
+
+namespace app_hook::util {
+
+/// @brief Wait for a background thread that was told to stop, and release it
+/// @param thread Thread whose loop is exiting; not joinable afterwards
+/// @note Never call under the loader lock (DllMain): an exiting thread needs it
+///       to finish, so the join would never return. app_hook never does: when the
+///       process exits DllMain leaves the threads to the OS, and AppHookUnload
+///       stops them on its own thread before the DLL is freed.
+inline void join_background_thread(std::thread& thread) {
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+} // namespace app_hook::util
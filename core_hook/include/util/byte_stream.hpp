@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Append-only binary writer for cache snapshots
+/// @note Values are written in host byte order; snapshots are only read back
+///       by the same build on the same machine.
+class ByteWriter {
+public:
+    /// @brief Write a trivially copyable value
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    void write(const T& value) {
+        const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+        buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+    }
+
+    /// @brief Write a length-prefixed string
+    void write_string(std::string_view value) {
+        write(static_cast<std::uint32_t>(value.size()));
+        buffer_.insert(buffer_.end(), value.begin(), value.end());
+    }
+
+    /// @brief Write a length-prefixed byte block
+    void write_bytes(std::span<const std::uint8_t> bytes) {
+        write(static_cast<std::uint32_t>(bytes.size()));
+        buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());
+    }
+
+    /// @brief Get the written bytes
+    [[nodiscard]] std::span<const std::uint8_t> data() const noexcept { return buffer_; }
+
+    /// @brief Take the written bytes
+    [[nodiscard]] std::vector<std::uint8_t> release() noexcept { return std::move(buffer_); }
+
+    /// @brief Get the number of written bytes
+    [[nodiscard]] std::size_t size() const noexcept { return buffer_.size(); }
+
+private:
+    std::vector<std::uint8_t> buffer_;
+};
+
+/// @brief Bounds-checked binary reader matching ByteWriter
+/// @note A failed read leaves the reader failed; every later read fails too,
+///       so callers can check ok() once after a batch of reads.
+class ByteReader {
+public:
+    /// @brief Constructor
+    /// @param data Bytes to read (must outlive the reader)
+    explicit ByteReader(std::span<const std::uint8_t> data) noexcept : data_(data) {}
+
+    /// @brief Read a trivially copyable value
+    template<typename T>
+        requires std::is_trivially_copyable_v<T>
+    bool read(T& value) noexcept {
+        if (!take(sizeof(T))) {
+            return false;
+        }
+        std::memcpy(&value, data_.data() + position_ - sizeof(T), sizeof(T));
+        return true;
+    }
+
+    /// @brief Read a length-prefixed string
+    bool read_string(std::string& value) {
+        std::uint32_t size = 0;
+        if (!read(size) || !take(size)) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(data_.data() + position_ - size), size);
+        return true;
+    }
+
+    /// @brief Read a length-prefixed byte block
+    bool read_bytes(std::vector<std::uint8_t>& bytes) {
+        std::uint32_t size = 0;
+        if (!read(size) || !take(size)) {
+            return false;
+        }
+        const auto* begin = data_.data() + position_ - size;
+        bytes.assign(begin, begin + size);
+        return true;
+    }
+
+    /// @brief Check that no read has failed
+    [[nodiscard]] bool ok() const noexcept { return ok_; }
+
+    /// @brief Get the number of unread bytes
+    [[nodiscard]] std::size_t remaining() const noexcept { return data_.size() - position_; }
+
+private:
+    /// @brief Consume bytes if enough remain
+    bool take(std::size_t size) noexcept {
+        if (!ok_ || size > remaining()) {
+            ok_ = false;
+            return false;
+        }
+        position_ += size;
+        return true;
+    }
+
+    std::span<const std::uint8_t> data_;
+    std::size_t position_ = 0;
+    bool ok_ = true;
+};
+
+/// @brief 64-bit FNV-1a hash of a byte block
+/// @param bytes Bytes to hash
+/// @return Hash value
+[[nodiscard]] constexpr std::uint64_t fnv1a_64(std::span<const std::uint8_t> bytes) noexcept {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (const auto byte : bytes) {
+        hash = (hash ^ byte) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+} // namespace app_hook::util
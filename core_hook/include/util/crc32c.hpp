@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace app_hook::util {
+
+/// @brief CRC32C (Castagnoli) of some bytes
+///
+/// Uses the SSE4.2 crc32 instruction when the CPU has it and a slicing-by-8
+/// table walk otherwise; both give the same result. Pass the checksum of the
+/// preceding bytes to extend a running checksum over several ranges.
+/// @param bytes Bytes to checksum
+/// @param crc Checksum of the bytes before these (0 to start)
+/// @return Checksum
+[[nodiscard]] std::uint32_t crc32c(std::span<const std::uint8_t> bytes, std::uint32_t crc = 0) noexcept;
+
+/// @brief CRC32C through the slicing-by-8 tables only
+/// @param bytes Bytes to checksum
+/// @param crc Checksum of the bytes before these (0 to start)
+/// @return Checksum
+[[nodiscard]] std::uint32_t crc32c_portable(std::span<const std::uint8_t> bytes, std::uint32_t crc = 0) noexcept;
+
+/// @brief Check if crc32c() runs on the SSE4.2 instruction
+[[nodiscard]] bool crc32c_accelerated() noexcept;
+
+} // namespace app_hook::util
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../task/hook_task.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Outcome of one node of a DagExecutor run
+struct DagRun {
+    std::string name;                       ///< Name given to the node
+    task::TaskResult result;                ///< Result of the work, or dependency_not_met if skipped
+    std::chrono::nanoseconds elapsed{0};    ///< Time spent in the work (0 if skipped)
+    bool skipped = false;                   ///< A parent failed, was skipped or is in a cycle
+};
+
+/// @brief Runs a dependency graph of tasks on a work-stealing thread set
+///
+/// Each thread owns a deque of ready nodes. A node that finishes releases its
+/// followers; those whose parents are all done are pushed on the finishing
+/// thread's own deque and popped from its back, so a chain stays on one thread
+/// while idle threads steal from the front of the others. A run therefore takes
+/// about the time of the graph's critical path. A node whose parent failed is
+/// not run, and neither are its own followers.
+class DagExecutor {
+public:
+    /// @brief Dense node identifier, in the order nodes are added
+    using NodeId = std::uint32_t;
+
+    /// @brief Work of one node
+    using Work = std::function<task::TaskResult()>;
+
+    /// @brief Add a node
+    /// @param name Name reported in the run results
+    /// @param work Work to run once the node's parents have succeeded
+    /// @return ID of the node
+    NodeId add(std::string name, Work work);
+
+    /// @brief Make a node wait for another
+    /// @param parent Node that must succeed first
+    /// @param follower Node that runs after it
+    /// @note Unknown IDs and self edges are ignored
+    void add_edge(NodeId parent, NodeId follower);
+
+    /// @brief Get the number of nodes
+    [[nodiscard]] std::size_t size() const noexcept { return nodes_.size(); }
+
+    /// @brief Run every node once, parents before followers
+    /// @param thread_count Threads to use, the calling thread included (0 picks the core count)
+    /// @return One result per node, in node order
+    /// @note Nodes caught in a cycle, and their followers, are reported skipped.
+    ///       Work that throws is reported as unknown_error
+    [[nodiscard]] std::vector<DagRun> run(std::size_t thread_count = 0);
+
+private:
+    /// @brief A node and its outgoing edges
+    struct Node {
+        std::string name;
+        Work work;
+        std::vector<NodeId> followers;
+        std::uint32_t parent_count = 0;
+    };
+
+    std::vector<Node> nodes_;
+};
+
+} // namespace app_hook::util
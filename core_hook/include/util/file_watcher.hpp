@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Coalesces bursts of change notifications per file
+///
+/// Editors save a file in several writes (truncate, write, rename over), each
+/// reported separately. A path becomes due once it has been quiet for the
+/// debounce delay, so it is handled once per save.
+class ChangeDebouncer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief Constructor
+    /// @param delay Quiet time before a changed path is reported
+    explicit ChangeDebouncer(std::chrono::milliseconds delay) noexcept : delay_(delay) {}
+
+    /// @brief Record a change
+    /// @param path Changed file
+    /// @param now Time of the change
+    void touch(const std::filesystem::path& path, Clock::time_point now);
+
+    /// @brief Take the paths that have been quiet for the delay
+    /// @param now Current time
+    /// @return Due paths, removed from the pending set
+    [[nodiscard]] std::vector<std::filesystem::path> take_due(Clock::time_point now);
+
+    /// @brief Get the time until the next path is due
+    /// @param now Current time
+    /// @return Wait time, zero if a path is due, or milliseconds::max() if nothing is pending
+    [[nodiscard]] std::chrono::milliseconds time_to_next(Clock::time_point now) const;
+
+    /// @brief Check if any change is pending
+    [[nodiscard]] bool empty() const noexcept { return pending_.empty(); }
+
+private:
+    std::chrono::milliseconds delay_;
+    std::map<std::filesystem::path, Clock::time_point> pending_;  ///< Last change of each path
+};
+
+/// @brief Watches directories for file changes on a background thread
+///
+/// Every directory is watched with ReadDirectoryChangesW. Written, created and
+/// renamed-to files are reported once they have been quiet for the debounce
+/// delay; removals are ignored. The callback runs on the watcher thread.
+class FileWatcher {
+public:
+    /// @brief Called with the absolute path of a changed file
+    using Callback = std::function<void(const std::filesystem::path&)>;
+
+    /// @brief Debounce delay used when none is given
+    static constexpr std::chrono::milliseconds kDefaultDebounce{150};
+
+    /// @brief Constructor
+    /// @param callback Change handler
+    /// @param debounce Quiet time before a changed file is reported
+    explicit FileWatcher(Callback callback, std::chrono::milliseconds debounce = kDefaultDebounce);
+
+    /// @brief Stops the watcher thread
+    ~FileWatcher();
+
+    // Non-copyable, non-movable
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+    FileWatcher(FileWatcher&&) = delete;
+    FileWatcher& operator=(FileWatcher&&) = delete;
+
+    /// @brief Add a directory to watch (before start)
+    /// @param directory Directory to watch
+    /// @param recursive Also watch its subdirectories
+    /// @return false if the directory cannot be opened or the watcher is running
+    /// @note A directory already watched is not added twice
+    bool add_directory(const std::filesystem::path& directory, bool recursive);
+
+    /// @brief Start the watcher thread
+    /// @return false if no directory is watched or the thread is already running
+    bool start();
+
+    /// @brief Stop the watcher thread; pending changes are dropped
+    /// @note Joins the thread (see join_background_thread)
+    void stop();
+
+    /// @brief Check if the watcher thread is running
+    [[nodiscard]] bool running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+    /// @brief Get the number of watched directories
+    [[nodiscard]] std::size_t directory_count() const noexcept { return watches_.size(); }
+
+private:
+    struct Watch;
+
+    Callback callback_;
+    ChangeDebouncer debouncer_;
+    std::vector<std::unique_ptr<Watch>> watches_;
+    void* stop_event_ = nullptr;           ///< Manual-reset event signaled by stop()
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    /// @brief Watcher thread loop
+    void run();
+
+    /// @brief Queue the next change read of a directory
+    /// @return false if the read cannot be issued
+    [[nodiscard]] bool arm(Watch& watch);
+
+    /// @brief Record the changes read for a directory
+    void collect(Watch& watch, unsigned long bytes);
+};
+
+} // namespace app_hook::util
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+
+namespace app_hook::util {
+
+/// @brief Layout of a hex dump
+enum class HexStyle : std::uint8_t {
+    spaced,    ///< "8D 86 00 10"
+    prefixed   ///< "0x8D 0x86 0x00 0x10"
+};
+
+/// @brief Upper-case hex digit pairs of every byte value, two characters per byte
+inline constexpr auto kHexPairs = [] {
+    constexpr char digits[] = "0123456789ABCDEF";
+    std::array<char, 512> pairs{};
+    for (std::size_t i = 0; i < 256; ++i) {
+        pairs[2 * i] = digits[i >> 4];
+        pairs[2 * i + 1] = digits[i & 0x0F];
+    }
+    return pairs;
+}();
+
+/// @brief Write the two hex digits of a byte
+/// @param byte Byte to encode
+/// @param out Destination (at least two characters)
+/// @return Pointer past the written digits
+constexpr char* encode_hex_byte(std::uint8_t byte, char* out) noexcept {
+    out[0] = kHexPairs[2 * byte];
+    out[1] = kHexPairs[2 * byte + 1];
+    return out + 2;
+}
+
+/// @brief Non-owning view of bytes that formats as hex
+///
+/// Constructing a dump only records the span, so it costs nothing when passed to
+/// a log call whose level is disabled. std::format encodes the bytes through a
+/// lookup table into a small stack buffer and copies that straight into the
+/// output, without building an intermediate string.
+/// @note The bytes must stay valid until the dump is formatted
+class HexDump {
+public:
+    /// @brief Constructor
+    /// @param bytes Bytes to dump
+    /// @param style Separator and prefix of each byte
+    /// @param bytes_per_line Start a new line after this many bytes (0 for a single line)
+    constexpr explicit HexDump(std::span<const std::uint8_t> bytes, HexStyle style = HexStyle::spaced,
+                               std::size_t bytes_per_line = 0) noexcept
+        : bytes_(bytes), style_(style), bytes_per_line_(bytes_per_line) {}
+
+    /// @brief Get the dumped bytes
+    [[nodiscard]] constexpr std::span<const std::uint8_t> bytes() const noexcept { return bytes_; }
+
+    /// @brief Get the number of characters the dump formats to
+    [[nodiscard]] constexpr std::size_t formatted_size() const noexcept {
+        if (bytes_.empty()) {
+            return 0;
+        }
+        return bytes_.size() * byte_width() + (bytes_.size() - 1);
+    }
+
+    /// @brief Write the dump to an output iterator
+    /// @param out Destination
+    /// @return Iterator past the written characters
+    template<typename OutputIt>
+    OutputIt format_to(OutputIt out) const {
+        // Room for a whole number of bytes, each with its separator
+        constexpr std::size_t kBufferSize = 256;
+        std::array<char, kBufferSize> buffer;
+        char* cursor = buffer.data();
+        const char* const limit = buffer.data() + kBufferSize - (kMaxByteWidth + 1);
+
+        for (std::size_t i = 0; i < bytes_.size(); ++i) {
+            if (i > 0) {
+                *cursor++ = bytes_per_line_ && i % bytes_per_line_ == 0 ? '\n' : ' ';
+            }
+            if (style_ == HexStyle::prefixed) {
+                *cursor++ = '0';
+                *cursor++ = 'x';
+            }
+            cursor = encode_hex_byte(bytes_[i], cursor);
+            if (cursor >= limit) {
+                out = std::copy(buffer.data(), cursor, out);
+                cursor = buffer.data();
+            }
+        }
+        return std::copy(buffer.data(), cursor, out);
+    }
+
+private:
+    static constexpr std::size_t kMaxByteWidth = 4;
+
+    [[nodiscard]] constexpr std::size_t byte_width() const noexcept {
+        return style_ == HexStyle::prefixed ? 4 : 2;
+    }
+
+    std::span<const std::uint8_t> bytes_;
+    HexStyle style_;
+    std::size_t bytes_per_line_;
+};
+
+} // namespace app_hook::util
+
+/// @brief Format a HexDump with "{}" (no format options)
+template<>
+struct std::formatter<app_hook::util::HexDump, char> {
+    constexpr auto parse(std::format_parse_context& ctx) {
+        auto it = ctx.begin();
+        if (it != ctx.end() && *it != '}') {
+            throw std::format_error("HexDump takes no format options");
+        }
+        return it;
+    }
+
+    template<typename FormatContext>
+    auto format(const app_hook::util::HexDump& dump, FormatContext& ctx) const {
+        return dump.format_to(ctx.out());
+    }
+};
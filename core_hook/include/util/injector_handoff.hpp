@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Settings the injector hands to app_hook before it is loaded
+///
+/// The injector writes them to a named shared-memory block of the target
+/// process, which app_hook reads once in DllMain: no temporary file, and the
+/// install thread does no I/O to find its paths. The block is a header followed
+/// by tag-length-value records, so a newer injector can add records that an
+/// older DLL skips.
+/// @note Header-only: the injector includes it without linking core_hook
+struct InjectorHandoff {
+    std::string config_dir;  ///< Directory of tasks.toml and the plugin config files
+    std::string plugin_dir;  ///< Directory plugins are loaded from
+    bool hot_reload = false; ///< Watch config files and mod binaries and apply their changes live
+    bool pack_bundle = false; ///< Pack the loaded configs and mod binaries into the config dir's mod bundle
+    std::string trace_path;  ///< Record hook triggers and write them here at exit (empty: not recording)
+};
+
+/// @brief Record tags of the handoff block
+enum class HandoffTag : std::uint16_t {
+    config_dir = 1,
+    plugin_dir = 2,
+    hot_reload = 3,  ///< One byte, non-zero when enabled; written only when enabled
+    pack_bundle = 4, ///< One byte, non-zero when requested; written only when requested
+    trace_path = 5   ///< Written only when recording
+};
+
+/// @brief Error types for handoff decoding
+enum class HandoffError {
+    truncated,            ///< Block or record shorter than declared
+    bad_magic,            ///< Not a handoff block
+    unsupported_version   ///< Block written by an incompatible injector
+};
+
+/// @brief Identifies a handoff block ("FFH1")
+inline constexpr std::uint32_t kHandoffMagic = 0x31484646;
+
+/// @brief Layout version; bumped only for changes older DLLs cannot skip
+inline constexpr std::uint16_t kHandoffVersion = 1;
+
+/// @brief Size of the block header: magic, version, reserved, total size
+inline constexpr std::size_t kHandoffHeaderSize = 12;
+
+/// @brief Size of a record header: tag, value length
+inline constexpr std::size_t kHandoffRecordHeaderSize = 6;
+
+/// @brief Get the name of the shared-memory block of a process
+/// @param process_id Target process ID
+/// @return Mapping name
+[[nodiscard]] inline std::string handoff_mapping_name(std::uint32_t process_id) {
+    return std::format("Local\\app_hook_handoff_{}", process_id);
+}
+
+namespace detail {
+
+template<typename T>
+void append_le(std::vector<std::uint8_t>& out, T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+    }
+}
+
+template<typename T>
+[[nodiscard]] T read_le(const std::uint8_t* bytes) noexcept {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(static_cast<T>(bytes[i]) << (8 * i));
+    }
+    return value;
+}
+
+inline void append_record(std::vector<std::uint8_t>& out, HandoffTag tag, std::string_view value) {
+    append_le(out, static_cast<std::uint16_t>(tag));
+    append_le(out, static_cast<std::uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+} // namespace detail
+
+/// @brief Serialize handoff settings
+/// @param handoff Settings to write
+/// @return Block bytes, header included
+[[nodiscard]] inline std::vector<std::uint8_t> encode_handoff(const InjectorHandoff& handoff) {
+    std::vector<std::uint8_t> out;
+    out.reserve(kHandoffHeaderSize + 2 * kHandoffRecordHeaderSize + handoff.config_dir.size() +
+                handoff.plugin_dir.size());
+    detail::append_le(out, kHandoffMagic);
+    detail::append_le(out, kHandoffVersion);
+    detail::append_le(out, std::uint16_t{0});
+    detail::append_le(out, std::uint32_t{0});  // Total size, patched below
+
+    detail::append_record(out, HandoffTag::config_dir, handoff.config_dir);
+    detail::append_record(out, HandoffTag::plugin_dir, handoff.plugin_dir);
+    if (handoff.hot_reload) {
+        detail::append_record(out, HandoffTag::hot_reload, std::string_view("\x01", 1));
+    }
+    if (handoff.pack_bundle) {
+        detail::append_record(out, HandoffTag::pack_bundle, std::string_view("\x01", 1));
+    }
+    if (!handoff.trace_path.empty()) {
+        detail::append_record(out, HandoffTag::trace_path, handoff.trace_path);
+    }
+
+    const auto size = static_cast<std::uint32_t>(out.size());
+    for (std::size_t i = 0; i < sizeof(size); ++i) {
+        out[8 + i] = static_cast<std::uint8_t>(size >> (8 * i));
+    }
+    return out;
+}
+
+/// @brief Parse a handoff block
+/// @param bytes Mapped block; may be longer than the block (mappings are page sized)
+/// @return Settings, with unknown records skipped, or error
+[[nodiscard]] inline std::expected<InjectorHandoff, HandoffError> decode_handoff(std::span<const std::uint8_t> bytes) {
+    if (bytes.size() < kHandoffHeaderSize) {
+        return std::unexpected(HandoffError::truncated);
+    }
+    if (detail::read_le<std::uint32_t>(bytes.data()) != kHandoffMagic) {
+        return std::unexpected(HandoffError::bad_magic);
+    }
+    if (detail::read_le<std::uint16_t>(bytes.data() + 4) != kHandoffVersion) {
+        return std::unexpected(HandoffError::unsupported_version);
+    }
+    const std::size_t size = detail::read_le<std::uint32_t>(bytes.data() + 8);
+    if (size < kHandoffHeaderSize || size > bytes.size()) {
+        return std::unexpected(HandoffError::truncated);
+    }
+
+    InjectorHandoff handoff;
+    std::size_t offset = kHandoffHeaderSize;
+    while (offset < size) {
+        if (size - offset < kHandoffRecordHeaderSize) {
+            return std::unexpected(HandoffError::truncated);
+        }
+        const auto tag = static_cast<HandoffTag>(detail::read_le<std::uint16_t>(bytes.data() + offset));
+        const std::size_t length = detail::read_le<std::uint32_t>(bytes.data() + offset + 2);
+        offset += kHandoffRecordHeaderSize;
+        if (length > size - offset) {
+            return std::unexpected(HandoffError::truncated);
+        }
+
+        const std::string_view value(reinterpret_cast<const char*>(bytes.data() + offset), length);
+        switch (tag) {
+            case HandoffTag::config_dir: handoff.config_dir = value; break;
+            case HandoffTag::plugin_dir: handoff.plugin_dir = value; break;
+            case HandoffTag::hot_reload: handoff.hot_reload = !value.empty() && value[0] != '\0'; break;
+            case HandoffTag::pack_bundle: handoff.pack_bundle = !value.empty() && value[0] != '\0'; break;
+            case HandoffTag::trace_path: handoff.trace_path = value; break;
+            default: break;  // Written by a newer injector
+        }
+        offset += length;
+    }
+    return handoff;
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Value published through a sequence lock, readable from another process
+///
+/// The single writer makes the sequence odd, stores the value word by word and
+/// makes the sequence even again; the stores are plain relaxed stores, with no
+/// lock and no read-modify-write. A reader copies the words and retries while
+/// the sequence was odd or changed under it, so it never sees a torn value and
+/// never slows the writer down. Lock-free 32-bit atomics are address-free, so
+/// the cell works in memory shared between processes.
+/// @tparam T Trivially copyable value whose size is a multiple of 4
+template<typename T>
+class SeqlockCell {
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(std::uint32_t) == 0);
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free);
+
+public:
+    /// @brief Publish a value (single writer)
+    /// @param value Value to publish
+    void store(const T& value) noexcept {
+        std::array<std::uint32_t, kWords> words;
+        std::memcpy(words.data(), &value, sizeof(T));
+        const auto sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words_[i].store(words[i], std::memory_order_relaxed);
+        }
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /// @brief Read the value once
+    /// @param out Receives the value when the read was consistent
+    /// @return false if the writer was storing it; try again
+    [[nodiscard]] bool try_load(T& out) const noexcept {
+        const auto before = sequence_.load(std::memory_order_acquire);
+        if (before & 1) {
+            return false;
+        }
+        std::array<std::uint32_t, kWords> words;
+        for (std::size_t i = 0; i < kWords; ++i) {
+            words[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence_.load(std::memory_order_relaxed) != before) {
+            return false;
+        }
+        std::memcpy(&out, words.data(), sizeof(T));
+        return true;
+    }
+
+    /// @brief Read the value, retrying until the read is consistent
+    /// @return Last published value (zeroed if none was)
+    [[nodiscard]] T load() const noexcept {
+        T value{};
+        while (!try_load(value)) {
+        }
+        return value;
+    }
+
+    /// @brief Get the number of values published so far
+    [[nodiscard]] std::uint32_t version() const noexcept { return sequence_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr std::size_t kWords = sizeof(T) / sizeof(std::uint32_t);
+
+    std::atomic<std::uint32_t> sequence_{0};
+    std::array<std::atomic<std::uint32_t>, kWords> words_{};
+};
+
+/// @brief Length of the names stored in the metrics block, terminator included
+inline constexpr std::size_t kMetricsNameSize = 48;
+
+/// @brief Hook, task, memory and plugin slots of the metrics block
+inline constexpr std::size_t kMetricsMaxHooks = 256;
+inline constexpr std::size_t kMetricsMaxTasks = 512;
+inline constexpr std::size_t kMetricsMaxMemory = 32;
+inline constexpr std::size_t kMetricsMaxPlugins = 32;
+
+/// @brief Identifies a metrics block ("FFM1")
+inline constexpr std::uint32_t kMetricsMagic = 0x314D4646;
+
+/// @brief Layout version of the metrics block
+inline constexpr std::uint32_t kMetricsVersion = 1;
+
+/// @brief Counters of one hook
+struct HookMetrics {
+    std::uint32_t address = 0;      ///< Hooked address
+    std::uint32_t task_count = 0;   ///< Tasks chained to the hook
+    std::uint64_t calls = 0;        ///< Triggers that ran the tasks
+    std::uint64_t total_ns = 0;     ///< Time spent in dispatch
+    std::uint64_t max_ns = 0;       ///< Longest dispatch
+    std::uint64_t failures = 0;     ///< Triggers where a task failed
+};
+
+/// @brief Counters of one task
+struct TaskMetrics {
+    std::uint32_t hook_address = 0; ///< Hook the task is chained to
+    std::uint32_t reserved = 0;
+    std::uint64_t calls = 0;        ///< Runs of the task
+    std::uint64_t total_ns = 0;     ///< Time spent in the task
+    std::uint64_t max_ns = 0;       ///< Longest run
+    std::uint64_t failures = 0;     ///< Failed runs
+    char name[kMetricsNameSize]{};  ///< Task name (truncated)
+};
+
+/// @brief Size of one memory category (e.g. relocated regions)
+struct MemoryMetrics {
+    std::uint64_t count = 0;            ///< Live objects
+    std::uint64_t bytes = 0;            ///< Bytes in use
+    std::uint64_t committed_bytes = 0;  ///< Committed pages backing them
+    std::uint64_t reserved_bytes = 0;   ///< Reserved address space
+    char category[kMetricsNameSize]{};  ///< Category name (truncated)
+};
+
+/// @brief State of one plugin
+struct PluginMetrics {
+    std::uint32_t loaded = 0;       ///< 1 if loaded, 0 if skipped because no task needs it
+    std::uint32_t reserved = 0;
+    char name[kMetricsNameSize]{};  ///< Plugin name (truncated)
+};
+
+/// @brief What a publish wrote and when
+struct MetricsSummary {
+    std::uint64_t published_ms = 0; ///< GetTickCount64 of the last publish
+    std::uint32_t publishes = 0;    ///< Publishes so far
+    std::uint32_t hook_count = 0;   ///< Valid hook slots (more hooks are not shown)
+    std::uint32_t task_count = 0;   ///< Valid task slots
+    std::uint32_t memory_count = 0; ///< Valid memory slots
+    std::uint32_t plugin_count = 0; ///< Valid plugin slots
+    std::uint32_t dropped = 0;      ///< Entries that did not fit the block
+};
+
+/// @brief Shared-memory block the DLL publishes its live metrics into
+/// @note The block is zero-filled by the mapping, which is a valid empty state
+struct MetricsBlock {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t size;             ///< sizeof(MetricsBlock) of the writer
+    std::uint32_t process_id;
+    SeqlockCell<MetricsSummary> summary;
+    std::array<SeqlockCell<HookMetrics>, kMetricsMaxHooks> hooks;
+    std::array<SeqlockCell<TaskMetrics>, kMetricsMaxTasks> tasks;
+    std::array<SeqlockCell<MemoryMetrics>, kMetricsMaxMemory> memory;
+    std::array<SeqlockCell<PluginMetrics>, kMetricsMaxPlugins> plugins;
+};
+
+/// @brief Everything one publish carries, as plain values
+struct MetricsFrame {
+    MetricsSummary summary;
+    std::vector<HookMetrics> hooks;
+    std::vector<TaskMetrics> tasks;
+    std::vector<MemoryMetrics> memory;
+    std::vector<PluginMetrics> plugins;
+};
+
+/// @brief Get the name of the metrics block of a process
+/// @param process_id Process running app_hook
+/// @return Mapping name
+[[nodiscard]] inline std::string metrics_mapping_name(std::uint32_t process_id) {
+    return std::format("Local\\app_hook_metrics_{}", process_id);
+}
+
+/// @brief Copy a name into a fixed metrics field, truncating it
+/// @param field Destination field
+/// @param name Name to copy
+inline void copy_metrics_name(char (&field)[kMetricsNameSize], std::string_view name) noexcept {
+    const auto length = std::min(name.size(), kMetricsNameSize - 1);
+    std::memcpy(field, name.data(), length);
+    std::memset(field + length, 0, kMetricsNameSize - length);
+}
+
+/// @brief Check that a mapped block was written with this layout
+/// @param block Mapped block
+/// @param mapped_size Bytes mapped
+[[nodiscard]] inline bool metrics_block_valid(const MetricsBlock& block, std::size_t mapped_size) noexcept {
+    return mapped_size >= sizeof(MetricsBlock) && block.magic == kMetricsMagic &&
+           block.version == kMetricsVersion && block.size == sizeof(MetricsBlock);
+}
+
+/// @brief Read a consistent copy of every valid slot
+/// @param block Block checked with metrics_block_valid
+/// @return Frame; each slot is consistent on its own, slots may come from consecutive publishes
+[[nodiscard]] inline MetricsFrame read_metrics(const MetricsBlock& block) {
+    MetricsFrame frame;
+    frame.summary = block.summary.load();
+    auto read = [](const auto& cells, std::uint32_t count, auto& out) {
+        count = std::min<std::uint32_t>(count, static_cast<std::uint32_t>(cells.size()));
+        out.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            out.push_back(cells[i].load());
+        }
+    };
+    read(block.hooks, frame.summary.hook_count, frame.hooks);
+    read(block.tasks, frame.summary.task_count, frame.tasks);
+    read(block.memory, frame.summary.memory_count, frame.memory);
+    read(block.plugins, frame.summary.plugin_count, frame.plugins);
+    return frame;
+}
+
+} // namespace app_hook::util
@@ -2,7 +2,9 @@
 
 #include <string>
 #include <format>
+#include <chrono>
 #include <spdlog/spdlog.h>
+#include "async_log_sink.hpp"
 
 namespace app_hook::util {
 
@@ -16,15 +18,29 @@ enum class LogLevel : int {
     Critical = 5
 };
 
+/// @brief Logging backend options
+struct LoggingOptions {
+    bool async = false;                                   ///< Hand records to a background writer thread
+    std::size_t queue_capacity = 8192;                    ///< Async queue capacity in records
+    LogOverflowPolicy overflow = LogOverflowPolicy::drop; ///< Behavior when the async queue is full
+    std::chrono::milliseconds flush_interval{250};        ///< Maximum delay before queued records hit the file
+};
+
 /// @brief Initialize logging system with file and console output
 /// @param log_file_path Path to log file
 /// @param level Log level (0=trace, 1=debug, 2=info, 3=warn, 4=error, 5=critical)
+/// @param options Backend options; synchronous logging by default
 /// @return true if successful
-bool initialize_logging(const std::string& log_file_path, int level = 2);
+bool initialize_logging(const std::string& log_file_path, int level = 2, const LoggingOptions& options = {});
 
 /// @brief Close logging system
 void shutdown_logging();
 
+/// @brief Write out the queued log records of a terminating process
+/// @note Does not wait for the async writer thread, which the exit has already
+///       stopped; the logger stays in place for whatever logs after this
+void flush_logging_at_exit();
+
 } // namespace app_hook::util
 
 /// @brief Convenient logging macros that capture source location
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Memory held by one category of framework objects
+struct MemoryUsage {
+    std::string category;              ///< What the memory holds, e.g. "hook.stubs"
+    std::size_t count = 0;             ///< Number of live objects
+    std::size_t bytes = 0;             ///< Bytes in use
+    std::size_t peak_bytes = 0;        ///< Highest bytes value seen
+    std::size_t committed_bytes = 0;   ///< Committed pages backing the objects (0 for heap memory)
+    std::size_t reserved_bytes = 0;    ///< Reserved address space (0 for heap memory)
+};
+
+/// @brief Function returning the current usage of a memory source
+using MemorySource = std::function<std::vector<MemoryUsage>()>;
+
+/// @brief State of the process address space
+struct AddressSpaceUsage {
+    std::size_t free_bytes = 0;          ///< Free address space
+    std::size_t largest_free_block = 0;  ///< Largest contiguous free range
+    std::size_t free_blocks = 0;         ///< Number of free ranges
+    std::size_t committed_bytes = 0;     ///< Committed memory, all owners included
+    std::size_t reserved_bytes = 0;      ///< Reserved but uncommitted address space
+
+    /// @brief Get how scattered the free address space is
+    /// @return 0 when all free space is one block, approaching 1 as it splits up
+    [[nodiscard]] double fragmentation() const noexcept {
+        return free_bytes ? 1.0 - static_cast<double>(largest_free_block) / static_cast<double>(free_bytes) : 0.0;
+    }
+};
+
+/// @brief Memory footprint of the framework and its plugins
+struct MemoryReport {
+    std::vector<MemoryUsage> entries;    ///< One entry per category, in source registration order
+    AddressSpaceUsage address_space;     ///< Address space of the whole process
+
+    /// @brief Get the bytes in use across all categories
+    [[nodiscard]] std::size_t total_bytes() const noexcept {
+        std::size_t total = 0;
+        for (const auto& entry : entries) {
+            total += entry.bytes;
+        }
+        return total;
+    }
+
+    /// @brief Find the entry of a category
+    /// @param category Category name
+    /// @return Entry or nullptr if the category was not reported
+    [[nodiscard]] const MemoryUsage* find(std::string_view category) const noexcept {
+        for (const auto& entry : entries) {
+            if (entry.category == category) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+};
+
+/// @brief Registry of the memory sources behind a MemoryReport
+///
+/// Each owner of memory (hook stubs, the context, a plugin's arena) registers a
+/// named source that describes its categories when a report is taken. Sources
+/// are called without the registry lock held, so they may take their own locks.
+/// The registry remembers the highest bytes value of every category, which makes
+/// peak_bytes meaningful even for sources that only know their current size.
+class MemoryAccounting {
+public:
+    /// @brief Register a source, replacing any source of the same name
+    /// @param name Source name
+    /// @param source Function returning the source's categories
+    void add_source(std::string name, MemorySource source);
+
+    /// @brief Unregister a source
+    /// @param name Source name
+    /// @return true if a source was removed
+    bool remove_source(const std::string& name);
+
+    /// @brief Get the number of registered sources
+    [[nodiscard]] std::size_t source_count() const;
+
+    /// @brief Collect every source and the state of the address space
+    /// @return Report with peaks updated
+    [[nodiscard]] MemoryReport report() const;
+
+private:
+    mutable std::mutex mutex_;  ///< Guards sources_ and peaks_
+    std::vector<std::pair<std::string, MemorySource>> sources_;
+    mutable std::unordered_map<std::string, std::size_t> peaks_;
+};
+
+/// @brief Walk the process address space
+/// @return Free, reserved and committed totals with the largest free block
+[[nodiscard]] AddressSpaceUsage query_address_space();
+
+/// @brief Write a report to the log, one line per category
+/// @param report Report to log
+void log_memory_report(const MemoryReport& report);
+
+} // namespace app_hook::util
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "live_metrics.hpp"
+#include <Windows.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace app_hook::util {
+
+/// @brief Publishes live metrics into a named shared-memory block
+///
+/// A background thread calls the collector at a fixed interval and copies the
+/// frame into the block's seqlock cells, so the game threads only ever touch
+/// their own counters and an outside reader (app_injector --stats) costs them
+/// nothing. Entries beyond the block's capacity are counted as dropped.
+class MetricsPublisher {
+public:
+    /// @brief Fills a frame with the current values (called on the publisher thread)
+    using Collector = std::function<void(MetricsFrame&)>;
+
+    /// @brief Time between publishes
+    static constexpr std::chrono::milliseconds kDefaultInterval{1000};
+
+    MetricsPublisher() = default;
+
+    /// @brief Stops the thread and unmaps the block
+    ~MetricsPublisher();
+
+    // Non-copyable, non-movable (the thread points to the publisher)
+    MetricsPublisher(const MetricsPublisher&) = delete;
+    MetricsPublisher& operator=(const MetricsPublisher&) = delete;
+    MetricsPublisher(MetricsPublisher&&) = delete;
+    MetricsPublisher& operator=(MetricsPublisher&&) = delete;
+
+    /// @brief Create and map the block
+    /// @param name Mapping name (metrics_mapping_name of the current process)
+    /// @return false if the mapping cannot be created or is already open
+    [[nodiscard]] bool open(const std::string& name);
+
+    /// @brief Copy a frame into the block
+    /// @param frame Values to publish; its summary counts are ignored
+    void publish(const MetricsFrame& frame);
+
+    /// @brief Publish from a background thread until stop()
+    /// @param collector Fills each frame
+    /// @param interval Time between publishes
+    /// @return false if the block is not open or the thread already runs
+    bool start(Collector collector, std::chrono::milliseconds interval = kDefaultInterval);
+
+    /// @brief Stop the background thread
+    /// @note Joins the thread (see join_background_thread)
+    void stop();
+
+    /// @brief Get the mapped block
+    /// @return Block or nullptr if not open
+    [[nodiscard]] const MetricsBlock* block() const noexcept { return block_; }
+
+private:
+    /// @brief Background thread body
+    void run(std::chrono::milliseconds interval);
+
+    HANDLE mapping_ = nullptr;
+    MetricsBlock* block_ = nullptr;
+    std::uint32_t publishes_ = 0;
+    Collector collector_;
+    std::thread thread_;
+    std::mutex mutex_;                  ///< Guards stopping_
+    std::condition_variable wake_;
+    bool stopping_ = false;
+};
+
+} // namespace app_hook::util
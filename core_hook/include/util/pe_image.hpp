@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace app_hook::util {
+
+/// @brief Identity of a PE build, from its file and optional headers
+struct ModuleStamp {
+    std::uint32_t timestamp = 0;   ///< Link time (TimeDateStamp)
+    std::uint32_t checksum = 0;    ///< Header checksum (0 when the linker left it out)
+    std::uint32_t image_size = 0;  ///< SizeOfImage
+
+    [[nodiscard]] bool operator==(const ModuleStamp&) const noexcept = default;
+};
+
+/// @brief Code of a module mapped in this process
+struct ModuleImage {
+    std::uintptr_t base = 0;        ///< Load address
+    ModuleStamp stamp;
+    std::uintptr_t code_begin = 0;  ///< Start of the code section
+    std::size_t code_size = 0;      ///< Mapped size of the code section
+
+    /// @brief Get the code section bytes
+    [[nodiscard]] std::span<const std::uint8_t> code() const noexcept {
+        return {reinterpret_cast<const std::uint8_t*>(code_begin), code_size};
+    }
+};
+
+/// @brief Describe a mapped module from its headers
+/// @param base Module load address (an HMODULE)
+/// @return Module image, or nullopt if the headers are not a PE image with code
+/// @note Uses ".text" when present, otherwise the first executable section
+[[nodiscard]] std::optional<ModuleImage> read_module_image(const void* base) noexcept;
+
+/// @brief Describe the executable of this process
+/// @return Module image of the main module, or nullopt
+[[nodiscard]] std::optional<ModuleImage> main_module_image() noexcept;
+
+} // namespace app_hook::util
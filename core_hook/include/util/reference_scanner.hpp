@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Find every 32-bit value in some bytes that points into an address range
+///
+/// Meant for code sections: any instruction that addresses a static table by
+/// absolute address carries that address as a disp32 or imm32, so every dword
+/// whose value lies in the table's range is a reference to rewrite when the
+/// table moves. Every byte position is tested, four dwords per SSE2 compare
+/// and sixteen positions per step; hits are rare, so they are confirmed with
+/// scalar reads.
+/// @param image Bytes to scan
+/// @param begin First address of the range
+/// @param size Size of the range in bytes
+/// @return Offsets in image of the matching dwords, ascending; a match hides
+///         the three positions after it, which overlap its bytes
+[[nodiscard]] std::vector<std::size_t> find_references(std::span<const std::uint8_t> image,
+                                                       std::uint32_t begin, std::uint32_t size);
+
+/// @brief Address range that moved, and where it moved to
+struct MovedRange {
+    std::uint32_t begin = 0;   ///< First old address
+    std::uint32_t size = 0;    ///< Size of the range in bytes
+    std::uint32_t target = 0;  ///< New address of begin
+};
+
+/// @brief Copy bytes, moving every pointer into a moved range along with it
+///
+/// Meant for data tables: a table whose entries hold absolute pointers into
+/// itself or into sibling tables keeps pointing at the old copies unless each
+/// pointer is moved. The dwords at multiples of four from the start are
+/// tested, sixteen bytes per SSE2 step, and the copy and the rewrite are one
+/// pass over the data. Bytes after the last whole dword are copied as they are.
+/// @param source Bytes to copy
+/// @param destination Buffer of at least source.size() bytes; may be source itself
+/// @param ranges Moved ranges; a value in several of them moves with the first
+/// @return Number of dwords rewritten
+std::size_t copy_rebased(std::span<const std::uint8_t> source, std::uint8_t* destination,
+                         std::span<const MovedRange> ranges);
+
+} // namespace app_hook::util
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "pe_image.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Resolves signature patterns to addresses in one module, with a disk cache
+///
+/// A batch of patterns is resolved with a single SignatureScanner pass over
+/// the module's code; only patterns missing from the cache are scanned. The
+/// cache file records the module's PE timestamp, checksum and image size and
+/// is ignored when any of them differs, so another build of the executable
+/// never reuses addresses found in this one. Position results are cached
+/// relative to the module base; "&" results (values read from the code) are
+/// cached as read. resolve may be called concurrently.
+class SignatureResolver {
+public:
+    /// @brief Name of the cache file inside the config directory
+    static constexpr const char* kFileName = "signatures.cache";
+
+    /// @brief Open the resolver of a module
+    /// @param image Module to scan
+    /// @param cache_path Cache file path (empty for no disk cache)
+    SignatureResolver(ModuleImage image, std::filesystem::path cache_path);
+
+    // Non-copyable and non-movable (owns a mutex)
+    SignatureResolver(const SignatureResolver&) = delete;
+    SignatureResolver& operator=(const SignatureResolver&) = delete;
+    SignatureResolver(SignatureResolver&&) = delete;
+    SignatureResolver& operator=(SignatureResolver&&) = delete;
+
+    /// @brief Resolve patterns to addresses
+    /// @param patterns Pattern strings (see Signature)
+    /// @return One address per pattern; 0 if the pattern is invalid, not found or
+    ///         matches more than once
+    /// @note Writes the cache file when anything had to be scanned
+    [[nodiscard]] std::vector<std::uintptr_t> resolve(std::span<const std::string> patterns);
+
+    /// @brief Get the number of patterns served from the cache
+    [[nodiscard]] std::size_t hits() const noexcept { return hits_; }
+
+    /// @brief Get the number of passes made over the module's code
+    [[nodiscard]] std::size_t scans() const noexcept { return scans_; }
+
+    /// @brief Get the module being resolved against
+    [[nodiscard]] const ModuleImage& image() const noexcept { return image_; }
+
+private:
+    /// @brief Cached result of one pattern
+    struct Entry {
+        std::uint32_t value = 0;
+        bool relative = false;  ///< value is an offset from the module base
+    };
+
+    /// @brief Turn a cached result into an address
+    [[nodiscard]] std::uintptr_t address_of(const Entry& entry) const noexcept {
+        return entry.relative ? image_.base + entry.value : entry.value;
+    }
+
+    /// @brief Read the cache file
+    void read();
+
+    /// @brief Write the cache file (caller holds mutex_)
+    bool save_locked() const;
+
+    ModuleImage image_;
+    std::filesystem::path path_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;  ///< Pattern -> result (guarded by mutex_)
+    std::atomic<std::size_t> hits_{0};
+    std::atomic<std::size_t> scans_{0};
+};
+
+} // namespace app_hook::util
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Byte signature with wildcards, parsed from a pattern string
+///
+/// Patterns are space-separated tokens: hex byte pairs ("8D"), wildcards
+/// ("??" or "?") and at most one marker placed before a byte. "^" makes the
+/// result the address of the byte after it instead of the match start; "&"
+/// makes the result the 32-bit value stored at that byte, for reading a data
+/// address out of an instruction's displacement or immediate:
+///
+///     "E8 ?? ?? ?? ?? ^ 8B 45 08"    address of the mov after the call
+///     "8D 86 & ?? ?? ?? ?? 8B"       disp32 of the lea (a data address)
+struct Signature {
+    std::vector<std::uint8_t> bytes;  ///< Expected bytes, 0 under wildcards
+    std::vector<std::uint8_t> mask;   ///< 0xFF for fixed bytes, 0 for wildcards
+    std::uint32_t result_offset = 0;  ///< Position of the marker in the pattern
+    bool deref = false;               ///< The result is the dword at result_offset
+
+    /// @brief Parse a pattern string
+    /// @param pattern Pattern text
+    /// @return Signature, or nullopt if a token is invalid, no byte is fixed or
+    ///         a "&" marker is not followed by four bytes
+    [[nodiscard]] static std::optional<Signature> parse(std::string_view pattern);
+
+    /// @brief Get the pattern length in bytes
+    [[nodiscard]] std::size_t size() const noexcept { return bytes.size(); }
+
+    /// @brief Check if the signature matches at the start of some bytes
+    [[nodiscard]] bool matches(const std::uint8_t* data) const noexcept {
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            if ((data[i] & mask[i]) != bytes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/// @brief Where a signature matched in a scanned image
+struct SignatureMatch {
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    std::size_t offset = npos;  ///< Offset of the first match in the image
+    std::size_t count = 0;      ///< Number of matches
+
+    /// @brief Check if the signature matched exactly once
+    [[nodiscard]] bool unique() const noexcept { return count == 1; }
+};
+
+/// @brief Finds many signatures in one pass over an image
+///
+/// Each signature is anchored on its rarest pair of adjacent fixed bytes
+/// (a single fixed byte when it has no pair); signatures sharing an anchor are
+/// checked together. The image is walked once in blocks that stay in L1, and
+/// within a block every distinct anchor is searched 16 bytes at a time with
+/// SSE2 compares; only anchor hits are checked against their full signatures.
+class SignatureScanner {
+public:
+    /// @brief Add a signature to look for
+    /// @param signature Signature (must have a fixed byte)
+    /// @return Index of the signature's result in scan()
+    std::size_t add(Signature signature);
+
+    /// @brief Get the number of signatures
+    [[nodiscard]] std::size_t size() const noexcept { return signatures_.size(); }
+
+    /// @brief Get a signature added earlier
+    [[nodiscard]] const Signature& signature(std::size_t index) const noexcept { return signatures_[index]; }
+
+    /// @brief Find every signature in an image
+    /// @param image Bytes to scan
+    /// @return One match per signature, in add() order
+    [[nodiscard]] std::vector<SignatureMatch> scan(std::span<const std::uint8_t> image) const;
+
+private:
+    /// @brief Fixed bytes searched for by one or more signatures
+    struct Anchor {
+        std::uint8_t first;
+        std::uint8_t second;
+        bool pair;                         ///< second is fixed too
+        std::vector<std::size_t> members;  ///< Signatures anchored here
+    };
+
+    /// @brief Get the anchors to search, grouping signatures by anchor bytes
+    [[nodiscard]] std::vector<Anchor> anchors() const;
+
+    std::vector<Signature> signatures_;
+    std::vector<std::size_t> anchor_offsets_;  ///< Anchor position in each signature
+};
+
+} // namespace app_hook::util
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief One completed span of the startup timeline
+struct TraceEvent {
+    std::string name;          ///< What ran, e.g. "load_plugin"
+    std::string category;      ///< Phase group, e.g. "plugins" or "hooks"
+    std::string detail;        ///< Plugin path, config file, hook address... (may be empty)
+    std::int64_t start_us;     ///< Start, in microseconds since the trace origin
+    std::int64_t duration_us;  ///< Duration in microseconds (0 for an instant marker)
+    std::uint32_t thread_id;   ///< Thread the span ran on
+    bool instant = false;      ///< Marker without duration
+};
+
+/// @brief Timeline of the injection-to-hooks-active critical path
+///
+/// Spans are recorded by TraceScope from any thread (configs are parsed on a
+/// worker pool) and written once as a Chrome trace, which chrome://tracing,
+/// Perfetto and Edge's about:tracing open directly. The origin is the moment the
+/// DLL was attached, so span start times read as time since injection.
+class StartupTrace {
+public:
+    /// @brief Get the trace of the host process
+    [[nodiscard]] static StartupTrace& instance();
+
+    /// @brief Restart the timeline from now and drop recorded spans
+    void reset();
+
+    /// @brief Enable or disable recording (enabled by default)
+    void set_enabled(bool enabled);
+
+    /// @brief Check if spans are recorded
+    [[nodiscard]] bool enabled() const;
+
+    /// @brief Get the time elapsed since the origin
+    [[nodiscard]] std::int64_t now_us() const;
+
+    /// @brief Record a completed span
+    /// @param event Span to add
+    void record(TraceEvent event);
+
+    /// @brief Record an instant marker at the current time
+    /// @param name Marker name
+    /// @param category Phase group
+    /// @param detail Optional detail
+    void mark(std::string name, std::string category, std::string detail = {});
+
+    /// @brief Get a copy of the recorded spans, in recording order
+    [[nodiscard]] std::vector<TraceEvent> events() const;
+
+    /// @brief Write the spans as a Chrome trace JSON file
+    /// @param path Output file (its directory must exist)
+    /// @return false if the file could not be written
+    bool write_chrome_trace(const std::string& path) const;
+
+    /// @brief Render the spans as a Chrome trace JSON document
+    [[nodiscard]] std::string to_chrome_trace() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    mutable std::mutex mutex_;  ///< Guards every member
+    Clock::time_point origin_ = Clock::now();
+    std::vector<TraceEvent> events_;
+    bool enabled_ = true;
+};
+
+/// @brief Records the lifetime of a scope as a StartupTrace span
+/// @note Startup code only: the names are copied, so keep it off per-call paths
+class TraceScope {
+public:
+    /// @brief Start a span
+    /// @param name What runs in the scope
+    /// @param category Phase group
+    /// @param detail Optional detail shown in the span's arguments
+    TraceScope(std::string name, std::string category, std::string detail = {});
+
+    /// @brief End the span and record it
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+    TraceScope(TraceScope&&) = delete;
+    TraceScope& operator=(TraceScope&&) = delete;
+
+private:
+    std::string name_;
+    std::string category_;
+    std::string detail_;
+    std::int64_t start_us_;
+};
+
+} // namespace app_hook::util
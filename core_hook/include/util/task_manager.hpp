@@ -2,6 +2,7 @@
 
 #include "../task/hook_task.hpp"
 #include "../config/config_loader.hpp"
+#include "dag_executor.hpp"
 #include <vector>
 #include <string>
 #include <expected>
@@ -11,6 +12,8 @@
 namespace app_hook::util {
 
 /// @brief Manager for hook tasks
+/// @note Tasks run in parallel on a DagExecutor; declared dependencies order them,
+///       and the followers of a failed task are skipped
 class TaskManager {
 public:
     TaskManager() = default;
@@ -36,14 +39,31 @@ public:
     /// @param task Task to add
     void add_task(task::HookTaskPtr task);
     
+    /// @brief Make a task wait for another
+    /// @param parent Index of the task that must succeed first (in add order)
+    /// @param follower Index of the task that runs after it
+    void add_dependency(std::size_t parent, std::size_t follower);
+    
+    /// @brief Take the followBy edges of a task graph as dependencies
+    /// @param graph Graph whose task IDs match the order the tasks were added in
+    void add_dependencies(const config::TaskGraph& graph);
+    
+    /// @brief Set the threads used to run the tasks
+    /// @param thread_count Threads, the calling thread included (0 picks the core count, 1 runs inline)
+    void set_thread_count(std::size_t thread_count) noexcept { thread_count_ = thread_count; }
+    
     /// @brief Execute all tasks
     /// @return true if all tasks succeeded
     [[nodiscard]] bool execute_all();
     
     /// @brief Execute all tasks and return detailed results
-    /// @return Vector of task results with names
+    /// @return Vector of task results with names, in add order
     [[nodiscard]] std::vector<std::pair<std::string, task::TaskResult>> execute_all_detailed();
     
+    /// @brief Execute all tasks and report the timing of each
+    /// @return One run per task, in add order; skipped tasks carry dependency_not_met
+    [[nodiscard]] std::vector<DagRun> execute_all_timed();
+    
     /// @brief Get the number of tasks
     /// @return Number of tasks
     [[nodiscard]] std::size_t task_count() const noexcept {
@@ -65,6 +85,8 @@ public:
     
 private:
     std::vector<task::HookTaskPtr> tasks_;
+    std::vector<std::pair<std::size_t, std::size_t>> dependencies_;  ///< (parent, follower) indices
+    std::size_t thread_count_ = 0;
 };
 
 } // namespace app_hook::util 
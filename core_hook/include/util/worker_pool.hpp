@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace app_hook::util {
+
+/// @brief Fixed set of background threads running jobs off the game thread
+///
+/// Every worker owns a FIFO queue. A job is submitted with an affinity key and
+/// always lands on the same worker for that key, so jobs sharing a key (for
+/// example the async tasks of one hook) run one after the other in submission
+/// order while different keys run in parallel. Threads start on first submit.
+class WorkerPool {
+public:
+    /// @brief Work item run by a worker
+    using Job = std::function<void()>;
+
+    /// @brief Constructor
+    /// @param thread_count Number of workers (0 picks a small default from the core count)
+    explicit WorkerPool(std::size_t thread_count = 0);
+
+    /// @brief Runs pending jobs and stops the workers
+    ~WorkerPool();
+
+    // Non-copyable, non-movable
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    WorkerPool(WorkerPool&&) = delete;
+    WorkerPool& operator=(WorkerPool&&) = delete;
+
+    /// @brief Queue a job
+    /// @param affinity Key selecting the worker; equal keys run in submission order
+    /// @param job Job to run
+    /// @return false if the pool is stopped (the job is not run)
+    bool submit(std::size_t affinity, Job job);
+
+    /// @brief Block until every submitted job has finished
+    void wait_idle();
+    
+    /// @brief Run body(i) for every i in [0, count) across the workers and wait for them
+    /// @param count Number of indices
+    /// @param body Work for one index; indices run concurrently, in no particular order
+    /// @note Runs inline when the pool is stopped. Only waits for its own jobs,
+    ///       so other submitted work may still be pending on return.
+    void for_each_index(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    /// @brief Run the remaining jobs and stop the workers
+    /// @note Joins the workers (see join_background_thread)
+    void stop();
+
+    /// @brief Get the number of workers
+    /// @return Worker count
+    [[nodiscard]] std::size_t thread_count() const noexcept { return workers_.size(); }
+
+    /// @brief Get the number of jobs queued or running
+    /// @return Pending job count
+    [[nodiscard]] std::size_t pending() const noexcept { return pending_.load(std::memory_order_acquire); }
+
+private:
+    /// @brief One worker thread with its queue
+    struct Worker {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<Job> jobs;
+        std::thread thread;
+    };
+
+    /// @brief Start the worker threads once
+    void start();
+
+    /// @brief Worker thread body
+    void run(Worker& worker);
+
+    /// @brief Mark one job as finished
+    void complete_one() noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::once_flag started_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::size_t> pending_{0};
+};
+
+} // namespace app_hook::util
@@ -0,0 +1,127 @@
+#include "../../include/config/address_map.hpp"
+#include "../../include/util/logger.hpp"
+#include <toml++/toml.h>
+#include <algorithm>
+#include <vector>
+
+namespace app_hook::config {
+
+namespace {
+
+/// @brief Read a number written as a hex string or an integer
+std::optional<std::uint64_t> read_number(const toml::node* node) {
+    if (!node) {
+        return std::nullopt;
+    }
+    if (const auto number = node->value<std::int64_t>(); number && *number >= 0) {
+        return static_cast<std::uint64_t>(*number);
+    }
+    if (const auto text = node->value<std::string>()) {
+        try {
+            return ConfigParsingUtils::parse_address(*text);
+        } catch (const std::exception&) {
+        }
+    }
+    return std::nullopt;
+}
+
+/// @brief Get the map files of a directory, sorted by name
+std::vector<std::filesystem::path> map_files(const std::filesystem::path& directory) {
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        if (entry.is_regular_file(ec) && entry.path().extension() == ".toml") {
+            files.push_back(entry.path());
+        }
+    }
+    std::ranges::sort(files);
+    return files;
+}
+
+} // namespace
+
+ConfigResult<AddressMap> AddressMap::read(const std::filesystem::path& path) {
+    toml::table root;
+    try {
+        root = toml::parse_file(path.string());
+    } catch (const toml::parse_error& e) {
+        LOG_ERROR("Cannot parse address map {}: {}", path.string(), e.description());
+        std::error_code ec;
+        return std::unexpected(std::filesystem::exists(path, ec) ? ConfigError::parse_error
+                                                                 : ConfigError::file_not_found);
+    }
+
+    const auto* build = root["build"].as_table();
+    const auto timestamp = build ? read_number(build->get("timestamp")) : std::nullopt;
+    if (!timestamp) {
+        LOG_ERROR("Address map {} has no [build] timestamp", path.string());
+        return std::unexpected(ConfigError::missing_required_field);
+    }
+
+    AddressMap map;
+    const auto* display_name = build->get_as<std::string>("name");
+    map.build_ = display_name ? display_name->get() : path.stem().string();
+    map.timestamp_ = static_cast<std::uint32_t>(*timestamp);
+    if (build->contains("checksum")) {
+        map.checksum_ = read_number(build->get("checksum"));
+        if (!map.checksum_) {
+            LOG_ERROR("Address map {} has an invalid checksum", path.string());
+            return std::unexpected(ConfigError::invalid_format);
+        }
+    }
+    if (build->contains("imageSize")) {
+        map.image_size_ = read_number(build->get("imageSize"));
+        if (!map.image_size_) {
+            LOG_ERROR("Address map {} has an invalid imageSize", path.string());
+            return std::unexpected(ConfigError::invalid_format);
+        }
+    }
+
+    if (const auto* symbols = root["symbols"].as_table()) {
+        map.symbols_.reserve(symbols->size());
+        for (const auto& [name, value] : *symbols) {
+            const auto address = read_number(&value);
+            if (!address || *address == 0) {
+                LOG_ERROR("Address map {} has an invalid address for '{}'", path.string(), name.str());
+                return std::unexpected(ConfigError::invalid_format);
+            }
+            map.symbols_.emplace(name.str(), static_cast<std::uintptr_t>(*address));
+        }
+    }
+    return map;
+}
+
+std::optional<AddressMap> AddressMap::select(const std::filesystem::path& directory, const util::ModuleStamp& stamp) {
+    for (const auto& path : map_files(directory)) {
+        auto map = read(path);
+        if (map && map->matches(stamp)) {
+            return std::move(*map);
+        }
+    }
+    return std::nullopt;
+}
+
+std::uint64_t AddressMap::fingerprint(const std::filesystem::path& directory) {
+    // FNV-1a over each file's name, size and write time
+    std::uint64_t hash = 0;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        for (const auto* byte = static_cast<const std::uint8_t*>(data); size != 0; --size, ++byte) {
+            hash = (hash ^ *byte) * 0x100000001B3ull;
+        }
+    };
+    for (const auto& path : map_files(directory)) {
+        if (hash == 0) {
+            hash = 0xCBF29CE484222325ull;
+        }
+        std::error_code ec;
+        const auto name = path.filename().string();
+        const auto size = std::filesystem::file_size(path, ec);
+        const auto time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+        mix(name.data(), name.size());
+        mix(&size, sizeof(size));
+        mix(&time, sizeof(time));
+    }
+    return hash;
+}
+
+} // namespace app_hook::config
@@ -0,0 +1,368 @@
+#include "../../include/config/config_cache.hpp"
+#include "../../include/config/config_factory.hpp"
+#include "../../include/config/address_map.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace app_hook::config {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x43434841;  // "AHCC"
+constexpr std::uint32_t kFormatVersion = 4;
+
+// Pseudo-loader recording tasks.toml
+constexpr const char* kTasksLoader = "tasks";
+constexpr std::uint32_t kTasksVersion = 1;
+
+} // namespace
+
+ConfigCache::ConfigCache(const std::filesystem::path& config_dir)
+    : path_(config_dir / kFileName) {
+    if (const auto image = util::main_module_image()) {
+        module_stamp_ = image->stamp;
+    }
+    address_maps_ = AddressMap::fingerprint(config_dir / AddressMap::kDirectory);
+    read();
+}
+
+ConfigResult<std::vector<TaskInfo>> ConfigCache::load_tasks(const std::string& tasks_file_path) {
+    if (const auto* entry = bundle_ ? bundle_->find_file(BundleEntryKind::tasks, tasks_file_path) : nullptr) {
+        util::ByteReader in(entry->data);
+        if (auto tasks = entry->version == kTasksVersion ? read_tasks(in) : std::nullopt) {
+            ++hits_;
+            return std::move(*tasks);
+        }
+        LOG_WARNING("Mod bundle entry for {} is corrupt - reading the file", tasks_file_path);
+    }
+
+    std::optional<FileFingerprint> current;
+    if (auto payload = lookup(tasks_file_path, kTasksLoader, kTasksVersion, {}, current)) {
+        util::ByteReader in(*payload);
+        if (auto tasks = read_tasks(in)) {
+            ++hits_;
+            LOG_INFO("Loaded {} task(s) from config cache for: {}", tasks->size(), tasks_file_path);
+            return std::move(*tasks);
+        }
+        LOG_WARNING("Config cache entry for {} is corrupt - reparsing", tasks_file_path);
+    }
+
+    ++misses_;
+    auto tasks = TaskLoader::load_tasks(tasks_file_path);
+    if (tasks && current) {
+        util::ByteWriter out;
+        write_tasks(out, *tasks);
+        store(tasks_file_path, *current, kTasksLoader, kTasksVersion, {}, out.release());
+    }
+    return tasks;
+}
+
+ConfigResult<std::vector<ConfigPtr>>
+ConfigCache::load_configs(ConfigType type, const std::string& config_file, const std::string& task_name) {
+    auto* loader = ConfigFactory::get_loader(type);
+    const auto version = loader ? loader->cache_version() : 0;
+    if (version == 0) {
+        return ConfigFactory::load_configs(type, config_file, task_name);
+    }
+
+    const auto loader_name = loader->get_name();
+    if (const auto* entry = bundle_ ? bundle_->find_file(BundleEntryKind::configs, config_file) : nullptr) {
+        if (entry->loader == loader_name && entry->version == version && entry->task == task_name) {
+            util::ByteReader in(entry->data);
+            if (auto configs = loader->deserialize_configs(type, in, task_name); configs && in.ok()) {
+                ++hits_;
+                LOG_DEBUG("Loaded {} config(s) from mod bundle for: {}", configs->size(), config_file);
+                return configs;
+            }
+        }
+        LOG_WARNING("Mod bundle entry for {} does not match loader '{}' v{} - reading the file",
+                    config_file, loader_name, version);
+    }
+
+    std::optional<FileFingerprint> current;
+    if (auto payload = lookup(config_file, loader_name, version, task_name, current)) {
+        util::ByteReader in(*payload);
+        if (auto configs = loader->deserialize_configs(type, in, task_name); configs && in.ok()) {
+            ++hits_;
+            LOG_DEBUG("Loaded {} config(s) from config cache for: {}", configs->size(), config_file);
+            return configs;
+        }
+        LOG_WARNING("Config cache entry for {} could not be read by '{}' - reparsing", config_file, loader_name);
+    }
+
+    ++misses_;
+    auto configs = ConfigFactory::load_configs(type, config_file, task_name);
+    if (configs && current) {
+        util::ByteWriter out;
+        if (loader->serialize_configs(*configs, out)) {
+            store(config_file, *current, loader_name, version, task_name, out.release());
+        }
+    }
+    return configs;
+}
+
+bool ConfigCache::save() {
+    std::lock_guard lock(mutex_);
+    const bool pruned = std::erase_if(entries_, [](const auto& item) { return !item.second.used; }) > 0;
+    if (!dirty_ && !pruned) {
+        return true;
+    }
+
+    util::ByteWriter out;
+    out.write(kMagic);
+    out.write(kFormatVersion);
+    out.write(module_stamp_);
+    out.write(address_maps_);
+    out.write(static_cast<std::uint32_t>(entries_.size()));
+    for (const auto& [file_path, entry] : entries_) {
+        out.write_string(file_path);
+        out.write(entry.fingerprint);
+        out.write_string(entry.loader);
+        out.write(entry.version);
+        out.write_string(entry.task);
+        out.write_bytes(*entry.payload);
+    }
+
+    // Write next to the cache and swap, so a crash never leaves a torn file
+    auto temp_path = path_;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            LOG_WARNING("Cannot write config cache: {}", temp_path.string());
+            return false;
+        }
+        const auto data = out.data();
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            LOG_WARNING("Failed to write config cache: {}", temp_path.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_, ec);
+    if (ec) {
+        LOG_WARNING("Failed to replace config cache {}: {}", path_.string(), ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+
+    dirty_ = false;
+    LOG_INFO("Saved config cache with {} entry(ies): {}", entries_.size(), path_.string());
+    return true;
+}
+
+bool ConfigCache::write_bundle(std::span<const std::string> blobs) const {
+    const auto config_dir = path_.parent_path();
+    BundleWriter writer;
+    {
+        std::lock_guard lock(mutex_);
+        for (const auto& [file_path, entry] : entries_) {
+            const auto kind = entry.loader == kTasksLoader ? BundleEntryKind::tasks : BundleEntryKind::configs;
+            writer.add(kind, ModBundle::config_key(config_dir, file_path), *entry.payload,
+                       kind == BundleEntryKind::tasks ? std::string{} : entry.loader, entry.version, entry.task);
+        }
+    }
+
+    for (const auto& blob : blobs) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(blob, ec);
+        std::vector<std::uint8_t> data(ec ? 0 : static_cast<std::size_t>(size));
+        std::ifstream file(blob, std::ios::binary);
+        if (ec || !file || !file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            LOG_WARNING("Cannot read binary for the mod bundle - it stays a loose file: {}", blob);
+            continue;
+        }
+        writer.add(BundleEntryKind::blob, ModBundle::blob_key(blob), std::move(data));
+    }
+    return writer.write(config_dir / ModBundle::kFileName, module_stamp_);
+}
+
+ConfigCache::Payload ConfigCache::lookup(const std::string& file_path, const std::string& loader,
+                                         std::uint32_t version, const std::string& task,
+                                         std::optional<FileFingerprint>& current) {
+    current = stat_file(file_path);
+    if (!current) {
+        return nullptr;
+    }
+
+    // Keys of plugin configs embed the task name, so a renamed task is reparsed
+    const auto same_loader = [&](const Entry& entry) {
+        return entry.loader == loader && entry.version == version && entry.task == task;
+    };
+
+    bool known = false;
+    {
+        std::lock_guard lock(mutex_);
+        auto it = entries_.find(file_path);
+        if (it != entries_.end() && same_loader(it->second)) {
+            if (it->second.fingerprint.mtime == current->mtime && it->second.fingerprint.size == current->size) {
+                current->hash = it->second.fingerprint.hash;
+                it->second.used = true;
+                return it->second.payload;
+            }
+            known = it->second.fingerprint.size == current->size;
+        }
+    }
+
+    // Hash only when the cheap check fails: a touched but unchanged file stays cached
+    auto hash = hash_file(file_path);
+    if (!hash) {
+        current.reset();
+        return nullptr;
+    }
+    current->hash = *hash;
+    if (!known) {
+        return nullptr;
+    }
+
+    std::lock_guard lock(mutex_);
+    auto it = entries_.find(file_path);
+    if (it != entries_.end() && same_loader(it->second) && it->second.fingerprint.size == current->size &&
+        it->second.fingerprint.hash == current->hash) {
+        it->second.fingerprint = *current;
+        it->second.used = true;
+        dirty_ = true;
+        return it->second.payload;
+    }
+    return nullptr;
+}
+
+void ConfigCache::store(const std::string& file_path, const FileFingerprint& fingerprint, std::string loader,
+                        std::uint32_t version, std::string task, std::vector<std::uint8_t> payload) {
+    auto shared = std::make_shared<const std::vector<std::uint8_t>>(std::move(payload));
+    std::lock_guard lock(mutex_);
+    entries_[file_path] = Entry{fingerprint, std::move(loader), version, std::move(task), std::move(shared), true};
+    dirty_ = true;
+}
+
+void ConfigCache::read() {
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(path_, ec);
+    if (ec || file_size == 0) {
+        return;
+    }
+
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(file_size));
+    {
+        std::ifstream file(path_, std::ios::binary);
+        if (!file || !file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            LOG_WARNING("Cannot read config cache: {}", path_.string());
+            return;
+        }
+    }
+
+    util::ByteReader in(data);
+    std::uint32_t magic = 0;
+    std::uint32_t format = 0;
+    util::ModuleStamp stamp;
+    std::uint64_t address_maps = 0;
+    std::uint32_t count = 0;
+    if (!in.read(magic) || !in.read(format) || magic != kMagic || format != kFormatVersion) {
+        LOG_INFO("Ignoring config cache with unknown format: {}", path_.string());
+        return;
+    }
+    if (!in.read(stamp) || !in.read(address_maps) || !in.read(count) || !(stamp == module_stamp_)) {
+        LOG_INFO("Config cache was built for another executable - reparsing: {}", path_.string());
+        return;
+    }
+    if (address_maps != address_maps_) {
+        LOG_INFO("Address maps changed since the config cache was written - reparsing: {}", path_.string());
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string file_path;
+        Entry entry;
+        std::vector<std::uint8_t> payload;
+        if (!in.read_string(file_path) || !in.read(entry.fingerprint) || !in.read_string(entry.loader) ||
+            !in.read(entry.version) || !in.read_string(entry.task) || !in.read_bytes(payload)) {
+            LOG_WARNING("Config cache is truncated - ignoring it: {}", path_.string());
+            entries_.clear();
+            return;
+        }
+        entry.payload = std::make_shared<const std::vector<std::uint8_t>>(std::move(payload));
+        entries_.emplace(std::move(file_path), std::move(entry));
+    }
+    LOG_DEBUG("Opened config cache with {} entry(ies): {}", entries_.size(), path_.string());
+}
+
+std::optional<FileFingerprint> ConfigCache::stat_file(const std::string& file_path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(file_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    const auto mtime = std::filesystem::last_write_time(file_path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+
+    FileFingerprint fingerprint;
+    fingerprint.mtime = static_cast<std::int64_t>(mtime.time_since_epoch().count());
+    fingerprint.size = static_cast<std::uint64_t>(size);
+    return fingerprint;
+}
+
+std::optional<std::uint64_t> ConfigCache::hash_file(const std::string& file_path) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> contents{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    return util::fnv1a_64(contents);
+}
+
+void ConfigCache::write_tasks(util::ByteWriter& out, const std::vector<TaskInfo>& tasks) {
+    out.write(static_cast<std::uint32_t>(tasks.size()));
+    for (const auto& task : tasks) {
+        out.write_string(task.name);
+        out.write_string(task.description);
+        out.write_string(task.config_file);
+        out.write(task.type);
+        out.write(static_cast<std::uint32_t>(task.follow_by.size()));
+        for (const auto& follow : task.follow_by) {
+            out.write_string(follow);
+        }
+        out.write(task.enabled);
+        out.write(task.policy);
+        out.write(task.every_n);
+        out.write(task.execution);
+    }
+}
+
+std::optional<std::vector<TaskInfo>> ConfigCache::read_tasks(util::ByteReader& in) {
+    std::uint32_t count = 0;
+    if (!in.read(count)) {
+        return std::nullopt;
+    }
+
+    std::vector<TaskInfo> tasks;
+    tasks.reserve(std::min<std::size_t>(count, in.remaining()));
+    for (std::uint32_t i = 0; i < count; ++i) {
+        TaskInfo task;
+        std::uint32_t follow_count = 0;
+        in.read_string(task.name);
+        in.read_string(task.description);
+        in.read_string(task.config_file);
+        in.read(task.type);
+        in.read(follow_count);
+        for (std::uint32_t j = 0; j < follow_count && in.ok(); ++j) {
+            in.read_string(task.follow_by.emplace_back());
+        }
+        in.read(task.enabled);
+        in.read(task.policy);
+        in.read(task.every_n);
+        in.read(task.execution);
+        if (!in.ok()) {
+            return std::nullopt;
+        }
+        tasks.push_back(std::move(task));
+    }
+    return tasks;
+}
+
+} // namespace app_hook::config
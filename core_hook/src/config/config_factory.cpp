@@ -1,9 +1,12 @@
 #include "../../include/config/config_factory.hpp"
+#include <algorithm>
 
 namespace app_hook::config {
 
 // Static member definition
 std::unordered_map<std::string, ConfigLoaderPtr> ConfigFactory::loaders_;
+std::array<ConfigLoaderBase*, kConfigTypeCount> ConfigFactory::loaders_by_type_{};
+std::shared_mutex ConfigFactory::mutex_;
 
 bool ConfigFactory::register_loader(ConfigLoaderPtr loader) {
     if (!loader) {
@@ -12,23 +15,22 @@ bool ConfigFactory::register_loader(ConfigLoaderPtr loader) {
     }
 
     const auto& name = loader->get_name();
-    if (loaders_.find(name) != loaders_.end()) {
+    std::unique_lock lock(mutex_);
+    if (auto existing = loaders_.find(name); existing != loaders_.end()) {
         LOG_WARNING("Loader '{}' is already registered - replacing", name);
+        std::ranges::replace(loaders_by_type_, existing->second.get(), nullptr);
     }
 
     LOG_INFO("Registering config loader: {} v{}", name, loader->get_version());
-    
-    // Log supported types
-    auto supported = loader->supported_types();
-    for (const auto& type : supported) {
-        LOG_DEBUG("  - Supports: {}", to_string(type));
-    }
 
+    // The newest loader for a type handles it
+    index_loader(loader.get(), true);
     loaders_[name] = std::move(loader);
     return true;
 }
 
 bool ConfigFactory::unregister_loader(const std::string& loader_name) {
+    std::unique_lock lock(mutex_);
     auto it = loaders_.find(loader_name);
     if (it == loaders_.end()) {
         LOG_WARNING("Loader '{}' not found for unregistration", loader_name);
@@ -36,7 +38,16 @@ bool ConfigFactory::unregister_loader(const std::string& loader_name) {
     }
 
     LOG_INFO("Unregistering config loader: {}", loader_name);
+    const auto* removed = it->second.get();
     loaders_.erase(it);
+
+    // Hand the freed types back to any other loader claiming them
+    if (std::ranges::find(loaders_by_type_, removed) != loaders_by_type_.end()) {
+        std::ranges::replace(loaders_by_type_, removed, nullptr);
+        for (const auto& [name, loader] : loaders_) {
+            index_loader(loader.get(), false);
+        }
+    }
     return true;
 }
 
@@ -45,6 +56,8 @@ ConfigFactory::load_configs(ConfigType type, const std::string& config_file, con
     LOG_INFO("Loading {} configs from file: {} for task: {}", 
              to_string(type), config_file, task_name);
 
+    // Shared: loads of different files run concurrently
+    std::shared_lock lock(mutex_);
     auto* loader = find_loader_for_type(type);
     if (!loader) {
         LOG_ERROR("No registered loader supports configuration type: {}", to_string(type));
@@ -56,6 +69,7 @@ ConfigFactory::load_configs(ConfigType type, const std::string& config_file, con
 }
 
 std::vector<std::string> ConfigFactory::get_registered_loaders() {
+    std::shared_lock lock(mutex_);
     std::vector<std::string> names;
     names.reserve(loaders_.size());
     
@@ -67,17 +81,40 @@ std::vector<std::string> ConfigFactory::get_registered_loaders() {
 }
 
 bool ConfigFactory::is_type_supported(ConfigType type) {
+    std::shared_lock lock(mutex_);
     return find_loader_for_type(type) != nullptr;
 }
 
-ConfigLoaderBase* ConfigFactory::find_loader_for_type(ConfigType type) {
-    for (const auto& [name, loader] : loaders_) {
-        const auto supported = loader->supported_types();
-        if (std::find(supported.begin(), supported.end(), type) != supported.end()) {
-            return loader.get();
+ConfigLoaderBase* ConfigFactory::get_loader(ConfigType type) {
+    std::shared_lock lock(mutex_);
+    return find_loader_for_type(type);
+}
+
+ConfigLoaderBase* ConfigFactory::find_loader_for_type(ConfigType type) noexcept {
+    const auto index = to_index(type);
+    return index < loaders_by_type_.size() ? loaders_by_type_[index] : nullptr;
+}
+
+void ConfigFactory::index_loader(ConfigLoaderBase* loader, bool replace) {
+    for (const auto type : loader->supported_types()) {
+        const auto index = to_index(type);
+        if (index >= loaders_by_type_.size()) {
+            LOG_WARNING("Loader '{}' claims unknown config type {} - ignoring it", 
+                        loader->get_name(), static_cast<int>(type));
+            continue;
         }
+
+        auto& slot = loaders_by_type_[index];
+        if (slot && slot != loader && !replace) {
+            continue;
+        }
+        if (slot && slot != loader) {
+            LOG_WARNING("Loader '{}' takes over config type '{}' from '{}'", 
+                        loader->get_name(), to_string(type), slot->get_name());
+        }
+        slot = loader;
+        LOG_DEBUG("  - Supports: {}", to_string(type));
     }
-    return nullptr;
 }
 
 } // namespace app_hook::config 
@@ -0,0 +1,206 @@
+#include "../../include/config/mod_bundle.hpp"
+#include "../../include/util/byte_stream.hpp"
+#include <windows.h>
+#include <algorithm>
+#include <fstream>
+#include <system_error>
+
+namespace app_hook::config {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x424D4841;  // "AHMB"
+constexpr std::uint32_t kFormatVersion = 1;
+
+/// @brief Size of the fixed header: magic, version, stamp, entry count, toc size
+constexpr std::size_t kHeaderSize = 2 * sizeof(std::uint32_t) + sizeof(util::ModuleStamp) + 2 * sizeof(std::uint32_t);
+
+/// @brief Key of the lookup index: kinds share the key space of their paths
+std::string index_key(BundleEntryKind kind, std::string_view key) {
+    std::string indexed;
+    indexed.reserve(key.size() + 1);
+    indexed.push_back(static_cast<char>(kind));
+    indexed.append(key);
+    return indexed;
+}
+
+constexpr std::size_t align_up(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+ConfigResult<std::shared_ptr<const ModBundle>> ModBundle::open(const std::filesystem::path& config_dir) {
+    const auto path = config_dir / kFileName;
+    std::shared_ptr<ModBundle> bundle(new ModBundle());
+    bundle->config_dir_ = config_dir;
+
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return std::unexpected(ConfigError::file_not_found);
+    }
+    bundle->file_ = file;
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(kHeaderSize) ||
+        static_cast<unsigned long long>(file_size.QuadPart) > SIZE_MAX) {
+        LOG_WARNING("Ignoring mod bundle with an invalid size: {}", path.string());
+        return std::unexpected(ConfigError::invalid_format);
+    }
+    bundle->size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+    bundle->mapping_ = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (bundle->mapping_) {
+        bundle->view_ = static_cast<const std::uint8_t*>(MapViewOfFile(bundle->mapping_, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!bundle->view_) {
+        LOG_WARNING("Cannot map mod bundle: {} (error {})", path.string(), GetLastError());
+        return std::unexpected(ConfigError::invalid_format);
+    }
+
+    if (!bundle->index()) {
+        LOG_WARNING("Ignoring corrupt mod bundle: {}", path.string());
+        return std::unexpected(ConfigError::invalid_format);
+    }
+
+    // Payloads hold addresses resolved against one build of the executable
+    if (const auto image = util::main_module_image(); image && !(bundle->stamp_ == image->stamp)) {
+        LOG_WARNING("Mod bundle was packed for another build of the executable - ignoring it: {}", path.string());
+        return std::unexpected(ConfigError::invalid_format);
+    }
+
+    LOG_INFO("Mapped mod bundle with {} entry(ies), {} bytes: {}", bundle->entries_.size(), bundle->size_, path.string());
+    return std::shared_ptr<const ModBundle>(std::move(bundle));
+}
+
+ModBundle::~ModBundle() {
+    if (view_) {
+        UnmapViewOfFile(view_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+    if (file_) {
+        CloseHandle(file_);
+    }
+}
+
+bool ModBundle::index() {
+    util::ByteReader header({view_, kHeaderSize});
+    std::uint32_t magic = 0;
+    std::uint32_t format = 0;
+    std::uint32_t count = 0;
+    std::uint32_t toc_size = 0;
+    if (!header.read(magic) || !header.read(format) || !header.read(stamp_) || !header.read(count) ||
+        !header.read(toc_size) || magic != kMagic || format != kFormatVersion || toc_size > size_ - kHeaderSize) {
+        return false;
+    }
+
+    util::ByteReader toc({view_ + kHeaderSize, toc_size});
+    entries_.reserve(count);
+    index_.reserve(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        BundleEntry entry;
+        std::uint8_t kind = 0;
+        std::uint64_t offset = 0;
+        std::uint64_t length = 0;
+        if (!toc.read(kind) || !toc.read_string(entry.key) || !toc.read_string(entry.loader) ||
+            !toc.read(entry.version) || !toc.read_string(entry.task) || !toc.read(offset) || !toc.read(length)) {
+            return false;
+        }
+        if (offset > size_ || length > size_ - offset) {
+            return false;
+        }
+        entry.kind = static_cast<BundleEntryKind>(kind);
+        entry.data = {view_ + offset, static_cast<std::size_t>(length)};
+        index_.insert_or_assign(index_key(entry.kind, entry.key), entries_.size());
+        entries_.push_back(std::move(entry));
+    }
+    return true;
+}
+
+const BundleEntry* ModBundle::find(BundleEntryKind kind, std::string_view key) const {
+    const auto it = index_.find(index_key(kind, key));
+    return it != index_.end() ? &entries_[it->second] : nullptr;
+}
+
+std::string ModBundle::config_key(const std::filesystem::path& config_dir, const std::filesystem::path& file) {
+    auto relative = file.lexically_normal().lexically_relative(config_dir.lexically_normal());
+    if (relative.empty()) {
+        relative = file.lexically_normal();
+    }
+    return relative.generic_string();
+}
+
+std::string ModBundle::blob_key(const std::filesystem::path& path) {
+    return path.lexically_normal().generic_string();
+}
+
+void BundleWriter::add(BundleEntryKind kind, std::string key, std::vector<std::uint8_t> data,
+                       std::string loader, std::uint32_t version, std::string task) {
+    entries_.push_back({kind, std::move(key), std::move(loader), version, std::move(task), std::move(data)});
+}
+
+bool BundleWriter::write(const std::filesystem::path& path, const util::ModuleStamp& stamp) const {
+    // The table of contents is sized first: it holds the offsets of the data after it
+    auto write_toc = [this](util::ByteWriter& toc, const std::vector<std::uint64_t>& offsets) {
+        for (std::size_t i = 0; i < entries_.size(); ++i) {
+            const auto& entry = entries_[i];
+            toc.write(static_cast<std::uint8_t>(entry.kind));
+            toc.write_string(entry.key);
+            toc.write_string(entry.loader);
+            toc.write(entry.version);
+            toc.write_string(entry.task);
+            toc.write(offsets[i]);
+            toc.write(static_cast<std::uint64_t>(entry.data.size()));
+        }
+    };
+    std::vector<std::uint64_t> offsets(entries_.size(), 0);
+    util::ByteWriter sizing;
+    write_toc(sizing, offsets);
+
+    std::size_t end = kHeaderSize + sizing.size();
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        const auto alignment = entries_[i].kind == BundleEntryKind::blob ? ModBundle::kBlobAlignment
+                                                                          : ModBundle::kPayloadAlignment;
+        offsets[i] = align_up(end, alignment);
+        end = static_cast<std::size_t>(offsets[i]) + entries_[i].data.size();
+    }
+
+    util::ByteWriter out;
+    out.write(kMagic);
+    out.write(kFormatVersion);
+    out.write(stamp);
+    out.write(static_cast<std::uint32_t>(entries_.size()));
+    out.write(static_cast<std::uint32_t>(sizing.size()));
+    write_toc(out, offsets);
+    auto bytes = out.release();
+    bytes.resize(end, 0);
+    for (std::size_t i = 0; i < entries_.size(); ++i) {
+        std::copy(entries_[i].data.begin(), entries_[i].data.end(), bytes.begin() + static_cast<std::ptrdiff_t>(offsets[i]));
+    }
+
+    // Write next to the bundle and swap, so a crash never leaves a torn file
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()))) {
+            LOG_WARNING("Cannot write mod bundle: {}", temp_path.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        LOG_WARNING("Failed to replace mod bundle {}: {}", path.string(), ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    LOG_INFO("Packed {} entry(ies), {} bytes into mod bundle: {}", entries_.size(), bytes.size(), path.string());
+    return true;
+}
+
+} // namespace app_hook::config
@@ -1,8 +1,7 @@
 #include "../../include/config/task_loader.hpp"
 #include "../../include/config/config_factory.hpp"
+#include "../../include/util/worker_pool.hpp"
 #include <unordered_map>
-#include <unordered_set>
-#include <functional>
 #include <ranges>
 #include <algorithm>
 #include <filesystem>
@@ -24,20 +23,38 @@ TaskLoader::load_configs_from_tasks(const std::string& tasks_file_path) {
         return std::unexpected(tasks_result.error());
     }
     
-    std::vector<ConfigPtr> all_configs;
+    const auto& tasks = *tasks_result;
     
-    // Load configs from each task file using the generic factory
-    for (const auto& task : *tasks_result) {
-        // Resolve config file path relative to tasks directory
-        std::filesystem::path config_file_path = tasks_dir / task.config_file;
-        std::string full_config_path = config_file_path.string();
-        
-        LOG_INFO("Loading {} configs from task '{}' file: {} (resolved from: {})", 
-                 to_string(task.type), task.name, full_config_path, task.config_file);
-        
-        auto configs_result = ConfigFactory::load_configs(task.type, full_config_path, task.name);
+    // Parse the task files concurrently; results are merged below in task order
+    std::vector<ConfigResult<std::vector<ConfigPtr>>> task_configs(
+        tasks.size(), std::unexpected(ConfigError::parse_error));
+    if (!tasks.empty()) {
+        util::WorkerPool pool(std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1,
+                                                      std::min<std::size_t>(tasks.size(), 8)));
+        pool.for_each_index(tasks.size(), [&](std::size_t i) {
+            const auto& task = tasks[i];
+            
+            // Resolve config file path relative to tasks directory
+            std::filesystem::path config_file_path = tasks_dir / task.config_file;
+            std::string full_config_path = config_file_path.string();
+            
+            LOG_INFO("Loading {} configs from task '{}' file: {} (resolved from: {})", 
+                     to_string(task.type), task.name, full_config_path, task.config_file);
+            
+            task_configs[i] = ConfigFactory::load_configs(task.type, full_config_path, task.name);
+            if (!task_configs[i]) {
+                LOG_ERROR("Failed to load configs from task file: {}", full_config_path);
+                return;
+            }
+            
+            LOG_INFO("Loaded {} config(s) from task '{}' file: {}", 
+                    task_configs[i]->size(), task.name, full_config_path);
+        });
+    }
+    
+    std::vector<ConfigPtr> all_configs;
+    for (auto& configs_result : task_configs) {
         if (!configs_result) {
-            LOG_ERROR("Failed to load configs from task file: {}", full_config_path);
             return std::unexpected(configs_result.error());
         }
         
@@ -45,9 +62,6 @@ TaskLoader::load_configs_from_tasks(const std::string& tasks_file_path) {
         for (auto& config : *configs_result) {
             all_configs.push_back(std::move(config));
         }
-        
-        LOG_INFO("Loaded {} config(s) from task '{}' file: {}", 
-                configs_result->size(), task.name, full_config_path);
     }
     
     LOG_INFO("Successfully loaded {} total config(s) from {} task(s)", 
@@ -55,94 +69,137 @@ TaskLoader::load_configs_from_tasks(const std::string& tasks_file_path) {
     return all_configs;
 }
 
-ConfigResult<std::vector<std::string>>
-TaskLoader::build_execution_order(const std::vector<TaskInfo>& tasks) {
-    LOG_INFO("Building task execution order for {} task(s)", tasks.size());
+std::string TaskGraph::key_from_file(std::string_view config_file) {
+    // Extract task name from key (format: "dir/task_name.toml")
+    if (auto pos = config_file.find_last_of('/'); pos != std::string_view::npos) {
+        config_file.remove_prefix(pos + 1);
+    }
+    if (config_file.ends_with(".toml")) {
+        config_file.remove_suffix(5);
+    }
+    return std::string{config_file};
+}
+
+std::optional<TaskGraph::TaskId> TaskGraph::find(const std::string& key) const {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+ConfigResult<TaskGraph> TaskGraph::build(std::span<const TaskInfo> tasks) {
+    TaskGraph graph;
+    graph.tasks_ = tasks;
+    graph.ids_.reserve(tasks.size());
+    graph.keys_.reserve(tasks.size());
+    graph.index_.reserve(tasks.size());
     
-    // Create a map of task names to TaskInfo for quick lookup
-    std::unordered_map<std::string, const TaskInfo*> task_map;
-    for (const auto& task : tasks) {
-        // Extract task name from key (format: "tasks.task_name")
-        auto pos = task.config_file.find_last_of('/');
-        std::string task_key = pos != std::string::npos ? 
-            task.config_file.substr(pos + 1) : task.config_file;
-        
-        // Remove .toml extension
-        if (task_key.ends_with(".toml")) {
-            task_key.erase(task_key.length() - 5);
+    // Intern task keys in declaration order
+    for (std::uint32_t i = 0; i < tasks.size(); ++i) {
+        auto task_key = key_from_file(tasks[i].config_file);
+        const auto id = static_cast<TaskId>(graph.ids_.size());
+        if (!graph.index_.emplace(task_key, id).second) {
+            LOG_WARNING("Task '{}' reuses key '{}' - ignoring it", tasks[i].name, task_key);
+            continue;
         }
-        
-        task_map[task_key] = &task;
-        LOG_DEBUG("Mapped task key '{}' to task '{}'", task_key, task.name);
+        LOG_DEBUG("Mapped task key '{}' to task '{}'", task_key, tasks[i].name);
+        graph.ids_.push_back(i);
+        graph.keys_.push_back(std::move(task_key));
     }
     
-    // Build dependency graph using modern C++23 features
-    std::unordered_map<std::string, std::vector<std::string>> dependencies;
-    std::unordered_set<std::string> all_tasks;
-    
-    for (const auto& task : tasks) {
-        auto task_key = task.config_file;
-        auto pos = task_key.find_last_of('/');
-        if (pos != std::string::npos) task_key = task_key.substr(pos + 1);
-        if (task_key.ends_with(".toml")) task_key.erase(task_key.length() - 5);
-        
-        all_tasks.insert(task_key);
-        dependencies[task_key] = task.follow_by;
-        
+    // Resolve followBy names once into adjacency arrays
+    const auto count = graph.ids_.size();
+    std::vector<std::uint32_t> in_degree(count, 0);
+    graph.follower_offsets_.reserve(count + 1);
+    graph.follower_offsets_.push_back(0);
+    for (TaskId id = 0; id < count; ++id) {
+        const auto& task = graph.task(id);
         if (task.has_follow_up_tasks()) {
-            LOG_DEBUG("Task '{}' has {} follow-up task(s)", task_key, task.follow_by.size());
-            for (const auto& follow_task : task.follow_by) {
-                LOG_DEBUG("  -> '{}'", follow_task);
+            LOG_DEBUG("Task '{}' has {} follow-up task(s)", graph.keys_[id], task.follow_by.size());
+        }
+        for (const auto& follow_task : task.follow_by) {
+            auto it = graph.index_.find(follow_task);
+            if (it == graph.index_.end()) {
+                LOG_WARNING("Follow-up task '{}' referenced by '{}' not found", follow_task, graph.keys_[id]);
+                continue;
             }
+            LOG_DEBUG("  -> '{}'", follow_task);
+            graph.follower_ids_.push_back(it->second);
+            ++in_degree[it->second];
         }
+        graph.follower_offsets_.push_back(static_cast<std::uint32_t>(graph.follower_ids_.size()));
     }
     
-    // Topological sort to detect cycles and determine execution order
-    std::vector<std::string> execution_order;
-    std::unordered_set<std::string> visited;
-    std::unordered_set<std::string> in_path;
-    
-    std::function<bool(const std::string&)> visit_task = [&](const std::string& task_key) -> bool {
-        if (in_path.contains(task_key)) {
-            LOG_ERROR("Circular dependency detected involving task '{}'", task_key);
-            return false; // Cycle detected
+    // Reverse edges, bucketed by follower; parents stay in declaration order
+    graph.parent_offsets_.assign(count + 1, 0);
+    for (const auto follower : graph.follower_ids_) {
+        ++graph.parent_offsets_[follower + 1];
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        graph.parent_offsets_[i + 1] += graph.parent_offsets_[i];
+    }
+    graph.parent_ids_.resize(graph.follower_ids_.size());
+    {
+        auto cursor = graph.parent_offsets_;
+        for (TaskId id = 0; id < count; ++id) {
+            for (const auto follower : graph.followers(id)) {
+                graph.parent_ids_[cursor[follower]++] = id;
+            }
         }
-        
-        if (visited.contains(task_key)) {
-            return true; // Already processed
+    }
+    
+    // Kahn's algorithm, one level at a time
+    graph.order_.reserve(count);
+    graph.level_offsets_.push_back(0);
+    for (TaskId id = 0; id < count; ++id) {
+        if (in_degree[id] == 0) {
+            graph.order_.push_back(id);
         }
-        
-        in_path.insert(task_key);
-        
-        // Visit all follow-up tasks first (reverse dependency)
-        if (dependencies.contains(task_key)) {
-            for (const auto& follow_task : dependencies[task_key]) {
-                if (all_tasks.contains(follow_task)) {
-                    if (!visit_task(follow_task)) {
-                        return false; // Propagate cycle detection
-                    }
-                } else {
-                    LOG_WARNING("Follow-up task '{}' referenced by '{}' not found", follow_task, task_key);
+    }
+    for (std::size_t begin = 0; begin < graph.order_.size();) {
+        const auto end = graph.order_.size();
+        graph.level_offsets_.push_back(static_cast<std::uint32_t>(end));
+        for (auto i = begin; i < end; ++i) {
+            for (const auto follower : graph.followers(graph.order_[i])) {
+                if (--in_degree[follower] == 0) {
+                    graph.order_.push_back(follower);
                 }
             }
         }
-        
-        in_path.erase(task_key);
-        visited.insert(task_key);
-        execution_order.push_back(task_key);
-        
-        return true;
-    };
+        // Keep each level in declaration order so the result is deterministic
+        std::sort(graph.order_.begin() + static_cast<std::ptrdiff_t>(end), graph.order_.end());
+        begin = end;
+    }
     
-    // Visit all tasks
-    for (const auto& task_key : all_tasks) {
-        if (!visit_task(task_key)) {
-            return std::unexpected(ConfigError::invalid_format);
+    if (graph.order_.size() != count) {
+        for (TaskId id = 0; id < count; ++id) {
+            if (in_degree[id] != 0) {
+                LOG_ERROR("Circular dependency detected involving task '{}'", graph.keys_[id]);
+            }
         }
+        return std::unexpected(ConfigError::invalid_format);
+    }
+    
+    LOG_DEBUG("Built task graph: {} task(s), {} edge(s), {} level(s)", 
+              count, graph.follower_ids_.size(), graph.level_count());
+    return graph;
+}
+
+ConfigResult<std::vector<std::string>>
+TaskLoader::build_execution_order(const std::vector<TaskInfo>& tasks) {
+    LOG_INFO("Building task execution order for {} task(s)", tasks.size());
+    
+    auto graph = TaskGraph::build(tasks);
+    if (!graph) {
+        return std::unexpected(graph.error());
     }
     
-    // Reverse to get correct execution order (dependencies first)
-    std::ranges::reverse(execution_order);
+    std::vector<std::string> execution_order;
+    execution_order.reserve(graph->size());
+    for (const auto id : graph->order()) {
+        execution_order.push_back(graph->key(id));
+    }
     
     // Build execution order string manually since fmt::join isn't available
     std::string order_str;
@@ -0,0 +1,632 @@
+#include "../../include/hook/call_profiler.hpp"
+#include "../../include/hook/hook_stats.hpp"
+#include "../../include/util/logger.hpp"
+#include <MinHook.h>
+#include <toml++/toml.h>
+#include <intrin.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace app_hook::hook {
+
+namespace {
+
+// Count-only probe: two locked adds, then the original code
+const std::uint8_t count_probe_stub[] = {
+    0x9C,                                   // pushfd
+    0xF0, 0x83, 0x05, 0, 0, 0, 0, 0x01,     // lock add dword ptr [calls], 1
+    0xF0, 0x83, 0x15, 0, 0, 0, 0, 0x00,     // lock adc dword ptr [calls + 4], 0
+    0x9D,                                   // popfd
+    0xE9, 0, 0, 0, 0                        // jmp trampoline
+};
+
+// Timed probe: counts, then hands its ProbeCounters* to the shared entry routine
+const std::uint8_t timed_probe_stub[] = {
+    0x9C,                                   // pushfd
+    0xF0, 0x83, 0x05, 0, 0, 0, 0, 0x01,     // lock add dword ptr [calls], 1
+    0xF0, 0x83, 0x15, 0, 0, 0, 0, 0x00,     // lock adc dword ptr [calls + 4], 0
+    0x9D,                                   // popfd
+    0x68, 0, 0, 0, 0,                       // push ProbeCounters*
+    0xE9, 0, 0, 0, 0                        // jmp timed entry routine
+};
+
+// Where a probe kind keeps the operands patched in its code
+struct ProbeLayout {
+    std::span<const std::uint8_t> code;
+    std::size_t calls_low_offset;           // [calls] displacement
+    std::size_t calls_high_offset;          // [calls + 4] displacement
+    std::size_t probe_offset;               // ProbeCounters* immediate (timed only)
+    std::size_t jmp_offset;                 // jmp opcode
+};
+
+constexpr ProbeLayout probe_layout(bool timed) noexcept {
+    return timed ? ProbeLayout{timed_probe_stub, 4, 12, 19, 23}
+                 : ProbeLayout{count_probe_stub, 4, 12, 0, 18};
+}
+
+static_assert(sizeof(count_probe_stub) <= StubArena::kSlotSize && sizeof(timed_probe_stub) <= StubArena::kSlotSize);
+static_assert(sizeof(void*) == 4, "probe stubs are x86 code");
+static_assert(offsetof(ProbeCounters, calls) == 0 && offsetof(ProbeCounters, ticks) == 8 &&
+              offsetof(ProbeCounters, trampoline) == 16, "offsets are hard-coded in the routines below");
+
+/// @brief Call in flight on a thread's shadow stack
+struct ShadowFrame {
+    std::uint32_t return_address;
+    ProbeCounters* probe;
+    std::uint32_t start_low;
+    std::uint32_t start_high;
+    std::uint32_t slot;             ///< Stack address holding the caller's return address
+};
+
+/// @brief Nesting depth of timed calls kept per thread; deeper calls are counted only
+constexpr std::size_t kShadowDepth = 256;
+
+/// @brief Timed calls in flight on one thread
+///
+/// frames[0] is a sentinel whose slot is above any stack address, so the routines
+/// below never look past the bottom. A call left by SEH unwind, longjmp or a C++
+/// exception leaves its frame behind: the next timed call at or above its slot
+/// drops it on entry, and a timed return drops every frame deeper than its own.
+/// A frame at the new call's slot is kept if the slot holds the exit routine: it
+/// is a timed function tail-calling another, and the return pops both frames and
+/// times only the outer call.
+struct ShadowStack {
+    ShadowFrame* top;
+    ShadowFrame* limit;
+    std::array<ShadowFrame, kShadowDepth> frames;
+};
+
+static_assert(sizeof(ShadowFrame) == 20 && offsetof(ShadowFrame, slot) == 16 && offsetof(ShadowStack, top) == 0 &&
+              offsetof(ShadowStack, limit) == 4 && offsetof(ShadowStack, frames) == 8,
+              "offsets are hard-coded in the routines below");
+
+// Entry routine shared by timed probes. On entry [esp] is the probe's
+// ProbeCounters* and [esp + 4] the caller's return address.
+const std::uint8_t timed_entry_routine[] = {
+    0x50,                                   //  0: push eax
+    0x51,                                   //  1: push ecx
+    0x52,                                   //  2: push edx
+    0x9C,                                   //  3: pushfd
+    0x64, 0x8B, 0x0D, 0, 0, 0, 0,           //  4: mov ecx, fs:[TLS slot] (ShadowStack*)
+    0x85, 0xC9,                             // 11: test ecx, ecx
+    0x74, 0x58,                             // 13: jz allocate (103)
+    0x8D, 0x44, 0x24, 0x14,                 // 15: resume: lea eax, [esp + 20] (slot)
+    0x8B, 0x11,                             // 19: mov edx, [ecx] (top)
+    0x39, 0x42, 0xFC,                       // 21: discard: cmp [edx - 4], eax (slot of top - 1)
+    0x77, 0x0F,                             // 24: ja keep (41): a caller's frame
+    0x72, 0x08,                             // 26: jb drop (36): left by an unwind
+    0x81, 0x38, 0, 0, 0, 0,                 // 28: cmp dword ptr [eax], exit routine
+    0x74, 0x05,                             // 34: je keep (41): a tail caller's frame
+    0x83, 0xEA, 0x14,                       // 36: drop: sub edx, 20
+    0xEB, 0xEC,                             // 39: jmp discard (21)
+    0x89, 0x11,                             // 41: keep: mov [ecx], edx
+    0x3B, 0x51, 0x04,                       // 43: cmp edx, [ecx + 4] (limit)
+    0x73, 0x25,                             // 46: jae done (85): too deep, count only
+    0x83, 0x01, 0x14,                       // 48: add dword ptr [ecx], 20 (push a frame)
+    0x89, 0xD1,                             // 51: mov ecx, edx
+    0x89, 0x41, 0x10,                       // 53: mov [ecx + 16], eax (slot)
+    0x8B, 0x44, 0x24, 0x14,                 // 56: mov eax, [esp + 20] (return address)
+    0x89, 0x01,                             // 60: mov [ecx], eax
+    0x8B, 0x44, 0x24, 0x10,                 // 62: mov eax, [esp + 16] (ProbeCounters*)
+    0x89, 0x41, 0x04,                       // 66: mov [ecx + 4], eax
+    0xC7, 0x44, 0x24, 0x14, 0, 0, 0, 0,     // 69: mov dword ptr [esp + 20], exit routine
+    0x0F, 0x31,                             // 77: rdtsc
+    0x89, 0x41, 0x08,                       // 79: mov [ecx + 8], eax
+    0x89, 0x51, 0x0C,                       // 82: mov [ecx + 12], edx
+    0x9D,                                   // 85: done: popfd
+    0x5A,                                   // 86: pop edx
+    0x59,                                   // 87: pop ecx
+    0x58,                                   // 88: pop eax
+    0x50,                                   // 89: push eax
+    0x8B, 0x44, 0x24, 0x04,                 // 90: mov eax, [esp + 4] (ProbeCounters*)
+    0x8B, 0x40, 0x10,                       // 94: mov eax, [eax + 16] (trampoline)
+    0x89, 0x44, 0x24, 0x04,                 // 97: mov [esp + 4], eax
+    0x58,                                   //101: pop eax
+    0xC3,                                   //102: ret (to the trampoline)
+    0xE8, 0, 0, 0, 0,                       //103: allocate: call allocate_shadow_stack
+    0x89, 0xC1,                             //108: mov ecx, eax
+    0x85, 0xC9,                             //110: test ecx, ecx
+    0x75, 0x9D,                             //112: jnz resume (15)
+    0xEB, 0xE1                              //114: jmp done (85)
+};
+
+// Exit routine: timed calls return here instead of to their caller. The
+// returning call's frame is the outermost one whose slot is below esp (stdcall
+// callees pop their arguments, so esp is not exactly slot + 4); frames pushed
+// after it belong to calls left by an unwind and are dropped.
+const std::uint8_t timed_exit_routine[] = {
+    0x50,                                   //  0: push eax (slot for the return address)
+    0x50,                                   //  1: push eax
+    0x51,                                   //  2: push ecx
+    0x52,                                   //  3: push edx
+    0x9C,                                   //  4: pushfd
+    0x64, 0x8B, 0x0D, 0, 0, 0, 0,           //  5: mov ecx, fs:[TLS slot] (ShadowStack*)
+    0x8D, 0x44, 0x24, 0x14,                 // 12: lea eax, [esp + 20] (esp after the return)
+    0x8B, 0x11,                             // 16: mov edx, [ecx]
+    0x83, 0xEA, 0x14,                       // 18: sub edx, 20 (top frame)
+    0x39, 0x42, 0xFC,                       // 21: find: cmp [edx - 4], eax (slot of the frame below)
+    0x73, 0x05,                             // 24: jae found (31): the frame below is a caller's
+    0x83, 0xEA, 0x14,                       // 26: sub edx, 20 (the frame was left by an unwind)
+    0xEB, 0xF6,                             // 29: jmp find (21)
+    0x89, 0x11,                             // 31: found: mov [ecx], edx (pop it and the stale frames)
+    0x89, 0xD1,                             // 33: mov ecx, edx
+    0x8B, 0x01,                             // 35: mov eax, [ecx] (return address)
+    0x89, 0x44, 0x24, 0x10,                 // 37: mov [esp + 16], eax
+    0x0F, 0x31,                             // 41: rdtsc
+    0x2B, 0x41, 0x08,                       // 43: sub eax, [ecx + 8]
+    0x1B, 0x51, 0x0C,                       // 46: sbb edx, [ecx + 12]
+    0x8B, 0x49, 0x04,                       // 49: mov ecx, [ecx + 4] (ProbeCounters*)
+    0xF0, 0x01, 0x41, 0x08,                 // 52: lock add [ecx + 8], eax (ticks)
+    0xF0, 0x11, 0x51, 0x0C,                 // 56: lock adc [ecx + 12], edx
+    0x9D,                                   // 60: popfd
+    0x5A,                                   // 61: pop edx
+    0x59,                                   // 62: pop ecx
+    0x58,                                   // 63: pop eax
+    0xC3                                    // 64: ret (to the caller)
+};
+
+constexpr std::size_t kEntryTlsOffset = 7;
+constexpr std::size_t kEntryTailOffset = 30;
+constexpr std::size_t kEntryExitOffset = 73;
+constexpr std::size_t kEntryCallOffset = 103;
+constexpr std::size_t kExitTlsOffset = 8;
+
+/// @brief Where the exit routine starts in the routines' page
+constexpr std::size_t kExitRoutineOffset = 128;
+
+/// @brief TLS slots readable at fs:[0xE10 + 4 * index] (TEB TlsSlots)
+constexpr DWORD kInlineTlsSlots = 64;
+
+void write_u32(void* code, std::size_t offset, std::uint32_t value) {
+    std::memcpy(static_cast<std::uint8_t*>(code) + offset, &value, sizeof(value));
+}
+
+void write_pointer(void* code, std::size_t offset, const void* pointer) {
+    write_u32(code, offset, static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(pointer)));
+}
+
+// Patch the rel32 of the jmp or call whose opcode is at offset
+void write_branch(void* code, std::size_t offset, const void* target) {
+    const auto next = reinterpret_cast<std::uintptr_t>(code) + offset + 5;
+    write_u32(code, offset + 1, static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(target) - next));
+}
+
+/// @brief Shared timed entry and exit routines and the threads' shadow stacks
+/// @note Built on first use and kept until the process exits: a timed call may
+///       still be on some stack, due to return through the exit routine
+class TimedRuntime {
+public:
+    /// @brief Get the runtime, building it on first use
+    /// @return Runtime, or nullptr if no inline TLS slot or executable page is available
+    static TimedRuntime* instance() {
+        static TimedRuntime* runtime = [] {
+            auto* built = new TimedRuntime();
+            if (!built->build()) {
+                delete built;
+                return static_cast<TimedRuntime*>(nullptr);
+            }
+            return built;
+        }();
+        return runtime;
+    }
+
+    [[nodiscard]] void* entry() const noexcept { return code_; }
+
+    /// @brief Check if no timed call is in flight on any thread
+    [[nodiscard]] bool idle() {
+        std::lock_guard lock(mutex_);
+        return std::ranges::all_of(stacks_, [](const auto& stack) {
+            return stack->top == stack->frames.data() + 1;
+        });
+    }
+
+private:
+    TimedRuntime() = default;
+
+    bool build() {
+        tls_index_ = TlsAlloc();
+        if (tls_index_ == TLS_OUT_OF_INDEXES) {
+            return false;
+        }
+        if (tls_index_ >= kInlineTlsSlots) {
+            TlsFree(tls_index_);
+            return false;
+        }
+        code_ = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, StubArena::kPageSize, MEM_COMMIT | MEM_RESERVE,
+                                                        PAGE_READWRITE));
+        if (!code_) {
+            TlsFree(tls_index_);
+            return false;
+        }
+
+        const std::uint32_t tls_slot = 0xE10 + 4 * tls_index_;
+        auto* exit = code_ + kExitRoutineOffset;
+        std::memcpy(code_, timed_entry_routine, sizeof(timed_entry_routine));
+        std::memcpy(exit, timed_exit_routine, sizeof(timed_exit_routine));
+        write_u32(code_, kEntryTlsOffset, tls_slot);
+        write_pointer(code_, kEntryTailOffset, exit);
+        write_pointer(code_, kEntryExitOffset, exit);
+        write_branch(code_, kEntryCallOffset, reinterpret_cast<const void*>(&TimedRuntime::allocate_shadow_stack));
+        write_u32(exit, kExitTlsOffset, tls_slot);
+
+        DWORD old_protection = 0;
+        VirtualProtect(code_, StubArena::kPageSize, PAGE_EXECUTE_READ, &old_protection);
+        FlushInstructionCache(GetCurrentProcess(), code_, StubArena::kPageSize);
+        return true;
+    }
+
+    /// @brief Give the calling thread its shadow stack (first timed call on the thread)
+    /// @return Stack, or nullptr to count the call without timing it
+    /// @note Called from the entry routine, which saved the scratch registers
+    static ShadowStack* allocate_shadow_stack() {
+        auto* runtime = instance();
+        auto stack = std::make_unique<ShadowStack>();
+        stack->frames[0].slot = UINT32_MAX;
+        stack->top = stack->frames.data() + 1;
+        stack->limit = stack->frames.data() + stack->frames.size();
+        if (!TlsSetValue(runtime->tls_index_, stack.get())) {
+            return nullptr;
+        }
+        std::lock_guard lock(runtime->mutex_);
+        return runtime->stacks_.emplace_back(std::move(stack)).get();
+    }
+
+    DWORD tls_index_ = TLS_OUT_OF_INDEXES;
+    std::uint8_t* code_ = nullptr;
+    std::mutex mutex_;                                  ///< Guards stacks_
+    std::vector<std::unique_ptr<ShadowStack>> stacks_;
+};
+
+/// @brief Split a CSV line into its fields
+std::vector<std::string_view> split_fields(std::string_view line) {
+    std::vector<std::string_view> fields;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i <= line.size(); ++i) {
+        if (i == line.size() || line[i] == '\t' || line[i] == ',' || line[i] == ';') {
+            fields.push_back(line.substr(begin, i - begin));
+            begin = i + 1;
+        }
+    }
+    return fields;
+}
+
+/// @brief Parse a hex address field ("0x4A1000", "004A1000", optionally quoted)
+std::optional<std::uintptr_t> parse_hex_field(std::string_view field) {
+    const auto trim = [](std::string_view text) {
+        const auto first = text.find_first_not_of(" \t\r\"");
+        const auto last = text.find_last_not_of(" \t\r\"");
+        return first == std::string_view::npos ? std::string_view{} : text.substr(first, last - first + 1);
+    };
+    field = trim(field);
+    if (field.starts_with("0x") || field.starts_with("0X")) {
+        field.remove_prefix(2);
+    }
+    std::uintptr_t address = 0;
+    const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), address, 16);
+    if (field.empty() || error != std::errc{} || end != field.data() + field.size() || address == 0) {
+        return std::nullopt;
+    }
+    return address;
+}
+
+/// @brief Read an address from a TOML integer or string
+std::optional<std::uintptr_t> parse_address_node(const toml::node& node) {
+    if (auto value = node.value<std::int64_t>(); value && *value > 0) {
+        return static_cast<std::uintptr_t>(*value);
+    }
+    if (auto text = node.value<std::string>()) {
+        try {
+            return config::ConfigParsingUtils::parse_address(*text);
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+    return std::nullopt;
+}
+
+void sort_unique(std::vector<std::uintptr_t>& addresses) {
+    std::ranges::sort(addresses);
+    addresses.erase(std::unique(addresses.begin(), addresses.end()), addresses.end());
+}
+
+} // namespace
+
+config::ConfigResult<ProfileOptions> CallProfiler::load_options(const std::filesystem::path& path) {
+    toml::table root;
+    try {
+        root = toml::parse_file(path.string());
+    } catch (const toml::parse_error& e) {
+        LOG_ERROR("Cannot parse profile config {}: {}", path.string(), e.description());
+        std::error_code ec;
+        return std::unexpected(std::filesystem::exists(path, ec) ? config::ConfigError::parse_error
+                                                                 : config::ConfigError::file_not_found);
+    }
+
+    const auto* profile = root["profile"].as_table();
+    if (!profile) {
+        LOG_ERROR("Profile config {} has no [profile] table", path.string());
+        return std::unexpected(config::ConfigError::missing_required_field);
+    }
+
+    ProfileOptions options;
+    if (const auto* addresses = profile->get_as<toml::array>("addresses")) {
+        for (const auto& node : *addresses) {
+            const auto address = parse_address_node(node);
+            if (!address) {
+                LOG_ERROR("Profile config {} lists an invalid address", path.string());
+                return std::unexpected(config::ConfigError::invalid_format);
+            }
+            options.addresses.push_back(*address);
+        }
+    }
+
+    // IDA exports are resolved next to the config file
+    if (auto csv = profile->get_as<std::string>("ida_csv")) {
+        const auto csv_path = path.parent_path() / csv->get();
+        std::ifstream file(csv_path, std::ios::binary);
+        if (!file) {
+            LOG_ERROR("IDA export {} of profile config {} not found", csv_path.string(), path.string());
+            return std::unexpected(config::ConfigError::file_not_found);
+        }
+        const std::string text{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        const auto column = profile->get_as<std::int64_t>("csv_column");
+        if (column && column->get() < 0) {
+            return std::unexpected(config::ConfigError::invalid_format);
+        }
+        std::ranges::move(parse_ida_csv(text, column ? static_cast<std::size_t>(column->get()) : 0),
+                          std::back_inserter(options.addresses));
+    }
+
+    if (auto timing = profile->get_as<bool>("timing")) {
+        options.timing = timing->get();
+    }
+    if (auto report = profile->get_as<std::string>("report")) {
+        options.report_path = report->get();
+    }
+
+    sort_unique(options.addresses);
+    if (options.addresses.empty()) {
+        LOG_ERROR("Profile config {} lists no address", path.string());
+        return std::unexpected(config::ConfigError::missing_required_field);
+    }
+    return options;
+}
+
+std::vector<std::uintptr_t> CallProfiler::parse_ida_csv(std::string_view text, std::size_t column) {
+    std::vector<std::uintptr_t> addresses;
+    while (!text.empty()) {
+        const auto end = text.find('\n');
+        const auto line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+        // Header rows and blank lines have no address in the column
+        const auto fields = split_fields(line);
+        if (column < fields.size()) {
+            if (const auto address = parse_hex_field(fields[column])) {
+                addresses.push_back(*address);
+            }
+        }
+    }
+    sort_unique(addresses);
+    return addresses;
+}
+
+std::span<const std::uint8_t> CallProfiler::probe_stub_code(bool timed) noexcept {
+    return probe_layout(timed).code;
+}
+
+std::uint64_t CallProfiler::read_counter(const std::uint64_t& counter) noexcept {
+    // The halves are written by separate locked adds; retry if the high half moved
+    const auto* halves = reinterpret_cast<const volatile std::uint32_t*>(&counter);
+    std::uint32_t high = 0;
+    std::uint32_t low = 0;
+    do {
+        high = halves[1];
+        low = halves[0];
+    } while (high != halves[1]);
+    return (static_cast<std::uint64_t>(high) << 32) | low;
+}
+
+void CallProfiler::add(const ProfileOptions& options) {
+    addresses_.insert(addresses_.end(), options.addresses.begin(), options.addresses.end());
+    sort_unique(addresses_);
+    timed_ = timed_ || options.timing;
+    report_path_ = options.report_path;
+}
+
+std::size_t CallProfiler::install(std::span<const std::uintptr_t> hooked) {
+    if (addresses_.empty() || running_) {
+        return probes_.size();
+    }
+
+    TimedRuntime* runtime = nullptr;
+    if (timed_) {
+        runtime = TimedRuntime::instance();
+        if (!runtime) {
+            LOG_WARNING("No TLS slot or page for timed probes: counting calls only");
+            timed_ = false;
+        }
+    }
+    const auto layout = probe_layout(timed_);
+
+    // A probe's jmp must not overlap a hook's or another probe's
+    std::vector<std::uintptr_t> taken(hooked.begin(), hooked.end());
+    std::ranges::sort(taken);
+    const auto near_hook = [&taken](std::uintptr_t address) {
+        const auto it = std::ranges::lower_bound(taken, address > kPatchSize ? address - kPatchSize + 1 : 0);
+        return it != taken.end() && *it < address + kPatchSize;
+    };
+
+    counters_ = std::make_unique<ProbeCounters[]>(addresses_.size());
+    probes_.reserve(addresses_.size());
+    skipped_ = 0;
+
+    stubs_.begin_write();
+    for (const auto address : addresses_) {
+        if (near_hook(address) || (!probes_.empty() && address - probes_.back().address < kPatchSize)) {
+            LOG_DEBUG("Not profiling 0x{:X}: too close to a hook or probe", address);
+            ++skipped_;
+            continue;
+        }
+        auto& counters = counters_[probes_.size()];
+        void* stub = stubs_.allocate(layout.code.size());
+        if (!stub) {
+            ++skipped_;
+            continue;
+        }
+        std::memcpy(stub, layout.code.data(), layout.code.size());
+        write_pointer(stub, layout.calls_low_offset, &counters.calls);
+        write_pointer(stub, layout.calls_high_offset, reinterpret_cast<const std::uint8_t*>(&counters.calls) + 4);
+        if (timed_) {
+            write_pointer(stub, layout.probe_offset, &counters);
+        }
+
+        void* trampoline = nullptr;
+        if (MH_CreateHook(reinterpret_cast<LPVOID>(address), stub, &trampoline) != MH_OK) {
+            LOG_DEBUG("Not profiling 0x{:X}: MinHook cannot hook it", address);
+            stubs_.deallocate(stub);
+            ++skipped_;
+            continue;
+        }
+        counters.trampoline = trampoline;
+        write_branch(stub, layout.jmp_offset, timed_ ? runtime->entry() : trampoline);
+        probes_.push_back({address, stub});
+        MH_QueueEnableHook(reinterpret_cast<LPVOID>(address));
+    }
+    stubs_.end_write();
+
+    // One thread freeze for every probe
+    if (!probes_.empty() && MH_ApplyQueued() != MH_OK) {
+        LOG_ERROR("Failed to enable {} profiling probe(s)", probes_.size());
+        release();
+        return 0;
+    }
+
+    start_qpc_ = read_timestamp();
+    start_tsc_ = __rdtsc();
+    running_ = !probes_.empty();
+    LOG_INFO("Profiling {} address(es){} ({} skipped), report in {}", probes_.size(),
+             timed_ ? " with timing" : "", skipped_, report_path_);
+    return probes_.size();
+}
+
+bool CallProfiler::stop() {
+    if (!running_) {
+        return true;
+    }
+    for (const auto& probe : probes_) {
+        MH_QueueDisableHook(reinterpret_cast<LPVOID>(probe.address));
+    }
+    MH_ApplyQueued();
+
+    seconds_ = static_cast<double>(ticks_to_ns(read_timestamp() - start_qpc_)) / 1e9;
+    ticks_per_second_ = timed_ && seconds_ > 0.0 ? static_cast<double>(__rdtsc() - start_tsc_) / seconds_ : 0.0;
+    running_ = false;
+
+    const std::filesystem::path path = report_path_;
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::ofstream out(path, std::ios::trunc);
+    out << format_report(report());
+    if (!out) {
+        LOG_ERROR("Cannot write the call profile to {}", report_path_);
+        return false;
+    }
+    LOG_INFO("Call profile of {} address(es) over {:.1f} s written to {}", probes_.size(), seconds_, report_path_);
+    return true;
+}
+
+ProfileReport CallProfiler::report() const {
+    std::vector<std::uintptr_t> addresses;
+    addresses.reserve(probes_.size());
+    for (const auto& probe : probes_) {
+        addresses.push_back(probe.address);
+    }
+
+    // A running profile reports the window so far
+    auto seconds = seconds_;
+    auto ticks_per_second = ticks_per_second_;
+    if (running_) {
+        seconds = static_cast<double>(ticks_to_ns(read_timestamp() - start_qpc_)) / 1e9;
+        ticks_per_second = timed_ && seconds > 0.0 ? static_cast<double>(__rdtsc() - start_tsc_) / seconds : 0.0;
+    }
+    auto result = make_report(addresses, {counters_.get(), counters_ ? probes_.size() : 0}, seconds, ticks_per_second);
+    result.skipped = skipped_;
+    return result;
+}
+
+ProfileReport CallProfiler::make_report(std::span<const std::uintptr_t> addresses,
+                                        std::span<const ProbeCounters> counters,
+                                        double seconds, double ticks_per_second) {
+    ProfileReport report;
+    report.seconds = seconds;
+    report.timed = ticks_per_second > 0.0;
+    report.entries.reserve(addresses.size());
+    for (std::size_t i = 0; i < addresses.size() && i < counters.size(); ++i) {
+        auto& entry = report.entries.emplace_back();
+        entry.address = addresses[i];
+        entry.calls = read_counter(counters[i].calls);
+        entry.calls_per_second = seconds > 0.0 ? static_cast<double>(entry.calls) / seconds : 0.0;
+        if (report.timed) {
+            const auto ticks = static_cast<double>(read_counter(counters[i].ticks));
+            entry.time_share = seconds > 0.0 ? ticks / (ticks_per_second * seconds) : 0.0;
+            entry.mean_ns = entry.calls ? static_cast<std::uint64_t>(ticks * 1e9 / ticks_per_second / entry.calls) : 0;
+        }
+    }
+    std::ranges::sort(report.entries, [](const ProfileEntry& a, const ProfileEntry& b) {
+        return a.calls != b.calls ? a.calls > b.calls : a.address < b.address;
+    });
+    return report;
+}
+
+std::string CallProfiler::format_report(const ProfileReport& report) {
+    std::string text = std::format("# Calls to the profiled addresses over {:.1f} s, most called first\n", report.seconds);
+    if (report.timed) {
+        text += "# time_share is the share of the wall time spent in the calls, callees included\n";
+    }
+    if (report.skipped != 0) {
+        text += std::format("# {} address(es) could not be probed, see logs/app_hook.log\n", report.skipped);
+    }
+    for (const auto& entry : report.entries) {
+        text += '\n';
+        if (entry.calls_per_second >= kHotCallsPerSecond) {
+            text += "# Hot: hook with policy = \"once\" or \"every_n\", or keep its tasks on the minimal stub\n";
+        }
+        text += std::format("[[function]]\naddress = \"0x{:08X}\"\ncalls = {}\ncalls_per_second = {:.1f}\n",
+                            entry.address, entry.calls, entry.calls_per_second);
+        if (report.timed) {
+            text += std::format("time_share = {:.6f}\nmean_ns = {}\n", entry.time_share, entry.mean_ns);
+        }
+    }
+    return text;
+}
+
+void CallProfiler::release() {
+    for (const auto& probe : probes_) {
+        MH_RemoveHook(reinterpret_cast<LPVOID>(probe.address));
+    }
+    stubs_.release();
+    probes_.clear();
+    running_ = false;
+
+    // The exit routine adds to the counters of calls still in flight
+    if (timed_ && counters_) {
+        auto* runtime = TimedRuntime::instance();
+        if (runtime && !runtime->idle()) {
+            LOG_DEBUG("Timed calls still in flight: keeping the profiler's counters");
+            (void)counters_.release();
+        }
+    }
+    counters_.reset();
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,127 @@
+#include "../../include/hook/frame_scheduler.hpp"
+#include "../../include/util/logger.hpp"
+#include <toml++/toml.h>
+#include <optional>
+
+namespace app_hook::hook {
+
+config::ConfigResult<FrameOptions> FrameScheduler::load_options(const std::filesystem::path& path) {
+    toml::table root;
+    try {
+        root = toml::parse_file(path.string());
+    } catch (const toml::parse_error& e) {
+        LOG_ERROR("Cannot parse frame config {}: {}", path.string(), e.description());
+        std::error_code ec;
+        return std::unexpected(std::filesystem::exists(path, ec) ? config::ConfigError::parse_error
+                                                                 : config::ConfigError::file_not_found);
+    }
+
+    const auto* frame = root["frame"].as_table();
+    const auto anchor = frame ? frame->get_as<std::string>("anchor") : nullptr;
+    if (!anchor) {
+        LOG_ERROR("Frame config {} has no [frame] anchor", path.string());
+        return std::unexpected(config::ConfigError::missing_required_field);
+    }
+
+    FrameOptions options;
+    try {
+        options.anchor = config::ConfigParsingUtils::parse_address(anchor->get());
+    } catch (const std::exception&) {
+        options.anchor = 0;
+    }
+    if (options.anchor == 0) {
+        LOG_ERROR("Frame config {} has an invalid anchor '{}'", path.string(), anchor->get());
+        return std::unexpected(config::ConfigError::invalid_format);
+    }
+
+    if (auto budget = frame->get_as<std::int64_t>("budget_us")) {
+        if (budget->get() < 1 || budget->get() > 1'000'000) {
+            LOG_ERROR("Frame config {} has an invalid budget_us", path.string());
+            return std::unexpected(config::ConfigError::invalid_format);
+        }
+        options.budget_us = static_cast<std::uint32_t>(budget->get());
+    }
+    return options;
+}
+
+void FrameScheduler::configure(const FrameOptions& options) noexcept {
+    anchor_ = options.anchor;
+    budget_us_ = options.budget_us;
+}
+
+bool FrameScheduler::defer(Job job) {
+    if (!active()) {
+        return false;
+    }
+    std::lock_guard lock(mutex_);
+    queue_.push_back(job);
+    return true;
+}
+
+void FrameScheduler::on_frame() {
+    framework_.record(frame_ticks_.exchange(0, std::memory_order_relaxed));
+
+    // Jobs are popped one at a time: hooks on other threads may queue meanwhile
+    const auto start = read_timestamp();
+    const std::uint64_t budget_ns = std::uint64_t{budget_us_} * 1'000;
+    std::uint64_t runs = 0;
+    std::uint64_t elapsed_ns = 0;
+    while (runs == 0 || elapsed_ns < budget_ns) {
+        std::optional<Job> job;
+        {
+            std::lock_guard lock(mutex_);
+            if (queue_.empty()) {
+                break;
+            }
+            job = queue_.front();
+            queue_.pop_front();
+        }
+        job->fn(job->state);
+        ++runs;
+        elapsed_ns = ticks_to_ns(read_timestamp() - start);
+    }
+
+    if (runs != 0) {
+        deferred_.record(read_timestamp() - start);
+        deferred_runs_.fetch_add(runs, std::memory_order_relaxed);
+        if (elapsed_ns > budget_ns) {
+            over_budget_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::size_t FrameScheduler::pending() const {
+    std::lock_guard lock(mutex_);
+    return queue_.size();
+}
+
+FrameStats FrameScheduler::stats() const {
+    FrameStats result;
+    result.framework = framework_.snapshot();
+    result.frames = result.framework.calls;
+    result.deferred = deferred_.snapshot();
+    result.deferred_runs = deferred_runs_.load(std::memory_order_relaxed);
+    result.over_budget = over_budget_.load(std::memory_order_relaxed);
+    result.pending = pending();
+    return result;
+}
+
+std::size_t FrameScheduler::shutdown() {
+    std::size_t dropped = 0;
+    {
+        std::lock_guard lock(mutex_);
+        dropped = queue_.size();
+        queue_.clear();
+    }
+
+    if (active()) {
+        const auto frame = stats();
+        LOG_INFO("Frame anchor 0x{:X}: {} frame(s), hooks took {} us per frame on average ({} us max); "
+                 "{} deferred job(s) run, {} frame(s) over the {} us budget, {} dropped",
+                 anchor_, frame.frames, frame.framework.mean_ns() / 1'000, frame.framework.max_ns / 1'000,
+                 frame.deferred_runs, frame.over_budget, budget_us_, dropped);
+    }
+    return dropped;
+}
+
+} // namespace app_hook::hook
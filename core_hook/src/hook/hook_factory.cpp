@@ -1,14 +1,47 @@
 #include "../../include/hook/hook_factory.hpp"
 #include "../../include/util/logger.hpp"
+#include "../../include/util/startup_trace.hpp"
+#include "../../include/util/worker_pool.hpp"
 #include <algorithm>
+#include <iterator>
 #include <ranges>
 #include <filesystem>
 
 namespace app_hook::hook {
 
+namespace {
+
+/// @brief Check if every config of a task names the address it hooks
+/// @note Memory configs always do; others (e.g. scripts with a hookAddress) may,
+///       and are then hooked there instead of following a parent task
+bool defines_hook_addresses(const std::vector<config::ConfigPtr>& configs) {
+    return !configs.empty() && std::ranges::all_of(configs, [](const config::ConfigPtr& config) {
+        return config->get_hook_address_if_trigger() != 0;
+    });
+}
+
+/// @brief Get where a hook runs a task of an execution mode
+TaskDispatch dispatch_of(config::TaskExecution execution) noexcept {
+    switch (execution) {
+        case config::TaskExecution::async: return TaskDispatch::worker;
+        case config::TaskExecution::deferred: return TaskDispatch::deferred;
+        default: return TaskDispatch::inline_call;
+    }
+}
+
+/// @brief Check if a task type's config file is read by the core instead of a plugin loader
+bool is_core_task(config::ConfigType type) noexcept {
+    return type == config::ConfigType::Profile || type == config::ConfigType::Frame;
+}
+
+} // namespace
+
 FactoryResult HookFactory::create_hooks_from_tasks(
     const std::string& tasks_path,
-    HookManager& manager) {
+    HookManager& manager,
+    HotReloader* reloader,
+    std::shared_ptr<const config::ModBundle> bundle,
+    bool pack_bundle) {
     
     LOG_INFO("Creating hooks from tasks configuration: {}", tasks_path);
     
@@ -16,54 +49,146 @@ FactoryResult HookFactory::create_hooks_from_tasks(
     std::filesystem::path config_dir = std::filesystem::path(tasks_path).parent_path();
     LOG_INFO("Config directory resolved as: {}", config_dir.string());
     
+    // Unchanged files are served from the config cache instead of being parsed
+    config::ConfigCache cache(config_dir);
+    if (bundle) {
+        cache.attach_bundle(std::move(bundle));
+    }
+    
     // Load task information
-    auto tasks_result = config::TaskLoader::load_tasks(tasks_path);
+    auto tasks_result = [&] {
+        util::TraceScope trace("load_tasks", "config", tasks_path);
+        return cache.load_tasks(tasks_path);
+    }();
     if (!tasks_result) {
         LOG_ERROR("Failed to load tasks from: {}", tasks_path);
         return std::unexpected(FactoryError::config_load_failed);
     }
     
-    // Build execution order
-    auto order_result = config::TaskLoader::build_execution_order(*tasks_result);
-    if (!order_result) {
+    // Index the tasks and order them by their followBy dependencies
+    auto graph_result = [&] {
+        util::TraceScope trace("build_task_graph", "config");
+        return config::TaskGraph::build(*tasks_result);
+    }();
+    if (!graph_result) {
         LOG_ERROR("Failed to build task execution order");
         return std::unexpected(FactoryError::invalid_config);
     }
+    const auto& graph = *graph_result;
     
-    LOG_INFO("Processing {} task(s) in dependency order", order_result->size());
-    
-    // Track where each task was hooked for dependency resolution
-    std::unordered_map<std::string, std::uintptr_t> task_hook_addresses;
+    LOG_INFO("Processing {} task(s) in dependency order", graph.size());
     
-    // Create a map of task information for quick lookup
-    std::unordered_map<std::string, const config::TaskInfo*> task_info_map;
-    for (const auto& task : *tasks_result) {
-        task_info_map[get_task_key_from_file(task.config_file)] = &task;
+    // Config files do not depend on each other: parse them all concurrently,
+    // then wire the hooks one task at a time in dependency order
+    std::vector<config::ConfigResult<std::vector<config::ConfigPtr>>> task_configs(
+        graph.size(), std::unexpected(config::ConfigError::file_not_found));
+    if (graph.size() != 0) {
+        util::TraceScope trace("load_task_configs", "config", std::to_string(graph.size()) + " task(s)");
+        util::WorkerPool pool(std::clamp<std::size_t>(std::thread::hardware_concurrency(), 1,
+                                                      std::min<std::size_t>(graph.size(), kMaxParseThreads)));
+        pool.for_each_index(graph.size(), [&](std::size_t id) {
+            task_configs[id] = load_task_configs(graph.task(static_cast<config::TaskGraph::TaskId>(id)), cache,
+                                                 config_dir.string());
+        });
     }
     
+    // Where each task was hooked (0 if nowhere yet), for its followers
+    std::vector<std::uintptr_t> task_hook_addresses(graph.size(), 0);
+    
+    // Tasks running on the worker pool or the frame anchor; their followers run there too
+    std::vector<TaskDispatch> task_dispatch(graph.size(), TaskDispatch::inline_call);
+    
     // Process tasks in dependency order
-    for (const auto& task_key : *order_result) {
-        // Find the task info for this key
-        auto task_it = std::ranges::find_if(*tasks_result, [&task_key](const auto& task) {
-            return get_task_key_from_file(task.config_file) == task_key;
-        });
+    {
+        util::TraceScope create_trace("create_tasks", "tasks");
+        for (const auto id : graph.order()) {
+            const auto& task = graph.task(id);
+            const auto& task_key = graph.key(id);
         
-        if (task_it == tasks_result->end()) {
-            LOG_ERROR("Task key '{}' not found in loaded tasks", task_key);
-            return std::unexpected(FactoryError::invalid_config);
-        }
+            if (!task_configs[id]) {
+                LOG_ERROR("Failed to process task '{}' ({})", task.name, task_key);
+                return std::unexpected(FactoryError::config_load_failed);
+            }
         
-        LOG_INFO("Processing task '{}' ({})", task_it->name, task_key);
+            LOG_INFO("Processing task '{}' ({})", task.name, task_key);
+            util::TraceScope task_trace("create_task", "tasks", task.name);
         
-        if (auto result = process_task_with_dependencies(*task_it, task_hook_addresses, task_info_map, manager, config_dir.string()); !result) {
-            LOG_ERROR("Failed to process task '{}' ({})", task_it->name, task_key);
-            return result;
-        }
+            // Profile tasks add probes, not hooks or tasks
+            if (task.type == config::ConfigType::Profile) {
+                auto options = hook::CallProfiler::load_options(config_dir / task.config_file);
+                if (!options) {
+                    LOG_ERROR("Failed to process task '{}' ({})", task.name, task_key);
+                    return std::unexpected(FactoryError::config_load_failed);
+                }
+                manager.profiler().add(*options);
+                LOG_INFO("Profiling {} address(es) for task '{}' ({})", options->addresses.size(), task.name, task_key);
+                continue;
+            }
+        
+            // Frame tasks hook the anchor; followers may run on every frame
+            if (task.type == config::ConfigType::Frame) {
+                auto options = FrameScheduler::load_options(config_dir / task.config_file);
+                if (!options) {
+                    LOG_ERROR("Failed to process task '{}' ({})", task.name, task_key);
+                    return std::unexpected(FactoryError::config_load_failed);
+                }
+                auto& scheduler = manager.frame_scheduler();
+                if (scheduler.active() && scheduler.anchor() != options->anchor) {
+                    LOG_ERROR("Task '{}' ({}) sets a second frame anchor", task.name, task_key);
+                    return std::unexpected(FactoryError::invalid_config);
+                }
+                scheduler.configure(*options);
+                if (auto result = manager.add_task_to_hook(options->anchor, std::make_unique<FrameAnchorTask>(scheduler));
+                    !result) {
+                    return std::unexpected(FactoryError::hook_creation_failed);
+                }
+                task_hook_addresses[id] = options->anchor;
+                LOG_INFO("Frame anchor at 0x{:X} with a {} us budget for task '{}' ({})",
+                         options->anchor, options->budget_us, task.name, task_key);
+                continue;
+            }
+        
+            if (reloader) {
+                std::vector<std::string> followers;
+                for (const auto follower : graph.followers(id)) {
+                    followers.push_back(graph.key(follower));
+                }
+                reloader->track_task(task, task_key, config_dir / task.config_file, std::move(followers));
+            }
+        
+            if (auto result = process_task_with_dependencies(graph, id, *task_configs[id], task_hook_addresses, task_dispatch, manager, reloader); !result) {
+                LOG_ERROR("Failed to process task '{}' ({})", task.name, task_key);
+                return result;
+            }
         
-        LOG_INFO("Successfully processed task '{}' ({})", task_it->name, task_key);
+            LOG_INFO("Successfully processed task '{}' ({})", task.name, task_key);
+        }
+    }
+    
+    if (!manager.frame_scheduler().active() && std::ranges::find(task_dispatch, TaskDispatch::deferred) != task_dispatch.end()) {
+        LOG_WARNING("Deferred tasks run inside their hooked call: no frame task sets an anchor");
     }
     
-    LOG_INFO("Successfully created hooks from tasks configuration");
+    {
+        util::TraceScope trace("save_config_cache", "config");
+        (void)cache.save();
+    }
+    if (pack_bundle) {
+        util::TraceScope trace("pack_mod_bundle", "config");
+        std::vector<std::string> data_files;
+        for (const auto& configs : task_configs) {
+            for (const auto& config : *configs) {
+                std::ranges::move(config->data_files(), std::back_inserter(data_files));
+            }
+        }
+        std::ranges::sort(data_files);
+        data_files.erase(std::unique(data_files.begin(), data_files.end()), data_files.end());
+        if (!cache.write_bundle(data_files)) {
+            LOG_ERROR("Failed to pack the mod bundle of {}", config_dir.string());
+        }
+    }
+    LOG_INFO("Successfully created hooks from tasks configuration ({} file(s) from cache, {} parsed)", 
+             cache.hits(), cache.misses());
     return {};
 }
 
@@ -110,14 +235,15 @@ FactoryResult HookFactory::create_hooks_from_configs(
     return {};
 }
 
-FactoryResult HookFactory::process_task_with_dependencies(
+config::ConfigResult<std::vector<config::ConfigPtr>> HookFactory::load_task_configs(
     const config::TaskInfo& task,
-    std::unordered_map<std::string, std::uintptr_t>& task_hook_addresses,
-    const std::unordered_map<std::string, const config::TaskInfo*>& task_info_map,
-    HookManager& manager,
+    config::ConfigCache& cache,
     const std::string& config_dir) {
     
-    LOG_DEBUG("Processing task '{}' of type '{}'", task.name, to_string(task.type));
+    // Profile and frame configs are read by the core itself
+    if (is_core_task(task.type)) {
+        return std::vector<config::ConfigPtr>{};
+    }
     
     // Resolve config file path relative to config directory
     std::filesystem::path config_file_path = std::filesystem::path(config_dir) / task.config_file;
@@ -130,32 +256,64 @@ FactoryResult HookFactory::process_task_with_dependencies(
     LOG_DEBUG("  Full config path: {}", full_config_path);
     
     // Check if the config file exists
-    if (!std::filesystem::exists(config_file_path)) {
+    std::error_code ec;
+    if (!std::filesystem::exists(config_file_path, ec)) {
         LOG_ERROR("Config file does not exist: {}", full_config_path);
         LOG_ERROR("  Config directory: {}", config_dir);
         LOG_ERROR("  Relative path: {}", task.config_file);
-        LOG_ERROR("  Working directory: {}", std::filesystem::current_path().string());
-        return std::unexpected(FactoryError::config_load_failed);
+        LOG_ERROR("  Working directory: {}", std::filesystem::current_path(ec).string());
+        return std::unexpected(config::ConfigError::file_not_found);
     } else {
         LOG_DEBUG("Config file exists: {}", full_config_path);
     }
     
-    // Load configurations for this task using the generic factory
-    auto configs_result = config::ConfigFactory::load_configs(task.type, full_config_path, task.name);
+    // Load configurations for this task using the generic factory (or the cache)
+    util::TraceScope trace("load_config_file", "config", full_config_path);
+    auto configs_result = cache.load_configs(task.type, full_config_path, task.name);
     if (!configs_result) {
         LOG_ERROR("Failed to load configs for task '{}' from: {}", task.name, full_config_path);
-        return std::unexpected(FactoryError::config_load_failed);
+        return configs_result;
     }
     
     LOG_DEBUG("Loaded {} configuration(s) for task '{}'", configs_result->size(), task.name);
+    return configs_result;
+}
+
+FactoryResult HookFactory::process_task_with_dependencies(
+    const config::TaskGraph& graph,
+    config::TaskGraph::TaskId id,
+    const std::vector<config::ConfigPtr>& configs,
+    std::vector<std::uintptr_t>& task_hook_addresses,
+    std::vector<TaskDispatch>& task_dispatch,
+    HookManager& manager,
+    HotReloader* reloader) {
     
-    const auto task_key = get_task_key_from_file(task.config_file);
+    const auto& task = graph.task(id);
+    LOG_DEBUG("Processing task '{}' of type '{}'", task.name, to_string(task.type));
     
-    // For memory tasks, they define their own hook addresses
-    if (task.type == config::ConfigType::Memory) {
+    const auto& task_key = graph.key(id);
+    
+    // Eager tasks have their inputs ready at install time: run them now, no detour
+    if (task.execution == config::TaskExecution::eager) {
+        for (const auto& config : configs) {
+            if (auto result = run_eager_task(config, task_key, manager, reloader); !result) {
+                return result;
+            }
+        }
+        
+        task_hook_addresses[id] = kEagerAddress;
+        LOG_INFO("Ran {} eager config(s) of task '{}' at install time", configs.size(), task.name);
+        return {};
+    }
+    
+    // For memory tasks (and tasks whose configs all name an address), they define their own hook addresses
+    if (task.type == config::ConfigType::Memory || defines_hook_addresses(configs)) {
         LOG_DEBUG("Processing memory task - will define own hook addresses");
         
-        for (const auto& config : *configs_result) {
+        const auto dispatch = dispatch_of(task.execution);
+        task_dispatch[id] = dispatch;
+        
+        for (const auto& config : configs) {
             LOG_DEBUG("Processing memory config: '{}'", config->key());
             
             std::uintptr_t hook_address = extract_hook_address(*config);
@@ -175,17 +333,25 @@ FactoryResult HookFactory::process_task_with_dependencies(
             }
             
             LOG_DEBUG("Adding task to hook at address 0x{:X}", hook_address);
-            if (auto result = manager.add_task_to_hook(hook_address, std::move(task_ptr)); !result) {
+            auto* hook_task = task_ptr.get();
+            if (auto result = manager.add_task_to_hook(hook_address, std::move(task_ptr), dispatch); !result) {
                 LOG_ERROR("Failed to add task '{}' to hook at address 0x{:X}", config->key(), hook_address);
                 return std::unexpected(FactoryError::hook_creation_failed);
             }
+            if (reloader) {
+                reloader->track_config(task_key, config, hook_task);
+            }
+            
+            if (auto* hook = manager.get_hook(hook_address)) {
+                apply_task_policy(task, *hook);
+            }
             
             // Remember where this task was hooked for followBy tasks
-            task_hook_addresses[task_key] = hook_address;
+            task_hook_addresses[id] = hook_address;
             LOG_DEBUG("Recorded task '{}' at hook address 0x{:X}", task_key, hook_address);
         }
         
-        LOG_DEBUG("Completed processing memory task '{}' with {} configs", task.name, configs_result->size());
+        LOG_DEBUG("Completed processing memory task '{}' with {} configs", task.name, configs.size());
     } 
     // For other task types (like patches), they are following tasks that should use parent task's hook address
     else {
@@ -194,30 +360,35 @@ FactoryResult HookFactory::process_task_with_dependencies(
         std::uintptr_t hook_address = 0;
         
         // This is a following task - it should be attached to the same hook as its parent
-        // Find which task this one is following by looking at the followBy relationships
         std::string parent_task_key;
+        auto parent_dispatch = TaskDispatch::inline_call;
         
-        LOG_DEBUG("Looking for parent hook address from {} existing task(s)", task_hook_addresses.size());
+        LOG_DEBUG("Looking for parent hook address among {} parent task(s)", graph.parents(id).size());
         
-        // Find the parent task that has this task in its followBy list
-        for (const auto& [existing_task_key, existing_hook_address] : task_hook_addresses) {
-            LOG_DEBUG("  Available task: '{}' at address 0x{:X}", existing_task_key, existing_hook_address);
-            
-            // Check if this existing task has the current task in its followBy list
-            auto parent_task_it = task_info_map.find(existing_task_key);
-            if (parent_task_it != task_info_map.end()) {
-                const auto& parent_task = *parent_task_it->second;
-                
-                // Check if this parent task has the current task in its followBy list
-                auto follow_it = std::find(parent_task.follow_by.begin(), parent_task.follow_by.end(), task_key);
-                if (follow_it != parent_task.follow_by.end()) {
-                    hook_address = existing_hook_address;
-                    parent_task_key = existing_task_key;
-                    LOG_DEBUG("Following task '{}' will use hook address 0x{:X} from parent task '{}'", 
-                             task_key, hook_address, parent_task_key);
-                    break;
+        // The first parent (in declaration order) that was hooked supplies the address
+        for (const auto parent : graph.parents(id)) {
+            LOG_DEBUG("  Parent task: '{}' at address 0x{:X}", graph.key(parent), task_hook_addresses[parent]);
+            if (task_hook_addresses[parent] != 0) {
+                hook_address = task_hook_addresses[parent];
+                parent_task_key = graph.key(parent);
+                parent_dispatch = task_dispatch[parent];
+                LOG_DEBUG("Following task '{}' will use hook address 0x{:X} from parent task '{}'", 
+                         task_key, hook_address, parent_task_key);
+                break;
+            }
+        }
+        
+        // The parent ran at install time, so its followers can run right after it
+        if (hook_address == kEagerAddress) {
+            for (const auto& config : configs) {
+                if (auto result = run_eager_task(config, task_key, manager, reloader); !result) {
+                    return result;
                 }
             }
+            
+            task_hook_addresses[id] = kEagerAddress;
+            LOG_INFO("Ran following task '{}' at install time (parent: '{}')", task_key, parent_task_key);
+            return {};
         }
         
         if (hook_address == 0) {
@@ -226,38 +397,91 @@ FactoryResult HookFactory::process_task_with_dependencies(
             return std::unexpected(FactoryError::invalid_config);
         }
         
+        // Followers of an async or deferred task wait on it by running after it in the same job
+        const auto dispatch = parent_dispatch != TaskDispatch::inline_call ? parent_dispatch
+                                                                           : dispatch_of(task.execution);
+        task_dispatch[id] = dispatch;
+        
         // Create tasks for this address
-        for (const auto& config : *configs_result) {
+        for (const auto& config : configs) {
             auto task_ptr = task::TaskFactory::instance().create_task(*config);
             if (!task_ptr) {
                 LOG_ERROR("Failed to create task for config '{}'", config->key());
                 return std::unexpected(FactoryError::task_creation_failed);
             }
             
-            if (auto result = manager.add_task_to_hook(hook_address, std::move(task_ptr)); !result) {
+            auto* hook_task = task_ptr.get();
+            if (auto result = manager.add_task_to_hook(hook_address, std::move(task_ptr), dispatch); !result) {
                 LOG_ERROR("Failed to add task '{}' to hook at address 0x{:X}", config->key(), hook_address);
                 return std::unexpected(FactoryError::hook_creation_failed);
             }
+            if (reloader) {
+                reloader->track_config(task_key, config, hook_task);
+            }
             
             LOG_INFO("Successfully added following task '{}' to hook at address 0x{:X} (parent: '{}')", 
                      config->key(), hook_address, parent_task_key);
         }
+        if (auto* hook = manager.get_hook(hook_address)) {
+            apply_task_policy(task, *hook);
+        }
         
         // Record this task's hook address for any tasks that might follow it
-        task_hook_addresses[task_key] = hook_address;
+        task_hook_addresses[id] = hook_address;
     }
     
     return {};
 }
 
-std::string HookFactory::get_task_key_from_file(const std::string& config_file) {
-    auto pos = config_file.find_last_of('/');
-    std::string task_key = pos != std::string::npos ? 
-        config_file.substr(pos + 1) : config_file;
-    if (task_key.ends_with(".toml")) {
-        task_key.erase(task_key.length() - 5);
+void HookFactory::apply_task_policy(const config::TaskInfo& task, Hook& hook) {
+    // Any task asking for registers gives the whole hook the full stub
+    if (task.stub == config::TaskStub::full) {
+        hook.set_stub_kind(StubKind::full);
+    }
+    
+    TriggerPolicy policy = TriggerPolicy::always;
+    switch (task.policy) {
+        case config::TaskPolicy::always: return;
+        case config::TaskPolicy::once: policy = TriggerPolicy::once; break;
+        case config::TaskPolicy::until_success: policy = TriggerPolicy::until_success; break;
+        case config::TaskPolicy::every_n: policy = TriggerPolicy::every_n; break;
+    }
+    
+    // The policy gates the whole hook, so tasks sharing it must agree
+    if (hook.policy() != TriggerPolicy::always) {
+        if (hook.policy() != policy || (policy == TriggerPolicy::every_n && hook.gate().period() != task.every_n)) {
+            LOG_WARNING("Task '{}' policy ignored: hook at 0x{:X} already has another policy", task.name, hook.address());
+        }
+        return;
+    }
+    
+    hook.set_policy(policy, task.every_n);
+    LOG_DEBUG("Hook at address 0x{:X} uses trigger policy {} (every {} calls)", hook.address(),
+              static_cast<int>(policy), task.every_n);
+}
+
+FactoryResult HookFactory::run_eager_task(const config::ConfigPtr& config, const std::string& task_key,
+                                          HookManager& manager, HotReloader* reloader) {
+    auto task_ptr = task::TaskFactory::instance().create_task(*config);
+    if (!task_ptr) {
+        LOG_ERROR("Failed to create task for config '{}'", config->key());
+        return std::unexpected(FactoryError::task_creation_failed);
     }
-    return task_key;
+    
+    if (auto result = task_ptr->execute(); !result) {
+        LOG_ERROR("Eager task '{}' failed with error code: {}", config->key(), static_cast<int>(result.error()));
+        return std::unexpected(FactoryError::task_execution_failed);
+    }
+    
+    // The task holds what it changed (e.g. a patch's original bytes): the manager
+    // keeps it so uninstall can roll it back and hot reload can update it
+    auto* detached = manager.add_detached_task(std::move(task_ptr));
+    if (reloader) {
+        reloader->track_config(task_key, config, detached);
+    }
+    
+    LOG_DEBUG("Eager task '{}' completed at install time", config->key());
+    return {};
 }
 
 FactoryResult HookFactory::create_tasks_for_address(
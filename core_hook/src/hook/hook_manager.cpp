@@ -1,5 +1,9 @@
 #include "../../include/hook/hook_manager.hpp"
+#include "../../include/hook/stub_arena.hpp"
+#include "../../include/context/mod_context.hpp"
 #include "../../include/util/logger.hpp"
+#include "../../include/util/startup_trace.hpp"
+#include <algorithm>
 #include <unordered_map>
 #include <functional>
 #include <sstream>
@@ -7,128 +11,312 @@
 
 namespace app_hook::hook {
 
-// Global map to associate addresses with hook instances
-// This is needed because MinHook requires static function pointers
-static std::unordered_map<std::uintptr_t, Hook*> g_hook_map;
+// C++ function called by minimal hook handlers. The stub passes the Hook* it
+// was generated for, so dispatch is a direct call with no lookup.
+void* dispatch_hook(Hook* hook) {
+    return dispatch_hook_with_context(hook, nullptr);
+}
+
+// Called by full-context handlers, which also pass their saved register frame
+void* dispatch_hook_with_context(Hook* hook, task::CpuContext* context) {
+    void* trampoline = hook->trampoline();
+    
+    // Skipped triggers (retired, claimed elsewhere, off-period) pass straight through
+    auto& gate = hook->gate();
+    auto* owner = hook->owner();
+    if (!gate.enter()) {
+        if (owner && owner->recorder().recording()) [[unlikely]] {
+            owner->recorder().record(hook->address(), read_timestamp(), 0, kTriggerSkipped);
+        }
+        return trampoline;
+    }
+    
+    const auto start = read_timestamp();
+    std::uint32_t failed = 0;
+    {
+        // Context values the tasks read stay alive until they return
+        const auto guard = app_hook::context::ModContext::instance().read_guard();
+        failed = hook->run_tasks(context);
+    }
+    const bool succeeded = failed == 0;
+    const auto elapsed = read_timestamp() - start;
+    hook->timing().record(elapsed);
+    if (!succeeded) {
+        hook->timing().record_failure();
+    }
+    if (owner) {
+        owner->frame_scheduler().add_framework_time(elapsed);
+        if (owner->recorder().recording()) [[unlikely]] {
+            owner->recorder().record(hook->address(), start, elapsed, failed);
+        }
+    }
+    if (gate.leave(succeeded) && owner) {
+        owner->retire_hook(*hook);
+    }
+    return trampoline;
+}
 
-// C++ function called by hook handlers
-void* execute_hook_by_address(void* address) {
-    std::uintptr_t addr_int = reinterpret_cast<std::uintptr_t>(address);
-    LOG_INFO("Hook triggered at address: 0x{:X}", addr_int);
+void Hook::submit_worker_tasks() {
+    auto run_worker_entries = [this] {
+        const auto guard = app_hook::context::ModContext::instance().read_guard();
+        for (const auto& entry : program_.entries()) {
+            if (entry.dispatch == TaskDispatch::worker) {
+                run_entry(entry);
+            }
+        }
+    };
+    
+    // Keyed on the address so a hook's jobs never overlap each other
+    if (!owner_ || !owner_->worker_pool().submit(address_, run_worker_entries)) {
+        run_worker_entries();
+    }
+}
 
-    if (auto it = g_hook_map.find(addr_int); it != g_hook_map.end()) {
-        LOG_DEBUG("Found hook for address 0x{:X}, executing {} task(s)", addr_int, it->second->task_count());
-        it->second->execute_tasks();
-        LOG_DEBUG("Completed execution for hook at address 0x{:X}", addr_int);
-        LOG_INFO("returning to 0x{:X}", reinterpret_cast<std::uintptr_t>(it->second->trampoline()));
-        return it->second->trampoline();
+void Hook::defer_tasks() {
+    // A job still queued runs the tasks for this trigger too
+    if (deferred_queued_.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    if (!owner_ || !owner_->frame_scheduler().defer({&Hook::run_deferred_tasks, this})) {
+        run_deferred_tasks(this);
     }
-    LOG_WARNING("No hook found for triggered address: 0x{:X}", addr_int);
-    LOG_DEBUG("Available hooks:");
-    for (const auto& [hook_addr, hook_ptr] : g_hook_map) {
-        LOG_DEBUG("  - Hook at address: 0x{:X}", hook_addr);
+}
+
+void Hook::run_deferred_tasks(void* state) {
+    auto* hook = static_cast<Hook*>(state);
+    
+    // Cleared first: a trigger during the run queues the next one
+    hook->deferred_queued_.store(false, std::memory_order_release);
+    const auto guard = app_hook::context::ModContext::instance().read_guard();
+    for (const auto& entry : hook->program_.entries()) {
+        if (entry.dispatch == TaskDispatch::deferred) {
+            hook->run_entry(entry);
+        }
     }
-    return nullptr;
 }
 
-// Remplacer 0xDEADBEEF par l'adresse réelle au moment de l'allocation
-unsigned char hook_stub[] = {
+// Full-context stub: saves every general register and EFLAGS, and passes the
+// saved frame to the tasks as a CpuContext they can read and write
+const std::uint8_t full_hook_stub[] = {
     0x60,                               // pushad
     0x9C,                               // pushfd
-    0xB8, 0, 0, 0, 0,                   // mov eax, address of newfunc
+    0x54,                               // push esp (CpuContext*)
+    0x68, 0, 0, 0, 0,                   // push Hook* bound to this stub
+    0xE8, 0, 0, 0, 0,                   // call dispatch_hook_with_context (offset à patcher)
+    0x83, 0xC4, 0x08,                   // add esp, 8
+    0x9D,                               // popfd
+    0x61,                               // popad
+    0xFF, 0, 0, 0, 0                    // jmp to patch after trampoline creation
+};
+
+// Minimal stub: dispatch_hook is cdecl, so only the caller-saved registers
+// (EAX, ECX, EDX) and EFLAGS can change across the call
+const std::uint8_t minimal_hook_stub[] = {
     0x50,                               // push eax
-    0xE8, 0, 0, 0, 0,                   // call execute_hook_by_address (offset à patcher)
+    0x51,                               // push ecx
+    0x52,                               // push edx
+    0x9C,                               // pushfd
+    0x68, 0, 0, 0, 0,                   // push Hook* bound to this stub
+    0xE8, 0, 0, 0, 0,                   // call dispatch_hook
     0x83, 0xC4, 0x04,                   // add esp, 4
     0x9D,                               // popfd
-    0x61,                               // popad
+    0x5A,                               // pop edx
+    0x59,                               // pop ecx
+    0x58,                               // pop eax
     0xFF, 0, 0, 0, 0                    // jmp to patch after trampoline creation
 };
 
-void* create_hook_instance() {
-    size_t funcSize = sizeof(hook_stub);
-    // Allouer de la mémoire exécutable
-    void* newFunc = VirtualAlloc(nullptr, funcSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE);
+// Where a stub kind keeps the operands patched in its code
+struct StubLayout {
+    std::span<const std::uint8_t> code;
+    std::size_t hook_offset;            // Hook* immediate
+    std::size_t call_offset;            // call dispatch_hook (full: dispatch_hook_with_context) opcode
+    std::size_t jmp_offset;             // jmp to the trampoline opcode
+};
+
+constexpr StubLayout stub_layout(StubKind kind) noexcept {
+    return kind == StubKind::full ? StubLayout{full_hook_stub, 4, 8, 18}
+                                  : StubLayout{minimal_hook_stub, 5, 9, 21};
+}
+
+static_assert(sizeof(full_hook_stub) <= StubArena::kSlotSize && sizeof(minimal_hook_stub) <= StubArena::kSlotSize);
+
+std::span<const std::uint8_t> hook_stub_code(StubKind kind) noexcept {
+    return stub_layout(kind).code;
+}
+
+void bind_hook_stub(void* handler, StubKind kind, Hook* hook) {
+    std::uintptr_t hookAddr = reinterpret_cast<std::uintptr_t>(hook);
+    memcpy(reinterpret_cast<char*>(handler) + stub_layout(kind).hook_offset, &hookAddr, 4);
+}
+
+// Shared executable pages holding every hook stub
+static StubArena g_stub_arena;
+
+void* create_hook_instance(Hook* hook) {
+    const auto layout = stub_layout(hook->stub_kind());
+    // Prendre un slot dans l'arène de stubs (déjà ouverte en écriture)
+    void* newFunc = g_stub_arena.allocate(layout.code.size());
     if (newFunc) {
-        // Copier le code de la fonction générique
-        memcpy(newFunc, hook_stub, sizeof(hook_stub));
+        // Copier le code de la variante choisie
+        memcpy(newFunc, layout.code.data(), layout.code.size());
         
-        // Patch the address parameter for mov eax instruction (offset 3)
-        std::uintptr_t funcAddr = reinterpret_cast<std::uintptr_t>(newFunc);
-        memcpy(reinterpret_cast<char*>(newFunc) + 3, &funcAddr, 4);
+        bind_hook_stub(newFunc, hook->stub_kind(), hook);
         
-        // Patch the call offset for execute_hook_by_address (offset 9)
-        std::uintptr_t callSite = reinterpret_cast<std::uintptr_t>(newFunc) + 8 + 5; // address after the call instruction
-        std::uintptr_t targetAddr = reinterpret_cast<std::uintptr_t>(&execute_hook_by_address);
+        // Patch the call offset for the dispatcher of the stub kind
+        std::uintptr_t callSite = reinterpret_cast<std::uintptr_t>(newFunc) + layout.call_offset + 5; // address after the call instruction
+        std::uintptr_t targetAddr = hook->stub_kind() == StubKind::full
+            ? reinterpret_cast<std::uintptr_t>(&dispatch_hook_with_context)
+            : reinterpret_cast<std::uintptr_t>(&dispatch_hook);
         std::int32_t callOffset = static_cast<std::int32_t>(targetAddr - callSite);
-        memcpy(reinterpret_cast<char*>(newFunc) + 9, &callOffset, 4);
+        memcpy(reinterpret_cast<char*>(newFunc) + layout.call_offset + 1, &callOffset, 4);
     }
     return newFunc;
 }
 
-void patch_hook(void* handler, void* trampoline) {
+void patch_hook(void* handler, StubKind kind, void* trampoline) {
     if (!handler || !trampoline) {
         LOG_ERROR("Invalid handler or trampoline address for patching");
         return;
     }
     
-    // Patch the jmp instruction at the end of the hook stub
-    // The jmp instruction starts at offset 18 (0xFF, 0, 0, 0, 0)
+    // Patch the jmp instruction at the end of the hook stub (0xFF, 0, 0, 0, 0)
     // Change it to: 0xE9 followed by relative offset to trampoline
     char* hookCode = reinterpret_cast<char*>(handler);
+    const auto jmp = stub_layout(kind).jmp_offset;
     
     // Calculate relative offset for direct jmp (0xE9)
-    std::uintptr_t jmpSite = reinterpret_cast<std::uintptr_t>(handler) + 18 + 5; // address after jmp instruction
+    std::uintptr_t jmpSite = reinterpret_cast<std::uintptr_t>(handler) + jmp + 5; // address after jmp instruction
     std::uintptr_t trampolineAddr = reinterpret_cast<std::uintptr_t>(trampoline);
     std::int32_t jmpOffset = static_cast<std::int32_t>(trampolineAddr - jmpSite);
     
     // Patch: 0xE9 (direct jmp) + 4-byte relative offset
-    hookCode[18] = 0xE9;
-    memcpy(hookCode + 19, &jmpOffset, 4);
+    hookCode[jmp] = static_cast<char>(0xE9);
+    memcpy(hookCode + jmp + 1, &jmpOffset, 4);
     
     LOG_DEBUG("Patched hook at 0x{:X} to jump to trampoline at 0x{:X}", 
               reinterpret_cast<std::uintptr_t>(handler), trampolineAddr);
 }
 
 
+// A generated stub and the kind it was generated as
+struct HookHandler {
+    void* stub;
+    StubKind kind;
+};
+
 // Hook handler registry
-static std::unordered_map<std::uintptr_t, void*> g_handler_registry;
+static std::unordered_map<std::uintptr_t, HookHandler> g_handler_registry;
+
+// Guards the registry and the arena against concurrent installs and releases
+static std::mutex g_handler_mutex;
 
 // Generate hook handlers for any address from configuration
-void* get_or_create_hook_handler(std::uintptr_t address) {
+void* get_or_create_hook_handler(std::uintptr_t address, Hook* hook) {
+    std::lock_guard lock(g_handler_mutex);
     auto it = g_handler_registry.find(address);
     if (it != g_handler_registry.end()) {
-        return it->second;
+        // A cached stub may still point at a previous Hook for this address
+        if (it->second.kind == hook->stub_kind()) {
+            bind_hook_stub(it->second.stub, it->second.kind, hook);
+            return it->second.stub;
+        }
+        // The new hook needs the other variant
+        g_stub_arena.deallocate(it->second.stub);
+        g_handler_registry.erase(it);
     }
     
-    // Use the generic handler for all addresses
-    // The handler will determine the actual hook address at runtime
-    auto handler = create_hook_instance();
-    g_handler_registry[address] = handler;
+    // Each stub carries the Hook* it dispatches to
+    auto handler = create_hook_instance(hook);
+    if (handler) {
+        g_handler_registry[address] = HookHandler{handler, hook->stub_kind()};
+    }
     return handler;
 }
 
-void* HookManager::create_hook_handler(std::uintptr_t address) {
-    return get_or_create_hook_handler(address);
+void release_hook_handler(std::uintptr_t address) {
+    std::lock_guard lock(g_handler_mutex);
+    if (auto it = g_handler_registry.find(address); it != g_handler_registry.end()) {
+        g_stub_arena.deallocate(it->second.stub);
+        g_handler_registry.erase(it);
+    }
 }
 
-HookResult HookManager::install_hook(Hook& hook) {
+void release_hook_handlers() {
+    std::lock_guard lock(g_handler_mutex);
+    g_handler_registry.clear();
+    g_stub_arena.release();
+}
+
+std::vector<util::MemoryUsage> HookManager::memory_usage() const {
+    // MinHook hands out one 64-byte trampoline slot per hook from 4 KiB blocks
+    constexpr std::size_t kTrampolineSlotSize = 64;
+    constexpr std::size_t kTrampolineBlockSize = 4096;
+    
+    util::MemoryUsage stubs{"hook.stubs"};
+    {
+        std::lock_guard lock(g_handler_mutex);
+        stubs.count = g_stub_arena.slot_count();
+        stubs.bytes = stubs.count * StubArena::kSlotSize;
+        stubs.peak_bytes = g_stub_arena.peak_slot_count() * StubArena::kSlotSize;
+        stubs.committed_bytes = g_stub_arena.committed_bytes();
+        stubs.reserved_bytes = g_stub_arena.reserved_bytes();
+    }
+    
+    util::MemoryUsage trampolines{"hook.trampolines"};
+    util::MemoryUsage objects{"hook.objects"};
+    util::MemoryUsage configs{"hook.configs"};
+    for (const auto& [address, hook] : hooks_) {
+        if (hook->trampoline()) {
+            ++trampolines.count;
+        }
+        ++objects.count;
+        objects.bytes += sizeof(Hook) + hook->task_count() * (sizeof(task::HookTaskPtr) + sizeof(TimingCounters));
+        configs.count += hook->task_count();
+        configs.bytes += hook->config_bytes();
+    }
+    for (const auto& task : detached_tasks_) {
+        ++configs.count;
+        configs.bytes += task->config_bytes();
+    }
+    trampolines.bytes = trampolines.count * kTrampolineSlotSize;
+    trampolines.committed_bytes = (trampolines.bytes + kTrampolineBlockSize - 1) / kTrampolineBlockSize * kTrampolineBlockSize;
+    trampolines.reserved_bytes = trampolines.committed_bytes;
+    
+    return {std::move(stubs), std::move(trampolines), std::move(objects), std::move(configs)};
+}
+
+void* HookManager::create_hook_handler(Hook& hook) {
+    return get_or_create_hook_handler(hook.address(), &hook);
+}
+
+HookResult HookManager::create_hook(Hook& hook) {
     const auto address = hook.address();
+    util::TraceScope trace("create_hook", "hooks", std::format("0x{:X}", address));
     const auto address_ptr = reinterpret_cast<LPVOID>(address);
     void* trampoline = nullptr;
     
+    // Stub pages are RX except while a stub is being written
+    std::unique_lock arena_lock(g_handler_mutex);
+    g_stub_arena.begin_write();
+    arena_lock.unlock();
+    
+    auto end_write = [] {
+        std::lock_guard lock(g_handler_mutex);
+        g_stub_arena.end_write();
+    };
     
-    // Get or create hook handler
-    auto handler = create_hook_handler(address);
+    // Get or create hook handler bound to this hook
+    auto handler = create_hook_handler(hook);
     if (!handler) {
+        end_write();
         return std::unexpected(HookError::minhook_create_failed);
     }
-    // Register hook in global map
-    g_hook_map[reinterpret_cast<std::uintptr_t>(handler)] = &hook;
 
     hook.set_handler(reinterpret_cast<void*>(handler));
     
     if (MH_CreateHook(address_ptr, handler, &trampoline) != MH_OK) {
-        g_hook_map.erase(reinterpret_cast<std::uintptr_t>(handler));
+        end_write();
         return std::unexpected(HookError::minhook_create_failed);
     }
 
@@ -137,13 +325,130 @@ HookResult HookManager::install_hook(Hook& hook) {
     hook.set_trampoline(trampoline);
     
     // Patch the hook handler to jump to the trampoline
-    patch_hook(handler, trampoline);
+    patch_hook(handler, hook.stub_kind(), trampoline);
+    
+    end_write();
+    return {};
+}
+
+void HookManager::remove_hook(Hook& hook) {
+    if (hook.trampoline()) {
+        MH_RemoveHook(reinterpret_cast<LPVOID>(hook.address()));
+        hook.set_trampoline(nullptr);
+    }
+    // Nothing reaches the stub once the detour is gone
+    release_hook_handler(hook.address());
+    hook.set_handler(nullptr);
+}
+
+std::expected<void, TraceError> HookManager::write_trace(const std::filesystem::path& path) {
+    std::vector<TraceHook> hooks;
+    hooks.reserve(hook_order_.size());
+    for (const auto address : hook_order_) {
+        auto& hook = *hooks_.at(address);
+        hooks.push_back({static_cast<std::uint32_t>(address), static_cast<std::uint16_t>(hook.task_count()),
+                         hook.policy(), 0, hook.gate().period()});
+    }
+    
+    const auto trace = recorder_.stop(std::move(hooks));
+    if (auto result = trace.write(path); !result) {
+        LOG_ERROR("Failed to write the trigger trace to {}", path.string());
+        return result;
+    }
+    LOG_INFO("Trigger trace written to {}: {} trigger(s) of {} hook(s), {} dropped",
+             path.string(), trace.records.size(), trace.hooks.size(), trace.dropped);
+    return {};
+}
+
+bool HookManager::disable_for_exit() {
+    if (!initialized_) {
+        return false;
+    }
+    
+    const bool enabled = profiler_.probe_count() != 0 ||
+        std::ranges::any_of(hooks_, [](const auto& entry) { return entry.second->trampoline() != nullptr; });
+    if (enabled && MH_DisableHook(MH_ALL_HOOKS) != MH_OK) {
+        LOG_WARNING("Failed to disable the hooks at exit");
+    }
+    
+    // Its probes are disabled already, so this only writes the report
+    profiler_.stop();
+    return enabled;
+}
+
+void HookManager::retire_hook(Hook& hook) {
+    const auto address = hook.address();
+    if (!initialized_ || !hook.trampoline()) {
+        return;
+    }
+    
+    // Restores the original prologue; this thread is in the stub, not in the
+    // patched bytes, so it can disable its own hook
+    if (MH_DisableHook(reinterpret_cast<LPVOID>(address)) != MH_OK) {
+        LOG_WARNING("Failed to disable run-once hook at 0x{:X}", address);
+        return;
+    }
+    
+    // Other threads may still be in the stub or on their way to the trampoline;
+    // nothing tells when they have left, so both stay until uninstall_all
+    LOG_INFO("Run-once hook at 0x{:X} disabled, original function restored", address);
+}
+
+HookResult HookManager::install_hook(Hook& hook) {
+    if (auto result = create_hook(hook); !result) {
+        return result;
+    }
+    
+    util::TraceScope trace("enable_hook", "hooks", std::format("0x{:X}", hook.address()));
+    if (MH_EnableHook(reinterpret_cast<LPVOID>(hook.address())) != MH_OK) {
+        return std::unexpected(HookError::minhook_enable_failed);
+    }
+    
+    return {};
+}
+
+HookResult HookManager::install_all_batched() {
+    std::vector<Hook*> created;
+    created.reserve(hooks_.size());
+    
+    auto rollback = [&created, this]() {
+        for (auto* hook : created) {
+            remove_hook(*hook);
+        }
+        LOG_WARNING("Rolled back {} hook(s) of the failed batch", created.size());
+    };
+    
+    // Create every detour first; nothing is live until the queue is applied
+    for (auto& [address, hook] : hooks_) {
+        if (!hook->has_tasks()) {
+            continue;
+        }
+        if (auto result = create_hook(*hook); !result) {
+            LOG_ERROR("Failed to create hook at 0x{:X}", address);
+            remove_hook(*hook);  // Its stub may exist without a detour
+            rollback();
+            return result;
+        }
+        created.push_back(hook.get());
+    }
+    
+    for (auto* hook : created) {
+        if (MH_QueueEnableHook(reinterpret_cast<LPVOID>(hook->address())) != MH_OK) {
+            LOG_ERROR("Failed to queue hook at 0x{:X}", hook->address());
+            rollback();
+            return std::unexpected(HookError::minhook_enable_failed);
+        }
+    }
     
-    if (MH_EnableHook(address_ptr) != MH_OK) {
-        g_hook_map.erase(reinterpret_cast<std::uintptr_t>(handler));
+    // A single thread freeze for the whole batch
+    util::TraceScope trace("apply_queued_hooks", "hooks", std::to_string(created.size()) + " hook(s)");
+    if (MH_ApplyQueued() != MH_OK) {
+        LOG_ERROR("Failed to apply {} queued hook(s)", created.size());
+        rollback();
         return std::unexpected(HookError::minhook_enable_failed);
     }
     
+    LOG_INFO("Enabled {} hook(s) in a single batch", created.size());
     return {};
 }
 
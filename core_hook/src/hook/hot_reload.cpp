@@ -0,0 +1,271 @@
+#include "../../include/hook/hot_reload.hpp"
+#include "../../include/config/config_factory.hpp"
+#include "../../include/context/mod_context.hpp"
+#include "../../include/util/logger.hpp"
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+namespace app_hook::hook {
+
+namespace {
+
+/// @brief Get a path in the form compared by hot reload
+std::string comparable(const std::filesystem::path& path) {
+    auto text = path.generic_string();
+    std::ranges::transform(text, text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+/// @brief Check if a normalized path lies inside a normalized directory
+bool under_directory(const std::filesystem::path& path, const std::filesystem::path& directory) {
+    auto prefix = comparable(directory);
+    if (!prefix.empty() && prefix.back() != '/') {
+        prefix += '/';
+    }
+    return comparable(path).starts_with(prefix);
+}
+
+} // namespace
+
+std::filesystem::path normalize_watch_path(const std::filesystem::path& path) {
+    std::error_code error;
+    auto absolute = std::filesystem::absolute(path, error);
+    return (error ? path : absolute).lexically_normal();
+}
+
+bool same_watch_path(const std::filesystem::path& a, const std::filesystem::path& b) {
+    return comparable(a) == comparable(b);
+}
+
+HotReloader::HotReloader(std::filesystem::path tasks_path)
+    : tasks_path_(normalize_watch_path(tasks_path)), config_dir_(tasks_path_.parent_path()) {}
+
+HotReloader::~HotReloader() {
+    stop();
+}
+
+void HotReloader::track_task(const config::TaskInfo& task, const std::string& key,
+                             const std::filesystem::path& config_file, std::vector<std::string> followers) {
+    std::lock_guard lock(mutex_);
+    tasks_.push_back(TrackedTask{task, key, normalize_watch_path(config_file), std::move(followers), {}});
+}
+
+void HotReloader::track_config(const std::string& task_key, config::ConfigPtr config, task::IHookTask* hook_task) {
+    std::lock_guard lock(mutex_);
+    auto* task = find_task(task_key);
+    if (!task || !config) {
+        LOG_WARNING("Hot reload cannot track config of unknown task '{}'", task_key);
+        return;
+    }
+    if (!hook_task) {
+        LOG_WARNING("Hot reload cannot track config '{}' of task '{}' without its task", config->key(), task_key);
+        return;
+    }
+    task->configs.push_back(TrackedConfig{std::move(config), hook_task});
+}
+
+ReloadReport HotReloader::reload_file(const std::filesystem::path& path) {
+    std::lock_guard lock(mutex_);
+    // Tasks read context values the hooks may replace meanwhile
+    const auto guard = context::ModContext::instance().read_guard();
+    ReloadReport report;
+    report.file = normalize_watch_path(path);
+
+    if (same_watch_path(report.file, tasks_path_)) {
+        report.matched = true;
+        ++report.restart_required;
+        LOG_WARNING("Task list '{}' changed: restart to apply it", report.file.string());
+        return report;
+    }
+
+    std::vector<std::string> stale;
+    for (auto& task : tasks_) {
+        if (same_watch_path(task.config_file, report.file)) {
+            report.matched = true;
+            reload_config_file(task, report, stale);
+        }
+    }
+
+    // Binaries and other files read by the tasks themselves
+    for (auto& task : tasks_) {
+        for (auto& tracked : task.configs) {
+            const auto files = watched_files(tracked);
+            const bool watches = std::ranges::any_of(files, [&](const std::string& file) {
+                return same_watch_path(normalize_watch_path(file), report.file);
+            });
+            if (!watches) {
+                continue;
+            }
+
+            report.matched = true;
+            record_outcome(tracked.task->refresh_file(report.file.string()), task, report, stale);
+        }
+    }
+
+    if (!report.matched) {
+        return report;
+    }
+
+    rerun(std::move(stale), report);
+    LOG_INFO("Hot reload of '{}': {} updated, {} unchanged, {} re-run, {} need a restart{}",
+             report.file.string(), report.updated, report.unchanged, report.rerun, report.restart_required,
+             report.parse_failed ? " (parse failed)" : "");
+    return report;
+}
+
+void HotReloader::reload_config_file(TrackedTask& task, ReloadReport& report, std::vector<std::string>& stale) {
+    // The cache would hand back the configs parsed at install time
+    auto configs = config::ConfigFactory::load_configs(task.info.type, task.config_file.string(), task.info.name);
+    if (!configs) {
+        report.parse_failed = true;
+        LOG_ERROR("Hot reload cannot parse '{}' for task '{}'; the applied configs are kept",
+                  task.config_file.string(), task.key);
+        return;
+    }
+
+    std::vector<bool> matched(configs->size(), false);
+    for (auto& tracked : task.configs) {
+        const auto it = std::ranges::find_if(*configs, [&](const config::ConfigPtr& config) {
+            return config && config->key() == tracked.config->key();
+        });
+        if (it == configs->end()) {
+            ++report.restart_required;
+            LOG_WARNING("Config '{}' was removed from '{}': restart to drop it",
+                        tracked.config->key(), task.config_file.string());
+            continue;
+        }
+        matched[static_cast<std::size_t>(it - configs->begin())] = true;
+
+        const auto outcome = tracked.task->reload(**it);
+        if (outcome != task::ReloadOutcome::restart_required) {
+            tracked.config = *it;
+        }
+        record_outcome(outcome, task, report, stale);
+    }
+
+    for (std::size_t i = 0; i < configs->size(); ++i) {
+        if (!matched[i] && (*configs)[i]) {
+            ++report.restart_required;
+            LOG_WARNING("Config '{}' was added to '{}': restart to apply it",
+                        (*configs)[i]->key(), task.config_file.string());
+        }
+    }
+}
+
+void HotReloader::record_outcome(task::ReloadOutcome outcome, const TrackedTask& task, ReloadReport& report,
+                                 std::vector<std::string>& stale) {
+    switch (outcome) {
+        case task::ReloadOutcome::unchanged:
+            ++report.unchanged;
+            break;
+        case task::ReloadOutcome::updated:
+            ++report.updated;
+            break;
+        case task::ReloadOutcome::dependents_stale:
+            ++report.updated;
+            stale.insert(stale.end(), task.followers.begin(), task.followers.end());
+            break;
+        case task::ReloadOutcome::restart_required:
+            ++report.restart_required;
+            LOG_WARNING("Task '{}' cannot apply the change in place: restart to apply it", task.key);
+            break;
+    }
+}
+
+void HotReloader::rerun(std::vector<std::string> stale, ReloadReport& report) {
+    // Everything downstream of a stale task read what it produced
+    std::unordered_set<std::string> pending;
+    while (!stale.empty()) {
+        auto key = std::move(stale.back());
+        stale.pop_back();
+        if (!pending.insert(key).second) {
+            continue;
+        }
+        if (const auto* task = find_task(key)) {
+            stale.insert(stale.end(), task->followers.begin(), task->followers.end());
+        }
+    }
+
+    for (const auto& task : tasks_) {
+        if (!pending.contains(task.key)) {
+            continue;
+        }
+        for (const auto& tracked : task.configs) {
+            if (tracked.task->execute()) {
+                ++report.rerun;
+            } else {
+                ++report.restart_required;
+                LOG_ERROR("Hot reload failed to run '{}' of task '{}' again", tracked.config->key(), task.key);
+            }
+        }
+    }
+}
+
+std::vector<std::string> HotReloader::watched_files(const TrackedConfig& tracked) {
+    return tracked.task->watched_files();
+}
+
+HotReloader::TrackedTask* HotReloader::find_task(const std::string& key) {
+    const auto it = std::ranges::find(tasks_, key, &TrackedTask::key);
+    return it == tasks_.end() ? nullptr : &*it;
+}
+
+bool HotReloader::start() {
+    std::lock_guard lock(mutex_);
+    if (watcher_) {
+        return false;
+    }
+
+    watcher_ = std::make_unique<util::FileWatcher>([this](const std::filesystem::path& path) {
+        (void)reload_file(path);
+    });
+
+    // Config files live under the config directory; mod binaries usually do not
+    bool watching = watcher_->add_directory(config_dir_, true);
+    auto watch_parent = [&](const std::filesystem::path& file) {
+        if (!under_directory(file, config_dir_)) {
+            watching = watcher_->add_directory(file.parent_path(), false) || watching;
+        }
+    };
+    for (const auto& task : tasks_) {
+        watch_parent(task.config_file);
+        for (const auto& tracked : task.configs) {
+            for (const auto& file : watched_files(tracked)) {
+                watch_parent(normalize_watch_path(file));
+            }
+        }
+    }
+
+    if (!watching || !watcher_->start()) {
+        LOG_WARNING("Hot reload is disabled: nothing under '{}' can be watched", config_dir_.string());
+        watcher_.reset();
+        return false;
+    }
+
+    LOG_INFO("Hot reload watching {} directorie(s) for {} task(s)", watcher_->directory_count(), tasks_.size());
+    return true;
+}
+
+void HotReloader::stop() {
+    // Not under mutex_: a reload in progress holds it until the watcher exits
+    if (watcher_) {
+        watcher_->stop();
+    }
+}
+
+std::size_t HotReloader::task_count() const {
+    std::lock_guard lock(mutex_);
+    return tasks_.size();
+}
+
+std::size_t HotReloader::config_count() const {
+    std::lock_guard lock(mutex_);
+    std::size_t count = 0;
+    for (const auto& task : tasks_) {
+        count += task.configs.size();
+    }
+    return count;
+}
+
+} // namespace app_hook::hook
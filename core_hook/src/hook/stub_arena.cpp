@@ -0,0 +1,113 @@
+#include "../../include/hook/stub_arena.hpp"
+#include "../../include/util/logger.hpp"
+#include <algorithm>
+
+namespace app_hook::hook {
+
+void* StubArena::allocate(std::size_t size) {
+    if (size == 0 || size > kSlotSize) {
+        return nullptr;
+    }
+    
+    if (!free_slots_.empty()) {
+        void* slot = free_slots_.back();
+        free_slots_.pop_back();
+        peak_slots_ = std::max(peak_slots_, ++live_slots_);
+        return slot;
+    }
+    
+    if (chunks_.empty() || chunks_.back().used + kSlotSize > kChunkSize) {
+        if (!add_chunk()) {
+            return nullptr;
+        }
+    }
+    
+    auto& chunk = chunks_.back();
+    if (!commit_to(chunk, chunk.used + kSlotSize)) {
+        return nullptr;
+    }
+    
+    void* slot = chunk.base + chunk.used;
+    chunk.used += kSlotSize;
+    peak_slots_ = std::max(peak_slots_, ++live_slots_);
+    return slot;
+}
+
+void StubArena::deallocate(void* slot) {
+    if (!slot) {
+        return;
+    }
+    free_slots_.push_back(slot);
+    --live_slots_;
+}
+
+void StubArena::begin_write() {
+    writing_ = true;
+    protect_all(PAGE_EXECUTE_READWRITE);
+}
+
+void StubArena::end_write() {
+    writing_ = false;
+    protect_all(PAGE_EXECUTE_READ);
+    for (const auto& chunk : chunks_) {
+        FlushInstructionCache(GetCurrentProcess(), chunk.base, chunk.committed);
+    }
+}
+
+void StubArena::release() {
+    for (const auto& chunk : chunks_) {
+        VirtualFree(chunk.base, 0, MEM_RELEASE);
+    }
+    chunks_.clear();
+    free_slots_.clear();
+    live_slots_ = 0;
+    writing_ = false;
+}
+
+std::size_t StubArena::committed_bytes() const noexcept {
+    std::size_t total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk.committed;
+    }
+    return total;
+}
+
+bool StubArena::add_chunk() {
+    void* base = VirtualAlloc(nullptr, kChunkSize, MEM_RESERVE, PAGE_NOACCESS);
+    if (!base) {
+        LOG_ERROR("Failed to reserve {} bytes for hook stubs, error: {}", kChunkSize, GetLastError());
+        return false;
+    }
+    chunks_.push_back(Chunk{static_cast<std::uint8_t*>(base), 0, 0});
+    return true;
+}
+
+bool StubArena::commit_to(Chunk& chunk, std::size_t end) {
+    if (end <= chunk.committed) {
+        return true;
+    }
+    
+    // New pages join the arena with the protection the arena is currently using
+    const DWORD protection = writing_ ? PAGE_EXECUTE_READWRITE : PAGE_EXECUTE_READ;
+    void* page = VirtualAlloc(chunk.base + chunk.committed, kPageSize, MEM_COMMIT, protection);
+    if (!page) {
+        LOG_ERROR("Failed to commit hook stub page, error: {}", GetLastError());
+        return false;
+    }
+    chunk.committed += kPageSize;
+    return true;
+}
+
+void StubArena::protect_all(DWORD protection) {
+    for (const auto& chunk : chunks_) {
+        if (chunk.committed == 0) {
+            continue;
+        }
+        DWORD old_protection = 0;
+        if (!VirtualProtect(chunk.base, chunk.committed, protection, &old_protection)) {
+            LOG_ERROR("Failed to change hook stub protection, error: {}", GetLastError());
+        }
+    }
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,278 @@
+#include "../../include/hook/trigger_trace.hpp"
+#include "../../include/hook/hook_manager.hpp"
+#include "../../include/hook/hook_stats.hpp"
+#include "../../include/util/logger.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <thread>
+#include <unordered_map>
+
+namespace app_hook::hook {
+
+namespace {
+
+/// @brief Identifies a trigger trace ("AHTR")
+constexpr std::uint32_t kTraceMagic = 0x52544841;
+
+/// @brief Layout version of trace files
+constexpr std::uint16_t kTraceVersion = 1;
+
+/// @brief Header at the start of a trace file
+struct TraceFileHeader {
+    std::uint32_t magic = kTraceMagic;
+    std::uint16_t version = kTraceVersion;
+    std::uint16_t reserved = 0;
+    std::uint64_t frequency = 0;
+    std::uint32_t hook_count = 0;
+    std::uint32_t reserved2 = 0;
+    std::uint64_t record_count = 0;
+    std::uint64_t dropped = 0;
+};
+
+static_assert(sizeof(TraceFileHeader) == 40, "the header is written as-is");
+
+/// @brief Performance counter frequency
+std::uint64_t counter_frequency() noexcept {
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return static_cast<std::uint64_t>(frequency.QuadPart);
+}
+
+// Outcome the replay tasks of the current thread act out, and whether any ran
+thread_local std::uint32_t t_replay_outcome = 0;
+thread_local bool t_replay_ran = false;
+
+/// @brief Stand-in for a recorded task: writes scratch memory, fails when the recorded task did
+class ReplayTask final : public task::IHookTask {
+public:
+    ReplayTask(std::span<std::uint8_t> scratch, std::uint32_t outcome_bit) noexcept
+        : scratch_(scratch), outcome_bit_(outcome_bit) {}
+
+    [[nodiscard]] task::TaskResult execute() override {
+        t_replay_ran = true;
+        std::memset(scratch_.data(), static_cast<int>(++runs_), scratch_.size());
+        if (t_replay_outcome & outcome_bit_) {
+            return std::unexpected(task::TaskError::unknown_error);
+        }
+        return {};
+    }
+
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+
+    [[nodiscard]] std::string name() const override { return "Replay"; }
+    [[nodiscard]] std::string description() const override { return "Replay a recorded task"; }
+
+private:
+    std::span<std::uint8_t> scratch_;
+    std::uint32_t outcome_bit_;
+    std::uint8_t runs_ = 0;
+};
+
+} // namespace
+
+std::expected<TriggerTrace, TraceError> TriggerTrace::read(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::unexpected(TraceError::file_not_found);
+    }
+
+    TraceFileHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return std::unexpected(TraceError::truncated);
+    }
+    if (header.magic != kTraceMagic || header.version != kTraceVersion) {
+        return std::unexpected(TraceError::bad_magic);
+    }
+
+    // Check the counts against the file before allocating for them
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    const auto expected = sizeof(header) + std::uint64_t{header.hook_count} * sizeof(TraceHook) +
+                          header.record_count * sizeof(TriggerRecord);
+    if (ec || header.record_count > size / sizeof(TriggerRecord) || size < expected) {
+        return std::unexpected(TraceError::truncated);
+    }
+
+    TriggerTrace trace;
+    trace.frequency = header.frequency;
+    trace.dropped = header.dropped;
+    trace.hooks.resize(header.hook_count);
+    trace.records.resize(static_cast<std::size_t>(header.record_count));
+    file.read(reinterpret_cast<char*>(trace.hooks.data()), trace.hooks.size() * sizeof(TraceHook));
+    file.read(reinterpret_cast<char*>(trace.records.data()), trace.records.size() * sizeof(TriggerRecord));
+    if (!file) {
+        return std::unexpected(TraceError::truncated);
+    }
+    return trace;
+}
+
+std::expected<void, TraceError> TriggerTrace::write(const std::filesystem::path& path) const {
+    std::error_code ec;
+    if (path.has_parent_path()) {
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    TraceFileHeader header;
+    header.frequency = frequency;
+    header.hook_count = static_cast<std::uint32_t>(hooks.size());
+    header.record_count = records.size();
+    header.dropped = dropped;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(hooks.data()), hooks.size() * sizeof(TraceHook));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(TriggerRecord));
+    if (!file) {
+        return std::unexpected(TraceError::write_failed);
+    }
+    return {};
+}
+
+std::vector<std::uint32_t> TriggerTrace::threads() const {
+    std::vector<std::uint32_t> result;
+    for (const auto& record : records) {
+        if (std::ranges::find(result, record.thread_id) == result.end()) {
+            result.push_back(record.thread_id);
+        }
+    }
+    return result;
+}
+
+bool TriggerRecorder::start(std::size_t capacity) {
+    if (recording() || capacity == 0) {
+        return false;
+    }
+    buffer_.reset(new (std::nothrow) TriggerRecord[capacity]);
+    if (!buffer_) {
+        LOG_ERROR("Cannot allocate a trigger trace buffer of {} record(s)", capacity);
+        return false;
+    }
+    capacity_ = capacity;
+    next_.store(0, std::memory_order_relaxed);
+    dropped_.store(0, std::memory_order_relaxed);
+    origin_ = read_timestamp();
+    recording_.store(true, std::memory_order_release);
+    LOG_INFO("Recording hook triggers ({} record(s) max)", capacity);
+    return true;
+}
+
+void TriggerRecorder::record(std::uintptr_t address, std::uint64_t start, std::uint64_t duration,
+                             std::uint32_t outcome) noexcept {
+    const auto slot = next_.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= capacity_) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer_[slot] = {start - origin_, static_cast<std::uint32_t>(address), GetCurrentThreadId(),
+                     static_cast<std::uint32_t>(std::min<std::uint64_t>(duration, std::numeric_limits<std::uint32_t>::max())), outcome};
+}
+
+TriggerTrace TriggerRecorder::stop(std::vector<TraceHook> hooks) {
+    TriggerTrace trace;
+    trace.frequency = counter_frequency();
+    trace.hooks = std::move(hooks);
+    if (!recording_.exchange(false, std::memory_order_acq_rel)) {
+        return trace;
+    }
+
+    const auto count = std::min(next_.load(std::memory_order_acquire), capacity_);
+    trace.records.assign(buffer_.get(), buffer_.get() + count);
+    trace.dropped = dropped_.load(std::memory_order_relaxed);
+    std::ranges::stable_sort(trace.records, {}, &TriggerRecord::time);
+
+    // The buffer stays allocated: a hooked call already past recording() may still write its slot
+    return trace;
+}
+
+TraceReplayer::TraceReplayer(const TriggerTrace& trace, ReplayOptions options)
+    : trace_(trace), options_(options), manager_(std::make_unique<HookManager>()) {
+    options_.scratch_bytes = std::max<std::size_t>(options_.scratch_bytes, 1);
+    scratch_ = std::make_unique<std::uint8_t[]>(trace.hooks.size() * options_.scratch_bytes);
+
+    for (std::size_t i = 0; i < trace.hooks.size(); ++i) {
+        const auto& recorded = trace.hooks[i];
+        const std::span scratch(scratch_.get() + i * options_.scratch_bytes, options_.scratch_bytes);
+        for (std::uint16_t task = 0; task < recorded.tasks; ++task) {
+            (void)manager_->add_task_to_hook(recorded.address, std::make_unique<ReplayTask>(scratch, task_outcome_bit(task)));
+        }
+        if (auto* hook = manager_->get_hook(recorded.address)) {
+            hook->set_policy(recorded.policy, recorded.period);
+            hook->set_trampoline(scratch.data());
+        }
+    }
+}
+
+TraceReplayer::~TraceReplayer() = default;
+
+ReplayResult TraceReplayer::run() {
+    // Resolve the hooks once, and split the triggers by recorded thread
+    const auto threads = trace_.threads();
+    std::unordered_map<std::uint32_t, Hook*> hooks;
+    for (const auto& recorded : trace_.hooks) {
+        hooks.emplace(recorded.address, manager_->get_hook(recorded.address));
+    }
+    std::vector<std::vector<const TriggerRecord*>> per_thread(threads.size());
+    for (const auto& record : trace_.records) {
+        const auto index = std::ranges::find(threads, record.thread_id) - threads.begin();
+        per_thread[static_cast<std::size_t>(index)].push_back(&record);
+    }
+
+    std::atomic<std::uint64_t> triggers{0};
+    std::atomic<std::uint64_t> mismatches{0};
+    const double ticks_per_second = trace_.frequency ? static_cast<double>(trace_.frequency) : 1e9;
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> replay_threads;
+        replay_threads.reserve(per_thread.size());
+        for (const auto& records : per_thread) {
+            replay_threads.emplace_back([&, start] {
+                std::uint64_t dispatched = 0;
+                std::uint64_t differing = 0;
+                for (const auto* record : records) {
+                    const auto it = hooks.find(record->address);
+                    if (it == hooks.end() || !it->second) {
+                        continue;
+                    }
+                    if (options_.speed > 0.0) {
+                        const auto offset = std::chrono::duration<double>(
+                            static_cast<double>(record->time) / ticks_per_second / options_.speed);
+                        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(offset));
+                    }
+                    t_replay_outcome = record->outcome;
+                    t_replay_ran = false;
+                    (void)dispatch_hook(it->second);
+                    ++dispatched;
+
+                    // Policy changes show up as triggers skipped or run unlike the recording
+                    const bool skipped = (record->outcome & kTriggerSkipped) != 0;
+                    if (it->second->task_count() != 0 && skipped == t_replay_ran) {
+                        ++differing;
+                    }
+                }
+                triggers.fetch_add(dispatched, std::memory_order_relaxed);
+                mismatches.fetch_add(differing, std::memory_order_relaxed);
+            });
+        }
+    }
+
+    ReplayResult result;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.threads = per_thread.size();
+    result.triggers = triggers.load(std::memory_order_relaxed);
+    result.mismatches = mismatches.load(std::memory_order_relaxed);
+    return result;
+}
+
+void TraceReplayer::reset() {
+    for (const auto& recorded : trace_.hooks) {
+        if (auto* hook = manager_->get_hook(recorded.address)) {
+            hook->set_policy(recorded.policy, recorded.period);
+        }
+    }
+    manager_->reset_stats();
+}
+
+} // namespace app_hook::hook
@@ -1,15 +1,35 @@
 #include "plugin/plugin_manager.hpp"
 #include "config/config_factory.hpp"
+#include "config/task_loader.hpp"
 #include "task/task_factory.hpp"
 #include "context/mod_context.hpp"
 #include "util/logger.hpp"
+#include "util/startup_trace.hpp"
 #include <filesystem>
 #include <algorithm>
 
 namespace app_hook::plugin {
 
 // PluginHost implementation
-PluginHost::PluginHost() = default;
+PluginHost::PluginHost() {
+    sync_log_level();
+    
+    // The context is shared by every plugin, so the host reports it
+    memory_accounting_.add_source("mod_context", [] {
+        const auto& context = ::app_hook::context::ModContext::instance();
+        std::vector<::app_hook::util::MemoryUsage> usage{{"context.table", 0, context.table_bytes()}};
+        for (const auto& type : context.usage_by_type()) {
+            usage.front().count += type.count;
+            usage.push_back({std::string("context.") + type.type->name(), type.count, type.bytes});
+        }
+        return usage;
+    });
+}
+
+void PluginHost::sync_log_level() {
+    // spdlog levels use the same numbering as the plugin API (trace=0 ... off=6)
+    set_min_log_level(static_cast<int>(spdlog::default_logger_raw()->level()));
+}
 
 void PluginHost::set_config_registry(std::function<void(std::unique_ptr<::app_hook::config::ConfigBase>)> callback) {
     config_registry_ = std::move(callback);
@@ -19,6 +39,10 @@ void PluginHost::set_data_path(const std::string& path) {
     data_path_ = path;
 }
 
+void PluginHost::set_hook_stats_provider(std::function<std::vector<::app_hook::hook::HookStats>()> provider) {
+    hook_stats_provider_ = std::move(provider);
+}
+
 PluginResult PluginHost::register_config(std::unique_ptr<::app_hook::config::ConfigBase> config) {
     if (!config_registry_) {
         LOG_ERROR("Config registry callback not set");
@@ -111,6 +135,72 @@ std::pair<void*, std::uint32_t> PluginHost::get_process_info() const {
     return ::app_hook::context::ModContext::instance();
 }
 
+std::vector<::app_hook::hook::HookStats> PluginHost::get_hook_stats() const {
+    if (!hook_stats_provider_) {
+        return {};
+    }
+    return hook_stats_provider_();
+}
+
+void PluginHost::register_memory_source(const std::string& name, ::app_hook::util::MemorySource source) {
+    memory_accounting_.add_source(name, std::move(source));
+}
+
+void PluginHost::unregister_memory_source(const std::string& name) {
+    memory_accounting_.remove_source(name);
+}
+
+::app_hook::util::MemoryReport PluginHost::get_memory_report() const {
+    return memory_accounting_.report();
+}
+
+void PluginHost::set_bundle(std::shared_ptr<const ::app_hook::config::ModBundle> bundle) {
+    bundle_ = std::move(bundle);
+}
+
+std::span<const std::uint8_t> PluginHost::bundle_blob(const std::string& path) {
+    return bundle_ ? bundle_->blob(path) : std::span<const std::uint8_t>{};
+}
+
+void PluginHost::set_signature_cache_dir(const std::filesystem::path& config_dir) {
+    signature_cache_dir_ = config_dir;
+}
+
+std::vector<std::uintptr_t> PluginHost::resolve_signatures(const std::vector<std::string>& patterns) {
+    // Loaders parse files in parallel; the first one to need a signature maps the executable
+    std::call_once(signature_resolver_once_, [this] {
+        if (auto image = util::main_module_image()) {
+            const auto cache = signature_cache_dir_.empty() ? std::filesystem::path{}
+                                                            : signature_cache_dir_ / util::SignatureResolver::kFileName;
+            signature_resolver_ = std::make_unique<util::SignatureResolver>(*image, cache);
+        } else {
+            LOG_ERROR("Cannot read the executable's headers: signatures will not resolve");
+        }
+    });
+    if (!signature_resolver_) {
+        return std::vector<std::uintptr_t>(patterns.size(), 0);
+    }
+    return signature_resolver_->resolve(patterns);
+}
+
+std::uintptr_t PluginHost::resolve_symbol(const std::string& symbol) {
+    // The executable's stamp picks one map for the whole session
+    std::call_once(address_map_once_, [this] {
+        const auto image = util::main_module_image();
+        if (!image || signature_cache_dir_.empty()) {
+            return;
+        }
+        address_map_ = config::AddressMap::select(signature_cache_dir_ / config::AddressMap::kDirectory, image->stamp);
+        if (address_map_) {
+            LOG_INFO("Using address map '{}' ({} symbol(s)) for this build", address_map_->build(), address_map_->size());
+        } else {
+            LOG_INFO("No address map for this build (timestamp 0x{:08X}, checksum 0x{:08X}): addresses come from "
+                     "signatures", image->stamp.timestamp, image->stamp.checksum);
+        }
+    });
+    return address_map_ ? address_map_->find(symbol) : 0;
+}
+
 // PluginManager implementation
 PluginManager::PluginManager() 
     : host_(std::make_unique<PluginHost>()), initialized_(false) {
@@ -131,12 +221,29 @@ PluginResult PluginManager::initialize(
     
     host_->set_data_path(data_path);
     host_->set_config_registry(std::move(config_registry));
+    host_->sync_log_level();
     initialized_ = true;
     
     LOG_INFO("Plugin manager initialized with data path: {}", data_path);
     return PluginResult::Success;
 }
 
+void PluginManager::set_hook_stats_provider(std::function<std::vector<::app_hook::hook::HookStats>()> provider) {
+    host_->set_hook_stats_provider(std::move(provider));
+}
+
+void PluginManager::add_memory_source(const std::string& name, ::app_hook::util::MemorySource source) {
+    host_->register_memory_source(name, std::move(source));
+}
+
+::app_hook::util::MemoryReport PluginManager::memory_report() const {
+    return host_->get_memory_report();
+}
+
+void PluginManager::set_bundle(std::shared_ptr<const ::app_hook::config::ModBundle> bundle) {
+    host_->set_bundle(std::move(bundle));
+}
+
 PluginResult PluginManager::load_plugin(const std::string& plugin_path) {
     if (!initialized_) {
         LOG_ERROR("Plugin manager not initialized");
@@ -144,6 +251,7 @@ PluginResult PluginManager::load_plugin(const std::string& plugin_path) {
     }
     
     LOG_INFO("Loading plugin from: {}", plugin_path);
+    util::TraceScope trace("load_plugin", "plugins", plugin_path);
     
     try {
         LOG_DEBUG("About to call load_plugin_dll for: {}", plugin_path);
@@ -195,7 +303,75 @@ PluginResult PluginManager::load_plugin(const std::string& plugin_path) {
     }
 }
 
+PluginResult PluginManager::add_builtin_plugin(std::unique_ptr<IPlugin> plugin) {
+    if (!initialized_) {
+        LOG_ERROR("Plugin manager not initialized");
+        return PluginResult::Failed;
+    }
+    if (!plugin) {
+        return PluginResult::Failed;
+    }
+
+    auto info = plugin->get_plugin_info();
+    if (plugins_.contains(info.name)) {
+        LOG_WARN("Plugin '{}' is already loaded", info.name);
+        return PluginResult::AlreadyLoaded;
+    }
+    if (!validate_plugin_version(plugin.get())) {
+        LOG_ERROR("Plugin '{}' has incompatible API version", info.name);
+        return PluginResult::InvalidVersion;
+    }
+
+    LOG_INFO("Added built-in plugin: {} v{} ({})", info.name, info.version, info.description);
+    auto name = info.name;
+    plugins_[name] = std::make_unique<PluginInstance>(nullptr, std::move(plugin), std::move(info), "<built-in>");
+    return PluginResult::Success;
+}
+
 std::size_t PluginManager::load_plugins_from_directory(const std::string& plugin_directory) {
+    return load_plugins_matching(plugin_directory, [](const std::filesystem::path&) { return true; });
+}
+
+std::size_t PluginManager::load_plugins_for_tasks(const std::string& plugin_directory,
+                                                  const std::string& tasks_path) {
+    auto tasks = config::TaskLoader::load_tasks(tasks_path);
+    if (!tasks) {
+        LOG_WARN("Cannot read {}, loading every plugin", tasks_path);
+        return load_plugins_from_directory(plugin_directory);
+    }
+    
+    std::vector<config::ConfigType> needed;
+    for (const auto& task : *tasks) {
+        if (std::ranges::find(needed, task.type) == needed.end()) {
+            needed.push_back(task.type);
+        }
+    }
+    
+    skipped_plugins_.clear();
+    return load_plugins_matching(plugin_directory, [&](const std::filesystem::path& dll_path) {
+        auto manifest = load_plugin_manifest(dll_path);
+        if (!manifest) {
+            if (manifest.error() != config::ConfigError::file_not_found) {
+                LOG_WARN("Invalid manifest for {}, loading it anyway", dll_path.string());
+            }
+            return true;
+        }
+        if (manifest->provides_any(needed)) {
+            return true;
+        }
+        LOG_INFO("Skipping plugin {}: no enabled task uses its config types", dll_path.filename().string());
+        skipped_plugins_.push_back(std::move(*manifest));
+        return false;
+    });
+}
+
+std::span<const PluginManifest> PluginManager::skipped_plugins() const noexcept {
+    return skipped_plugins_;
+}
+
+std::size_t PluginManager::load_plugins_matching(
+    const std::string& plugin_directory,
+    const std::function<bool(const std::filesystem::path&)>& should_load) {
     if (!initialized_) {
         LOG_ERROR("Plugin manager not initialized");
         return 0;
@@ -218,6 +394,10 @@ std::size_t PluginManager::load_plugins_from_directory(const std::string& plugin
             LOG_DEBUG("Found directory entry: {}", entry.path().string());
             
             if (entry.is_regular_file() && entry.path().extension() == ".dll") {
+                if (!should_load(entry.path())) {
+                    continue;
+                }
+                
                 const auto plugin_path = entry.path().string();
                 LOG_DEBUG("Found plugin DLL: {}", plugin_path);
                 
@@ -254,6 +434,7 @@ std::size_t PluginManager::load_plugins_from_directory(const std::string& plugin
 
 PluginResult PluginManager::initialize_plugins(const std::string& config_path) {
     LOG_INFO("Initializing {} loaded plugin(s)", plugins_.size());
+    host_->set_signature_cache_dir(config_path);
     
     for (auto& [name, instance] : plugins_) {
         if (instance->initialized) {
@@ -263,13 +444,17 @@ PluginResult PluginManager::initialize_plugins(const std::string& config_path) {
         LOG_DEBUG("Initializing plugin: {}", name);
         
         // Initialize plugin
-        auto result = instance->plugin->initialize(host_.get());
+        auto result = [&] {
+            util::TraceScope trace("initialize_plugin", "plugins", name);
+            return instance->plugin->initialize(host_.get());
+        }();
         if (result != PluginResult::Success) {
             LOG_ERROR("Failed to initialize plugin '{}': {}", name, to_string(result));
             continue;
         }
         
         // Load configurations
+        util::TraceScope trace("load_plugin_configurations", "plugins", name);
         result = instance->plugin->load_configurations(config_path);
         if (result != PluginResult::Success) {
             LOG_ERROR("Failed to load configurations for plugin '{}': {}", name, to_string(result));
@@ -301,7 +486,9 @@ PluginResult PluginManager::unload_plugin(const std::string& plugin_name) {
         instance->plugin->shutdown();
     }
     
-    FreeLibrary(instance->module_handle);
+    if (instance->module_handle) {
+        FreeLibrary(instance->module_handle);
+    }
     plugins_.erase(it);
     
     LOG_INFO("Successfully unloaded plugin: {}", plugin_name);
@@ -316,7 +503,9 @@ void PluginManager::unload_all_plugins() {
         if (instance->initialized) {
             instance->plugin->shutdown();
         }
-        FreeLibrary(instance->module_handle);
+        if (instance->module_handle) {
+            FreeLibrary(instance->module_handle);
+        }
     }
     
     plugins_.clear();
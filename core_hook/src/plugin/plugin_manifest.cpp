@@ -0,0 +1,72 @@
+#include "plugin/plugin_manifest.hpp"
+#include "util/logger.hpp"
+#include <toml++/toml.h>
+#include <algorithm>
+
+namespace app_hook::plugin {
+
+bool PluginManifest::provides(config::ConfigType type) const noexcept {
+    return std::ranges::find(config_types, type) != config_types.end();
+}
+
+bool PluginManifest::provides_any(std::span<const config::ConfigType> types) const noexcept {
+    return std::ranges::any_of(types, [this](config::ConfigType type) { return provides(type); });
+}
+
+std::filesystem::path manifest_path_for(const std::filesystem::path& dll_path) {
+    auto path = dll_path;
+    path.replace_extension(".plugin.toml");
+    return path;
+}
+
+config::ConfigResult<PluginManifest> load_plugin_manifest(const std::filesystem::path& dll_path) {
+    const auto manifest_path = manifest_path_for(dll_path);
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(manifest_path, error)) {
+        return std::unexpected(config::ConfigError::file_not_found);
+    }
+
+    try {
+        auto toml = toml::parse_file(manifest_path.string());
+        const auto* section = toml["plugin"].as_table();
+        if (!section) {
+            LOG_ERROR("Plugin manifest '{}' has no [plugin] table", manifest_path.string());
+            return std::unexpected(config::ConfigError::invalid_format);
+        }
+
+        PluginManifest manifest;
+        manifest.dll_path = dll_path;
+        manifest.name = (*section)["name"].value_or(dll_path.stem().string());
+
+        const auto* types = (*section)["config_types"].as_array();
+        if (!types) {
+            LOG_ERROR("Plugin manifest '{}' is missing config_types", manifest_path.string());
+            return std::unexpected(config::ConfigError::missing_required_field);
+        }
+        for (const auto& node : *types) {
+            const auto name = node.value<std::string>();
+            const auto type = name ? config::from_string(*name) : config::ConfigType::Unknown;
+            if (type == config::ConfigType::Unknown) {
+                LOG_ERROR("Plugin manifest '{}' lists an unknown config type", manifest_path.string());
+                return std::unexpected(config::ConfigError::invalid_format);
+            }
+            manifest.config_types.push_back(type);
+        }
+
+        if (const auto* creators = (*section)["task_creators"].as_array()) {
+            for (const auto& node : *creators) {
+                if (auto id = node.value<std::string>()) {
+                    manifest.task_creators.push_back(std::move(*id));
+                }
+            }
+        }
+        return manifest;
+    }
+    catch (const toml::parse_error& e) {
+        LOG_ERROR("TOML parse error in plugin manifest '{}': {} at line {}, column {}", manifest_path.string(),
+                  e.description(), e.source().begin.line, e.source().begin.column);
+        return std::unexpected(config::ConfigError::parse_error);
+    }
+}
+
+} // namespace app_hook::plugin
@@ -8,15 +8,12 @@ namespace app_hook::task {
 
 TaskFactory& TaskFactory::instance() {
     static TaskFactory instance;
-    LOG_DEBUG("TaskFactory::instance() returning singleton at address: 0x{:X}", reinterpret_cast<uintptr_t>(&instance));
     return instance;
 }
 
 
 
 bool TaskFactory::register_task_creator(const std::string& config_type_name, TaskCreatorFunc creator) {
-    LOG_DEBUG("TaskFactory::register_task_creator called on instance at address: 0x{:X}", reinterpret_cast<uintptr_t>(this));
-    
     if (config_type_name.empty() || !creator) {
         LOG_ERROR("Cannot register task creator: invalid config type name or creator function");
         return false;
@@ -27,55 +24,76 @@ bool TaskFactory::register_task_creator(const std::string& config_type_name, Tas
     }
 
     creators_[config_type_name] = std::move(creator);
+    legacy_creators_.clear();
     LOG_INFO("Registered task creator for config type: {}", config_type_name);
     LOG_DEBUG("TaskFactory now has {} total creators", creators_.size());
     return true;
 }
 
 HookTaskPtr TaskFactory::create_task(const config::ConfigBase& config) {
-    const std::string config_type = typeid(config).name();
-    
-    LOG_DEBUG("TaskFactory::create_task called on instance at address: 0x{:X}", reinterpret_cast<uintptr_t>(this));
-    LOG_DEBUG("TaskFactory::create_task called for config type: {}", config_type);
-    LOG_DEBUG("TaskFactory has {} registered creators", creators_.size());
-    
-    // Log all registered creators for debugging
-    if (creators_.empty()) {
-        LOG_WARNING("TaskFactory has no registered creators!");
-    } else {
-        LOG_DEBUG("Registered creators:");
-        for (const auto& [registered_type, _] : creators_) {
-            LOG_DEBUG("  - {}", registered_type);
+    // Classes linked into the host share the address of their type ID with the creator
+    if (const auto& builtin = builtin_creators_[config::to_index(config.type())];
+        builtin.create && config.type_id().data() == builtin.type_id) {
+        return builtin.create(config, builtin.host);
+    }
+
+    const TaskCreatorFunc* creator = nullptr;
+    if (const auto type_id = config.type_id(); !type_id.empty()) {
+        if (auto it = creators_.find(type_id); it != creators_.end()) {
+            creator = &it->second;
         }
+    } else {
+        creator = resolve_legacy(config);
     }
-    
-    // Try to find a creator by exact type name first
-    auto it = creators_.find(config_type);
-    if (it != creators_.end()) {
-        LOG_DEBUG("Creating task using exact type match for: {}", config_type);
-        return it->second(config);
+
+    if (!creator) {
+        LOG_WARNING("No task creator found for config type: {} (key: {})", 
+                    config.type_id().empty() ? std::string_view{typeid(config).name()} : config.type_id(), config.key());
+        return nullptr;
+    }
+
+    auto task = (*creator)(config);
+    if (!task) {
+        LOG_WARNING("Task creator returned nullptr for config '{}'", config.key());
+    }
+    return task;
+}
+
+void TaskFactory::note_builtin_creator(std::string_view type_id) {
+    LOG_INFO("Registered built-in task creator for config type: {}", type_id);
+}
+
+const TaskCreatorFunc* TaskFactory::resolve_legacy(const config::ConfigBase& config) {
+    const std::type_index type(typeid(config));
+    if (auto it = legacy_creators_.find(type); it != legacy_creators_.end()) {
+        return it->second;
     }
-    LOG_DEBUG("No exact match found for: {}", config_type);
-
-    // Try to find a creator by simplified type name (without namespace/decorations)
-    for (const auto& [registered_type, creator] : creators_) {
-        LOG_DEBUG("Checking partial match: '{}' contains '{}'?", config_type, registered_type);
-        if (config_type.find(registered_type) != std::string::npos) {
-            LOG_DEBUG("Creating task using partial type match '{}' for: {}", registered_type, config_type);
-            auto task = creator(config);
-            if (!task) {
-                LOG_WARNING("Task creator returned nullptr for type: {}", registered_type);
+
+    // RTTI names carry compiler decorations ("class app_hook::..."), so fall back
+    // to a substring match; done once per type, then served from the cache
+    const std::string config_type = typeid(config).name();
+    const TaskCreatorFunc* creator = nullptr;
+    if (auto it = creators_.find(config_type); it != creators_.end()) {
+        creator = &it->second;
+    } else {
+        for (const auto& [registered_type, candidate] : creators_) {
+            if (config_type.find(registered_type) != std::string::npos) {
+                LOG_DEBUG("Matched config type '{}' to task creator '{}'", config_type, registered_type);
+                creator = &candidate;
+                break;
             }
-            return task;
         }
     }
 
-    LOG_WARNING("No task creator found for config type: {} (key: {})", config_type, config.key());
-    return nullptr;
+    legacy_creators_.emplace(type, creator);
+    return creator;
 }
 
 bool TaskFactory::has_creator(const std::string& config_type_name) const {
-    return creators_.find(config_type_name) != creators_.end();
+    return creators_.contains(config_type_name) ||
+           std::ranges::any_of(builtin_creators_, [&](const BuiltinEntry& entry) {
+               return entry.create && config_type_name == entry.type_id;
+           });
 }
 
 std::vector<std::string> TaskFactory::get_registered_types() const {
@@ -85,6 +103,11 @@ std::vector<std::string> TaskFactory::get_registered_types() const {
     for (const auto& [type_name, _] : creators_) {
         types.push_back(type_name);
     }
+    for (const auto& entry : builtin_creators_) {
+        if (entry.create && !creators_.contains(entry.type_id)) {
+            types.emplace_back(entry.type_id);
+        }
+    }
     
     std::sort(types.begin(), types.end());
     return types;
@@ -93,6 +116,8 @@ std::vector<std::string> TaskFactory::get_registered_types() const {
 void TaskFactory::clear_creators() {
     LOG_INFO("Clearing all registered task creators");
     creators_.clear();
+    legacy_creators_.clear();
+    builtin_creators_ = {};
 }
 
 } // namespace app_hook::task 
\ No newline at end of file
@@ -0,0 +1,248 @@
+#include "../../include/util/async_log_sink.hpp"
+#include "../../include/util/background_thread.hpp"
+#include <bit>
+#include <cstring>
+
+namespace app_hook::util {
+
+AsyncLogSink::AsyncLogSink(std::string logger_name,
+                           std::vector<spdlog::sink_ptr> sinks,
+                           std::size_t capacity,
+                           LogOverflowPolicy policy,
+                           std::chrono::milliseconds flush_interval)
+    : sinks_(std::move(sinks)),
+      mask_(std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1),
+      policy_(policy),
+      flush_interval_(flush_interval),
+      logger_name_(std::move(logger_name)) {
+    cells_ = std::make_unique<Cell[]>(mask_ + 1);
+    for (std::size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+AsyncLogSink::~AsyncLogSink() {
+    stop();
+}
+
+void AsyncLogSink::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    writer_ = std::thread([this] { run(); });
+}
+
+void AsyncLogSink::stop() {
+    if (abandoned_.load(std::memory_order_acquire)) {
+        (void)abandon();
+        return;
+    }
+    if (running_.exchange(false)) {
+        wake_writer();
+        join_background_thread(writer_);
+    }
+    drain();
+}
+
+std::size_t AsyncLogSink::drain() {
+    std::lock_guard lock(consumer_mutex_);
+    std::size_t written = 0;
+    while (try_pop_and_write()) {
+        ++written;
+    }
+    flush_sinks();
+    return written;
+}
+
+std::size_t AsyncLogSink::abandon() {
+    // The writer cannot be joined: the process exit stopped it
+    abandoned_.store(true, std::memory_order_release);
+    running_.store(false, std::memory_order_release);
+    if (writer_.joinable()) {
+        writer_.detach();
+    }
+    
+    std::unique_lock lock(consumer_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return 0;
+    }
+    std::size_t written = 0;
+    while (try_pop_and_write()) {
+        ++written;
+    }
+    flush_sinks();
+    return written;
+}
+
+void AsyncLogSink::log(const spdlog::details::log_msg& msg) {
+    if (try_push(msg)) {
+        return;
+    }
+    
+    if (policy_ == LogOverflowPolicy::drop) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    while (!try_push(msg)) {
+        std::this_thread::yield();
+    }
+}
+
+void AsyncLogSink::flush() {
+    // Called by spdlog from the logging thread; the writer does the I/O
+    flush_requested_.store(true, std::memory_order_relaxed);
+}
+
+void AsyncLogSink::set_pattern(const std::string& pattern) {
+    for (auto& sink : sinks_) {
+        sink->set_pattern(pattern);
+    }
+}
+
+void AsyncLogSink::set_formatter(std::unique_ptr<spdlog::formatter> sink_formatter) {
+    for (auto& sink : sinks_) {
+        sink->set_formatter(sink_formatter->clone());
+    }
+}
+
+bool AsyncLogSink::try_push(const spdlog::details::log_msg& msg) {
+    Cell* cell = nullptr;
+    auto pos = enqueue_pos_.load(std::memory_order_relaxed);
+    
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    
+    auto& record = cell->record;
+    record.time = msg.time;
+    record.source = msg.source;
+    record.level = msg.level;
+    record.thread_id = msg.thread_id;
+    record.length = msg.payload.size();
+    if (record.length <= kInlinePayload) {
+        std::memcpy(record.inline_payload.data(), msg.payload.data(), record.length);
+    } else {
+        record.long_payload.assign(msg.payload.data(), msg.payload.size());
+    }
+    
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    
+    // Pairs with the fence in wait_for_records: either the writer sees this
+    // record, or this producer sees the writer idle and wakes it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writer_idle_.load(std::memory_order_relaxed) && writer_idle_.exchange(false, std::memory_order_relaxed)) {
+        wake_writer();
+    }
+    return true;
+}
+
+bool AsyncLogSink::try_pop_and_write() {
+    Cell* cell = nullptr;
+    auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    
+    for (;;) {
+        cell = &cells_[pos & mask_];
+        const auto sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Empty
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+    
+    const auto& record = cell->record;
+    const spdlog::string_view_t payload = record.length <= kInlinePayload
+        ? spdlog::string_view_t(record.inline_payload.data(), record.length)
+        : spdlog::string_view_t(record.long_payload.data(), record.long_payload.size());
+    
+    spdlog::details::log_msg msg(record.time, record.source, logger_name_, record.level, payload);
+    msg.thread_id = record.thread_id;
+    
+    for (auto& sink : sinks_) {
+        if (sink->should_log(msg.level)) {
+            sink->log(msg);
+        }
+    }
+    if (record.level >= spdlog::level::err) {
+        flush_requested_.store(true, std::memory_order_relaxed);
+    }
+    
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogSink::run() {
+    auto last_flush = std::chrono::steady_clock::now();
+    bool dirty = false;
+    
+    while (running_.load(std::memory_order_acquire)) {
+        std::size_t written = 0;
+        {
+            std::lock_guard lock(consumer_mutex_);
+            while (written < mask_ + 1 && try_pop_and_write()) {
+                ++written;
+            }
+            dirty = dirty || written > 0;
+            
+            // Nothing is waiting to be batched with the last records once the ring is empty
+            const auto now = std::chrono::steady_clock::now();
+            if (dirty && (flush_requested_.exchange(false, std::memory_order_relaxed) || written == 0 ||
+                          now - last_flush >= flush_interval_)) {
+                flush_sinks();
+                last_flush = now;
+                dirty = false;
+            }
+        }
+        
+        if (written == 0) {
+            wait_for_records();
+        }
+    }
+}
+
+void AsyncLogSink::wait_for_records() {
+    const auto epoch = wake_.load(std::memory_order_acquire);
+    writer_idle_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (empty() && running_.load(std::memory_order_acquire)) {
+        wake_.wait(epoch, std::memory_order_acquire);
+    }
+    writer_idle_.store(false, std::memory_order_relaxed);
+}
+
+void AsyncLogSink::wake_writer() {
+    wake_.fetch_add(1, std::memory_order_release);
+    wake_.notify_one();
+}
+
+bool AsyncLogSink::empty() const noexcept {
+    // A sequence past pos + 1 means a drain() moved dequeue_pos_ on: look again
+    const auto pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const auto sequence = cells_[pos & mask_].sequence.load(std::memory_order_acquire);
+    return static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos + 1) < 0;
+}
+
+void AsyncLogSink::flush_sinks() {
+    for (auto& sink : sinks_) {
+        sink->flush();
+    }
+}
+
+} // namespace app_hook::util
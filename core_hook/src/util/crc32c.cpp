@@ -0,0 +1,120 @@
+#include "../../include/util/crc32c.hpp"
+#include <array>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define APP_HOOK_CRC_TARGET
+#else
+#include <cpuid.h>
+#define APP_HOOK_CRC_TARGET __attribute__((target("sse4.2")))
+#endif
+#define APP_HOOK_CRC_SSE42 1
+#endif
+
+namespace app_hook::util {
+
+namespace {
+
+/// @brief Reflected Castagnoli polynomial
+constexpr std::uint32_t kPolynomial = 0x82F63B78;
+
+/// @brief Slicing-by-8 tables: table k advances a byte through k further zero bytes
+constexpr auto kTables = [] {
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (kPolynomial & (0u - (crc & 1)));
+        }
+        tables[0][i] = crc;
+    }
+    for (std::size_t k = 1; k < tables.size(); ++k) {
+        for (std::size_t i = 0; i < 256; ++i) {
+            const auto previous = tables[k - 1][i];
+            tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}();
+
+std::uint32_t update_portable(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept {
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint32_t low;
+        std::uint32_t high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + 4, 4);
+        low ^= crc;
+        crc = kTables[7][low & 0xFF] ^ kTables[6][(low >> 8) & 0xFF] ^
+              kTables[5][(low >> 16) & 0xFF] ^ kTables[4][low >> 24] ^
+              kTables[3][high & 0xFF] ^ kTables[2][(high >> 8) & 0xFF] ^
+              kTables[1][(high >> 16) & 0xFF] ^ kTables[0][high >> 24];
+    }
+    for (; size > 0; ++data, --size) {
+        crc = kTables[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef APP_HOOK_CRC_SSE42
+bool has_sse42() noexcept {
+#ifdef _MSC_VER
+    int registers[4] = {};
+    __cpuid(registers, 1);
+    return (registers[2] & (1 << 20)) != 0;
+#else
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2) != 0;
+#endif
+}
+
+APP_HOOK_CRC_TARGET
+std::uint32_t update_sse42(const std::uint8_t* data, std::size_t size, std::uint32_t crc) noexcept {
+#if defined(_M_X64) || defined(__x86_64__)
+    std::uint64_t wide = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        wide = _mm_crc32_u64(wide, word);
+    }
+    crc = static_cast<std::uint32_t>(wide);
+#endif
+    for (; size >= 4; data += 4, size -= 4) {
+        std::uint32_t word;
+        std::memcpy(&word, data, 4);
+        crc = _mm_crc32_u32(crc, word);
+    }
+    for (; size > 0; ++data, --size) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+#endif
+
+} // namespace
+
+std::uint32_t crc32c(std::span<const std::uint8_t> bytes, std::uint32_t crc) noexcept {
+#ifdef APP_HOOK_CRC_SSE42
+    if (crc32c_accelerated()) {
+        return ~update_sse42(bytes.data(), bytes.size(), ~crc);
+    }
+#endif
+    return ~update_portable(bytes.data(), bytes.size(), ~crc);
+}
+
+std::uint32_t crc32c_portable(std::span<const std::uint8_t> bytes, std::uint32_t crc) noexcept {
+    return ~update_portable(bytes.data(), bytes.size(), ~crc);
+}
+
+bool crc32c_accelerated() noexcept {
+#ifdef APP_HOOK_CRC_SSE42
+    static const bool accelerated = has_sse42();
+    return accelerated;
+#else
+    return false;
+#endif
+}
+
+} // namespace app_hook::util
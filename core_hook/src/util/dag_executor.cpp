@@ -0,0 +1,189 @@
+#include "../../include/util/dag_executor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace app_hook::util {
+
+namespace {
+
+/// @brief Ready nodes of one thread: the owner works at the back, thieves at the front
+struct ReadyQueue {
+    std::mutex mutex;
+    std::deque<DagExecutor::NodeId> nodes;
+};
+
+} // namespace
+
+DagExecutor::NodeId DagExecutor::add(std::string name, Work work) {
+    nodes_.push_back(Node{std::move(name), std::move(work), {}, 0});
+    return static_cast<NodeId>(nodes_.size() - 1);
+}
+
+void DagExecutor::add_edge(NodeId parent, NodeId follower) {
+    if (parent >= nodes_.size() || follower >= nodes_.size() || parent == follower) {
+        return;
+    }
+    nodes_[parent].followers.push_back(follower);
+    ++nodes_[follower].parent_count;
+}
+
+std::vector<DagRun> DagExecutor::run(std::size_t thread_count) {
+    const auto count = nodes_.size();
+    std::vector<DagRun> runs(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        runs[i].name = nodes_[i].name;
+    }
+    if (count == 0) {
+        return runs;
+    }
+
+    // Kahn pass: nodes never reaching zero parents are in (or behind) a cycle
+    std::vector<std::uint32_t> waiting(count);
+    std::vector<NodeId> roots;
+    std::vector<NodeId> sorted;
+    sorted.reserve(count);
+    for (NodeId id = 0; id < count; ++id) {
+        waiting[id] = nodes_[id].parent_count;
+        if (waiting[id] == 0) {
+            roots.push_back(id);
+            sorted.push_back(id);
+        }
+    }
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        for (const auto follower : nodes_[sorted[i]].followers) {
+            if (--waiting[follower] == 0) {
+                sorted.push_back(follower);
+            }
+        }
+    }
+    if (sorted.size() != count) {
+        std::vector<bool> reachable(count, false);
+        for (const auto id : sorted) {
+            reachable[id] = true;
+        }
+        for (NodeId id = 0; id < count; ++id) {
+            if (!reachable[id]) {
+                runs[id].skipped = true;
+                runs[id].result = std::unexpected(task::TaskError::dependency_not_met);
+            }
+        }
+    }
+    if (sorted.empty()) {
+        return runs;
+    }
+
+    if (thread_count == 0) {
+        thread_count = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    thread_count = std::min(thread_count, sorted.size());
+
+    auto pending = std::make_unique<std::atomic<std::uint32_t>[]>(count);
+    auto blocked = std::make_unique<std::atomic<bool>[]>(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        pending[i].store(nodes_[i].parent_count, std::memory_order_relaxed);
+        blocked[i].store(false, std::memory_order_relaxed);
+    }
+
+    std::vector<std::unique_ptr<ReadyQueue>> queues;
+    queues.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        queues.push_back(std::make_unique<ReadyQueue>());
+    }
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+        queues[i % thread_count]->nodes.push_back(roots[i]);
+    }
+
+    std::atomic<std::size_t> remaining{sorted.size()};
+    // Bumped whenever a node becomes ready or the run ends, to wake idle threads
+    std::atomic<std::uint32_t> epoch{0};
+
+    auto take = [&](std::size_t self) -> std::optional<NodeId> {
+        {
+            auto& own = *queues[self];
+            std::lock_guard lock(own.mutex);
+            if (!own.nodes.empty()) {
+                const auto id = own.nodes.back();
+                own.nodes.pop_back();
+                return id;
+            }
+        }
+        for (std::size_t step = 1; step < thread_count; ++step) {
+            auto& victim = *queues[(self + step) % thread_count];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.nodes.empty()) {
+                const auto id = victim.nodes.front();
+                victim.nodes.pop_front();
+                return id;
+            }
+        }
+        return std::nullopt;
+    };
+
+    auto process = [&](std::size_t self, NodeId id) {
+        auto& node = nodes_[id];
+        auto& run = runs[id];
+        if (blocked[id].load(std::memory_order_acquire)) {
+            run.skipped = true;
+            run.result = std::unexpected(task::TaskError::dependency_not_met);
+        } else {
+            const auto start = std::chrono::steady_clock::now();
+            try {
+                run.result = node.work ? node.work() : task::TaskResult{};
+            } catch (...) {
+                run.result = std::unexpected(task::TaskError::unknown_error);
+            }
+            run.elapsed = std::chrono::steady_clock::now() - start;
+        }
+
+        const bool succeeded = !run.skipped && run.result.has_value();
+        bool released = false;
+        for (const auto follower : node.followers) {
+            if (!succeeded) {
+                blocked[follower].store(true, std::memory_order_release);
+            }
+            if (pending[follower].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                auto& own = *queues[self];
+                std::lock_guard lock(own.mutex);
+                own.nodes.push_back(follower);
+                released = true;
+            }
+        }
+        if (released) {
+            epoch.fetch_add(1, std::memory_order_release);
+            epoch.notify_all();
+        }
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            epoch.fetch_add(1, std::memory_order_release);
+            epoch.notify_all();
+        }
+    };
+
+    auto work = [&](std::size_t self) {
+        while (remaining.load(std::memory_order_acquire) != 0) {
+            // Read the epoch before looking: a node released after the look bumps it
+            const auto seen = epoch.load(std::memory_order_acquire);
+            if (const auto id = take(self)) {
+                process(self, *id);
+            } else if (remaining.load(std::memory_order_acquire) != 0) {
+                epoch.wait(seen, std::memory_order_acquire);
+            }
+        }
+    };
+
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count - 1);
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            threads.emplace_back(work, i);
+        }
+        work(0);
+    }
+    return runs;
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,213 @@
+#include "../../include/util/file_watcher.hpp"
+#include "../../include/util/background_thread.hpp"
+#include "../../include/util/logger.hpp"
+#include <windows.h>
+#include <algorithm>
+
+namespace app_hook::util {
+
+void ChangeDebouncer::touch(const std::filesystem::path& path, Clock::time_point now) {
+    pending_[path] = now;
+}
+
+std::vector<std::filesystem::path> ChangeDebouncer::take_due(Clock::time_point now) {
+    std::vector<std::filesystem::path> due;
+    for (auto it = pending_.begin(); it != pending_.end();) {
+        if (now - it->second >= delay_) {
+            due.push_back(it->first);
+            it = pending_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return due;
+}
+
+std::chrono::milliseconds ChangeDebouncer::time_to_next(Clock::time_point now) const {
+    auto next = std::chrono::milliseconds::max();
+    for (const auto& [path, changed] : pending_) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - changed);
+        next = std::min(next, std::max(delay_ - elapsed, std::chrono::milliseconds{0}));
+    }
+    return next;
+}
+
+/// @brief Directory handle with its pending change read
+struct FileWatcher::Watch {
+    std::filesystem::path directory;
+    bool recursive = false;
+    HANDLE handle = INVALID_HANDLE_VALUE;
+    HANDLE event = nullptr;
+    OVERLAPPED overlapped{};
+    alignas(DWORD) std::byte buffer[16 * 1024];
+
+    ~Watch() {
+        if (handle != INVALID_HANDLE_VALUE) {
+            CancelIoEx(handle, &overlapped);
+            CloseHandle(handle);
+        }
+        if (event) {
+            CloseHandle(event);
+        }
+    }
+};
+
+FileWatcher::FileWatcher(Callback callback, std::chrono::milliseconds debounce)
+    : callback_(std::move(callback)), debouncer_(debounce) {}
+
+FileWatcher::~FileWatcher() {
+    stop();
+    watches_.clear();
+    if (stop_event_) {
+        CloseHandle(stop_event_);
+    }
+}
+
+bool FileWatcher::add_directory(const std::filesystem::path& directory, bool recursive) {
+    if (running()) {
+        return false;
+    }
+
+    std::error_code error;
+    auto normalized = std::filesystem::absolute(directory, error).lexically_normal();
+    if (error || !std::filesystem::is_directory(normalized, error)) {
+        LOG_WARNING("Cannot watch '{}': not a directory", directory.string());
+        return false;
+    }
+    for (const auto& watch : watches_) {
+        if (watch->directory == normalized) {
+            watch->recursive = watch->recursive || recursive;
+            return true;
+        }
+    }
+
+    // MAXIMUM_WAIT_OBJECTS includes the stop event
+    if (watches_.size() + 1 >= MAXIMUM_WAIT_OBJECTS) {
+        LOG_WARNING("Cannot watch '{}': too many watched directories", normalized.string());
+        return false;
+    }
+
+    auto watch = std::make_unique<Watch>();
+    watch->directory = std::move(normalized);
+    watch->recursive = recursive;
+    watch->handle = CreateFileW(watch->directory.wstring().c_str(), FILE_LIST_DIRECTORY,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (watch->handle == INVALID_HANDLE_VALUE) {
+        LOG_WARNING("Cannot watch '{}': error {}", watch->directory.string(), GetLastError());
+        return false;
+    }
+    watch->event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+    if (!watch->event) {
+        return false;
+    }
+    watch->overlapped.hEvent = watch->event;
+
+    LOG_DEBUG("Watching '{}'{}", watch->directory.string(), recursive ? " and its subdirectories" : "");
+    watches_.push_back(std::move(watch));
+    return true;
+}
+
+bool FileWatcher::start() {
+    if (watches_.empty() || running()) {
+        return false;
+    }
+    if (!stop_event_) {
+        stop_event_ = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+        if (!stop_event_) {
+            return false;
+        }
+    }
+    for (auto& watch : watches_) {
+        if (!arm(*watch)) {
+            LOG_WARNING("Cannot read changes of '{}': error {}", watch->directory.string(), GetLastError());
+            return false;
+        }
+    }
+
+    ResetEvent(stop_event_);
+    running_.store(true, std::memory_order_release);
+    thread_ = std::thread([this] { run(); });
+    return true;
+}
+
+void FileWatcher::stop() {
+    // The thread may have left its loop on its own after a failed read
+    if (!thread_.joinable()) {
+        return;
+    }
+    running_.store(false, std::memory_order_release);
+    SetEvent(stop_event_);
+    join_background_thread(thread_);
+}
+
+bool FileWatcher::arm(Watch& watch) {
+    constexpr DWORD kFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+    ResetEvent(watch.event);
+    return ReadDirectoryChangesW(watch.handle, watch.buffer, sizeof(watch.buffer), watch.recursive ? TRUE : FALSE,
+                                 kFilter, nullptr, &watch.overlapped, nullptr) != FALSE;
+}
+
+void FileWatcher::collect(Watch& watch, unsigned long bytes) {
+    const auto now = ChangeDebouncer::Clock::now();
+    if (bytes == 0) {
+        // The buffer overflowed: the changes are lost, not worth a full rescan
+        LOG_WARNING("Change notifications of '{}' overflowed", watch.directory.string());
+        return;
+    }
+
+    const auto* entry_bytes = watch.buffer;
+    for (;;) {
+        const auto* entry = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(entry_bytes);
+        if (entry->Action == FILE_ACTION_ADDED || entry->Action == FILE_ACTION_MODIFIED ||
+            entry->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+            const std::wstring name(entry->FileName, entry->FileNameLength / sizeof(WCHAR));
+            debouncer_.touch((watch.directory / name).lexically_normal(), now);
+        }
+        if (entry->NextEntryOffset == 0) {
+            break;
+        }
+        entry_bytes += entry->NextEntryOffset;
+    }
+}
+
+void FileWatcher::run() {
+    std::vector<HANDLE> handles{stop_event_};
+    for (const auto& watch : watches_) {
+        handles.push_back(watch->event);
+    }
+
+    for (;;) {
+        const auto wait = debouncer_.time_to_next(ChangeDebouncer::Clock::now());
+        const DWORD timeout = wait == std::chrono::milliseconds::max() ? INFINITE : static_cast<DWORD>(wait.count());
+        const DWORD result = WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, timeout);
+        if (result == WAIT_OBJECT_0 || result == WAIT_FAILED) {
+            break;
+        }
+
+        if (result > WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + handles.size()) {
+            auto& watch = *watches_[result - WAIT_OBJECT_0 - 1];
+            DWORD bytes = 0;
+            if (GetOverlappedResult(watch.handle, &watch.overlapped, &bytes, FALSE)) {
+                collect(watch, bytes);
+            }
+            if (!arm(watch)) {
+                LOG_WARNING("Stopped watching '{}': error {}", watch.directory.string(), GetLastError());
+                break;
+            }
+        }
+
+        for (const auto& path : debouncer_.take_due(ChangeDebouncer::Clock::now())) {
+            try {
+                callback_(path);
+            }
+            catch (const std::exception& e) {
+                LOG_ERROR("File change handler failed for '{}': {}", path.string(), e.what());
+            }
+        }
+    }
+
+    running_.store(false, std::memory_order_release);
+}
+
+} // namespace app_hook::util
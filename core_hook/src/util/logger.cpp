@@ -7,7 +7,7 @@
 
 namespace app_hook::util {
 
-bool initialize_logging(const std::string& log_file_path, int level) {
+bool initialize_logging(const std::string& log_file_path, int level, const LoggingOptions& options) {
     try {
         // Create directory if it doesn't exist
         const auto log_path = std::filesystem::path(log_file_path);
@@ -39,10 +39,21 @@ bool initialize_logging(const std::string& log_file_path, int level) {
         file_sink->set_level(spdlog_level);
         console_sink->set_level(spdlog_level);
         
-        // Create logger with both sinks
-        auto logger = std::make_shared<spdlog::logger>("app_hook", spdlog::sinks_init_list{file_sink, console_sink});
-        logger->set_level(spdlog_level);
-        logger->flush_on(spdlog::level::debug); // Auto-flush on debug level and above
+        std::shared_ptr<spdlog::logger> logger;
+        if (options.async) {
+            // Callers only pay for a queue push; the writer thread batches file and console I/O
+            auto async_sink = std::make_shared<AsyncLogSink>("app_hook",
+                std::vector<spdlog::sink_ptr>{file_sink, console_sink},
+                options.queue_capacity, options.overflow, options.flush_interval);
+            async_sink->start();
+            logger = std::make_shared<spdlog::logger>("app_hook", async_sink);
+            logger->set_level(spdlog_level);
+        } else {
+            // Create logger with both sinks
+            logger = std::make_shared<spdlog::logger>("app_hook", spdlog::sinks_init_list{file_sink, console_sink});
+            logger->set_level(spdlog_level);
+            logger->flush_on(spdlog::level::debug); // Auto-flush on debug level and above
+        }
         
         // Set as default logger
         spdlog::set_default_logger(logger);
@@ -50,7 +61,8 @@ bool initialize_logging(const std::string& log_file_path, int level) {
         // Set global log level as well (just to be sure)
         spdlog::set_level(spdlog_level);
         
-        SPDLOG_INFO("FF8 Hook logging system initialized with level: {}", spdlog::level::to_string_view(spdlog_level));
+        SPDLOG_INFO("FF8 Hook logging system initialized with level: {} ({})", 
+                    spdlog::level::to_string_view(spdlog_level), options.async ? "async" : "sync");
         SPDLOG_DEBUG("Debug logging test - this should appear if debug level is active");
         return true;
         
@@ -64,4 +76,18 @@ void shutdown_logging() {
     spdlog::shutdown();
 }
 
+void flush_logging_at_exit() {
+    const auto logger = spdlog::default_logger();
+    if (!logger) {
+        return;
+    }
+    for (const auto& sink : logger->sinks()) {
+        if (const auto async = std::dynamic_pointer_cast<AsyncLogSink>(sink)) {
+            (void)async->abandon();
+        } else {
+            sink->flush();
+        }
+    }
+}
+
 } // namespace app_hook::util 
\ No newline at end of file
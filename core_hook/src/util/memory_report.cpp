@@ -0,0 +1,109 @@
+#include "../../include/util/memory_report.hpp"
+#include "../../include/util/logger.hpp"
+#include <Windows.h>
+#include <algorithm>
+#include <cstdint>
+
+namespace app_hook::util {
+
+void MemoryAccounting::add_source(std::string name, MemorySource source) {
+    std::lock_guard lock(mutex_);
+    auto it = std::ranges::find(sources_, name, &std::pair<std::string, MemorySource>::first);
+    if (it != sources_.end()) {
+        it->second = std::move(source);
+        return;
+    }
+    sources_.emplace_back(std::move(name), std::move(source));
+}
+
+bool MemoryAccounting::remove_source(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    return std::erase_if(sources_, [&name](const auto& item) { return item.first == name; }) > 0;
+}
+
+std::size_t MemoryAccounting::source_count() const {
+    std::lock_guard lock(mutex_);
+    return sources_.size();
+}
+
+MemoryReport MemoryAccounting::report() const {
+    std::vector<std::pair<std::string, MemorySource>> sources;
+    {
+        std::lock_guard lock(mutex_);
+        sources = sources_;
+    }
+
+    MemoryReport report;
+    for (const auto& [name, source] : sources) {
+        if (!source) {
+            continue;
+        }
+        try {
+            auto entries = source();
+            report.entries.insert(report.entries.end(), std::make_move_iterator(entries.begin()),
+                                  std::make_move_iterator(entries.end()));
+        }
+        catch (const std::exception& e) {
+            LOG_WARNING("Memory source '{}' failed: {}", name, e.what());
+        }
+    }
+
+    {
+        std::lock_guard lock(mutex_);
+        for (auto& entry : report.entries) {
+            auto& peak = peaks_[entry.category];
+            peak = std::max({peak, entry.peak_bytes, entry.bytes});
+            entry.peak_bytes = peak;
+        }
+    }
+
+    report.address_space = query_address_space();
+    return report;
+}
+
+AddressSpaceUsage query_address_space() {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+
+    AddressSpaceUsage usage;
+    auto address = reinterpret_cast<std::uintptr_t>(info.lpMinimumApplicationAddress);
+    const auto end = reinterpret_cast<std::uintptr_t>(info.lpMaximumApplicationAddress);
+    MEMORY_BASIC_INFORMATION region{};
+    while (address < end &&
+           VirtualQuery(reinterpret_cast<LPCVOID>(address), &region, sizeof(region)) == sizeof(region)) {
+        const auto size = static_cast<std::size_t>(region.RegionSize);
+        if (size == 0) {
+            break;
+        }
+        if (region.State == MEM_FREE) {
+            usage.free_bytes += size;
+            usage.largest_free_block = std::max(usage.largest_free_block, size);
+            ++usage.free_blocks;
+        } else if (region.State == MEM_RESERVE) {
+            usage.reserved_bytes += size;
+        } else if (region.State == MEM_COMMIT) {
+            usage.committed_bytes += size;
+        }
+        address = reinterpret_cast<std::uintptr_t>(region.BaseAddress) + size;
+    }
+    return usage;
+}
+
+void log_memory_report(const MemoryReport& report) {
+    constexpr double kKiB = 1024.0;
+    LOG_INFO("Memory footprint: {:.1f} KiB in {} categor(ies)", report.total_bytes() / kKiB, report.entries.size());
+    for (const auto& entry : report.entries) {
+        LOG_INFO("  {:<32} {:>6} object(s) {:>10.1f} KiB (peak {:.1f} KiB, committed {:.1f} KiB, reserved {:.1f} KiB)",
+                 entry.category, entry.count, entry.bytes / kKiB, entry.peak_bytes / kKiB,
+                 entry.committed_bytes / kKiB, entry.reserved_bytes / kKiB);
+    }
+
+    const auto& space = report.address_space;
+    LOG_INFO("Address space: {:.1f} MiB free in {} block(s), largest {:.1f} MiB (fragmentation {:.0f}%), "
+             "{:.1f} MiB committed, {:.1f} MiB reserved",
+             space.free_bytes / (kKiB * kKiB), space.free_blocks, space.largest_free_block / (kKiB * kKiB),
+             space.fragmentation() * 100.0, space.committed_bytes / (kKiB * kKiB),
+             space.reserved_bytes / (kKiB * kKiB));
+}
+
+} // namespace app_hook::util
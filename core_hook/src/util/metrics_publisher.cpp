@@ -0,0 +1,117 @@
+#include "../../include/util/metrics_publisher.hpp"
+#include "../../include/util/background_thread.hpp"
+#include "../../include/util/logger.hpp"
+#include <algorithm>
+
+namespace app_hook::util {
+
+namespace {
+
+/// @brief Copy entries into cells, up to the cells' capacity
+/// @return Entries copied
+template<typename Cells, typename Entries>
+std::uint32_t publish_cells(Cells& cells, const Entries& entries) {
+    const auto count = std::min(cells.size(), entries.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        cells[i].store(entries[i]);
+    }
+    return static_cast<std::uint32_t>(count);
+}
+
+} // namespace
+
+MetricsPublisher::~MetricsPublisher() {
+    stop();
+    if (block_) {
+        UnmapViewOfFile(block_);
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+    }
+}
+
+bool MetricsPublisher::open(const std::string& name) {
+    if (block_) {
+        return false;
+    }
+    mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                  static_cast<DWORD>(sizeof(MetricsBlock)), name.c_str());
+    if (!mapping_) {
+        LOG_WARNING("Failed to create the metrics block {}: error {}", name, GetLastError());
+        return false;
+    }
+    block_ = static_cast<MetricsBlock*>(MapViewOfFile(mapping_, FILE_MAP_WRITE, 0, 0, sizeof(MetricsBlock)));
+    if (!block_) {
+        LOG_WARNING("Failed to map the metrics block {}: error {}", name, GetLastError());
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+        return false;
+    }
+
+    // Fresh mappings are zero-filled: every cell already reads as empty
+    block_->version = kMetricsVersion;
+    block_->size = sizeof(MetricsBlock);
+    block_->process_id = GetCurrentProcessId();
+    std::atomic_ref<std::uint32_t>(block_->magic).store(kMetricsMagic, std::memory_order_release);
+    LOG_INFO("Live metrics published as {} ({} bytes)", name, sizeof(MetricsBlock));
+    return true;
+}
+
+void MetricsPublisher::publish(const MetricsFrame& frame) {
+    if (!block_) {
+        return;
+    }
+
+    // Slots first: a reader seeing the new counts finds them filled
+    MetricsSummary summary;
+    summary.hook_count = publish_cells(block_->hooks, frame.hooks);
+    summary.task_count = publish_cells(block_->tasks, frame.tasks);
+    summary.memory_count = publish_cells(block_->memory, frame.memory);
+    summary.plugin_count = publish_cells(block_->plugins, frame.plugins);
+    summary.dropped = static_cast<std::uint32_t>(
+        frame.hooks.size() + frame.tasks.size() + frame.memory.size() + frame.plugins.size() -
+        summary.hook_count - summary.task_count - summary.memory_count - summary.plugin_count);
+    summary.published_ms = GetTickCount64();
+    summary.publishes = ++publishes_;
+    block_->summary.store(summary);
+}
+
+bool MetricsPublisher::start(Collector collector, std::chrono::milliseconds interval) {
+    if (!block_ || !collector || thread_.joinable()) {
+        return false;
+    }
+    collector_ = std::move(collector);
+    stopping_ = false;
+    thread_ = std::thread([this, interval] { run(interval); });
+    return true;
+}
+
+void MetricsPublisher::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    join_background_thread(thread_);
+}
+
+void MetricsPublisher::run(std::chrono::milliseconds interval) {
+    std::unique_lock lock(mutex_);
+    while (!stopping_) {
+        lock.unlock();
+        try {
+            MetricsFrame frame;
+            collector_(frame);
+            publish(frame);
+        } catch (const std::exception& e) {
+            LOG_WARNING("Failed to collect live metrics: {}", e.what());
+        }
+        lock.lock();
+        wake_.wait_for(lock, interval, [this] { return stopping_; });
+    }
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,54 @@
+#include "../../include/util/pe_image.hpp"
+#include <windows.h>
+#include <cstring>
+
+namespace app_hook::util {
+
+std::optional<ModuleImage> read_module_image(const void* base) noexcept {
+    if (!base) {
+        return std::nullopt;
+    }
+    const auto* bytes = static_cast<const std::uint8_t*>(base);
+    const auto* dos = reinterpret_cast<const IMAGE_DOS_HEADER*>(bytes);
+    if (dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew <= 0) {
+        return std::nullopt;
+    }
+    const auto* nt = reinterpret_cast<const IMAGE_NT_HEADERS*>(bytes + dos->e_lfanew);
+    if (nt->Signature != IMAGE_NT_SIGNATURE) {
+        return std::nullopt;
+    }
+
+    ModuleImage image;
+    image.base = reinterpret_cast<std::uintptr_t>(base);
+    image.stamp = {nt->FileHeader.TimeDateStamp, nt->OptionalHeader.CheckSum, nt->OptionalHeader.SizeOfImage};
+
+    const IMAGE_SECTION_HEADER* code = nullptr;
+    const auto* section = IMAGE_FIRST_SECTION(nt);
+    for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i, ++section) {
+        if (std::memcmp(section->Name, ".text", 6) == 0) {
+            code = section;
+            break;
+        }
+        if (!code && (section->Characteristics & IMAGE_SCN_MEM_EXECUTE)) {
+            code = section;
+        }
+    }
+    if (!code) {
+        return std::nullopt;
+    }
+
+    // Mapped sections are VirtualSize long; old linkers leave it at 0
+    const auto size = code->Misc.VirtualSize ? code->Misc.VirtualSize : code->SizeOfRawData;
+    if (code->VirtualAddress + static_cast<std::uint64_t>(size) > image.stamp.image_size) {
+        return std::nullopt;
+    }
+    image.code_begin = image.base + code->VirtualAddress;
+    image.code_size = size;
+    return image;
+}
+
+std::optional<ModuleImage> main_module_image() noexcept {
+    return read_module_image(GetModuleHandleW(nullptr));
+}
+
+} // namespace app_hook::util
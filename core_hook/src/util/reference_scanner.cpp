@@ -0,0 +1,122 @@
+#include "../../include/util/reference_scanner.hpp"
+#include <bit>
+#include <cstring>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define APP_HOOK_SCAN_SSE2 1
+#endif
+
+namespace app_hook::util {
+
+namespace {
+
+/// @brief Check the dword at a position against the range
+[[nodiscard]] bool in_range(const std::uint8_t* data, std::uint32_t begin, std::uint32_t size) noexcept {
+    std::uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value - begin < size;
+}
+
+} // namespace
+
+std::vector<std::size_t> find_references(std::span<const std::uint8_t> image, std::uint32_t begin, std::uint32_t size) {
+    std::vector<std::size_t> references;
+    if (size == 0 || image.size() < sizeof(std::uint32_t)) {
+        return references;
+    }
+    const auto* data = image.data();
+    const auto last = image.size() - sizeof(std::uint32_t);  // Last position with a whole dword
+    std::size_t next = 0;                                     // First position not hidden by a match
+
+    auto confirm = [&](std::size_t position) {
+        if (position >= next && in_range(data + position, begin, size)) {
+            references.push_back(position);
+            next = position + sizeof(std::uint32_t);
+        }
+    };
+
+    std::size_t position = 0;
+#ifdef APP_HOOK_SCAN_SSE2
+    // value - begin < size, unsigned, as a signed compare with both sides biased by 2^31
+    const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+    const __m128i low = _mm_set1_epi32(static_cast<int>(begin));
+    const __m128i limit = _mm_set1_epi32(static_cast<int>(size ^ 0x80000000u));
+    auto lanes = [&](const std::uint8_t* at) {
+        const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(at));
+        const __m128i offsets = _mm_xor_si128(_mm_sub_epi32(values, low), bias);
+        return _mm_cmplt_epi32(offsets, limit);
+    };
+
+    // The four loads at position..position+3 cover the dwords starting at the next 16 positions
+    for (; position + 19 <= image.size(); position += 16) {
+        const __m128i hits = _mm_or_si128(_mm_or_si128(lanes(data + position), lanes(data + position + 1)),
+                                          _mm_or_si128(lanes(data + position + 2), lanes(data + position + 3)));
+        if (_mm_movemask_epi8(hits) != 0) {
+            for (std::size_t i = 0; i < 16; ++i) {
+                confirm(position + i);
+            }
+        }
+    }
+#endif
+    for (; position <= last; ++position) {
+        confirm(position);
+    }
+    return references;
+}
+
+std::size_t copy_rebased(std::span<const std::uint8_t> source, std::uint8_t* destination,
+                         std::span<const MovedRange> ranges) {
+    const auto* data = source.data();
+    std::size_t moved = 0;
+    std::size_t offset = 0;
+#ifdef APP_HOOK_SCAN_SSE2
+    if (!ranges.empty()) {
+        struct Lanes {
+            __m128i low;
+            __m128i limit;
+            __m128i target;
+        };
+        std::vector<Lanes> lanes;
+        lanes.reserve(ranges.size());
+        for (const auto& range : ranges) {
+            lanes.push_back({_mm_set1_epi32(static_cast<int>(range.begin)),
+                             _mm_set1_epi32(static_cast<int>(range.size ^ 0x80000000u)),
+                             _mm_set1_epi32(static_cast<int>(range.target))});
+        }
+        // Same unsigned compare as find_references; hit lanes take offset + target
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        for (; offset + 16 <= source.size(); offset += 16) {
+            const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + offset));
+            __m128i result = values;
+            __m128i taken = _mm_setzero_si128();
+            for (const auto& range : lanes) {
+                const __m128i offsets = _mm_sub_epi32(values, range.low);
+                const __m128i hits = _mm_andnot_si128(
+                    taken, _mm_cmplt_epi32(_mm_xor_si128(offsets, bias), range.limit));
+                result = _mm_or_si128(_mm_andnot_si128(hits, result),
+                                      _mm_and_si128(hits, _mm_add_epi32(offsets, range.target)));
+                taken = _mm_or_si128(taken, hits);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), result);
+            moved += static_cast<std::size_t>(std::popcount(static_cast<unsigned>(_mm_movemask_epi8(taken)))) / 4;
+        }
+    }
+#endif
+    for (; offset + sizeof(std::uint32_t) <= source.size(); offset += sizeof(std::uint32_t)) {
+        std::uint32_t value = 0;
+        std::memcpy(&value, data + offset, sizeof(value));
+        for (const auto& range : ranges) {
+            if (value - range.begin < range.size) {
+                value = value - range.begin + range.target;
+                ++moved;
+                break;
+            }
+        }
+        std::memcpy(destination + offset, &value, sizeof(value));
+    }
+    std::memmove(destination + offset, data + offset, source.size() - offset);
+    return moved;
+}
+
+} // namespace app_hook::util
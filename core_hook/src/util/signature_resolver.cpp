@@ -0,0 +1,166 @@
+#include "../../include/util/signature_resolver.hpp"
+#include "../../include/util/byte_stream.hpp"
+#include "../../include/util/logger.hpp"
+#include "../../include/util/signature_scanner.hpp"
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+namespace app_hook::util {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x43534841;  // "AHSC"
+constexpr std::uint32_t kFormatVersion = 1;
+
+} // namespace
+
+SignatureResolver::SignatureResolver(ModuleImage image, std::filesystem::path cache_path)
+    : image_(image), path_(std::move(cache_path)) {
+    read();
+}
+
+std::vector<std::uintptr_t> SignatureResolver::resolve(std::span<const std::string> patterns) {
+    std::vector<std::uintptr_t> addresses(patterns.size(), 0);
+    std::lock_guard lock(mutex_);
+
+    // Everything the cache does not know goes into one scan
+    SignatureScanner scanner;
+    std::vector<std::size_t> scanned;
+    for (std::size_t i = 0; i < patterns.size(); ++i) {
+        if (auto it = entries_.find(patterns[i]); it != entries_.end()) {
+            addresses[i] = address_of(it->second);
+            ++hits_;
+            continue;
+        }
+        auto signature = Signature::parse(patterns[i]);
+        if (!signature) {
+            LOG_ERROR("Invalid signature pattern: '{}'", patterns[i]);
+            continue;
+        }
+        scanner.add(std::move(*signature));
+        scanned.push_back(i);
+    }
+    if (scanned.empty()) {
+        return addresses;
+    }
+
+    const auto matches = scanner.scan(image_.code());
+    ++scans_;
+    std::size_t found = 0;
+    for (std::size_t s = 0; s < scanned.size(); ++s) {
+        const auto& pattern = patterns[scanned[s]];
+        const auto& match = matches[s];
+        if (!match.unique()) {
+            if (match.count == 0) {
+                LOG_ERROR("Signature not found in module code: '{}'", pattern);
+            } else {
+                LOG_ERROR("Signature matches {} times (first at 0x{:X}), make it longer: '{}'",
+                          match.count, image_.code_begin + match.offset, pattern);
+            }
+            continue;
+        }
+
+        const auto& signature = scanner.signature(s);
+        const auto at = image_.code_begin + match.offset + signature.result_offset;
+        Entry entry;
+        if (signature.deref) {
+            std::memcpy(&entry.value, reinterpret_cast<const void*>(at), sizeof(entry.value));
+        } else {
+            entry.value = static_cast<std::uint32_t>(at - image_.base);
+            entry.relative = true;
+        }
+        addresses[scanned[s]] = address_of(entry);
+        entries_.insert_or_assign(pattern, entry);
+        ++found;
+        LOG_DEBUG("Signature '{}' resolved to 0x{:X}", pattern, addresses[scanned[s]]);
+    }
+
+    LOG_INFO("Resolved {}/{} signature(s) in one pass over {} bytes of code", found, scanned.size(), image_.code_size);
+    if (found != 0 && !path_.empty()) {
+        save_locked();
+    }
+    return addresses;
+}
+
+void SignatureResolver::read() {
+    if (path_.empty()) {
+        return;
+    }
+    std::error_code ec;
+    const auto file_size = std::filesystem::file_size(path_, ec);
+    if (ec || file_size == 0) {
+        return;
+    }
+
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(file_size));
+    {
+        std::ifstream file(path_, std::ios::binary);
+        if (!file || !file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            LOG_WARNING("Cannot read signature cache: {}", path_.string());
+            return;
+        }
+    }
+
+    ByteReader in(data);
+    std::uint32_t magic = 0;
+    std::uint32_t format = 0;
+    ModuleStamp stamp;
+    std::uint32_t count = 0;
+    if (!in.read(magic) || !in.read(format) || magic != kMagic || format != kFormatVersion) {
+        LOG_INFO("Ignoring signature cache with unknown format: {}", path_.string());
+        return;
+    }
+    if (!in.read(stamp) || !in.read(count) || !(stamp == image_.stamp)) {
+        LOG_INFO("Signature cache was built for another executable - rescanning: {}", path_.string());
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string pattern;
+        Entry entry;
+        if (!in.read_string(pattern) || !in.read(entry.value) || !in.read(entry.relative)) {
+            LOG_WARNING("Signature cache is truncated - ignoring it: {}", path_.string());
+            entries_.clear();
+            return;
+        }
+        entries_.insert_or_assign(std::move(pattern), entry);
+    }
+    LOG_DEBUG("Opened signature cache with {} entry(ies): {}", entries_.size(), path_.string());
+}
+
+bool SignatureResolver::save_locked() const {
+    ByteWriter out;
+    out.write(kMagic);
+    out.write(kFormatVersion);
+    out.write(image_.stamp);
+    out.write(static_cast<std::uint32_t>(entries_.size()));
+    for (const auto& [pattern, entry] : entries_) {
+        out.write_string(pattern);
+        out.write(entry.value);
+        out.write(entry.relative);
+    }
+
+    // Write next to the cache and swap, so a crash never leaves a torn file
+    auto temp_path = path_;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        const auto data = out.data();
+        if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            LOG_WARNING("Cannot write signature cache: {}", temp_path.string());
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path_, ec);
+    if (ec) {
+        LOG_WARNING("Failed to replace signature cache {}: {}", path_.string(), ec.message());
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,191 @@
+#include "../../include/util/signature_scanner.hpp"
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <map>
+#include <utility>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define APP_HOOK_SCAN_SSE2 1
+#endif
+
+namespace app_hook::util {
+
+namespace {
+
+/// @brief Bytes scanned per block: every anchor walks a block while it is in L1
+constexpr std::size_t kBlockSize = 16 * 1024;
+
+/// @brief Rough frequency of a byte in x86 code; lower anchors fewer false hits
+constexpr int byte_weight(std::uint8_t byte) noexcept {
+    switch (byte) {
+        case 0x00: return 10;
+        case 0xFF: return 8;
+        case 0xCC: case 0x8B: return 6;
+        case 0x89: case 0x90: case 0x24: return 5;
+        case 0xE8: case 0x0F: case 0x83: case 0x45: case 0x04: case 0x01: case 0x08: return 4;
+        case 0x85: case 0x74: case 0x75: case 0x50: case 0x56: case 0x57: case 0xC3: case 0x8D: return 3;
+        default: return 1;
+    }
+}
+
+/// @brief Pick the position of a signature's anchor
+std::size_t choose_anchor(const Signature& signature) noexcept {
+    std::size_t best = SignatureMatch::npos;
+    int best_weight = 0;
+    for (std::size_t i = 0; i + 1 < signature.size(); ++i) {
+        if (signature.mask[i] && signature.mask[i + 1]) {
+            const int weight = byte_weight(signature.bytes[i]) + byte_weight(signature.bytes[i + 1]);
+            if (best == SignatureMatch::npos || weight < best_weight) {
+                best = i;
+                best_weight = weight;
+            }
+        }
+    }
+    if (best != SignatureMatch::npos) {
+        return best;
+    }
+    // No adjacent fixed pair: the rarest single byte
+    for (std::size_t i = 0; i < signature.size(); ++i) {
+        if (signature.mask[i] && (best == SignatureMatch::npos || byte_weight(signature.bytes[i]) < best_weight)) {
+            best = i;
+            best_weight = byte_weight(signature.bytes[i]);
+        }
+    }
+    return best;
+}
+
+/// @brief Call found(position) for each anchor hit at a position in [begin, end)
+template<typename Found>
+void find_anchor(std::span<const std::uint8_t> image, std::size_t begin, std::size_t end,
+                 std::uint8_t first, std::uint8_t second, bool pair, Found&& found) {
+    const auto* data = image.data();
+    std::size_t position = begin;
+#ifdef APP_HOOK_SCAN_SSE2
+    // Pairs read one byte past the 16 compared, which must stay in the image
+    const std::size_t reach = pair ? 17 : 16;
+    const __m128i first_bytes = _mm_set1_epi8(static_cast<char>(first));
+    const __m128i second_bytes = _mm_set1_epi8(static_cast<char>(second));
+    for (; position + 16 <= end && position + reach <= image.size(); position += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        __m128i hits = _mm_cmpeq_epi8(chunk, first_bytes);
+        if (pair) {
+            const __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position + 1));
+            hits = _mm_and_si128(hits, _mm_cmpeq_epi8(next, second_bytes));
+        }
+        for (auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits)); mask != 0; mask &= mask - 1) {
+            found(position + static_cast<std::size_t>(std::countr_zero(mask)));
+        }
+    }
+#endif
+    for (; position < end; ++position) {
+        if (data[position] == first && (!pair || (position + 1 < image.size() && data[position + 1] == second))) {
+            found(position);
+        }
+    }
+}
+
+} // namespace
+
+std::optional<Signature> Signature::parse(std::string_view pattern) {
+    Signature signature;
+    bool marked = false;
+    std::size_t fixed = 0;
+
+    std::size_t position = 0;
+    while (position < pattern.size()) {
+        if (pattern[position] == ' ' || pattern[position] == '\t') {
+            ++position;
+            continue;
+        }
+        auto token_end = pattern.find_first_of(" \t", position);
+        if (token_end == std::string_view::npos) {
+            token_end = pattern.size();
+        }
+        const auto token = pattern.substr(position, token_end - position);
+        position = token_end;
+
+        if (token == "^" || token == "&") {
+            if (marked) {
+                return std::nullopt;
+            }
+            marked = true;
+            signature.deref = token == "&";
+            signature.result_offset = static_cast<std::uint32_t>(signature.size());
+        } else if (token == "?" || token == "??") {
+            signature.bytes.push_back(0);
+            signature.mask.push_back(0);
+        } else {
+            std::uint8_t byte = 0;
+            const auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), byte, 16);
+            if (token.size() != 2 || ec != std::errc{} || end != token.data() + token.size()) {
+                return std::nullopt;
+            }
+            signature.bytes.push_back(byte);
+            signature.mask.push_back(0xFF);
+            ++fixed;
+        }
+    }
+
+    // A marker names the byte after it, and "&" the dword starting there
+    const std::size_t marked_size = signature.deref ? 4 : 1;
+    if (fixed == 0 || (marked && signature.result_offset + marked_size > signature.size())) {
+        return std::nullopt;
+    }
+    return signature;
+}
+
+std::size_t SignatureScanner::add(Signature signature) {
+    anchor_offsets_.push_back(choose_anchor(signature));
+    signatures_.push_back(std::move(signature));
+    return signatures_.size() - 1;
+}
+
+std::vector<SignatureScanner::Anchor> SignatureScanner::anchors() const {
+    std::map<std::pair<int, int>, std::size_t> index;
+    std::vector<Anchor> anchors;
+    for (std::size_t i = 0; i < signatures_.size(); ++i) {
+        const auto& signature = signatures_[i];
+        const auto at = anchor_offsets_[i];
+        const bool pair = at + 1 < signature.size() && signature.mask[at + 1];
+        const std::pair<int, int> key{signature.bytes[at], pair ? signature.bytes[at + 1] : -1};
+        auto [it, inserted] = index.try_emplace(key, anchors.size());
+        if (inserted) {
+            anchors.push_back(Anchor{signature.bytes[at], pair ? signature.bytes[at + 1] : std::uint8_t{0}, pair, {}});
+        }
+        anchors[it->second].members.push_back(i);
+    }
+    return anchors;
+}
+
+std::vector<SignatureMatch> SignatureScanner::scan(std::span<const std::uint8_t> image) const {
+    std::vector<SignatureMatch> matches(signatures_.size());
+    const auto groups = anchors();
+
+    for (std::size_t block = 0; block < image.size(); block += kBlockSize) {
+        const auto block_end = std::min(block + kBlockSize, image.size());
+        for (const auto& anchor : groups) {
+            find_anchor(image, block, block_end, anchor.first, anchor.second, anchor.pair, [&](std::size_t hit) {
+                for (const auto index : anchor.members) {
+                    const auto& signature = signatures_[index];
+                    const auto at = anchor_offsets_[index];
+                    if (hit < at || hit - at + signature.size() > image.size()) {
+                        continue;
+                    }
+                    const auto start = hit - at;
+                    if (signature.matches(image.data() + start)) {
+                        auto& match = matches[index];
+                        // Blocks and hits within a block come in address order
+                        if (match.count++ == 0) {
+                            match.offset = start;
+                        }
+                    }
+                }
+            });
+        }
+    }
+    return matches;
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,127 @@
+#include "../../include/util/startup_trace.hpp"
+#include <Windows.h>
+#include <format>
+#include <fstream>
+
+namespace app_hook::util {
+
+namespace {
+
+/// @brief Append a string as a JSON string literal
+void append_json_string(std::string& out, const std::string& value) {
+    out += '"';
+    for (const char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out += std::format("\\u{:04x}", static_cast<unsigned>(c));
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+} // namespace
+
+StartupTrace& StartupTrace::instance() {
+    static StartupTrace trace;
+    return trace;
+}
+
+void StartupTrace::reset() {
+    std::lock_guard lock(mutex_);
+    origin_ = Clock::now();
+    events_.clear();
+}
+
+void StartupTrace::set_enabled(bool enabled) {
+    std::lock_guard lock(mutex_);
+    enabled_ = enabled;
+}
+
+bool StartupTrace::enabled() const {
+    std::lock_guard lock(mutex_);
+    return enabled_;
+}
+
+std::int64_t StartupTrace::now_us() const {
+    std::lock_guard lock(mutex_);
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - origin_).count();
+}
+
+void StartupTrace::record(TraceEvent event) {
+    std::lock_guard lock(mutex_);
+    if (enabled_) {
+        events_.push_back(std::move(event));
+    }
+}
+
+void StartupTrace::mark(std::string name, std::string category, std::string detail) {
+    record(TraceEvent{std::move(name), std::move(category), std::move(detail), now_us(), 0,
+                      static_cast<std::uint32_t>(GetCurrentThreadId()), true});
+}
+
+std::vector<TraceEvent> StartupTrace::events() const {
+    std::lock_guard lock(mutex_);
+    return events_;
+}
+
+std::string StartupTrace::to_chrome_trace() const {
+    const auto events = this->events();
+    const auto process_id = static_cast<std::uint32_t>(GetCurrentProcessId());
+
+    std::string out = "{\"traceEvents\":[\n";
+    for (std::size_t i = 0; i < events.size(); ++i) {
+        const auto& event = events[i];
+        out += "{\"name\":";
+        append_json_string(out, event.name);
+        out += ",\"cat\":";
+        append_json_string(out, event.category);
+        if (event.instant) {
+            out += std::format(",\"ph\":\"i\",\"s\":\"p\",\"ts\":{}", event.start_us);
+        } else {
+            out += std::format(",\"ph\":\"X\",\"ts\":{},\"dur\":{}", event.start_us, event.duration_us);
+        }
+        out += std::format(",\"pid\":{},\"tid\":{}", process_id, event.thread_id);
+        if (!event.detail.empty()) {
+            out += ",\"args\":{\"detail\":";
+            append_json_string(out, event.detail);
+            out += '}';
+        }
+        out += i + 1 < events.size() ? "},\n" : "}\n";
+    }
+    out += "],\"displayTimeUnit\":\"ms\"}\n";
+    return out;
+}
+
+bool StartupTrace::write_chrome_trace(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    const auto json = to_chrome_trace();
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    return static_cast<bool>(file);
+}
+
+TraceScope::TraceScope(std::string name, std::string category, std::string detail)
+    : name_(std::move(name))
+    , category_(std::move(category))
+    , detail_(std::move(detail))
+    , start_us_(StartupTrace::instance().now_us()) {}
+
+TraceScope::~TraceScope() {
+    auto& trace = StartupTrace::instance();
+    const auto end_us = trace.now_us();
+    trace.record(TraceEvent{std::move(name_), std::move(category_), std::move(detail_), start_us_,
+                            end_us - start_us_, static_cast<std::uint32_t>(GetCurrentThreadId())});
+}
+
+} // namespace app_hook::util
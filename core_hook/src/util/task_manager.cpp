@@ -10,6 +10,7 @@ bool TaskManager::load_from_tasks_config(const std::string& tasks_config_path) {
     
     // Clear existing tasks
     tasks_.clear();
+    dependencies_.clear();
     
     // Note: Task creation from configs is handled by specific implementations
     // This core version just validates that configs can be loaded
@@ -28,31 +29,45 @@ void TaskManager::add_task(task::HookTaskPtr task) {
     }
 }
 
+void TaskManager::add_dependency(std::size_t parent, std::size_t follower) {
+    dependencies_.emplace_back(parent, follower);
+}
+
+void TaskManager::add_dependencies(const config::TaskGraph& graph) {
+    for (config::TaskGraph::TaskId id = 0; id < graph.size(); ++id) {
+        for (const auto follower : graph.followers(id)) {
+            add_dependency(id, follower);
+        }
+    }
+}
+
 bool TaskManager::execute_all() {
     if (tasks_.empty()) {
         return true;
     }
     
-    // Execute all tasks and collect results
-    const auto results = tasks_ 
-        | std::views::transform([](const auto& task) { return task->execute(); })
-        | std::ranges::to<std::vector>();
-    
     // Check if all tasks succeeded
-    return std::ranges::all_of(results, [](const auto& result) { 
-        return result.has_value(); 
+    return std::ranges::all_of(execute_all_timed(), [](const auto& run) { 
+        return run.result.has_value(); 
     });
 }
 
 std::vector<std::pair<std::string, task::TaskResult>> TaskManager::execute_all_detailed() {
-    std::vector<std::pair<std::string, task::TaskResult>> results;
-    results.reserve(tasks_.size());
-    
+    return execute_all_timed()
+        | std::views::transform([](auto& run) { return std::pair{std::move(run.name), run.result}; })
+        | std::ranges::to<std::vector>();
+}
+
+std::vector<DagRun> TaskManager::execute_all_timed() {
+    DagExecutor executor;
     for (const auto& task : tasks_) {
-        results.emplace_back(task->name(), task->execute());
+        auto* hook_task = task.get();
+        executor.add(hook_task->name(), [hook_task] { return hook_task->execute(); });
     }
-    
-    return results;
+    for (const auto& [parent, follower] : dependencies_) {
+        executor.add_edge(static_cast<DagExecutor::NodeId>(parent), static_cast<DagExecutor::NodeId>(follower));
+    }
+    return executor.run(thread_count_);
 }
 
 std::vector<std::string> TaskManager::get_task_names() const {
@@ -63,6 +78,7 @@ std::vector<std::string> TaskManager::get_task_names() const {
 
 void TaskManager::clear() noexcept {
     tasks_.clear();
+    dependencies_.clear();
 }
 
 } // namespace app_hook::util 
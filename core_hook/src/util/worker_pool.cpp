@@ -0,0 +1,133 @@
+#include "../../include/util/worker_pool.hpp"
+#include "../../include/util/background_thread.hpp"
+#include "../../include/util/logger.hpp"
+#include <algorithm>
+#include <latch>
+
+namespace app_hook::util {
+
+WorkerPool::WorkerPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        // Hook tasks are mostly file I/O; a couple of threads is enough and
+        // leaves the cores to the game
+        thread_count = std::clamp<std::size_t>(std::thread::hardware_concurrency() / 2, 1, 4);
+    }
+    workers_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::start() {
+    std::call_once(started_, [this] {
+        for (auto& worker : workers_) {
+            worker->thread = std::thread([this, w = worker.get()] { run(*w); });
+        }
+    });
+}
+
+bool WorkerPool::submit(std::size_t affinity, Job job) {
+    if (!job || stopping_.load()) {
+        return false;
+    }
+    start();
+
+    auto& worker = *workers_[affinity % workers_.size()];
+    {
+        std::lock_guard lock(worker.mutex);
+        if (stopping_.load()) {
+            return false;
+        }
+        pending_.fetch_add(1, std::memory_order_acq_rel);
+        worker.jobs.push_back(std::move(job));
+    }
+    worker.wake.notify_one();
+    return true;
+}
+
+void WorkerPool::wait_idle() {
+    for (auto pending = pending_.load(std::memory_order_acquire); pending != 0;
+         pending = pending_.load(std::memory_order_acquire)) {
+        pending_.wait(pending, std::memory_order_acquire);
+    }
+}
+
+void WorkerPool::for_each_index(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    std::latch done(static_cast<std::ptrdiff_t>(count));
+    for (std::size_t i = 0; i < count; ++i) {
+        auto job = [&done, &body, i] {
+            // Count down even if the body throws, or the caller would wait forever
+            struct CountDown {
+                std::latch& latch;
+                ~CountDown() { latch.count_down(); }
+            } count_down{done};
+            body(i);
+        };
+        if (!submit(i, job)) {
+            try {
+                job();
+            } catch (const std::exception& e) {
+                LOG_ERROR("Worker job threw an exception: {}", e.what());
+            } catch (...) {
+                LOG_ERROR("Worker job threw an unknown exception");
+            }
+        }
+    }
+    done.wait();
+}
+
+void WorkerPool::stop() {
+    if (stopping_.exchange(true)) {
+        return;
+    }
+
+    for (auto& worker : workers_) {
+        {
+            std::lock_guard lock(worker->mutex);
+        }
+        worker->wake.notify_all();
+    }
+
+    for (auto& worker : workers_) {
+        join_background_thread(worker->thread);
+    }
+}
+
+void WorkerPool::run(Worker& worker) {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock lock(worker.mutex);
+            worker.wake.wait(lock, [&] { return !worker.jobs.empty() || stopping_.load(); });
+            if (worker.jobs.empty()) {
+                break;  // stopping and drained
+            }
+            job = std::move(worker.jobs.front());
+            worker.jobs.pop_front();
+        }
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            LOG_ERROR("Worker job threw an exception: {}", e.what());
+        } catch (...) {
+            LOG_ERROR("Worker job threw an unknown exception");
+        }
+        complete_one();
+    }
+}
+
+void WorkerPool::complete_one() noexcept {
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+    pending_.notify_all();
+}
+
+} // namespace app_hook::util
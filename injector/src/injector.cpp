@@ -6,10 +6,25 @@
 #include <algorithm>
 #include <format>
 #include <string_view>
-#include <fstream>
+#include <cstring>
+#include <vector>
+#include <util/injector_handoff.hpp>
+#include <util/live_metrics.hpp>
 
 namespace injector {
 
+    /// How long --launch keeps the game suspended waiting for the hooks
+    constexpr DWORD kHooksReadyTimeoutMs = 60'000;
+
+    /// Refresh period of --stats --watch
+    constexpr DWORD kStatsRefreshMs = 1'000;
+
+    /// How long --unload waits for the DLL to stop its threads and undo its hooks
+    constexpr DWORD kUnloadTimeoutMs = 30'000;
+
+    /// Export of app_hook.dll that tears it down and unloads it (see app_hook's dllmain.cpp)
+    constexpr const char* kUnloadExport = "AppHookUnload";
+
     /**
      * @brief Find process ID by name (case-insensitive)
      * @param processName Name of the process to find
@@ -73,6 +88,90 @@ namespace injector {
         return false;
     }
 
+    /**
+     * @brief Check that the injector and the target process have the same architecture
+     * @param processId Target process ID
+     * @return true if the DLL can be injected
+     */
+    [[nodiscard]] bool CheckArchitecture(DWORD processId) {
+        bool targetIs64Bit = IsProcess64Bit(processId);
+        std::cout << std::format("Target process architecture: {}\n", targetIs64Bit ? "64-bit" : "32-bit");
+        
+        #ifdef _WIN64
+            std::cout << "Injector architecture: 64-bit\n";
+            if (!targetIs64Bit) {
+                std::cerr << "ERROR: Architecture mismatch!\n";
+                std::cerr << "Target process is 32-bit but injector is 64-bit.\n";
+                std::cerr << "You need to build a 32-bit version of the injector and DLL.\n";
+                return false;
+            }
+        #else
+            std::cout << "Injector architecture: 32-bit\n";
+            if (targetIs64Bit) {
+                std::cerr << "ERROR: Architecture mismatch!\n";
+                std::cerr << "Target process is 64-bit but injector is 32-bit.\n";
+                std::cerr << "You need to build a 64-bit version of the injector and DLL.\n";
+                return false;
+            }
+        #endif
+        return true;
+    }
+
+    /**
+     * @brief Get the name of the event the DLL sets once its hooks are installed
+     * @param processId Target process ID
+     * @return Event name (must match HooksReadyEventName in app_hook's dllmain.cpp)
+     */
+    [[nodiscard]] std::string HooksReadyEventName(DWORD processId) {
+        return std::format("Local\\app_hook_ready_{}", processId);
+    }
+
+    /**
+     * @brief Start a process with its main thread suspended
+     * @param exePath Executable to start
+     * @param processInfo [out] Process and main thread handles
+     * @return true if the process was created
+     * @note The working directory is the executable's directory, as when the game is started normally
+     */
+    [[nodiscard]] bool LaunchSuspended(const std::filesystem::path& exePath, PROCESS_INFORMATION& processInfo) {
+        const std::string exe = exePath.string();
+        const std::string workingDir = exePath.parent_path().string();
+        std::string commandLine = std::format("\"{}\"", exe);  // CreateProcessA may modify it
+        
+        STARTUPINFOA startupInfo{};
+        startupInfo.cb = sizeof(startupInfo);
+        if (!CreateProcessA(exe.c_str(), commandLine.data(), NULL, NULL, FALSE, CREATE_SUSPENDED, NULL,
+                            workingDir.c_str(), &startupInfo, &processInfo)) {
+            std::cerr << std::format("Failed to start {}. Error: {}\n", exe, GetLastError());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Wait until the injected DLL reports that its hooks are installed
+     * @param readyEvent Event created with HooksReadyEventName
+     * @param hProcess Target process, to stop waiting if it exits
+     * @param timeoutMs Longest wait
+     * @return true if the DLL set the event in time
+     */
+    [[nodiscard]] bool WaitForHooksReady(HANDLE readyEvent, HANDLE hProcess, DWORD timeoutMs) {
+        const HANDLE handles[] = {readyEvent, hProcess};
+        switch (WaitForMultipleObjects(2, handles, FALSE, timeoutMs)) {
+            case WAIT_OBJECT_0:
+                return true;
+            case WAIT_OBJECT_0 + 1:
+                std::cerr << "Target process exited before the hooks were installed\n";
+                return false;
+            case WAIT_TIMEOUT:
+                std::cerr << std::format("Hooks were not reported ready within {} seconds\n", timeoutMs / 1000);
+                return false;
+            default:
+                std::cerr << std::format("Failed to wait for the hooks. Error: {}\n", GetLastError());
+                return false;
+        }
+    }
+
     /**
      * @brief Inject DLL into target process
      * @param processId Target process ID
@@ -182,22 +281,134 @@ namespace injector {
         return true;
     }
 
+    /**
+     * @brief Find where a module is loaded in another process
+     * @param processId Target process ID
+     * @param moduleName File name of the module (case-insensitive)
+     * @return Base address in the target process, or nullptr if not loaded
+     */
+    [[nodiscard]] BYTE* FindRemoteModule(DWORD processId, std::string_view moduleName) {
+        HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPMODULE | TH32CS_SNAPMODULE32, processId);
+        if (hSnapshot == INVALID_HANDLE_VALUE) {
+            return nullptr;
+        }
+
+        MODULEENTRY32 me32{};
+        me32.dwSize = sizeof(MODULEENTRY32);
+
+        std::string targetModule{moduleName};
+        std::transform(targetModule.begin(), targetModule.end(), targetModule.begin(), ::tolower);
+
+        BYTE* base = nullptr;
+        if (Module32First(hSnapshot, &me32)) {
+            do {
+                std::string currentModule = me32.szModule;
+                std::transform(currentModule.begin(), currentModule.end(), currentModule.begin(), ::tolower);
+                if (currentModule == targetModule) {
+                    base = me32.modBaseAddr;
+                    break;
+                }
+            } while (Module32Next(hSnapshot, &me32));
+        }
+
+        CloseHandle(hSnapshot);
+        return base;
+    }
+
+    /**
+     * @brief Tear the injected DLL down and unload it from the target process
+     * @param processId Target process ID
+     * @param dllPath Path to the DLL, loaded here without running it to find the export
+     * @return true if the DLL was unloaded
+     * @note Runs the DLL's AppHookUnload export on a remote thread: the DLL stops its
+     *       threads and undoes its hooks there, outside the loader lock, then frees itself
+     */
+    [[nodiscard]] bool UnloadDLL(DWORD processId, const std::string& dllPath) {
+        const std::string moduleName = std::filesystem::path(dllPath).filename().string();
+        BYTE* remoteBase = FindRemoteModule(processId, moduleName);
+        if (!remoteBase) {
+            std::cerr << std::format("{} is not loaded in the target process\n", moduleName);
+            return false;
+        }
+
+        // Same architecture as the target, so the export has the same offset in both
+        HMODULE local = LoadLibraryExA(dllPath.c_str(), NULL, DONT_RESOLVE_DLL_REFERENCES);
+        if (!local) {
+            std::cerr << std::format("Failed to map {}. Error: {}\n", dllPath, GetLastError());
+            return false;
+        }
+        const auto* localExport = reinterpret_cast<const BYTE*>(GetProcAddress(local, kUnloadExport));
+        const auto offset = localExport ? localExport - reinterpret_cast<const BYTE*>(local) : 0;
+        FreeLibrary(local);
+        if (!localExport) {
+            std::cerr << std::format("{} has no {} export\n", moduleName, kUnloadExport);
+            return false;
+        }
+
+        HANDLE hProcess = OpenProcess(PROCESS_CREATE_THREAD | PROCESS_QUERY_INFORMATION | SYNCHRONIZE, FALSE, processId);
+        if (!hProcess) {
+            std::cerr << std::format("Failed to open target process. Error: {}\n", GetLastError());
+            return false;
+        }
+
+        auto* pUnload = reinterpret_cast<LPTHREAD_START_ROUTINE>(remoteBase + offset);
+        HANDLE hThread = CreateRemoteThread(hProcess, NULL, 0, pUnload, NULL, 0, NULL);
+        if (!hThread) {
+            std::cerr << std::format("Failed to create remote thread. Error: {}\n", GetLastError());
+            CloseHandle(hProcess);
+            return false;
+        }
+
+        const DWORD wait = WaitForSingleObject(hThread, kUnloadTimeoutMs);
+        DWORD exitCode = 0;
+        GetExitCodeThread(hThread, &exitCode);
+        CloseHandle(hThread);
+        CloseHandle(hProcess);
+
+        if (wait != WAIT_OBJECT_0) {
+            std::cerr << std::format("Unload did not finish within {} seconds, check logs/app_hook.log\n",
+                                     kUnloadTimeoutMs / 1000);
+            return false;
+        }
+        if (exitCode != 0) {
+            std::cerr << "An unload is already running in the target process\n";
+            return false;
+        }
+        return true;
+    }
+
     /**
      * @brief Display usage information
      * @param programName Name of the program executable
      */
     void ShowUsage(const char* programName) {
-        std::cout << "Usage: " << programName << " <process_name> [dll_name] [--config-dir <path>] [--plugin-dir <path>]\n\n";
+        std::cout << "Usage: " << programName << " <process_name> [dll_name] [--config-dir <path>] [--plugin-dir <path>] [--hot-reload] [--pack] [--record-trace <path>]\n";
+        std::cout << "       " << programName << " --launch <exe_path> [dll_name] [--config-dir <path>] [--plugin-dir <path>] [--hot-reload] [--pack] [--record-trace <path>]\n";
+        std::cout << "       " << programName << " --stats <process_name> [--watch]\n";
+        std::cout << "       " << programName << " --unload <process_name> [dll_name]\n\n";
         std::cout << "Arguments:\n";
         std::cout << "  process_name  Name of the target process (e.g., myapp.exe)\n";
         std::cout << "  dll_name      Name of DLL to inject (default: app_hook.dll)\n\n";
         std::cout << "Options:\n";
+        std::cout << "  --launch      Start the executable suspended, inject, and resume it once hooks are installed\n";
         std::cout << "  --config-dir  Directory for configuration files (default: config)\n";
-        std::cout << "  --plugin-dir  Directory for plugin tasks (default: mods/xtender/tasks)\n\n";
+        std::cout << "  --plugin-dir  Directory for plugin tasks (default: mods/xtender/tasks)\n";
+        std::cout << "  --hot-reload  Apply edits of config files and mod binaries while the game runs\n";
+        std::cout << "  --pack        Load the loose config files and pack them with the mod binaries into <config-dir>/mod.bundle\n";
+        std::cout << "  --record-trace Record every hook trigger and write the trace to <path> when the game exits\n";
+        std::cout << "  --stats       Print the live hook, task, memory and plugin metrics of a process running the DLL\n";
+        std::cout << "  --watch       With --stats, refresh every second until the process exits\n";
+        std::cout << "  --unload      Undo the hooks of the injected DLL and unload it; the game keeps running\n\n";
         std::cout << "Examples:\n";
         std::cout << "  " << programName << " myapp.exe\n";
         std::cout << "  " << programName << " game.exe custom_hook.dll\n";
         std::cout << "  " << programName << " app.exe app_hook.dll --config-dir custom_config --plugin-dir custom_plugins\n";
+        std::cout << "  " << programName << " --launch C:\\Games\\FF8\\FF8_EN.exe\n";
+        std::cout << "  " << programName << " --launch C:\\Games\\FF8\\FF8_EN.exe --hot-reload\n";
+        std::cout << "  " << programName << " --launch C:\\Games\\FF8\\FF8_EN.exe --pack\n";
+        std::cout << "  " << programName << " --launch C:\\Games\\FF8\\FF8_EN.exe --record-trace battle.trace\n";
+        std::cout << "  " << programName << " --stats FF8_EN.exe --watch\n";
+        std::cout << "  " << programName << " --unload FF8_EN.exe\n";
     }
 
     /**
@@ -208,21 +419,36 @@ namespace injector {
      * @param dllName [out] DLL name to inject
      * @param configDir [out] Configuration directory path
      * @param pluginDir [out] Plugin directory path
+     * @param launchPath [out] Executable to start with --launch (empty to attach to a running process)
+     * @param hotReload [out] Whether --hot-reload was given
+     * @param packBundle [out] Whether --pack was given
+     * @param tracePath [out] Trace file of --record-trace (empty when not recording)
+     * @param showStats [out] Whether --stats was given (print metrics instead of injecting)
+     * @param watchStats [out] Whether --watch was given
+     * @param unload [out] Whether --unload was given (unload the DLL instead of injecting)
      * @return true if parsing successful, false otherwise
      */
     bool ParseArguments(int argc, char* argv[], std::string& processName, std::string& dllName, 
-                       std::string& configDir, std::string& pluginDir) {
+                       std::string& configDir, std::string& pluginDir, std::string& launchPath,
+                       bool& hotReload, bool& packBundle, std::string& tracePath, bool& showStats, bool& watchStats,
+                       bool& unload) {
         if (argc < 2) {
             return false;
         }
         
-        processName = argv[1];
         dllName = "app_hook.dll";  // default
         configDir = "config";      // default
         pluginDir = "tasks";  // default
-
-        // Parse remaining arguments
-        for (int i = 2; i < argc; ++i) {
+        launchPath.clear();
+        hotReload = false;
+        packBundle = false;
+        tracePath.clear();
+        showStats = false;
+        watchStats = false;
+        unload = false;
+
+        std::vector<std::string> positional;
+        for (int i = 1; i < argc; ++i) {
             std::string arg = argv[i];
             
             if (arg == "--config-dir" && i + 1 < argc) {
@@ -231,9 +457,30 @@ namespace injector {
             else if (arg == "--plugin-dir" && i + 1 < argc) {
                 pluginDir = argv[++i];
             }
+            else if (arg == "--launch" && i + 1 < argc) {
+                launchPath = argv[++i];
+            }
+            else if (arg == "--hot-reload") {
+                hotReload = true;
+            }
+            else if (arg == "--pack") {
+                packBundle = true;
+            }
+            else if (arg == "--record-trace" && i + 1 < argc) {
+                // The DLL writes it from the game's working directory
+                tracePath = std::filesystem::absolute(argv[++i]).string();
+            }
+            else if (arg == "--stats") {
+                showStats = true;
+            }
+            else if (arg == "--watch") {
+                watchStats = true;
+            }
+            else if (arg == "--unload") {
+                unload = true;
+            }
             else if (!arg.starts_with("--")) {
-                // Assume it's the DLL name (for backward compatibility)
-                dllName = arg;
+                positional.push_back(std::move(arg));
             }
             else {
                 std::cerr << std::format("Unknown option: {}\n", arg);
@@ -241,41 +488,236 @@ namespace injector {
             }
         }
         
+        if (showStats && !launchPath.empty()) {
+            std::cerr << "--stats attaches to a running process and cannot be combined with --launch\n";
+            return false;
+        }
+        if (unload && (showStats || !launchPath.empty())) {
+            std::cerr << "--unload attaches to a running process and cannot be combined with --launch or --stats\n";
+            return false;
+        }
+        
+        // --launch names the target, so the process name is not given
+        auto next = positional.begin();
+        if (!launchPath.empty()) {
+            processName = std::filesystem::path(launchPath).filename().string();
+        } else if (next != positional.end()) {
+            processName = *next++;
+        } else {
+            return false;
+        }
+        
+        // Any further argument is the DLL name (for backward compatibility)
+        if (next != positional.end()) {
+            dllName = positional.back();
+        }
+        
         return true;
     }
 
     /**
-     * @brief Write configuration paths to a temporary file for the DLL to read
-     * @param configDir Configuration directory path
-     * @param pluginDir Plugin directory path
-     * @return true if successful, false otherwise
+     * @brief Publish the settings for the DLL in a shared-memory block of the target process
+     * @param processId Target process ID
+     * @param settings Directories and options for the DLL
+     * @return Mapping handle, to be closed once the DLL is loaded, or NULL on failure
+     * @note The DLL copies the block in DllMain, so closing after InjectDLL returns is safe
      */
-    [[nodiscard]] bool WriteConfigFile(const std::string& configDir, const std::string& pluginDir) {
-        try {
-            // Create temp directory if it doesn't exist
-            std::filesystem::path tempDir = std::filesystem::temp_directory_path() / "ffscript_loader";
-            std::filesystem::create_directories(tempDir);
-            
-            // Write configuration to temporary file
-            std::filesystem::path configFile = tempDir / "injector_config.txt";
-            std::ofstream outFile(configFile);
-            
-            if (!outFile.is_open()) {
-                std::cerr << std::format("Failed to create config file: {}\n", configFile.string());
-                return false;
-            }
-            
-            outFile << "config_dir=" << configDir << "\n";
-            outFile << "plugin_dir=" << pluginDir << "\n";
-            outFile.close();
-            
-            std::cout << std::format("Configuration written to: {}\n", configFile.string());
-            return true;
+    [[nodiscard]] HANDLE WriteHandoff(DWORD processId, const app_hook::util::InjectorHandoff& settings) {
+        const auto block = app_hook::util::encode_handoff(settings);
+        const std::string name = app_hook::util::handoff_mapping_name(processId);
+        
+        HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+                                            static_cast<DWORD>(block.size()), name.c_str());
+        if (!mapping) {
+            std::cerr << std::format("Failed to create shared memory {}. Error: {}\n", name, GetLastError());
+            return NULL;
+        }
+        
+        void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, block.size());
+        if (!view) {
+            std::cerr << std::format("Failed to map shared memory {}. Error: {}\n", name, GetLastError());
+            CloseHandle(mapping);
+            return NULL;
+        }
+        std::memcpy(view, block.data(), block.size());
+        UnmapViewOfFile(view);
+        
+        std::cout << std::format("Configuration shared as {} ({} bytes)\n", name, block.size());
+        return mapping;
+    }
+
+    /**
+     * @brief Start the target suspended and resume it once the DLL's hooks are installed
+     * @param launchPath Executable to start
+     * @param dllPath Absolute path of the DLL to inject
+     * @param settings Directories and options for the DLL
+     * @return true if the game was resumed with the DLL loaded
+     * @note Nothing in the game runs before the hooks exist, so early hook targets cannot be missed
+     */
+    [[nodiscard]] bool LaunchAndInject(const std::string& launchPath, const std::string& dllPath,
+                                       const app_hook::util::InjectorHandoff& settings) {
+        const auto exePath = std::filesystem::absolute(launchPath);
+        if (!std::filesystem::exists(exePath)) {
+            std::cerr << std::format("Error: {} not found!\n", exePath.string());
+            return false;
+        }
+        
+        std::cout << std::format("Starting {} suspended...\n", exePath.string());
+        PROCESS_INFORMATION processInfo{};
+        if (!LaunchSuspended(exePath, processInfo)) {
+            return false;
+        }
+        std::cout << std::format("Started {} (PID: {})\n", exePath.filename().string(), processInfo.dwProcessId);
+        
+        auto abandon = [&processInfo] {
+            TerminateProcess(processInfo.hProcess, 1);
+            CloseHandle(processInfo.hThread);
+            CloseHandle(processInfo.hProcess);
+            return false;
+        };
+        
+        if (!CheckArchitecture(processInfo.dwProcessId)) {
+            return abandon();
+        }
+        
+        // Created before injection so the DLL can never signal ahead of the wait
+        const std::string eventName = HooksReadyEventName(processInfo.dwProcessId);
+        HANDLE readyEvent = CreateEventA(NULL, TRUE, FALSE, eventName.c_str());
+        if (!readyEvent) {
+            std::cerr << std::format("Failed to create event {}. Error: {}\n", eventName, GetLastError());
+            return abandon();
+        }
+        
+        HANDLE handoff = WriteHandoff(processInfo.dwProcessId, settings);
+        if (!handoff) {
+            CloseHandle(readyEvent);
+            return abandon();
+        }
+        
+        std::cout << std::format("\nInjecting DLL: {}\n", dllPath);
+        const bool injected = InjectDLL(processInfo.dwProcessId, dllPath);
+        CloseHandle(handoff);
+        if (!injected) {
+            CloseHandle(readyEvent);
+            return abandon();
+        }
+        
+        std::cout << "Waiting for hooks to be installed...\n";
+        const DWORD waitStart = GetTickCount();
+        const bool hooksReady = WaitForHooksReady(readyEvent, processInfo.hProcess, kHooksReadyTimeoutMs);
+        CloseHandle(readyEvent);
+        if (hooksReady) {
+            std::cout << std::format("Hooks installed after {} ms\n", GetTickCount() - waitStart);
+        } else {
+            std::cerr << "Resuming without confirmation, check logs/app_hook.log\n";
+        }
+        
+        if (ResumeThread(processInfo.hThread) == static_cast<DWORD>(-1)) {
+            std::cerr << std::format("Failed to resume the main thread. Error: {}\n", GetLastError());
+            return abandon();
+        }
+        
+        CloseHandle(processInfo.hThread);
+        CloseHandle(processInfo.hProcess);
+        return true;
+    }
+
+    /**
+     * @brief Print one set of live metrics
+     * @param frame Metrics read from the block
+     */
+    void PrintStats(const app_hook::util::MetricsFrame& frame) {
+        const auto& summary = frame.summary;
+        std::cout << std::format("Publish #{} ({} ms ago)\n", summary.publishes,
+                                 GetTickCount64() - std::min(summary.published_ms, GetTickCount64()));
+        
+        std::cout << std::format("\nHooks ({})\n{:>10}  {:>5}  {:>12}  {:>10}  {:>10}  {:>8}\n", frame.hooks.size(),
+                                 "address", "tasks", "calls", "mean_us", "max_us", "failures");
+        for (const auto& hook : frame.hooks) {
+            const double mean_us = hook.calls ? hook.total_ns / 1000.0 / hook.calls : 0.0;
+            std::cout << std::format("0x{:08X}  {:>5}  {:>12}  {:>10.2f}  {:>10.2f}  {:>8}\n", hook.address,
+                                     hook.task_count, hook.calls, mean_us, hook.max_ns / 1000.0, hook.failures);
+        }
+        
+        std::cout << std::format("\nTasks ({})\n{:<32}  {:>10}  {:>12}  {:>10}  {:>10}  {:>8}\n", frame.tasks.size(),
+                                 "name", "hook", "calls", "mean_us", "max_us", "failures");
+        for (const auto& task : frame.tasks) {
+            const double mean_us = task.calls ? task.total_ns / 1000.0 / task.calls : 0.0;
+            std::cout << std::format("{:<32}  0x{:08X}  {:>12}  {:>10.2f}  {:>10.2f}  {:>8}\n", std::string_view{task.name},
+                                     task.hook_address, task.calls, mean_us, task.max_ns / 1000.0, task.failures);
+        }
+        
+        std::cout << std::format("\nMemory ({})\n{:<40}  {:>8}  {:>12}  {:>12}  {:>12}\n", frame.memory.size(),
+                                 "category", "count", "bytes", "committed", "reserved");
+        for (const auto& memory : frame.memory) {
+            std::cout << std::format("{:<40}  {:>8}  {:>12}  {:>12}  {:>12}\n", std::string_view{memory.category}, memory.count,
+                                     memory.bytes, memory.committed_bytes, memory.reserved_bytes);
+        }
+        
+        std::cout << std::format("\nPlugins ({})\n", frame.plugins.size());
+        for (const auto& plugin : frame.plugins) {
+            std::cout << std::format("  {:<40}  {}\n", std::string_view{plugin.name}, plugin.loaded ? "loaded" : "skipped");
+        }
+        if (summary.dropped != 0) {
+            std::cout << std::format("\n{} entr(ies) did not fit the metrics block\n", summary.dropped);
         }
-        catch (const std::exception& e) {
-            std::cerr << std::format("Exception writing config file: {}\n", e.what());
+    }
+
+    /**
+     * @brief Print the live metrics the DLL publishes in a process
+     * @param processId Process running the DLL
+     * @param watch Refresh every kStatsRefreshMs until the process exits
+     * @return true if the metrics block was found
+     */
+    [[nodiscard]] bool ShowStats(DWORD processId, bool watch) {
+        const std::string name = app_hook::util::metrics_mapping_name(processId);
+        HANDLE mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name.c_str());
+        if (!mapping) {
+            std::cerr << std::format("No metrics block {} (is the DLL loaded and its hooks installed?)\n", name);
             return false;
         }
+        
+        const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        MEMORY_BASIC_INFORMATION info{};
+        const SIZE_T size = view && VirtualQuery(view, &info, sizeof(info)) == sizeof(info) ? info.RegionSize : 0;
+        const auto* block = static_cast<const app_hook::util::MetricsBlock*>(view);
+        if (!block || !app_hook::util::metrics_block_valid(*block, size)) {
+            std::cerr << std::format("{} was written by an incompatible DLL\n", name);
+            if (view) {
+                UnmapViewOfFile(view);
+            }
+            CloseHandle(mapping);
+            return false;
+        }
+        
+        HANDLE process = watch ? OpenProcess(SYNCHRONIZE, FALSE, processId) : NULL;
+        if (watch) {
+            // Redraw in place where the console understands escape sequences
+            HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+            DWORD mode = 0;
+            if (GetConsoleMode(console, &mode)) {
+                SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+            }
+        }
+        
+        for (;;) {
+            if (watch) {
+                std::cout << "\x1b[2J\x1b[H";
+            }
+            PrintStats(app_hook::util::read_metrics(*block));
+            std::cout.flush();
+            if (!watch || !process || WaitForSingleObject(process, kStatsRefreshMs) != WAIT_TIMEOUT) {
+                break;
+            }
+        }
+        
+        if (process) {
+            CloseHandle(process);
+            std::cout << "\nProcess exited\n";
+        }
+        UnmapViewOfFile(view);
+        CloseHandle(mapping);
+        return true;
     }
 
 } // namespace injector
@@ -291,12 +733,31 @@ int main(int argc, char* argv[]) {
     std::string dllName;
     std::string configDir;
     std::string pluginDir;
-
-    if (!ParseArguments(argc, argv, processName, dllName, configDir, pluginDir)) {
+    std::string launchPath;
+    bool hotReload = false;
+    bool packBundle = false;
+    std::string tracePath;
+    bool showStats = false;
+    bool watchStats = false;
+    bool unload = false;
+
+    if (!ParseArguments(argc, argv, processName, dllName, configDir, pluginDir, launchPath, hotReload, packBundle,
+                        tracePath, showStats, watchStats, unload)) {
         ShowUsage(argv[0]);
         system("pause");
         return 1;
     }
+    
+    // Read-only: attaches to the metrics block, injects nothing
+    if (showStats) {
+        const DWORD processId = FindProcessId(processName);
+        if (processId == 0) {
+            std::cerr << std::format("Error: {} is not running\n", processName);
+            return 1;
+        }
+        return ShowStats(processId, watchStats) ? 0 : 1;
+    }
+    const app_hook::util::InjectorHandoff settings{configDir, pluginDir, hotReload, packBundle, tracePath};
 
     // Get the current directory and construct DLL path
     std::filesystem::path currentPath = std::filesystem::current_path();
@@ -314,10 +775,44 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
+    if (unload) {
+        const DWORD processId = FindProcessId(processName);
+        if (processId == 0) {
+            std::cerr << std::format("Error: {} is not running\n", processName);
+            return 1;
+        }
+        if (!CheckArchitecture(processId)) {
+            return 1;
+        }
+        std::cout << std::format("Unloading {} from {} (PID: {})...\n", dllName, processName, processId);
+        if (!UnloadDLL(processId, dllPathStr)) {
+            std::cerr << "\nUnload failed!\n";
+            return 1;
+        }
+        std::cout << "\nDLL unloaded, hooks removed. Check logs/app_hook.log for details.\n";
+        return 0;
+    }
+
     std::cout << std::format("Target process: {}\n", processName);
     std::cout << std::format("DLL found at: {}\n", dllPathStr);
     std::cout << std::format("Config directory: {}\n", configDir);
-    std::cout << std::format("Plugin directory: {}\n\n", pluginDir);
+    std::cout << std::format("Plugin directory: {}\n", pluginDir);
+    std::cout << std::format("Hot reload: {}\n", hotReload ? "enabled" : "disabled");
+    std::cout << std::format("Pack bundle: {}\n", packBundle ? "yes" : "no");
+    std::cout << std::format("Trigger trace: {}\n\n", tracePath.empty() ? "off" : tracePath);
+
+    if (!launchPath.empty()) {
+        if (!LaunchAndInject(launchPath, dllPathStr, settings)) {
+            std::cerr << "\nLaunch with injection failed!\n";
+            system("pause");
+            return 1;
+        }
+        
+        std::cout << "\nDLL injection successful, game resumed!\n";
+        std::cout << "Check logs/app_hook.log for detailed logs.\n";
+        system("pause");
+        return 0;
+    }
 
     std::cout << std::format("Looking for {} process...\n", processName);
 
@@ -345,40 +840,24 @@ int main(int argc, char* argv[]) {
     std::cout << std::format("Found {} (PID: {})\n", processName, processId);
     
     // Check process architecture
-    bool targetIs64Bit = IsProcess64Bit(processId);
-    std::cout << std::format("Target process architecture: {}\n", targetIs64Bit ? "64-bit" : "32-bit");
-    
-    #ifdef _WIN64
-        std::cout << "Injector architecture: 64-bit\n";
-        if (!targetIs64Bit) {
-            std::cerr << "ERROR: Architecture mismatch!\n";
-            std::cerr << "Target process is 32-bit but injector is 64-bit.\n";
-            std::cerr << "You need to build a 32-bit version of the injector and DLL.\n";
-            system("pause");
-            return 1;
-        }
-    #else
-        std::cout << "Injector architecture: 32-bit\n";
-        if (targetIs64Bit) {
-            std::cerr << "ERROR: Architecture mismatch!\n";
-            std::cerr << "Target process is 64-bit but injector is 32-bit.\n";
-            std::cerr << "You need to build a 64-bit version of the injector and DLL.\n";
-            system("pause");
-            return 1;
-        }
-    #endif
+    if (!CheckArchitecture(processId)) {
+        system("pause");
+        return 1;
+    }
     
-    // Write configuration file for DLL to read
-    std::cout << "Writing configuration file for DLL...\n";
-    if (!WriteConfigFile(configDir, pluginDir)) {
-        std::cerr << "\nFailed to write configuration file!\n";
+    // Share the configuration paths for the DLL to read when it loads
+    HANDLE handoff = WriteHandoff(processId, settings);
+    if (!handoff) {
+        std::cerr << "\nFailed to share the configuration with the DLL!\n";
         system("pause");
         return 1;
     }
 
     std::cout << std::format("\nInjecting DLL: {}\n", dllPathStr);
 
-    if (!InjectDLL(processId, dllPathStr)) {
+    const bool injected = InjectDLL(processId, dllPathStr);
+    CloseHandle(handoff);
+    if (!injected) {
         std::cerr << "\nDLL injection failed!\n";
         system("pause");
         return 1;
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <config/config_base.hpp>
+#include "../script/chunk_cache.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief Configuration for a Lua script run by a hook
+///
+/// A script with a hookAddress is hooked there on its own; without one it
+/// follows its parent task in tasks.toml and runs on the parent's hook.
+class ScriptConfig : public ConfigBase, public AddressTrigger {
+public:
+    /// @brief Type ID the task creator is registered under
+    static constexpr std::string_view kTypeId = "app_hook::config::ScriptConfig";
+
+    /// @brief Constructor
+    /// @param key Configuration key
+    /// @param name Display name
+    ScriptConfig(std::string key, std::string name)
+        : ConfigBase(ConfigType::Script, std::move(key), std::move(name))
+        , script_path_{}
+        , entry_{}
+        , hook_address_(0) {}
+
+    /// @brief Default destructor
+    ~ScriptConfig() override = default;
+
+    /// @brief Get the stable type ID
+    [[nodiscard]] std::string_view type_id() const noexcept override { return kTypeId; }
+
+    // Accessors following C++23 conventions
+    [[nodiscard]] const std::string& script_path() const noexcept { return script_path_; }
+    [[nodiscard]] const std::string& entry() const noexcept { return entry_; }
+    [[nodiscard]] constexpr std::uintptr_t hook_address() const noexcept { return hook_address_; }
+
+    /// @brief Check if the script runs a named function on each trigger
+    /// @return False if the whole chunk runs on each trigger
+    [[nodiscard]] bool has_entry() const noexcept { return !entry_.empty(); }
+
+    // Mutators
+    void set_script_path(std::string path) { script_path_ = std::move(path); }
+    void set_entry(std::string entry) { entry_ = std::move(entry); }
+    void set_hook_address(std::uintptr_t address) noexcept { hook_address_ = address; }
+
+    // AddressTrigger interface implementation
+    /// @brief Get the address the script hooks on its own
+    /// @return hookAddress, or 0 if the script follows its parent task
+    [[nodiscard]] std::uintptr_t get_hook_address() const noexcept override {
+        return hook_address_;
+    }
+
+    /// @brief Check if this configuration is valid
+    /// @return True if a script file is set
+    [[nodiscard]] bool is_valid() const noexcept override {
+        return ConfigBase::is_valid() && !script_path_.empty();
+    }
+
+    /// @brief Get the memory held by this configuration
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept override {
+        return sizeof(*this) + heap_bytes() + script_path_.capacity() + entry_.capacity();
+    }
+
+    /// @brief Shrink the strings
+    void compact() override {
+        ConfigBase::compact();
+        script_path_.shrink_to_fit();
+        entry_.shrink_to_fit();
+    }
+
+    /// @brief Get the script and its compiled chunk, packed into mod bundles
+    [[nodiscard]] std::vector<std::string> data_files() const override {
+        auto chunk = script::ChunkCache::instance().chunk_file(script_path_);
+        if (chunk.empty()) {
+            return {script_path_};
+        }
+        return {script_path_, std::move(chunk)};
+    }
+
+    /// @brief Get debug string representation
+    /// @return Debug string with script-specific information
+    [[nodiscard]] std::string debug_string() const override {
+        return ConfigBase::debug_string() +
+               " script=" + script_path_ +
+               (entry_.empty() ? std::string{} : " function=" + entry_) +
+               (hook_address_ ? " hook=0x" + std::to_string(hook_address_) : std::string{});
+    }
+
+private:
+    std::string script_path_;       ///< Path to the .lua file
+    std::string entry_;             ///< Global function called on each trigger (empty: the whole chunk)
+    std::uintptr_t hook_address_;   ///< Address hooked by the script itself (0: follows its parent)
+};
+
+} // namespace app_hook::config
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <config/config_loader_base.hpp>
+#include "script_config.hpp"
+#include <memory>
+#include <toml++/toml.hpp>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace lua_plugin {
+
+/// @brief Script configuration loader
+/// @note Implements ConfigLoaderBase to provide Lua script configuration loading
+class ScriptConfigLoader : public app_hook::config::ConfigLoaderBase {
+public:
+    ScriptConfigLoader() = default;
+    ~ScriptConfigLoader() override = default;
+
+    /// @brief Set the plugin host for logging
+    void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
+
+    // ConfigLoaderBase interface
+    std::vector<app_hook::config::ConfigType> supported_types() const override;
+
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> load_configs(
+        app_hook::config::ConfigType type,
+        const std::string& file_path,
+        const std::string& task_name
+    ) override;
+
+    std::string get_name() const override;
+    std::string get_version() const override;
+
+    // Config cache hooks
+    std::uint32_t cache_version() const override;
+    bool serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs,
+                           app_hook::util::ByteWriter& out) const override;
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> deserialize_configs(
+        app_hook::config::ConfigType type,
+        app_hook::util::ByteReader& in,
+        const std::string& task_name
+    ) override;
+
+private:
+    /// @brief Parse a single script from TOML
+    app_hook::config::ConfigPtr parse_script(const toml::table& table, const std::string& task_name,
+                                             const std::string& config_name);
+
+    /// @brief Plugin host for logging
+    app_hook::plugin::IPluginHost* host_ = nullptr;
+};
+
+} // namespace lua_plugin
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace app_hook::script {
+
+/// @brief Compiled Lua chunks kept next to the config cache
+///
+/// Each script compiled from source is dumped to its own file in the
+/// lua.cache directory of the config directory, named after the script path.
+/// A chunk file holds the script path, the hash of the source it was compiled
+/// from and the LuaJIT version, then the bytecode:
+///
+///     magic "AHLC", format version, LuaJIT version, source hash, script path,
+///     bytecode size, bytecode (up to the end of the file)
+///
+/// load() reads every chunk file across a worker pool while the plugin
+/// initializes and keeps those whose script still hashes the same, so tasks
+/// load bytecode instead of compiling. Mod bundles pack the chunk files next
+/// to the scripts (see ScriptConfig::data_files), so a bundled mod skips
+/// compilation on its first launch too.
+class ChunkCache {
+public:
+    /// @brief Compiled chunk
+    using Bytecode = std::vector<std::uint8_t>;
+
+    /// @brief Name of the chunk directory inside the config directory
+    static constexpr const char* kDirectoryName = "lua.cache";
+
+    /// @brief Get the cache shared by the plugin's tasks
+    /// @return Cache instance
+    static ChunkCache& instance();
+
+    ChunkCache() = default;
+
+    // Non-copyable, non-movable
+    ChunkCache(const ChunkCache&) = delete;
+    ChunkCache& operator=(const ChunkCache&) = delete;
+    ChunkCache(ChunkCache&&) = delete;
+    ChunkCache& operator=(ChunkCache&&) = delete;
+
+    /// @brief Load the chunks of a config directory whose scripts did not change
+    /// @param config_dir Directory holding the config cache
+    /// @param host Host serving scripts packed into the mod bundle (may be null)
+    /// @return Number of chunks loaded
+    /// @note Replaces the chunks loaded before
+    std::size_t load(const std::filesystem::path& config_dir, plugin::IPluginHost* host);
+
+    /// @brief Get the chunk file of a script
+    /// @param script_path Script path as the task was configured
+    /// @return Path in the chunk directory, or an empty string before load()
+    [[nodiscard]] std::string chunk_file(const std::string& script_path) const;
+
+    /// @brief Get the bytecode loaded for a script
+    /// @param script_path Script path as the task was configured
+    /// @return Bytecode, or nullptr if the script has no valid chunk
+    [[nodiscard]] std::shared_ptr<const Bytecode> find(const std::string& script_path) const;
+
+    /// @brief Write the chunk of a script just compiled from source
+    /// @param script_path Script path as the task was configured
+    /// @param source Source the bytecode was compiled from
+    /// @param bytecode Dumped bytecode
+    /// @return False if there is no chunk directory or the file cannot be written
+    bool store(const std::string& script_path, std::span<const char> source, Bytecode bytecode);
+
+    /// @brief Get the bytecode of a chunk file if it matches a script
+    /// @param file Contents of the chunk file
+    /// @param script_path Script the chunk must have been compiled from
+    /// @param source_hash hash_source() of the script's current source
+    /// @return Bytecode inside file, or an empty span if the chunk is stale or corrupt
+    [[nodiscard]] static std::span<const std::uint8_t> decode(std::span<const std::uint8_t> file,
+                                                              const std::string& script_path,
+                                                              std::uint64_t source_hash);
+
+    /// @brief Hash a script's source
+    [[nodiscard]] static std::uint64_t hash_source(std::span<const char> source) noexcept;
+
+    /// @brief Drop the loaded bytecode once the tasks are compiled
+    /// @note Called once the hooks are installed; chunks stored later are kept
+    void release();
+
+    /// @brief Drop the loaded bytecode and forget the chunk directory
+    void clear();
+
+    /// @brief Get the number of loaded chunks
+    [[nodiscard]] std::size_t chunk_count() const;
+
+    /// @brief Get the size of the loaded bytecode
+    [[nodiscard]] std::size_t chunk_bytes() const;
+
+private:
+    mutable std::mutex mutex_;       ///< Guards directory_ and chunks_
+    std::filesystem::path directory_;
+    std::unordered_map<std::string, std::shared_ptr<const Bytecode>> chunks_;  ///< Script path -> bytecode
+};
+
+} // namespace app_hook::script
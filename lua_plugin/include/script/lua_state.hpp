@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+struct lua_State;
+
+// Forward declarations
+namespace app_hook::plugin { class IPluginHost; }
+namespace app_hook::context { class ModContext; }
+
+namespace app_hook::script {
+
+/// @brief One LuaJIT state running one script
+///
+/// The state is opened and the script compiled once, then the same compiled
+/// function is called on every trigger. Scripts reach memory through the `app`
+/// table: app.region() and app.address() return FFI pointers straight onto a
+/// MemoryRegion's bytes or a game address, so nothing is copied into Lua tables.
+/// @note Not thread-safe: the owner serializes every call
+class LuaState {
+public:
+    LuaState() = default;
+
+    /// @brief Closes the state
+    ~LuaState();
+
+    // Non-copyable, non-movable (the state's allocator points to the object)
+    LuaState(const LuaState&) = delete;
+    LuaState& operator=(const LuaState&) = delete;
+    LuaState(LuaState&&) = delete;
+    LuaState& operator=(LuaState&&) = delete;
+
+    /// @brief Create the state, open the standard libraries and the `app` table
+    /// @param context Context app.region() looks regions up in
+    /// @param host Host app.log() writes through (may be null)
+    /// @param default_region Region app.region() returns when called without a name
+    /// @return False if the state cannot be created; see last_error()
+    [[nodiscard]] bool open(context::ModContext& context, plugin::IPluginHost* host, const std::string& default_region);
+
+    /// @brief Compile a chunk
+    /// @param source Lua source or bytecode
+    /// @param chunk_name Name shown in error messages (e.g. "@path/to/script.lua")
+    /// @return False on a syntax error; see last_error()
+    [[nodiscard]] bool load(std::span<const char> source, const std::string& chunk_name);
+
+    /// @brief Dump the compiled chunk as bytecode
+    /// @param out Receives the bytecode, which load() accepts in place of the source
+    /// @return False if no chunk is loaded (bind() with an entry releases it)
+    [[nodiscard]] bool dump(std::vector<std::uint8_t>& out);
+
+    /// @brief Choose what each call() runs
+    /// @param entry Global function to call; empty to run the chunk itself on each call
+    /// @return False if running the chunk failed or did not define the function
+    /// @note With an entry, the chunk runs once here: its top level is the script's setup
+    [[nodiscard]] bool bind(const std::string& entry);
+
+    /// @brief Run the bound function once
+    /// @return False if it raised an error or returned false; see last_error()
+    [[nodiscard]] bool call();
+
+    /// @brief Check if load() and bind() succeeded
+    [[nodiscard]] bool ready() const noexcept { return entry_ref_ >= 0; }
+
+    /// @brief Get the error message of the last failed operation
+    [[nodiscard]] const std::string& last_error() const noexcept { return error_; }
+
+    /// @brief Get the bytes the state has allocated
+    [[nodiscard]] std::size_t heap_bytes() const noexcept { return bytes_; }
+
+    /// @brief Get the raw state
+    [[nodiscard]] lua_State* get() const noexcept { return state_; }
+
+    /// @brief Get the number of open states in the process
+    [[nodiscard]] static std::size_t live_states() noexcept { return total_states_.load(std::memory_order_relaxed); }
+
+    /// @brief Get the bytes allocated by every open state
+    [[nodiscard]] static std::size_t live_bytes() noexcept { return total_bytes_.load(std::memory_order_relaxed); }
+
+private:
+    /// @brief lua_Alloc counting the state's bytes
+    static void* allocate(void* user, void* block, std::size_t old_size, std::size_t new_size) noexcept;
+
+    /// @brief Record the error message on top of the stack and pop it
+    void take_error();
+
+    lua_State* state_ = nullptr;
+    int chunk_ref_ = -1;        ///< Registry reference of the compiled chunk
+    int entry_ref_ = -1;        ///< Registry reference of the function call() runs
+    std::size_t bytes_ = 0;
+    std::string error_;
+
+    static inline std::atomic<std::size_t> total_states_{0};
+    static inline std::atomic<std::size_t> total_bytes_{0};
+};
+
+} // namespace app_hook::script
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../config/script_config.hpp"
+#include "lua_state.hpp"
+#include "chunk_cache.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include <expected>
+#include <memory>
+#include <mutex>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace app_hook::script {
+
+// Use the config structure from the config namespace
+using ScriptConfig = config::ScriptConfig;
+
+/// @brief Task that runs a Lua script on each trigger
+///
+/// The script is compiled once, when the task is created (or loaded from its
+/// cached bytecode, see ChunkCache), into a state the task keeps: every
+/// trigger calls the same compiled function, so globals a script sets survive
+/// from one trigger to the next. Reloading the config or the script file
+/// compiles a fresh state.
+class ScriptTask final : public task::IHookTask {
+public:
+    /// @brief Construct a script task
+    /// @param config Configuration for the script
+    explicit ScriptTask(ScriptConfig config) noexcept
+        : config_(std::move(config)), host_(nullptr) {}
+
+    /// @brief Set the plugin host for logging
+    void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
+
+    /// @brief Set the plugin host for logging (base interface override)
+    void setHost(void* host) override {
+        host_ = static_cast<app_hook::plugin::IPluginHost*>(host);
+    }
+
+    /// @brief Compile the script ahead of the first trigger
+    /// @return False if the script cannot be read or compiled; execute() then fails
+    /// @note Called by the task creator so the hooked code never waits on the compiler
+    bool prepare();
+
+    /// @brief Run the script
+    /// @return Task result indicating success or failure
+    [[nodiscard]] task::TaskResult execute() override;
+
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+
+    /// @brief Take over a reloaded configuration, compiling the script again
+    /// @param updated Reloaded script configuration
+    /// @return unchanged, updated, or restart_required when the hook address changed
+    ///         or the new script does not compile
+    [[nodiscard]] task::ReloadOutcome reload(const config::ConfigBase& updated) override;
+
+    /// @brief Get the script file, watched by hot reload
+    [[nodiscard]] std::vector<std::string> watched_files() const override;
+
+    /// @brief Compile the changed script into a fresh state
+    /// @param path Changed file
+    /// @return updated, or restart_required when the new script does not compile
+    [[nodiscard]] task::ReloadOutcome refresh_file(const std::string& path) override;
+
+    /// @brief Get the task name
+    /// @return Task name
+    [[nodiscard]] std::string name() const override {
+        return "Script";
+    }
+
+    /// @brief Get the task description
+    /// @return Task description
+    [[nodiscard]] std::string description() const override {
+        return "Run script '" + config_.script_path() + "'" +
+               (config_.has_entry() ? " function '" + config_.entry() + "'" : std::string{});
+    }
+
+    /// @brief Shrink the configuration's strings and drop the chunks loaded at startup
+    void compact() override {
+        std::lock_guard lock(mutex_);
+        config_.compact();
+        ChunkCache::instance().release();
+    }
+
+    /// @brief Get the memory held by the task's configuration
+    /// @note The Lua heap is reported by the plugin's memory source
+    [[nodiscard]] std::size_t config_bytes() const noexcept override {
+        return config_.footprint_bytes();
+    }
+
+    /// @brief Get the configuration
+    /// @return Script configuration
+    /// @note Not synchronized with reload()
+    [[nodiscard]] const ScriptConfig& config() const noexcept {
+        return config_;
+    }
+
+private:
+    ScriptConfig config_;
+    app_hook::plugin::IPluginHost* host_ = nullptr;
+    std::unique_ptr<LuaState> state_;   ///< Compiled script; bound on the first trigger
+    bool failed_ = false;               ///< The script did not compile: do not read it on every trigger
+    bool read_file_ = false;            ///< The file changed since the bundle was packed
+    mutable std::mutex mutex_;          ///< Serializes execute() with reload()
+
+    /// @brief Open a state and compile a configuration's script into it
+    /// @param config Configuration naming the script
+    /// @return Compiled state, or the reason it could not be built
+    [[nodiscard]] std::expected<std::unique_ptr<LuaState>, task::TaskError> compile(const ScriptConfig& config);
+};
+
+} // namespace app_hook::script
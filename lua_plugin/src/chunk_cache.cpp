@@ -0,0 +1,218 @@
+#include "../include/script/chunk_cache.hpp"
+#include "plugin/plugin_interface.hpp"
+#include "util/byte_stream.hpp"
+#include "util/worker_pool.hpp"
+#include <lua.hpp>
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <optional>
+
+namespace app_hook::script {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x434C4841;  // "AHLC"
+constexpr std::uint32_t kFormatVersion = 1;
+constexpr std::uint32_t kInterpreterVersion = LUAJIT_VERSION_NUM;
+
+/// @brief Most threads reading chunk files at once
+constexpr std::size_t kMaxLoadThreads = 8;
+
+/// @brief Fields of a chunk file ahead of the bytecode
+struct ChunkHeader {
+    std::string script_path;
+    std::uint64_t source_hash = 0;
+    std::span<const std::uint8_t> bytecode;
+};
+
+/// @brief Parse a chunk file written for this LuaJIT version
+std::optional<ChunkHeader> parse(std::span<const std::uint8_t> file) {
+    util::ByteReader in(file);
+    std::uint32_t magic = 0;
+    std::uint32_t format = 0;
+    std::uint32_t interpreter = 0;
+    std::uint32_t size = 0;
+    ChunkHeader header;
+    if (!in.read(magic) || !in.read(format) || !in.read(interpreter) || !in.read(header.source_hash) ||
+        !in.read_string(header.script_path) || !in.read(size)) {
+        return std::nullopt;
+    }
+    if (magic != kMagic || format != kFormatVersion || interpreter != kInterpreterVersion || size != in.remaining()) {
+        return std::nullopt;
+    }
+    header.bytecode = file.subspan(file.size() - size);
+    return header;
+}
+
+/// @brief Read a whole file
+std::optional<std::vector<std::uint8_t>> read_file(const std::filesystem::path& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    std::ifstream file(path, std::ios::binary);
+    if (ec || !file) {
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> data(static_cast<std::size_t>(size));
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        return std::nullopt;
+    }
+    return data;
+}
+
+/// @brief Load a chunk file if its script still has the source it was compiled from
+/// @return Script path and bytecode, or an empty path if the chunk is stale or unreadable
+std::pair<std::string, std::shared_ptr<const ChunkCache::Bytecode>>
+load_chunk(const std::filesystem::path& path, plugin::IPluginHost* host) {
+    const auto file = read_file(path);
+    auto header = file ? parse(*file) : std::nullopt;
+    if (!header) {
+        return {};
+    }
+
+    // The script itself is read from the bundle when it was packed
+    const auto packed = host ? host->bundle_blob(header->script_path) : std::span<const std::uint8_t>{};
+    std::optional<std::vector<std::uint8_t>> loose;
+    if (packed.empty()) {
+        loose = read_file(header->script_path);
+        if (!loose) {
+            return {};
+        }
+    }
+    const auto source = loose ? std::span<const std::uint8_t>(*loose) : packed;
+    if (ChunkCache::hash_source({reinterpret_cast<const char*>(source.data()), source.size()}) != header->source_hash) {
+        return {};
+    }
+    auto bytecode = std::make_shared<const ChunkCache::Bytecode>(header->bytecode.begin(), header->bytecode.end());
+    return {std::move(header->script_path), std::move(bytecode)};
+}
+
+} // namespace
+
+ChunkCache& ChunkCache::instance() {
+    static ChunkCache cache;
+    return cache;
+}
+
+std::size_t ChunkCache::load(const std::filesystem::path& config_dir, plugin::IPluginHost* host) {
+    const auto directory = config_dir / kDirectoryName;
+    std::vector<std::filesystem::path> files;
+    std::error_code ec;
+    for (auto it = std::filesystem::directory_iterator(directory, ec); !ec && it != std::filesystem::directory_iterator();
+         it.increment(ec)) {
+        if (it->path().extension() == ".luac") {
+            files.push_back(it->path());
+        }
+    }
+
+    // Chunk files are independent: read and check them concurrently
+    std::vector<std::pair<std::string, std::shared_ptr<const Bytecode>>> loaded(files.size());
+    if (!files.empty()) {
+        util::WorkerPool pool(std::min(files.size(), kMaxLoadThreads));
+        pool.for_each_index(files.size(), [&](std::size_t i) {
+            loaded[i] = load_chunk(files[i], host);
+        });
+    }
+
+    std::lock_guard lock(mutex_);
+    directory_ = directory;
+    chunks_.clear();
+    for (auto& [script_path, bytecode] : loaded) {
+        if (bytecode) {
+            chunks_.insert_or_assign(std::move(script_path), std::move(bytecode));
+        }
+    }
+    return chunks_.size();
+}
+
+std::string ChunkCache::chunk_file(const std::string& script_path) const {
+    std::lock_guard lock(mutex_);
+    if (directory_.empty()) {
+        return {};
+    }
+    const auto name_hash = util::fnv1a_64({reinterpret_cast<const std::uint8_t*>(script_path.data()), script_path.size()});
+    return (directory_ / std::format("{:016x}.luac", name_hash)).string();
+}
+
+std::shared_ptr<const ChunkCache::Bytecode> ChunkCache::find(const std::string& script_path) const {
+    std::lock_guard lock(mutex_);
+    auto it = chunks_.find(script_path);
+    return it != chunks_.end() ? it->second : nullptr;
+}
+
+bool ChunkCache::store(const std::string& script_path, std::span<const char> source, Bytecode bytecode) {
+    const std::filesystem::path path = chunk_file(script_path);
+    if (path.empty()) {
+        return false;
+    }
+
+    util::ByteWriter out;
+    out.write(kMagic);
+    out.write(kFormatVersion);
+    out.write(kInterpreterVersion);
+    out.write(hash_source(source));
+    out.write_string(script_path);
+    out.write_bytes(bytecode);
+
+    // Write next to the chunk and swap, so a crash never leaves a torn file
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    auto temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        const auto data = out.data();
+        if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+    chunks_.insert_or_assign(script_path, std::make_shared<const Bytecode>(std::move(bytecode)));
+    return true;
+}
+
+std::span<const std::uint8_t> ChunkCache::decode(std::span<const std::uint8_t> file, const std::string& script_path,
+                                                 std::uint64_t source_hash) {
+    const auto header = parse(file);
+    if (!header || header->script_path != script_path || header->source_hash != source_hash) {
+        return {};
+    }
+    return header->bytecode;
+}
+
+std::uint64_t ChunkCache::hash_source(std::span<const char> source) noexcept {
+    return util::fnv1a_64({reinterpret_cast<const std::uint8_t*>(source.data()), source.size()});
+}
+
+void ChunkCache::release() {
+    std::lock_guard lock(mutex_);
+    chunks_.clear();
+}
+
+void ChunkCache::clear() {
+    std::lock_guard lock(mutex_);
+    chunks_.clear();
+    directory_.clear();
+}
+
+std::size_t ChunkCache::chunk_count() const {
+    std::lock_guard lock(mutex_);
+    return chunks_.size();
+}
+
+std::size_t ChunkCache::chunk_bytes() const {
+    std::lock_guard lock(mutex_);
+    std::size_t bytes = 0;
+    for (const auto& [script_path, bytecode] : chunks_) {
+        bytes += bytecode->size();
+    }
+    return bytes;
+}
+
+} // namespace app_hook::script
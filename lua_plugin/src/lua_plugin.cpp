@@ -0,0 +1,123 @@
+#include "plugin/plugin_interface.hpp"
+#include "../include/config/script_config_loader.hpp"
+#include "../include/script/script_task.hpp"
+#include "../include/script/lua_state.hpp"
+#include "../include/script/chunk_cache.hpp"
+#include "task/task_factory.hpp"
+#include <memory>
+#include <string>
+
+namespace lua_plugin {
+
+/// @brief Lua scripting plugin implementation
+class LuaPlugin : public app_hook::plugin::IPlugin {
+public:
+    LuaPlugin() : host_(nullptr) {}
+    ~LuaPlugin() override = default;
+
+    // IPlugin interface
+    app_hook::plugin::PluginInfo get_plugin_info() const override {
+        return {
+            "Lua Scripting Plugin",
+            "1.0.0",
+            "Runs LuaJIT scripts on hooks with direct views onto context memory",
+            app_hook::plugin::PLUGIN_API_VERSION
+        };
+    }
+
+    app_hook::plugin::PluginResult initialize(app_hook::plugin::IPluginHost* host) override {
+        if (!host) {
+            return app_hook::plugin::PluginResult::Failed;
+        }
+
+        host_ = host;
+        PLUGIN_LOG_INFO("Lua Plugin: Initializing...");
+
+        // Register script config loader
+        auto script_loader = std::make_unique<ScriptConfigLoader>();
+        script_loader->setHost(host_); // Set host for logging
+        auto script_result = host_->register_config_loader(std::move(script_loader));
+        if (script_result != app_hook::plugin::PluginResult::Success) {
+            PLUGIN_LOG_ERROR("Lua Plugin: Failed to register script config loader");
+            return script_result;
+        }
+        PLUGIN_LOG_INFO("Lua Plugin: Script config loader registered successfully");
+
+        // Register ScriptTask creator; scripts compile here, at install time
+        auto script_creator_result = host_->register_task_creator(
+            std::string{app_hook::config::ScriptConfig::kTypeId},
+            [this](const app_hook::config::ConfigBase& base_config) -> std::unique_ptr<app_hook::task::IHookTask> {
+                const auto& script_config = static_cast<const app_hook::config::ScriptConfig&>(base_config);
+                auto task = std::make_unique<app_hook::script::ScriptTask>(script_config);
+                task->setHost(host_);
+                (void)task->prepare();
+                return task;
+            }
+        );
+
+        if (script_creator_result != app_hook::plugin::PluginResult::Success) {
+            PLUGIN_LOG_ERROR("Lua Plugin: Failed to register ScriptTask creator");
+            return script_creator_result;
+        }
+        PLUGIN_LOG_INFO("Lua Plugin: ScriptTask creator registered successfully");
+
+        host_->register_memory_source(kMemorySourceName, &LuaPlugin::memory_usage);
+
+        PLUGIN_LOG_INFO("Lua Plugin: Initialized successfully");
+        return app_hook::plugin::PluginResult::Success;
+    }
+
+    app_hook::plugin::PluginResult load_configurations(const std::string& config_path) override {
+        if (!host_) {
+            return app_hook::plugin::PluginResult::Failed;
+        }
+
+        PLUGIN_LOG_DEBUG("Lua Plugin: Config path provided: {}", config_path);
+
+        // Chunks compiled on earlier launches are read now, so tasks skip the compiler
+        const auto chunks = app_hook::script::ChunkCache::instance().load(config_path, host_);
+        PLUGIN_LOG_INFO("Lua Plugin: {} compiled chunk(s) ready", chunks);
+        return app_hook::plugin::PluginResult::Success;
+    }
+
+    void shutdown() override {
+        if (host_) {
+            PLUGIN_LOG_INFO("Lua Plugin: Shutting down...");
+            host_->unregister_memory_source(kMemorySourceName);
+            app_hook::script::ChunkCache::instance().clear();
+            host_ = nullptr;
+        }
+    }
+
+private:
+    /// @brief Name of the plugin's source in the memory footprint report
+    static constexpr const char* kMemorySourceName = "lua_plugin";
+
+    /// @brief Describe the open Lua states, their heaps and the loaded chunks
+    static std::vector<app_hook::util::MemoryUsage> memory_usage() {
+        app_hook::util::MemoryUsage states{"lua_plugin.states"};
+        states.count = app_hook::script::LuaState::live_states();
+        states.bytes = app_hook::script::LuaState::live_bytes();
+
+        const auto& cache = app_hook::script::ChunkCache::instance();
+        app_hook::util::MemoryUsage chunks{"lua_plugin.chunk_cache"};
+        chunks.count = cache.chunk_count();
+        chunks.bytes = cache.chunk_bytes();
+        return {std::move(states), std::move(chunks)};
+    }
+
+    app_hook::plugin::IPluginHost* host_;
+};
+
+} // namespace lua_plugin
+
+// Export plugin functions
+extern "C" {
+    __declspec(dllexport) app_hook::plugin::IPlugin* CreatePlugin() {
+        return new lua_plugin::LuaPlugin();
+    }
+
+    __declspec(dllexport) void DestroyPlugin(app_hook::plugin::IPlugin* plugin) {
+        delete plugin;
+    }
+}
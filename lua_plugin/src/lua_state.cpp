@@ -0,0 +1,229 @@
+#include "../include/script/lua_state.hpp"
+#include "memory/memory_region.hpp"
+#include "context/mod_context.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <lua.hpp>
+#include <cstdlib>
+#include <format>
+
+namespace app_hook::script {
+
+namespace {
+
+/// @brief Defines the `app` table scripts use; called with the native helpers
+constexpr char kPrelude[] = R"lua(
+local raw_region, raw_log, default_region = ...
+local ffi = require("ffi")
+local cast = ffi.cast
+local format = string.format
+
+app = { ffi = ffi }
+
+-- Pointer onto the bytes of a context region and its size; nil, 0 if there is none
+function app.region(name, ctype)
+    local base, size = raw_region(name or default_region)
+    if base == nil then
+        return nil, 0
+    end
+    return cast(ctype or "uint8_t*", base), size
+end
+
+-- Pointer onto a game address
+function app.address(address, ctype)
+    return cast(ctype or "uint8_t*", address)
+end
+
+function app.debug(...) raw_log(1, format(...)) end
+function app.log(...) raw_log(2, format(...)) end
+function app.warn(...) raw_log(3, format(...)) end
+function app.error(...) raw_log(4, format(...)) end
+)lua";
+
+/// @brief raw_region(name): base (light userdata) and size of a context region
+int region_lookup(lua_State* state) {
+    auto* context = static_cast<context::ModContext*>(lua_touserdata(state, lua_upvalueindex(1)));
+    const auto* region = context->get_data<memory::MemoryRegion>(luaL_checkstring(state, 1));
+    if (!region || !region->base()) {
+        lua_pushnil(state);
+        lua_pushinteger(state, 0);
+        return 2;
+    }
+    lua_pushlightuserdata(state, region->base());
+    lua_pushinteger(state, static_cast<lua_Integer>(region->size));
+    return 2;
+}
+
+/// @brief raw_log(level, message): log through the plugin host
+int log_message(lua_State* state) {
+    auto* host = static_cast<plugin::IPluginHost*>(lua_touserdata(state, lua_upvalueindex(1)));
+    const auto level = static_cast<int>(luaL_checkinteger(state, 1));
+    std::size_t length = 0;
+    const char* text = luaL_checklstring(state, 2, &length);
+    if (host && host->is_enabled(level)) {
+        host->log_message(level, std::string(text, length));
+    }
+    return 0;
+}
+
+/// @brief Message handler appending a traceback to script errors
+int traceback(lua_State* state) {
+    const char* message = lua_tostring(state, 1);
+    luaL_traceback(state, state, message ? message : "(error object is not a string)", 1);
+    return 1;
+}
+
+/// @brief lua_Writer appending a dumped chunk to a byte vector
+int append_chunk(lua_State*, const void* data, std::size_t size, void* user) {
+    auto& bytes = *static_cast<std::vector<std::uint8_t>*>(user);
+    const auto* begin = static_cast<const std::uint8_t*>(data);
+    bytes.insert(bytes.end(), begin, begin + size);
+    return 0;
+}
+
+/// @brief Stack slot of the message handler, pushed once when the state is opened
+constexpr int kTracebackIndex = 1;
+
+} // namespace
+
+LuaState::~LuaState() {
+    if (state_) {
+        lua_close(state_);
+        total_states_.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+bool LuaState::open(context::ModContext& context, plugin::IPluginHost* host, const std::string& default_region) {
+    if (state_) {
+        error_ = "the state is already open";
+        return false;
+    }
+    state_ = lua_newstate(&LuaState::allocate, this);
+    if (!state_) {
+        error_ = "cannot create a Lua state";
+        return false;
+    }
+    total_states_.fetch_add(1, std::memory_order_relaxed);
+    luaL_openlibs(state_);
+    lua_pushcfunction(state_, traceback);
+
+    if (luaL_loadbuffer(state_, kPrelude, sizeof(kPrelude) - 1, "=app") != 0) {
+        take_error();
+        return false;
+    }
+    lua_pushlightuserdata(state_, &context);
+    lua_pushcclosure(state_, region_lookup, 1);
+    lua_pushlightuserdata(state_, host);
+    lua_pushcclosure(state_, log_message, 1);
+    if (default_region.empty()) {
+        lua_pushnil(state_);
+    } else {
+        lua_pushlstring(state_, default_region.data(), default_region.size());
+    }
+    if (lua_pcall(state_, 3, 0, kTracebackIndex) != 0) {
+        take_error();
+        return false;
+    }
+    return true;
+}
+
+bool LuaState::load(std::span<const char> source, const std::string& chunk_name) {
+    if (!state_ || chunk_ref_ >= 0) {
+        error_ = "the state is not open or already has a chunk";
+        return false;
+    }
+    if (luaL_loadbuffer(state_, source.data(), source.size(), chunk_name.c_str()) != 0) {
+        take_error();
+        return false;
+    }
+    chunk_ref_ = luaL_ref(state_, LUA_REGISTRYINDEX);
+    return true;
+}
+
+bool LuaState::dump(std::vector<std::uint8_t>& out) {
+    if (chunk_ref_ < 0) {
+        error_ = "no chunk is loaded";
+        return false;
+    }
+    lua_rawgeti(state_, LUA_REGISTRYINDEX, chunk_ref_);
+    const int status = lua_dump(state_, append_chunk, &out);
+    lua_pop(state_, 1);
+    return status == 0;
+}
+
+bool LuaState::bind(const std::string& entry) {
+    if (chunk_ref_ < 0) {
+        error_ = "no chunk is loaded";
+        return false;
+    }
+    if (entry.empty()) {
+        entry_ref_ = chunk_ref_;
+        return true;
+    }
+
+    // The top level runs once; only the function it defines stays referenced
+    lua_rawgeti(state_, LUA_REGISTRYINDEX, chunk_ref_);
+    if (lua_pcall(state_, 0, 0, kTracebackIndex) != 0) {
+        take_error();
+        return false;
+    }
+    lua_getglobal(state_, entry.c_str());
+    if (!lua_isfunction(state_, -1)) {
+        lua_pop(state_, 1);
+        error_ = std::format("the script defines no function '{}'", entry);
+        return false;
+    }
+    entry_ref_ = luaL_ref(state_, LUA_REGISTRYINDEX);
+    luaL_unref(state_, LUA_REGISTRYINDEX, chunk_ref_);
+    chunk_ref_ = -1;
+    return true;
+}
+
+bool LuaState::call() {
+    if (entry_ref_ < 0) {
+        error_ = "no function is bound";
+        return false;
+    }
+    lua_rawgeti(state_, LUA_REGISTRYINDEX, entry_ref_);
+    if (lua_pcall(state_, 0, 1, kTracebackIndex) != 0) {
+        take_error();
+        return false;
+    }
+
+    // Returning false fails the task (nil and anything else succeed)
+    const bool failed = lua_type(state_, -1) == LUA_TBOOLEAN && !lua_toboolean(state_, -1);
+    lua_pop(state_, 1);
+    if (failed) {
+        error_ = "the script returned false";
+        return false;
+    }
+    return true;
+}
+
+void* LuaState::allocate(void* user, void* block, std::size_t old_size, std::size_t new_size) noexcept {
+    auto& self = *static_cast<LuaState*>(user);
+
+    // Without a block, old_size encodes the object type rather than a size
+    const std::size_t old_bytes = block ? old_size : 0;
+    if (new_size == 0) {
+        std::free(block);
+        self.bytes_ -= old_bytes;
+        total_bytes_.fetch_sub(old_bytes, std::memory_order_relaxed);
+        return nullptr;
+    }
+    void* resized = std::realloc(block, new_size);
+    if (!resized) {
+        return nullptr;
+    }
+    self.bytes_ = self.bytes_ - old_bytes + new_size;
+    total_bytes_.fetch_add(new_size, std::memory_order_relaxed);
+    total_bytes_.fetch_sub(old_bytes, std::memory_order_relaxed);
+    return resized;
+}
+
+void LuaState::take_error() {
+    const char* message = lua_tostring(state_, -1);
+    error_ = message ? message : "unknown Lua error";
+    lua_pop(state_, 1);
+}
+
+} // namespace app_hook::script
@@ -0,0 +1,172 @@
+#include "../include/config/script_config_loader.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <toml++/toml.hpp>
+#include <filesystem>
+#include <format>
+
+namespace lua_plugin {
+
+std::vector<app_hook::config::ConfigType> ScriptConfigLoader::supported_types() const {
+    return {
+        app_hook::config::ConfigType::Script
+    };
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>>
+ScriptConfigLoader::load_configs(
+    app_hook::config::ConfigType type,
+    const std::string& file_path,
+    const std::string& task_name) {
+
+    if (type != app_hook::config::ConfigType::Script) {
+        PLUGIN_LOG_ERROR("ScriptConfigLoader: Unsupported config type: {}", static_cast<int>(type));
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+
+    PLUGIN_LOG_INFO("ScriptConfigLoader: Loading script configs from file: {} for task: {}", file_path, task_name);
+    if (!std::filesystem::exists(file_path)) {
+        PLUGIN_LOG_ERROR("ScriptConfigLoader: Config file not found: {}", file_path);
+        return std::unexpected(app_hook::config::ConfigError::file_not_found);
+    }
+
+    try {
+        auto config = toml::parse_file(file_path);
+        std::vector<app_hook::config::ConfigPtr> configs;
+
+        // Table format only: [script.item]
+        if (const auto* script_table = config["script"].as_table()) {
+            for (auto& [key, value] : *script_table) {
+                const auto* table = value.as_table();
+                if (!table) {
+                    PLUGIN_LOG_WARN("ScriptConfigLoader: Invalid script format for key: {}", std::string(key));
+                    continue;
+                }
+                if (auto script = parse_script(*table, task_name, std::string(key))) {
+                    configs.push_back(std::move(script));
+                } else {
+                    PLUGIN_LOG_WARN("ScriptConfigLoader: Failed to parse script: {}", std::string(key));
+                }
+            }
+        } else {
+            PLUGIN_LOG_DEBUG("ScriptConfigLoader: No script section found in config file");
+        }
+
+        PLUGIN_LOG_INFO("ScriptConfigLoader: Successfully loaded {} script configurations", configs.size());
+        return configs;
+    } catch (const toml::parse_error& e) {
+        PLUGIN_LOG_ERROR("ScriptConfigLoader: TOML parse error in file {}: {}", file_path, e.what());
+        return std::unexpected(app_hook::config::ConfigError::parse_error);
+    } catch (const std::exception& e) {
+        PLUGIN_LOG_ERROR("ScriptConfigLoader: Exception while loading configs from {}: {}", file_path, e.what());
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+}
+
+std::string ScriptConfigLoader::get_name() const {
+    return "Lua Script Loader";
+}
+
+std::string ScriptConfigLoader::get_version() const {
+    return "1.0.0";
+}
+
+std::uint32_t ScriptConfigLoader::cache_version() const {
+    return 1;
+}
+
+bool ScriptConfigLoader::serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs,
+                                           app_hook::util::ByteWriter& out) const {
+    out.write(static_cast<std::uint32_t>(configs.size()));
+    for (const auto& config : configs) {
+        const auto* script_config = dynamic_cast<const app_hook::config::ScriptConfig*>(config.get());
+        if (!script_config) {
+            return false;
+        }
+        app_hook::config::write_config_base(out, *script_config);
+        out.write_string(script_config->script_path());
+        out.write_string(script_config->entry());
+        out.write(static_cast<std::uint64_t>(script_config->hook_address()));
+    }
+    return true;
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>>
+ScriptConfigLoader::deserialize_configs(
+    app_hook::config::ConfigType type,
+    app_hook::util::ByteReader& in,
+    const std::string& task_name) {
+
+    std::uint32_t count = 0;
+    if (type != app_hook::config::ConfigType::Script || !in.read(count)) {
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+
+    std::vector<app_hook::config::ConfigPtr> configs;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        std::string name;
+        if (!app_hook::config::read_config_identity(in, key, name)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        auto script_config = std::make_shared<app_hook::config::ScriptConfig>(std::move(key), std::move(name));
+
+        std::string script_path;
+        std::string entry;
+        std::uint64_t hook_address = 0;
+        if (!app_hook::config::read_config_fields(in, *script_config) || !in.read_string(script_path) ||
+            !in.read_string(entry) || !in.read(hook_address)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        script_config->set_script_path(std::move(script_path));
+        script_config->set_entry(std::move(entry));
+        script_config->set_hook_address(static_cast<std::uintptr_t>(hook_address));
+        configs.push_back(std::move(script_config));
+    }
+
+    PLUGIN_LOG_DEBUG("ScriptConfigLoader: Restored {} script configs for task {} from cache", configs.size(), task_name);
+    return configs;
+}
+
+app_hook::config::ConfigPtr ScriptConfigLoader::parse_script(const toml::table& table, const std::string& task_name,
+                                                             const std::string& config_name) {
+    auto config = app_hook::config::make_config<app_hook::config::ScriptConfig>(
+        task_name + "_" + config_name, config_name);
+    auto* script_config = static_cast<app_hook::config::ScriptConfig*>(config.get());
+
+    // Parse required field: script (the .lua file)
+    auto script = table["script"].value<std::string>();
+    if (!script || script->empty()) {
+        PLUGIN_LOG_ERROR("ScriptConfigLoader: Missing or invalid script field in script: {}", config_name);
+        return nullptr;
+    }
+    script_config->set_script_path(std::move(*script));
+
+    // function: global called on each trigger once the chunk ran; without it the chunk is the hook
+    if (auto entry = table["function"].value<std::string>()) {
+        script_config->set_entry(std::move(*entry));
+    }
+
+    // hookAddress: the script hooks this address itself instead of following its parent task
+    if (auto address = table["hookAddress"].value<std::string>()) {
+        try {
+            script_config->set_hook_address(app_hook::config::ConfigParsingUtils::parse_address(*address));
+        } catch (const std::exception&) {
+            PLUGIN_LOG_ERROR("ScriptConfigLoader: Invalid hookAddress '{}' in script: {}", *address, config_name);
+            return nullptr;
+        }
+    }
+
+    if (auto description = table["description"].value<std::string>()) {
+        script_config->set_description(std::move(*description));
+    }
+    if (auto read_from_context = table["readFromContext"].value<std::string>()) {
+        script_config->set_read_from_context(std::move(*read_from_context));
+    }
+
+    PLUGIN_LOG_DEBUG("ScriptConfigLoader: Parsed script '{}': {}{}", config_name, script_config->script_path(),
+                     script_config->hook_address() ? std::format(" hooked at 0x{:X}", script_config->hook_address())
+                                                   : std::string{});
+    return config;
+}
+
+} // namespace lua_plugin
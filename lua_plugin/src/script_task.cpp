@@ -0,0 +1,170 @@
+#include "../include/script/script_task.hpp"
+#include "../include/script/chunk_cache.hpp"
+#include "../../core_hook/include/context/mod_context.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <fstream>
+#include <iterator>
+
+namespace app_hook::script {
+
+bool ScriptTask::prepare() {
+    std::lock_guard lock(mutex_);
+    auto state = compile(config_);
+    if (!state) {
+        failed_ = true;
+        return false;
+    }
+    state_ = std::move(*state);
+    return true;
+}
+
+task::TaskResult ScriptTask::execute() {
+    std::lock_guard lock(mutex_);
+    PLUGIN_LOG_DEBUG("Executing ScriptTask for key '{}'", config_.key());
+
+    if (!config_.is_valid()) {
+        PLUGIN_LOG_ERROR("Invalid configuration for ScriptTask '{}'", config_.key());
+        return std::unexpected(task::TaskError::invalid_config);
+    }
+
+    // Tasks not created through the plugin compile on their first trigger
+    if (!state_) {
+        if (failed_) {
+            return std::unexpected(task::TaskError::script_error);
+        }
+        auto state = compile(config_);
+        if (!state) {
+            failed_ = true;
+            return std::unexpected(state.error());
+        }
+        state_ = std::move(*state);
+    }
+
+    // The first trigger runs the script's setup, which may read the context
+    if (!state_->ready() && !state_->bind(config_.entry())) {
+        PLUGIN_LOG_ERROR("Script '{}' of task '{}' failed to start: {}",
+                         config_.script_path(), config_.key(), state_->last_error());
+        state_.reset();
+        failed_ = true;
+        return std::unexpected(task::TaskError::script_error);
+    }
+
+    // A failed call keeps the state: the next trigger may find what this one missed
+    if (!state_->call()) {
+        PLUGIN_LOG_ERROR("Script '{}' of task '{}' failed: {}",
+                         config_.script_path(), config_.key(), state_->last_error());
+        return std::unexpected(task::TaskError::script_error);
+    }
+    return {};
+}
+
+task::ReloadOutcome ScriptTask::reload(const config::ConfigBase& updated) {
+    if (updated.type_id() != ScriptConfig::kTypeId) {
+        return task::ReloadOutcome::restart_required;
+    }
+    const auto& script_config = static_cast<const ScriptConfig&>(updated);
+
+    std::lock_guard lock(mutex_);
+    if (script_config.hook_address() != config_.hook_address()) {
+        return task::ReloadOutcome::restart_required;
+    }
+    if (script_config.script_path() == config_.script_path() && script_config.entry() == config_.entry() &&
+        script_config.read_from_context() == config_.read_from_context() &&
+        script_config.description() == config_.description()) {
+        return task::ReloadOutcome::unchanged;
+    }
+
+    // The running state is only replaced by one that compiled
+    auto state = compile(script_config);
+    if (!state) {
+        return task::ReloadOutcome::restart_required;
+    }
+    config_ = script_config;
+    state_ = std::move(*state);
+    failed_ = false;
+    PLUGIN_LOG_INFO("Reloaded script task '{}': {}", config_.key(), config_.script_path());
+    return task::ReloadOutcome::updated;
+}
+
+std::vector<std::string> ScriptTask::watched_files() const {
+    std::lock_guard lock(mutex_);
+    return {config_.script_path()};
+}
+
+task::ReloadOutcome ScriptTask::refresh_file(const std::string& path) {
+    std::lock_guard lock(mutex_);
+    PLUGIN_LOG_INFO("Script '{}' of task '{}' changed", path, config_.key());
+
+    // The bundled copy is stale from now on
+    read_file_ = true;
+    auto state = compile(config_);
+    if (!state) {
+        return task::ReloadOutcome::restart_required;
+    }
+    state_ = std::move(*state);
+    failed_ = false;
+    return task::ReloadOutcome::updated;
+}
+
+std::expected<std::unique_ptr<LuaState>, task::TaskError> ScriptTask::compile(const ScriptConfig& config) {
+    auto& context = host_ ? host_->get_mod_context() : context::ModContext::instance();
+    auto state = std::make_unique<LuaState>();
+    if (!state->open(context, host_, config.read_from_context())) {
+        PLUGIN_LOG_ERROR("Failed to open a Lua state for task '{}': {}", config.key(), state->last_error());
+        return std::unexpected(task::TaskError::script_error);
+    }
+    const auto chunk_name = "@" + config.script_path();
+
+    // Chunks loaded at startup were checked against the script's current source
+    auto& chunks = ChunkCache::instance();
+    if (const auto cached = read_file_ ? nullptr : chunks.find(config.script_path())) {
+        if (state->load({reinterpret_cast<const char*>(cached->data()), cached->size()}, chunk_name)) {
+            PLUGIN_LOG_DEBUG("Loaded cached chunk of script '{}' for task '{}'", config.script_path(), config.key());
+            return state;
+        }
+        PLUGIN_LOG_WARN("Cached chunk of script '{}' is corrupt - compiling the script", config.script_path());
+    }
+
+    // Scripts packed into the mod bundle are compiled from its view
+    const auto packed = host_ && !read_file_ ? host_->bundle_blob(config.script_path())
+                                             : std::span<const std::uint8_t>{};
+    std::string text;
+    std::span<const char> source{reinterpret_cast<const char*>(packed.data()), packed.size()};
+    if (packed.empty()) {
+        std::ifstream file(config.script_path(), std::ios::binary);
+        if (!file) {
+            PLUGIN_LOG_ERROR("Script file '{}' of task '{}' not found", config.script_path(), config.key());
+            return std::unexpected(task::TaskError::file_not_found);
+        }
+        text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (file.bad()) {
+            PLUGIN_LOG_ERROR("Failed to read script file '{}' of task '{}'", config.script_path(), config.key());
+            return std::unexpected(task::TaskError::file_read_error);
+        }
+        source = text;
+    } else {
+        // The bundle packs the script's chunk next to it
+        const auto chunk = ChunkCache::decode(host_->bundle_blob(chunks.chunk_file(config.script_path())),
+                                              config.script_path(), ChunkCache::hash_source(source));
+        if (!chunk.empty() && state->load({reinterpret_cast<const char*>(chunk.data()), chunk.size()}, chunk_name)) {
+            PLUGIN_LOG_DEBUG("Loaded bundled chunk of script '{}' for task '{}'", config.script_path(), config.key());
+            return state;
+        }
+    }
+
+    if (!state->load(source, chunk_name)) {
+        PLUGIN_LOG_ERROR("Failed to compile script '{}' of task '{}': {}",
+                         config.script_path(), config.key(), state->last_error());
+        return std::unexpected(task::TaskError::script_error);
+    }
+    PLUGIN_LOG_DEBUG("Compiled script '{}' for task '{}'", config.script_path(), config.key());
+
+    // Keep the bytecode for the next launch
+    ChunkCache::Bytecode bytecode;
+    if (state->dump(bytecode) && !chunks.store(config.script_path(), source, std::move(bytecode))) {
+        PLUGIN_LOG_DEBUG("Compiled chunk of script '{}' was not cached", config.script_path());
+    }
+    return state;
+}
+
+} // namespace app_hook::script
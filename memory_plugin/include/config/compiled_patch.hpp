@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief Single instruction patch data
+/// @note Standalone form kept for callers building patches by hand; loaders
+///       produce a CompiledPatchSet instead.
+struct InstructionPatch {
+    std::uintptr_t address;                ///< Address to patch
+    std::vector<std::uint8_t> bytes;       ///< Instruction bytes with placeholders
+    std::int32_t offset;                   ///< Offset to apply to new memory base
+
+    /// @brief Check if this patch is valid
+    [[nodiscard]] constexpr bool is_valid() const noexcept {
+        return address != 0 && !bytes.empty();
+    }
+};
+
+/// @brief One instruction of a compiled patch set
+struct CompiledInstruction {
+    std::uintptr_t address;       ///< Address to patch
+    std::uint32_t pool_offset;    ///< Start of the instruction bytes in the pool
+    std::uint32_t length;         ///< Number of instruction bytes
+    std::uint32_t placeholder;    ///< Offset of the 4-byte address placeholder in the instruction
+    std::int32_t offset;          ///< Offset to apply to new memory base
+};
+
+/// @brief Run of instructions written as one contiguous block
+struct PatchSpan {
+    std::uintptr_t address;   ///< First byte of the block
+    std::uint32_t length;     ///< Bytes from the first instruction to the end of the last
+    std::uint32_t first;      ///< Index of the first instruction of the run
+    std::uint32_t count;      ///< Number of instructions in the run
+};
+
+/// @brief Difference between a compiled patch set and the set replacing it
+struct PatchSetDiff {
+    std::vector<CompiledInstruction> changed;  ///< Instructions of the new set that are new or differ
+    std::vector<CompiledInstruction> removed;  ///< Instructions of the old set with no counterpart or a shorter one
+};
+
+/// @brief Patch instructions flattened for application
+///
+/// The bytes of every instruction live in one contiguous pool and the address
+/// placeholder of each instruction is located once, at load time. Applying an
+/// instruction is a copy of its bytes followed by a store of the resolved
+/// address; literal 0xFF bytes are never mistaken for the placeholder.
+class CompiledPatchSet {
+public:
+    /// @brief Size of the address placeholder in bytes
+    static constexpr std::uint32_t kPlaceholderSize = 4;
+
+    /// @brief Reserve room for instructions and their bytes
+    /// @param instructions Expected instruction count
+    /// @param bytes Expected total byte count
+    void reserve(std::size_t instructions, std::size_t bytes) {
+        instructions_.reserve(instructions);
+        pool_.reserve(bytes);
+    }
+
+    /// @brief Add an instruction written as hex text, e.g. "8D 86 XX XX XX XX"
+    /// @param address Address to patch
+    /// @param hex Hex bytes; the first run of four "XX" marks the address placeholder
+    /// @param offset Offset to apply to new memory base
+    /// @return false if the text is not valid hex or has no placeholder (nothing is added)
+    bool add_hex(std::uintptr_t address, std::string_view hex, std::int32_t offset) {
+        const auto start = pool_.size();
+        std::uint32_t placeholder = kNoPlaceholder;
+        std::uint32_t pending_xx = 0;
+
+        for (std::size_t i = 0; i < hex.size();) {
+            const char c = hex[i];
+            if (c == ' ' || c == '\t' || c == ',') {
+                ++i;
+                continue;
+            }
+            if (i + 1 >= hex.size()) {
+                pool_.resize(start);
+                return false;
+            }
+
+            const char next = hex[i + 1];
+            if ((c == 'X' || c == 'x') && (next == 'X' || next == 'x')) {
+                pool_.push_back(0x00);
+                if (++pending_xx == kPlaceholderSize && placeholder == kNoPlaceholder) {
+                    placeholder = static_cast<std::uint32_t>(pool_.size() - start - kPlaceholderSize);
+                }
+            } else {
+                const int high = hex_digit(c);
+                const int low = hex_digit(next);
+                if (high < 0 || low < 0) {
+                    pool_.resize(start);
+                    return false;
+                }
+                pool_.push_back(static_cast<std::uint8_t>((high << 4) | low));
+                pending_xx = 0;
+            }
+            i += 2;
+        }
+
+        if (address == 0 || placeholder == kNoPlaceholder) {
+            pool_.resize(start);
+            return false;
+        }
+
+        instructions_.push_back(CompiledInstruction{
+            address, static_cast<std::uint32_t>(start), static_cast<std::uint32_t>(pool_.size() - start),
+            placeholder, offset});
+        return true;
+    }
+
+    /// @brief Add a standalone instruction patch
+    /// @param patch Patch whose placeholder is the first run of four 0xFF bytes
+    /// @return false if the patch is invalid or has no placeholder (nothing is added)
+    bool add(const InstructionPatch& patch) {
+        if (!patch.is_valid() || patch.bytes.size() < kPlaceholderSize) {
+            return false;
+        }
+
+        constexpr std::uint8_t marker[kPlaceholderSize] = {0xFF, 0xFF, 0xFF, 0xFF};
+        const auto it = std::search(patch.bytes.begin(), patch.bytes.end(), std::begin(marker), std::end(marker));
+        if (it == patch.bytes.end()) {
+            return false;
+        }
+
+        const auto start = static_cast<std::uint32_t>(pool_.size());
+        pool_.insert(pool_.end(), patch.bytes.begin(), patch.bytes.end());
+        instructions_.push_back(CompiledInstruction{
+            patch.address, start, static_cast<std::uint32_t>(patch.bytes.size()),
+            static_cast<std::uint32_t>(it - patch.bytes.begin()), patch.offset});
+        return true;
+    }
+
+    /// @brief Compile standalone instruction patches
+    /// @param patches Patches to compile (patches without a placeholder are dropped)
+    /// @return Compiled set
+    [[nodiscard]] static CompiledPatchSet compile(std::span<const InstructionPatch> patches) {
+        CompiledPatchSet set;
+        std::size_t bytes = 0;
+        for (const auto& patch : patches) {
+            bytes += patch.bytes.size();
+        }
+        set.reserve(patches.size(), bytes);
+        for (const auto& patch : patches) {
+            set.add(patch);
+        }
+        return set;
+    }
+
+    /// @brief Rebuild a set from its instructions and pool (config cache)
+    /// @param instructions Instructions referencing the pool
+    /// @param pool Byte pool
+    /// @return Rebuilt set, or nullopt if an instruction points outside the pool
+    [[nodiscard]] static std::optional<CompiledPatchSet> from_parts(std::vector<CompiledInstruction> instructions,
+                                                                    std::vector<std::uint8_t> pool) {
+        for (const auto& instruction : instructions) {
+            const auto end = std::uint64_t{instruction.pool_offset} + instruction.length;
+            if (end > pool.size() || instruction.length < kPlaceholderSize ||
+                instruction.placeholder > instruction.length - kPlaceholderSize) {
+                return std::nullopt;
+            }
+        }
+        CompiledPatchSet set;
+        set.instructions_ = std::move(instructions);
+        set.pool_ = std::move(pool);
+        return set;
+    }
+
+    /// @brief Order the instructions by target address
+    void sort_by_address() {
+        std::ranges::stable_sort(instructions_, {}, &CompiledInstruction::address);
+    }
+
+    /// @brief Compare a set with the set reloaded to replace it
+    /// @param before Set currently applied, sorted by address
+    /// @param after Reloaded set, sorted by address
+    /// @return Instructions of after to write (referencing after's pool) and those of before dropped
+    /// @note Instructions are matched by address, in order at equal addresses. An
+    ///       instruction replaced by a shorter one is listed in both: its old range is
+    ///       restored first, so no byte past the new end stays patched
+    [[nodiscard]] static PatchSetDiff diff(const CompiledPatchSet& before, const CompiledPatchSet& after) {
+        PatchSetDiff result;
+        const auto old_instructions = before.instructions();
+        const auto new_instructions = after.instructions();
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < old_instructions.size() || j < new_instructions.size()) {
+            if (j == new_instructions.size() ||
+                (i < old_instructions.size() && old_instructions[i].address < new_instructions[j].address)) {
+                result.removed.push_back(old_instructions[i++]);
+            } else if (i == old_instructions.size() || new_instructions[j].address < old_instructions[i].address) {
+                result.changed.push_back(new_instructions[j++]);
+            } else {
+                const auto& old_instruction = old_instructions[i++];
+                const auto& new_instruction = new_instructions[j++];
+                if (new_instruction.length < old_instruction.length) {
+                    result.removed.push_back(old_instruction);
+                    result.changed.push_back(new_instruction);
+                } else if (old_instruction.placeholder != new_instruction.placeholder ||
+                    old_instruction.offset != new_instruction.offset ||
+                    !std::ranges::equal(before.bytes(old_instruction), after.bytes(new_instruction))) {
+                    result.changed.push_back(new_instruction);
+                }
+            }
+        }
+        return result;
+    }
+
+    /// @brief Group instructions whose bytes touch or nearly touch into spans
+    /// @param instructions Instructions sorted by address
+    /// @param max_gap Largest run of untouched bytes allowed between two instructions of a span
+    /// @return Spans in address order; overlapping instructions always share a span
+    [[nodiscard]] static std::vector<PatchSpan> coalesce(std::span<const CompiledInstruction> instructions,
+                                                         std::uintptr_t max_gap) {
+        std::vector<PatchSpan> spans;
+        std::uintptr_t end = 0;
+        for (std::size_t i = 0; i < instructions.size(); ++i) {
+            const auto& instruction = instructions[i];
+            const auto instruction_end = instruction.address + instruction.length;
+            if (!spans.empty() && instruction.address <= end + max_gap) {
+                auto& span = spans.back();
+                end = std::max(end, instruction_end);
+                span.length = static_cast<std::uint32_t>(end - span.address);
+                ++span.count;
+                continue;
+            }
+            spans.push_back(PatchSpan{instruction.address, instruction.length, static_cast<std::uint32_t>(i), 1});
+            end = instruction_end;
+        }
+        return spans;
+    }
+
+    /// @brief Get the compiled instructions
+    [[nodiscard]] std::span<const CompiledInstruction> instructions() const noexcept { return instructions_; }
+
+    /// @brief Get the bytes of an instruction (placeholder left zeroed)
+    /// @param instruction Instruction of this set
+    [[nodiscard]] std::span<const std::uint8_t> bytes(const CompiledInstruction& instruction) const noexcept {
+        return std::span(pool_).subspan(instruction.pool_offset, instruction.length);
+    }
+
+    /// @brief Get the byte pool shared by all instructions
+    [[nodiscard]] std::span<const std::uint8_t> pool() const noexcept { return pool_; }
+
+    /// @brief Get the number of instructions
+    [[nodiscard]] std::size_t size() const noexcept { return instructions_.size(); }
+
+    /// @brief Get the heap bytes held by the instructions and the pool
+    [[nodiscard]] std::size_t heap_bytes() const noexcept {
+        return instructions_.capacity() * sizeof(CompiledInstruction) + pool_.capacity();
+    }
+
+    /// @brief Check if the set has no instructions
+    [[nodiscard]] bool empty() const noexcept { return instructions_.empty(); }
+
+    /// @brief Give back the capacity reserved while compiling
+    void shrink_to_fit() {
+        instructions_.shrink_to_fit();
+        pool_.shrink_to_fit();
+    }
+
+private:
+    static constexpr std::uint32_t kNoPlaceholder = ~std::uint32_t{0};
+
+    [[nodiscard]] static constexpr int hex_digit(char c) noexcept {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        return -1;
+    }
+
+    std::vector<CompiledInstruction> instructions_;
+    std::vector<std::uint8_t> pool_;
+};
+
+} // namespace app_hook::config
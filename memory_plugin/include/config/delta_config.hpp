@@ -0,0 +1,124 @@
+#pragma once
+
+#include <config/config_base.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief One edit of a delta: bytes written at an offset of the region
+struct DeltaEdit {
+    std::uint32_t offset;       ///< Offset from the region base
+    std::uint32_t pool_offset;  ///< Start of the edit's bytes in the pool
+    std::uint32_t length;       ///< Number of bytes written
+
+    [[nodiscard]] bool operator==(const DeltaEdit&) const noexcept = default;
+};
+
+/// @brief Configuration for byte edits applied on top of a region in the mod context
+///
+/// A delta carries only the fields a mod changes instead of a whole table. Its
+/// edits are kept in one byte pool, like compiled patches. Several deltas may
+/// target the same region; they are applied in task order.
+class DeltaConfig : public ConfigBase {
+public:
+    /// @brief Type ID the task creator is registered under
+    static constexpr std::string_view kTypeId = "app_hook::config::DeltaConfig";
+    /// @brief Config type, the slot of the built-in task creator
+    static constexpr ConfigType kConfigType = ConfigType::Delta;
+
+    /// @brief Constructor
+    /// @param key Configuration key
+    /// @param name Display name
+    DeltaConfig(std::string key, std::string name)
+        : ConfigBase(kConfigType, std::move(key), std::move(name))
+        , edits_{}
+        , pool_{} {}
+
+    /// @brief Default destructor
+    ~DeltaConfig() override = default;
+
+    /// @brief Get the stable type ID
+    [[nodiscard]] std::string_view type_id() const noexcept override { return kTypeId; }
+
+    // Accessors following C++23 conventions
+    [[nodiscard]] const std::vector<DeltaEdit>& edits() const noexcept { return edits_; }
+    [[nodiscard]] const std::vector<std::uint8_t>& pool() const noexcept { return pool_; }
+
+    /// @brief Get the bytes of an edit
+    [[nodiscard]] std::span<const std::uint8_t> bytes(const DeltaEdit& edit) const noexcept {
+        return {pool_.data() + edit.pool_offset, edit.length};
+    }
+
+    /// @brief Get the end of the furthest edit, the region size the delta needs
+    [[nodiscard]] std::size_t extent() const noexcept {
+        std::size_t end = 0;
+        for (const auto& edit : edits_) {
+            end = std::max<std::size_t>(end, static_cast<std::size_t>(edit.offset) + edit.length);
+        }
+        return end;
+    }
+
+    /// @brief Add an edit
+    /// @param offset Offset from the region base
+    /// @param bytes Bytes to write (not empty)
+    /// @return False if the edit is empty
+    bool add_edit(std::uint32_t offset, std::span<const std::uint8_t> bytes) {
+        if (bytes.empty()) {
+            return false;
+        }
+        edits_.push_back(DeltaEdit{offset, static_cast<std::uint32_t>(pool_.size()), static_cast<std::uint32_t>(bytes.size())});
+        pool_.insert(pool_.end(), bytes.begin(), bytes.end());
+        return true;
+    }
+
+    /// @brief Replace the edits with restored ones
+    /// @param edits Edits pointing into the pool
+    /// @param pool Edit bytes
+    /// @return False (and nothing replaced) if an edit points outside the pool
+    bool set_edits(std::vector<DeltaEdit> edits, std::vector<std::uint8_t> pool) {
+        for (const auto& edit : edits) {
+            if (edit.length == 0 || edit.pool_offset > pool.size() || edit.length > pool.size() - edit.pool_offset) {
+                return false;
+            }
+        }
+        edits_ = std::move(edits);
+        pool_ = std::move(pool);
+        return true;
+    }
+
+    /// @brief Check if this configuration is valid
+    /// @return True if the delta targets a region and has edits
+    [[nodiscard]] bool is_valid() const noexcept override {
+        return ConfigBase::is_valid() && reads_from_context() && !edits_.empty();
+    }
+
+    /// @brief Get the memory held by this configuration
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept override {
+        return sizeof(*this) + heap_bytes() + edits_.capacity() * sizeof(DeltaEdit) + pool_.capacity();
+    }
+
+    /// @brief Shrink the strings, the edits and their byte pool
+    void compact() override {
+        ConfigBase::compact();
+        edits_.shrink_to_fit();
+        pool_.shrink_to_fit();
+    }
+
+    /// @brief Get debug string representation
+    /// @return Debug string with delta-specific information
+    [[nodiscard]] std::string debug_string() const override {
+        return ConfigBase::debug_string() +
+               " edits=" + std::to_string(edits_.size()) +
+               " bytes=" + std::to_string(pool_.size());
+    }
+
+private:
+    std::vector<DeltaEdit> edits_;     ///< Edits in file order
+    std::vector<std::uint8_t> pool_;   ///< Bytes of every edit
+};
+
+} // namespace app_hook::config
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <config/config_loader_base.hpp>
+#include "delta_config.hpp"
+#include <memory>
+#include <optional>
+#include <toml++/toml.hpp>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace memory_plugin {
+
+/// @brief Delta configuration loader
+/// @note Implements ConfigLoaderBase to provide delta configuration loading only
+class DeltaConfigLoader : public app_hook::config::ConfigLoaderBase {
+public:
+    DeltaConfigLoader() = default;
+    ~DeltaConfigLoader() override = default;
+
+    /// @brief Set the plugin host for logging
+    void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
+
+    // ConfigLoaderBase interface
+    std::vector<app_hook::config::ConfigType> supported_types() const override;
+    
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> load_configs(
+        app_hook::config::ConfigType type, 
+        const std::string& file_path, 
+        const std::string& task_name
+    ) override;
+
+    std::string get_name() const override;
+    std::string get_version() const override;
+    
+    // Config cache hooks
+    std::uint32_t cache_version() const override;
+    bool serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                           app_hook::util::ByteWriter& out) const override;
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> deserialize_configs(
+        app_hook::config::ConfigType type, 
+        app_hook::util::ByteReader& in, 
+        const std::string& task_name
+    ) override;
+
+private:
+    /// @brief Parse a single delta from TOML
+    app_hook::config::ConfigPtr parse_delta(const toml::table& table, const std::string& task_name,
+                                            const std::string& config_name);
+
+    /// @brief Parse hex bytes written as pairs, e.g. "20 00 FF"
+    /// @return Bytes, or nullopt if a pair is not hex
+    static std::optional<std::vector<std::uint8_t>> parse_hex(std::string_view hex);
+
+    /// @brief Plugin host for logging
+    app_hook::plugin::IPluginHost* host_ = nullptr;
+};
+
+} // namespace memory_plugin
@@ -1,28 +1,61 @@
 #pragma once
 
 #include <config/config_base.hpp>
+#include <optional>
 #include <string>
+#include <vector>
 #include <cstdint>
 
 namespace app_hook::config {
 
+/// @brief How a LoadInMemory task reads its binary
+enum class BinaryReadMode {
+    stream,  ///< Read through a file stream into a buffer (default)
+    mapped   ///< Map the file and copy straight from the view
+};
+
+/// @brief Codec a LoadInMemory binary was compressed with
+enum class BinaryCompression {
+    none,  ///< Raw bytes, copied as is (default)
+    lz4,   ///< LZ4 frame with its content size recorded
+    zstd   ///< Zstandard frames with their content size recorded
+};
+
 /// @brief Configuration for loading binary data into memory
 class LoadInMemoryConfig : public ConfigBase {
 public:
+    /// @brief Type ID the task creator is registered under
+    static constexpr std::string_view kTypeId = "app_hook::config::LoadInMemoryConfig";
+    /// @brief Config type, the slot of the built-in task creator
+    static constexpr ConfigType kConfigType = ConfigType::Load;
+
     /// @brief Constructor
     /// @param key Configuration key
     /// @param name Display name
     LoadInMemoryConfig(std::string key, std::string name)
-        : ConfigBase(ConfigType::Load, std::move(key), std::move(name))
+        : ConfigBase(kConfigType, std::move(key), std::move(name))
         , binary_path_{}
-        , offset_security_(0) {}
+        , offset_security_(0)
+        , preload_(true)
+        , read_mode_(BinaryReadMode::stream)
+        , compression_(BinaryCompression::none)
+        , verify_(false)
+        , checksum_{} {}
+
+    /// @brief Get the stable type ID
+    [[nodiscard]] std::string_view type_id() const noexcept override { return kTypeId; }
 
     /// @brief Copy constructor
     /// @param other Another LoadInMemoryConfig to copy from
     LoadInMemoryConfig(const LoadInMemoryConfig& other)
-        : ConfigBase(ConfigType::Load, other.key(), other.name())
+        : ConfigBase(kConfigType, other.key(), other.name())
         , binary_path_(other.binary_path_)
-        , offset_security_(other.offset_security_) {
+        , offset_security_(other.offset_security_)
+        , preload_(other.preload_)
+        , read_mode_(other.read_mode_)
+        , compression_(other.compression_)
+        , verify_(other.verify_)
+        , checksum_(other.checksum_) {
         set_description(other.description());
         set_enabled(other.enabled());
         set_write_in_context(other.write_in_context());
@@ -35,10 +68,20 @@ public:
     // Accessors following C++23 conventions
     [[nodiscard]] const std::string& binary_path() const noexcept { return binary_path_; }
     [[nodiscard]] constexpr std::uintptr_t offset_security() const noexcept { return offset_security_; }
+    [[nodiscard]] constexpr bool preload() const noexcept { return preload_; }
+    [[nodiscard]] constexpr BinaryReadMode read_mode() const noexcept { return read_mode_; }
+    [[nodiscard]] constexpr BinaryCompression compression() const noexcept { return compression_; }
+    [[nodiscard]] constexpr bool verify() const noexcept { return verify_; }
+    [[nodiscard]] constexpr const std::optional<std::uint32_t>& checksum() const noexcept { return checksum_; }
 
     // Mutators
     void set_binary_path(std::string path) { binary_path_ = std::move(path); }
     void set_offset_security(std::uintptr_t offset) noexcept { offset_security_ = offset; }
+    void set_preload(bool preload) noexcept { preload_ = preload; }
+    void set_read_mode(BinaryReadMode mode) noexcept { read_mode_ = mode; }
+    void set_compression(BinaryCompression compression) noexcept { compression_ = compression; }
+    void set_verify(bool verify) noexcept { verify_ = verify; }
+    void set_checksum(std::optional<std::uint32_t> checksum) noexcept { checksum_ = checksum; }
 
     /// @brief Check if this configuration is valid
     /// @return True if all required fields are properly set
@@ -46,6 +89,20 @@ public:
         return ConfigBase::is_valid() && !binary_path_.empty();
     }
 
+    /// @brief Get the memory held by this configuration
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept override {
+        return sizeof(*this) + heap_bytes() + binary_path_.capacity();
+    }
+
+    /// @brief Shrink the strings
+    void compact() override {
+        ConfigBase::compact();
+        binary_path_.shrink_to_fit();
+    }
+
+    /// @brief Get the binary, packed into mod bundles
+    [[nodiscard]] std::vector<std::string> data_files() const override { return {binary_path_}; }
+
     /// @brief Get debug string representation
     /// @return Debug string with load-specific information
     [[nodiscard]] std::string debug_string() const override {
@@ -57,6 +114,11 @@ public:
 private:
     std::string binary_path_;              ///< Path to the binary file to load
     std::uintptr_t offset_security_;       ///< Security offset to apply when loading
+    bool preload_;                         ///< Stage the binary in the background at install time
+    BinaryReadMode read_mode_;             ///< How the binary is read when not staged
+    BinaryCompression compression_;        ///< Codec the binary is decoded with on injection
+    bool verify_;                          ///< Check the injected bytes with CRC32C
+    std::optional<std::uint32_t> checksum_; ///< Expected CRC32C of the injected bytes
 };
 
 } // namespace app_hook::config 
\ No newline at end of file
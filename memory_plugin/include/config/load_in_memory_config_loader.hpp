@@ -32,6 +32,16 @@ public:
 
     std::string get_name() const override;
     std::string get_version() const override;
+    
+    // Config cache hooks
+    std::uint32_t cache_version() const override;
+    bool serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                           app_hook::util::ByteWriter& out) const override;
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> deserialize_configs(
+        app_hook::config::ConfigType type, 
+        app_hook::util::ByteReader& in, 
+        const std::string& task_name
+    ) override;
 
 private:
     /// @brief Load load in memory configurations from file
@@ -44,6 +54,9 @@ private:
     /// @brief Parse address string (supports hex format)
     static std::uintptr_t parse_address(const std::string& value);
 
+    /// @brief Check if the mod bundle holds a binary (it is then not staged)
+    bool packed(const std::string& binary_path) const;
+
     /// @brief Plugin host for logging
     app_hook::plugin::IPluginHost* host_ = nullptr;
 };
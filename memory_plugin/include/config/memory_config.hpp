@@ -4,30 +4,54 @@
 #include <string>
 #include <cstdint>
 #include <optional>
+#include <vector>
 
 namespace app_hook::config {
 
 /// @brief Configuration for memory copy operations
 class CopyMemoryConfig : public ConfigBase, public AddressTrigger {
 public:
+    /// @brief Type ID the task creator is registered under
+    static constexpr std::string_view kTypeId = "app_hook::config::CopyMemoryConfig";
+    /// @brief Config type, the slot of the built-in task creator
+    static constexpr ConfigType kConfigType = ConfigType::Memory;
+
+    /// @brief Alignment of the expanded region when the config does not set one
+    static constexpr std::size_t kDefaultAlignment = 16;
+
     /// @brief Constructor
     /// @param key Configuration key
     /// @param name Display name
     CopyMemoryConfig(std::string key, std::string name)
-        : ConfigBase(ConfigType::Memory, std::move(key), std::move(name))
+        : ConfigBase(kConfigType, std::move(key), std::move(name))
         , address_(0)
         , copy_after_(0)
         , original_size_(0)
-        , new_size_(0) {}
+        , new_size_(0)
+        , alignment_(kDefaultAlignment)
+        , reserve_size_(0)
+        , sample_accesses_(false)
+        , snapshots_(false)
+        , rebase_self_(false)
+        , rebase_from_{} {}
+
+    /// @brief Get the stable type ID
+    [[nodiscard]] std::string_view type_id() const noexcept override { return kTypeId; }
 
     /// @brief Copy constructor
     /// @param other Another CopyMemoryConfig to copy from
     CopyMemoryConfig(const CopyMemoryConfig& other)
-        : ConfigBase(ConfigType::Memory, other.key(), other.name())
+        : ConfigBase(kConfigType, other.key(), other.name())
         , address_(other.address_)
         , copy_after_(other.copy_after_)
         , original_size_(other.original_size_)
-        , new_size_(other.new_size_) {
+        , new_size_(other.new_size_)
+        , alignment_(other.alignment_)
+        , reserve_size_(other.reserve_size_)
+        , sample_accesses_(other.sample_accesses_)
+        , snapshots_(other.snapshots_)
+        , rebase_self_(other.rebase_self_)
+        , rebase_from_(other.rebase_from_) {
         set_description(other.description());
         set_enabled(other.enabled());
         set_write_in_context(other.write_in_context());
@@ -42,12 +66,38 @@ public:
     [[nodiscard]] constexpr std::uintptr_t copy_after() const noexcept { return copy_after_; }
     [[nodiscard]] constexpr std::size_t original_size() const noexcept { return original_size_; }
     [[nodiscard]] constexpr std::size_t new_size() const noexcept { return new_size_; }
+    [[nodiscard]] constexpr std::size_t alignment() const noexcept { return alignment_; }
+    [[nodiscard]] constexpr std::size_t reserve_size() const noexcept { return reserve_size_; }
+    
+    /// @brief Check if the region is reserved large and committed as it fills
+    [[nodiscard]] constexpr bool is_growable() const noexcept { return reserve_size_ != 0; }
+    
+    /// @brief Check if accesses to the old bytes are sampled once the region is copied
+    [[nodiscard]] constexpr bool sample_accesses() const noexcept { return sample_accesses_; }
+    
+    /// @brief Check if the region's pages are write-watched for incremental snapshots
+    [[nodiscard]] constexpr bool snapshots() const noexcept { return snapshots_; }
+    
+    /// @brief Check if pointers into the old bytes are moved to the new region while copying
+    [[nodiscard]] constexpr bool rebase_self() const noexcept { return rebase_self_; }
+    
+    /// @brief Get the context names of the copied regions whose pointers are moved too
+    [[nodiscard]] const std::vector<std::string>& rebase_from() const noexcept { return rebase_from_; }
+    
+    /// @brief Check if the copy rewrites any pointers
+    [[nodiscard]] bool rebases() const noexcept { return rebase_self_ || !rebase_from_.empty(); }
 
     // Mutators
     void set_address(std::uintptr_t addr) noexcept { address_ = addr; }
     void set_copy_after(std::uintptr_t addr) noexcept { copy_after_ = addr; }
     void set_original_size(std::size_t size) noexcept { original_size_ = size; }
     void set_new_size(std::size_t size) noexcept { new_size_ = size; }
+    void set_alignment(std::size_t alignment) noexcept { alignment_ = alignment; }
+    void set_reserve_size(std::size_t size) noexcept { reserve_size_ = size; }
+    void set_sample_accesses(bool sample) noexcept { sample_accesses_ = sample; }
+    void set_snapshots(bool snapshots) noexcept { snapshots_ = snapshots; }
+    void set_rebase_self(bool rebase) noexcept { rebase_self_ = rebase; }
+    void set_rebase_from(std::vector<std::string> regions) { rebase_from_ = std::move(regions); }
 
     // AddressTrigger interface implementation
     /// @brief Get the hook address for this memory configuration
@@ -61,7 +111,23 @@ public:
     [[nodiscard]] bool is_valid() const noexcept override {
         return ConfigBase::is_valid() && 
                address_ != 0 && copy_after_ != 0 && 
-               original_size_ > 0 && new_size_ >= original_size_;
+               original_size_ > 0 && new_size_ >= original_size_ &&
+               (reserve_size_ == 0 || reserve_size_ >= new_size_);
+    }
+
+    /// @brief Get the memory held by this configuration
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept override {
+        std::size_t regions = rebase_from_.capacity() * sizeof(std::string);
+        for (const auto& region : rebase_from_) {
+            regions += region.capacity();
+        }
+        return sizeof(*this) + heap_bytes() + regions;
+    }
+
+    /// @brief Shrink the strings and the rebased region names
+    void compact() override {
+        ConfigBase::compact();
+        rebase_from_.shrink_to_fit();
     }
 
     /// @brief Get debug string representation
@@ -70,7 +136,9 @@ public:
         return ConfigBase::debug_string() + 
                " addr=0x" + std::to_string(address_) +
                " copy_after=0x" + std::to_string(copy_after_) +
-               " size=" + std::to_string(original_size_) + "->" + std::to_string(new_size_);
+               " size=" + std::to_string(original_size_) + "->" + std::to_string(new_size_) +
+               (reserve_size_ ? " reserve=" + std::to_string(reserve_size_) : std::string{}) +
+               (rebases() ? " rebase=" + std::to_string(rebase_from_.size() + (rebase_self_ ? 1 : 0)) : std::string{});
     }
 
 private:
@@ -78,6 +146,12 @@ private:
     std::uintptr_t copy_after_;                ///< Address after which to place new memory
     std::size_t original_size_;                ///< Original size of the memory region
     std::size_t new_size_;                     ///< New size for the expanded memory region
+    std::size_t alignment_;                    ///< Alignment of the expanded region (power of two)
+    std::size_t reserve_size_;                 ///< Address space the region may grow into (0: fixed size)
+    bool sample_accesses_;                     ///< Diagnostic: sample accesses to the old bytes
+    bool snapshots_;                           ///< Allocate with MEM_WRITE_WATCH for RegionSnapshots
+    bool rebase_self_;                         ///< Move pointers into the old bytes to the new region
+    std::vector<std::string> rebase_from_;     ///< Copied regions whose old pointers are moved as well
 };
 
 } // namespace app_hook::config 
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <config/config_loader_base.hpp>
 #include "memory_config.hpp"
+#include "signature_batch.hpp"
 #include <memory>
 #include <optional>
 #include <toml++/toml.hpp>
@@ -32,6 +33,16 @@ public:
 
     std::string get_name() const override;
     std::string get_version() const override;
+    
+    // Config cache hooks
+    std::uint32_t cache_version() const override;
+    bool serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                           app_hook::util::ByteWriter& out) const override;
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> deserialize_configs(
+        app_hook::config::ConfigType type, 
+        app_hook::util::ByteReader& in, 
+        const std::string& task_name
+    ) override;
 
 private:
     /// @brief Load memory configurations from file
@@ -39,7 +50,18 @@ private:
     load_memory_configs(const std::string& file_path, const std::string& task_name);
 
     /// @brief Parse a single memory operation from TOML
-    app_hook::config::ConfigPtr parse_memory_operation(const toml::node& op, const std::string& task_name, const std::string& config_name = "");
+    /// @param signatures Resolved symbols and patterns of the file's address fields
+    app_hook::config::ConfigPtr parse_memory_operation(const toml::node& op, const std::string& task_name,
+                                                       const SignatureBatch& signatures,
+                                                       const std::string& config_name = "");
+
+    /// @brief Read an address field, from the address map, its signature alternative or the literal value
+    /// @param table Memory operation table
+    /// @param field Address field ("address" or "copyAfter")
+    /// @param signatures Resolved symbols and patterns of the file
+    /// @return Address, or nullopt if the field is missing, invalid or its signature did not resolve
+    std::optional<std::uintptr_t> parse_address_field(const toml::table& table, const std::string& field,
+                                                      const SignatureBatch& signatures);
 
     /// @brief Parse address string (supports hex format)
     static std::uintptr_t parse_address(const std::string& value);
@@ -1,56 +1,79 @@
 #pragma once
 
 #include <config/config_base.hpp>
+#include "compiled_patch.hpp"
+#include <optional>
 #include <string>
 #include <vector>
 #include <cstdint>
 
 namespace app_hook::config {
 
-/// @brief Single instruction patch data
-struct InstructionPatch {
-    std::uintptr_t address;                ///< Address to patch
-    std::vector<std::uint8_t> bytes;       ///< Instruction bytes with placeholders
-    std::int32_t offset;                   ///< Offset to apply to new memory base
-    
-    /// @brief Check if this patch is valid
-    [[nodiscard]] constexpr bool is_valid() const noexcept {
-        return address != 0 && !bytes.empty();
-    }
-};
-
 /// @brief Configuration for instruction patches
 class PatchConfig : public ConfigBase {
 public:
+    /// @brief Type ID the task creator is registered under
+    static constexpr std::string_view kTypeId = "app_hook::config::PatchConfig";
+    /// @brief Config type, the slot of the built-in task creator
+    static constexpr ConfigType kConfigType = ConfigType::Patch;
+
     /// @brief Constructor
     /// @param key Configuration key
     /// @param name Display name
     PatchConfig(std::string key, std::string name)
-        : ConfigBase(ConfigType::Patch, std::move(key), std::move(name))
+        : ConfigBase(kConfigType, std::move(key), std::move(name))
         , patch_file_path_{}
-        , instructions_{} {}
+        , compiled_{} {}
 
     /// @brief Default destructor
     ~PatchConfig() override = default;
 
+    /// @brief Get the stable type ID
+    [[nodiscard]] std::string_view type_id() const noexcept override { return kTypeId; }
+
     // Accessors following C++23 conventions
     [[nodiscard]] const std::string& patch_file_path() const noexcept { return patch_file_path_; }
-    [[nodiscard]] const std::vector<InstructionPatch>& instructions() const noexcept { return instructions_; }
+    [[nodiscard]] const CompiledPatchSet& compiled() const noexcept { return compiled_; }
+    [[nodiscard]] constexpr const std::optional<std::uint32_t>& expected_original() const noexcept { return expected_original_; }
+    [[nodiscard]] constexpr bool allows_overlap() const noexcept { return allow_overlap_; }
 
     // Mutators
     void set_patch_file_path(std::string path) { patch_file_path_ = std::move(path); }
-    void set_instructions(std::vector<InstructionPatch> instructions) { 
-        instructions_ = std::move(instructions); 
+    void set_compiled(CompiledPatchSet compiled) { compiled_ = std::move(compiled); }
+    void set_expected_original(std::optional<std::uint32_t> checksum) noexcept { expected_original_ = checksum; }
+    void set_allow_overlap(bool allow) noexcept { allow_overlap_ = allow; }
+    void set_instructions(const std::vector<InstructionPatch>& instructions) { 
+        compiled_ = CompiledPatchSet::compile(instructions); 
     }
-    void add_instruction(InstructionPatch instruction) { 
-        instructions_.push_back(std::move(instruction)); 
+    bool add_instruction(const InstructionPatch& instruction) { 
+        return compiled_.add(instruction); 
     }
 
     /// @brief Check if this configuration is valid
     /// @return True if all required fields are properly set
     [[nodiscard]] bool is_valid() const noexcept override {
         return ConfigBase::is_valid() && 
-               (!patch_file_path_.empty() || !instructions_.empty());
+               (!patch_file_path_.empty() || !compiled_.empty());
+    }
+
+    /// @brief Get the memory held by this configuration
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept override {
+        return sizeof(*this) + heap_bytes() + patch_file_path_.capacity() + compiled_.heap_bytes();
+    }
+
+    /// @brief Shrink the strings and the compiled patches
+    void compact() override {
+        ConfigBase::compact();
+        patch_file_path_.shrink_to_fit();
+        compiled_.shrink_to_fit();
+    }
+
+    /// @brief Drop the compiled patches and shrink the remaining strings
+    /// @note Only for a config whose task keeps its own copy of the patches;
+    ///       is_valid() no longer holds for an inline patch list afterwards
+    void release_patches() {
+        compiled_ = {};
+        compact();
     }
 
     /// @brief Get debug string representation
@@ -58,12 +81,15 @@ public:
     [[nodiscard]] std::string debug_string() const override {
         return ConfigBase::debug_string() + 
                " patch_file=" + patch_file_path_ +
-               " instructions=" + std::to_string(instructions_.size());
+               " instructions=" + std::to_string(compiled_.size()) +
+               (allow_overlap_ ? " overlap=warn" : "");
     }
 
 private:
     std::string patch_file_path_;              ///< Path to the patch TOML file
-    std::vector<InstructionPatch> instructions_;  ///< Loaded instruction patches
+    CompiledPatchSet compiled_;                ///< Loaded instruction patches
+    std::optional<std::uint32_t> expected_original_; ///< CRC32C of the code under the patches, in address order
+    bool allow_overlap_ = false;               ///< Load even if other sets write some of the same bytes
 };
 
 } // namespace app_hook::config 
\ No newline at end of file
@@ -2,12 +2,13 @@
 
 #include <config/config_loader_base.hpp>
 #include "patch_config.hpp"
+#include "signature_batch.hpp"
 #include <toml++/toml.hpp>
 #include <vector>
 #include <string>
-#include <regex>
 #include <algorithm>
 #include <optional>
+#include <span>
 
 // Forward declaration
 namespace app_hook::plugin { class IPluginHost; }
@@ -35,18 +36,51 @@ public:
 
     std::string get_name() const override;
     std::string get_version() const override;
+    
+    // Config cache hooks
+    std::uint32_t cache_version() const override;
+    bool serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                           app_hook::util::ByteWriter& out) const override;
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> deserialize_configs(
+        app_hook::config::ConfigType type, 
+        app_hook::util::ByteReader& in, 
+        const std::string& task_name
+    ) override;
+
+    /// @brief Add a patch for every dword of some code that points into a table
+    /// @param code Code bytes to scan
+    /// @param code_address Address of the first code byte
+    /// @param address Original table address
+    /// @param size Original table size
+    /// @param excluded Dword addresses to leave alone
+    /// @param compiled Set receiving one 4-byte patch per reference; dwords inside
+    ///        its existing instructions are skipped
+    /// @return Number of patches added, or -1 if one could not be added
+    std::ptrdiff_t add_relocation_patches(std::span<const std::uint8_t> code, std::uintptr_t code_address,
+                                          std::uintptr_t address, std::uint32_t size,
+                                          std::span<const std::uintptr_t> excluded,
+                                          app_hook::config::CompiledPatchSet& compiled);
 
 private:
     /// @brief Load patch configurations from file
     app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
     load_patch_configs(const std::string& file_path, const std::string& task_name);
 
-    /// @brief Parse a single instruction entry from TOML
-    std::optional<app_hook::config::InstructionPatch> 
-    parse_single_instruction(const std::string& key_str, const toml::node& value);
-    
-    /// @brief Parse bytes string like "8D 86 XX XX XX XX" into byte array
-    std::vector<std::uint8_t> parse_bytes_string(const std::string& bytes_str);
+    /// @brief Parse a single instruction entry from TOML into the compiled set
+    /// @param key_str Instruction address, or a label when the entry has a symbol or a pattern
+    /// @param signatures Resolved instruction symbols and patterns of the file
+    /// @return true if the instruction was added
+    bool parse_single_instruction(const std::string& key_str, const toml::node& value,
+                                  const SignatureBatch& signatures,
+                                  app_hook::config::CompiledPatchSet& compiled);
+
+    /// @brief Generate the patches of a [relocate] section from the executable's code
+    /// @return false if the section is invalid or the executable cannot be read
+    bool add_relocation_patches(const toml::table& table, app_hook::config::CompiledPatchSet& compiled);
+
+    /// @brief Claim the bytes written by a loaded config in the plugin's patch index
+    /// @return false if other configs write some of them and the config does not allow overlaps
+    bool claim_bytes(const app_hook::config::PatchConfig& config);
 
     /// @brief Parse address string (supports hex format)
     static std::uintptr_t parse_address(const std::string& value);
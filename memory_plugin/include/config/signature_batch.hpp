@@ -0,0 +1,71 @@
+#pragma once
+
+#include "plugin/plugin_interface.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace memory_plugin {
+
+/// @brief Signature patterns and address-map symbols of one config file, resolved together
+/// @note Loaders collect every pattern of a file first and resolve them with
+///       one host call, so a cold start scans the executable once per file
+///       rather than once per address. A field naming a symbol that the
+///       address map of this build holds queues no pattern: scanning is only
+///       the fallback for builds without a map.
+class SignatureBatch {
+public:
+    /// @brief Queue a pattern
+    void add(const std::string& pattern) {
+        if (addresses_.try_emplace(pattern, 0).second) {
+            patterns_.push_back(pattern);
+        }
+    }
+
+    /// @brief Look up a symbol in the address map of this build
+    /// @param host Plugin host (without one, no symbol resolves)
+    /// @param symbol Symbol name
+    /// @return True if the map names the symbol, so its pattern need not be queued
+    bool add_symbol(app_hook::plugin::IPluginHost* host, const std::string& symbol) {
+        const auto address = host ? host->resolve_symbol(symbol) : 0;
+        symbols_[symbol] = address;
+        return address != 0;
+    }
+
+    /// @brief Get the address a symbol resolved to
+    /// @return Address, or 0 if the symbol was not added or is not in the map
+    [[nodiscard]] std::uintptr_t symbol(const std::string& symbol) const {
+        const auto it = symbols_.find(symbol);
+        return it != symbols_.end() ? it->second : 0;
+    }
+
+    /// @brief Check if no pattern was queued
+    [[nodiscard]] bool empty() const noexcept { return patterns_.empty(); }
+
+    /// @brief Resolve the queued patterns through the host
+    /// @param host Plugin host (without one, every pattern stays unresolved)
+    void resolve(app_hook::plugin::IPluginHost* host) {
+        if (!host || patterns_.empty()) {
+            return;
+        }
+        const auto addresses = host->resolve_signatures(patterns_);
+        for (std::size_t i = 0; i < patterns_.size() && i < addresses.size(); ++i) {
+            addresses_[patterns_[i]] = addresses[i];
+        }
+    }
+
+    /// @brief Get the address a pattern resolved to
+    /// @return Address, or 0 if the pattern did not resolve
+    [[nodiscard]] std::uintptr_t address(const std::string& pattern) const {
+        const auto it = addresses_.find(pattern);
+        return it != addresses_.end() ? it->second : 0;
+    }
+
+private:
+    std::vector<std::string> patterns_;
+    std::unordered_map<std::string, std::uintptr_t> addresses_;
+    std::unordered_map<std::string, std::uintptr_t> symbols_;
+};
+
+} // namespace memory_plugin
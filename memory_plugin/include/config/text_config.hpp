@@ -0,0 +1,176 @@
+#pragma once
+
+#include <config/config_base.hpp>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief What the entries of a text table's offset table count from
+enum class TextOffsetBase : std::uint8_t {
+    table,  ///< Start of the offset table (the block start)
+    data    ///< Start of the string data, right after the table
+};
+
+/// @brief Sidecar file a text table was encoded from, with its state at load time
+struct TextSource {
+    std::string path;
+    std::uint64_t size = 0;
+    std::int64_t write_time = 0;    ///< Last write time, in file clock ticks
+
+    [[nodiscard]] bool operator==(const TextSource&) const noexcept = default;
+};
+
+/// @brief Configuration for a table of encoded strings written into a region
+///
+/// The strings are encoded once, when the config is loaded: the data pool holds
+/// every string followed by the terminator, and offsets_ the start of each one
+/// in the pool. The task writes the block (the offset table, then the data) in
+/// one pass, at the offset or after the region's original bytes.
+class TextConfig : public ConfigBase {
+public:
+    /// @brief Type ID the task creator is registered under
+    static constexpr std::string_view kTypeId = "app_hook::config::TextConfig";
+    /// @brief Config type, the slot of the built-in task creator
+    static constexpr ConfigType kConfigType = ConfigType::Text;
+
+    /// @brief Constructor
+    /// @param key Configuration key
+    /// @param name Display name
+    TextConfig(std::string key, std::string name)
+        : ConfigBase(kConfigType, std::move(key), std::move(name))
+        , offset_{}
+        , offset_width_(2)
+        , offset_base_(TextOffsetBase::table)
+        , terminator_(0)
+        , offsets_{}
+        , data_{}
+        , sources_{} {}
+
+    /// @brief Default destructor
+    ~TextConfig() override = default;
+
+    /// @brief Get the stable type ID
+    [[nodiscard]] std::string_view type_id() const noexcept override { return kTypeId; }
+
+    // Accessors following C++23 conventions
+    [[nodiscard]] std::optional<std::uint32_t> offset() const noexcept { return offset_; }
+    [[nodiscard]] std::uint8_t offset_width() const noexcept { return offset_width_; }
+    [[nodiscard]] TextOffsetBase offset_base() const noexcept { return offset_base_; }
+    [[nodiscard]] std::uint8_t terminator() const noexcept { return terminator_; }
+    [[nodiscard]] const std::vector<std::uint32_t>& offsets() const noexcept { return offsets_; }
+    [[nodiscard]] const std::vector<std::uint8_t>& data() const noexcept { return data_; }
+    [[nodiscard]] const std::vector<TextSource>& sources() const noexcept { return sources_; }
+
+    void set_offset(std::optional<std::uint32_t> offset) noexcept { offset_ = offset; }
+    void set_offset_base(TextOffsetBase base) noexcept { offset_base_ = base; }
+    void set_terminator(std::uint8_t terminator) noexcept { terminator_ = terminator; }
+    void add_source(TextSource source) { sources_.push_back(std::move(source)); }
+
+    /// @brief Set the width of the offset table's entries
+    /// @param width 2 or 4 bytes
+    /// @return False if the width is not supported
+    bool set_offset_width(std::uint8_t width) noexcept {
+        if (width != 2 && width != 4) {
+            return false;
+        }
+        offset_width_ = width;
+        return true;
+    }
+
+    /// @brief Get the number of strings
+    [[nodiscard]] std::size_t count() const noexcept { return offsets_.size(); }
+
+    /// @brief Get the size of the offset table
+    [[nodiscard]] std::size_t table_bytes() const noexcept { return offsets_.size() * offset_width_; }
+
+    /// @brief Get the size of the block written into the region
+    [[nodiscard]] std::size_t block_bytes() const noexcept { return table_bytes() + data_.size(); }
+
+    /// @brief Get the table entry of a string, counted from the offset base
+    [[nodiscard]] std::uint32_t entry(std::size_t index) const noexcept {
+        const auto bias = offset_base_ == TextOffsetBase::table ? table_bytes() : 0;
+        return offsets_[index] + static_cast<std::uint32_t>(bias);
+    }
+
+    /// @brief Check if every table entry fits the offset width
+    [[nodiscard]] bool entries_fit() const noexcept {
+        if (offset_width_ == 4 || offsets_.empty()) {
+            return true;
+        }
+        return entry(offsets_.size() - 1) <= 0xFFFF;
+    }
+
+    /// @brief Start a string in the data pool
+    /// @return Buffer the encoded string is appended to; call end_string() once it is
+    std::vector<std::uint8_t>& begin_string() {
+        offsets_.push_back(static_cast<std::uint32_t>(data_.size()));
+        return data_;
+    }
+
+    /// @brief Terminate the string begun last
+    void end_string() { data_.push_back(terminator_); }
+
+    /// @brief Replace the strings with restored ones
+    /// @param offsets String starts in the pool, ascending
+    /// @param data Encoded strings
+    /// @return False (and nothing replaced) if an offset points outside the pool or goes back
+    bool set_strings(std::vector<std::uint32_t> offsets, std::vector<std::uint8_t> data) {
+        std::uint32_t previous = 0;
+        for (const auto offset : offsets) {
+            if (offset < previous || offset >= data.size()) {
+                return false;
+            }
+            previous = offset;
+        }
+        offsets_ = std::move(offsets);
+        data_ = std::move(data);
+        return true;
+    }
+
+    /// @brief Check if this configuration is valid
+    /// @return True if the table targets a region, has strings and its offsets fit their width
+    [[nodiscard]] bool is_valid() const noexcept override {
+        return ConfigBase::is_valid() && reads_from_context() && !offsets_.empty() && entries_fit();
+    }
+
+    /// @brief Get the memory held by this configuration
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept override {
+        std::size_t sources = sources_.capacity() * sizeof(TextSource);
+        for (const auto& source : sources_) {
+            sources += source.path.capacity();
+        }
+        return sizeof(*this) + heap_bytes() + offsets_.capacity() * sizeof(std::uint32_t) + data_.capacity() + sources;
+    }
+
+    /// @brief Shrink the strings, the offsets and the data pool
+    void compact() override {
+        ConfigBase::compact();
+        offsets_.shrink_to_fit();
+        data_.shrink_to_fit();
+        sources_.shrink_to_fit();
+    }
+
+    /// @brief Get debug string representation
+    /// @return Debug string with text-specific information
+    [[nodiscard]] std::string debug_string() const override {
+        return ConfigBase::debug_string() +
+               " strings=" + std::to_string(offsets_.size()) +
+               " bytes=" + std::to_string(block_bytes()) +
+               " width=" + std::to_string(offset_width_);
+    }
+
+private:
+    std::optional<std::uint32_t> offset_;   ///< Block offset in the region (default: after the original bytes)
+    std::uint8_t offset_width_;             ///< Bytes per table entry (2 or 4)
+    TextOffsetBase offset_base_;            ///< What table entries count from
+    std::uint8_t terminator_;               ///< Byte ending every string
+    std::vector<std::uint32_t> offsets_;    ///< Start of each string in the data pool
+    std::vector<std::uint8_t> data_;        ///< Encoded strings, terminators included
+    std::vector<TextSource> sources_;       ///< Strings file and charmap the data was encoded from
+};
+
+} // namespace app_hook::config
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <config/config_loader_base.hpp>
+#include "text_config.hpp"
+#include "text_encoder.hpp"
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <toml++/toml.hpp>
+#include <unordered_map>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace memory_plugin {
+
+/// @brief Text table configuration loader
+/// @note Implements ConfigLoaderBase to provide text table configuration loading only
+class TextConfigLoader : public app_hook::config::ConfigLoaderBase {
+public:
+    TextConfigLoader() = default;
+    ~TextConfigLoader() override = default;
+
+    /// @brief Set the plugin host for logging
+    void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
+
+    // ConfigLoaderBase interface
+    std::vector<app_hook::config::ConfigType> supported_types() const override;
+    
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> load_configs(
+        app_hook::config::ConfigType type, 
+        const std::string& file_path, 
+        const std::string& task_name
+    ) override;
+
+    std::string get_name() const override;
+    std::string get_version() const override;
+    
+    // Config cache hooks
+    std::uint32_t cache_version() const override;
+    bool serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                           app_hook::util::ByteWriter& out) const override;
+    app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> deserialize_configs(
+        app_hook::config::ConfigType type, 
+        app_hook::util::ByteReader& in, 
+        const std::string& task_name
+    ) override;
+
+private:
+    /// @brief Charmaps read by one load_configs call, by normalized path
+    using CharmapCache = std::unordered_map<std::string, app_hook::config::TextEncoder>;
+
+    /// @brief Parse a single text table from TOML and encode its strings
+    /// @param directory Directory of the config file, the base of relative sidecar paths
+    /// @param charmaps Charmaps already read by this load
+    app_hook::config::ConfigPtr parse_text(const toml::table& table, const std::string& task_name,
+                                           const std::string& config_name, const std::filesystem::path& directory,
+                                           CharmapCache& charmaps);
+
+    /// @brief Get the encoder of a charmap file, reading it on first use in this load
+    /// @param charmaps Charmaps already read by this load
+    /// @return Encoder, or nullptr if the charmap cannot be read
+    static const app_hook::config::TextEncoder* charmap(const std::filesystem::path& path, CharmapCache& charmaps);
+
+    /// @brief Read a charmap file: [charmap] "A" = 0x21, "é" = [0x1F, 0x45]
+    /// @return Encoder, or nullopt if the file cannot be parsed or a mapping is invalid
+    static std::optional<app_hook::config::TextEncoder> read_charmap(const std::filesystem::path& path);
+
+    /// @brief Record a sidecar file's size and write time
+    static std::optional<app_hook::config::TextSource> fingerprint(const std::filesystem::path& path);
+
+    /// @brief Check that cached sidecars still match their files
+    /// @return False if a sidecar that still exists changed since it was encoded
+    static bool sources_current(const app_hook::config::TextConfig& config);
+
+    /// @brief Plugin host for logging
+    app_hook::plugin::IPluginHost* host_ = nullptr;
+};
+
+} // namespace memory_plugin
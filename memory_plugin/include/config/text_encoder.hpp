@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::config {
+
+/// @brief Maps Unicode code points to the bytes of a game's text encoding
+///
+/// Each mapped code point holds an entry pointing into one byte pool, so
+/// encoding a character is a table index and a copy of 1 to 4 bytes. Code
+/// points of the Basic Multilingual Plane use a dense table sized to the
+/// highest one mapped; the rare ones above it go through a hash map.
+class TextEncoder {
+public:
+    /// @brief Longest byte sequence a code point may encode to
+    static constexpr std::size_t kMaxSequence = 4;
+
+    TextEncoder() = default;
+
+    /// @brief Create an encoder mapping printable ASCII (0x20-0x7E) to itself
+    [[nodiscard]] static TextEncoder ascii();
+
+    /// @brief Map a code point, replacing any previous mapping
+    /// @param code_point Unicode code point
+    /// @param bytes Encoded bytes (1 to kMaxSequence)
+    /// @return False if the sequence is empty or too long
+    bool map(char32_t code_point, std::span<const std::uint8_t> bytes);
+
+    /// @brief Get the number of mapped code points
+    [[nodiscard]] std::size_t size() const noexcept { return mapped_; }
+
+    /// @brief Encode UTF-8 text, appending to a buffer
+    ///
+    /// "{XX}" writes the raw byte XX (control codes of the game's text), and
+    /// "{{" writes the encoding of '{'.
+    /// @param utf8 Text to encode
+    /// @param out Buffer the bytes are appended to
+    /// @return Nothing, or the offset in utf8 of the first character that is
+    ///         invalid UTF-8, unmapped, or a malformed escape (out is then partly written)
+    [[nodiscard]] std::expected<void, std::size_t> encode(std::string_view utf8, std::vector<std::uint8_t>& out) const;
+
+private:
+    /// @brief Entry of a mapped code point: pool offset in the low 24 bits, length in the high 8 (0 = unmapped)
+    using Entry = std::uint32_t;
+
+    /// @brief Look up a code point's entry
+    [[nodiscard]] Entry find(char32_t code_point) const noexcept;
+
+    std::vector<Entry> dense_;                          ///< Entries of code points below 0x10000
+    std::unordered_map<char32_t, Entry> sparse_;        ///< Entries of higher code points
+    std::vector<std::uint8_t> pool_;                    ///< Bytes of every entry
+    std::size_t mapped_ = 0;
+};
+
+/// @brief Decode one UTF-8 character
+/// @param text Text starting at the character
+/// @param length Set to the character's byte length on success
+/// @return Code point, or nullopt if the sequence is invalid or truncated
+[[nodiscard]] std::optional<char32_t> decode_utf8(std::string_view text, std::size_t& length) noexcept;
+
+} // namespace app_hook::config
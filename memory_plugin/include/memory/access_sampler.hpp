@@ -0,0 +1,161 @@
+#pragma once
+
+#include <windows.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief An instruction seen touching the old bytes of a relocated region
+struct AccessSite {
+    std::uintptr_t instruction = 0;     ///< Address of the faulting instruction
+    std::uintptr_t region_begin = 0;    ///< Old address of the region
+    std::uint32_t region_size = 0;      ///< Size of the region
+    std::uint32_t offset = 0;           ///< Offset of the first access sampled
+    std::uint32_t hits = 0;             ///< Sampled accesses
+    std::string region;                 ///< Key of the region
+    std::array<std::uint8_t, 16> code{};///< Code bytes at the instruction
+    std::uint8_t code_size = 0;         ///< Code bytes that could be read
+};
+
+/// @brief Samples accesses to the old copy of relocated regions to find missed patches
+///
+/// The pages under each watched region are made PAGE_GUARD. A guard fault is
+/// handled by a vectored exception handler that pushes the faulting instruction
+/// and address into a lock-free ring and lets the access run; the OS has already
+/// lifted the guard. A timer drains the ring into one site per instruction and
+/// guards the pages again, so each page faults at most once per interval
+/// however hot the table is.
+class AccessSampler {
+public:
+    /// @brief Time between re-arms of the guard pages
+    static constexpr std::chrono::milliseconds kDefaultInterval{50};
+
+    /// @brief Samples the ring holds between drains (power of two)
+    static constexpr std::uint32_t kRingSize = 4096;
+
+    /// @brief Regions that can be watched at once
+    static constexpr std::size_t kMaxRegions = 32;
+
+    /// @brief Get the sampler shared by the plugin's copy tasks
+    /// @note Never destroyed, so it is not torn down under the loader lock at exit
+    static AccessSampler& instance();
+
+    /// @brief Constructor
+    /// @param interval Time between re-arms of the guard pages
+    explicit AccessSampler(std::chrono::milliseconds interval = kDefaultInterval);
+
+    /// @brief Stops sampling, waiting for a running re-arm
+    /// @note Writes nothing, and lifts the guards only if the lock is free: a thread
+    ///       stopped by the process exit may hold it
+    ~AccessSampler();
+
+    // Non-copyable, non-movable
+    AccessSampler(const AccessSampler&) = delete;
+    AccessSampler& operator=(const AccessSampler&) = delete;
+    AccessSampler(AccessSampler&&) = delete;
+    AccessSampler& operator=(AccessSampler&&) = delete;
+
+    /// @brief Start sampling accesses to a region's old bytes
+    /// @param key Key of the region (a key already watched is not added twice)
+    /// @param address Old address of the region
+    /// @param size Size of the region
+    /// @return False if the region cannot be guarded, too many regions are watched,
+    ///         or another sampler is active
+    bool watch(const std::string& key, std::uintptr_t address, std::size_t size);
+
+    /// @brief Lift the guards, remove the handler and collect the last samples
+    /// @param wait Wait for a running re-arm; leave false under the loader lock
+    void stop(bool wait = false);
+
+    /// @brief Check if any region is watched
+    [[nodiscard]] bool active() const noexcept { return region_count_.load(std::memory_order_acquire) != 0; }
+
+    /// @brief Record a guard fault (called by the exception handler)
+    /// @param instruction Address of the faulting instruction
+    /// @param address Address that was accessed
+    /// @return True if the address is on a watched page (the fault is ours)
+    bool on_guard_fault(std::uintptr_t instruction, std::uintptr_t address) noexcept;
+
+    /// @brief Move the ring's samples into the sites
+    void drain();
+
+    /// @brief Get the sites seen so far, by instruction address
+    [[nodiscard]] std::vector<AccessSite> sites();
+
+    /// @brief Get the samples lost because the ring was full
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /// @brief Write the sites as patch entries
+    /// @param path File to write
+    /// @return False if there is nothing to report or the file cannot be written
+    bool write_report(const std::filesystem::path& path);
+
+    /// @brief Keep a report current while sampling
+    /// @param path File the timer rewrites whenever a new site was seen
+    /// @note The game exiting skips the plugin's shutdown, so the report must already
+    ///       be on disk then; set it before the first watch()
+    void set_report_path(std::filesystem::path path) { report_path_ = std::move(path); }
+
+    /// @brief Format a site as a patch entry of magic_patch.toml
+    /// @param site Sampled site
+    /// @return TOML entry; when the code carries no absolute address into the
+    ///         region, the entry is commented out with the code bytes as a hint
+    [[nodiscard]] static std::string patch_entry(const AccessSite& site);
+
+private:
+    /// @brief A watched region and the pages guarded for it
+    struct Watched {
+        std::uintptr_t begin;
+        std::uintptr_t end;
+        std::uintptr_t page_begin;
+        std::uintptr_t page_end;
+        DWORD protect;                 ///< Protection of the pages without the guard
+    };
+
+    /// @brief One slot of the ring
+    struct Sample {
+        std::atomic<std::uint32_t> sequence;
+        std::uintptr_t instruction;
+        std::uintptr_t address;
+        std::uint32_t region;
+    };
+
+    /// @brief Move the ring's samples into the sites (mutex_ held)
+    void drain_locked();
+
+    /// @brief Guard the pages of every watched region again
+    void rearm() noexcept;
+
+    /// @brief Timer callback: drain and re-arm
+    static VOID CALLBACK on_timer(PVOID sampler, BOOLEAN fired);
+
+    std::chrono::milliseconds interval_;
+    std::array<Watched, kMaxRegions> regions_{};
+    std::atomic<std::size_t> region_count_{0};  ///< Regions published to the handler
+    std::array<Sample, kRingSize> ring_;
+    alignas(64) std::atomic<std::uint32_t> head_{0};
+    std::uint32_t tail_ = 0;                    ///< Next slot to drain (under mutex_)
+    std::atomic<std::uint64_t> dropped_{0};
+
+    std::mutex mutex_;                          ///< Serializes watch(), drain() and stop()
+    std::vector<std::string> keys_;             ///< Key of each watched region
+    std::map<std::uintptr_t, AccessSite> sites_;
+    std::uintptr_t code_begin_ = 0;             ///< Executable code the sites must lie in
+    std::uintptr_t code_end_ = 0;               ///< (0 when it could not be read)
+    std::uint64_t outside_ = 0;                 ///< Samples from code outside the executable
+    PVOID handler_ = nullptr;                   ///< Vectored exception handler
+    HANDLE timer_ = nullptr;                    ///< Re-arm timer in the default timer queue
+    std::filesystem::path report_path_;         ///< Rewritten by the timer when sites are added
+    std::size_t reported_sites_ = 0;            ///< Sites in the last report written (under mutex_)
+};
+
+} // namespace app_hook::memory
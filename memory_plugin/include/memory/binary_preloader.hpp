@@ -0,0 +1,99 @@
+#pragma once
+
+#include "blob_store.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Reads LoadInMemory binaries on a background thread ahead of their hooks
+///
+/// Config loaders queue every referenced binary right after parsing. A single
+/// background thread reads them into staged buffers, so that when the hook
+/// fires the task only copies bytes into the game's memory. The thread exits
+/// once the queue is empty and restarts on the next preload. Files are read
+/// through the BlobStore, so paths naming the same file, or files with the
+/// same bytes, are staged once.
+class BinaryPreloader {
+public:
+    /// @brief Staged file contents
+    using Buffer = BlobStore::Buffer;
+
+    /// @brief Get the preloader shared by the plugin's loaders and tasks
+    /// @return Preloader instance, never destroyed (see clear)
+    static BinaryPreloader& instance();
+
+    BinaryPreloader() = default;
+
+    /// @brief Waits for the background thread
+    ~BinaryPreloader();
+
+    // Non-copyable, non-movable
+    BinaryPreloader(const BinaryPreloader&) = delete;
+    BinaryPreloader& operator=(const BinaryPreloader&) = delete;
+    BinaryPreloader(BinaryPreloader&&) = delete;
+    BinaryPreloader& operator=(BinaryPreloader&&) = delete;
+
+    /// @brief Queue a binary for staging (no-op if already queued or staged)
+    /// @param path Path of the binary
+    void preload(const std::string& path);
+
+    /// @brief Get the staged contents of a binary
+    /// @param path Path of the binary
+    /// @param timeout Longest wait if the file is being read right now
+    /// @return Staged contents, or nullptr if the caller should read the file itself
+    ///         (never queued, not started yet, failed, or still reading after timeout)
+    [[nodiscard]] std::shared_ptr<const Buffer> acquire(const std::string& path,
+                                                        std::chrono::milliseconds timeout = std::chrono::milliseconds(2000));
+
+    /// @brief Drop the staged contents of a binary so the next acquire reads the file
+    /// @param path Path of the binary
+    void invalidate(const std::string& path);
+
+    /// @brief Stop staging and drop every staged buffer
+    /// @note Waits for a read in progress. Never call it at process exit: the OS
+    ///       kills the thread first, and the wait would never end
+    void clear();
+
+    /// @brief Get the number of binaries staged successfully
+    /// @return Staged binary count
+    [[nodiscard]] std::size_t staged_count() const;
+
+    /// @brief Get the total size of the staged buffers
+    /// @return Staged bytes, counting buffers shared by several paths once
+    [[nodiscard]] std::size_t staged_bytes() const;
+
+private:
+    /// @brief Staging state of one binary
+    enum class State { queued, loading, ready, failed };
+
+    /// @brief Staging entry of one binary
+    struct Entry {
+        State state = State::queued;
+        std::shared_ptr<const Buffer> data;
+    };
+
+    /// @brief Background thread body
+    void run();
+
+    /// @brief Read a whole file
+    /// @param path File path
+    /// @return File contents or nullptr on failure
+    [[nodiscard]] static std::shared_ptr<const Buffer> read_file(const std::string& path);
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::deque<std::string> queue_;
+    bool running_ = false;
+};
+
+} // namespace app_hook::memory
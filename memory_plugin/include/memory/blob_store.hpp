@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../../core_hook/include/task/hook_task.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Counters of a blob store
+struct BlobStoreStats {
+    std::size_t blobs = 0;            ///< Distinct payloads alive
+    std::size_t bytes = 0;            ///< Bytes held by them
+    std::uint64_t file_hits = 0;      ///< Loads served without reading the file
+    std::uint64_t content_hits = 0;   ///< Reads whose bytes matched a payload already held
+    std::uint64_t bytes_shared = 0;   ///< Bytes not read or not kept thanks to both
+};
+
+/// @brief Content-addressed store of binary payloads
+///
+/// Several tasks, often from different mods, can point at the same file under
+/// different spellings, or ship identical files under different names. A load
+/// is first looked up by file identity (canonical path, size and write time),
+/// which skips the read entirely. A file that has to be read is then looked up
+/// by content (CRC32C and size, confirmed byte for byte), so identical payloads
+/// are kept once whatever their path.
+///
+/// Payloads are immutable and shared: every task copies (or decodes) them into
+/// its own target, which is the only write ever made. The store holds weak
+/// references, so a payload lives exactly as long as a staged preload or a
+/// running load holds it.
+class BlobStore {
+public:
+    /// @brief Immutable payload bytes
+    using Buffer = std::vector<std::uint8_t>;
+
+    /// @brief Get the store shared by the plugin's preloader and tasks
+    /// @return Store instance
+    static BlobStore& instance();
+
+    BlobStore() = default;
+
+    // Non-copyable, non-movable
+    BlobStore(const BlobStore&) = delete;
+    BlobStore& operator=(const BlobStore&) = delete;
+    BlobStore(BlobStore&&) = delete;
+    BlobStore& operator=(BlobStore&&) = delete;
+
+    /// @brief Get the contents of a file, shared with every other holder of the same bytes
+    /// @param path File path
+    /// @return Payload, file_not_found if the file is missing, or file_read_error
+    ///         if it is empty or cannot be read
+    [[nodiscard]] std::expected<std::shared_ptr<const Buffer>, task::TaskError> load(const std::string& path);
+
+    /// @brief Forget the file identity of a path so the next load reads it
+    /// @param path File path
+    /// @note For edits that keep the size and write time; holders keep their payload
+    void invalidate(const std::string& path);
+
+    /// @brief Take a snapshot of the counters
+    [[nodiscard]] BlobStoreStats stats() const;
+
+private:
+    /// @brief Identity of a file on disk
+    struct FileEntry {
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type write_time;
+        std::weak_ptr<const Buffer> blob;
+    };
+
+    /// @brief Find a live payload with the same bytes (mutex_ held)
+    [[nodiscard]] std::shared_ptr<const Buffer> find_content(std::uint64_t key, const Buffer& bytes) const;
+
+    /// @brief Drop entries whose payload is gone (mutex_ held)
+    void prune();
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, FileEntry> files_;                          ///< By canonical path
+    std::unordered_multimap<std::uint64_t, std::weak_ptr<const Buffer>> contents_;  ///< By size and CRC32C
+    std::uint64_t file_hits_ = 0;
+    std::uint64_t content_hits_ = 0;
+    std::uint64_t bytes_shared_ = 0;
+};
+
+} // namespace app_hook::memory
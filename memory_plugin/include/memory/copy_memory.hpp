@@ -4,6 +4,9 @@
 #include "../memory/memory_region.hpp"
 #include "../../core_hook/include/task/hook_task.hpp"
 #include "../../core_hook/include/context/mod_context.hpp"
+#include "../../core_hook/include/util/reference_scanner.hpp"
+#include <mutex>
+#include <vector>
 
 // Forward declaration
 namespace app_hook::plugin { class IPluginHost; }
@@ -33,6 +36,16 @@ public:
     /// @return Task result indicating success or failure
     [[nodiscard]] task::TaskResult execute() override;
     
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    
+    /// @brief Take over a reloaded copy configuration
+    /// @param updated Reloaded copy configuration
+    /// @return unchanged; updated if the region was not copied yet; dependents_stale once
+    ///         the region was copied again with its new size; restart_required when the
+    ///         hook address or the context key changed
+    [[nodiscard]] task::ReloadOutcome reload(const config::ConfigBase& updated) override;
+    
     /// @brief Get the task name
     /// @return Task name
     [[nodiscard]] std::string name() const override {
@@ -49,8 +62,20 @@ public:
     
 
     
+    /// @brief Shrink the configuration's buffers
+    void compact() override {
+        std::lock_guard lock(mutex_);
+        config_.compact();
+    }
+    
+    /// @brief Get the memory held by the task's configuration
+    [[nodiscard]] std::size_t config_bytes() const noexcept override {
+        return config_.footprint_bytes();
+    }
+    
     /// @brief Get the configuration
     /// @return Copy memory configuration
+    /// @note Not synchronized with reload()
     [[nodiscard]] const CopyMemoryConfig& config() const noexcept {
         return config_;
     }
@@ -58,6 +83,19 @@ public:
 private:
     CopyMemoryConfig config_;
     app_hook::plugin::IPluginHost* host_ = nullptr;
+    context::ContextKey region_key_;  ///< Interned context key of the copied region
+    bool copied_ = false;             ///< The region was copied at least once
+    std::mutex mutex_;                ///< Serializes execute() with reload()
+    
+    /// @brief Copy the region and store it in the context
+    [[nodiscard]] task::TaskResult copy_region();
+    
+    /// @brief Collect the old ranges whose pointers the copy moves
+    /// @param context Context holding the sibling regions
+    /// @param base Base of the new region
+    /// @return The old bytes of this region, then each copied sibling, with their new bases
+    [[nodiscard]] std::vector<util::MovedRange> moved_ranges(context::ModContext& context,
+                                                            const std::uint8_t* base) const;
 };
 
 } // namespace app_hook::memory
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../config/delta_config.hpp"
+#include "../memory/memory_region.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include "../../core_hook/include/context/mod_context.hpp"
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace app_hook::memory {
+
+// Use the config structure from the config namespace
+using DeltaConfig = config::DeltaConfig;
+
+/// @brief Task that writes a delta's edits into a region of the mod context
+///
+/// The region is usually one CopyMemory expanded (and LoadInMemory may have
+/// filled); the delta only rewrites the fields a mod changes. Every edit is
+/// bounds-checked before any is written, so a delta applies whole or not at all.
+class DeltaLoadTask final : public task::IHookTask {
+public:
+    /// @brief Construct a delta load task
+    /// @param config Configuration for the delta
+    explicit DeltaLoadTask(DeltaConfig config) noexcept
+        : config_(std::move(config)), host_(nullptr) {}
+    
+    /// @brief Set the plugin host for logging
+    void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
+    
+    /// @brief Set the plugin host for logging (base interface override)
+    void setHost(void* host) override { 
+        host_ = static_cast<app_hook::plugin::IPluginHost*>(host); 
+    }
+    
+    /// @brief Write the edits into the region
+    /// @return Task result indicating success or failure
+    [[nodiscard]] task::TaskResult execute() override;
+    
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    
+    /// @brief Take over reloaded edits, putting back the bytes under the old ones first
+    /// @param updated Reloaded delta configuration
+    /// @return unchanged, updated, or restart_required when the target region changed
+    [[nodiscard]] task::ReloadOutcome reload(const config::ConfigBase& updated) override;
+    
+    /// @brief Get the task name
+    /// @return Task name
+    [[nodiscard]] std::string name() const override {
+        return "DeltaLoad";
+    }
+    
+    /// @brief Get the task description
+    /// @return Task description
+    [[nodiscard]] std::string description() const override {
+        return "Apply " + std::to_string(config_.edits().size()) + " edit(s) of delta '" + config_.key() +
+               "' to '" + config_.read_from_context() + "'";
+    }
+    
+    /// @brief Shrink the configuration's buffers
+    void compact() override {
+        std::lock_guard lock(mutex_);
+        config_.compact();
+    }
+    
+    /// @brief Get the memory held by the task's configuration and the saved original bytes
+    [[nodiscard]] std::size_t config_bytes() const noexcept override {
+        return config_.footprint_bytes() + originals_.capacity();
+    }
+    
+    /// @brief Get the configuration
+    /// @return Delta configuration
+    /// @note Not synchronized with reload()
+    [[nodiscard]] const DeltaConfig& config() const noexcept {
+        return config_;
+    }
+    
+private:
+    DeltaConfig config_;
+    app_hook::plugin::IPluginHost* host_ = nullptr;
+    context::ContextKey region_key_;          ///< Interned context key of the target region
+    std::uint8_t* applied_base_ = nullptr;    ///< Region base the edits were last written to
+    std::vector<std::uint8_t> originals_;     ///< Bytes the edits replaced, in pool order
+    std::mutex mutex_;                        ///< Serializes execute() with reload()
+    
+    /// @brief Look up the target region
+    /// @return Region, or nullptr if it is not in the context
+    [[nodiscard]] const MemoryRegion* region();
+    
+    /// @brief Write the edits, saving the bytes under them when the region is new
+    [[nodiscard]] task::TaskResult apply();
+    
+    /// @brief Put back the bytes under the last written edits if the region is still there
+    void restore();
+};
+
+} // namespace app_hook::memory
@@ -4,6 +4,9 @@
 #include "../memory/memory_region.hpp"
 #include "../../core_hook/include/task/hook_task.hpp"
 #include "../../core_hook/include/context/mod_context.hpp"
+#include <cstdint>
+#include <mutex>
+#include <span>
 
 // Forward declaration
 namespace app_hook::plugin { class IPluginHost; }
@@ -33,6 +36,23 @@ public:
     /// @return Task result indicating success or failure
     [[nodiscard]] task::TaskResult execute() override;
     
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    
+    /// @brief Take over a reloaded load configuration, loading the binary again if it ran
+    /// @param updated Reloaded load configuration
+    /// @return unchanged, updated, dependents_stale when a published view moved, or
+    ///         restart_required when the region read from context changed
+    [[nodiscard]] task::ReloadOutcome reload(const config::ConfigBase& updated) override;
+    
+    /// @brief Get the binary watched by hot reload
+    [[nodiscard]] std::vector<std::string> watched_files() const override;
+    
+    /// @brief Load the changed binary again, bypassing the install-time preload
+    /// @param path Changed binary
+    /// @return updated, or dependents_stale when the view of the binary is published
+    [[nodiscard]] task::ReloadOutcome refresh_file(const std::string& path) override;
+    
     /// @brief Get the task name
     /// @return Task name
     [[nodiscard]] std::string name() const override {
@@ -45,8 +65,20 @@ public:
         return "Load binary data '" + config_.key() + "' from file: " + config_.binary_path();
     }
     
+    /// @brief Shrink the configuration's buffers
+    void compact() override {
+        std::lock_guard lock(mutex_);
+        config_.compact();
+    }
+    
+    /// @brief Get the memory held by the task's configuration
+    [[nodiscard]] std::size_t config_bytes() const noexcept override {
+        return config_.footprint_bytes();
+    }
+    
     /// @brief Get the configuration
     /// @return Load in memory configuration
+    /// @note Not synchronized with reload()
     [[nodiscard]] const LoadInMemoryConfig& config() const noexcept {
         return config_;
     }
@@ -54,6 +86,24 @@ public:
 private:
     LoadInMemoryConfig config_;                ///< Configuration for the load operation
     app_hook::plugin::IPluginHost* host_;      ///< Plugin host for logging and context access
+    context::ContextKey read_key_;             ///< Interned key of the region read from context
+    context::ContextKey write_key_;            ///< Interned key of the view written to context
+    bool loaded_ = false;                      ///< The binary was injected at least once
+    mutable std::mutex mutex_;                 ///< Serializes execute() with reload()
+    
+    /// @brief Inject the binary and publish its view
+    [[nodiscard]] task::TaskResult load_binary();
+    
+    /// @brief Compare the CRC32C of the injected bytes with the source or the configured checksum
+    /// @param payload Source bytes as read (compressed or raw)
+    /// @param target Injected bytes
+    /// @return Success, or copy_failed on a mismatch
+    [[nodiscard]] task::TaskResult verify_injection(std::span<const std::uint8_t> payload,
+                                                    std::span<const std::uint8_t> target);
+    
+    /// @brief Load the binary again after a reload
+    /// @return Outcome of the reload
+    [[nodiscard]] task::ReloadOutcome reload_binary();
 };
 
 } // namespace app_hook::memory 
\ No newline at end of file
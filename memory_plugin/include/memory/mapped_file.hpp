@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../../core_hook/include/task/hook_task.hpp"
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+
+namespace app_hook::memory {
+
+/// @brief Read-only view of a whole file mapped into memory
+/// @note Copying out of the view lets the OS page the file straight into the
+///       destination, without a CRT stream or an intermediate buffer. The view
+///       is unmapped when the object is destroyed.
+class MappedFile {
+public:
+    /// @brief Map a file for reading
+    /// @param path File path
+    /// @return Mapped file, file_not_found if it cannot be opened, or
+    ///         file_read_error if it is empty or cannot be mapped
+    [[nodiscard]] static std::expected<MappedFile, task::TaskError> open(const std::string& path);
+
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    // Non-copyable but movable
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /// @brief Unmap the view and close the file
+    void close() noexcept;
+
+    /// @brief Get the mapped bytes
+    /// @return Pointer to the start of the file
+    [[nodiscard]] const std::uint8_t* data() const noexcept { return static_cast<const std::uint8_t*>(view_); }
+
+    /// @brief Get the file size
+    /// @return Size in bytes
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /// @brief Get the mapped bytes as a span
+    /// @return View of the file contents
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const noexcept { return {data(), size_}; }
+
+    /// @brief Check if a file is mapped
+    /// @return true if mapped
+    [[nodiscard]] bool is_open() const noexcept { return view_ != nullptr; }
+
+private:
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+    const void* view_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace app_hook::memory
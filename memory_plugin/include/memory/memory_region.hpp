@@ -1,22 +1,37 @@
 #pragma once
 
+#include "util/hex_dump.hpp"
+#include <algorithm>
+#include <format>
 #include <memory>
 #include <string>
 #include <span>
 #include <cstdint>
-#include <sstream>
-#include <iomanip>
 
 namespace app_hook::memory {
 
+/// @brief Where the bytes of a memory region live
+enum class RegionStorage {
+    owned,  ///< Heap buffer owned by the region
+    arena,  ///< Block carved from the RegionArena, released with the arena
+    reserved, ///< Growable reservation in the RegionArena, committed up to size
+    view    ///< Bytes owned by another region (see MemoryRegion::parent_key)
+};
+
 /// @brief Memory region information for memory operations
-/// @note This class manages allocated memory regions with metadata
+/// @note This class manages allocated memory regions with metadata. Arena,
+///       reserved and view regions do not own their bytes: a view must not outlive its
+///       parent, and an arena region must not outlive the arena.
 struct MemoryRegion {
     std::unique_ptr<std::uint8_t[]> data;
     std::size_t size;
     std::size_t original_size;
     std::uintptr_t original_address;
     std::string description;
+    std::uint8_t* external_base = nullptr;        ///< Start of bytes not held by data (arena and view regions)
+    RegionStorage kind = RegionStorage::owned;    ///< Where the bytes live
+    std::string parent_key;                       ///< Context key of the region a view points into
+    std::size_t capacity = 0;                     ///< Size a reserved region may grow to
     
     /// @brief Default constructor
     MemoryRegion() : data(nullptr), size(0), original_size(0), original_address(0), description() {}
@@ -38,22 +53,115 @@ struct MemoryRegion {
     MemoryRegion(MemoryRegion&&) = default;
     MemoryRegion& operator=(MemoryRegion&&) = default;
     
+    /// @brief Create a region over bytes owned by another region
+    /// @param base Start of the bytes
+    /// @param sz Size of the view
+    /// @param parent Context key of the owning region
+    /// @param desc Description of the memory region
+    /// @return Non-owning region
+    [[nodiscard]] static MemoryRegion make_view(std::uint8_t* base, std::size_t sz, 
+                                                std::string parent, std::string desc) {
+        MemoryRegion region;
+        region.external_base = base;
+        region.kind = RegionStorage::view;
+        region.size = sz;
+        region.original_size = sz;
+        region.original_address = reinterpret_cast<std::uintptr_t>(base);
+        region.description = std::move(desc);
+        region.parent_key = std::move(parent);
+        return region;
+    }
+    
+    /// @brief Create a region over a block carved from the region arena
+    /// @param base Start of the block
+    /// @param sz Size of the memory region
+    /// @param original_sz Size of the original data
+    /// @param addr Original address
+    /// @param desc Description of the memory region
+    /// @return Arena-backed region
+    [[nodiscard]] static MemoryRegion make_arena_region(std::uint8_t* base, std::size_t sz, std::size_t original_sz,
+                                                        std::uintptr_t addr, std::string desc) {
+        MemoryRegion region;
+        region.external_base = base;
+        region.kind = RegionStorage::arena;
+        region.size = sz;
+        region.original_size = original_sz;
+        region.original_address = addr;
+        region.description = std::move(desc);
+        return region;
+    }
+    
+    /// @brief Create a region over a growable reservation in the region arena
+    /// @param base Start of the reservation
+    /// @param sz Committed size of the memory region
+    /// @param cap Size the region may grow to without moving
+    /// @param original_sz Size of the original data
+    /// @param addr Original address
+    /// @param desc Description of the memory region
+    /// @return Reserved region
+    [[nodiscard]] static MemoryRegion make_reserved_region(std::uint8_t* base, std::size_t sz, std::size_t cap,
+                                                           std::size_t original_sz, std::uintptr_t addr,
+                                                           std::string desc) {
+        auto region = make_arena_region(base, sz, original_sz, addr, std::move(desc));
+        region.kind = RegionStorage::reserved;
+        region.capacity = cap;
+        return region;
+    }
+    
+    /// @brief Get the start of the region's bytes, whatever their storage
+    [[nodiscard]] std::uint8_t* base() const noexcept {
+        return data ? data.get() : external_base;
+    }
+    
+    /// @brief Get where the region's bytes live
+    [[nodiscard]] RegionStorage storage() const noexcept {
+        return kind;
+    }
+    
+    /// @brief Check if the region is a view into another region
+    [[nodiscard]] bool is_view() const noexcept {
+        return storage() == RegionStorage::view;
+    }
+
+    /// @brief Check if the region can grow to a size without moving
+    /// @param sz Size the region needs
+    [[nodiscard]] bool can_grow_to(std::size_t sz) const noexcept {
+        return storage() == RegionStorage::reserved && sz <= capacity;
+    }
+
+    /// @brief Get the memory held by this region object
+    /// @return Object size, owned buffer and strings; arena, reserved and view bytes are not counted
+    ///         here (the RegionArena reports them)
+    [[nodiscard]] std::size_t footprint_bytes() const noexcept {
+        return sizeof(*this) + (data ? size : 0) + description.capacity() + parent_key.capacity();
+    }
+    
     /// @brief Get a span view of the memory region
     [[nodiscard]] std::span<std::uint8_t> span() noexcept {
-        return {data.get(), size};
+        return {base(), size};
     }
     
     /// @brief Get a const span view of the memory region
     [[nodiscard]] std::span<const std::uint8_t> span() const noexcept {
-        return {data.get(), size};
+        return {base(), size};
     }
 
     /// @brief Get the memory region as a string
     [[nodiscard]] std::string to_string() const noexcept {
-        std::stringstream ss;
-        ss << "MemoryRegion: " << description << " [0x" << std::hex << original_address 
-           << " - 0x" << std::hex << original_address + size << "]";
-        return ss.str();
+        return std::format("MemoryRegion: {} [0x{:x} - 0x{:x}]", description, original_address, original_address + size);
+    }
+
+    /// @brief Get a lazily formatted hex dump of the memory content
+    /// @param offset Starting offset in the memory region
+    /// @param count Number of bytes to display (clamped to the region)
+    /// @return Dump formatting as "0xAB 0xCD ...", 16 bytes per line; empty if offset is out of range
+    /// @note Pass it to a log call directly: nothing is formatted unless the message is emitted
+    [[nodiscard]] util::HexDump hex(std::size_t offset, std::size_t count) const noexcept {
+        const std::uint8_t* bytes = base();
+        if (!bytes || offset >= size) {
+            return util::HexDump{{}};
+        }
+        return util::HexDump{{bytes + offset, std::min(count, size - offset)}, util::HexStyle::prefixed, 16};
     }
 
     /// @brief Get the memory content as a string
@@ -61,28 +169,10 @@ struct MemoryRegion {
     /// @param count Number of bytes to display
     /// @return Formatted hex string of the memory content
     [[nodiscard]] std::string to_string(std::size_t offset, std::size_t count) const noexcept {
-        // Safety checks
-        if (!data || offset >= size) {
+        if (!base() || offset >= size) {
             return "Invalid offset or null data";
         }
-        
-        // Clamp count to available data
-        const std::size_t max_count = size - offset;
-        const std::size_t actual_count = (count > max_count) ? max_count : count;
-        
-        std::stringstream ss;
-        ss << std::hex << std::uppercase;
-        
-        for (std::size_t i = 0; i < actual_count; ++i) {
-            if (i > 0 && i % 16 == 0) {
-                ss << std::endl;
-            } else if (i > 0) {
-                ss << " ";
-            }
-            ss << "0x" << std::setfill('0') << std::setw(2) 
-               << static_cast<unsigned int>(data.get()[offset + i]);
-        }
-        return ss.str();
+        return std::format("{}", hex(offset, count));
     }
 };
 
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../config/compiled_patch.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Code bytes claimed by the loaded patch sets, to catch sets writing the same bytes
+///
+/// Patch loaders claim the instructions of every set they load, keyed by the
+/// task that owns it. Claims are kept as disjoint address intervals (touching
+/// instructions of one owner are merged), so checking a set of k instructions
+/// against n claimed intervals costs O(k log n). An owner claiming again, as a
+/// reloaded task does, replaces its previous claims.
+class PatchIndex {
+public:
+    /// @brief Bytes claimed by two owners
+    struct Conflict {
+        std::uintptr_t address;   ///< First shared byte
+        std::uint32_t length;     ///< Number of shared bytes
+        std::string owner;        ///< Owner already holding the bytes
+    };
+
+    /// @brief Get the index shared by the plugin's patch loaders
+    /// @return Index instance
+    static PatchIndex& instance();
+
+    /// @brief Claim the bytes of a patch set
+    /// @param owner Key of the task applying the set
+    /// @param instructions Instructions of the set, sorted by address
+    /// @param keep_overlaps Claim the intervals sharing no byte even if others do
+    /// @return Bytes already held by other owners, in address order; when not empty and
+    ///         keep_overlaps is false, nothing is claimed and the owner keeps its previous claims
+    [[nodiscard]] std::vector<Conflict> claim(const std::string& owner,
+                                              std::span<const config::CompiledInstruction> instructions,
+                                              bool keep_overlaps = false);
+
+    /// @brief Drop every claim of an owner
+    void release(const std::string& owner);
+
+    /// @brief Drop every claim
+    void clear();
+
+    /// @brief Get the number of claimed intervals
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /// @brief Claimed interval, keyed by its first byte
+    struct Interval {
+        std::uintptr_t end;
+        std::string owner;
+    };
+
+    /// @brief Collect the bytes of [begin, end) held by other owners
+    void find_conflicts(std::uintptr_t begin, std::uintptr_t end, const std::string& owner,
+                        std::vector<Conflict>& conflicts) const;
+
+    /// @brief Drop the claims of an owner (lock held)
+    void release_locked(const std::string& owner);
+
+    mutable std::mutex mutex_;
+    std::map<std::uintptr_t, Interval> intervals_;                              ///< Disjoint, by first byte
+    std::unordered_map<std::string, std::vector<std::uintptr_t>> owners_;      ///< First bytes of each owner's intervals
+};
+
+} // namespace app_hook::memory
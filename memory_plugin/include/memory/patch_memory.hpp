@@ -2,11 +2,14 @@
 
 #include "../config/patch_config.hpp"
 #include "../memory/memory_region.hpp"
+#include "../memory/patch_transaction.hpp"
 #include "../../core_hook/include/task/hook_task.hpp"
 #include "../../core_hook/include/context/mod_context.hpp"
 #include "../../core_hook/include/config/config_loader.hpp"
 #include <string>
 #include <cstdint>
+#include <mutex>
+#include <span>
 #include <vector>
 #include <windows.h>
 
@@ -18,17 +21,30 @@ namespace app_hook::memory {
 /// @brief Use instruction patch from config namespace
 using InstructionPatch = config::InstructionPatch;
 
+/// @brief Use compiled patch types from config namespace
+using CompiledPatchSet = config::CompiledPatchSet;
+using CompiledInstruction = config::CompiledInstruction;
+
 /// @brief Use patch config from config namespace
 using PatchConfig = config::PatchConfig;
 
 /// @brief Task that applies memory patches to instructions
 class PatchMemoryTask final : public task::IHookTask {
 public:
+    /// @brief Construct a memory patch task from the config's compiled patches
+    /// @param config Configuration for the patch operation
+    explicit PatchMemoryTask(PatchConfig config)
+        : config_(std::move(config)), patches_(config_.compiled()), host_(nullptr) {
+        patches_.sort_by_address();
+    }
+    
     /// @brief Construct a memory patch task
     /// @param config Configuration for the patch operation
-    /// @param patches Pre-parsed instruction patches
-    PatchMemoryTask(PatchConfig config, std::vector<InstructionPatch> patches) noexcept
-        : config_(std::move(config)), patches_(std::move(patches)), host_(nullptr) {}
+    /// @param patches Pre-parsed instruction patches (compiled on construction)
+    PatchMemoryTask(PatchConfig config, const std::vector<InstructionPatch>& patches)
+        : config_(std::move(config)), patches_(CompiledPatchSet::compile(patches)), host_(nullptr) {
+        patches_.sort_by_address();
+    }
     
     /// @brief Set the plugin host for logging
     void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
@@ -42,6 +58,18 @@ public:
     /// @return Task result indicating success or failure
     [[nodiscard]] task::TaskResult execute() override;
     
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    
+    /// @brief Take over reloaded patches, rewriting only the instructions that changed
+    /// @param updated Reloaded patch configuration
+    /// @return unchanged, updated, or restart_required for another config type
+    /// @note Instructions dropped from the file get their original bytes back
+    [[nodiscard]] task::ReloadOutcome reload(const config::ConfigBase& updated) override;
+    
+    /// @brief Put the original code back under every patched instruction
+    void rollback() override;
+    
     /// @brief Get the task name
     /// @return Task name
     [[nodiscard]] std::string name() const override;
@@ -52,6 +80,14 @@ public:
     
 
     
+    /// @brief Drop the config's compiled patches, keeping only the task's sorted copy
+    void compact() override;
+    
+    /// @brief Get the memory held by the task's configuration and its sorted patch copy
+    [[nodiscard]] std::size_t config_bytes() const noexcept override {
+        return config_.footprint_bytes() + patches_.heap_bytes() + transaction_.heap_bytes();
+    }
+    
     /// @brief Get the configuration
     /// @return Patch configuration
     [[nodiscard]] const PatchConfig& config() const noexcept {
@@ -59,27 +95,54 @@ public:
     }
     
     /// @brief Get the patches
-    /// @return Vector of instruction patches
-    [[nodiscard]] const std::vector<InstructionPatch>& patches() const noexcept {
+    /// @return Compiled instruction patches, ordered by address
+    /// @note Not synchronized with reload()
+    [[nodiscard]] const CompiledPatchSet& patches() const noexcept {
         return patches_;
     }
     
+    /// @brief Get the number of page groups the last execution wrote
+    /// @return Page group count (one protection change and one flush each)
+    [[nodiscard]] std::size_t page_groups() const noexcept {
+        return page_groups_;
+    }
+    
+    /// @brief Get the CRC32C of the bytes currently under the patches
+    /// @return Checksum over every instruction's range, in address order
+    /// @note Before the first execution this is the value for expectedOriginal
+    [[nodiscard]] std::uint32_t original_checksum() const noexcept;
+    
+    /// @brief Get the transaction holding the original bytes
+    /// @note Not synchronized with execute()
+    [[nodiscard]] const PatchTransaction& transaction() const noexcept {
+        return transaction_;
+    }
+    
 private:
     PatchConfig config_;
-    std::vector<InstructionPatch> patches_;
+    CompiledPatchSet patches_;
     app_hook::plugin::IPluginHost* host_ = nullptr;
+    context::ContextKey region_key_;  ///< Interned context key of the memory region
+    std::size_t page_groups_ = 0;
+    PatchTransaction transaction_;    ///< Original bytes under the written patches
+    bool applied_ = false;            ///< Patches were written at least once
+    bool compacted_ = false;          ///< config_ no longer holds the patches
+    mutable std::mutex mutex_;        ///< Serializes execute() with reload()
+    
+    /// @brief Get the context key of the memory region the patches point into
+    [[nodiscard]] const std::string& context_key() const noexcept {
+        return config_.reads_from_context() ? config_.read_from_context() : config_.key();
+    }
+    
+    /// @brief Check the code under the patches against expectedOriginal
+    /// @return true if no checksum is configured or it matches
+    [[nodiscard]] bool original_matches() const;
     
-    /// @brief Apply a single instruction patch
-    /// @param patch Patch to apply
+    /// @brief Write instructions through the transaction
+    /// @param instructions Instructions sorted by address
     /// @param new_base New memory base address
-    /// @return true if patch was successful
-    [[nodiscard]] bool apply_instruction_patch(const InstructionPatch& patch, std::uintptr_t new_base);
-    
-    /// @brief Replace 'XX XX XX XX' placeholders with actual address
-    /// @param bytes Byte array to modify
-    /// @param address Address to insert
-    /// @return true if placeholders were found and replaced
-    [[nodiscard]] bool replace_placeholders(std::vector<std::uint8_t>& bytes, std::uintptr_t address);
+    /// @return true if all were written, false if none were
+    [[nodiscard]] bool commit(std::span<const CompiledInstruction> instructions, std::uintptr_t new_base);
 };
 
 } // namespace app_hook::memory 
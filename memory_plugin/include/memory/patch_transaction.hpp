@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../config/compiled_patch.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Writes a patch set all at once and keeps the code it replaced
+///
+/// The original bytes under every instruction are saved in one contiguous
+/// undo buffer the first time the instruction's range is written; later
+/// commits over the same range keep the first copy, so a rollback always
+/// returns the pristine code. Writes go by page group (instructions whose
+/// pages touch), with one protection change and one instruction cache flush
+/// per group. A commit makes every group writable before touching any byte:
+/// if one protection change fails, nothing is written. Instructions at most
+/// kSpanGap bytes apart are assembled in a staging buffer and stored as one
+/// block, the bytes between them written back unchanged.
+class PatchTransaction {
+public:
+    /// @brief Largest run of untouched bytes between two instructions written as one block
+    static constexpr std::uintptr_t kSpanGap = 16;
+
+    /// @brief Write instructions, saving the bytes they replace first
+    /// @param patches Set supplying the instruction bytes
+    /// @param instructions Instructions of patches, sorted by address
+    /// @param new_base Memory base address stored over the placeholders
+    /// @return Number of page groups written, or patch_failed with nothing written
+    [[nodiscard]] std::expected<std::size_t, task::TaskError> commit(
+        const config::CompiledPatchSet& patches, std::span<const config::CompiledInstruction> instructions,
+        std::uintptr_t new_base);
+
+    /// @brief Put back every saved byte and forget it
+    /// @return Number of page groups restored
+    std::size_t rollback();
+
+    /// @brief Put back the bytes under some instructions and forget them
+    /// @param instructions Instructions sorted by address (of any set)
+    /// @return Number of page groups restored
+    std::size_t restore(std::span<const config::CompiledInstruction> instructions);
+
+    /// @brief Check if no original bytes are held
+    [[nodiscard]] bool empty() const noexcept { return saved_.empty(); }
+
+    /// @brief Get the number of saved address ranges
+    [[nodiscard]] std::size_t saved_ranges() const noexcept { return saved_.size(); }
+
+    /// @brief Get the number of original bytes held
+    [[nodiscard]] std::size_t saved_bytes() const noexcept;
+
+    /// @brief Get the heap memory held by the undo buffer and its index
+    [[nodiscard]] std::size_t heap_bytes() const noexcept {
+        return saved_.capacity() * sizeof(SavedRange) + undo_.capacity();
+    }
+
+private:
+    /// @brief Original bytes of one address range
+    struct SavedRange {
+        std::uintptr_t address;
+        std::uint32_t undo_offset;  ///< Start of the bytes in undo_
+        std::uint32_t length;
+    };
+
+    std::vector<SavedRange> saved_;    ///< Sorted by address, never overlapping
+    std::vector<std::uint8_t> undo_;   ///< Original bytes of every range
+
+    /// @brief Save the current bytes of the parts of the instructions not saved yet
+    void capture(std::span<const config::CompiledInstruction> instructions);
+
+    /// @brief Write saved ranges back under batched protection changes
+    /// @param ranges Ranges sorted by address
+    /// @return Number of page groups restored
+    static std::size_t write_back(std::span<const SavedRange> ranges, const std::vector<std::uint8_t>& undo);
+};
+
+} // namespace app_hook::memory
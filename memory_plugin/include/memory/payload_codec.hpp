@@ -0,0 +1,30 @@
+#pragma once
+
+#include "../config/load_in_memory_config.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <span>
+
+namespace app_hook::memory {
+
+/// @brief Get the size a LoadInMemory payload decodes to
+/// @param compression Codec the payload was written with
+/// @param payload Bytes read from the file, the staging buffer or the mod bundle
+/// @return Decoded size, or file_read_error if the stream is malformed or does not
+///         record its content size (`lz4 --content-size`; zstd records it by default)
+[[nodiscard]] std::expected<std::size_t, task::TaskError> decoded_size(
+    config::BinaryCompression compression, std::span<const std::uint8_t> payload);
+
+/// @brief Decode a LoadInMemory payload straight into its destination
+/// @param compression Codec the payload was written with
+/// @param payload Bytes read from the file, the staging buffer or the mod bundle
+/// @param destination Target of exactly decoded_size() bytes
+/// @return Success, or file_read_error if the stream is malformed
+/// @note A corrupt stream can leave the destination partly written
+[[nodiscard]] task::TaskResult decode_payload(
+    config::BinaryCompression compression, std::span<const std::uint8_t> payload,
+    std::span<std::uint8_t> destination);
+
+} // namespace app_hook::memory
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <windows.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Contiguous store for expanded memory regions
+///
+/// Regions are carved in order from large reserved blocks whose pages are
+/// committed on demand, so regions copied one after the other (a table and
+/// its text, for instance) end up next to each other with the alignment their
+/// config asks for. Blocks are keyed by config: a copy that runs again reuses
+/// its block instead of growing the arena. Regions that may grow get their own
+/// reservation instead, committed page by page as they fill, so their base
+/// never moves. Reservations can also be write-watched (MEM_WRITE_WATCH) so
+/// RegionSnapshots copies only the pages written since its last pass. Nothing
+/// is freed individually; the whole arena is released at shutdown.
+class RegionArena {
+public:
+    /// @brief Address space reserved per chunk
+    static constexpr std::size_t kChunkSize = 16 * 1024 * 1024;
+    
+    /// @brief Granularity of page commits
+    static constexpr std::size_t kCommitSize = 64 * 1024;
+    
+    /// @brief Granularity of commits in growable regions
+    static constexpr std::size_t kPageSize = 4096;
+    
+    /// @brief Alignment used when a config does not ask for one
+    static constexpr std::size_t kDefaultAlignment = 16;
+
+    /// @brief Committed pages of a write-watched reservation
+    struct WatchedRange {
+        std::string key;            ///< Key of the region
+        std::uint8_t* base;         ///< Start of the reservation
+        std::size_t committed;      ///< Committed bytes (whole pages)
+    };
+
+    /// @brief Get the arena shared by the plugin's copy tasks
+    /// @return Arena instance
+    static RegionArena& instance();
+
+    /// @brief Constructor
+    /// @param chunk_size Address space reserved per chunk
+    explicit RegionArena(std::size_t chunk_size = kChunkSize) : chunk_size_(chunk_size) {}
+    
+    /// @brief Releases every chunk
+    ~RegionArena() { release(); }
+
+    // Non-copyable, non-movable
+    RegionArena(const RegionArena&) = delete;
+    RegionArena& operator=(const RegionArena&) = delete;
+    RegionArena(RegionArena&&) = delete;
+    RegionArena& operator=(RegionArena&&) = delete;
+
+    /// @brief Get the block of a region, carving it on first use
+    /// @param key Key of the region (reused blocks keep their address)
+    /// @param size Size of the block
+    /// @param alignment Alignment of the block (power of two)
+    /// @return Zero-initialized on first use, or nullptr if the arena cannot grow
+    [[nodiscard]] std::uint8_t* allocate(const std::string& key, std::size_t size,
+                                         std::size_t alignment = kDefaultAlignment);
+
+    /// @brief Get the reservation of a growable region, reserving it on first use
+    /// @param key Key of the region (a large enough reservation keeps its address)
+    /// @param capacity Address space the region may grow into
+    /// @param size Bytes to commit now
+    /// @param write_watch Track written pages with MEM_WRITE_WATCH (a reservation
+    ///        reserved without it is replaced)
+    /// @return Start of the reservation, aligned to the allocation granularity, with
+    ///         every committed byte past size zeroed; nullptr if it cannot be reserved
+    [[nodiscard]] std::uint8_t* reserve(const std::string& key, std::size_t capacity, std::size_t size,
+                                        bool write_watch = false);
+
+    /// @brief Commit the pages of a growable region up to a size
+    /// @param base Start of the reservation
+    /// @param size Bytes that must be committed; new pages are zeroed
+    /// @return False if base is not a reservation, size exceeds its capacity or the commit fails
+    [[nodiscard]] bool grow(const std::uint8_t* base, std::size_t size);
+
+    /// @brief Get the write-watched reservations in use
+    /// @return One range per key, in no particular order
+    [[nodiscard]] std::vector<WatchedRange> watched_ranges() const;
+
+    /// @brief Release every chunk; all blocks become invalid
+    void release();
+
+    /// @brief Get the number of carved blocks
+    /// @return Block count
+    [[nodiscard]] std::size_t block_count() const;
+
+    /// @brief Get the bytes handed out, alignment padding included
+    /// @return Used bytes
+    [[nodiscard]] std::size_t used_bytes() const;
+
+    /// @brief Get the committed bytes
+    /// @return Committed bytes of the chunks and the reservations
+    [[nodiscard]] std::size_t committed_bytes() const;
+
+    /// @brief Get the reserved address space
+    /// @return Reserved bytes of the chunks and the reservations
+    [[nodiscard]] std::size_t reserved_bytes() const;
+
+private:
+    /// @brief One reserved range of the arena
+    struct Chunk {
+        std::uint8_t* base;
+        std::size_t reserved;
+        std::size_t committed;
+        std::size_t used;
+        bool watched = false;   ///< Reserved with MEM_WRITE_WATCH
+    };
+
+    /// @brief A carved block
+    struct Block {
+        std::uint8_t* base;
+        std::size_t size;
+    };
+
+    /// @brief Carve a new block at the end of the arena
+    [[nodiscard]] std::uint8_t* carve(std::size_t size, std::size_t alignment);
+
+    /// @brief Reserve a new chunk able to hold a block
+    [[nodiscard]] bool add_chunk(std::size_t min_size);
+
+    /// @brief Commit a chunk's pages up to an offset
+    /// @param granularity Commit step (power of two)
+    [[nodiscard]] static bool commit_to(Chunk& chunk, std::size_t end, std::size_t granularity = kCommitSize);
+
+    std::size_t chunk_size_;
+    mutable std::mutex mutex_;
+    std::vector<Chunk> chunks_;
+    std::unordered_map<std::string, Block> blocks_;
+    std::vector<Chunk> reservations_;                       ///< Growable regions; used is unused
+    std::unordered_map<std::string, std::size_t> reserved_; ///< Index of each key's reservation
+};
+
+} // namespace app_hook::memory
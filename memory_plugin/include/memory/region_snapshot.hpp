@@ -0,0 +1,102 @@
+#pragma once
+
+#include "region_arena.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Error types for region snapshots
+enum class SnapshotError {
+    no_watched_regions,   ///< No region was copied with snapshots = true
+    unknown_snapshot,     ///< No snapshot has that name
+    watch_failed          ///< GetWriteWatch refused a region
+};
+
+/// @brief Work done by a capture or restore
+struct SnapshotStats {
+    std::size_t regions = 0;        ///< Watched regions visited
+    std::size_t pages = 0;          ///< Pages copied
+    std::size_t bytes = 0;          ///< Bytes copied
+};
+
+/// @brief Named save states of the write-watched regions
+///
+/// Regions copied with snapshots = true live in reservations allocated with
+/// MEM_WRITE_WATCH. The first capture of a name copies their committed pages
+/// whole; after that, every pass asks the OS which pages were written
+/// (GetWriteWatch, resetting the marks) and flags them in every snapshot, so
+/// capturing again copies only the pages written since that snapshot, and
+/// restoring copies back only the pages written since it was captured. The
+/// cost of both follows what the game changed, not the size of the regions.
+///
+/// Pages a region committed after a capture (a growable region filled by a
+/// later load) are copied whole by the next capture and left as they are by a
+/// restore. A region copied again at a new address starts over with a full copy.
+///
+/// @note Capture and restore from the game thread, or while it is paused: a
+///       page written during the copy may be captured or restored half updated
+class RegionSnapshots {
+public:
+    /// @brief Get the snapshots of the plugin's region arena
+    static RegionSnapshots& instance();
+
+    /// @brief Constructor
+    /// @param arena Arena whose watched reservations are snapshotted
+    explicit RegionSnapshots(RegionArena& arena = RegionArena::instance()) : arena_(arena) {}
+
+    // Non-copyable, non-movable
+    RegionSnapshots(const RegionSnapshots&) = delete;
+    RegionSnapshots& operator=(const RegionSnapshots&) = delete;
+    RegionSnapshots(RegionSnapshots&&) = delete;
+    RegionSnapshots& operator=(RegionSnapshots&&) = delete;
+
+    /// @brief Take a snapshot, or bring an existing one up to date
+    /// @param name Snapshot name
+    /// @return Pages copied, or the reason no snapshot was taken
+    [[nodiscard]] std::expected<SnapshotStats, SnapshotError> capture(const std::string& name);
+
+    /// @brief Put the watched regions back as they were when a snapshot was captured
+    /// @param name Snapshot name
+    /// @return Pages copied back, or the reason nothing was restored
+    [[nodiscard]] std::expected<SnapshotStats, SnapshotError> restore(const std::string& name);
+
+    /// @brief Forget a snapshot
+    /// @param name Snapshot name
+    /// @return false if there is no such snapshot
+    bool drop(const std::string& name);
+
+    /// @brief Get the snapshot names, sorted
+    [[nodiscard]] std::vector<std::string> names() const;
+
+    /// @brief Get the memory held by the snapshots' copies
+    [[nodiscard]] std::size_t bytes() const;
+
+private:
+    /// @brief Copy of one region in one snapshot
+    struct Shadow {
+        std::uint8_t* base = nullptr;       ///< Reservation the copy was taken from
+        std::vector<std::uint8_t> bytes;    ///< Committed bytes when captured
+        std::vector<bool> dirty;            ///< Pages written since they were captured
+    };
+
+    /// @brief Regions of one snapshot, by key
+    using Snapshot = std::unordered_map<std::string, Shadow>;
+
+    /// @brief Move the OS write marks into every snapshot's dirty pages (mutex_ held)
+    /// @param ranges Watched reservations
+    /// @return false if GetWriteWatch failed for a range
+    [[nodiscard]] bool collect(const std::vector<RegionArena::WatchedRange>& ranges);
+
+    RegionArena& arena_;
+    mutable std::mutex mutex_;
+    std::map<std::string, Snapshot> snapshots_;
+};
+
+} // namespace app_hook::memory
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace app_hook::memory {
+
+/// @brief Offset index of a text table written into a region
+///
+/// Published by TextLoadTask next to the view of its block, so patches and
+/// scripts find a string by number without walking the table in game memory.
+struct TextIndex {
+    std::uint8_t* block = nullptr;          ///< Start of the offset table
+    std::uint8_t* data = nullptr;           ///< Start of the string data
+    std::size_t data_size = 0;              ///< Size of the string data, terminators included
+    std::vector<std::uint32_t> offsets;     ///< Start of each string, from data
+
+    /// @brief Get the number of strings
+    [[nodiscard]] std::size_t count() const noexcept { return offsets.size(); }
+
+    /// @brief Get the address of a string
+    /// @return Address, or nullptr if the index is out of range
+    [[nodiscard]] std::uint8_t* string(std::size_t index) const noexcept {
+        return index < offsets.size() ? data + offsets[index] : nullptr;
+    }
+
+    /// @brief Get the encoded bytes of a string, without its terminator
+    /// @return Bytes, empty if the index is out of range
+    [[nodiscard]] std::span<const std::uint8_t> bytes(std::size_t index) const noexcept {
+        if (index >= offsets.size()) {
+            return {};
+        }
+        const std::size_t end = index + 1 < offsets.size() ? offsets[index + 1] : data_size;
+        return {data + offsets[index], end - offsets[index] - 1};
+    }
+};
+
+} // namespace app_hook::memory
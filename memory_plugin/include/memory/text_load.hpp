@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../config/text_config.hpp"
+#include "../memory/memory_region.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include "../../core_hook/include/context/mod_context.hpp"
+#include <cstdint>
+#include <mutex>
+
+// Forward declaration
+namespace app_hook::plugin { class IPluginHost; }
+
+namespace app_hook::memory {
+
+// Use the config structure from the config namespace
+using TextConfig = config::TextConfig;
+
+/// @brief Task that writes an encoded text table into a region of the mod context
+///
+/// The block is the offset table followed by the strings, encoded when the
+/// config was loaded; it is written in one pass at the configured offset, or
+/// after the region's original bytes like LoadInMemory. A reserved region grows
+/// to fit it. With writeInContext set, the task publishes a view of the block
+/// under the name and a TextIndex under "<name>.index".
+class TextLoadTask final : public task::IHookTask {
+public:
+    /// @brief Construct a text load task
+    /// @param config Configuration for the text table
+    explicit TextLoadTask(TextConfig config) noexcept
+        : config_(std::move(config)), host_(nullptr) {}
+
+    /// @brief Set the plugin host for logging
+    void setHost(app_hook::plugin::IPluginHost* host) { host_ = host; }
+
+    /// @brief Set the plugin host for logging (base interface override)
+    void setHost(void* host) override {
+        host_ = static_cast<app_hook::plugin::IPluginHost*>(host);
+    }
+
+    /// @brief Write the table into the region and publish its index
+    /// @return Task result indicating success or failure
+    [[nodiscard]] task::TaskResult execute() override;
+
+    /// @brief Get the direct entry point used by compiled task programs
+    [[nodiscard]] task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+
+    /// @brief Take over reloaded strings, writing them again if the table was written
+    /// @param updated Reloaded text configuration
+    /// @return unchanged, updated, or restart_required when the target or published names changed
+    [[nodiscard]] task::ReloadOutcome reload(const config::ConfigBase& updated) override;
+
+    /// @brief Get the task name
+    /// @return Task name
+    [[nodiscard]] std::string name() const override {
+        return "TextLoad";
+    }
+
+    /// @brief Get the task description
+    /// @return Task description
+    [[nodiscard]] std::string description() const override {
+        return "Write " + std::to_string(config_.count()) + " string(s) of text table '" + config_.key() +
+               "' into '" + config_.read_from_context() + "'";
+    }
+
+    /// @brief Shrink the configuration's buffers
+    void compact() override {
+        std::lock_guard lock(mutex_);
+        config_.compact();
+    }
+
+    /// @brief Get the memory held by the task's configuration
+    [[nodiscard]] std::size_t config_bytes() const noexcept override {
+        return config_.footprint_bytes();
+    }
+
+    /// @brief Get the configuration
+    /// @return Text configuration
+    /// @note Not synchronized with reload()
+    [[nodiscard]] const TextConfig& config() const noexcept {
+        return config_;
+    }
+
+private:
+    TextConfig config_;
+    app_hook::plugin::IPluginHost* host_ = nullptr;
+    context::ContextKey region_key_;          ///< Interned context key of the target region
+    context::ContextKey view_key_;            ///< Interned context key of the published view
+    context::ContextKey index_key_;           ///< Interned context key of the published index
+    bool written_ = false;                    ///< Whether execute() wrote the table
+    std::mutex mutex_;                        ///< Serializes execute() with reload()
+
+    /// @brief Write the block and publish it
+    [[nodiscard]] task::TaskResult write();
+};
+
+} // namespace app_hook::memory
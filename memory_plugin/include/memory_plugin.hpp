@@ -0,0 +1,13 @@
+#pragma once
+
+#include "plugin/plugin_interface.hpp"
+#include <memory>
+
+namespace memory_plugin {
+
+/// @brief Create the memory plugin linked into the host
+/// @return Plugin instance, for PluginManager::add_builtin_plugin
+/// @note Only built with APP_HOOK_STATIC_MEMORY_PLUGIN; the DLL exports CreatePlugin instead
+[[nodiscard]] std::unique_ptr<app_hook::plugin::IPlugin> create_builtin_plugin();
+
+} // namespace memory_plugin
@@ -0,0 +1,328 @@
+#include "../include/memory/access_sampler.hpp"
+#include "util/hex_dump.hpp"
+#include "util/pe_image.hpp"
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+
+namespace app_hook::memory {
+
+namespace {
+
+/// @brief Sampler whose regions the exception handler serves
+std::atomic<AccessSampler*> g_active{nullptr};
+
+LONG CALLBACK on_exception(EXCEPTION_POINTERS* info) {
+    if (info->ExceptionRecord->ExceptionCode != STATUS_GUARD_PAGE_VIOLATION ||
+        info->ExceptionRecord->NumberParameters < 2) {
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+    auto* sampler = g_active.load(std::memory_order_acquire);
+    if (!sampler) {
+        return EXCEPTION_CONTINUE_SEARCH;
+    }
+#ifdef _WIN64
+    const auto instruction = static_cast<std::uintptr_t>(info->ContextRecord->Rip);
+#else
+    const auto instruction = static_cast<std::uintptr_t>(info->ContextRecord->Eip);
+#endif
+    const auto address = static_cast<std::uintptr_t>(info->ExceptionRecord->ExceptionInformation[1]);
+    // The guard is already lifted: running the instruction again completes the access
+    return sampler->on_guard_fault(instruction, address) ? EXCEPTION_CONTINUE_EXECUTION : EXCEPTION_CONTINUE_SEARCH;
+}
+
+std::uintptr_t page_size() noexcept {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwPageSize;
+}
+
+} // namespace
+
+AccessSampler& AccessSampler::instance() {
+    // Never destroyed: at process exit its timer thread may be gone with mutex_ held
+    static auto* sampler = new AccessSampler();
+    return *sampler;
+}
+
+AccessSampler::AccessSampler(std::chrono::milliseconds interval) : interval_(interval) {
+    for (std::uint32_t i = 0; i < kRingSize; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+AccessSampler::~AccessSampler() {
+    if (timer_) {
+        DeleteTimerQueueTimer(nullptr, timer_, INVALID_HANDLE_VALUE);
+        timer_ = nullptr;
+    }
+
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock()) {
+        lock.unlock();
+        stop();
+        return;
+    }
+    // Leave the guards: only stop the handler from reaching this object
+    AccessSampler* self = this;
+    g_active.compare_exchange_strong(self, nullptr);
+    if (handler_) {
+        RemoveVectoredExceptionHandler(handler_);
+    }
+}
+
+bool AccessSampler::watch(const std::string& key, std::uintptr_t address, std::size_t size) {
+    if (address == 0 || size == 0) {
+        return false;
+    }
+
+    std::lock_guard lock(mutex_);
+    if (std::ranges::find(keys_, key) != keys_.end()) {
+        return true;
+    }
+    const auto count = region_count_.load(std::memory_order_relaxed);
+    AccessSampler* expected = nullptr;
+    if (count == kMaxRegions || (!g_active.compare_exchange_strong(expected, this) && expected != this)) {
+        return false;
+    }
+
+    const auto page = page_size();
+    Watched region{address, address + size, address & ~(page - 1), (address + size + page - 1) & ~(page - 1), 0};
+    MEMORY_BASIC_INFORMATION info{};
+    if (!VirtualQuery(reinterpret_cast<void*>(address), &info, sizeof(info)) || info.State != MEM_COMMIT) {
+        if (count == 0) {
+            g_active.store(nullptr, std::memory_order_release);
+        }
+        return false;
+    }
+    region.protect = info.Protect & ~static_cast<DWORD>(PAGE_GUARD);
+
+    if (count == 0) {
+        if (const auto image = util::main_module_image()) {
+            code_begin_ = image->code_begin;
+            code_end_ = image->code_begin + image->code_size;
+        }
+    }
+
+    // Publish the region before its pages can fault
+    regions_[count] = region;
+    keys_.push_back(key);
+    region_count_.store(count + 1, std::memory_order_release);
+
+    if (!handler_) {
+        handler_ = AddVectoredExceptionHandler(1, on_exception);
+    }
+    if (!timer_ && !CreateTimerQueueTimer(&timer_, nullptr, on_timer, this, static_cast<DWORD>(interval_.count()),
+                                          static_cast<DWORD>(interval_.count()), WT_EXECUTEDEFAULT)) {
+        timer_ = nullptr;
+    }
+
+    DWORD old = 0;
+    return handler_ && VirtualProtect(reinterpret_cast<void*>(region.page_begin), region.page_end - region.page_begin,
+                                      region.protect | PAGE_GUARD, &old);
+}
+
+void AccessSampler::stop(bool wait) {
+    // Delete the timer first so no re-arm follows the guards being lifted
+    if (timer_) {
+        DeleteTimerQueueTimer(nullptr, timer_, wait ? INVALID_HANDLE_VALUE : nullptr);
+        timer_ = nullptr;
+    }
+
+    std::lock_guard lock(mutex_);
+    const auto count = region_count_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& region = regions_[i];
+        DWORD old = 0;
+        VirtualProtect(reinterpret_cast<void*>(region.page_begin), region.page_end - region.page_begin,
+                       region.protect, &old);
+    }
+    if (handler_) {
+        RemoveVectoredExceptionHandler(handler_);
+        handler_ = nullptr;
+    }
+    region_count_.store(0, std::memory_order_release);
+    AccessSampler* self = this;
+    g_active.compare_exchange_strong(self, nullptr);
+
+    // Keep the last samples: their keys are still known
+    drain_locked();
+    keys_.clear();
+}
+
+bool AccessSampler::on_guard_fault(std::uintptr_t instruction, std::uintptr_t address) noexcept {
+    const auto count = region_count_.load(std::memory_order_acquire);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& region = regions_[i];
+        if (address < region.page_begin || address >= region.page_end) {
+            continue;
+        }
+        // Other data sharing the region's pages faults too, but is not a missed patch
+        if (address < region.begin || address >= region.end) {
+            return true;
+        }
+
+        // Bounded MPMC enqueue: claim a slot whose sequence matches the position
+        auto position = head_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& sample = ring_[position & (kRingSize - 1)];
+            const auto sequence = sample.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::int32_t>(sequence - position);
+            if (difference == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    sample.instruction = instruction;
+                    sample.address = address;
+                    sample.region = static_cast<std::uint32_t>(i);
+                    sample.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    return false;
+}
+
+void AccessSampler::drain() {
+    std::lock_guard lock(mutex_);
+    drain_locked();
+}
+
+void AccessSampler::drain_locked() {
+    while (true) {
+        auto& sample = ring_[tail_ & (kRingSize - 1)];
+        if (sample.sequence.load(std::memory_order_acquire) != tail_ + 1) {
+            break;
+        }
+        const auto instruction = sample.instruction;
+        const auto address = sample.address;
+        const auto index = sample.region;
+        sample.sequence.store(tail_ + kRingSize, std::memory_order_release);
+        ++tail_;
+
+        if (index >= keys_.size()) {
+            continue;
+        }
+        // Only the executable's code can be patched; this plugin's own copies land here too
+        if (code_end_ != 0 && (instruction < code_begin_ || instruction >= code_end_)) {
+            ++outside_;
+            continue;
+        }
+        auto [it, inserted] = sites_.try_emplace(instruction);
+        auto& site = it->second;
+        ++site.hits;
+        if (!inserted) {
+            continue;
+        }
+        const auto& region = regions_[index];
+        site.instruction = instruction;
+        site.region_begin = region.begin;
+        site.region_size = static_cast<std::uint32_t>(region.end - region.begin);
+        site.offset = static_cast<std::uint32_t>(address - region.begin);
+        site.region = keys_[index];
+
+        // The code may end close to an unmapped page: read what can be read
+        SIZE_T read = 0;
+        for (const std::size_t want : {site.code.size(), std::size_t{8}}) {
+            if (ReadProcessMemory(GetCurrentProcess(), reinterpret_cast<const void*>(instruction), site.code.data(),
+                                  want, &read)) {
+                site.code_size = static_cast<std::uint8_t>(read);
+                break;
+            }
+        }
+    }
+}
+
+std::vector<AccessSite> AccessSampler::sites() {
+    drain();
+    std::lock_guard lock(mutex_);
+    std::vector<AccessSite> result;
+    result.reserve(sites_.size());
+    for (const auto& [instruction, site] : sites_) {
+        result.push_back(site);
+    }
+    return result;
+}
+
+bool AccessSampler::write_report(const std::filesystem::path& path) {
+    const auto found = sites();
+    if (found.empty()) {
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(path.parent_path(), error);
+    std::ofstream out(path, std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    out << "# Instructions that still touched the old address of a relocated region\n"
+        << "# (sampled with sampleAccesses = true). Review each entry, then move it into\n"
+        << "# the region's patch file.\n";
+    if (const auto lost = dropped()) {
+        out << "# " << lost << " sample(s) were dropped: the ring was full\n";
+    }
+    if (outside_ != 0) {
+        out << "# " << outside_ << " sample(s) came from code outside the executable and are not listed\n";
+    }
+    for (const auto& site : found) {
+        out << '\n' << patch_entry(site);
+    }
+    return static_cast<bool>(out);
+}
+
+std::string AccessSampler::patch_entry(const AccessSite& site) {
+    std::string entry = std::format("# {}: {} sampled access(es), first at offset 0x{:X}\n",
+                                    site.region, site.hits, site.offset);
+
+    // An absolute address into the region is what a patch rewrites
+    const std::span code{site.code.data(), site.code_size};
+    for (std::size_t position = 0; position + 4 <= code.size(); ++position) {
+        std::uint32_t value = 0;
+        std::memcpy(&value, code.data() + position, sizeof(value));
+        if (value < site.region_begin || value - site.region_begin >= site.region_size) {
+            continue;
+        }
+        entry += std::format("[instructions.0x{:08X}]\n", site.instruction);
+        entry += position == 0 ? std::string{"bytes = \"XX XX XX XX\"\n"}
+                               : std::format("bytes = \"{} XX XX XX XX\"\n", util::HexDump{code.first(position)});
+        entry += std::format("offset = \"0x{:X}\"\n", value - site.region_begin);
+        return entry;
+    }
+
+    entry += std::format("# The address is computed at run time: patch the code that computes it by hand\n"
+                         "# [instructions.0x{:08X}]\n# code = \"{}\"\n", site.instruction, util::HexDump{code});
+    return entry;
+}
+
+void AccessSampler::rearm() noexcept {
+    const auto count = region_count_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& region = regions_[i];
+        DWORD old = 0;
+        VirtualProtect(reinterpret_cast<void*>(region.page_begin), region.page_end - region.page_begin,
+                       region.protect | PAGE_GUARD, &old);
+    }
+}
+
+VOID CALLBACK AccessSampler::on_timer(PVOID sampler, BOOLEAN) {
+    auto* self = static_cast<AccessSampler*>(sampler);
+    bool added = false;
+    {
+        std::lock_guard lock(self->mutex_);
+        self->drain_locked();
+        self->rearm();
+        added = !self->report_path_.empty() && self->sites_.size() != self->reported_sites_;
+        self->reported_sites_ = self->sites_.size();
+    }
+    // Here rather than at exit, which runs under the loader lock and skips the plugin's shutdown
+    if (added) {
+        (void)self->write_report(self->report_path_);
+    }
+}
+
+} // namespace app_hook::memory
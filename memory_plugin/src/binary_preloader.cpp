@@ -0,0 +1,129 @@
+#include "../include/memory/binary_preloader.hpp"
+#include <unordered_set>
+
+namespace app_hook::memory {
+
+BinaryPreloader& BinaryPreloader::instance() {
+    // Never destroyed: at process exit the OS has already killed the staging
+    // thread, so a destructor waiting for it would hang the exit. An unload
+    // clears it from the plugin's shutdown instead
+    static auto* preloader = new BinaryPreloader();
+    return *preloader;
+}
+
+BinaryPreloader::~BinaryPreloader() {
+    clear();
+}
+
+void BinaryPreloader::preload(const std::string& path) {
+    std::lock_guard lock(mutex_);
+    if (path.empty() || entries_.contains(path)) {
+        return;
+    }
+
+    entries_.emplace(path, Entry{});
+    queue_.push_back(path);
+
+    if (!running_) {
+        running_ = true;
+        // Detached: it exits by itself once the queue is empty, and clear()
+        // waits on running_ for a read in progress
+        std::thread([this] { run(); }).detach();
+    }
+}
+
+std::shared_ptr<const BinaryPreloader::Buffer> BinaryPreloader::acquire(const std::string& path,
+                                                                        std::chrono::milliseconds timeout) {
+    std::unique_lock lock(mutex_);
+    auto it = entries_.find(path);
+    if (it == entries_.end()) {
+        return nullptr;
+    }
+
+    // Reading it here is faster than waiting behind the rest of the queue
+    if (it->second.state == State::queued) {
+        return nullptr;
+    }
+
+    if (it->second.state == State::loading) {
+        changed_.wait_for(lock, timeout, [this, &path] {
+            auto current = entries_.find(path);
+            return current == entries_.end() || current->second.state != State::loading;
+        });
+        it = entries_.find(path);
+        if (it == entries_.end()) {
+            return nullptr;
+        }
+    }
+
+    return it->second.state == State::ready ? it->second.data : nullptr;
+}
+
+void BinaryPreloader::invalidate(const std::string& path) {
+    std::lock_guard lock(mutex_);
+    entries_.erase(path);
+    std::erase(queue_, path);
+}
+
+void BinaryPreloader::clear() {
+    std::unique_lock lock(mutex_);
+    queue_.clear();
+    changed_.wait(lock, [this] { return !running_; });
+    entries_.clear();
+}
+
+std::size_t BinaryPreloader::staged_count() const {
+    std::lock_guard lock(mutex_);
+    std::size_t count = 0;
+    for (const auto& [path, entry] : entries_) {
+        count += entry.state == State::ready ? 1 : 0;
+    }
+    return count;
+}
+
+std::size_t BinaryPreloader::staged_bytes() const {
+    std::lock_guard lock(mutex_);
+    std::unordered_set<const Buffer*> counted;
+    std::size_t bytes = 0;
+    for (const auto& [path, entry] : entries_) {
+        if (entry.state == State::ready && counted.insert(entry.data.get()).second) {
+            bytes += entry.data->size();
+        }
+    }
+    return bytes;
+}
+
+void BinaryPreloader::run() {
+    std::unique_lock lock(mutex_);
+    while (!queue_.empty()) {
+        const std::string path = std::move(queue_.front());
+        queue_.pop_front();
+
+        auto it = entries_.find(path);
+        if (it == entries_.end() || it->second.state != State::queued) {
+            continue;
+        }
+        it->second.state = State::loading;
+
+        lock.unlock();
+        auto data = read_file(path);
+        lock.lock();
+
+        // The entry may have been invalidated while the file was being read
+        if (it = entries_.find(path); it != entries_.end() && it->second.state == State::loading) {
+            it->second.state = data ? State::ready : State::failed;
+            it->second.data = std::move(data);
+        }
+        changed_.notify_all();
+    }
+
+    running_ = false;
+    changed_.notify_all();
+}
+
+std::shared_ptr<const BinaryPreloader::Buffer> BinaryPreloader::read_file(const std::string& path) {
+    auto blob = BlobStore::instance().load(path);
+    return blob ? std::move(*blob) : nullptr;
+}
+
+} // namespace app_hook::memory
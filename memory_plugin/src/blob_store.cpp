@@ -0,0 +1,121 @@
+#include "../include/memory/blob_store.hpp"
+#include "util/crc32c.hpp"
+#include <algorithm>
+#include <fstream>
+#include <new>
+#include <span>
+
+namespace app_hook::memory {
+
+namespace {
+
+/// @brief Content key: size in the high half, CRC32C in the low half
+std::uint64_t content_key(std::span<const std::uint8_t> bytes) noexcept {
+    return (std::uint64_t{static_cast<std::uint32_t>(bytes.size())} << 32) | util::crc32c(bytes);
+}
+
+/// @brief Identity key of a path: its canonical form when it can be resolved
+std::string identity_of(const std::string& path) {
+    std::error_code ec;
+    auto canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? path : canonical.make_preferred().string();
+}
+
+} // namespace
+
+BlobStore& BlobStore::instance() {
+    static BlobStore store;
+    return store;
+}
+
+std::expected<std::shared_ptr<const BlobStore::Buffer>, task::TaskError> BlobStore::load(const std::string& path) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return std::unexpected(task::TaskError::file_not_found);
+    }
+    const auto write_time = std::filesystem::last_write_time(path, ec);
+    if (ec || size == 0) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+
+    const auto identity = identity_of(path);
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = files_.find(identity); it != files_.end() && it->second.size == size &&
+                                             it->second.write_time == write_time) {
+            if (auto blob = it->second.blob.lock()) {
+                ++file_hits_;
+                bytes_shared_ += blob->size();
+                return blob;
+            }
+        }
+    }
+
+    // Read outside the lock: other loads go on meanwhile
+    std::shared_ptr<Buffer> bytes;
+    try {
+        bytes = std::make_shared<Buffer>(static_cast<std::size_t>(size));
+    } catch (const std::bad_alloc&) {
+        return std::unexpected(task::TaskError::memory_allocation_failed);
+    }
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::unexpected(task::TaskError::file_not_found);
+    }
+    file.read(reinterpret_cast<char*>(bytes->data()), static_cast<std::streamsize>(size));
+    if (!file) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+    const auto key = content_key(*bytes);
+
+    std::lock_guard lock(mutex_);
+    prune();
+    std::shared_ptr<const Buffer> blob = find_content(key, *bytes);
+    if (blob) {
+        ++content_hits_;
+        bytes_shared_ += blob->size();
+    } else {
+        blob = std::move(bytes);
+        contents_.emplace(key, blob);
+    }
+    files_.insert_or_assign(identity, FileEntry{size, write_time, blob});
+    return blob;
+}
+
+void BlobStore::invalidate(const std::string& path) {
+    std::lock_guard lock(mutex_);
+    files_.erase(identity_of(path));
+}
+
+BlobStoreStats BlobStore::stats() const {
+    std::lock_guard lock(mutex_);
+    BlobStoreStats result;
+    for (const auto& [key, weak] : contents_) {
+        if (auto blob = weak.lock()) {
+            ++result.blobs;
+            result.bytes += blob->size();
+        }
+    }
+    result.file_hits = file_hits_;
+    result.content_hits = content_hits_;
+    result.bytes_shared = bytes_shared_;
+    return result;
+}
+
+std::shared_ptr<const BlobStore::Buffer> BlobStore::find_content(std::uint64_t key, const Buffer& bytes) const {
+    const auto [first, last] = contents_.equal_range(key);
+    for (auto it = first; it != last; ++it) {
+        if (auto blob = it->second.lock(); blob && *blob == bytes) {
+            return blob;
+        }
+    }
+    return nullptr;
+}
+
+void BlobStore::prune() {
+    std::erase_if(files_, [](const auto& entry) { return entry.second.blob.expired(); });
+    std::erase_if(contents_, [](const auto& entry) { return entry.second.expired(); });
+}
+
+} // namespace app_hook::memory
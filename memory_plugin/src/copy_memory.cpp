@@ -1,7 +1,10 @@
 #include "../include/memory/copy_memory.hpp"
+#include "../include/memory/access_sampler.hpp"
 #include "../include/memory/memory_region.hpp"
+#include "../include/memory/region_arena.hpp"
 #include "../../core_hook/include/task/hook_task.hpp"
 #include "../../core_hook/include/context/mod_context.hpp"
+#include "../../core_hook/include/util/reference_scanner.hpp"
 #include "plugin/plugin_interface.hpp"
 
 namespace app_hook::memory {
@@ -12,6 +15,59 @@ using CopyMemoryConfig = config::CopyMemoryConfig;
 /// @brief Execute the memory copy operation
 /// @return Task result indicating success or failure
 task::TaskResult CopyMemoryTask::execute() {
+    std::lock_guard lock(mutex_);
+    auto result = copy_region();
+    if (result) {
+        copied_ = true;
+    }
+    return result;
+}
+
+task::ReloadOutcome CopyMemoryTask::reload(const config::ConfigBase& updated) {
+    if (updated.type_id() != CopyMemoryConfig::kTypeId) {
+        return task::ReloadOutcome::restart_required;
+    }
+    const auto& copy_config = static_cast<const CopyMemoryConfig&>(updated);
+    
+    std::lock_guard lock(mutex_);
+    // The hook is already installed and its followers read the region under this name
+    if (copy_config.copy_after() != config_.copy_after() || 
+        copy_config.write_in_context().name != config_.write_in_context().name) {
+        return task::ReloadOutcome::restart_required;
+    }
+    
+    const bool region_changed = copy_config.address() != config_.address() ||
+        copy_config.original_size() != config_.original_size() ||
+        copy_config.new_size() != config_.new_size() ||
+        copy_config.alignment() != config_.alignment() ||
+        copy_config.reserve_size() != config_.reserve_size() ||
+        copy_config.snapshots() != config_.snapshots() ||
+        copy_config.rebase_self() != config_.rebase_self() ||
+        copy_config.rebase_from() != config_.rebase_from();
+    if (!region_changed) {
+        if (copy_config.description() == config_.description()) {
+            return task::ReloadOutcome::unchanged;
+        }
+        config_ = copy_config;
+        return task::ReloadOutcome::updated;
+    }
+    
+    config_ = copy_config;
+    if (!copied_) {
+        return task::ReloadOutcome::updated;
+    }
+    
+    // A larger region gets a new arena block, and the copy resets what was loaded into it:
+    // the followers must load and patch again
+    if (auto result = copy_region(); !result) {
+        PLUGIN_LOG_ERROR("Failed to copy reloaded region '{}'", config_.key());
+        return task::ReloadOutcome::restart_required;
+    }
+    PLUGIN_LOG_INFO("Reloaded region '{}': {} -> {} bytes", config_.key(), config_.original_size(), config_.new_size());
+    return task::ReloadOutcome::dependents_stale;
+}
+
+task::TaskResult CopyMemoryTask::copy_region() {
         PLUGIN_LOG_DEBUG("Executing CopyMemoryTask for key '{}'", config_.key());
         PLUGIN_LOG_DEBUG("Source address: 0x{:X}, Size: {} -> {}", config_.address(), config_.original_size(), config_.new_size());
         
@@ -21,35 +77,69 @@ task::TaskResult CopyMemoryTask::execute() {
         }
         
         try {
-            // Create new memory region
-            MemoryRegion region{
-                config_.new_size(), 
-                config_.original_size(),
-                config_.address(), 
-                config_.description()
-            };
-            
-            // Copy original memory content
             const auto* source = reinterpret_cast<const std::uint8_t*>(config_.address());
             if (!source) {
                 PLUGIN_LOG_ERROR("Invalid source address 0x{:X} for CopyMemoryTask '{}'", config_.address(), config_.key());
                 return std::unexpected(task::TaskError::invalid_address);
             }
             
+            // A growable region gets its own reservation with only newSize committed;
+            // later loads commit more pages without moving the base the patches use.
+            // Snapshot regions get one too, write-watched, even at a fixed size
+            auto& arena = RegionArena::instance();
+            MemoryRegion region;
+            const std::size_t capacity = config_.is_growable() ? config_.reserve_size() : config_.new_size();
+            if (config_.is_growable() || config_.snapshots()) {
+                if (auto* base = arena.reserve(config_.key(), capacity, config_.new_size(), config_.snapshots())) {
+                    region = MemoryRegion::make_reserved_region(base, config_.new_size(), capacity,
+                                                                config_.original_size(), config_.address(),
+                                                                config_.description());
+                } else {
+                    PLUGIN_LOG_WARN("Cannot reserve {} bytes for '{}', allocating its {} bytes up front",
+                                    capacity, config_.key(), config_.new_size());
+                }
+            }
+            
+            // Otherwise carve the new memory region from the arena, next to the regions copied before it
+            if (region.base()) {
+                PLUGIN_LOG_DEBUG("Reserved {} bytes for '{}', {} committed{}", capacity, config_.key(),
+                                 config_.new_size(), config_.snapshots() ? ", write-watched" : "");
+            } else if (auto* block = arena.allocate(config_.key(), config_.new_size(), config_.alignment())) {
+                region = MemoryRegion::make_arena_region(
+                    block, config_.new_size(), config_.original_size(), config_.address(), config_.description());
+            } else {
+                PLUGIN_LOG_WARN("Region arena exhausted, allocating '{}' on the heap", config_.key());
+                region = MemoryRegion{
+                    config_.new_size(), 
+                    config_.original_size(),
+                    config_.address(), 
+                    config_.description()
+                };
+            }
+            
             PLUGIN_LOG_DEBUG("Copying {} bytes from 0x{:X}", config_.original_size(), config_.address());
             
-            // Perform the memory copy
-            std::copy_n(source, config_.original_size(), region.data.get());
+            auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+            
+            // Perform the memory copy, moving pointers into the old tables in the same pass
+            if (config_.rebases()) {
+                const auto ranges = moved_ranges(context, region.base());
+                const auto moved = util::copy_rebased({source, config_.original_size()}, region.base(), ranges);
+                PLUGIN_LOG_DEBUG("Rebased {} pointer(s) into {} moved range(s) while copying '{}'",
+                                 moved, ranges.size(), config_.key());
+            } else {
+                std::copy_n(source, config_.original_size(), region.base());
+            }
             
             // Zero-initialize the expanded portion
             if (config_.new_size() > config_.original_size()) {
                 const auto expanded_size = config_.new_size() - config_.original_size();
                 PLUGIN_LOG_DEBUG("Zero-initializing {} expanded bytes", expanded_size);
-                std::fill_n(region.data.get() + config_.original_size(), expanded_size, std::uint8_t{0});
+                std::fill_n(region.base() + config_.original_size(), expanded_size, std::uint8_t{0});
             }
             
             // Log content before storing the region
-            PLUGIN_LOG_DEBUG("Copied content: {}", region.to_string(0, 100));
+            PLUGIN_LOG_DEBUG("Copied content: {}", region.hex(0, 100));
             
             // Store in context using the configured key
             if (!config_.writes_to_context()) {
@@ -57,7 +147,7 @@ task::TaskResult CopyMemoryTask::execute() {
                 return std::unexpected(task::TaskError::invalid_config);
             }
             
-            const std::string context_key = config_.write_in_context().name;
+            const std::string& context_key = config_.write_in_context().name;
             if (context_key.empty()) {
                 PLUGIN_LOG_ERROR("CopyMemoryTask '{}' has empty context key name", config_.key());
                 return std::unexpected(task::TaskError::invalid_config);
@@ -70,12 +160,25 @@ task::TaskResult CopyMemoryTask::execute() {
                            config_.write_in_context().enabled, config_.write_in_context().name);
             
             PLUGIN_LOG_DEBUG("Storing memory region '{}' in context", context_key);
-            if (host_) {
-                host_->get_mod_context().store_data(context_key, std::move(region));
-            } else {
+            if (!host_) {
                 // Fallback to singleton for backward compatibility
                 PLUGIN_LOG_WARN("Using singleton ModContext for backward compatibility");
-                app_hook::context::ModContext::instance().store_data(context_key, std::move(region));
+            }
+            if (!region_key_) {
+                region_key_ = context.intern(context_key);
+            }
+            if (!context.store(region_key_, std::move(region))) {
+                PLUGIN_LOG_ERROR("Cannot store context key '{}' for CopyMemoryTask '{}'", context_key, config_.key());
+                return std::unexpected(task::TaskError::invalid_config);
+            }
+            
+            // Diagnostic: code that still touches the old bytes was missed by the patches
+            if (config_.sample_accesses()) {
+                if (AccessSampler::instance().watch(config_.key(), config_.address(), config_.original_size())) {
+                    PLUGIN_LOG_INFO("Sampling accesses to the old bytes of '{}' at 0x{:X}", config_.key(), config_.address());
+                } else {
+                    PLUGIN_LOG_WARN("Cannot sample accesses to the old bytes of '{}'", config_.key());
+                }
             }
             
             PLUGIN_LOG_INFO("Successfully executed CopyMemoryTask for key '{}'", config_.key());
@@ -90,4 +193,29 @@ task::TaskResult CopyMemoryTask::execute() {
         }
     }
     
+std::vector<util::MovedRange> CopyMemoryTask::moved_ranges(context::ModContext& context,
+                                                           const std::uint8_t* base) const {
+    // Addresses are 32-bit on the target, like the pointers in its tables
+    auto range = [](std::uintptr_t begin, std::size_t size, const std::uint8_t* target) {
+        return util::MovedRange{static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(size),
+                                static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(target))};
+    };
+    
+    std::vector<util::MovedRange> ranges;
+    if (config_.rebase_self()) {
+        ranges.push_back(range(config_.address(), config_.original_size(), base));
+    }
+    for (const auto& name : config_.rebase_from()) {
+        const auto* sibling = context.get_data<MemoryRegion>(name);
+        if (!sibling || !sibling->base()) {
+            // Tables pointing at each other: the one copied first cannot see the other yet
+            PLUGIN_LOG_WARN("Region '{}' is not copied yet, pointers of '{}' into it keep their old address",
+                            name, config_.key());
+            continue;
+        }
+        ranges.push_back(range(sibling->original_address, sibling->original_size, sibling->base()));
+    }
+    return ranges;
+}
+    
 } // namespace app_hook::memory
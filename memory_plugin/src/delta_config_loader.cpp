@@ -0,0 +1,206 @@
+#include "../include/config/delta_config_loader.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <toml++/toml.hpp>
+#include <charconv>
+#include <filesystem>
+
+namespace memory_plugin {
+
+std::vector<app_hook::config::ConfigType> DeltaConfigLoader::supported_types() const {
+    return {
+        app_hook::config::ConfigType::Delta
+    };
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
+DeltaConfigLoader::load_configs(
+    app_hook::config::ConfigType type, 
+    const std::string& file_path, 
+    const std::string& task_name) {
+    
+    if (type != app_hook::config::ConfigType::Delta) {
+        PLUGIN_LOG_ERROR("DeltaConfigLoader: Unsupported config type: {}", static_cast<int>(type));
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+    
+    PLUGIN_LOG_INFO("DeltaConfigLoader: Loading delta configs from file: {} for task: {}", file_path, task_name);
+    if (!std::filesystem::exists(file_path)) {
+        PLUGIN_LOG_ERROR("DeltaConfigLoader: Config file not found: {}", file_path);
+        return std::unexpected(app_hook::config::ConfigError::file_not_found);
+    }
+    
+    try {
+        auto config = toml::parse_file(file_path);
+        std::vector<app_hook::config::ConfigPtr> configs;
+        
+        // Table format only: [delta.item]
+        if (const auto* delta_table = config["delta"].as_table()) {
+            for (auto& [key, value] : *delta_table) {
+                const auto* table = value.as_table();
+                if (!table) {
+                    PLUGIN_LOG_WARN("DeltaConfigLoader: Invalid delta format for key: {}", std::string(key));
+                    continue;
+                }
+                if (auto delta = parse_delta(*table, task_name, std::string(key))) {
+                    configs.push_back(std::move(delta));
+                } else {
+                    PLUGIN_LOG_WARN("DeltaConfigLoader: Failed to parse delta: {}", std::string(key));
+                }
+            }
+        } else {
+            PLUGIN_LOG_DEBUG("DeltaConfigLoader: No delta section found in config file");
+        }
+        
+        PLUGIN_LOG_INFO("DeltaConfigLoader: Successfully loaded {} delta configurations", configs.size());
+        return configs;
+    } catch (const toml::parse_error& e) {
+        PLUGIN_LOG_ERROR("DeltaConfigLoader: TOML parse error in file {}: {}", file_path, e.what());
+        return std::unexpected(app_hook::config::ConfigError::parse_error);
+    } catch (const std::exception& e) {
+        PLUGIN_LOG_ERROR("DeltaConfigLoader: Exception while loading configs from {}: {}", file_path, e.what());
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+}
+
+std::string DeltaConfigLoader::get_name() const {
+    return "Delta Operations Loader";
+}
+
+std::string DeltaConfigLoader::get_version() const {
+    return "1.0.0";
+}
+
+std::uint32_t DeltaConfigLoader::cache_version() const {
+    return 1;
+}
+
+bool DeltaConfigLoader::serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                                          app_hook::util::ByteWriter& out) const {
+    out.write(static_cast<std::uint32_t>(configs.size()));
+    for (const auto& config : configs) {
+        const auto* delta_config = dynamic_cast<const app_hook::config::DeltaConfig*>(config.get());
+        if (!delta_config) {
+            return false;
+        }
+        app_hook::config::write_config_base(out, *delta_config);
+        out.write(static_cast<std::uint32_t>(delta_config->edits().size()));
+        for (const auto& edit : delta_config->edits()) {
+            out.write(edit);
+        }
+        out.write_bytes(delta_config->pool());
+    }
+    return true;
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
+DeltaConfigLoader::deserialize_configs(
+    app_hook::config::ConfigType type, 
+    app_hook::util::ByteReader& in, 
+    const std::string& task_name) {
+    
+    std::uint32_t count = 0;
+    if (type != app_hook::config::ConfigType::Delta || !in.read(count)) {
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+    
+    std::vector<app_hook::config::ConfigPtr> configs;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        std::string name;
+        if (!app_hook::config::read_config_identity(in, key, name)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        auto delta_config = std::make_shared<app_hook::config::DeltaConfig>(std::move(key), std::move(name));
+        
+        std::uint32_t edit_count = 0;
+        if (!app_hook::config::read_config_fields(in, *delta_config) || !in.read(edit_count) ||
+            edit_count > in.remaining()) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        std::vector<app_hook::config::DeltaEdit> edits(edit_count);
+        for (auto& edit : edits) {
+            in.read(edit);
+        }
+        std::vector<std::uint8_t> pool;
+        in.read_bytes(pool);
+        if (!in.ok() || !delta_config->set_edits(std::move(edits), std::move(pool))) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        configs.push_back(std::move(delta_config));
+    }
+    
+    PLUGIN_LOG_DEBUG("DeltaConfigLoader: Restored {} delta configs for task {} from cache", configs.size(), task_name);
+    return configs;
+}
+
+app_hook::config::ConfigPtr DeltaConfigLoader::parse_delta(const toml::table& table, const std::string& task_name,
+                                                           const std::string& config_name) {
+    auto config = app_hook::config::make_config<app_hook::config::DeltaConfig>(
+        task_name + "_" + config_name, config_name);
+    auto* delta_config = static_cast<app_hook::config::DeltaConfig*>(config.get());
+    
+    // Parse required field: readFromContext (the region the edits apply to)
+    auto read_from_context = table["readFromContext"].value<std::string>();
+    if (!read_from_context || read_from_context->empty()) {
+        PLUGIN_LOG_ERROR("DeltaConfigLoader: Missing or invalid readFromContext field in delta: {}", config_name);
+        return nullptr;
+    }
+    delta_config->set_read_from_context(std::move(*read_from_context));
+    
+    if (auto description = table["description"].value<std::string>()) {
+        delta_config->set_description(std::move(*description));
+    }
+    
+    // Parse required field: edits = [{ offset = "0x2A", bytes = "20 00" }, ...]
+    const auto* edits = table["edits"].as_array();
+    if (!edits || edits->empty()) {
+        PLUGIN_LOG_ERROR("DeltaConfigLoader: Missing or empty edits array in delta: {}", config_name);
+        return nullptr;
+    }
+    for (const auto& node : *edits) {
+        const auto* edit = node.as_table();
+        if (!edit) {
+            PLUGIN_LOG_ERROR("DeltaConfigLoader: Edit of delta '{}' is not a table", config_name);
+            return nullptr;
+        }
+        
+        std::optional<std::uint32_t> offset;
+        if (auto text = (*edit)["offset"].value<std::string>()) {
+            offset = static_cast<std::uint32_t>(app_hook::config::ConfigParsingUtils::parse_address(*text));
+        } else if (auto number = (*edit)["offset"].value<std::int64_t>(); number && *number >= 0) {
+            offset = static_cast<std::uint32_t>(*number);
+        }
+        const auto hex = (*edit)["bytes"].value<std::string>();
+        const auto bytes = hex ? parse_hex(*hex) : std::nullopt;
+        if (!offset || !bytes || !delta_config->add_edit(*offset, *bytes)) {
+            PLUGIN_LOG_ERROR("DeltaConfigLoader: Edit of delta '{}' needs an offset and non-empty hex bytes", config_name);
+            return nullptr;
+        }
+    }
+    
+    PLUGIN_LOG_DEBUG("DeltaConfigLoader: Parsed delta '{}': {} edit(s), {} byte(s) into '{}'", config_name,
+                     delta_config->edits().size(), delta_config->pool().size(), delta_config->read_from_context());
+    return config;
+}
+
+std::optional<std::vector<std::uint8_t>> DeltaConfigLoader::parse_hex(std::string_view hex) {
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(hex.size() / 3 + 1);
+    for (std::size_t i = 0; i < hex.size();) {
+        if (hex[i] == ' ' || hex[i] == '\t' || hex[i] == '\n' || hex[i] == '\r') {
+            ++i;
+            continue;
+        }
+        std::uint8_t value = 0;
+        const auto* begin = hex.data() + i;
+        const auto* end = hex.data() + std::min(i + 2, hex.size());
+        if (end - begin != 2 || std::from_chars(begin, end, value, 16).ptr != end) {
+            return std::nullopt;
+        }
+        bytes.push_back(value);
+        i += 2;
+    }
+    return bytes;
+}
+
+} // namespace memory_plugin
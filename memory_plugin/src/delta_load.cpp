@@ -0,0 +1,113 @@
+#include "../include/memory/delta_load.hpp"
+#include "../include/memory/memory_region.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include "../../core_hook/include/context/mod_context.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <cstring>
+
+namespace app_hook::memory {
+
+task::TaskResult DeltaLoadTask::execute() {
+    std::lock_guard lock(mutex_);
+    return apply();
+}
+
+task::ReloadOutcome DeltaLoadTask::reload(const config::ConfigBase& updated) {
+    if (updated.type_id() != DeltaConfig::kTypeId) {
+        return task::ReloadOutcome::restart_required;
+    }
+    const auto& delta_config = static_cast<const DeltaConfig&>(updated);
+    
+    std::lock_guard lock(mutex_);
+    if (delta_config.read_from_context() != config_.read_from_context()) {
+        return task::ReloadOutcome::restart_required;
+    }
+    
+    const bool edits_changed = delta_config.edits() != config_.edits() || delta_config.pool() != config_.pool();
+    if (!edits_changed && delta_config.description() == config_.description()) {
+        return task::ReloadOutcome::unchanged;
+    }
+    
+    // The old edits come out before the new ones go in, so dropped edits leave no trace
+    const bool applied = applied_base_ != nullptr;
+    if (edits_changed && applied) {
+        restore();
+    }
+    config_ = delta_config;
+    if (!edits_changed || !applied) {
+        return task::ReloadOutcome::updated;
+    }
+    
+    if (auto result = apply(); !result) {
+        PLUGIN_LOG_ERROR("Failed to apply reloaded delta '{}'", config_.key());
+        return task::ReloadOutcome::restart_required;
+    }
+    PLUGIN_LOG_INFO("Reloaded delta '{}': {} edit(s)", config_.key(), config_.edits().size());
+    return task::ReloadOutcome::updated;
+}
+
+const MemoryRegion* DeltaLoadTask::region() {
+    auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+    if (!region_key_) {
+        region_key_ = context.intern(config_.read_from_context());
+    }
+    return context.get<MemoryRegion>(region_key_);
+}
+
+task::TaskResult DeltaLoadTask::apply() {
+    PLUGIN_LOG_DEBUG("Executing DeltaLoadTask for key '{}'", config_.key());
+    
+    if (!config_.is_valid()) {
+        PLUGIN_LOG_ERROR("Invalid configuration for DeltaLoadTask '{}'", config_.key());
+        return std::unexpected(task::TaskError::invalid_config);
+    }
+    
+    const auto* memory_region = region();
+    if (!memory_region) {
+        PLUGIN_LOG_ERROR("Memory region '{}' not found in context for DeltaLoadTask '{}'", 
+                       config_.read_from_context(), config_.key());
+        return std::unexpected(task::TaskError::invalid_address);
+    }
+    
+    // Every edit must fit before any is written
+    const auto extent = config_.extent();
+    if (extent > memory_region->size) {
+        PLUGIN_LOG_ERROR("Delta '{}' writes up to offset {} but region '{}' has {} bytes", 
+                       config_.key(), extent, config_.read_from_context(), memory_region->size);
+        return std::unexpected(task::TaskError::invalid_address);
+    }
+    
+    // A new region (first run, or copied again) has fresh bytes under the edits;
+    // running again on the same region keeps the bytes saved the first time
+    auto* base = memory_region->base();
+    if (base != applied_base_) {
+        originals_.resize(config_.pool().size());
+        for (const auto& edit : config_.edits()) {
+            std::memcpy(originals_.data() + edit.pool_offset, base + edit.offset, edit.length);
+        }
+    }
+    
+    for (const auto& edit : config_.edits()) {
+        const auto bytes = config_.bytes(edit);
+        std::memcpy(base + edit.offset, bytes.data(), bytes.size());
+    }
+    applied_base_ = base;
+    
+    PLUGIN_LOG_INFO("Applied delta '{}': {} edit(s), {} byte(s) into '{}'", 
+                   config_.key(), config_.edits().size(), config_.pool().size(), config_.read_from_context());
+    return {};
+}
+
+void DeltaLoadTask::restore() {
+    // The region may have been copied again or dropped since; its bytes are then not ours
+    const auto* memory_region = region();
+    if (memory_region && memory_region->base() == applied_base_ && config_.extent() <= memory_region->size) {
+        for (const auto& edit : config_.edits()) {
+            std::memcpy(applied_base_ + edit.offset, originals_.data() + edit.pool_offset, edit.length);
+        }
+    }
+    applied_base_ = nullptr;
+    originals_.clear();
+}
+
+} // namespace app_hook::memory
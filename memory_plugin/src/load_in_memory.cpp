@@ -1,16 +1,85 @@
 #include "../include/memory/load_in_memory.hpp"
 #include "../include/memory/memory_region.hpp"
+#include "../include/memory/binary_preloader.hpp"
+#include "../include/memory/blob_store.hpp"
+#include "../include/memory/mapped_file.hpp"
+#include "../include/memory/payload_codec.hpp"
+#include "../include/memory/region_arena.hpp"
 #include "../../core_hook/include/task/hook_task.hpp"
 #include "../../core_hook/include/context/mod_context.hpp"
 #include "plugin/plugin_interface.hpp"
+#include "util/crc32c.hpp"
+#include "util/hex_dump.hpp"
 #include <filesystem>
-#include <fstream>
-#include <cstdio>
 #include <cstring>
+#include <memory>
+#include <optional>
 
 namespace app_hook::memory {
 
 task::TaskResult LoadInMemoryTask::execute() {
+    std::lock_guard lock(mutex_);
+    auto result = load_binary();
+    if (result) {
+        loaded_ = true;
+    }
+    return result;
+}
+
+task::ReloadOutcome LoadInMemoryTask::reload(const config::ConfigBase& updated) {
+    if (updated.type_id() != LoadInMemoryConfig::kTypeId) {
+        return task::ReloadOutcome::restart_required;
+    }
+    const auto& load_config = static_cast<const LoadInMemoryConfig&>(updated);
+    
+    std::lock_guard lock(mutex_);
+    if (load_config.read_from_context() != config_.read_from_context() ||
+        load_config.write_in_context().name != config_.write_in_context().name) {
+        return task::ReloadOutcome::restart_required;
+    }
+    
+    // Preload, read mode and verification only change how the next load runs
+    const bool binary_changed = load_config.binary_path() != config_.binary_path() ||
+        load_config.offset_security() != config_.offset_security() ||
+        load_config.compression() != config_.compression() ||
+        load_config.write_in_context().enabled != config_.write_in_context().enabled;
+    if (!binary_changed && load_config.preload() == config_.preload() && 
+        load_config.read_mode() == config_.read_mode() && load_config.verify() == config_.verify() &&
+        load_config.checksum() == config_.checksum() && load_config.description() == config_.description()) {
+        return task::ReloadOutcome::unchanged;
+    }
+    
+    config_ = load_config;
+    return binary_changed ? reload_binary() : task::ReloadOutcome::updated;
+}
+
+std::vector<std::string> LoadInMemoryTask::watched_files() const {
+    std::lock_guard lock(mutex_);
+    return {config_.binary_path()};
+}
+
+task::ReloadOutcome LoadInMemoryTask::refresh_file(const std::string& path) {
+    std::lock_guard lock(mutex_);
+    // The bytes staged at install time are stale; read the file itself
+    BinaryPreloader::instance().invalidate(config_.binary_path());
+    BlobStore::instance().invalidate(config_.binary_path());
+    PLUGIN_LOG_INFO("Binary '{}' of task '{}' changed", path, config_.key());
+    return reload_binary();
+}
+
+task::ReloadOutcome LoadInMemoryTask::reload_binary() {
+    if (!loaded_) {
+        return task::ReloadOutcome::updated;
+    }
+    if (auto result = load_binary(); !result) {
+        PLUGIN_LOG_ERROR("Failed to load reloaded binary '{}' for task '{}'", config_.binary_path(), config_.key());
+        return task::ReloadOutcome::restart_required;
+    }
+    // Tasks reading the published view must pick up its new size
+    return config_.writes_to_context() ? task::ReloadOutcome::dependents_stale : task::ReloadOutcome::updated;
+}
+
+task::TaskResult LoadInMemoryTask::load_binary() {
     PLUGIN_LOG_DEBUG("Executing LoadInMemoryTask for key '{}'", config_.key());
     PLUGIN_LOG_DEBUG("Loading binary from file: {}", config_.binary_path());
     PLUGIN_LOG_DEBUG("Offset security: 0x{:X}", config_.offset_security());
@@ -21,45 +90,112 @@ task::TaskResult LoadInMemoryTask::execute() {
     }
     
     try {
-        // Check if binary file exists
-        if (!std::filesystem::exists(config_.binary_path())) {
-            PLUGIN_LOG_ERROR("Binary file not found: {}", config_.binary_path());
-            return std::unexpected(task::TaskError::file_not_found);
-        }
+        // Binaries packed into the mod bundle are copied from its view
+        const auto packed = host_ ? host_->bundle_blob(config_.binary_path()) : std::span<const std::uint8_t>{};
+        
+        // Binaries preloaded at install time only need to be copied
+        const auto staged = config_.preload() && packed.empty() ? 
+            BinaryPreloader::instance().acquire(config_.binary_path()) : nullptr;
         
-        // Get file size
-        const auto file_size = std::filesystem::file_size(config_.binary_path());
-        PLUGIN_LOG_DEBUG("Binary file size: {} bytes", file_size);
+        // Mapped binaries are copied straight from the view
+        std::optional<MappedFile> mapped;
+        
+        // Streamed files are read whole before the copy so a failed read
+        // leaves the target untouched; the blob is shared with every other
+        // task loading the same file or the same bytes
+        std::shared_ptr<const BlobStore::Buffer> blob;
+        
+        std::uintmax_t file_size = 0;
+        const std::uint8_t* source = nullptr;
+        if (!packed.empty()) {
+            file_size = packed.size();
+            source = packed.data();
+            PLUGIN_LOG_DEBUG("Using binary from the mod bundle: {} bytes", file_size);
+        } else if (staged) {
+            file_size = staged->size();
+            source = staged->data();
+            PLUGIN_LOG_DEBUG("Using preloaded binary: {} bytes", file_size);
+        } else if (config_.read_mode() == config::BinaryReadMode::mapped) {
+            auto mapped_result = MappedFile::open(config_.binary_path());
+            if (!mapped_result) {
+                PLUGIN_LOG_ERROR("Failed to map binary file: {}", config_.binary_path());
+                return std::unexpected(mapped_result.error());
+            }
+            mapped.emplace(std::move(*mapped_result));
+            file_size = mapped->size();
+            source = mapped->data();
+            PLUGIN_LOG_DEBUG("Mapped binary file: {} bytes", file_size);
+        } else {
+            auto loaded = BlobStore::instance().load(config_.binary_path());
+            if (!loaded) {
+                PLUGIN_LOG_ERROR("Failed to read binary file: {}", config_.binary_path());
+                return std::unexpected(loaded.error());
+            }
+            blob = std::move(*loaded);
+            file_size = blob->size();
+            source = blob->data();
+            PLUGIN_LOG_DEBUG("Loaded {} bytes from binary file", file_size);
+        }
         
         if (file_size == 0) {
             PLUGIN_LOG_WARN("Binary file is empty: {}", config_.binary_path());
             return std::unexpected(task::TaskError::file_read_error);
         }
         
+        // Compressed payloads are decoded straight into the target, so the
+        // region check needs the size recorded in the stream
+        const std::span payload{source, static_cast<std::size_t>(file_size)};
+        const auto payload_size = decoded_size(config_.compression(), payload);
+        if (!payload_size) {
+            PLUGIN_LOG_ERROR("Cannot read the decoded size of compressed binary '{}'", config_.binary_path());
+            return std::unexpected(payload_size.error());
+        }
+        const std::size_t load_size = *payload_size;
+        
         // Determine base address for loading
         std::uintptr_t base_address = 0;
         std::uintptr_t injection_address = 0;
-        std::size_t total_size = static_cast<std::size_t>(file_size) + config_.offset_security();
         
         if (config_.reads_from_context()) {
             // Read base address from context
-            const std::string context_key = config_.read_from_context();
+            const std::string& context_key = config_.read_from_context();
             PLUGIN_LOG_DEBUG("Reading base address from context key: '{}'", context_key);
             
-            auto memory_region = host_ ? 
-                host_->get_mod_context().get_data<MemoryRegion>(context_key) :
-                app_hook::context::ModContext::instance().get_data<MemoryRegion>(context_key);
-                
+            auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+            if (!read_key_) {
+                read_key_ = context.intern(context_key);
+            }
+            auto memory_region = context.get<MemoryRegion>(read_key_);
+            
             if (!memory_region) {
                 PLUGIN_LOG_ERROR("Memory region '{}' not found in context for LoadInMemoryTask", context_key);
                 return std::unexpected(task::TaskError::invalid_address);
             }
             
             // Log detailed memory region information for Cheat Engine inspection
-            const std::uintptr_t region_base = reinterpret_cast<std::uintptr_t>(memory_region->data.get());
+            const std::uintptr_t region_base = reinterpret_cast<std::uintptr_t>(memory_region->base());
             injection_address = region_base + memory_region->original_size + config_.offset_security();
             base_address = injection_address;
             
+            // A reserved region commits the pages the binary needs; its base does not move
+            const std::size_t used = memory_region->original_size + config_.offset_security();
+            const std::size_t end = used + load_size;
+            if (end > memory_region->size && memory_region->can_grow_to(end)) {
+                if (RegionArena::instance().grow(memory_region->base(), end)) {
+                    PLUGIN_LOG_DEBUG("Grew region '{}' from {} to {} bytes", context_key, memory_region->size, end);
+                    memory_region->size = end;
+                } else {
+                    PLUGIN_LOG_ERROR("Cannot commit {} bytes of region '{}'", end, context_key);
+                }
+            }
+            
+            // The loaded bytes (and the view published for them) must stay inside the parent
+            if (used > memory_region->size || load_size > memory_region->size - used) {
+                PLUGIN_LOG_ERROR("Binary '{}' ({} bytes) does not fit in memory region '{}' ({} bytes, {} in use)",
+                               config_.binary_path(), load_size, context_key, memory_region->size, used);
+                return std::unexpected(task::TaskError::invalid_address);
+            }
+            
             PLUGIN_LOG_INFO("=== MEMORY INJECTION DETAILS ===");
             PLUGIN_LOG_INFO("Context Memory Region: '{}'", context_key);
             PLUGIN_LOG_INFO("  Original Address: 0x{:016X}", memory_region->original_address);
@@ -69,9 +205,12 @@ task::TaskResult LoadInMemoryTask::execute() {
             PLUGIN_LOG_INFO("Binary Injection Details:");
             PLUGIN_LOG_INFO("  File:             {}", config_.binary_path());
             PLUGIN_LOG_INFO("  File Size:        {} bytes (0x{:X})", file_size, file_size);
+            if (config_.compression() != config::BinaryCompression::none) {
+                PLUGIN_LOG_INFO("  Decoded Size:     {} bytes (0x{:X})", load_size, load_size);
+            }
             PLUGIN_LOG_INFO("  Offset Security:  {} bytes (0x{:X})", config_.offset_security(), config_.offset_security());
             PLUGIN_LOG_INFO("  Injection Address: 0x{:016X} [CHEAT ENGINE TARGET]", injection_address);
-            PLUGIN_LOG_INFO("  End Address:      0x{:016X}", injection_address + file_size);
+            PLUGIN_LOG_INFO("  End Address:      0x{:016X}", injection_address + load_size);
             PLUGIN_LOG_INFO("================================");
             
             PLUGIN_LOG_DEBUG("Using context-based address: 0x{:X} (region size: {}, offset: 0x{:X})", 
@@ -81,74 +220,66 @@ task::TaskResult LoadInMemoryTask::execute() {
             return std::unexpected(task::TaskError::invalid_config);
         }
         
-        // Create memory region for the loaded data
-        MemoryRegion region{
-            total_size,
-            static_cast<std::size_t>(file_size),
-            base_address,
-            config_.description().empty() ? 
-                ("Loaded binary data from " + config_.binary_path()) : 
-                config_.description()
-        };
-        
-        // Read binary file into memory
-        std::ifstream file(config_.binary_path(), std::ios::binary);
-        if (!file) {
-            PLUGIN_LOG_ERROR("Failed to open binary file: {}", config_.binary_path());
-            return std::unexpected(task::TaskError::file_not_found);
-        }
-        
-        file.read(reinterpret_cast<char*>(region.data.get()), static_cast<std::streamsize>(file_size));
-        if (!file) {
-            PLUGIN_LOG_ERROR("Failed to read binary file: {}", config_.binary_path());
-            return std::unexpected(task::TaskError::file_read_error);
-        }
-        
-        PLUGIN_LOG_DEBUG("Successfully loaded {} bytes from binary file", file_size);
-        
         // CRITICAL: Actually inject the data into the target memory address!
-        PLUGIN_LOG_INFO("Injecting {} bytes to target address 0x{:016X}", file_size, injection_address);
+        PLUGIN_LOG_INFO("Injecting {} bytes to target address 0x{:016X}", load_size, injection_address);
         
-        // Copy the loaded data to the injection address
-        std::memcpy(reinterpret_cast<void*>(injection_address), region.data.get(), static_cast<std::size_t>(file_size));
+        // Copy (or decode) the loaded data to the injection address
+        const std::span target{reinterpret_cast<std::uint8_t*>(injection_address), load_size};
+        if (auto decoded = decode_payload(config_.compression(), payload, target); !decoded) {
+            PLUGIN_LOG_ERROR("Failed to decode compressed binary '{}' at 0x{:016X}", config_.binary_path(), injection_address);
+            return decoded;
+        }
         
-        PLUGIN_LOG_INFO("Successfully injected {} bytes into memory at 0x{:016X}", file_size, injection_address);
+        PLUGIN_LOG_INFO("Successfully injected {} bytes into memory at 0x{:016X}", load_size, injection_address);
         
-        // Verify injection by reading back from the target address
-        if (file_size > 0) {
-            const auto preview_size = std::min(static_cast<std::size_t>(16), static_cast<std::size_t>(file_size));
-            std::string hex_preview;
-            
-            // Read from the actual injected memory location for verification
-            const std::uint8_t* injected_data = reinterpret_cast<const std::uint8_t*>(injection_address);
-            for (std::size_t i = 0; i < preview_size; ++i) {
-                char hex_byte[8];
-                std::snprintf(hex_byte, sizeof(hex_byte), "%02X ", injected_data[i]);
-                hex_preview += hex_byte;
+        // Check the whole injected range against the source (or the configured
+        // checksum) while the source is still at hand
+        if (config_.verify()) {
+            if (auto verified = verify_injection(payload, target); !verified) {
+                return verified;
             }
-            PLUGIN_LOG_INFO("INJECTION VERIFIED: First {} bytes at 0x{:016X}: {}", preview_size, injection_address, hex_preview);
-            
-            // Additional Cheat Engine inspection info
-            const std::size_t pattern_length = std::min(hex_preview.size(), static_cast<std::size_t>(23));
-            PLUGIN_LOG_INFO("CHEAT ENGINE: Search for pattern '{}' at address 0x{:016X}", 
-                          hex_preview.substr(0, pattern_length), injection_address);
         }
         
+        // The data now lives in the parent region; drop the source right away
+        mapped.reset();
+        blob.reset();
+        
+        // Preview of the first bytes for manual inspection (formatted only when debug logging is on)
+        const std::span injected_data{target.data(), std::min(static_cast<std::size_t>(16), load_size)};
+        PLUGIN_LOG_DEBUG("First {} bytes at 0x{:016X}: {}", injected_data.size(), injection_address,
+                         util::HexDump{injected_data});
+        PLUGIN_LOG_DEBUG("CHEAT ENGINE: Search for pattern '{}' at address 0x{:016X}", 
+                         util::HexDump{injected_data.first(std::min<std::size_t>(injected_data.size(), 8))}, injection_address);
+        
         // Store in context if configured
         if (config_.writes_to_context()) {
-            const std::string context_key = config_.write_in_context().name;
+            const std::string& context_key = config_.write_in_context().name;
             if (context_key.empty()) {
                 PLUGIN_LOG_ERROR("LoadInMemoryTask '{}' has empty context key name", config_.key());
                 return std::unexpected(task::TaskError::invalid_config);
             }
             
-            PLUGIN_LOG_DEBUG("Storing loaded data in context with key: '{}'", context_key);
-            if (host_) {
-                host_->get_mod_context().store_data(context_key, std::move(region));
-            } else {
+            // Publish a view of the injected bytes rather than a private copy
+            auto region = MemoryRegion::make_view(
+                reinterpret_cast<std::uint8_t*>(injection_address),
+                load_size,
+                config_.read_from_context(),
+                config_.description().empty() ? 
+                    ("Loaded binary data from " + config_.binary_path()) : 
+                    config_.description());
+            
+            PLUGIN_LOG_DEBUG("Storing view of loaded data in context with key: '{}'", context_key);
+            if (!host_) {
                 // Fallback to singleton for backward compatibility
                 PLUGIN_LOG_WARN("Using singleton ModContext for backward compatibility");
-                app_hook::context::ModContext::instance().store_data(context_key, std::move(region));
+            }
+            auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+            if (!write_key_) {
+                write_key_ = context.intern(context_key);
+            }
+            if (!context.store(write_key_, std::move(region))) {
+                PLUGIN_LOG_ERROR("Cannot store context key '{}' for LoadInMemoryTask '{}'", context_key, config_.key());
+                return std::unexpected(task::TaskError::invalid_config);
             }
         }
         
@@ -171,4 +302,28 @@ task::TaskResult LoadInMemoryTask::execute() {
     }
 }
 
-} // namespace app_hook::memory 
\ No newline at end of file
+task::TaskResult LoadInMemoryTask::verify_injection(std::span<const std::uint8_t> payload,
+                                                    std::span<const std::uint8_t> target) {
+    std::optional<std::uint32_t> expected = config_.checksum();
+    if (!expected && config_.compression() == config::BinaryCompression::none) {
+        expected = util::crc32c(payload);
+    }
+    const auto actual = util::crc32c(target);
+    
+    // A compressed source only has the codec's own frame checks to go by
+    if (!expected) {
+        PLUGIN_LOG_INFO("Injected binary '{}' has CRC32C 0x{:08X} (set checksum to enforce it)",
+                        config_.binary_path(), actual);
+        return {};
+    }
+    if (actual != *expected) {
+        PLUGIN_LOG_ERROR("Injected binary '{}' failed verification: CRC32C 0x{:08X}, expected 0x{:08X}",
+                         config_.binary_path(), actual, *expected);
+        return std::unexpected(task::TaskError::copy_failed);
+    }
+    PLUGIN_LOG_INFO("Verified {} injected bytes of '{}' (CRC32C 0x{:08X}{})", target.size(), config_.binary_path(),
+                    actual, util::crc32c_accelerated() ? ", SSE4.2" : "");
+    return {};
+}
+
+} // namespace app_hook::memory
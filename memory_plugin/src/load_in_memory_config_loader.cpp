@@ -1,4 +1,5 @@
 #include "../include/config/load_in_memory_config_loader.hpp"
+#include "../include/memory/binary_preloader.hpp"
 #include "plugin/plugin_interface.hpp"
 #include <toml++/toml.hpp>
 #include <filesystem>
@@ -36,6 +37,86 @@ std::string LoadInMemoryConfigLoader::get_version() const {
     return "1.0.0";
 }
 
+std::uint32_t LoadInMemoryConfigLoader::cache_version() const {
+    return 3;
+}
+
+bool LoadInMemoryConfigLoader::serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                                                 app_hook::util::ByteWriter& out) const {
+    out.write(static_cast<std::uint32_t>(configs.size()));
+    for (const auto& config : configs) {
+        const auto* load_config = dynamic_cast<const app_hook::config::LoadInMemoryConfig*>(config.get());
+        if (!load_config) {
+            return false;
+        }
+        app_hook::config::write_config_base(out, *load_config);
+        out.write_string(load_config->binary_path());
+        out.write(static_cast<std::uint64_t>(load_config->offset_security()));
+        out.write(load_config->preload());
+        out.write(load_config->read_mode());
+        out.write(load_config->compression());
+        out.write(load_config->verify());
+        out.write(load_config->checksum().has_value());
+        out.write(load_config->checksum().value_or(0));
+    }
+    return true;
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
+LoadInMemoryConfigLoader::deserialize_configs(
+    app_hook::config::ConfigType type, 
+    app_hook::util::ByteReader& in, 
+    const std::string& task_name) {
+    
+    std::uint32_t count = 0;
+    if (type != app_hook::config::ConfigType::Load || !in.read(count)) {
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+    
+    std::vector<app_hook::config::ConfigPtr> configs;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        std::string name;
+        if (!app_hook::config::read_config_identity(in, key, name)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        auto load_config = std::make_shared<app_hook::config::LoadInMemoryConfig>(std::move(key), std::move(name));
+        
+        std::string binary_path;
+        std::uint64_t offset_security = 0;
+        bool preload = true;
+        auto read_mode = app_hook::config::BinaryReadMode::stream;
+        auto compression = app_hook::config::BinaryCompression::none;
+        bool verify = false;
+        bool has_checksum = false;
+        std::uint32_t checksum = 0;
+        if (!app_hook::config::read_config_fields(in, *load_config) || !in.read_string(binary_path) ||
+            !in.read(offset_security) || !in.read(preload) || !in.read(read_mode) || !in.read(compression) ||
+            !in.read(verify) || !in.read(has_checksum) || !in.read(checksum)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        load_config->set_binary_path(std::move(binary_path));
+        load_config->set_offset_security(static_cast<std::uintptr_t>(offset_security));
+        load_config->set_preload(preload);
+        load_config->set_read_mode(read_mode);
+        load_config->set_compression(compression);
+        load_config->set_verify(verify);
+        load_config->set_checksum(has_checksum ? std::optional(checksum) : std::nullopt);
+        configs.push_back(std::move(load_config));
+    }
+    
+    // Staging is part of loading: queue the binaries just as a parse would
+    for (const auto& config : configs) {
+        const auto& load_config = static_cast<const app_hook::config::LoadInMemoryConfig&>(*config);
+        if (load_config.preload() && !packed(load_config.binary_path())) {
+            app_hook::memory::BinaryPreloader::instance().preload(load_config.binary_path());
+        }
+    }
+    
+    PLUGIN_LOG_DEBUG("LoadInMemoryConfigLoader: Restored {} load configs for task {} from cache", configs.size(), task_name);
+    return configs;
+}
+
 app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
 LoadInMemoryConfigLoader::load_load_in_memory_configs(const std::string& file_path, const std::string& task_name) {
     PLUGIN_LOG_INFO("LoadInMemoryConfigLoader: Loading load in memory configs from file: {} for task: {}", file_path, task_name);
@@ -203,6 +284,63 @@ app_hook::config::ConfigPtr LoadInMemoryConfigLoader::parse_load_operation(const
                            read_from_context_node->as_string()->get());
         }
 
+        // Parse optional field: preload (default true)
+        auto preload_node = table.get("preload");
+        if (preload_node && preload_node->is_boolean()) {
+            load_config->set_preload(preload_node->as_boolean()->get());
+        }
+
+        // Parse optional field: readMode ("stream" or "mapped")
+        auto read_mode_node = table.get("readMode");
+        if (read_mode_node && read_mode_node->is_string()) {
+            const auto& read_mode = read_mode_node->as_string()->get();
+            if (read_mode == "mapped") {
+                load_config->set_read_mode(app_hook::config::BinaryReadMode::mapped);
+            } else if (read_mode != "stream") {
+                PLUGIN_LOG_WARN("LoadInMemoryConfigLoader: Unknown readMode '{}', using 'stream'", read_mode);
+            }
+        }
+
+        // Parse optional field: compression ("lz4" or "zstd")
+        auto compression_node = table.get("compression");
+        if (compression_node && compression_node->is_string()) {
+            const auto& compression = compression_node->as_string()->get();
+            if (compression == "lz4") {
+                load_config->set_compression(app_hook::config::BinaryCompression::lz4);
+            } else if (compression == "zstd") {
+                load_config->set_compression(app_hook::config::BinaryCompression::zstd);
+            } else if (compression != "none") {
+                PLUGIN_LOG_ERROR("LoadInMemoryConfigLoader: Unknown compression '{}'", compression);
+                return nullptr;
+            }
+        }
+
+        // Parse optional fields: verify (bool) and checksum (CRC32C of the loaded bytes)
+        auto verify_node = table.get("verify");
+        if (verify_node && verify_node->is_boolean()) {
+            load_config->set_verify(verify_node->as_boolean()->get());
+        }
+        auto checksum_node = table.get("checksum");
+        if (checksum_node && checksum_node->is_string()) {
+            load_config->set_checksum(static_cast<std::uint32_t>(parse_address(checksum_node->as_string()->get())));
+            load_config->set_verify(true);
+        } else if (checksum_node && checksum_node->is_integer()) {
+            load_config->set_checksum(static_cast<std::uint32_t>(checksum_node->as_integer()->get()));
+            load_config->set_verify(true);
+        }
+
+        // Mapped binaries are copied straight from the file; staging them would
+        // only add a second copy in memory
+        if (load_config->read_mode() == app_hook::config::BinaryReadMode::mapped) {
+            load_config->set_preload(false);
+        }
+
+        // Start reading the binary now so the hook only has to copy it
+        if (load_config->preload() && !packed(load_config->binary_path())) {
+            app_hook::memory::BinaryPreloader::instance().preload(load_config->binary_path());
+            PLUGIN_LOG_DEBUG("LoadInMemoryConfigLoader: Queued binary for preload: {}", load_config->binary_path());
+        }
+
         PLUGIN_LOG_DEBUG("LoadInMemoryConfigLoader: Successfully parsed load operation: {}", name);
         return config;
 
@@ -220,4 +358,8 @@ std::uintptr_t LoadInMemoryConfigLoader::parse_address(const std::string& value)
     return static_cast<std::uintptr_t>(std::stoull(value));
 }
 
+bool LoadInMemoryConfigLoader::packed(const std::string& binary_path) const {
+    return host_ && !host_->bundle_blob(binary_path).empty();
+}
+
 } // namespace memory_plugin 
\ No newline at end of file
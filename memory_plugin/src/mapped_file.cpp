@@ -0,0 +1,62 @@
+#include "../include/memory/mapped_file.hpp"
+#include <utility>
+
+namespace app_hook::memory {
+
+std::expected<MappedFile, task::TaskError> MappedFile::open(const std::string& path) {
+    MappedFile mapped;
+    mapped.file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (mapped.file_ == INVALID_HANDLE_VALUE) {
+        return std::unexpected(task::TaskError::file_not_found);
+    }
+
+    LARGE_INTEGER file_size{};
+    if (!GetFileSizeEx(mapped.file_, &file_size) || file_size.QuadPart == 0 ||
+        static_cast<unsigned long long>(file_size.QuadPart) > SIZE_MAX) {
+        // Empty files cannot be mapped; oversized ones don't fit the address space
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+    mapped.size_ = static_cast<std::size_t>(file_size.QuadPart);
+
+    mapped.mapping_ = CreateFileMappingA(mapped.file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapped.mapping_) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+
+    mapped.view_ = MapViewOfFile(mapped.mapping_, FILE_MAP_READ, 0, 0, 0);
+    if (!mapped.view_) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+
+    return mapped;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        file_ = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        view_ = std::exchange(other.view_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedFile::close() noexcept {
+    if (view_) {
+        UnmapViewOfFile(view_);
+        view_ = nullptr;
+    }
+    if (mapping_) {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+    if (file_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+    size_ = 0;
+}
+
+} // namespace app_hook::memory
@@ -1,6 +1,7 @@
 #include "../include/config/memory_config_loader.hpp"
 #include "plugin/plugin_interface.hpp"
 #include <toml++/toml.hpp>
+#include <bit>
 #include <filesystem>
 #include <fstream>
 
@@ -36,6 +37,90 @@ std::string MemoryConfigLoader::get_version() const {
     return "1.0.0";
 }
 
+std::uint32_t MemoryConfigLoader::cache_version() const {
+    return 5;
+}
+
+bool MemoryConfigLoader::serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                                           app_hook::util::ByteWriter& out) const {
+    out.write(static_cast<std::uint32_t>(configs.size()));
+    for (const auto& config : configs) {
+        const auto* memory_config = dynamic_cast<const app_hook::config::CopyMemoryConfig*>(config.get());
+        if (!memory_config) {
+            return false;
+        }
+        app_hook::config::write_config_base(out, *memory_config);
+        out.write(static_cast<std::uint64_t>(memory_config->address()));
+        out.write(static_cast<std::uint64_t>(memory_config->copy_after()));
+        out.write(static_cast<std::uint64_t>(memory_config->original_size()));
+        out.write(static_cast<std::uint64_t>(memory_config->new_size()));
+        out.write(static_cast<std::uint64_t>(memory_config->alignment()));
+        out.write(static_cast<std::uint64_t>(memory_config->reserve_size()));
+        out.write(memory_config->sample_accesses());
+        out.write(memory_config->snapshots());
+        out.write(memory_config->rebase_self());
+        out.write(static_cast<std::uint32_t>(memory_config->rebase_from().size()));
+        for (const auto& region : memory_config->rebase_from()) {
+            out.write_string(region);
+        }
+    }
+    return true;
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
+MemoryConfigLoader::deserialize_configs(
+    app_hook::config::ConfigType type, 
+    app_hook::util::ByteReader& in, 
+    const std::string& task_name) {
+    
+    std::uint32_t count = 0;
+    if (type != app_hook::config::ConfigType::Memory || !in.read(count)) {
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+    
+    std::vector<app_hook::config::ConfigPtr> configs;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        std::string name;
+        if (!app_hook::config::read_config_identity(in, key, name)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        auto memory_config = std::make_shared<app_hook::config::CopyMemoryConfig>(std::move(key), std::move(name));
+        
+        std::uint64_t address = 0, copy_after = 0, original_size = 0, new_size = 0, alignment = 0, reserve_size = 0;
+        bool sample_accesses = false;
+        bool snapshots = false;
+        bool rebase_self = false;
+        std::uint32_t rebase_count = 0;
+        if (!app_hook::config::read_config_fields(in, *memory_config) || !in.read(address) || !in.read(copy_after) ||
+            !in.read(original_size) || !in.read(new_size) || !in.read(alignment) || !in.read(reserve_size) ||
+            !in.read(sample_accesses) || !in.read(snapshots) || !in.read(rebase_self) || !in.read(rebase_count) ||
+            rebase_count > in.remaining()) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        std::vector<std::string> rebase_from(rebase_count);
+        for (auto& region : rebase_from) {
+            if (!in.read_string(region)) {
+                return std::unexpected(app_hook::config::ConfigError::invalid_format);
+            }
+        }
+        memory_config->set_address(static_cast<std::uintptr_t>(address));
+        memory_config->set_copy_after(static_cast<std::uintptr_t>(copy_after));
+        memory_config->set_original_size(static_cast<std::size_t>(original_size));
+        memory_config->set_new_size(static_cast<std::size_t>(new_size));
+        memory_config->set_alignment(static_cast<std::size_t>(alignment));
+        memory_config->set_reserve_size(static_cast<std::size_t>(reserve_size));
+        memory_config->set_sample_accesses(sample_accesses);
+        memory_config->set_snapshots(snapshots);
+        memory_config->set_rebase_self(rebase_self);
+        memory_config->set_rebase_from(std::move(rebase_from));
+        configs.push_back(std::move(memory_config));
+    }
+    
+    PLUGIN_LOG_DEBUG("MemoryConfigLoader: Restored {} memory configs for task {} from cache", configs.size(), task_name);
+    return configs;
+}
+
 app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
 MemoryConfigLoader::load_memory_configs(const std::string& file_path, const std::string& task_name) {
     PLUGIN_LOG_INFO("MemoryConfigLoader: Loading memory configs from file: {} for task: {}", file_path, task_name);
@@ -50,6 +135,35 @@ MemoryConfigLoader::load_memory_configs(const std::string& file_path, const std:
         auto config = toml::parse_file(file_path);
         std::vector<app_hook::config::ConfigPtr> configs;
 
+        // Resolve every signature of the file in one pass before parsing the operations;
+        // fields whose symbol is in this build's address map are not scanned for
+        SignatureBatch signatures;
+        if (auto memory_section = config.get("memory")) {
+            auto collect = [this, &signatures](const toml::node& op) {
+                if (const auto* table = op.as_table()) {
+                    for (const std::string field : {"address", "copyAfter"}) {
+                        if (auto symbol = table->get(field + "Symbol"); symbol && symbol->is_string() &&
+                            signatures.add_symbol(host_, symbol->as_string()->get())) {
+                            continue;
+                        }
+                        if (auto pattern = table->get(field + "Pattern"); pattern && pattern->is_string()) {
+                            signatures.add(pattern->as_string()->get());
+                        }
+                    }
+                }
+            };
+            if (const auto* memory_array = memory_section->as_array()) {
+                for (const auto& op : *memory_array) {
+                    collect(op);
+                }
+            } else if (const auto* memory_table = memory_section->as_table()) {
+                for (const auto& [key, value] : *memory_table) {
+                    collect(value);
+                }
+            }
+        }
+        signatures.resolve(host_);
+
         // Parse memory operations from TOML - support both array and table formats
         if (auto memory_section = config.get("memory")) {
             if (memory_section->is_array()) {
@@ -59,7 +173,7 @@ MemoryConfigLoader::load_memory_configs(const std::string& file_path, const std:
                 PLUGIN_LOG_INFO("MemoryConfigLoader: Processing {} memory operations from array", memory_array->size());
                 
                 for (auto&& op : *memory_array) {
-                    auto memory_config = parse_memory_operation(op, task_name);
+                    auto memory_config = parse_memory_operation(op, task_name, signatures);
                     if (memory_config) {
                         PLUGIN_LOG_DEBUG("MemoryConfigLoader: Successfully parsed memory operation");
                         configs.push_back(std::move(memory_config));
@@ -76,7 +190,7 @@ MemoryConfigLoader::load_memory_configs(const std::string& file_path, const std:
                 for (auto& [key, value] : memory_table) {
                     if (value.is_table()) {
                         PLUGIN_LOG_DEBUG("MemoryConfigLoader: Parsing memory operation with key: {}", std::string(key));
-                        auto memory_config = parse_memory_operation(value, task_name, std::string(key));
+                        auto memory_config = parse_memory_operation(value, task_name, signatures, std::string(key));
                         if (memory_config) {
                             PLUGIN_LOG_DEBUG("MemoryConfigLoader: Successfully parsed memory operation: {}", std::string(key));
                             configs.push_back(std::move(memory_config));
@@ -103,7 +217,9 @@ MemoryConfigLoader::load_memory_configs(const std::string& file_path, const std:
     }
 }
 
-app_hook::config::ConfigPtr MemoryConfigLoader::parse_memory_operation(const toml::node& op, const std::string& task_name, const std::string& config_name) {
+app_hook::config::ConfigPtr MemoryConfigLoader::parse_memory_operation(const toml::node& op, const std::string& task_name,
+                                                                       const SignatureBatch& signatures,
+                                                                       const std::string& config_name) {
     try {
         if (!op.is_table()) {
             PLUGIN_LOG_ERROR("MemoryConfigLoader: Memory operation is not a table");
@@ -128,12 +244,11 @@ app_hook::config::ConfigPtr MemoryConfigLoader::parse_memory_operation(const tom
         auto* memory_config = static_cast<app_hook::config::CopyMemoryConfig*>(config.get());
 
         // Parse required fields
-        auto address_node = table.get("address");
-        if (!address_node || !address_node->is_string()) {
-            PLUGIN_LOG_ERROR("MemoryConfigLoader: Missing or invalid address field");
+        const auto address = parse_address_field(table, "address", signatures);
+        if (!address) {
             return nullptr;
         }
-        memory_config->set_address(parse_address(address_node->as_string()->get()));
+        memory_config->set_address(*address);
 
         auto original_size_node = table.get("originalSize");
         if (!original_size_node || !original_size_node->is_integer()) {
@@ -149,14 +264,68 @@ app_hook::config::ConfigPtr MemoryConfigLoader::parse_memory_operation(const tom
         }
         memory_config->set_new_size(new_size_node->as_integer()->get());
 
-        auto copy_after_node = table.get("copyAfter");
-        if (!copy_after_node || !copy_after_node->is_string()) {
-            PLUGIN_LOG_ERROR("MemoryConfigLoader: Missing or invalid copyAfter field");
+        const auto copy_after = parse_address_field(table, "copyAfter", signatures);
+        if (!copy_after) {
             return nullptr;
         }
-        memory_config->set_copy_after(parse_address(copy_after_node->as_string()->get()));
+        memory_config->set_copy_after(*copy_after);
 
         // Parse optional fields
+        auto align_node = table.get("align");
+        if (align_node) {
+            const auto align = align_node->is_integer() ? align_node->as_integer()->get() : 0;
+            if (align > 0 && std::has_single_bit(static_cast<std::uint64_t>(align))) {
+                memory_config->set_alignment(static_cast<std::size_t>(align));
+            } else {
+                PLUGIN_LOG_WARN("MemoryConfigLoader: align must be a power of two for {}, using {}",
+                                name, app_hook::config::CopyMemoryConfig::kDefaultAlignment);
+            }
+        }
+
+        // reserveSize: address space the region may grow into; only newSize is committed up front
+        auto reserve_node = table.get("reserveSize");
+        if (reserve_node) {
+            const auto reserve = reserve_node->is_integer() ? reserve_node->as_integer()->get() : 0;
+            if (reserve < 0 || static_cast<std::uint64_t>(reserve) < memory_config->new_size()) {
+                PLUGIN_LOG_ERROR("MemoryConfigLoader: reserveSize of {} must be an integer of at least newSize", name);
+                return nullptr;
+            }
+            memory_config->set_reserve_size(static_cast<std::size_t>(reserve));
+        }
+
+        // sampleAccesses: diagnostic that reports code still reading the old bytes
+        if (auto sample = table["sampleAccesses"].value<bool>()) {
+            memory_config->set_sample_accesses(*sample);
+        }
+
+        // snapshots: track written pages so RegionSnapshots copies only what changed
+        if (auto snapshots = table["snapshots"].value<bool>()) {
+            memory_config->set_snapshots(*snapshots);
+        }
+
+        // rebasePointers / rebaseFrom: move pointers into this table or copied siblings while copying
+        if (auto rebase = table["rebasePointers"].value<bool>()) {
+            memory_config->set_rebase_self(*rebase);
+        }
+        if (auto rebase_from_node = table.get("rebaseFrom")) {
+            const auto* regions = rebase_from_node->as_array();
+            std::vector<std::string> rebase_from;
+            if (regions) {
+                for (const auto& region : *regions) {
+                    if (!region.is_string()) {
+                        regions = nullptr;
+                        break;
+                    }
+                    rebase_from.push_back(region.as_string()->get());
+                }
+            }
+            if (!regions) {
+                PLUGIN_LOG_ERROR("MemoryConfigLoader: rebaseFrom of {} must be an array of context names", name);
+                return nullptr;
+            }
+            memory_config->set_rebase_from(std::move(rebase_from));
+        }
+
         auto description_node = table.get("description");
         if (description_node && description_node->is_string()) {
             memory_config->set_description(description_node->as_string()->get());
@@ -215,6 +384,35 @@ app_hook::config::ConfigPtr MemoryConfigLoader::parse_memory_operation(const tom
     }
 }
 
+std::optional<std::uintptr_t> MemoryConfigLoader::parse_address_field(const toml::table& table, const std::string& field,
+                                                                     const SignatureBatch& signatures) {
+    // "<field>Symbol" takes the address from this build's address map
+    if (auto symbol_node = table.get(field + "Symbol"); symbol_node && symbol_node->is_string()) {
+        if (const auto address = signatures.symbol(symbol_node->as_string()->get())) {
+            return address;
+        }
+        PLUGIN_LOG_DEBUG("MemoryConfigLoader: {}Symbol '{}' is not in this build's address map", field,
+                         symbol_node->as_string()->get());
+    }
+    
+    // "<field>Pattern" finds the address by signature instead of hard-coding it
+    if (auto pattern_node = table.get(field + "Pattern"); pattern_node && pattern_node->is_string()) {
+        const auto& pattern = pattern_node->as_string()->get();
+        if (const auto address = signatures.address(pattern)) {
+            return address;
+        }
+        PLUGIN_LOG_ERROR("MemoryConfigLoader: {}Pattern '{}' did not resolve", field, pattern);
+        return std::nullopt;
+    }
+    
+    auto address_node = table.get(field);
+    if (!address_node || !address_node->is_string()) {
+        PLUGIN_LOG_ERROR("MemoryConfigLoader: Missing or invalid {} field", field);
+        return std::nullopt;
+    }
+    return parse_address(address_node->as_string()->get());
+}
+
 std::uintptr_t MemoryConfigLoader::parse_address(const std::string& value) {
     // Note: Cannot use PLUGIN_LOG in static methods as they don't have access to host_
     if (value.starts_with("0x") || value.starts_with("0X")) {
@@ -1,10 +1,21 @@
 #include "plugin/plugin_interface.hpp"
+#include "../include/memory_plugin.hpp"
 #include "../include/config/memory_config_loader.hpp"
 #include "../include/config/patch_config_loader.hpp"
 #include "../include/config/load_in_memory_config_loader.hpp"
+#include "../include/config/delta_config_loader.hpp"
+#include "../include/config/text_config_loader.hpp"
 #include "../include/memory/copy_memory.hpp"
 #include "../include/memory/patch_memory.hpp"
 #include "../include/memory/load_in_memory.hpp"
+#include "../include/memory/delta_load.hpp"
+#include "../include/memory/text_load.hpp"
+#include "../include/memory/binary_preloader.hpp"
+#include "../include/memory/blob_store.hpp"
+#include "../include/memory/access_sampler.hpp"
+#include "../include/memory/patch_index.hpp"
+#include "../include/memory/region_arena.hpp"
+#include "../include/memory/memory_region.hpp"
 #include "task/task_factory.hpp"
 #include <filesystem>
 #include <string>
@@ -66,69 +77,50 @@ public:
         }
         PLUGIN_LOG_INFO("Memory Plugin: Load in memory config loader registered successfully");
         
-        // Task creators will capture host_ and set it directly on created tasks
-        
-        // Register task creators (back to original approach)
-        PLUGIN_LOG_INFO("Memory Plugin: Registering task creators...");
-        
-        // Register CopyMemoryTask creator
-        auto memory_creator_result = host_->register_task_creator(
-            "app_hook::config::CopyMemoryConfig",
-            [this](const app_hook::config::ConfigBase& base_config) -> std::unique_ptr<app_hook::task::IHookTask> {
-                if (const auto* memory_config = dynamic_cast<const app_hook::config::CopyMemoryConfig*>(&base_config)) {
-                    auto task = app_hook::task::make_task<app_hook::memory::CopyMemoryTask>(*memory_config);
-                    task->setHost(host_);
-                    return task;
-                }
-                return nullptr;
-            }
-        );
-        
-        if (memory_creator_result != app_hook::plugin::PluginResult::Success) {
-            PLUGIN_LOG_ERROR("Memory Plugin: Failed to register CopyMemoryTask creator");
-            return memory_creator_result;
+        // Register delta config loader
+        auto delta_loader = std::make_unique<DeltaConfigLoader>();
+        delta_loader->setHost(host_); // Set host for logging
+        auto delta_result = host_->register_config_loader(std::move(delta_loader));
+        if (delta_result != app_hook::plugin::PluginResult::Success) {
+            PLUGIN_LOG_ERROR("Memory Plugin: Failed to register delta config loader");
+            return delta_result;
         }
-        PLUGIN_LOG_INFO("Memory Plugin: CopyMemoryTask creator registered successfully");
-        
-        // Register PatchMemoryTask creator
-        auto patch_creator_result = host_->register_task_creator(
-            "app_hook::config::PatchConfig",
-            [this](const app_hook::config::ConfigBase& base_config) -> std::unique_ptr<app_hook::task::IHookTask> {
-                if (const auto* patch_config = dynamic_cast<const app_hook::config::PatchConfig*>(&base_config)) {
-                    // Extract instructions from the patch config
-                    const auto& instructions = patch_config->instructions();
-                    auto task = app_hook::task::make_task<app_hook::memory::PatchMemoryTask>(*patch_config, instructions);
-                    task->setHost(host_);
-                    return task;
-                }
-                return nullptr;
-            }
-        );
+        PLUGIN_LOG_INFO("Memory Plugin: Delta config loader registered successfully");
         
-        if (patch_creator_result != app_hook::plugin::PluginResult::Success) {
-            PLUGIN_LOG_ERROR("Memory Plugin: Failed to register PatchMemoryTask creator");
-            return patch_creator_result;
+        // Register text table config loader
+        auto text_loader = std::make_unique<TextConfigLoader>();
+        text_loader->setHost(host_); // Set host for logging
+        auto text_result = host_->register_config_loader(std::move(text_loader));
+        if (text_result != app_hook::plugin::PluginResult::Success) {
+            PLUGIN_LOG_ERROR("Memory Plugin: Failed to register text config loader");
+            return text_result;
         }
-        PLUGIN_LOG_INFO("Memory Plugin: PatchMemoryTask creator registered successfully");
+        PLUGIN_LOG_INFO("Memory Plugin: Text config loader registered successfully");
         
-        // Register LoadInMemoryTask creator
-        auto load_in_memory_creator_result = host_->register_task_creator(
-            "app_hook::config::LoadInMemoryConfig",
-            [this](const app_hook::config::ConfigBase& base_config) -> std::unique_ptr<app_hook::task::IHookTask> {
-                if (const auto* load_config = dynamic_cast<const app_hook::config::LoadInMemoryConfig*>(&base_config)) {
-                    auto task = app_hook::task::make_task<app_hook::memory::LoadInMemoryTask>(*load_config);
-                    task->setHost(host_);
-                    return task;
-                }
-                return nullptr;
-            }
-        );
-        
-        if (load_in_memory_creator_result != app_hook::plugin::PluginResult::Success) {
-            PLUGIN_LOG_ERROR("Memory Plugin: Failed to register LoadInMemoryTask creator");
-            return load_in_memory_creator_result;
+        PLUGIN_LOG_INFO("Memory Plugin: Registering task creators...");
+        if (auto result = register_creator<app_hook::config::CopyMemoryConfig, app_hook::memory::CopyMemoryTask>(
+                "CopyMemoryTask"); result != app_hook::plugin::PluginResult::Success) {
+            return result;
+        }
+        if (auto result = register_creator<app_hook::config::PatchConfig, app_hook::memory::PatchMemoryTask>(
+                "PatchMemoryTask"); result != app_hook::plugin::PluginResult::Success) {
+            return result;
+        }
+        if (auto result = register_creator<app_hook::config::LoadInMemoryConfig, app_hook::memory::LoadInMemoryTask>(
+                "LoadInMemoryTask"); result != app_hook::plugin::PluginResult::Success) {
+            return result;
+        }
+        if (auto result = register_creator<app_hook::config::DeltaConfig, app_hook::memory::DeltaLoadTask>(
+                "DeltaLoadTask"); result != app_hook::plugin::PluginResult::Success) {
+            return result;
+        }
+        if (auto result = register_creator<app_hook::config::TextConfig, app_hook::memory::TextLoadTask>(
+                "TextLoadTask"); result != app_hook::plugin::PluginResult::Success) {
+            return result;
         }
-        PLUGIN_LOG_INFO("Memory Plugin: LoadInMemoryTask creator registered successfully");
+        
+        host_->register_memory_source(kMemorySourceName, &MemoryPlugin::memory_usage);
+        app_hook::memory::AccessSampler::instance().set_report_path(kAccessReportPath);
         
         PLUGIN_LOG_INFO("Memory Plugin: Initialized successfully");
         return app_hook::plugin::PluginResult::Success;
@@ -151,16 +143,115 @@ public:
     void shutdown() override {
         if (host_) {
             PLUGIN_LOG_INFO("Memory Plugin: Shutting down...");
+            host_->unregister_memory_source(kMemorySourceName);
+            write_access_report();
+            if (const auto blobs = app_hook::memory::BlobStore::instance().stats(); blobs.bytes_shared != 0) {
+                PLUGIN_LOG_INFO("Memory Plugin: Shared binaries saved {} byte(s) ({} load(s) without a read, "
+                                "{} duplicate file(s))", blobs.bytes_shared, blobs.file_hits, blobs.content_hits);
+            }
+            app_hook::memory::BinaryPreloader::instance().clear();
+            app_hook::memory::PatchIndex::instance().clear();
+            release_regions();
             host_ = nullptr;
         }
     }
 
 private:
+    /// @brief Name of the plugin's source in the memory footprint report
+    static constexpr const char* kMemorySourceName = "memory_plugin";
+    
+    /// @brief Where sampled accesses to relocated regions are reported
+    static constexpr const char* kAccessReportPath = "logs/unpatched_accesses.toml";
+
+    /// @brief Register the creator of one task type
+    /// @param task_name Task name for the log
+    /// @return Result of the registration
+    template<typename ConfigT, app_hook::task::HookTask TaskT>
+    app_hook::plugin::PluginResult register_creator(const char* task_name) {
+#ifdef MEMORY_PLUGIN_STATIC
+        // Linked into the host: the factory calls a plain function, found by config type
+        app_hook::task::TaskFactory::instance().register_builtin_creator<ConfigT, TaskT>(host_);
+        const auto result = app_hook::plugin::PluginResult::Success;
+#else
+        // Creators are keyed by type ID and only called for configs declaring it,
+        // so the cast below is checked by the factory
+        const auto result = host_->register_task_creator(
+            std::string{ConfigT::kTypeId},
+            [this](const app_hook::config::ConfigBase& base_config) -> std::unique_ptr<app_hook::task::IHookTask> {
+                auto task = app_hook::task::make_task<TaskT>(static_cast<const ConfigT&>(base_config));
+                task->setHost(host_);
+                return task;
+            }
+        );
+#endif
+        if (result != app_hook::plugin::PluginResult::Success) {
+            PLUGIN_LOG_ERROR("Memory Plugin: Failed to register {} creator", task_name);
+        } else {
+            PLUGIN_LOG_INFO("Memory Plugin: {} creator registered successfully", task_name);
+        }
+        return result;
+    }
+
+    /// @brief Describe the region arena and the preloaded binaries
+    /// @note Owned and view regions are reported with the context entries that hold them
+    static std::vector<app_hook::util::MemoryUsage> memory_usage() {
+        const auto& arena = app_hook::memory::RegionArena::instance();
+        app_hook::util::MemoryUsage regions{"memory_plugin.region_arena"};
+        regions.count = arena.block_count();
+        regions.bytes = arena.used_bytes();
+        regions.committed_bytes = arena.committed_bytes();
+        regions.reserved_bytes = arena.reserved_bytes();
+
+        const auto& preloader = app_hook::memory::BinaryPreloader::instance();
+        app_hook::util::MemoryUsage preloaded{"memory_plugin.preloaded_binaries"};
+        preloaded.count = preloader.staged_count();
+        preloaded.bytes = preloader.staged_bytes();
+        return {std::move(regions), std::move(preloaded)};
+    }
+
+    /// @brief Stop sampling accesses to relocated regions and report the missed sites
+    void write_access_report() {
+        auto& sampler = app_hook::memory::AccessSampler::instance();
+        if (!sampler.active()) {
+            return;
+        }
+        sampler.stop();
+        const auto sites = sampler.sites();
+        if (sites.empty()) {
+            PLUGIN_LOG_INFO("Memory Plugin: No access to the old address of a sampled region was seen");
+        } else if (sampler.write_report(kAccessReportPath)) {
+            PLUGIN_LOG_WARN("Memory Plugin: {} instruction(s) still access relocated regions, see {}",
+                            sites.size(), kAccessReportPath);
+        } else {
+            PLUGIN_LOG_ERROR("Memory Plugin: Cannot write {}", kAccessReportPath);
+        }
+    }
+
+    /// @brief Drop the context regions that point into the arena, then release it
+    void release_regions() {
+        auto& context = host_->get_mod_context();
+        context.for_each_key({}, [&context](const std::string&, app_hook::context::ContextKey key) {
+            const auto* region = context.get<app_hook::memory::MemoryRegion>(key);
+            if (region && region->storage() != app_hook::memory::RegionStorage::owned) {
+                (void)context.remove(key);
+            }
+        });
+        app_hook::memory::RegionArena::instance().release();
+    }
+
     app_hook::plugin::IPluginHost* host_;
 };
 
 } // namespace memory_plugin
 
+#ifdef MEMORY_PLUGIN_STATIC
+
+std::unique_ptr<app_hook::plugin::IPlugin> memory_plugin::create_builtin_plugin() {
+    return std::make_unique<memory_plugin::MemoryPlugin>();
+}
+
+#else
+
 // Export plugin functions
 extern "C" {
     __declspec(dllexport) app_hook::plugin::IPlugin* CreatePlugin() {
@@ -170,4 +261,6 @@ extern "C" {
     __declspec(dllexport) void DestroyPlugin(app_hook::plugin::IPlugin* plugin) {
         delete plugin;
     }
-} 
\ No newline at end of file
+} 
+
+#endif
@@ -1,7 +1,13 @@
 #include "../include/config/patch_config_loader.hpp"
+#include "../include/memory/patch_index.hpp"
 #include "plugin/plugin_interface.hpp"
+#include "util/pe_image.hpp"
+#include "util/reference_scanner.hpp"
 #include <toml++/toml.hpp>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <format>
 
 namespace memory_plugin {
 
@@ -35,6 +41,104 @@ std::string PatchConfigLoader::get_version() const {
     return "1.0.0";
 }
 
+std::uint32_t PatchConfigLoader::cache_version() const {
+    return 4;
+}
+
+bool PatchConfigLoader::serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs, 
+                                          app_hook::util::ByteWriter& out) const {
+    out.write(static_cast<std::uint32_t>(configs.size()));
+    for (const auto& config : configs) {
+        const auto* patch_config = dynamic_cast<const app_hook::config::PatchConfig*>(config.get());
+        if (!patch_config) {
+            return false;
+        }
+        app_hook::config::write_config_base(out, *patch_config);
+        out.write_string(patch_config->patch_file_path());
+        out.write(patch_config->expected_original().has_value());
+        out.write(patch_config->expected_original().value_or(0));
+        out.write(patch_config->allows_overlap());
+        
+        // The compiled set is stored as is: restoring it is two copies
+        const auto& compiled = patch_config->compiled();
+        out.write(static_cast<std::uint32_t>(compiled.size()));
+        for (const auto& instruction : compiled.instructions()) {
+            out.write(static_cast<std::uint64_t>(instruction.address));
+            out.write(instruction.pool_offset);
+            out.write(instruction.length);
+            out.write(instruction.placeholder);
+            out.write(instruction.offset);
+        }
+        out.write_bytes(compiled.pool());
+    }
+    return true;
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
+PatchConfigLoader::deserialize_configs(
+    app_hook::config::ConfigType type, 
+    app_hook::util::ByteReader& in, 
+    const std::string& task_name) {
+    
+    std::uint32_t count = 0;
+    if (type != app_hook::config::ConfigType::Patch || !in.read(count)) {
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+    
+    std::vector<app_hook::config::ConfigPtr> configs;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        std::string name;
+        if (!app_hook::config::read_config_identity(in, key, name)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        auto patch_config = std::make_shared<app_hook::config::PatchConfig>(std::move(key), std::move(name));
+        
+        std::string patch_file_path;
+        bool has_expected_original = false;
+        std::uint32_t expected_original = 0;
+        bool allow_overlap = false;
+        std::uint32_t instruction_count = 0;
+        if (!app_hook::config::read_config_fields(in, *patch_config) || !in.read_string(patch_file_path) ||
+            !in.read(has_expected_original) || !in.read(expected_original) || !in.read(allow_overlap) ||
+            !in.read(instruction_count) || instruction_count > in.remaining()) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        patch_config->set_patch_file_path(std::move(patch_file_path));
+        if (has_expected_original) {
+            patch_config->set_expected_original(expected_original);
+        }
+        patch_config->set_allow_overlap(allow_overlap);
+        
+        std::vector<app_hook::config::CompiledInstruction> instructions(instruction_count);
+        for (auto& instruction : instructions) {
+            std::uint64_t address = 0;
+            in.read(address);
+            in.read(instruction.pool_offset);
+            in.read(instruction.length);
+            in.read(instruction.placeholder);
+            in.read(instruction.offset);
+            instruction.address = static_cast<std::uintptr_t>(address);
+        }
+        std::vector<std::uint8_t> pool;
+        in.read_bytes(pool);
+        
+        auto compiled = in.ok() ? 
+            app_hook::config::CompiledPatchSet::from_parts(std::move(instructions), std::move(pool)) : std::nullopt;
+        if (!compiled) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        patch_config->set_compiled(std::move(*compiled));
+        if (!claim_bytes(*patch_config)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        configs.push_back(std::move(patch_config));
+    }
+    
+    PLUGIN_LOG_DEBUG("PatchConfigLoader: Restored {} patch configs for task {} from cache", configs.size(), task_name);
+    return configs;
+}
+
 app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>> 
 PatchConfigLoader::load_patch_configs(const std::string& file_path, const std::string& task_name) {
     PLUGIN_LOG_INFO("PatchConfigLoader: Loading patch configs from file: {} for task: {}", file_path, task_name);
@@ -73,20 +177,56 @@ PatchConfigLoader::load_patch_configs(const std::string& file_path, const std::s
                                        read_from_context->as_string()->get());
                     }
                 }
+                
+                // CRC32C of the original code under the patches, to refuse other builds
+                if (auto expected_original = metadata_table.get("expectedOriginal")) {
+                    if (expected_original->is_string()) {
+                        patch_config_ptr->set_expected_original(
+                            static_cast<std::uint32_t>(std::stoul(expected_original->as_string()->get(), nullptr, 0)));
+                    } else if (expected_original->is_integer()) {
+                        patch_config_ptr->set_expected_original(
+                            static_cast<std::uint32_t>(expected_original->as_integer()->get()));
+                    }
+                }
+                
+                // Bytes also written by another set: "reject" (default) or "warn"
+                if (auto overlap = metadata_table.get_as<std::string>("overlap")) {
+                    if (overlap->get() != "reject" && overlap->get() != "warn") {
+                        PLUGIN_LOG_ERROR("PatchConfigLoader: Invalid overlap policy '{}' in {}", overlap->get(), file_path);
+                        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+                    }
+                    patch_config_ptr->set_allow_overlap(overlap->get() == "warn");
+                }
             }
         }
 
-        // Parse instruction sections
-        std::vector<app_hook::config::InstructionPatch> instructions;
+        // Parse instruction sections straight into the compiled set
+        app_hook::config::CompiledPatchSet compiled;
         if (auto instructions_node = config.get("instructions")) {
             if (instructions_node->is_table()) {
                 auto& instructions_table = *instructions_node->as_table();
                 PLUGIN_LOG_INFO("PatchConfigLoader: Processing {} instruction patches", instructions_table.size());
                 
+                // Resolve every instruction pattern of the file in one pass; instructions
+                // whose symbol is in this build's address map are not scanned for
+                SignatureBatch signatures;
                 for (auto& [key, value] : instructions_table) {
-                    auto instruction = parse_single_instruction(std::string(key), value);
-                    if (instruction) {
-                        instructions.push_back(std::move(*instruction));
+                    if (const auto* table = value.as_table()) {
+                        if (auto symbol = table->get("symbol"); symbol && symbol->is_string() &&
+                            signatures.add_symbol(host_, symbol->as_string()->get())) {
+                            continue;
+                        }
+                        if (auto pattern = table->get("pattern"); pattern && pattern->is_string()) {
+                            signatures.add(pattern->as_string()->get());
+                        }
+                    }
+                }
+                signatures.resolve(host_);
+                
+                // Most instructions are 5-7 bytes
+                compiled.reserve(instructions_table.size(), instructions_table.size() * 8);
+                for (auto& [key, value] : instructions_table) {
+                    if (parse_single_instruction(std::string(key), value, signatures, compiled)) {
                         PLUGIN_LOG_DEBUG("PatchConfigLoader: Successfully parsed instruction: {}", std::string(key));
                     } else {
                         PLUGIN_LOG_WARN("PatchConfigLoader: Failed to parse instruction: {}", std::string(key));
@@ -95,7 +235,20 @@ PatchConfigLoader::load_patch_configs(const std::string& file_path, const std::s
             }
         }
 
-        patch_config_ptr->set_instructions(std::move(instructions));
+        // Generate the instructions that address a relocated table from the code itself
+        if (auto relocate_node = config.get("relocate")) {
+            if (!relocate_node->is_table() || !add_relocation_patches(*relocate_node->as_table(), compiled)) {
+                PLUGIN_LOG_ERROR("PatchConfigLoader: Invalid [relocate] section in {}", file_path);
+                return std::unexpected(app_hook::config::ConfigError::invalid_format);
+            }
+        }
+
+        // Sorted once here so the overlap check, the cache and the task share the order
+        compiled.sort_by_address();
+        patch_config_ptr->set_compiled(std::move(compiled));
+        if (!claim_bytes(*patch_config_ptr)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
         configs.push_back(std::move(patch_config));
 
         PLUGIN_LOG_INFO("PatchConfigLoader: Successfully loaded {} patch configurations", configs.size());
@@ -109,98 +262,197 @@ PatchConfigLoader::load_patch_configs(const std::string& file_path, const std::s
     }
 }
 
-std::optional<app_hook::config::InstructionPatch> 
-PatchConfigLoader::parse_single_instruction(const std::string& key_str, const toml::node& value) {
+bool PatchConfigLoader::parse_single_instruction(const std::string& key_str, const toml::node& value,
+                                                 const SignatureBatch& signatures,
+                                                 app_hook::config::CompiledPatchSet& compiled) {
     PLUGIN_LOG_TRACE("PatchConfigLoader: Parsing instruction with key: {}", key_str);
     
     if (!value.is_table()) {
         PLUGIN_LOG_ERROR("PatchConfigLoader: Instruction value is not a table for key: {}", key_str);
-        return std::nullopt;
-    }
-    
-    app_hook::config::InstructionPatch patch;
-    
-    // Parse address from key (format: 0x1234ABCD)
-    try {
-        patch.address = parse_address(key_str);
-        PLUGIN_LOG_DEBUG("PatchConfigLoader: Parsed address: 0x{:X}", patch.address);
-    } catch (const std::exception& e) {
-        PLUGIN_LOG_ERROR("PatchConfigLoader: Failed to parse address from key '{}': {}", key_str, e.what());
-        return std::nullopt;
+        return false;
     }
-    
     auto table = value.as_table();
     
-    // Parse bytes field
-    if (auto bytes_node = table->get("bytes")) {
-        if (auto bytes_str = bytes_node->value<std::string>()) {
-            try {
-                patch.bytes = parse_bytes_string(*bytes_str);
-                PLUGIN_LOG_DEBUG("PatchConfigLoader: Parsed {} bytes from string: {}", patch.bytes.size(), *bytes_str);
-            } catch (const std::exception& e) {
-                PLUGIN_LOG_ERROR("PatchConfigLoader: Failed to parse bytes string '{}': {}", *bytes_str, e.what());
-                return std::nullopt;
-            }
-        } else {
-            PLUGIN_LOG_ERROR("PatchConfigLoader: Bytes field is not a string for instruction: {}", key_str);
-            return std::nullopt;
+    // With a symbol or a pattern the key is only a label; otherwise it is the address (format: 0x1234ABCD)
+    std::uintptr_t address = 0;
+    const auto symbol_node = table->get("symbol");
+    if (symbol_node && symbol_node->is_string()) {
+        address = signatures.symbol(symbol_node->as_string()->get());
+    }
+    if (address != 0) {
+        PLUGIN_LOG_DEBUG("PatchConfigLoader: Symbol of '{}' is at 0x{:X} in this build", key_str, address);
+    } else if (auto pattern_node = table->get("pattern"); pattern_node && pattern_node->is_string()) {
+        address = signatures.address(pattern_node->as_string()->get());
+        if (address == 0) {
+            PLUGIN_LOG_ERROR("PatchConfigLoader: Pattern of instruction '{}' did not resolve", key_str);
+            return false;
         }
+        PLUGIN_LOG_DEBUG("PatchConfigLoader: Pattern of '{}' resolved to 0x{:X}", key_str, address);
+    } else if (symbol_node) {
+        PLUGIN_LOG_ERROR("PatchConfigLoader: Symbol of instruction '{}' is not in this build's address map and "
+                         "no pattern is given", key_str);
+        return false;
     } else {
+        try {
+            address = parse_address(key_str);
+            PLUGIN_LOG_DEBUG("PatchConfigLoader: Parsed address: 0x{:X}", address);
+        } catch (const std::exception& e) {
+            PLUGIN_LOG_ERROR("PatchConfigLoader: Failed to parse address from key '{}': {}", key_str, e.what());
+            return false;
+        }
+    }
+    
+    // Parse bytes field
+    auto bytes_node = table->get("bytes");
+    if (!bytes_node) {
         PLUGIN_LOG_ERROR("PatchConfigLoader: Missing bytes field for instruction: {}", key_str);
-        return std::nullopt;
+        return false;
+    }
+    const auto* bytes_str = bytes_node->as_string();
+    if (!bytes_str) {
+        PLUGIN_LOG_ERROR("PatchConfigLoader: Bytes field is not a string for instruction: {}", key_str);
+        return false;
     }
     
     // Parse offset field
+    std::int32_t offset = 0;
     if (auto offset_node = table->get("offset")) {
         if (auto offset_str = offset_node->value<std::string>()) {
             try {
-                patch.offset = parse_offset(*offset_str);
-                PLUGIN_LOG_DEBUG("PatchConfigLoader: Parsed offset: {} from string: {}", patch.offset, *offset_str);
+                offset = parse_offset(*offset_str);
+                PLUGIN_LOG_DEBUG("PatchConfigLoader: Parsed offset: {} from string: {}", offset, *offset_str);
             } catch (const std::exception& e) {
                 PLUGIN_LOG_ERROR("PatchConfigLoader: Failed to parse offset string '{}': {}", *offset_str, e.what());
-                return std::nullopt;
+                return false;
             }
         } else {
             PLUGIN_LOG_ERROR("PatchConfigLoader: Offset field is not a string for instruction: {}", key_str);
-            return std::nullopt;
+            return false;
         }
     } else {
         PLUGIN_LOG_ERROR("PatchConfigLoader: Missing offset field for instruction: {}", key_str);
-        return std::nullopt;
+        return false;
     }
     
-    bool is_valid = patch.is_valid();
-    PLUGIN_LOG_DEBUG("PatchConfigLoader: Instruction validation result: {}", is_valid);
-    
-    return is_valid ? std::make_optional(patch) : std::nullopt;
+    if (!compiled.add_hex(address, bytes_str->get(), offset)) {
+        PLUGIN_LOG_ERROR("PatchConfigLoader: Invalid bytes '{}' for instruction {} (hex pairs with one XX XX XX XX placeholder expected)",
+                         bytes_str->get(), key_str);
+        return false;
+    }
+    return true;
 }
 
-std::vector<std::uint8_t> PatchConfigLoader::parse_bytes_string(const std::string& bytes_str) {
-    // Note: Cannot use PLUGIN_LOG in static methods as they don't have access to host_
+bool PatchConfigLoader::add_relocation_patches(const toml::table& table, app_hook::config::CompiledPatchSet& compiled) {
+    // The table's address comes from this build's address map when it names it
+    std::uintptr_t address = 0;
+    if (auto symbol = table["addressSymbol"].value<std::string>(); symbol && host_) {
+        address = host_->resolve_symbol(*symbol);
+    }
+    const auto address_node = table.get("address");
+    const auto size = table.get("originalSize") ? table.get("originalSize")->value<std::int64_t>() : std::nullopt;
+    if ((address == 0 && (!address_node || !address_node->is_string())) || !size || *size <= 0 || *size > UINT32_MAX) {
+        PLUGIN_LOG_ERROR("PatchConfigLoader: [relocate] needs an address string (or a mapped addressSymbol) and a positive originalSize");
+        return false;
+    }
+    if (address == 0) {
+        try {
+            address = parse_address(address_node->as_string()->get());
+        } catch (const std::exception& e) {
+            PLUGIN_LOG_ERROR("PatchConfigLoader: Invalid [relocate] address '{}': {}", address_node->as_string()->get(), e.what());
+            return false;
+        }
+    }
     
-    std::vector<std::uint8_t> bytes;
-    std::regex byte_regex(R"([0-9A-Fa-f]{2}|XX)");
+    // Dwords the scan must leave alone (false positives: constants that look like addresses)
+    std::vector<std::uintptr_t> excluded;
+    if (auto exclude_node = table.get("exclude")) {
+        const auto* exclude = exclude_node->as_array();
+        if (!exclude) {
+            PLUGIN_LOG_ERROR("PatchConfigLoader: [relocate] exclude must be an array of addresses");
+            return false;
+        }
+        for (const auto& entry : *exclude) {
+            const auto text = entry.value<std::string>();
+            if (!text) {
+                PLUGIN_LOG_ERROR("PatchConfigLoader: [relocate] exclude entries must be address strings");
+                return false;
+            }
+            try {
+                excluded.push_back(parse_address(*text));
+            } catch (const std::exception& e) {
+                PLUGIN_LOG_ERROR("PatchConfigLoader: Invalid [relocate] exclude address '{}': {}", *text, e.what());
+                return false;
+            }
+        }
+    }
     
-    auto matches = std::sregex_iterator(bytes_str.begin(), bytes_str.end(), byte_regex);
-    auto end_matches = std::sregex_iterator{};
+    const auto image = app_hook::util::main_module_image();
+    if (!image) {
+        PLUGIN_LOG_ERROR("PatchConfigLoader: Cannot read the executable's code section for [relocate]");
+        return false;
+    }
+    return add_relocation_patches(image->code(), image->code_begin, address,
+                                  static_cast<std::uint32_t>(*size), excluded, compiled) >= 0;
+}
+
+std::ptrdiff_t PatchConfigLoader::add_relocation_patches(std::span<const std::uint8_t> code, std::uintptr_t code_address,
+                                                         std::uintptr_t address, std::uint32_t size,
+                                                         std::span<const std::uintptr_t> excluded,
+                                                         app_hook::config::CompiledPatchSet& compiled) {
+    // Hand-written instructions win over the dwords found inside them
+    std::vector<std::pair<std::uintptr_t, std::uintptr_t>> written;
+    written.reserve(compiled.size());
+    for (const auto& instruction : compiled.instructions()) {
+        written.emplace_back(instruction.address, instruction.address + instruction.length);
+    }
+    std::ranges::sort(written);
+    auto covered = [&written](std::uintptr_t at) {
+        auto it = std::ranges::upper_bound(written, std::pair{at, UINTPTR_MAX});
+        return it != written.begin() && at < std::prev(it)->second;
+    };
     
-    int byte_count = 0;
-    for (auto it = matches; it != end_matches; ++it) {
-        const std::string byte_str = it->str();
-        if (byte_str == "XX") {
-            bytes.push_back(0xFF); // Placeholder
+    const auto references = app_hook::util::find_references(code, static_cast<std::uint32_t>(address), size);
+    std::ptrdiff_t added = 0;
+    std::size_t skipped = 0;
+    for (const auto position : references) {
+        const auto at = code_address + position;
+        if (covered(at) || covered(at + app_hook::config::CompiledPatchSet::kPlaceholderSize - 1) ||
+            std::ranges::find(excluded, at) != excluded.end()) {
+            ++skipped;
+            continue;
+        }
+        std::uint32_t target = 0;
+        std::memcpy(&target, code.data() + position, sizeof(target));
+        // The dword alone is the patch: its bytes are the placeholder
+        if (!compiled.add_hex(at, "XX XX XX XX", static_cast<std::int32_t>(target - address))) {
+            return -1;
+        }
+        ++added;
+    }
+    PLUGIN_LOG_INFO("PatchConfigLoader: [relocate] found {} reference(s) to 0x{:X}+0x{:X} in {} bytes of code ({} skipped)",
+                    added, address, size, code.size(), skipped);
+    return added;
+}
+
+bool PatchConfigLoader::claim_bytes(const app_hook::config::PatchConfig& config) {
+    const auto conflicts = app_hook::memory::PatchIndex::instance().claim(
+        config.key(), config.compiled().instructions(), config.allows_overlap());
+    for (const auto& conflict : conflicts) {
+        const auto message = std::format("PatchConfigLoader: Patches of '{}' and '{}' both write 0x{:X}-0x{:X}",
+                                         config.key(), conflict.owner, conflict.address,
+                                         conflict.address + conflict.length - 1);
+        if (config.allows_overlap()) {
+            PLUGIN_LOG_WARN("{}", message);
         } else {
-            auto byte_value = static_cast<std::uint8_t>(std::stoul(byte_str, nullptr, 16));
-            bytes.push_back(byte_value);
+            PLUGIN_LOG_ERROR("{}", message);
         }
-        byte_count++;
     }
-    
-    if (bytes.empty()) {
-        throw std::invalid_argument("No valid bytes found in string: " + bytes_str);
+    if (!conflicts.empty() && !config.allows_overlap()) {
+        PLUGIN_LOG_ERROR("PatchConfigLoader: Rejected the patches of '{}' ({} overlapping range(s)); "
+                         "set [metadata] overlap = \"warn\" to load them anyway", config.key(), conflicts.size());
+        return false;
     }
-    
-    return bytes;
+    return true;
 }
 
 std::uintptr_t PatchConfigLoader::parse_address(const std::string& value) {
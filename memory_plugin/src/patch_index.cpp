@@ -0,0 +1,87 @@
+#include "../include/memory/patch_index.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace app_hook::memory {
+
+PatchIndex& PatchIndex::instance() {
+    static PatchIndex index;
+    return index;
+}
+
+std::vector<PatchIndex::Conflict> PatchIndex::claim(const std::string& owner,
+                                                    std::span<const config::CompiledInstruction> instructions,
+                                                    bool keep_overlaps) {
+    // Touching instructions become one interval
+    const auto spans = config::CompiledPatchSet::coalesce(instructions, 0);
+
+    std::lock_guard lock(mutex_);
+    std::vector<Conflict> conflicts;
+    std::vector<bool> shared(spans.size(), false);
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        const auto before = conflicts.size();
+        find_conflicts(spans[i].address, spans[i].address + spans[i].length, owner, conflicts);
+        shared[i] = conflicts.size() != before;
+    }
+    if (!conflicts.empty() && !keep_overlaps) {
+        return conflicts;
+    }
+
+    release_locked(owner);
+    auto& claimed = owners_[owner];
+    claimed.reserve(spans.size());
+    for (std::size_t i = 0; i < spans.size(); ++i) {
+        if (!shared[i]) {
+            intervals_.emplace(spans[i].address, Interval{spans[i].address + spans[i].length, owner});
+            claimed.push_back(spans[i].address);
+        }
+    }
+    return conflicts;
+}
+
+void PatchIndex::release(const std::string& owner) {
+    std::lock_guard lock(mutex_);
+    release_locked(owner);
+}
+
+void PatchIndex::clear() {
+    std::lock_guard lock(mutex_);
+    intervals_.clear();
+    owners_.clear();
+}
+
+std::size_t PatchIndex::size() const {
+    std::lock_guard lock(mutex_);
+    return intervals_.size();
+}
+
+void PatchIndex::find_conflicts(std::uintptr_t begin, std::uintptr_t end, const std::string& owner,
+                                std::vector<Conflict>& conflicts) const {
+    // Intervals are disjoint: only the last one starting before begin can reach into it
+    auto it = intervals_.upper_bound(begin);
+    if (it != intervals_.begin() && std::prev(it)->second.end > begin) {
+        --it;
+    }
+    for (; it != intervals_.end() && it->first < end; ++it) {
+        if (it->second.owner == owner) {
+            continue;
+        }
+        const auto shared_begin = std::max(begin, it->first);
+        const auto shared_end = std::min(end, it->second.end);
+        conflicts.push_back(Conflict{shared_begin, static_cast<std::uint32_t>(shared_end - shared_begin),
+                                     it->second.owner});
+    }
+}
+
+void PatchIndex::release_locked(const std::string& owner) {
+    const auto it = owners_.find(owner);
+    if (it == owners_.end()) {
+        return;
+    }
+    for (const auto begin : it->second) {
+        intervals_.erase(begin);
+    }
+    owners_.erase(it);
+}
+
+} // namespace app_hook::memory
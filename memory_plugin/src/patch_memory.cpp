@@ -3,15 +3,18 @@
 #include "../../core_hook/include/task/hook_task.hpp"
 #include "../../core_hook/include/context/mod_context.hpp"
 #include "plugin/plugin_interface.hpp"
+#include "util/crc32c.hpp"
 #include <windows.h>
 
 namespace app_hook::memory {
 
 task::TaskResult PatchMemoryTask::execute() {
+    std::lock_guard lock(mutex_);
     PLUGIN_LOG_DEBUG("Executing PatchMemoryTask for key '{}'", config_.key());
     PLUGIN_LOG_INFO("Applying {} patch instruction(s) for task '{}'", patches_.size(), config_.key());
     
-    if (!config_.is_valid()) {
+    // A compacted config was valid when the task was built, its patches now live in patches_
+    if (!compacted_ && !config_.is_valid()) {
         PLUGIN_LOG_ERROR("Invalid configuration for PatchMemoryTask '{}'", config_.key());
         return std::unexpected(task::TaskError::invalid_config);
     }
@@ -22,47 +25,42 @@ task::TaskResult PatchMemoryTask::execute() {
     }
     
     try {
-        // Determine which key to use for reading from context
-        std::string context_key;
-        if (config_.reads_from_context()) {
-            context_key = config_.read_from_context();
-            PLUGIN_LOG_DEBUG("Using configured read context key: '{}'", context_key);
-        } else {
-            // Fall back to legacy key (same as task key) for backward compatibility
-            context_key = config_.key();
-            PLUGIN_LOG_DEBUG("Using legacy read context key: '{}'", context_key);
-        }
+        // Determine which key to use for reading from context; the legacy key
+        // (same as task key) is kept for backward compatibility
+        const std::string& context_key = this->context_key();
+        PLUGIN_LOG_DEBUG("Using {} read context key: '{}'", config_.reads_from_context() ? "configured" : "legacy", context_key);
         
-        // Get the new memory base address from context  
-        auto memory_region = host_ ? 
-            host_->get_mod_context().get_data<MemoryRegion>(context_key) :
-            app_hook::context::ModContext::instance().get_data<MemoryRegion>(context_key);
+        // Get the new memory base address from context (key interned on first run)
+        auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+        if (!region_key_) {
+            region_key_ = context.intern(context_key);
+        }
+        auto memory_region = context.get<MemoryRegion>(region_key_);
         if (!memory_region) {
             PLUGIN_LOG_ERROR("Memory region '{}' not found in context for PatchMemoryTask", context_key);
             return std::unexpected(task::TaskError::invalid_address);
         }
         
-        const auto new_base = reinterpret_cast<std::uintptr_t>(memory_region->data.get());
+        const auto new_base = reinterpret_cast<std::uintptr_t>(memory_region->base());
+        if (memory_region->is_view()) {
+            PLUGIN_LOG_DEBUG("Memory region '{}' is a view into '{}'", context_key, memory_region->parent_key);
+        }
         PLUGIN_LOG_DEBUG("Using new memory base address: 0x{:X}", new_base);
         
-        // Apply all patches
-        std::size_t successful_patches = 0;
-        for (const auto& patch : patches_) {
-            if (apply_instruction_patch(patch, new_base)) {
-                successful_patches++;
-            } else {
-                PLUGIN_LOG_WARN("Failed to apply patch at address 0x{:X}", patch.address);
-            }
+        // Refuse to patch code that is not the build the patches were written for
+        if (!applied_ && !original_matches()) {
+            return std::unexpected(task::TaskError::patch_failed);
         }
         
-        PLUGIN_LOG_INFO("Successfully applied {}/{} patches for task '{}'", 
-                successful_patches, patches_.size(), config_.key());
-        
-        if (successful_patches == 0) {
-            PLUGIN_LOG_ERROR("No patches were successfully applied for task '{}'", config_.key());
+        // Apply the patches (sorted by address) together, or none of them
+        if (!commit(patches_.instructions(), new_base)) {
+            PLUGIN_LOG_ERROR("No patches were applied for task '{}'", config_.key());
             return std::unexpected(task::TaskError::patch_failed);
         }
         
+        PLUGIN_LOG_INFO("Successfully applied {} patches for task '{}' in {} page group(s)", 
+                patches_.size(), config_.key(), page_groups_);
+        applied_ = true;
         return {};
         
     } catch (const std::exception& e) {
@@ -82,58 +80,116 @@ std::string PatchMemoryTask::description() const {
     return "Apply " + std::to_string(patches_.size()) + " memory patches for '" + config_.key() + "'";
 }
 
-bool PatchMemoryTask::apply_instruction_patch(const InstructionPatch& patch, std::uintptr_t new_base) {
-    PLUGIN_LOG_DEBUG("Applying patch at address 0x{:X} with offset {}", patch.address, patch.offset);
-    
-    // Calculate the new address
-    const auto new_address = new_base + patch.offset;
-    PLUGIN_LOG_INFO("New address: 0x{:X} + {} = 0x{:X}", new_base, patch.offset, new_address);
+task::ReloadOutcome PatchMemoryTask::reload(const config::ConfigBase& updated) {
+    if (updated.type_id() != PatchConfig::kTypeId) {
+        return task::ReloadOutcome::restart_required;
+    }
+    const auto& patch_config = static_cast<const PatchConfig&>(updated);
+    auto patches = patch_config.compiled();
+    patches.sort_by_address();
     
-    // Create patched bytes by replacing 'XX XX XX XX' with new address
-    auto patched_bytes = patch.bytes;
-    if (!replace_placeholders(patched_bytes, new_address)) {
-        PLUGIN_LOG_ERROR("Failed to replace placeholders in patch at 0x{:X}", patch.address);
-        return false;
+    std::lock_guard lock(mutex_);
+    const auto& new_context_key = patch_config.reads_from_context() ? 
+        patch_config.read_from_context() : patch_config.key();
+    const bool region_changed = new_context_key != context_key();
+    auto diff = CompiledPatchSet::diff(patches_, patches);
+    if (!region_changed && diff.changed.empty() && diff.removed.empty()) {
+        return task::ReloadOutcome::unchanged;
     }
     
-    // Apply the binary patch
-    auto* target = reinterpret_cast<std::uint8_t*>(patch.address);
-    if (!target) {
-        PLUGIN_LOG_ERROR("Invalid target address 0x{:X} for patch", patch.address);
-        return false;
+    // Dropped instructions get the code they replaced back, and so do shortened
+    // ones before their new bytes are written below
+    if (!diff.removed.empty()) {
+        const auto groups = transaction_.restore(diff.removed);
+        PLUGIN_LOG_INFO("Restored the original code of {} instruction(s) removed from task '{}' ({} page group(s))",
+                        diff.removed.size(), config_.key(), groups);
     }
     
-    // Make memory writable
-    DWORD old_protect;
-    if (!VirtualProtect(target, patched_bytes.size(), PAGE_EXECUTE_READWRITE, &old_protect)) {
-        PLUGIN_LOG_ERROR("Failed to make memory writable at 0x{:X}", patch.address);
-        return false;
+    config_ = patch_config;
+    patches_ = std::move(patches);
+    if (compacted_) {
+        config_.release_patches();
+    }
+    if (region_changed) {
+        region_key_ = {};
     }
     
-    // Copy the patched bytes
-    std::copy(patched_bytes.begin(), patched_bytes.end(), target);
+    // Not applied yet: the next run writes the new set
+    if (!applied_) {
+        return task::ReloadOutcome::updated;
+    }
     
-    // Restore original protection
-    VirtualProtect(target, patched_bytes.size(), old_protect, &old_protect);
+    auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+    if (!region_key_) {
+        region_key_ = context.intern(context_key());
+    }
+    auto memory_region = context.get<MemoryRegion>(region_key_);
+    if (!memory_region) {
+        PLUGIN_LOG_ERROR("Memory region '{}' not found in context for reloaded task '{}'", context_key(), config_.key());
+        return task::ReloadOutcome::restart_required;
+    }
     
-    PLUGIN_LOG_INFO("Successfully applied patch at 0x{:X}", patch.address);
+    // A new region moves every placeholder; otherwise only the changed instructions are written
+    const auto new_base = reinterpret_cast<std::uintptr_t>(memory_region->base());
+    const auto instructions = region_changed ? patches_.instructions() : std::span<const CompiledInstruction>(diff.changed);
+    if (!commit(instructions, new_base)) {
+        PLUGIN_LOG_ERROR("Reloaded task '{}' could not rewrite its instructions", config_.key());
+        return task::ReloadOutcome::restart_required;
+    }
+    PLUGIN_LOG_INFO("Reloaded task '{}': rewrote {} instruction(s) in {} page group(s)", 
+                    config_.key(), instructions.size(), page_groups_);
+    return task::ReloadOutcome::updated;
+}
+
+void PatchMemoryTask::compact() {
+    std::lock_guard lock(mutex_);
+    config_.release_patches();
+    patches_.shrink_to_fit();
+    compacted_ = true;
+}
+
+void PatchMemoryTask::rollback() {
+    std::lock_guard lock(mutex_);
+    if (transaction_.empty()) {
+        return;
+    }
+    const auto bytes = transaction_.saved_bytes();
+    const auto groups = transaction_.rollback();
+    applied_ = false;
+    PLUGIN_LOG_DEBUG("Rolled back task '{}': restored {} byte(s) in {} page group(s)", config_.key(), bytes, groups);
+}
+
+std::uint32_t PatchMemoryTask::original_checksum() const noexcept {
+    std::uint32_t crc = 0;
+    for (const auto& instruction : patches_.instructions()) {
+        crc = util::crc32c({reinterpret_cast<const std::uint8_t*>(instruction.address), instruction.length}, crc);
+    }
+    return crc;
+}
+
+bool PatchMemoryTask::original_matches() const {
+    const auto& expected = config_.expected_original();
+    if (!expected) {
+        return true;
+    }
+    const auto actual = original_checksum();
+    if (actual != *expected) {
+        PLUGIN_LOG_ERROR("Code under the patches of task '{}' has CRC32C 0x{:08X}, expected 0x{:08X}: "
+                         "wrong executable build, nothing was patched", config_.key(), actual, *expected);
+        return false;
+    }
+    PLUGIN_LOG_DEBUG("Code under the patches of task '{}' matches CRC32C 0x{:08X}", config_.key(), actual);
     return true;
 }
 
-bool PatchMemoryTask::replace_placeholders(std::vector<std::uint8_t>& bytes, std::uintptr_t address) {
-    // Look for 4 consecutive 0xFF bytes (our placeholder)
-    for (std::size_t i = 0; i <= bytes.size() - 4; ++i) {
-        if (bytes[i] == 0xFF && bytes[i+1] == 0xFF && bytes[i+2] == 0xFF && bytes[i+3] == 0xFF) {
-            // Replace with address in little-endian format
-            const auto addr_bytes = reinterpret_cast<const std::uint8_t*>(&address);
-            bytes[i] = addr_bytes[0];
-            bytes[i+1] = addr_bytes[1];
-            bytes[i+2] = addr_bytes[2];
-            bytes[i+3] = addr_bytes[3];
-            return true;
-        }
+bool PatchMemoryTask::commit(std::span<const CompiledInstruction> instructions, std::uintptr_t new_base) {
+    auto groups = transaction_.commit(patches_, instructions, new_base);
+    if (!groups) {
+        PLUGIN_LOG_ERROR("Failed to make the code of task '{}' writable; nothing was patched", config_.key());
+        return false;
     }
-    return false;
+    page_groups_ = *groups;
+    return true;
 }
 
 } // namespace app_hook::memory 
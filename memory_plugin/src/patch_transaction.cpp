@@ -0,0 +1,232 @@
+#include "../include/memory/patch_transaction.hpp"
+#include <windows.h>
+#include <algorithm>
+#include <cstring>
+
+namespace app_hook::memory {
+
+namespace {
+
+/// @brief Get the system page size
+std::uintptr_t page_size() noexcept {
+    static const std::uintptr_t size = [] {
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+        return static_cast<std::uintptr_t>(info.dwPageSize);
+    }();
+    return size;
+}
+
+constexpr std::uintptr_t page_floor(std::uintptr_t address, std::uintptr_t page) noexcept {
+    return address & ~(page - 1);
+}
+
+constexpr std::uintptr_t page_ceil(std::uintptr_t address, std::uintptr_t page) noexcept {
+    return (address + page - 1) & ~(page - 1);
+}
+
+/// @brief Ranges sharing a contiguous page range
+struct PageGroup {
+    std::size_t first;           ///< First range of the group
+    std::size_t last;            ///< One past the last range of the group
+    std::uintptr_t touched_begin;
+    std::uintptr_t touched_end;
+
+    [[nodiscard]] void* pages() const noexcept {
+        return reinterpret_cast<void*>(page_floor(touched_begin, page_size()));
+    }
+
+    [[nodiscard]] std::size_t pages_size() const noexcept {
+        return page_ceil(touched_end, page_size()) - page_floor(touched_begin, page_size());
+    }
+};
+
+/// @brief Split ranges sorted by address into page groups
+/// @param ranges Anything with address and length, sorted by address
+template <typename Range>
+std::vector<PageGroup> page_groups(std::span<const Range> ranges) {
+    const auto page = page_size();
+    std::vector<PageGroup> groups;
+    for (std::size_t begin = 0; begin < ranges.size();) {
+        PageGroup group{begin, begin + 1, ranges[begin].address, ranges[begin].address + ranges[begin].length};
+        while (group.last < ranges.size() && ranges[group.last].address < page_ceil(group.touched_end, page)) {
+            group.touched_end = std::max(group.touched_end, ranges[group.last].address + ranges[group.last].length);
+            ++group.last;
+        }
+        groups.push_back(group);
+        begin = group.last;
+    }
+    return groups;
+}
+
+/// @brief Restore a group's protection and drop stale decoded instructions
+void finish_group(const PageGroup& group, DWORD protect) {
+    DWORD ignored;
+    VirtualProtect(group.pages(), group.pages_size(), protect, &ignored);
+    FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<void*>(group.touched_begin),
+                          group.touched_end - group.touched_begin);
+}
+
+} // namespace
+
+std::expected<std::size_t, task::TaskError> PatchTransaction::commit(
+    const config::CompiledPatchSet& patches, std::span<const config::CompiledInstruction> instructions,
+    std::uintptr_t new_base) {
+    if (instructions.empty()) {
+        return 0;
+    }
+
+    // Every page must be writable before the first byte changes
+    const auto groups = page_groups(instructions);
+    std::vector<DWORD> old_protect(groups.size());
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (!VirtualProtect(groups[i].pages(), groups[i].pages_size(), PAGE_EXECUTE_READWRITE, &old_protect[i])) {
+            for (std::size_t j = 0; j < i; ++j) {
+                DWORD ignored;
+                VirtualProtect(groups[j].pages(), groups[j].pages_size(), old_protect[j], &ignored);
+            }
+            return std::unexpected(task::TaskError::patch_failed);
+        }
+    }
+
+    capture(instructions);
+
+    // Copy each instruction, then store the new address over its placeholder
+    const auto write = [&](std::uint8_t* target, const config::CompiledInstruction& instruction) {
+        const auto bytes = patches.bytes(instruction);
+        std::memcpy(target, bytes.data(), bytes.size());
+        const auto new_address = static_cast<std::uint32_t>(new_base + instruction.offset);
+        std::memcpy(target + instruction.placeholder, &new_address, sizeof(new_address));
+    };
+
+    std::vector<std::uint8_t> staging;
+    for (const auto& span : config::CompiledPatchSet::coalesce(instructions, kSpanGap)) {
+        auto* target = reinterpret_cast<std::uint8_t*>(span.address);
+        if (span.count == 1) {
+            write(target, instructions[span.first]);
+            continue;
+        }
+
+        // Neighbors are assembled over the current bytes and stored in one copy
+        staging.assign(target, target + span.length);
+        for (const auto& instruction : instructions.subspan(span.first, span.count)) {
+            write(staging.data() + (instruction.address - span.address), instruction);
+        }
+        std::memcpy(target, staging.data(), staging.size());
+    }
+
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        finish_group(groups[i], old_protect[i]);
+    }
+    return groups.size();
+}
+
+std::size_t PatchTransaction::rollback() {
+    const auto groups = write_back(saved_, undo_);
+    saved_ = {};
+    undo_ = {};
+    return groups;
+}
+
+std::size_t PatchTransaction::restore(std::span<const config::CompiledInstruction> instructions) {
+    // Saved ranges lie inside the instruction that first covered them
+    std::vector<bool> selected(saved_.size(), false);
+    for (const auto& instruction : instructions) {
+        const auto end = instruction.address + instruction.length;
+        auto it = std::ranges::upper_bound(saved_, instruction.address, {},
+                                           [](const SavedRange& range) { return range.address + range.length; });
+        for (; it != saved_.end() && it->address < end; ++it) {
+            selected[static_cast<std::size_t>(it - saved_.begin())] = true;
+        }
+    }
+
+    std::vector<SavedRange> restored;
+    std::vector<SavedRange> kept;
+    for (std::size_t i = 0; i < saved_.size(); ++i) {
+        (selected[i] ? restored : kept).push_back(saved_[i]);
+    }
+    if (restored.empty()) {
+        return 0;
+    }
+
+    const auto groups = write_back(restored, undo_);
+    // Restored bytes stay in the buffer until nothing references it
+    saved_ = std::move(kept);
+    if (saved_.empty()) {
+        undo_ = {};
+    }
+    return groups;
+}
+
+std::size_t PatchTransaction::saved_bytes() const noexcept {
+    std::size_t total = 0;
+    for (const auto& range : saved_) {
+        total += range.length;
+    }
+    return total;
+}
+
+void PatchTransaction::capture(std::span<const config::CompiledInstruction> instructions) {
+    std::size_t incoming = 0;
+    for (const auto& instruction : instructions) {
+        incoming += instruction.length;
+    }
+    undo_.reserve(undo_.size() + incoming);
+
+    // One pass: instructions and saved ranges are both sorted by address
+    std::vector<SavedRange> added;
+    std::uintptr_t pass_end = 0;
+    auto next = saved_.begin();
+    for (const auto& instruction : instructions) {
+        auto begin = std::max(instruction.address, pass_end);
+        const auto end = instruction.address + instruction.length;
+        pass_end = std::max(pass_end, end);
+
+        while (begin < end) {
+            while (next != saved_.end() && next->address + next->length <= begin) {
+                ++next;
+            }
+            if (next != saved_.end() && next->address <= begin) {
+                // Saved by an earlier commit: those are the original bytes
+                begin = next->address + next->length;
+                continue;
+            }
+
+            const auto piece_end = next != saved_.end() ? std::min(end, next->address) : end;
+            const auto* source = reinterpret_cast<const std::uint8_t*>(begin);
+            added.push_back(SavedRange{begin, static_cast<std::uint32_t>(undo_.size()),
+                                       static_cast<std::uint32_t>(piece_end - begin)});
+            undo_.insert(undo_.end(), source, source + (piece_end - begin));
+            begin = piece_end;
+        }
+    }
+
+    if (added.empty()) {
+        return;
+    }
+    const auto middle = saved_.size();
+    saved_.insert(saved_.end(), added.begin(), added.end());
+    std::inplace_merge(saved_.begin(), saved_.begin() + static_cast<std::ptrdiff_t>(middle), saved_.end(),
+                       [](const SavedRange& a, const SavedRange& b) { return a.address < b.address; });
+}
+
+std::size_t PatchTransaction::write_back(std::span<const SavedRange> ranges, const std::vector<std::uint8_t>& undo) {
+    const auto groups = page_groups(ranges);
+    std::size_t restored = 0;
+    for (const auto& group : groups) {
+        DWORD old_protect;
+        if (!VirtualProtect(group.pages(), group.pages_size(), PAGE_EXECUTE_READWRITE, &old_protect)) {
+            // The module is gone or the pages were locked: nothing left to restore
+            continue;
+        }
+        for (std::size_t i = group.first; i < group.last; ++i) {
+            std::memcpy(reinterpret_cast<void*>(ranges[i].address), undo.data() + ranges[i].undo_offset,
+                        ranges[i].length);
+        }
+        finish_group(group, old_protect);
+        ++restored;
+    }
+    return restored;
+}
+
+} // namespace app_hook::memory
@@ -0,0 +1,116 @@
+#include "../include/memory/payload_codec.hpp"
+#include <lz4frame.h>
+#include <zstd.h>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace app_hook::memory {
+
+namespace {
+
+/// @brief Decompression context freed on scope exit
+using Lz4Context = std::unique_ptr<LZ4F_dctx, decltype(&LZ4F_freeDecompressionContext)>;
+
+[[nodiscard]] Lz4Context make_lz4_context() {
+    LZ4F_dctx* context = nullptr;
+    if (LZ4F_isError(LZ4F_createDecompressionContext(&context, LZ4F_VERSION))) {
+        context = nullptr;
+    }
+    return {context, &LZ4F_freeDecompressionContext};
+}
+
+[[nodiscard]] std::expected<std::size_t, task::TaskError> lz4_decoded_size(std::span<const std::uint8_t> payload) {
+    auto context = make_lz4_context();
+    if (!context) {
+        return std::unexpected(task::TaskError::memory_allocation_failed);
+    }
+    
+    LZ4F_frameInfo_t info{};
+    std::size_t consumed = payload.size();
+    if (LZ4F_isError(LZ4F_getFrameInfo(context.get(), &info, payload.data(), &consumed)) ||
+        info.contentSize == 0 || info.contentSize > std::numeric_limits<std::size_t>::max()) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+    return static_cast<std::size_t>(info.contentSize);
+}
+
+[[nodiscard]] task::TaskResult lz4_decode(std::span<const std::uint8_t> payload, std::span<std::uint8_t> destination) {
+    auto context = make_lz4_context();
+    if (!context) {
+        return std::unexpected(task::TaskError::memory_allocation_failed);
+    }
+    
+    std::size_t read = 0;
+    std::size_t written = 0;
+    std::size_t hint = 1;
+    while (hint != 0 && read < payload.size()) {
+        std::size_t in_size = payload.size() - read;
+        std::size_t out_size = destination.size() - written;
+        hint = LZ4F_decompress(context.get(), destination.data() + written, &out_size,
+                               payload.data() + read, &in_size, nullptr);
+        if (LZ4F_isError(hint) || (in_size == 0 && out_size == 0)) {
+            return std::unexpected(task::TaskError::file_read_error);
+        }
+        read += in_size;
+        written += out_size;
+    }
+    
+    // A frame ends with hint 0; anything else is a truncated stream
+    if (hint != 0 || written != destination.size()) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+    return {};
+}
+
+[[nodiscard]] std::expected<std::size_t, task::TaskError> zstd_decoded_size(std::span<const std::uint8_t> payload) {
+    const auto size = ZSTD_findDecompressedSize(payload.data(), payload.size());
+    if (size == ZSTD_CONTENTSIZE_UNKNOWN || size == ZSTD_CONTENTSIZE_ERROR || size == 0 ||
+        size > std::numeric_limits<std::size_t>::max()) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+    return static_cast<std::size_t>(size);
+}
+
+[[nodiscard]] task::TaskResult zstd_decode(std::span<const std::uint8_t> payload, std::span<std::uint8_t> destination) {
+    const auto written = ZSTD_decompress(destination.data(), destination.size(), payload.data(), payload.size());
+    if (ZSTD_isError(written) || written != destination.size()) {
+        return std::unexpected(task::TaskError::file_read_error);
+    }
+    return {};
+}
+
+} // namespace
+
+std::expected<std::size_t, task::TaskError> decoded_size(
+    config::BinaryCompression compression, std::span<const std::uint8_t> payload) {
+    switch (compression) {
+        case config::BinaryCompression::lz4:
+            return lz4_decoded_size(payload);
+        case config::BinaryCompression::zstd:
+            return zstd_decoded_size(payload);
+        case config::BinaryCompression::none:
+            break;
+    }
+    return payload.size();
+}
+
+task::TaskResult decode_payload(
+    config::BinaryCompression compression, std::span<const std::uint8_t> payload,
+    std::span<std::uint8_t> destination) {
+    switch (compression) {
+        case config::BinaryCompression::lz4:
+            return lz4_decode(payload, destination);
+        case config::BinaryCompression::zstd:
+            return zstd_decode(payload, destination);
+        case config::BinaryCompression::none:
+            break;
+    }
+    if (destination.size() != payload.size()) {
+        return std::unexpected(task::TaskError::copy_failed);
+    }
+    std::memcpy(destination.data(), payload.data(), payload.size());
+    return {};
+}
+
+} // namespace app_hook::memory
@@ -0,0 +1,195 @@
+#include "../include/memory/region_arena.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace app_hook::memory {
+
+namespace {
+
+constexpr std::size_t align_up(std::size_t value, std::size_t alignment) noexcept {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+RegionArena& RegionArena::instance() {
+    static RegionArena arena;
+    return arena;
+}
+
+std::uint8_t* RegionArena::allocate(const std::string& key, std::size_t size, std::size_t alignment) {
+    if (size == 0) {
+        return nullptr;
+    }
+    if (!std::has_single_bit(alignment)) {
+        alignment = kDefaultAlignment;
+    }
+
+    std::lock_guard lock(mutex_);
+    if (auto it = blocks_.find(key); it != blocks_.end()) {
+        const auto& block = it->second;
+        if (block.size >= size && reinterpret_cast<std::uintptr_t>(block.base) % alignment == 0) {
+            return block.base;
+        }
+    }
+
+    auto* base = carve(size, alignment);
+    if (base) {
+        blocks_[key] = Block{base, size};
+    }
+    return base;
+}
+
+std::uint8_t* RegionArena::reserve(const std::string& key, std::size_t capacity, std::size_t size,
+                                   bool write_watch) {
+    if (capacity == 0 || size > capacity) {
+        return nullptr;
+    }
+    capacity = align_up(capacity, kPageSize);
+
+    std::lock_guard lock(mutex_);
+    if (auto it = reserved_.find(key); it != reserved_.end()) {
+        auto& reservation = reservations_[it->second];
+        if (reservation.reserved >= capacity && reservation.watched == write_watch) {
+            // Pages grown into by the last run are kept, but must read as fresh ones
+            if (reservation.committed > size) {
+                std::fill(reservation.base + size, reservation.base + reservation.committed, std::uint8_t{0});
+            }
+            return commit_to(reservation, size, kPageSize) ? reservation.base : nullptr;
+        }
+    }
+
+    // A smaller reservation stays mapped: the old region may still be read until it is replaced
+    void* base = VirtualAlloc(nullptr, capacity, MEM_RESERVE | (write_watch ? MEM_WRITE_WATCH : 0), PAGE_NOACCESS);
+    if (!base) {
+        return nullptr;
+    }
+    Chunk reservation{static_cast<std::uint8_t*>(base), capacity, 0, 0, write_watch};
+    if (!commit_to(reservation, size, kPageSize)) {
+        VirtualFree(base, 0, MEM_RELEASE);
+        return nullptr;
+    }
+    reserved_[key] = reservations_.size();
+    reservations_.push_back(reservation);
+    return reservation.base;
+}
+
+bool RegionArena::grow(const std::uint8_t* base, std::size_t size) {
+    std::lock_guard lock(mutex_);
+    auto it = std::find_if(reservations_.begin(), reservations_.end(),
+                           [base](const Chunk& reservation) { return reservation.base == base; });
+    if (it == reservations_.end() || size > it->reserved) {
+        return false;
+    }
+    return commit_to(*it, size, kPageSize);
+}
+
+std::vector<RegionArena::WatchedRange> RegionArena::watched_ranges() const {
+    std::lock_guard lock(mutex_);
+    std::vector<WatchedRange> ranges;
+    for (const auto& [key, index] : reserved_) {
+        const auto& reservation = reservations_[index];
+        if (reservation.watched && reservation.committed != 0) {
+            ranges.push_back({key, reservation.base, reservation.committed});
+        }
+    }
+    return ranges;
+}
+
+void RegionArena::release() {
+    std::lock_guard lock(mutex_);
+    for (const auto& chunk : chunks_) {
+        VirtualFree(chunk.base, 0, MEM_RELEASE);
+    }
+    for (const auto& reservation : reservations_) {
+        VirtualFree(reservation.base, 0, MEM_RELEASE);
+    }
+    chunks_.clear();
+    blocks_.clear();
+    reservations_.clear();
+    reserved_.clear();
+}
+
+std::size_t RegionArena::block_count() const {
+    std::lock_guard lock(mutex_);
+    return blocks_.size();
+}
+
+std::size_t RegionArena::used_bytes() const {
+    std::lock_guard lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk.used;
+    }
+    return total;
+}
+
+std::size_t RegionArena::committed_bytes() const {
+    std::lock_guard lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk.committed;
+    }
+    for (const auto& reservation : reservations_) {
+        total += reservation.committed;
+    }
+    return total;
+}
+
+std::size_t RegionArena::reserved_bytes() const {
+    std::lock_guard lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& chunk : chunks_) {
+        total += chunk.reserved;
+    }
+    for (const auto& reservation : reservations_) {
+        total += reservation.reserved;
+    }
+    return total;
+}
+
+std::uint8_t* RegionArena::carve(std::size_t size, std::size_t alignment) {
+    auto fits = [size, alignment](const Chunk& chunk) {
+        const auto address = reinterpret_cast<std::uintptr_t>(chunk.base) + chunk.used;
+        const auto offset = align_up(address, alignment) - reinterpret_cast<std::uintptr_t>(chunk.base);
+        return offset <= chunk.reserved && size <= chunk.reserved - offset;
+    };
+
+    if ((chunks_.empty() || !fits(chunks_.back())) && !add_chunk(size + alignment)) {
+        return nullptr;
+    }
+
+    auto& chunk = chunks_.back();
+    const auto address = align_up(reinterpret_cast<std::uintptr_t>(chunk.base) + chunk.used, alignment);
+    const auto offset = address - reinterpret_cast<std::uintptr_t>(chunk.base);
+    if (!commit_to(chunk, offset + size)) {
+        return nullptr;
+    }
+
+    chunk.used = offset + size;
+    return chunk.base + offset;
+}
+
+bool RegionArena::add_chunk(std::size_t min_size) {
+    const std::size_t reserve = std::max(chunk_size_, align_up(min_size, kCommitSize));
+    void* base = VirtualAlloc(nullptr, reserve, MEM_RESERVE, PAGE_NOACCESS);
+    if (!base) {
+        return false;
+    }
+    chunks_.push_back(Chunk{static_cast<std::uint8_t*>(base), reserve, 0, 0});
+    return true;
+}
+
+bool RegionArena::commit_to(Chunk& chunk, std::size_t end, std::size_t granularity) {
+    if (end <= chunk.committed) {
+        return true;
+    }
+    const std::size_t target = std::min(align_up(end, granularity), chunk.reserved);
+    if (!VirtualAlloc(chunk.base + chunk.committed, target - chunk.committed, MEM_COMMIT, PAGE_READWRITE)) {
+        return false;
+    }
+    chunk.committed = target;
+    return true;
+}
+
+} // namespace app_hook::memory
@@ -0,0 +1,182 @@
+#include "../include/memory/region_snapshot.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace app_hook::memory {
+
+namespace {
+
+constexpr std::size_t kPageSize = RegionArena::kPageSize;
+
+/// @brief Number of pages covering a byte count
+constexpr std::size_t page_count(std::size_t bytes) noexcept {
+    return (bytes + kPageSize - 1) / kPageSize;
+}
+
+} // namespace
+
+RegionSnapshots& RegionSnapshots::instance() {
+    static RegionSnapshots snapshots;
+    return snapshots;
+}
+
+std::expected<SnapshotStats, SnapshotError> RegionSnapshots::capture(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    const auto ranges = arena_.watched_ranges();
+    if (ranges.empty()) {
+        return std::unexpected(SnapshotError::no_watched_regions);
+    }
+    if (!collect(ranges)) {
+        return std::unexpected(SnapshotError::watch_failed);
+    }
+
+    auto& snapshot = snapshots_[name];
+    SnapshotStats stats;
+    for (const auto& range : ranges) {
+        auto& shadow = snapshot[range.key];
+        ++stats.regions;
+
+        // A new region, or one copied again elsewhere, is taken whole
+        if (shadow.base != range.base) {
+            shadow.base = range.base;
+            shadow.bytes.assign(range.base, range.base + range.committed);
+            shadow.dirty.assign(page_count(range.committed), false);
+            stats.pages += shadow.dirty.size();
+            stats.bytes += range.committed;
+            continue;
+        }
+
+        // Pages committed since the last capture are taken whole as well
+        const auto captured = shadow.bytes.size();
+        if (range.committed > captured) {
+            shadow.bytes.insert(shadow.bytes.end(), range.base + captured, range.base + range.committed);
+            shadow.dirty.resize(page_count(range.committed), false);
+            stats.pages += page_count(range.committed) - page_count(captured);
+            stats.bytes += range.committed - captured;
+        }
+
+        for (std::size_t page = 0; page < shadow.dirty.size(); ++page) {
+            if (!shadow.dirty[page]) {
+                continue;
+            }
+            const auto offset = page * kPageSize;
+            const auto length = std::min(kPageSize, shadow.bytes.size() - offset);
+            std::memcpy(shadow.bytes.data() + offset, range.base + offset, length);
+            shadow.dirty[page] = false;
+            ++stats.pages;
+            stats.bytes += length;
+        }
+    }
+
+    // Regions no longer watched are not part of the state any more
+    std::erase_if(snapshot, [&ranges](const auto& entry) {
+        return std::ranges::none_of(ranges, [&entry](const auto& range) { return range.key == entry.first; });
+    });
+    return stats;
+}
+
+std::expected<SnapshotStats, SnapshotError> RegionSnapshots::restore(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    const auto it = snapshots_.find(name);
+    if (it == snapshots_.end()) {
+        return std::unexpected(SnapshotError::unknown_snapshot);
+    }
+    const auto ranges = arena_.watched_ranges();
+    if (ranges.empty()) {
+        return std::unexpected(SnapshotError::no_watched_regions);
+    }
+    if (!collect(ranges)) {
+        return std::unexpected(SnapshotError::watch_failed);
+    }
+
+    SnapshotStats stats;
+    std::vector<std::pair<Shadow*, std::size_t>> restored;
+    for (const auto& range : ranges) {
+        const auto shadow_it = it->second.find(range.key);
+        if (shadow_it == it->second.end() || shadow_it->second.base != range.base) {
+            continue;
+        }
+        auto& shadow = shadow_it->second;
+        ++stats.regions;
+
+        const auto end = std::min(shadow.bytes.size(), range.committed);
+        for (std::size_t page = 0; page < shadow.dirty.size() && page * kPageSize < end; ++page) {
+            if (!shadow.dirty[page]) {
+                continue;
+            }
+            const auto offset = page * kPageSize;
+            const auto length = std::min(kPageSize, end - offset);
+            std::memcpy(range.base + offset, shadow.bytes.data() + offset, length);
+            restored.emplace_back(&shadow, page);
+            ++stats.pages;
+            stats.bytes += length;
+        }
+    }
+
+    // The copies are writes too: the other snapshots see the pages as changed,
+    // while this one matches them again
+    if (!collect(ranges)) {
+        return std::unexpected(SnapshotError::watch_failed);
+    }
+    for (const auto& [shadow, page] : restored) {
+        shadow->dirty[page] = false;
+    }
+    return stats;
+}
+
+bool RegionSnapshots::drop(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    return snapshots_.erase(name) != 0;
+}
+
+std::vector<std::string> RegionSnapshots::names() const {
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> result;
+    result.reserve(snapshots_.size());
+    for (const auto& [name, snapshot] : snapshots_) {
+        result.push_back(name);
+    }
+    return result;
+}
+
+std::size_t RegionSnapshots::bytes() const {
+    std::lock_guard lock(mutex_);
+    std::size_t total = 0;
+    for (const auto& [name, snapshot] : snapshots_) {
+        for (const auto& [key, shadow] : snapshot) {
+            total += shadow.bytes.size();
+        }
+    }
+    return total;
+}
+
+bool RegionSnapshots::collect(const std::vector<RegionArena::WatchedRange>& ranges) {
+    std::array<void*, 512> written;
+    for (const auto& range : ranges) {
+        // With the reset flag each call hands out the next batch of written pages
+        for (;;) {
+            ULONG_PTR count = written.size();
+            DWORD granularity = 0;
+            if (GetWriteWatch(WRITE_WATCH_FLAG_RESET, range.base, range.committed, written.data(), &count,
+                              &granularity) != 0) {
+                return false;
+            }
+            for (ULONG_PTR i = 0; i < count; ++i) {
+                const auto page = (static_cast<std::uint8_t*>(written[i]) - range.base) / kPageSize;
+                for (auto& [name, snapshot] : snapshots_) {
+                    if (auto shadow = snapshot.find(range.key);
+                        shadow != snapshot.end() && shadow->second.base == range.base && page < shadow->second.dirty.size()) {
+                        shadow->second.dirty[page] = true;
+                    }
+                }
+            }
+            if (count < written.size()) {
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace app_hook::memory
@@ -0,0 +1,408 @@
+#include "../include/config/text_config_loader.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <toml++/toml.hpp>
+#include <fstream>
+#include <iterator>
+
+namespace memory_plugin {
+
+namespace {
+
+/// @brief Read a strings file: one string per line, without the line breaks
+std::optional<std::vector<std::string>> read_lines(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    std::string text(std::istreambuf_iterator<char>(file), {});
+    if (text.starts_with("\xEF\xBB\xBF")) {
+        text.erase(0, 3);
+    }
+
+    std::vector<std::string> lines;
+    std::size_t start = 0;
+    while (start < text.size()) {
+        auto end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        auto line = std::string_view(text).substr(start, end - start);
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        lines.emplace_back(line);
+        start = end + 1;
+    }
+    return lines;
+}
+
+} // namespace
+
+std::vector<app_hook::config::ConfigType> TextConfigLoader::supported_types() const {
+    return {
+        app_hook::config::ConfigType::Text
+    };
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>>
+TextConfigLoader::load_configs(
+    app_hook::config::ConfigType type,
+    const std::string& file_path,
+    const std::string& task_name) {
+
+    if (type != app_hook::config::ConfigType::Text) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Unsupported config type: {}", static_cast<int>(type));
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+
+    PLUGIN_LOG_INFO("TextConfigLoader: Loading text configs from file: {} for task: {}", file_path, task_name);
+    if (!std::filesystem::exists(file_path)) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Config file not found: {}", file_path);
+        return std::unexpected(app_hook::config::ConfigError::file_not_found);
+    }
+
+    // Tables of one file often share a charmap; it is read once per load. The
+    // cache is local: loaders run concurrently on the same loader object
+    CharmapCache charmaps;
+    try {
+        auto config = toml::parse_file(file_path);
+        const auto directory = std::filesystem::path(file_path).parent_path();
+        std::vector<app_hook::config::ConfigPtr> configs;
+
+        // Table format only: [text.item]
+        if (const auto* text_table = config["text"].as_table()) {
+            for (auto& [key, value] : *text_table) {
+                const auto* table = value.as_table();
+                if (!table) {
+                    PLUGIN_LOG_WARN("TextConfigLoader: Invalid text format for key: {}", std::string(key));
+                    continue;
+                }
+                if (auto text = parse_text(*table, task_name, std::string(key), directory, charmaps)) {
+                    configs.push_back(std::move(text));
+                } else {
+                    PLUGIN_LOG_WARN("TextConfigLoader: Failed to parse text table: {}", std::string(key));
+                }
+            }
+        } else {
+            PLUGIN_LOG_DEBUG("TextConfigLoader: No text section found in config file");
+        }
+
+        PLUGIN_LOG_INFO("TextConfigLoader: Successfully loaded {} text configurations", configs.size());
+        return configs;
+    } catch (const toml::parse_error& e) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: TOML parse error in file {}: {}", file_path, e.what());
+        return std::unexpected(app_hook::config::ConfigError::parse_error);
+    } catch (const std::exception& e) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Exception while loading configs from {}: {}", file_path, e.what());
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+}
+
+std::string TextConfigLoader::get_name() const {
+    return "Text Table Loader";
+}
+
+std::string TextConfigLoader::get_version() const {
+    return "1.0.0";
+}
+
+std::uint32_t TextConfigLoader::cache_version() const {
+    return 1;
+}
+
+bool TextConfigLoader::serialize_configs(const std::vector<app_hook::config::ConfigPtr>& configs,
+                                         app_hook::util::ByteWriter& out) const {
+    out.write(static_cast<std::uint32_t>(configs.size()));
+    for (const auto& config : configs) {
+        const auto* text_config = dynamic_cast<const app_hook::config::TextConfig*>(config.get());
+        if (!text_config) {
+            return false;
+        }
+        app_hook::config::write_config_base(out, *text_config);
+        out.write(text_config->offset().has_value());
+        out.write(text_config->offset().value_or(0));
+        out.write(text_config->offset_width());
+        out.write(text_config->offset_base());
+        out.write(text_config->terminator());
+        out.write(static_cast<std::uint32_t>(text_config->offsets().size()));
+        for (const auto offset : text_config->offsets()) {
+            out.write(offset);
+        }
+        out.write_bytes(text_config->data());
+        out.write(static_cast<std::uint32_t>(text_config->sources().size()));
+        for (const auto& source : text_config->sources()) {
+            out.write_string(source.path);
+            out.write(source.size);
+            out.write(source.write_time);
+        }
+    }
+    return true;
+}
+
+app_hook::config::ConfigResult<std::vector<app_hook::config::ConfigPtr>>
+TextConfigLoader::deserialize_configs(
+    app_hook::config::ConfigType type,
+    app_hook::util::ByteReader& in,
+    const std::string& task_name) {
+
+    std::uint32_t count = 0;
+    if (type != app_hook::config::ConfigType::Text || !in.read(count)) {
+        return std::unexpected(app_hook::config::ConfigError::invalid_format);
+    }
+
+    std::vector<app_hook::config::ConfigPtr> configs;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        std::string name;
+        if (!app_hook::config::read_config_identity(in, key, name)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        auto text_config = std::make_shared<app_hook::config::TextConfig>(std::move(key), std::move(name));
+
+        bool has_offset = false;
+        std::uint32_t offset = 0;
+        std::uint8_t width = 0;
+        app_hook::config::TextOffsetBase base{};
+        std::uint8_t terminator = 0;
+        std::uint32_t string_count = 0;
+        if (!app_hook::config::read_config_fields(in, *text_config) || !in.read(has_offset) || !in.read(offset) ||
+            !in.read(width) || !in.read(base) || !in.read(terminator) || !in.read(string_count) ||
+            string_count > in.remaining() / sizeof(std::uint32_t) || !text_config->set_offset_width(width) ||
+            (base != app_hook::config::TextOffsetBase::table && base != app_hook::config::TextOffsetBase::data)) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        text_config->set_offset(has_offset ? std::optional(offset) : std::nullopt);
+        text_config->set_offset_base(base);
+        text_config->set_terminator(terminator);
+
+        std::vector<std::uint32_t> offsets(string_count);
+        for (auto& string_offset : offsets) {
+            in.read(string_offset);
+        }
+        std::vector<std::uint8_t> data;
+        in.read_bytes(data);
+        std::uint32_t source_count = 0;
+        if (!in.read(source_count) || source_count > in.remaining() ||
+            !text_config->set_strings(std::move(offsets), std::move(data))) {
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        for (std::uint32_t s = 0; s < source_count; ++s) {
+            app_hook::config::TextSource source;
+            if (!in.read_string(source.path) || !in.read(source.size) || !in.read(source.write_time)) {
+                return std::unexpected(app_hook::config::ConfigError::invalid_format);
+            }
+            text_config->add_source(std::move(source));
+        }
+
+        // The cache is keyed on the config file only; edited sidecars mean encoding again
+        if (!sources_current(*text_config)) {
+            PLUGIN_LOG_DEBUG("TextConfigLoader: Sidecar of '{}' changed since it was cached", text_config->key());
+            return std::unexpected(app_hook::config::ConfigError::invalid_format);
+        }
+        configs.push_back(std::move(text_config));
+    }
+
+    PLUGIN_LOG_DEBUG("TextConfigLoader: Restored {} text configs for task {} from cache", configs.size(), task_name);
+    return configs;
+}
+
+app_hook::config::ConfigPtr TextConfigLoader::parse_text(const toml::table& table, const std::string& task_name,
+                                                         const std::string& config_name,
+                                                         const std::filesystem::path& directory,
+                                                         CharmapCache& charmaps) {
+    auto config = app_hook::config::make_config<app_hook::config::TextConfig>(
+        task_name + "_" + config_name, config_name);
+    auto* text_config = static_cast<app_hook::config::TextConfig*>(config.get());
+
+    // Parse required field: readFromContext (the region the table is written into)
+    auto read_from_context = table["readFromContext"].value<std::string>();
+    if (!read_from_context || read_from_context->empty()) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Missing or invalid readFromContext field in text table: {}", config_name);
+        return nullptr;
+    }
+    text_config->set_read_from_context(std::move(*read_from_context));
+
+    if (auto description = table["description"].value<std::string>()) {
+        text_config->set_description(std::move(*description));
+    }
+
+    // Parse optional field: writeInContext = { enabled = true, name = "..." }
+    if (const auto* write_table = table["writeInContext"].as_table()) {
+        app_hook::config::WriteContextConfig write_config;
+        write_config.enabled = (*write_table)["enabled"].value_or(false);
+        write_config.name = (*write_table)["name"].value_or(std::string{});
+        text_config->set_write_in_context(std::move(write_config));
+    }
+
+    // Parse optional fields of the block layout
+    if (auto text = table["offset"].value<std::string>()) {
+        text_config->set_offset(static_cast<std::uint32_t>(app_hook::config::ConfigParsingUtils::parse_address(*text)));
+    } else if (auto number = table["offset"].value<std::int64_t>(); number && *number >= 0) {
+        text_config->set_offset(static_cast<std::uint32_t>(*number));
+    }
+    const auto width = table["offsetWidth"].value_or(std::int64_t{2});
+    if (width < 0 || width > 0xFF || !text_config->set_offset_width(static_cast<std::uint8_t>(width))) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: offsetWidth of text table '{}' must be 2 or 4", config_name);
+        return nullptr;
+    }
+    const auto offsets_from = table["offsetsFrom"].value_or(std::string("table"));
+    if (offsets_from == "data") {
+        text_config->set_offset_base(app_hook::config::TextOffsetBase::data);
+    } else if (offsets_from != "table") {
+        PLUGIN_LOG_ERROR("TextConfigLoader: offsetsFrom of text table '{}' must be \"table\" or \"data\"", config_name);
+        return nullptr;
+    }
+    const auto terminator = table["terminator"].value_or(std::int64_t{0});
+    if (terminator < 0 || terminator > 0xFF) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: terminator of text table '{}' must be a byte", config_name);
+        return nullptr;
+    }
+    text_config->set_terminator(static_cast<std::uint8_t>(terminator));
+
+    // Parse the encoder: a charmap sidecar, or printable ASCII as-is
+    static const auto ascii = app_hook::config::TextEncoder::ascii();
+    const app_hook::config::TextEncoder* encoder = &ascii;
+    if (auto charmap_path = table["charmap"].value<std::string>()) {
+        const auto path = directory / *charmap_path;
+        encoder = charmap(path, charmaps);
+        auto source = encoder ? fingerprint(path) : std::nullopt;
+        if (!source) {
+            PLUGIN_LOG_ERROR("TextConfigLoader: Cannot read charmap '{}' of text table '{}'", path.string(), config_name);
+            return nullptr;
+        }
+        text_config->add_source(std::move(*source));
+    }
+
+    // Parse required strings: strings = ["..."] or file = "strings.txt" (one per line)
+    std::vector<std::string> strings;
+    if (const auto* array = table["strings"].as_array()) {
+        for (const auto& node : *array) {
+            auto string = node.value<std::string>();
+            if (!string) {
+                PLUGIN_LOG_ERROR("TextConfigLoader: strings of text table '{}' must all be strings", config_name);
+                return nullptr;
+            }
+            strings.push_back(std::move(*string));
+        }
+    } else if (auto file = table["file"].value<std::string>()) {
+        const auto path = directory / *file;
+        auto lines = read_lines(path);
+        auto source = lines ? fingerprint(path) : std::nullopt;
+        if (!source) {
+            PLUGIN_LOG_ERROR("TextConfigLoader: Cannot read strings file '{}' of text table '{}'", path.string(), config_name);
+            return nullptr;
+        }
+        strings = std::move(*lines);
+        text_config->add_source(std::move(*source));
+    }
+    if (strings.empty()) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Text table '{}' needs a non-empty strings array or a strings file", config_name);
+        return nullptr;
+    }
+
+    // One pass: each string's offset is the pool size when it starts
+    for (std::size_t i = 0; i < strings.size(); ++i) {
+        if (auto encoded = encoder->encode(strings[i], text_config->begin_string()); !encoded) {
+            PLUGIN_LOG_ERROR("TextConfigLoader: String {} of text table '{}' cannot be encoded at byte {}: '{}'",
+                             i, config_name, encoded.error(), strings[i]);
+            return nullptr;
+        }
+        text_config->end_string();
+    }
+    if (!text_config->entries_fit()) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Text table '{}' ({} bytes) is too large for 2-byte offsets; set offsetWidth = 4",
+                         config_name, text_config->block_bytes());
+        return nullptr;
+    }
+
+    PLUGIN_LOG_DEBUG("TextConfigLoader: Parsed text table '{}': {} string(s), {} byte(s) into '{}'", config_name,
+                     text_config->count(), text_config->block_bytes(), text_config->read_from_context());
+    return config;
+}
+
+const app_hook::config::TextEncoder* TextConfigLoader::charmap(const std::filesystem::path& path,
+                                                                    CharmapCache& charmaps) {
+    const auto key = path.lexically_normal().string();
+    if (const auto it = charmaps.find(key); it != charmaps.end()) {
+        return &it->second;
+    }
+    auto encoder = read_charmap(path);
+    if (!encoder) {
+        return nullptr;
+    }
+    return &charmaps.emplace(key, std::move(*encoder)).first->second;
+}
+
+std::optional<app_hook::config::TextEncoder> TextConfigLoader::read_charmap(const std::filesystem::path& path) {
+    toml::table root;
+    try {
+        root = toml::parse_file(path.string());
+    } catch (const toml::parse_error& e) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Cannot parse charmap {}: {}", path.string(), e.description());
+        return std::nullopt;
+    }
+    const auto* table = root["charmap"].as_table();
+    if (!table || table->empty()) {
+        PLUGIN_LOG_ERROR("TextConfigLoader: Charmap {} has no [charmap] entries", path.string());
+        return std::nullopt;
+    }
+
+    app_hook::config::TextEncoder encoder;
+    for (const auto& [key, value] : *table) {
+        // The key is one character; the value one byte or an array of up to four
+        std::size_t length = 0;
+        const auto code_point = app_hook::config::decode_utf8(key.str(), length);
+        std::vector<std::uint8_t> bytes;
+        if (auto byte = value.value<std::int64_t>()) {
+            if (*byte >= 0 && *byte <= 0xFF) {
+                bytes.push_back(static_cast<std::uint8_t>(*byte));
+            }
+        } else if (const auto* array = value.as_array()) {
+            for (const auto& node : *array) {
+                const auto element = node.value<std::int64_t>();
+                if (!element || *element < 0 || *element > 0xFF) {
+                    bytes.clear();
+                    break;
+                }
+                bytes.push_back(static_cast<std::uint8_t>(*element));
+            }
+        }
+        if (!code_point || length != key.str().size() || !encoder.map(*code_point, bytes)) {
+            PLUGIN_LOG_ERROR("TextConfigLoader: Charmap {} has an invalid mapping for '{}'", path.string(), key.str());
+            return std::nullopt;
+        }
+    }
+    return encoder;
+}
+
+std::optional<app_hook::config::TextSource> TextConfigLoader::fingerprint(const std::filesystem::path& path) {
+    std::error_code ec;
+    app_hook::config::TextSource source;
+    source.path = path.lexically_normal().string();
+    source.size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    source.write_time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) {
+        return std::nullopt;
+    }
+    return source;
+}
+
+bool TextConfigLoader::sources_current(const app_hook::config::TextConfig& config) {
+    for (const auto& cached : config.sources()) {
+        // A bundle may ship the encoded table without its sidecars
+        std::error_code ec;
+        if (!std::filesystem::exists(cached.path, ec)) {
+            continue;
+        }
+        const auto current = fingerprint(cached.path);
+        if (!current || *current != cached) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace memory_plugin
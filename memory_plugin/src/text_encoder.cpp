@@ -0,0 +1,132 @@
+#include "../include/config/text_encoder.hpp"
+#include <charconv>
+
+namespace app_hook::config {
+
+namespace {
+
+constexpr std::uint32_t kLengthShift = 24;
+constexpr std::uint32_t kOffsetMask = (1u << kLengthShift) - 1;
+
+/// @brief First code point that goes to the sparse map
+constexpr char32_t kDenseLimit = 0x10000;
+
+} // namespace
+
+std::optional<char32_t> decode_utf8(std::string_view text, std::size_t& length) noexcept {
+    if (text.empty()) {
+        return std::nullopt;
+    }
+    const auto lead = static_cast<std::uint8_t>(text[0]);
+    char32_t code_point = 0;
+    std::size_t count = 0;
+    if (lead < 0x80) {
+        length = 1;
+        return lead;
+    } else if ((lead & 0xE0) == 0xC0) {
+        code_point = lead & 0x1F;
+        count = 2;
+    } else if ((lead & 0xF0) == 0xE0) {
+        code_point = lead & 0x0F;
+        count = 3;
+    } else if ((lead & 0xF8) == 0xF0) {
+        code_point = lead & 0x07;
+        count = 4;
+    } else {
+        return std::nullopt;
+    }
+    if (text.size() < count) {
+        return std::nullopt;
+    }
+    for (std::size_t i = 1; i < count; ++i) {
+        const auto next = static_cast<std::uint8_t>(text[i]);
+        if ((next & 0xC0) != 0x80) {
+            return std::nullopt;
+        }
+        code_point = (code_point << 6) | (next & 0x3F);
+    }
+
+    // Overlong forms, surrogates and values past U+10FFFF are not valid UTF-8
+    constexpr char32_t kMinimum[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (code_point < kMinimum[count] || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+        return std::nullopt;
+    }
+    length = count;
+    return code_point;
+}
+
+TextEncoder TextEncoder::ascii() {
+    TextEncoder encoder;
+    for (char32_t c = 0x20; c <= 0x7E; ++c) {
+        const std::uint8_t byte = static_cast<std::uint8_t>(c);
+        encoder.map(c, {&byte, 1});
+    }
+    return encoder;
+}
+
+bool TextEncoder::map(char32_t code_point, std::span<const std::uint8_t> bytes) {
+    if (bytes.empty() || bytes.size() > kMaxSequence || pool_.size() + bytes.size() > kOffsetMask) {
+        return false;
+    }
+    const Entry entry = static_cast<Entry>(pool_.size()) | (static_cast<Entry>(bytes.size()) << kLengthShift);
+    pool_.insert(pool_.end(), bytes.begin(), bytes.end());
+
+    Entry* slot = nullptr;
+    if (code_point < kDenseLimit) {
+        if (code_point >= dense_.size()) {
+            dense_.resize(static_cast<std::size_t>(code_point) + 1, 0);
+        }
+        slot = &dense_[code_point];
+    } else {
+        slot = &sparse_[code_point];
+    }
+    if (*slot == 0) {
+        ++mapped_;
+    }
+    *slot = entry;
+    return true;
+}
+
+TextEncoder::Entry TextEncoder::find(char32_t code_point) const noexcept {
+    if (code_point < dense_.size()) {
+        return dense_[code_point];
+    }
+    if (code_point >= kDenseLimit) {
+        if (const auto it = sparse_.find(code_point); it != sparse_.end()) {
+            return it->second;
+        }
+    }
+    return 0;
+}
+
+std::expected<void, std::size_t> TextEncoder::encode(std::string_view utf8, std::vector<std::uint8_t>& out) const {
+    for (std::size_t i = 0; i < utf8.size();) {
+        // Raw byte escape: {XX}
+        if (utf8[i] == '{' && (i + 1 >= utf8.size() || utf8[i + 1] != '{')) {
+            std::uint8_t value = 0;
+            const auto* begin = utf8.data() + i + 1;
+            const auto* end = begin + 2;
+            if (utf8.size() - i < 4 || utf8[i + 3] != '}' || std::from_chars(begin, end, value, 16).ptr != end) {
+                return std::unexpected(i);
+            }
+            out.push_back(value);
+            i += 4;
+            continue;
+        }
+
+        std::size_t length = 0;
+        const auto code_point = decode_utf8(utf8.substr(i), length);
+        const Entry entry = code_point ? find(*code_point) : 0;
+        if (entry == 0) {
+            return std::unexpected(i);
+        }
+        const auto* bytes = pool_.data() + (entry & kOffsetMask);
+        out.insert(out.end(), bytes, bytes + (entry >> kLengthShift));
+
+        // "{{" is one literal brace
+        i += (*code_point == U'{') ? 2 : length;
+    }
+    return {};
+}
+
+} // namespace app_hook::config
@@ -0,0 +1,129 @@
+#include "../include/memory/text_load.hpp"
+#include "../include/memory/text_index.hpp"
+#include "../include/memory/memory_region.hpp"
+#include "../include/memory/region_arena.hpp"
+#include "../../core_hook/include/task/hook_task.hpp"
+#include "../../core_hook/include/context/mod_context.hpp"
+#include "plugin/plugin_interface.hpp"
+#include <cstring>
+
+namespace app_hook::memory {
+
+task::TaskResult TextLoadTask::execute() {
+    std::lock_guard lock(mutex_);
+    return write();
+}
+
+task::ReloadOutcome TextLoadTask::reload(const config::ConfigBase& updated) {
+    if (updated.type_id() != TextConfig::kTypeId) {
+        return task::ReloadOutcome::restart_required;
+    }
+    const auto& text_config = static_cast<const TextConfig&>(updated);
+
+    std::lock_guard lock(mutex_);
+    if (text_config.read_from_context() != config_.read_from_context() ||
+        text_config.write_in_context().enabled != config_.write_in_context().enabled ||
+        text_config.write_in_context().name != config_.write_in_context().name) {
+        return task::ReloadOutcome::restart_required;
+    }
+
+    const bool table_changed = text_config.offsets() != config_.offsets() || text_config.data() != config_.data() ||
+                               text_config.offset() != config_.offset() ||
+                               text_config.offset_width() != config_.offset_width() ||
+                               text_config.offset_base() != config_.offset_base();
+    if (!table_changed && text_config.description() == config_.description()) {
+        return task::ReloadOutcome::unchanged;
+    }
+
+    config_ = text_config;
+    if (!table_changed || !written_) {
+        return task::ReloadOutcome::updated;
+    }
+    if (auto result = write(); !result) {
+        PLUGIN_LOG_ERROR("Failed to write reloaded text table '{}'", config_.key());
+        return task::ReloadOutcome::restart_required;
+    }
+    PLUGIN_LOG_INFO("Reloaded text table '{}': {} string(s)", config_.key(), config_.count());
+    return task::ReloadOutcome::updated;
+}
+
+task::TaskResult TextLoadTask::write() {
+    PLUGIN_LOG_DEBUG("Executing TextLoadTask for key '{}'", config_.key());
+
+    if (!config_.is_valid()) {
+        PLUGIN_LOG_ERROR("Invalid configuration for TextLoadTask '{}'", config_.key());
+        return std::unexpected(task::TaskError::invalid_config);
+    }
+
+    auto& context = host_ ? host_->get_mod_context() : app_hook::context::ModContext::instance();
+    if (!region_key_) {
+        region_key_ = context.intern(config_.read_from_context());
+    }
+    auto* memory_region = context.get<MemoryRegion>(region_key_);
+    if (!memory_region) {
+        PLUGIN_LOG_ERROR("Memory region '{}' not found in context for TextLoadTask '{}'",
+                       config_.read_from_context(), config_.key());
+        return std::unexpected(task::TaskError::invalid_address);
+    }
+
+    // A reserved region commits the pages the table needs; its base does not move
+    const std::size_t start = config_.offset().value_or(memory_region->original_size);
+    const std::size_t end = start + config_.block_bytes();
+    if (end > memory_region->size && memory_region->can_grow_to(end)) {
+        if (RegionArena::instance().grow(memory_region->base(), end)) {
+            PLUGIN_LOG_DEBUG("Grew region '{}' from {} to {} bytes", config_.read_from_context(), memory_region->size, end);
+            memory_region->size = end;
+        } else {
+            PLUGIN_LOG_ERROR("Cannot commit {} bytes of region '{}'", end, config_.read_from_context());
+        }
+    }
+    if (end > memory_region->size) {
+        PLUGIN_LOG_ERROR("Text table '{}' ({} bytes at offset {}) does not fit in region '{}' ({} bytes)",
+                       config_.key(), config_.block_bytes(), start, config_.read_from_context(), memory_region->size);
+        return std::unexpected(task::TaskError::invalid_address);
+    }
+
+    // One pass: the table entries, then the strings right behind them
+    auto* block = memory_region->base() + start;
+    auto* out = block;
+    for (std::size_t i = 0; i < config_.count(); ++i) {
+        const auto entry = config_.entry(i);
+        if (config_.offset_width() == 2) {
+            const auto narrow = static_cast<std::uint16_t>(entry);
+            std::memcpy(out, &narrow, sizeof(narrow));
+        } else {
+            std::memcpy(out, &entry, sizeof(entry));
+        }
+        out += config_.offset_width();
+    }
+    std::memcpy(out, config_.data().data(), config_.data().size());
+    written_ = true;
+
+    PLUGIN_LOG_INFO("Wrote text table '{}': {} string(s), {} byte(s) at offset 0x{:X} of '{}'",
+                   config_.key(), config_.count(), config_.block_bytes(), start, config_.read_from_context());
+
+    if (!config_.writes_to_context()) {
+        return {};
+    }
+    const auto& context_key = config_.write_in_context().name;
+    if (!view_key_) {
+        view_key_ = context.intern(context_key);
+        index_key_ = context.intern(context_key + ".index");
+    }
+
+    TextIndex index;
+    index.block = block;
+    index.data = out;
+    index.data_size = config_.data().size();
+    index.offsets = config_.offsets();
+    auto view = MemoryRegion::make_view(block, config_.block_bytes(), config_.read_from_context(),
+                                        config_.description().empty() ? ("Text table " + config_.key())
+                                                                      : config_.description());
+    if (!context.store(view_key_, std::move(view)) || !context.store(index_key_, std::move(index))) {
+        PLUGIN_LOG_ERROR("Cannot store context key '{}' for TextLoadTask '{}'", context_key, config_.key());
+        return std::unexpected(task::TaskError::invalid_config);
+    }
+    return {};
+}
+
+} // namespace app_hook::memory
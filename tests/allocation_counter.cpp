@@ -0,0 +1,125 @@
+#include "allocation_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+namespace app_hook::test {
+
+namespace {
+
+// Counter of the innermost open scope on this thread (constant-initialized, so
+// safe to read from operator new before any thread setup)
+thread_local std::size_t* t_counter = nullptr;
+
+void count_allocation() noexcept {
+    if (t_counter) {
+        ++*t_counter;
+    }
+}
+
+void* allocate(std::size_t size) noexcept {
+    count_allocation();
+    return std::malloc(size ? size : 1);
+}
+
+void* allocate_aligned(std::size_t size, std::align_val_t alignment) noexcept {
+    count_allocation();
+    const auto align = static_cast<std::size_t>(alignment);
+#ifdef _MSC_VER
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+void release_aligned(void* block) noexcept {
+#ifdef _MSC_VER
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+} // namespace
+
+AllocationScope::AllocationScope() noexcept : previous_(t_counter) {
+    t_counter = &count_;
+}
+
+AllocationScope::~AllocationScope() {
+    stop();
+}
+
+std::size_t AllocationScope::stop() noexcept {
+    if (open_) {
+        t_counter = previous_;
+        open_ = false;
+    }
+    return count_;
+}
+
+} // namespace app_hook::test
+
+#ifdef APP_HOOK_COUNT_ALLOCATIONS
+
+// Replacements of the global allocation functions for the test binary
+
+void* operator new(std::size_t size) {
+    if (auto* block = app_hook::test::allocate(size)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return app_hook::test::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return app_hook::test::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    if (auto* block = app_hook::test::allocate_aligned(size, alignment)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return app_hook::test::allocate_aligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return app_hook::test::allocate_aligned(size, alignment);
+}
+
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, const std::nothrow_t&) noexcept { std::free(block); }
+void operator delete[](void* block, const std::nothrow_t&) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept { app_hook::test::release_aligned(block); }
+void operator delete[](void* block, std::align_val_t) noexcept { app_hook::test::release_aligned(block); }
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept { app_hook::test::release_aligned(block); }
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept { app_hook::test::release_aligned(block); }
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept {
+    app_hook::test::release_aligned(block);
+}
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept {
+    app_hook::test::release_aligned(block);
+}
+
+#endif // APP_HOOK_COUNT_ALLOCATIONS
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <gtest/gtest.h>
+#include <cstddef>
+
+namespace app_hook::test {
+
+/// @brief Check if this test build counts heap allocations
+/// @return True when allocation_counter.cpp replaces the global operator new
+///         (APP_HOOK_COUNT_ALLOCATIONS, on unless a sanitizer or debug heap needs it off)
+[[nodiscard]] constexpr bool allocation_tracking_enabled() noexcept {
+#ifdef APP_HOOK_COUNT_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+/// @brief Count the heap allocations the calling thread makes while the scope is open
+/// @note Only operator new is counted: MSVC's CRT links malloc statically and
+///       cannot replace it, but the containers, strings and smart pointers of
+///       the hot path all allocate through operator new. Scopes nest; an inner
+///       scope's allocations are not added to the outer one.
+class AllocationScope {
+public:
+    AllocationScope() noexcept;
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    /// @brief Stop counting
+    /// @return Allocations made since the scope was opened
+    std::size_t stop() noexcept;
+
+private:
+    std::size_t count_ = 0;
+    std::size_t* previous_ = nullptr;
+    bool open_ = true;
+};
+
+} // namespace app_hook::test
+
+/// @brief Expect a statement (or a braced block) to make no heap allocation
+/// @note Skips the test when the build does not count allocations
+#define EXPECT_NO_ALLOCATIONS(...)                                                              \
+    do {                                                                                        \
+        if (!::app_hook::test::allocation_tracking_enabled()) {                                \
+            GTEST_SKIP() << "Allocation tracking is off in this build";                        \
+        }                                                                                       \
+        ::app_hook::test::AllocationScope allocation_scope_;                                   \
+        __VA_ARGS__;                                                                            \
+        const auto allocations_ = allocation_scope_.stop();                                    \
+        EXPECT_EQ(allocations_, 0u) << "Heap allocations in: " #__VA_ARGS__;                    \
+    } while (false)
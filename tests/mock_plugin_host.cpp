@@ -45,4 +45,8 @@ void MockPluginHost::clear_log_messages() {
 
 void MockPluginHost::set_data_path(const std::string& path) {
     data_path_ = path;
-} 
\ No newline at end of file
+} 
+
+void MockPluginHost::set_log_level(int level) {
+    set_min_log_level(level);
+}
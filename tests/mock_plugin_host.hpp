@@ -29,6 +29,19 @@ public:
     MOCK_METHOD((std::pair<void*, std::uint32_t>), get_process_info, (), (const, override));
     
     MOCK_METHOD(app_hook::context::ModContext&, get_mod_context, (), (override));
+    
+    MOCK_METHOD(std::vector<app_hook::hook::HookStats>, get_hook_stats, (), (const, override));
+    
+    MOCK_METHOD(void, register_memory_source, 
+                (const std::string& name, app_hook::util::MemorySource source), (override));
+    
+    MOCK_METHOD(void, unregister_memory_source, (const std::string& name), (override));
+    
+    MOCK_METHOD(app_hook::util::MemoryReport, get_memory_report, (), (const, override));
+    
+    MOCK_METHOD(std::vector<std::uintptr_t>, resolve_signatures, (const std::vector<std::string>& patterns), (override));
+    MOCK_METHOD(std::uintptr_t, resolve_symbol, (const std::string& symbol), (override));
+    MOCK_METHOD(std::span<const std::uint8_t>, bundle_blob, (const std::string& path), (override));
 
     // Non-mock implementations for logging (need to capture messages)
     void log_message(int level, const std::string& message) override;
@@ -38,6 +51,7 @@ public:
     const std::vector<std::pair<int, std::string>>& get_log_messages() const;
     void clear_log_messages();
     void set_data_path(const std::string& path);
+    void set_log_level(int level);
 
 private:
     std::vector<std::pair<int, std::string>> log_messages_;
@@ -0,0 +1,94 @@
+#include "modpack_generator.hpp"
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace app_hook::test {
+
+namespace {
+
+/// Hook addresses start here and are 16 bytes apart
+constexpr std::uintptr_t kFirstHook = 0x00410000;
+
+/// Patched instructions start here and are 8 bytes apart
+constexpr std::uintptr_t kFirstInstruction = 0x00500000;
+
+void write_file(const std::filesystem::path& path, const std::string& content) {
+    std::ofstream file(path, std::ios::binary);
+    file << content;
+}
+
+std::string region_name(std::size_t group) {
+    return std::format("modpack.group{}.region0", group);
+}
+
+} // namespace
+
+ModpackLayout generate_modpack(const std::filesystem::path& directory, const ModpackSpec& spec) {
+    const auto tasks_dir = directory / "tasks";
+    const auto binaries_dir = directory / "mods";
+    std::filesystem::create_directories(tasks_dir);
+    std::filesystem::create_directories(binaries_dir);
+
+    ModpackLayout layout;
+    layout.tasks_path = directory / "tasks.toml";
+    std::string tasks = "[metadata]\nversion = \"1.0.0\"\ndescription = \"Generated modpack\"\n\n";
+
+    std::size_t hook = 0;
+    std::size_t instruction = 0;
+    for (std::size_t g = spec.groups(); g-- > 0;) {
+        const auto memory_key = std::format("memory_{}", g);
+        const auto load_key = [g](std::size_t i) { return std::format("load_{}_{}", g, i); };
+        const auto patch_key = std::format("patch_{}", g);
+
+        // Patch task, end of the chain
+        std::string patch = std::format("[metadata]\nscript_version = \"1.0.0\"\ntotal_instructions = {}\n\n"
+                                        "readFromContext = \"{}\"\n\n", spec.instructions_per_patch, region_name(g));
+        for (std::size_t i = 0; i < spec.instructions_per_patch; ++i, ++instruction) {
+            patch += std::format("[instructions.0x{:08X}]\nbytes = \"8D 86 XX XX XX XX\"\noffset = \"0x{:X}\"\n\n",
+                                 kFirstInstruction + instruction * 8, (i * 4) % 0x1000);
+        }
+        write_file(tasks_dir / (patch_key + ".toml"), patch);
+        tasks += std::format("[tasks.{0}]\nname = \"Patch {1}\"\ntype = \"patch\"\n"
+                             "config_file = \"tasks/{0}.toml\"\nenabled = true\n\n", patch_key, g);
+
+        // Chain of loads, each followed by the next
+        for (std::size_t i = spec.chain_depth; i-- > 0;) {
+            const auto binary = binaries_dir / (load_key(i) + ".bin");
+            write_file(binary, std::string(spec.binary_size, static_cast<char>(i)));
+            write_file(tasks_dir / (load_key(i) + ".toml"),
+                       std::format("[load.DATA_{}_{}]\nbinary = \"{}\"\noffsetSecurity = \"0x{:X}\"\n"
+                                   "readFromContext = \"{}\"\n", g, i, binary.generic_string(),
+                                   i * spec.binary_size, region_name(g)));
+            const auto next = i + 1 < spec.chain_depth ? load_key(i + 1) : patch_key;
+            tasks += std::format("[tasks.{0}]\nname = \"Load {1}.{2}\"\ntype = \"load\"\n"
+                                 "config_file = \"tasks/{0}.toml\"\nfollowBy = [\"{3}\"]\nenabled = true\n\n",
+                                 load_key(i), g, i, next);
+        }
+
+        // Memory task at the head of the group, one hook per region
+        std::string memory;
+        for (std::size_t r = 0; r < spec.regions_per_memory; ++r, ++hook) {
+            memory += std::format("[memory.REGION_{4}_{0}]\naddress = \"0x{1:08X}\"\noriginalSize = 256\n"
+                                  "newSize = {2}\ncopyAfter = \"0x{3:08X}\"\n"
+                                  "writeInContext = {{ enabled = true, name = \"modpack.group{4}.region{0}\" }}\n\n",
+                                  r, 0x01000000 + hook * 0x1000, 256 + spec.chain_depth * spec.binary_size,
+                                  kFirstHook + hook * 16, g);
+        }
+        write_file(tasks_dir / (memory_key + ".toml"), memory);
+        const auto first = spec.chain_depth != 0 ? load_key(0) : patch_key;
+        tasks += std::format("[tasks.{0}]\nname = \"Memory {1}\"\ntype = \"memory\"\n"
+                             "config_file = \"tasks/{0}.toml\"\nfollowBy = [\"{2}\"]\nenabled = true\n\n",
+                             memory_key, g, first);
+    }
+    write_file(layout.tasks_path, tasks);
+
+    layout.tasks = spec.groups() * spec.group_size();
+    layout.hooks = hook;
+    layout.instructions = instruction;
+    // Every config becomes one task; followers join the hook of their parent's last region
+    layout.task_objects = spec.groups() * (spec.regions_per_memory + spec.chain_depth + 1);
+    return layout;
+}
+
+} // namespace app_hook::test
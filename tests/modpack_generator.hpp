@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+namespace app_hook::test {
+
+/// @brief Shape of a generated modpack
+///
+/// Tasks come in groups: a memory task copying regions_per_memory regions,
+/// followed by a chain of chain_depth load tasks reading its first region,
+/// the last of which is followed by a patch task of instructions_per_patch
+/// instructions. Groups are declared in reverse order, so the task graph has
+/// to reorder every followBy edge.
+struct ModpackSpec {
+    std::size_t tasks = 10;                   ///< Total number of tasks (rounded up to whole groups)
+    std::size_t chain_depth = 2;              ///< Load tasks between a memory task and its patch task
+    std::size_t regions_per_memory = 4;       ///< Regions (hooks) per memory task
+    std::size_t instructions_per_patch = 64;  ///< Instructions per patch task
+    std::size_t binary_size = 256;            ///< Size of each generated binary
+
+    /// @brief Get the number of tasks in one group
+    [[nodiscard]] std::size_t group_size() const noexcept { return chain_depth + 2; }
+
+    /// @brief Get the number of groups generated
+    [[nodiscard]] std::size_t groups() const noexcept { return (tasks + group_size() - 1) / group_size(); }
+};
+
+/// @brief What a generated modpack contains
+struct ModpackLayout {
+    std::filesystem::path tasks_path;   ///< Generated tasks.toml
+    std::size_t tasks = 0;              ///< Tasks declared
+    std::size_t hooks = 0;              ///< Distinct hook addresses (one per region)
+    std::size_t task_objects = 0;       ///< Tasks the factory creates (one per config)
+    std::size_t instructions = 0;       ///< Patch instructions across all patch files
+};
+
+/// @brief Write a tasks.toml and its config files and binaries
+/// @param directory Directory to generate into (created; existing files are overwritten)
+/// @param spec Shape of the modpack
+/// @return Layout of what was written
+ModpackLayout generate_modpack(const std::filesystem::path& directory, const ModpackSpec& spec);
+
+} // namespace app_hook::test
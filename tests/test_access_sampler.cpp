@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/access_sampler.hpp"
+#include <windows.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <sstream>
+
+using namespace app_hook::memory;
+
+namespace {
+
+/// @brief Read a byte the way unpatched game code would
+__declspec(noinline) std::uint8_t read_byte(const volatile std::uint8_t* address) {
+    return *address;
+}
+
+} // namespace
+
+class AccessSamplerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        page_ = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        ASSERT_NE(page_, nullptr);
+        std::memset(page_, 0x11, 4096);
+    }
+
+    void TearDown() override {
+        sampler_.stop(true);
+        VirtualFree(page_, 0, MEM_RELEASE);
+    }
+
+    /// @brief An address in the test executable's code, where samples are kept
+    static std::uintptr_t code_address() {
+        return reinterpret_cast<std::uintptr_t>(&read_byte);
+    }
+
+    std::uint8_t* page_ = nullptr;
+    // Re-arming is left to the tests
+    AccessSampler sampler_{std::chrono::hours{1}};
+};
+
+TEST_F(AccessSamplerTest, GuardFaultIsRecordedAndExecutionContinues) {
+    ASSERT_TRUE(sampler_.watch("K_MAGIC", reinterpret_cast<std::uintptr_t>(page_ + 256), 512));
+    EXPECT_TRUE(sampler_.active());
+    
+    // The first access faults, is sampled and still reads the byte
+    EXPECT_EQ(read_byte(page_ + 300), 0x11);
+    EXPECT_EQ(read_byte(page_ + 301), 0x11);
+    
+    const auto sites = sampler_.sites();
+    ASSERT_EQ(sites.size(), 1u);
+    EXPECT_EQ(sites[0].region, "K_MAGIC");
+    EXPECT_EQ(sites[0].offset, 44u);
+    EXPECT_EQ(sites[0].hits, 1u);
+    EXPECT_EQ(sites[0].region_begin, reinterpret_cast<std::uintptr_t>(page_ + 256));
+    EXPECT_EQ(sites[0].region_size, 512u);
+    EXPECT_GT(sites[0].code_size, 0u);
+}
+
+TEST_F(AccessSamplerTest, SitesAreDeduplicatedByInstruction) {
+    const auto base = reinterpret_cast<std::uintptr_t>(page_);
+    ASSERT_TRUE(sampler_.watch("table", base + 64, 128));
+    
+    EXPECT_TRUE(sampler_.on_guard_fault(code_address(), base + 64));
+    EXPECT_TRUE(sampler_.on_guard_fault(code_address(), base + 100));
+    EXPECT_TRUE(sampler_.on_guard_fault(code_address() + 4, base + 70));
+    
+    // Other data on the region's page is ours to let through, but not sampled
+    EXPECT_TRUE(sampler_.on_guard_fault(code_address(), base + 8));
+    // Other pages are not ours at all
+    EXPECT_FALSE(sampler_.on_guard_fault(code_address(), base + 8192));
+    
+    const auto sites = sampler_.sites();
+    ASSERT_EQ(sites.size(), 2u);
+    EXPECT_EQ(sites[0].instruction, code_address());
+    EXPECT_EQ(sites[0].hits, 2u);
+    EXPECT_EQ(sites[0].offset, 0u);
+    EXPECT_EQ(sites[1].hits, 1u);
+    EXPECT_EQ(sites[1].offset, 6u);
+}
+
+TEST_F(AccessSamplerTest, FullRingDropsSamples) {
+    const auto base = reinterpret_cast<std::uintptr_t>(page_);
+    ASSERT_TRUE(sampler_.watch("table", base, 16));
+    
+    for (std::uint32_t i = 0; i < AccessSampler::kRingSize + 10; ++i) {
+        sampler_.on_guard_fault(code_address(), base);
+    }
+    EXPECT_EQ(sampler_.dropped(), 10u);
+    
+    const auto sites = sampler_.sites();
+    ASSERT_EQ(sites.size(), 1u);
+    EXPECT_EQ(sites[0].hits, AccessSampler::kRingSize);
+}
+
+TEST_F(AccessSamplerTest, StopLiftsTheGuards) {
+    ASSERT_TRUE(sampler_.watch("table", reinterpret_cast<std::uintptr_t>(page_), 4096));
+    sampler_.stop(true);
+    EXPECT_FALSE(sampler_.active());
+    
+    MEMORY_BASIC_INFORMATION info{};
+    ASSERT_NE(VirtualQuery(page_, &info, sizeof(info)), 0u);
+    EXPECT_EQ(info.Protect & PAGE_GUARD, 0u);
+    EXPECT_EQ(read_byte(page_), 0x11);
+    EXPECT_TRUE(sampler_.sites().empty());
+}
+
+TEST_F(AccessSamplerTest, OnlyOneSamplerIsActive) {
+    ASSERT_TRUE(sampler_.watch("table", reinterpret_cast<std::uintptr_t>(page_), 16));
+    
+    AccessSampler other{std::chrono::hours{1}};
+    EXPECT_FALSE(other.watch("other", reinterpret_cast<std::uintptr_t>(page_ + 32), 16));
+    EXPECT_FALSE(sampler_.watch("unmapped", 0, 16));
+}
+
+TEST_F(AccessSamplerTest, PatchEntryRewritesAbsoluteAddress) {
+    AccessSite site;
+    site.instruction = 0x0048D774;
+    site.region_begin = 0x01CF4064;
+    site.region_size = 3420;
+    site.offset = 0x2A;
+    site.hits = 12;
+    site.region = "K_MAGIC";
+    const std::uint8_t code[] = {0x8D, 0x86, 0x8E, 0x40, 0xCF, 0x01, 0x90, 0x90};
+    std::memcpy(site.code.data(), code, sizeof(code));
+    site.code_size = sizeof(code);
+    
+    const auto entry = AccessSampler::patch_entry(site);
+    EXPECT_NE(entry.find("[instructions.0x0048D774]\n"), std::string::npos);
+    EXPECT_NE(entry.find("bytes = \"8D 86 XX XX XX XX\"\n"), std::string::npos);
+    EXPECT_NE(entry.find("offset = \"0x2A\"\n"), std::string::npos);
+    EXPECT_NE(entry.find("K_MAGIC: 12 sampled access(es)"), std::string::npos);
+}
+
+TEST_F(AccessSamplerTest, PatchEntryWithoutAddressIsCommentedOut) {
+    AccessSite site;
+    site.instruction = 0x0048D800;
+    site.region_begin = 0x01CF4064;
+    site.region_size = 3420;
+    site.region = "K_MAGIC";
+    const std::uint8_t code[] = {0x8B, 0x04, 0x8E, 0xC3};
+    std::memcpy(site.code.data(), code, sizeof(code));
+    site.code_size = sizeof(code);
+    
+    const auto entry = AccessSampler::patch_entry(site);
+    EXPECT_EQ(entry.find("\n[instructions."), std::string::npos);
+    EXPECT_NE(entry.find("# [instructions.0x0048D800]\n"), std::string::npos);
+    EXPECT_NE(entry.find("# code = \"8B 04 8E C3\""), std::string::npos);
+}
+
+TEST_F(AccessSamplerTest, ReportListsTheSites) {
+    const auto path = std::filesystem::temp_directory_path() / "access_sampler_test" / "unpatched_accesses.toml";
+    EXPECT_FALSE(sampler_.write_report(path));
+    
+    const auto base = reinterpret_cast<std::uintptr_t>(page_);
+    ASSERT_TRUE(sampler_.watch("table", base, 16));
+    sampler_.on_guard_fault(code_address(), base + 4);
+    ASSERT_TRUE(sampler_.write_report(path));
+    
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_NE(content.str().find(std::format("instructions.0x{:08X}", code_address())), std::string::npos);
+    std::filesystem::remove_all(path.parent_path());
+}
+
+TEST_F(AccessSamplerTest, TimerKeepsTheReportCurrent) {
+    const auto path = std::filesystem::temp_directory_path() / "access_sampler_timer" / "unpatched_accesses.toml";
+    std::filesystem::remove_all(path.parent_path());
+    
+    const auto base = reinterpret_cast<std::uintptr_t>(page_);
+    AccessSampler sampler{std::chrono::milliseconds{10}};
+    sampler.set_report_path(path);
+    ASSERT_TRUE(sampler.watch("table", base, 16));
+    sampler.on_guard_fault(code_address(), base + 4);
+    
+    // Written by the timer thread, with no stop() or shutdown
+    const auto expected = std::format("instructions.0x{:08X}", code_address());
+    auto read_report = [&path] {
+        std::ifstream file(path);
+        std::stringstream content;
+        content << file.rdbuf();
+        return content.str();
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (read_report().find(expected) == std::string::npos && std::chrono::steady_clock::now() < deadline) {
+        Sleep(10);
+    }
+    sampler.stop(true);
+    
+    EXPECT_NE(read_report().find(expected), std::string::npos);
+    std::filesystem::remove_all(path.parent_path());
+}
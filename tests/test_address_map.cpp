@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "config/address_map.hpp"
+#include "../memory_plugin/include/config/memory_config_loader.hpp"
+#include "mock_plugin_host.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace app_hook::config;
+using namespace testing;
+
+class AddressMapTest : public Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "address_map_test";
+        std::filesystem::create_directories(temp_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    std::filesystem::path create_test_file(const std::string& filename, const std::string& content) {
+        auto file_path = temp_dir_ / filename;
+        std::ofstream file(file_path, std::ios::binary);
+        file << content;
+        return file_path;
+    }
+
+    static constexpr app_hook::util::ModuleStamp kSteam{0x5203E1C3, 0x0021D6E4, 0x01D5C000};
+    std::filesystem::path temp_dir_;
+};
+
+TEST_F(AddressMapTest, ReadBuildAndSymbols) {
+    const auto path = create_test_file("steam.toml", R"(
+        [build]
+        name = "FF8 2013 EN"
+        timestamp = "0x5203E1C3"
+        checksum = 0x0021D6E4
+
+        [symbols]
+        K_MAGIC = "0x1CF3E48"
+        copy_site = 4885827
+    )");
+
+    auto map = AddressMap::read(path);
+    ASSERT_TRUE(map.has_value());
+    EXPECT_EQ(map->build(), "FF8 2013 EN");
+    EXPECT_EQ(map->size(), 2u);
+    EXPECT_EQ(map->find("K_MAGIC"), 0x1CF3E48u);
+    EXPECT_EQ(map->find("copy_site"), 0x4A8D43u);
+    EXPECT_EQ(map->find("unknown"), 0u);
+
+    // Unset fields of the build match any value
+    EXPECT_TRUE(map->matches(kSteam));
+    EXPECT_TRUE(map->matches({kSteam.timestamp, kSteam.checksum, 0x1000}));
+    EXPECT_FALSE(map->matches({kSteam.timestamp, 0x1234, kSteam.image_size}));
+    EXPECT_FALSE(map->matches({kSteam.timestamp + 1, kSteam.checksum, kSteam.image_size}));
+}
+
+TEST_F(AddressMapTest, RejectInvalidFiles) {
+    EXPECT_EQ(AddressMap::read(temp_dir_ / "missing.toml").error(), ConfigError::file_not_found);
+    EXPECT_EQ(AddressMap::read(create_test_file("broken.toml", "[build\n")).error(), ConfigError::parse_error);
+    EXPECT_EQ(AddressMap::read(create_test_file("no_build.toml", "[symbols]\nA = \"0x10\"\n")).error(),
+              ConfigError::missing_required_field);
+    EXPECT_EQ(AddressMap::read(create_test_file("bad_symbol.toml",
+                                                "[build]\ntimestamp = 1\n[symbols]\nA = \"zz\"\n")).error(),
+              ConfigError::invalid_format);
+}
+
+TEST_F(AddressMapTest, SelectTheMatchingBuild) {
+    create_test_file("a_retail.toml", "[build]\ntimestamp = \"0x4A000000\"\n[symbols]\nsite = \"0x401000\"\n");
+    create_test_file("b_steam.toml", R"(
+        [build]
+        timestamp = "0x5203E1C3"
+        imageSize = "0x1D5C000"
+        [symbols]
+        site = "0x4A8D43"
+    )");
+    create_test_file("notes.txt", "not a map");
+
+    auto map = AddressMap::select(temp_dir_, kSteam);
+    ASSERT_TRUE(map.has_value());
+    EXPECT_EQ(map->build(), "b_steam");
+    EXPECT_EQ(map->find("site"), 0x4A8D43u);
+
+    EXPECT_FALSE(AddressMap::select(temp_dir_, {0x11111111, 0, 0}).has_value());
+    EXPECT_FALSE(AddressMap::select(temp_dir_ / "missing", kSteam).has_value());
+}
+
+TEST_F(AddressMapTest, FingerprintFollowsEdits) {
+    EXPECT_EQ(AddressMap::fingerprint(temp_dir_), 0u);
+
+    create_test_file("steam.toml", "[build]\ntimestamp = 1\n");
+    const auto first = AddressMap::fingerprint(temp_dir_);
+    EXPECT_NE(first, 0u);
+    EXPECT_EQ(AddressMap::fingerprint(temp_dir_), first);
+
+    create_test_file("steam.toml", "[build]\ntimestamp = 1\n[symbols]\nsite = \"0x401000\"\n");
+    EXPECT_NE(AddressMap::fingerprint(temp_dir_), first);
+}
+
+TEST_F(AddressMapTest, MemoryLoaderPrefersSymbolsOverPatterns) {
+    MockPluginHost host;
+    ON_CALL(host, resolve_symbol("copy_site")).WillByDefault(Return(0x4A8D43));
+    ON_CALL(host, resolve_signatures(_)).WillByDefault([](const std::vector<std::string>& patterns) {
+        return std::vector<std::uintptr_t>(patterns.size(), 0x402000);
+    });
+
+    const auto path = create_test_file("memory.toml", R"(
+        [memory.K_MAGIC]
+        address = "0x1CF3E48"
+        addressSymbol = "K_MAGIC"
+        originalSize = 16
+        newSize = 32
+        copyAfterSymbol = "copy_site"
+        copyAfterPattern = "8B 0D ?? ?? ?? ??"
+    )");
+
+    // The mapped symbol queues no pattern; the unmapped one falls back to the literal
+    EXPECT_CALL(host, resolve_signatures(_)).Times(0);
+    memory_plugin::MemoryConfigLoader loader;
+    loader.setHost(&host);
+    auto result = loader.load_configs(ConfigType::Memory, path.string(), "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+
+    const auto* memory = static_cast<CopyMemoryConfig*>((*result)[0].get());
+    EXPECT_EQ(memory->address(), 0x1CF3E48u);
+    EXPECT_EQ(memory->copy_after(), 0x4A8D43u);
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "util/async_log_sink.hpp"
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/logger.h>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace app_hook::util {
+
+// Sink that records every payload it receives
+class CaptureSink : public spdlog::sinks::base_sink<std::mutex> {
+public:
+    std::vector<std::string> messages() {
+        std::lock_guard lock(mutex_);
+        return messages_;
+    }
+    
+    int flush_count() {
+        std::lock_guard lock(mutex_);
+        return flushes_;
+    }
+    
+protected:
+    void sink_it_(const spdlog::details::log_msg& msg) override {
+        messages_.emplace_back(msg.payload.data(), msg.payload.size());
+    }
+    
+    void flush_() override { ++flushes_; }
+    
+private:
+    std::vector<std::string> messages_;
+    int flushes_ = 0;
+};
+
+class AsyncLogSinkTest : public ::testing::Test {
+protected:
+    std::shared_ptr<CaptureSink> capture_ = std::make_shared<CaptureSink>();
+};
+
+TEST_F(AsyncLogSinkTest, CapacityIsRoundedToPowerOfTwo) {
+    AsyncLogSink sink("test", {capture_}, 100, LogOverflowPolicy::drop, std::chrono::milliseconds(10));
+    EXPECT_EQ(sink.capacity(), 128u);
+}
+
+TEST_F(AsyncLogSinkTest, DrainWritesRecordsInOrder) {
+    auto sink = std::make_shared<AsyncLogSink>("test", std::vector<spdlog::sink_ptr>{capture_}, 16,
+                                               LogOverflowPolicy::drop, std::chrono::milliseconds(10));
+    spdlog::logger logger("test", sink);
+    
+    logger.info("first");
+    logger.info("second");
+    logger.info(std::string(AsyncLogSink::kInlinePayload + 10, 'x'));
+    EXPECT_TRUE(capture_->messages().empty());
+    
+    EXPECT_EQ(sink->drain(), 3u);
+    auto messages = capture_->messages();
+    ASSERT_EQ(messages.size(), 3u);
+    EXPECT_EQ(messages[0], "first");
+    EXPECT_EQ(messages[1], "second");
+    EXPECT_EQ(messages[2].size(), AsyncLogSink::kInlinePayload + 10);
+    EXPECT_GE(capture_->flush_count(), 1);
+}
+
+TEST_F(AsyncLogSinkTest, DropPolicyCountsOverflow) {
+    auto sink = std::make_shared<AsyncLogSink>("test", std::vector<spdlog::sink_ptr>{capture_}, 4,
+                                               LogOverflowPolicy::drop, std::chrono::milliseconds(10));
+    spdlog::logger logger("test", sink);
+    
+    for (int i = 0; i < 10; ++i) {
+        logger.info("message {}", i);
+    }
+    
+    EXPECT_EQ(sink->dropped(), 6u);
+    EXPECT_EQ(sink->drain(), 4u);
+    EXPECT_EQ(capture_->messages().front(), "message 0");
+}
+
+TEST_F(AsyncLogSinkTest, AbandonWritesTheQueueWithoutTheWriter) {
+    auto sink = std::make_shared<AsyncLogSink>("test", std::vector<spdlog::sink_ptr>{capture_}, 16,
+                                               LogOverflowPolicy::drop, std::chrono::milliseconds(10));
+    spdlog::logger logger("test", sink);
+    
+    logger.info("before exit");
+    EXPECT_EQ(sink->abandon(), 1u);
+    EXPECT_GE(capture_->flush_count(), 1);
+    
+    // Records logged afterwards go out when the sink is stopped, which no longer waits
+    logger.info("after exit");
+    sink->stop();
+    auto messages = capture_->messages();
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[1], "after exit");
+}
+
+TEST_F(AsyncLogSinkTest, WriterThreadDeliversFromManyProducers) {
+    auto sink = std::make_shared<AsyncLogSink>("test", std::vector<spdlog::sink_ptr>{capture_}, 64,
+                                               LogOverflowPolicy::block, std::chrono::milliseconds(5));
+    spdlog::logger logger("test", sink);
+    sink->start();
+    
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < kPerThread; ++i) {
+                logger.info("thread {} message {}", t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    sink->stop();
+    EXPECT_EQ(sink->dropped(), 0u);
+    EXPECT_EQ(capture_->messages().size(), static_cast<std::size_t>(kThreads * kPerThread));
+}
+
+TEST_F(AsyncLogSinkTest, IdleWriterWakesForEachRecord) {
+    auto sink = std::make_shared<AsyncLogSink>("test", std::vector<spdlog::sink_ptr>{capture_}, 16,
+                                               LogOverflowPolicy::drop, std::chrono::hours(1));
+    spdlog::logger logger("test", sink);
+    sink->start();
+    
+    // Written and flushed by the writer alone, long before the flush interval
+    const auto delivered = [this](std::size_t count) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (capture_->messages().size() < count || capture_->flush_count() < static_cast<int>(count)) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    };
+    for (std::size_t i = 1; i <= 3; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));  // Let the writer block
+        logger.info("record {}", i);
+        EXPECT_TRUE(delivered(i)) << "record " << i;
+    }
+    
+    sink->stop();
+    EXPECT_EQ(capture_->messages().size(), 3u);
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/binary_preloader.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+using namespace app_hook::memory;
+
+class BinaryPreloaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "binary_preloader_test";
+        std::filesystem::create_directories(temp_dir_);
+        
+        binary_path_ = (temp_dir_ / "staged.bin").string();
+        std::ofstream file(binary_path_, std::ios::binary);
+        const std::uint8_t data[] = {0xDE, 0xAD, 0xBE, 0xEF, 0x01, 0x02, 0x03, 0x04};
+        file.write(reinterpret_cast<const char*>(data), sizeof(data));
+    }
+    
+    void TearDown() override {
+        preloader_.clear();
+        std::filesystem::remove_all(temp_dir_);
+    }
+    
+    // Wait until the background thread has settled every queued binary
+    void wait_for_staging(std::size_t expected) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (preloader_.staged_count() < expected && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    
+    BinaryPreloader preloader_;
+    std::filesystem::path temp_dir_;
+    std::string binary_path_;
+};
+
+TEST_F(BinaryPreloaderTest, UnknownPathIsNotStaged) {
+    EXPECT_EQ(preloader_.acquire(binary_path_), nullptr);
+    EXPECT_EQ(preloader_.staged_count(), 0u);
+}
+
+TEST_F(BinaryPreloaderTest, StagesFileContents) {
+    preloader_.preload(binary_path_);
+    wait_for_staging(1);
+    
+    auto staged = preloader_.acquire(binary_path_);
+    ASSERT_NE(staged, nullptr);
+    ASSERT_EQ(staged->size(), 8u);
+    EXPECT_EQ((*staged)[0], 0xDE);
+    EXPECT_EQ((*staged)[7], 0x04);
+    EXPECT_EQ(preloader_.staged_bytes(), 8u);
+    
+    // Staged data stays available for later triggers
+    EXPECT_EQ(preloader_.acquire(binary_path_), staged);
+}
+
+TEST_F(BinaryPreloaderTest, MissingFileFallsBackToCaller) {
+    const auto missing = (temp_dir_ / "missing.bin").string();
+    preloader_.preload(missing);
+    preloader_.preload(binary_path_);
+    wait_for_staging(1);
+    
+    EXPECT_EQ(preloader_.acquire(missing), nullptr);
+    EXPECT_EQ(preloader_.staged_count(), 1u);
+}
+
+TEST_F(BinaryPreloaderTest, InvalidateDropsStagedData) {
+    preloader_.preload(binary_path_);
+    wait_for_staging(1);
+    
+    preloader_.invalidate(binary_path_);
+    EXPECT_EQ(preloader_.acquire(binary_path_), nullptr);
+    EXPECT_EQ(preloader_.staged_count(), 0u);
+}
+
+TEST_F(BinaryPreloaderTest, ClearDropsEverything) {
+    preloader_.preload(binary_path_);
+    wait_for_staging(1);
+    
+    preloader_.clear();
+    EXPECT_EQ(preloader_.staged_count(), 0u);
+    
+    // The preloader can be used again afterwards
+    preloader_.preload(binary_path_);
+    wait_for_staging(1);
+    EXPECT_NE(preloader_.acquire(binary_path_), nullptr);
+}
+
+TEST_F(BinaryPreloaderTest, IdenticalBinariesAreStagedOnce) {
+    const auto copy_path = (temp_dir_ / "copy.bin").string();
+    std::filesystem::copy_file(binary_path_, copy_path);
+    preloader_.preload(binary_path_);
+    preloader_.preload(copy_path);
+    wait_for_staging(2);
+    
+    auto staged = preloader_.acquire(binary_path_);
+    ASSERT_NE(staged, nullptr);
+    EXPECT_EQ(preloader_.acquire(copy_path), staged);
+    EXPECT_EQ(preloader_.staged_count(), 2u);
+    EXPECT_EQ(preloader_.staged_bytes(), 8u);
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/blob_store.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace app_hook::memory;
+
+class BlobStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "blob_store_test";
+        std::filesystem::create_directories(temp_dir_ / "mod_a");
+        std::filesystem::create_directories(temp_dir_ / "mod_b");
+    }
+    
+    void TearDown() override {
+        std::filesystem::remove_all(temp_dir_);
+    }
+    
+    std::string write_file(const std::string& name, const std::vector<std::uint8_t>& bytes) {
+        const auto path = temp_dir_ / name;
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return path.string();
+    }
+    
+    BlobStore store_;
+    std::filesystem::path temp_dir_;
+    const std::vector<std::uint8_t> kernel_ = {0x10, 0x20, 0x30, 0x40, 0x50, 0x60};
+};
+
+TEST_F(BlobStoreTest, ReportsMissingAndEmptyFiles) {
+    EXPECT_EQ(store_.load((temp_dir_ / "missing.bin").string()).error(), app_hook::task::TaskError::file_not_found);
+    EXPECT_EQ(store_.load(write_file("empty.bin", {})).error(), app_hook::task::TaskError::file_read_error);
+}
+
+TEST_F(BlobStoreTest, SamePathIsReadOnce) {
+    const auto path = write_file("mod_a/kernel.bin", kernel_);
+    auto first = store_.load(path);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(**first, kernel_);
+    
+    // Another spelling of the same file is served without reading it
+    const auto alias = (temp_dir_ / "mod_b" / ".." / "mod_a" / "kernel.bin").string();
+    auto second = store_.load(alias);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->get(), first->get());
+    
+    const auto stats = store_.stats();
+    EXPECT_EQ(stats.file_hits, 1u);
+    EXPECT_EQ(stats.content_hits, 0u);
+    EXPECT_EQ(stats.blobs, 1u);
+    EXPECT_EQ(stats.bytes_shared, kernel_.size());
+}
+
+TEST_F(BlobStoreTest, IdenticalFilesShareOnePayload) {
+    auto first = store_.load(write_file("mod_a/kernel.bin", kernel_));
+    auto second = store_.load(write_file("mod_b/kernel_copy.bin", kernel_));
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->get(), first->get());
+    
+    // Same size, different bytes: kept apart
+    auto other = kernel_;
+    other.back() ^= 0xFF;
+    auto third = store_.load(write_file("mod_b/kernel_edit.bin", other));
+    ASSERT_TRUE(third.has_value());
+    EXPECT_NE(third->get(), first->get());
+    EXPECT_EQ(**third, other);
+    
+    const auto stats = store_.stats();
+    EXPECT_EQ(stats.content_hits, 1u);
+    EXPECT_EQ(stats.blobs, 2u);
+    EXPECT_EQ(stats.bytes, 2 * kernel_.size());
+}
+
+TEST_F(BlobStoreTest, PayloadsLiveAsLongAsTheirHolders) {
+    const auto path = write_file("mod_a/kernel.bin", kernel_);
+    {
+        auto held = store_.load(path);
+        ASSERT_TRUE(held.has_value());
+        EXPECT_EQ(store_.stats().blobs, 1u);
+    }
+    EXPECT_EQ(store_.stats().blobs, 0u);
+    
+    // Nobody held it, so the next load reads the file again
+    ASSERT_TRUE(store_.load(path).has_value());
+    EXPECT_EQ(store_.stats().file_hits, 0u);
+}
+
+TEST_F(BlobStoreTest, ChangedFileIsReadAgain) {
+    const auto path = write_file("mod_a/kernel.bin", kernel_);
+    auto before = store_.load(path);
+    ASSERT_TRUE(before.has_value());
+    
+    const std::vector<std::uint8_t> edited = {0x01, 0x02, 0x03};
+    write_file("mod_a/kernel.bin", edited);
+    auto after = store_.load(path);
+    ASSERT_TRUE(after.has_value());
+    EXPECT_EQ(**after, edited);
+    
+    // The earlier holder keeps the bytes it loaded
+    EXPECT_EQ(**before, kernel_);
+}
+
+TEST_F(BlobStoreTest, InvalidateForcesARead) {
+    const auto path = write_file("mod_a/kernel.bin", kernel_);
+    auto held = store_.load(path);
+    ASSERT_TRUE(held.has_value());
+    
+    store_.invalidate(path);
+    auto again = store_.load(path);
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(store_.stats().file_hits, 0u);
+    
+    // Same bytes, so the read still ends up sharing the payload
+    EXPECT_EQ(again->get(), held->get());
+    EXPECT_EQ(store_.stats().content_hits, 1u);
+}
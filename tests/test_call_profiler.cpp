@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include "hook/call_profiler.hpp"
+#include "config/config_base.hpp"
+#include <MinHook.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace app_hook::hook {
+
+namespace {
+
+__declspec(noinline) int timed_leaf(int value) {
+    if (value < 0) {
+        throw std::runtime_error("negative");
+    }
+    return value + 1;
+}
+
+__declspec(noinline) int timed_caller(int value) {
+    try {
+        return timed_leaf(value) * 2;
+    } catch (const std::runtime_error&) {
+        return 0;
+    }
+}
+
+} // namespace
+
+class CallProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "call_profiler_test";
+        std::filesystem::create_directories(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path create_test_file(const std::string& filename, const std::string& content) {
+        auto path = test_dir_ / filename;
+        std::ofstream file(path);
+        file << content;
+        return path;
+    }
+
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(CallProfilerTest, ProfileIsACoreConfigType) {
+    EXPECT_EQ(config::from_string("profile"), config::ConfigType::Profile);
+    EXPECT_EQ(config::to_string(config::ConfigType::Profile), "profile");
+    EXPECT_LT(config::to_index(config::ConfigType::Profile), config::kConfigTypeCount);
+}
+
+TEST_F(CallProfilerTest, ParsesIdaExportColumns) {
+    const auto text = "Address\tInstruction\n"
+                      "0x48D8A4\tlea     edx, K_MAGIC[eax]\r\n"
+                      "0x48D774\tlea     eax, K_MAGIC[esi]\n"
+                      "\n"
+                      "0x48D774\tduplicate\n";
+    EXPECT_EQ(CallProfiler::parse_ida_csv(text), (std::vector<std::uintptr_t>{0x48D774, 0x48D8A4}));
+
+    // Functions exports put the start address after the name
+    const auto functions = "Function name,Segment,Start,Length\n"
+                           "sub_401000,.text,00401000,0000002A\n"
+                           "\"battle_main\",.text,\"004A1000\",00000100\n";
+    EXPECT_EQ(CallProfiler::parse_ida_csv(functions, 2), (std::vector<std::uintptr_t>{0x401000, 0x4A1000}));
+    EXPECT_TRUE(CallProfiler::parse_ida_csv(functions, 7).empty());
+}
+
+TEST_F(CallProfilerTest, LoadsAddressesAndCsv) {
+    (void)create_test_file("functions.csv", "0x401000\tsub_401000\n0x402000\tsub_402000\n");
+    const auto path = create_test_file("profile.toml", R"(
+        [profile]
+        addresses = ["0x403000", 0x401000]
+        ida_csv = "functions.csv"
+        timing = true
+        report = "logs/battle_profile.toml"
+    )");
+
+    auto options = CallProfiler::load_options(path);
+    ASSERT_TRUE(options.has_value());
+    EXPECT_EQ(options->addresses, (std::vector<std::uintptr_t>{0x401000, 0x402000, 0x403000}));
+    EXPECT_TRUE(options->timing);
+    EXPECT_EQ(options->report_path, "logs/battle_profile.toml");
+
+    CallProfiler profiler;
+    profiler.add(*options);
+    EXPECT_EQ(profiler.probe_count(), 3u);
+    EXPECT_TRUE(profiler.timed());
+}
+
+TEST_F(CallProfilerTest, RejectsUnusableConfigs) {
+    auto result = CallProfiler::load_options(test_dir_ / "missing.toml");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), config::ConfigError::file_not_found);
+
+    result = CallProfiler::load_options(create_test_file("empty.toml", "[profile]\ntiming = true\n"));
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), config::ConfigError::missing_required_field);
+
+    result = CallProfiler::load_options(create_test_file("bad.toml", "[profile]\naddresses = [\"zzz\"]\n"));
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), config::ConfigError::invalid_format);
+
+    result = CallProfiler::load_options(create_test_file("no_csv.toml", "[profile]\nida_csv = \"none.csv\"\n"));
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), config::ConfigError::file_not_found);
+}
+
+TEST_F(CallProfilerTest, ReportSortsByCallsAndSharesTime) {
+    const std::vector<std::uintptr_t> addresses{0x401000, 0x402000, 0x403000};
+    std::vector<ProbeCounters> counters(3);
+    counters[0].calls = 10;
+    counters[0].ticks = 1'000;
+    counters[1].calls = 50'000;
+    counters[1].ticks = 500'000;
+    counters[2].calls = 10;
+
+    // 2 s at 1 MHz
+    const auto report = CallProfiler::make_report(addresses, counters, 2.0, 1'000'000.0);
+    ASSERT_EQ(report.entries.size(), 3u);
+    EXPECT_TRUE(report.timed);
+    EXPECT_EQ(report.entries[0].address, 0x402000u);
+    EXPECT_DOUBLE_EQ(report.entries[0].calls_per_second, 25'000.0);
+    EXPECT_DOUBLE_EQ(report.entries[0].time_share, 0.25);
+    EXPECT_EQ(report.entries[0].mean_ns, 10'000u);
+    EXPECT_EQ(report.entries[1].address, 0x401000u);
+    EXPECT_EQ(report.entries[2].address, 0x403000u);
+    EXPECT_EQ(report.entries[2].mean_ns, 0u);
+
+    const auto text = CallProfiler::format_report(report);
+    EXPECT_NE(text.find("address = \"0x00402000\""), std::string::npos);
+    EXPECT_LT(text.find("# Hot"), text.find("0x00401000"));
+    EXPECT_NE(text.find("time_share"), std::string::npos);
+
+    const auto counted = CallProfiler::make_report(addresses, counters, 2.0, 0.0);
+    EXPECT_FALSE(counted.timed);
+    EXPECT_EQ(CallProfiler::format_report(counted).find("time_share"), std::string::npos);
+}
+
+TEST_F(CallProfilerTest, StubsFitAnArenaSlot) {
+    EXPECT_LE(CallProfiler::probe_stub_code(false).size(), StubArena::kSlotSize);
+    EXPECT_LE(CallProfiler::probe_stub_code(true).size(), StubArena::kSlotSize);
+
+    // No dispatch: the count-only stub ends with its jump to the trampoline
+    const auto stub = CallProfiler::probe_stub_code(false);
+    EXPECT_EQ(stub[stub.size() - 5], 0xE9);
+}
+
+TEST_F(CallProfilerTest, ReadsCountersAcrossHalves) {
+    ProbeCounters counters;
+    counters.calls = 0x1'FFFF'FFFFull;
+    EXPECT_EQ(CallProfiler::read_counter(counters.calls), 0x1'FFFF'FFFFull);
+}
+
+TEST_F(CallProfilerTest, NothingToInstallWithoutAddresses) {
+    CallProfiler profiler;
+    EXPECT_EQ(profiler.install(), 0u);
+    EXPECT_TRUE(profiler.stop());
+    EXPECT_TRUE(profiler.report().entries.empty());
+}
+
+TEST_F(CallProfilerTest, ThrowingPastATimedCallKeepsReturnsIntact) {
+    const auto status = MH_Initialize();
+    ASSERT_TRUE(status == MH_OK || status == MH_ERROR_ALREADY_INITIALIZED);
+
+    ProfileOptions options;
+    options.addresses = {reinterpret_cast<std::uintptr_t>(&timed_leaf),
+                         reinterpret_cast<std::uintptr_t>(&timed_caller)};
+    options.timing = true;
+    options.report_path = (test_dir_ / "call_profile.toml").string();
+    CallProfiler profiler;
+    profiler.add(options);
+    ASSERT_EQ(profiler.install(), 2u);
+
+    // Called through volatile pointers so the calls stay real calls
+    int (*volatile leaf)(int) = &timed_leaf;
+    int (*volatile caller)(int) = &timed_caller;
+
+    // The exception leaves the leaf's frame above the caller's; the caller's
+    // return must drop it and go back here, not into the caller
+    EXPECT_EQ(caller(-1), 0);
+    EXPECT_EQ(caller(1), 4);
+
+    // Thrown out to the test: later timed calls and returns still pair up
+    EXPECT_THROW(leaf(-1), std::runtime_error);
+    EXPECT_EQ(leaf(1), 2);
+    EXPECT_EQ(caller(2), 6);
+
+    EXPECT_TRUE(profiler.stop());
+    const auto report = profiler.report();
+    ASSERT_EQ(report.entries.size(), 2u);
+    const auto entry = [&report](auto* function) {
+        const auto address = reinterpret_cast<std::uintptr_t>(function);
+        return *std::ranges::find(report.entries, address, &ProfileEntry::address);
+    };
+    EXPECT_EQ(entry(&timed_leaf).calls, 5u);
+    EXPECT_EQ(entry(&timed_caller).calls, 3u);
+
+    profiler.release();
+    if (status == MH_OK) {
+        MH_Uninitialize();
+    }
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/config/compiled_patch.hpp"
+
+using namespace app_hook::config;
+
+TEST(CompiledPatchSetTest, DecodesHexAndLocatesPlaceholder) {
+    CompiledPatchSet set;
+    ASSERT_TRUE(set.add_hex(0x401000, "8D 86 XX XX XX XX", 0x2A));
+    
+    ASSERT_EQ(set.size(), 1u);
+    const auto& instruction = set.instructions()[0];
+    EXPECT_EQ(instruction.address, 0x401000u);
+    EXPECT_EQ(instruction.length, 6u);
+    EXPECT_EQ(instruction.placeholder, 2u);
+    EXPECT_EQ(instruction.offset, 0x2A);
+    
+    const auto bytes = set.bytes(instruction);
+    EXPECT_EQ(bytes[0], 0x8D);
+    EXPECT_EQ(bytes[1], 0x86);
+}
+
+TEST(CompiledPatchSetTest, LiteralFFBytesAreNotPlaceholders) {
+    CompiledPatchSet set;
+    ASSERT_TRUE(set.add_hex(0x401000, "FF FF FF FF 8b 0d xx xx xx xx", 0));
+    
+    EXPECT_EQ(set.instructions()[0].placeholder, 6u);
+    EXPECT_EQ(set.bytes(set.instructions()[0])[3], 0xFF);
+}
+
+TEST(CompiledPatchSetTest, InstructionsShareOnePool) {
+    CompiledPatchSet set;
+    ASSERT_TRUE(set.add_hex(0x401000, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(set.add_hex(0x401010, "A1 XX XX XX XX", 4));
+    
+    EXPECT_EQ(set.pool().size(), 10u);
+    EXPECT_EQ(set.instructions()[1].pool_offset, 5u);
+    EXPECT_EQ(set.bytes(set.instructions()[1]).data(), set.pool().data() + 5);
+}
+
+TEST(CompiledPatchSetTest, RejectsInvalidText) {
+    CompiledPatchSet set;
+    EXPECT_FALSE(set.add_hex(0x401000, "8D 8G XX XX XX XX", 0));
+    EXPECT_FALSE(set.add_hex(0x401000, "8D 86 XX XX XX", 0));
+    EXPECT_FALSE(set.add_hex(0x401000, "8D 86 X", 0));
+    EXPECT_FALSE(set.add_hex(0, "B8 XX XX XX XX", 0));
+    
+    // Failed additions leave nothing behind
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.pool().empty());
+}
+
+TEST(CompiledPatchSetTest, CompilesStandalonePatches) {
+    std::vector<InstructionPatch> patches{
+        {0x402000, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 8},
+        {0x401000, {0x90, 0x90}, 0},
+    };
+    auto set = CompiledPatchSet::compile(patches);
+    
+    // The patch without a placeholder is dropped
+    ASSERT_EQ(set.size(), 1u);
+    EXPECT_EQ(set.instructions()[0].placeholder, 1u);
+    EXPECT_EQ(set.instructions()[0].offset, 8);
+}
+
+TEST(CompiledPatchSetTest, SortsByAddress) {
+    CompiledPatchSet set;
+    ASSERT_TRUE(set.add_hex(0x403000, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(set.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    set.sort_by_address();
+    
+    EXPECT_EQ(set.instructions()[0].address, 0x401000u);
+    EXPECT_EQ(set.bytes(set.instructions()[0])[0], 0xA1);
+}
+
+TEST(CompiledPatchSetTest, DiffKeepsOnlyChangedInstructions) {
+    CompiledPatchSet before;
+    ASSERT_TRUE(before.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(before.add_hex(0x402000, "B8 XX XX XX XX", 0x10));
+    ASSERT_TRUE(before.add_hex(0x403000, "8D 86 XX XX XX XX", 0));
+    
+    // Same first instruction, new offset for the second, new bytes for the third, one added
+    CompiledPatchSet after;
+    ASSERT_TRUE(after.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(after.add_hex(0x402000, "B8 XX XX XX XX", 0x20));
+    ASSERT_TRUE(after.add_hex(0x403000, "8D 8E XX XX XX XX", 0));
+    ASSERT_TRUE(after.add_hex(0x404000, "C7 05 XX XX XX XX", 0));
+    
+    const auto diff = CompiledPatchSet::diff(before, after);
+    ASSERT_EQ(diff.changed.size(), 3u);
+    EXPECT_EQ(diff.changed[0].address, 0x402000u);
+    EXPECT_EQ(diff.changed[0].offset, 0x20);
+    EXPECT_EQ(diff.changed[1].address, 0x403000u);
+    EXPECT_EQ(after.bytes(diff.changed[1])[1], 0x8E);
+    EXPECT_EQ(diff.changed[2].address, 0x404000u);
+    EXPECT_TRUE(diff.removed.empty());
+}
+
+TEST(CompiledPatchSetTest, DiffListsRemovedInstructions) {
+    CompiledPatchSet before;
+    ASSERT_TRUE(before.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(before.add_hex(0x402000, "B8 XX XX XX XX", 0));
+    
+    CompiledPatchSet after;
+    ASSERT_TRUE(after.add_hex(0x402000, "B8 XX XX XX XX", 0));
+    
+    const auto diff = CompiledPatchSet::diff(before, after);
+    EXPECT_TRUE(diff.changed.empty());
+    ASSERT_EQ(diff.removed.size(), 1u);
+    EXPECT_EQ(diff.removed[0].address, 0x401000u);
+    
+    const auto unchanged = CompiledPatchSet::diff(after, after);
+    EXPECT_TRUE(unchanged.changed.empty());
+    EXPECT_TRUE(unchanged.removed.empty());
+}
+
+TEST(CompiledPatchSetTest, DiffRestoresShortenedInstructions) {
+    CompiledPatchSet before;
+    ASSERT_TRUE(before.add_hex(0x401000, "C7 05 XX XX XX XX 01 00 00 00", 0));
+    ASSERT_TRUE(before.add_hex(0x402000, "A1 XX XX XX XX", 0));
+    
+    // Same address, fewer bytes: the old tail must go back to the original code
+    CompiledPatchSet after;
+    ASSERT_TRUE(after.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(after.add_hex(0x402000, "8D 86 XX XX XX XX", 0));
+    
+    const auto diff = CompiledPatchSet::diff(before, after);
+    ASSERT_EQ(diff.removed.size(), 1u);
+    EXPECT_EQ(diff.removed[0].address, 0x401000u);
+    EXPECT_EQ(diff.removed[0].length, 10u);
+    ASSERT_EQ(diff.changed.size(), 2u);
+    EXPECT_EQ(diff.changed[0].address, 0x401000u);
+    EXPECT_EQ(diff.changed[0].length, 5u);
+    
+    // A longer instruction only overwrites
+    EXPECT_EQ(diff.changed[1].address, 0x402000u);
+}
+
+TEST(CompiledPatchSetTest, CoalescesNeighboringInstructions) {
+    CompiledPatchSet patches;
+    ASSERT_TRUE(patches.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(patches.add_hex(0x401005, "B8 XX XX XX XX", 0));   // Touching
+    ASSERT_TRUE(patches.add_hex(0x401010, "A1 XX XX XX XX", 0));   // 6 bytes further
+    ASSERT_TRUE(patches.add_hex(0x401100, "B8 XX XX XX XX", 0));
+    
+    const auto touching = CompiledPatchSet::coalesce(patches.instructions(), 0);
+    ASSERT_EQ(touching.size(), 3u);
+    EXPECT_EQ(touching[0].address, 0x401000u);
+    EXPECT_EQ(touching[0].length, 10u);
+    EXPECT_EQ(touching[0].count, 2u);
+    EXPECT_EQ(touching[1].first, 2u);
+    
+    const auto near = CompiledPatchSet::coalesce(patches.instructions(), 16);
+    ASSERT_EQ(near.size(), 2u);
+    EXPECT_EQ(near[0].length, 0x15u);
+    EXPECT_EQ(near[0].count, 3u);
+    EXPECT_EQ(near[1].address, 0x401100u);
+    EXPECT_EQ(near[1].first, 3u);
+    EXPECT_EQ(near[1].count, 1u);
+    
+    EXPECT_TRUE(CompiledPatchSet::coalesce({}, 16).empty());
+}
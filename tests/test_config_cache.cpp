@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include "config/config_cache.hpp"
+#include "config/config_factory.hpp"
+#include "config/config_loader_base.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+namespace app_hook::config {
+
+// Loader counting how often it parses, with optional cache support
+class CountingLoader : public ConfigLoaderBase {
+public:
+    CountingLoader(int& parses, std::uint32_t version) : parses_(parses), version_(version) {}
+    
+    std::string get_name() const override { return "CountingLoader"; }
+    std::string get_version() const override { return "1.0.0"; }
+    std::vector<ConfigType> supported_types() const override { return {ConfigType::Script}; }
+    
+    ConfigResult<std::vector<ConfigPtr>> load_configs(
+        ConfigType type, const std::string& file_path, const std::string& task_name) override {
+        ++parses_;
+        std::ifstream file(file_path);
+        std::string description;
+        std::getline(file, description);
+        auto config = std::make_shared<ConfigBase>(type, task_name + "_script", task_name);
+        config->set_description(description);
+        return std::vector<ConfigPtr>{config};
+    }
+    
+    std::uint32_t cache_version() const override { return version_; }
+    
+    bool serialize_configs(const std::vector<ConfigPtr>& configs, util::ByteWriter& out) const override {
+        out.write(static_cast<std::uint32_t>(configs.size()));
+        for (const auto& config : configs) {
+            write_config_base(out, *config);
+        }
+        return true;
+    }
+    
+    ConfigResult<std::vector<ConfigPtr>> deserialize_configs(
+        ConfigType type, util::ByteReader& in, const std::string& task_name) override {
+        std::uint32_t count = 0;
+        in.read(count);
+        std::vector<ConfigPtr> configs;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::string key;
+            std::string name;
+            if (!read_config_identity(in, key, name)) {
+                return std::unexpected(ConfigError::invalid_format);
+            }
+            auto config = std::make_shared<ConfigBase>(type, key, name);
+            if (!read_config_fields(in, *config)) {
+                return std::unexpected(ConfigError::invalid_format);
+            }
+            configs.push_back(config);
+        }
+        return configs;
+    }
+    
+private:
+    int& parses_;
+    std::uint32_t version_;
+};
+
+class ConfigCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "config_cache_test";
+        std::filesystem::remove_all(temp_dir_);
+        std::filesystem::create_directories(temp_dir_);
+        
+        write_file("tasks.toml", R"(
+[tasks.script]
+name = "Script task"
+config_file = "script.toml"
+type = "script"
+followBy = ["other"]
+once = true
+execution = "eager"
+)");
+        write_file("script.toml", "first description");
+    }
+    
+    void TearDown() override {
+        (void)ConfigFactory::unregister_loader("CountingLoader");
+        std::filesystem::remove_all(temp_dir_);
+    }
+    
+    void register_loader(std::uint32_t version = 1) {
+        ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<CountingLoader>(parses_, version)));
+    }
+    
+    void write_file(const std::string& name, const std::string& content) {
+        std::ofstream file(temp_dir_ / name, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+    
+    std::string path(const std::string& name) const { return (temp_dir_ / name).string(); }
+    
+    // Load the script config through a fresh cache, then save it
+    std::string load_script(const std::string& task_name = "script_task") {
+        ConfigCache cache(temp_dir_);
+        auto configs = cache.load_configs(ConfigType::Script, path("script.toml"), task_name);
+        EXPECT_TRUE(configs.has_value());
+        EXPECT_TRUE(cache.save());
+        last_hits_ = cache.hits();
+        return configs && !configs->empty() ? (*configs)[0]->description() : std::string{};
+    }
+    
+    std::filesystem::path temp_dir_;
+    int parses_ = 0;
+    std::size_t last_hits_ = 0;
+};
+
+TEST_F(ConfigCacheTest, TasksServedFromCacheWhenUnchanged) {
+    {
+        ConfigCache cache(temp_dir_);
+        ASSERT_TRUE(cache.load_tasks(path("tasks.toml")).has_value());
+        EXPECT_EQ(cache.misses(), 1u);
+        EXPECT_TRUE(cache.save());
+    }
+    EXPECT_TRUE(std::filesystem::exists(temp_dir_ / ConfigCache::kFileName));
+    
+    ConfigCache cache(temp_dir_);
+    auto tasks = cache.load_tasks(path("tasks.toml"));
+    ASSERT_TRUE(tasks.has_value());
+    EXPECT_EQ(cache.hits(), 1u);
+    
+    ASSERT_EQ(tasks->size(), 1u);
+    const auto& task = (*tasks)[0];
+    EXPECT_EQ(task.name, "Script task");
+    EXPECT_EQ(task.config_file, "script.toml");
+    EXPECT_EQ(task.type, ConfigType::Script);
+    ASSERT_EQ(task.follow_by.size(), 1u);
+    EXPECT_EQ(task.follow_by[0], "other");
+    EXPECT_EQ(task.policy, TaskPolicy::until_success);
+    EXPECT_EQ(task.execution, TaskExecution::eager);
+}
+
+TEST_F(ConfigCacheTest, UnchangedConfigIsNotParsedAgain) {
+    register_loader();
+    
+    EXPECT_EQ(load_script(), "first description");
+    EXPECT_EQ(load_script(), "first description");
+    
+    EXPECT_EQ(parses_, 1);
+    EXPECT_EQ(last_hits_, 1u);
+}
+
+TEST_F(ConfigCacheTest, ModifiedConfigIsParsedAgain) {
+    register_loader();
+    load_script();
+    
+    write_file("script.toml", "second, longer description");
+    EXPECT_EQ(load_script(), "second, longer description");
+    EXPECT_EQ(parses_, 2);
+}
+
+TEST_F(ConfigCacheTest, TouchedButUnchangedConfigStaysCached) {
+    register_loader();
+    load_script();
+    
+    const auto file = temp_dir_ / "script.toml";
+    std::filesystem::last_write_time(file, std::filesystem::last_write_time(file) + std::chrono::hours(1));
+    
+    EXPECT_EQ(load_script(), "first description");
+    EXPECT_EQ(parses_, 1);
+}
+
+TEST_F(ConfigCacheTest, LoaderVersionChangeInvalidates) {
+    register_loader(1);
+    load_script();
+    
+    register_loader(2);
+    load_script();
+    EXPECT_EQ(parses_, 2);
+}
+
+TEST_F(ConfigCacheTest, RenamedTaskIsParsedAgain) {
+    register_loader();
+    load_script("script_task");
+    load_script("renamed_task");
+    EXPECT_EQ(parses_, 2);
+}
+
+TEST_F(ConfigCacheTest, LoaderWithoutCacheSupportIsAlwaysParsed) {
+    register_loader(0);
+    load_script();
+    load_script();
+    EXPECT_EQ(parses_, 2);
+}
+
+TEST_F(ConfigCacheTest, CorruptCacheIsIgnored) {
+    register_loader();
+    write_file(ConfigCache::kFileName, "not a cache file");
+    
+    EXPECT_EQ(load_script(), "first description");
+    EXPECT_EQ(load_script(), "first description");
+    EXPECT_EQ(parses_, 1);
+}
+
+} // namespace app_hook::config
@@ -3,6 +3,8 @@
 #include "config/config_factory.hpp"
 #include "config/config_base.hpp"
 #include "config/config_loader_base.hpp"
+#include "util/worker_pool.hpp"
+#include <atomic>
 
 namespace app_hook::config {
 
@@ -123,6 +125,47 @@ TEST_F(ConfigFactoryTest, RegisterMultipleLoaders) {
     EXPECT_TRUE(ConfigFactory::is_type_supported(ConfigType::Patch));
 }
 
+TEST_F(ConfigFactoryTest, NewestLoaderHandlesSharedType) {
+    ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<MockConfigLoader>("First", ConfigType::Patch)));
+    ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<MockConfigLoader>("Second", ConfigType::Patch)));
+    
+    ASSERT_NE(ConfigFactory::get_loader(ConfigType::Patch), nullptr);
+    EXPECT_EQ(ConfigFactory::get_loader(ConfigType::Patch)->get_name(), "Second");
+    
+    // Unregistering hands the type back to the remaining loader
+    EXPECT_TRUE(ConfigFactory::unregister_loader("Second"));
+    ASSERT_NE(ConfigFactory::get_loader(ConfigType::Patch), nullptr);
+    EXPECT_EQ(ConfigFactory::get_loader(ConfigType::Patch)->get_name(), "First");
+    
+    EXPECT_TRUE(ConfigFactory::unregister_loader("First"));
+    EXPECT_EQ(ConfigFactory::get_loader(ConfigType::Patch), nullptr);
+}
+
+TEST_F(ConfigFactoryTest, OutOfRangeTypeHasNoLoader) {
+    ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<MockConfigLoader>("Memory", ConfigType::Memory)));
+    EXPECT_FALSE(ConfigFactory::is_type_supported(static_cast<ConfigType>(kConfigTypeCount)));
+    EXPECT_FALSE(ConfigFactory::is_type_supported(static_cast<ConfigType>(0xFF)));
+}
+
+TEST_F(ConfigFactoryTest, ConcurrentLoadsShareTheRegistry) {
+    ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<MockConfigLoader>("Memory", ConfigType::Memory)));
+    ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<MockConfigLoader>("Patch", ConfigType::Patch)));
+    
+    std::atomic<int> loaded{0};
+    {
+        util::WorkerPool pool(4);
+        pool.for_each_index(64, [&loaded](std::size_t i) {
+            const auto type = i % 2 == 0 ? ConfigType::Memory : ConfigType::Patch;
+            if (ConfigFactory::load_configs(type, "test_config.toml", "task_" + std::to_string(i)) &&
+                ConfigFactory::is_type_supported(type)) {
+                ++loaded;
+            }
+        });
+    }
+    
+    EXPECT_EQ(loaded.load(), 64);
+}
+
 // Note: Additional tests would require actual config implementations
 // This provides basic structural testing of the ConfigFactory interface
 
@@ -3,7 +3,9 @@
 #include "memory/copy_memory.hpp"
 #include "mock_plugin_host.hpp"
 #include "context/mod_context.hpp"
+#include <cstring>
 #include <memory>
+#include <vector>
 
 // Need to read some config headers to create test configs
 namespace app_hook::memory {
@@ -433,4 +435,43 @@ TEST_F(CopyMemoryTest, MultipleExecutions) {
     EXPECT_TRUE(context.has_data(expanded_key));
 }
 
+TEST_F(CopyMemoryTest, RebasedCopyMovesPointersIntoOldTables) {
+    auto& context = app_hook::context::ModContext::instance();
+    
+    // A table of two entries pointing into itself and one into a sibling
+    std::vector<std::uint32_t> table(8, 0);
+    std::vector<std::uint32_t> sibling(4, 0);
+    const auto table_address = reinterpret_cast<std::uintptr_t>(table.data());
+    const auto sibling_address = reinterpret_cast<std::uintptr_t>(sibling.data());
+    table[0] = static_cast<std::uint32_t>(table_address + 16);
+    table[1] = static_cast<std::uint32_t>(sibling_address + 4);
+    table[2] = 1234;
+    context.store_data("rebase_sibling", MemoryRegion(32, sibling.size() * 4, sibling_address, "Sibling"));
+    
+    CopyMemoryConfig config("rebase_key", "rebase_table");
+    config.set_address(table_address);
+    config.set_copy_after(0x401000);
+    config.set_original_size(table.size() * 4);
+    config.set_new_size(64);
+    config.set_write_in_context({true, "rebase_table"});
+    config.set_rebase_self(true);
+    config.set_rebase_from({"rebase_sibling", "rebase_missing"});
+    CopyMemoryTask task(std::move(config));
+    task.setHost(mock_host_.get());
+    ASSERT_TRUE(task.execute().has_value());
+    
+    const auto* copied = context.get_data<MemoryRegion>("rebase_table");
+    const auto* moved_sibling = context.get_data<MemoryRegion>("rebase_sibling");
+    ASSERT_NE(copied, nullptr);
+    ASSERT_NE(moved_sibling, nullptr);
+    std::uint32_t entries[3] = {};
+    std::memcpy(entries, copied->base(), sizeof(entries));
+    EXPECT_EQ(entries[0], reinterpret_cast<std::uintptr_t>(copied->base()) + 16);
+    EXPECT_EQ(entries[1], reinterpret_cast<std::uintptr_t>(moved_sibling->base()) + 4);
+    EXPECT_EQ(entries[2], 1234u);
+    
+    // The source is untouched
+    EXPECT_EQ(table[0], table_address + 16);
+}
+
 } // namespace app_hook::memory 
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "util/crc32c.hpp"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace app_hook::util;
+
+namespace {
+
+std::span<const std::uint8_t> as_bytes(std::string_view text) {
+    return {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()};
+}
+
+} // namespace
+
+TEST(Crc32cTest, MatchesCheckValue) {
+    // Standard CRC-32C check value of "123456789"
+    EXPECT_EQ(crc32c(as_bytes("123456789")), 0xE3069283u);
+    EXPECT_EQ(crc32c_portable(as_bytes("123456789")), 0xE3069283u);
+    EXPECT_EQ(crc32c({}), 0u);
+}
+
+TEST(Crc32cTest, AcceleratedAndPortableAgreeOnEveryLength) {
+    std::vector<std::uint8_t> bytes(67);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i * 37 + 11);
+    }
+    // Cover the 8-byte, 4-byte and single-byte tails of both paths
+    for (std::size_t size = 0; size <= bytes.size(); ++size) {
+        const std::span range{bytes.data(), size};
+        EXPECT_EQ(crc32c(range), crc32c_portable(range)) << "size " << size;
+    }
+}
+
+TEST(Crc32cTest, RunningChecksumEqualsWholeChecksum) {
+    const auto bytes = as_bytes("The quick brown fox jumps over the lazy dog");
+    const auto whole = crc32c(bytes);
+    for (std::size_t split = 0; split <= bytes.size(); ++split) {
+        EXPECT_EQ(crc32c(bytes.subspan(split), crc32c(bytes.first(split))), whole) << "split " << split;
+    }
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "util/dag_executor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace app_hook::util {
+
+namespace {
+
+// Records the order nodes ran in
+class RunLog {
+public:
+    DagExecutor::Work node(std::string name, task::TaskResult result = {}) {
+        return [this, name = std::move(name), result] {
+            std::lock_guard lock(mutex_);
+            order_.push_back(name);
+            return result;
+        };
+    }
+
+    std::size_t position(const std::string& name) const {
+        return static_cast<std::size_t>(std::find(order_.begin(), order_.end(), name) - order_.begin());
+    }
+
+    const std::vector<std::string>& order() const { return order_; }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::string> order_;
+};
+
+} // namespace
+
+TEST(DagExecutorTest, EmptyGraph) {
+    DagExecutor executor;
+    EXPECT_TRUE(executor.run().empty());
+}
+
+TEST(DagExecutorTest, RunsParentsBeforeFollowers) {
+    // The magic branch and the text branch of the sample tasks.toml
+    RunLog log;
+    DagExecutor executor;
+    const auto copy_magic = executor.add("copy_magic", log.node("copy_magic"));
+    const auto load_magic = executor.add("load_magic", log.node("load_magic"));
+    const auto magic_patch = executor.add("magic_patch", log.node("magic_patch"));
+    const auto copy_text = executor.add("copy_text", log.node("copy_text"));
+    const auto text_patch = executor.add("text_patch", log.node("text_patch"));
+    executor.add_edge(copy_magic, load_magic);
+    executor.add_edge(copy_magic, magic_patch);
+    executor.add_edge(copy_text, text_patch);
+
+    const auto runs = executor.run(4);
+    ASSERT_EQ(runs.size(), 5u);
+    EXPECT_TRUE(std::ranges::all_of(runs, [](const DagRun& run) { return run.result.has_value() && !run.skipped; }));
+    EXPECT_EQ(runs[load_magic].name, "load_magic");
+
+    ASSERT_EQ(log.order().size(), 5u);
+    EXPECT_LT(log.position("copy_magic"), log.position("load_magic"));
+    EXPECT_LT(log.position("copy_magic"), log.position("magic_patch"));
+    EXPECT_LT(log.position("copy_text"), log.position("text_patch"));
+}
+
+TEST(DagExecutorTest, IndependentBranchesRunConcurrently) {
+    // Each root waits for the other to start: only a parallel run finishes both
+    std::atomic<int> started{0};
+    auto rendezvous = [&started]() -> task::TaskResult {
+        started.fetch_add(1);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (started.load() < 2) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return std::unexpected(task::TaskError::unknown_error);
+            }
+            std::this_thread::yield();
+        }
+        return {};
+    };
+
+    DagExecutor executor;
+    executor.add("a", rendezvous);
+    executor.add("b", rendezvous);
+
+    const auto runs = executor.run(2);
+    EXPECT_TRUE(runs[0].result.has_value());
+    EXPECT_TRUE(runs[1].result.has_value());
+}
+
+TEST(DagExecutorTest, FailureSkipsEveryDependent) {
+    RunLog log;
+    DagExecutor executor;
+    const auto root = executor.add("root", log.node("root", std::unexpected(task::TaskError::copy_failed)));
+    const auto child = executor.add("child", log.node("child"));
+    const auto grandchild = executor.add("grandchild", log.node("grandchild"));
+    const auto other = executor.add("other", log.node("other"));
+    executor.add_edge(root, child);
+    executor.add_edge(child, grandchild);
+    executor.add_edge(other, grandchild);
+
+    const auto runs = executor.run(2);
+    EXPECT_EQ(runs[root].result.error(), task::TaskError::copy_failed);
+    EXPECT_FALSE(runs[root].skipped);
+    EXPECT_TRUE(runs[child].skipped);
+    EXPECT_EQ(runs[child].result.error(), task::TaskError::dependency_not_met);
+    EXPECT_TRUE(runs[grandchild].skipped);
+    EXPECT_TRUE(runs[other].result.has_value());
+
+    EXPECT_EQ(log.order().size(), 2u);
+}
+
+TEST(DagExecutorTest, CycleIsSkippedAndTheRestRuns) {
+    RunLog log;
+    DagExecutor executor;
+    const auto a = executor.add("a", log.node("a"));
+    const auto b = executor.add("b", log.node("b"));
+    const auto behind = executor.add("behind", log.node("behind"));
+    const auto unrelated = executor.add("unrelated", log.node("unrelated"));
+    executor.add_edge(a, b);
+    executor.add_edge(b, a);
+    executor.add_edge(b, behind);
+
+    const auto runs = executor.run();
+    EXPECT_TRUE(runs[a].skipped);
+    EXPECT_TRUE(runs[b].skipped);
+    EXPECT_TRUE(runs[behind].skipped);
+    EXPECT_TRUE(runs[unrelated].result.has_value());
+    EXPECT_EQ(log.order(), std::vector<std::string>{"unrelated"});
+}
+
+TEST(DagExecutorTest, ReportsTimingAndExceptions) {
+    DagExecutor executor;
+    const auto slow = executor.add("slow", []() -> task::TaskResult {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return {};
+    });
+    const auto throwing = executor.add("throwing", []() -> task::TaskResult {
+        throw std::runtime_error("boom");
+    });
+
+    const auto runs = executor.run(1);
+    EXPECT_GE(runs[slow].elapsed, std::chrono::milliseconds(20));
+    EXPECT_EQ(runs[throwing].result.error(), task::TaskError::unknown_error);
+}
+
+TEST(DagExecutorTest, LongChainsAndWideFansComplete) {
+    std::atomic<int> ran{0};
+    DagExecutor executor;
+    const auto count_up = [&ran]() -> task::TaskResult {
+        ran.fetch_add(1);
+        return {};
+    };
+
+    // A 200-node chain next to a root fanning out to 800 leaves
+    DagExecutor::NodeId previous = executor.add("chain0", count_up);
+    for (int i = 1; i < 200; ++i) {
+        const auto next = executor.add("chain" + std::to_string(i), count_up);
+        executor.add_edge(previous, next);
+        previous = next;
+    }
+    const auto fan = executor.add("fan", count_up);
+    for (int i = 0; i < 800; ++i) {
+        executor.add_edge(fan, executor.add("leaf" + std::to_string(i), count_up));
+    }
+
+    const auto runs = executor.run(4);
+    EXPECT_EQ(ran.load(), 1001);
+    EXPECT_TRUE(std::ranges::all_of(runs, [](const DagRun& run) { return run.result.has_value(); }));
+}
+
+} // namespace app_hook::util
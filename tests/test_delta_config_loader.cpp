@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "../memory_plugin/include/config/delta_config_loader.hpp"
+#include "../memory_plugin/include/config/delta_config.hpp"
+#include "mock_plugin_host.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace memory_plugin;
+using namespace app_hook::config;
+using namespace testing;
+
+class DeltaConfigLoaderTest : public Test {
+protected:
+    void SetUp() override {
+        loader_ = std::make_unique<DeltaConfigLoader>();
+        mock_host_ = std::make_unique<MockPluginHost>();
+        loader_->setHost(mock_host_.get());
+        
+        temp_dir_ = std::filesystem::temp_directory_path() / "delta_loader_test";
+        std::filesystem::create_directories(temp_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    std::string create_test_file(const std::string& filename, const std::string& content) {
+        auto file_path = temp_dir_ / filename;
+        std::ofstream file(file_path);
+        file << content;
+        return file_path.string();
+    }
+
+    std::unique_ptr<DeltaConfigLoader> loader_;
+    std::unique_ptr<MockPluginHost> mock_host_;
+    std::filesystem::path temp_dir_;
+};
+
+TEST_F(DeltaConfigLoaderTest, SupportedTypes) {
+    EXPECT_EQ(loader_->supported_types(), std::vector<ConfigType>{ConfigType::Delta});
+    EXPECT_EQ(from_string("delta"), ConfigType::Delta);
+    EXPECT_EQ(to_string(ConfigType::Delta), "delta");
+}
+
+TEST_F(DeltaConfigLoaderTest, LoadEdits) {
+    const auto path = create_test_file("fire.toml", R"(
+        [delta.FIRE_POWER]
+        readFromContext = "ff8.magic.k_magic_data"
+        description = "Stronger Fire"
+        edits = [
+            { offset = "0x2A", bytes = "20 00" },
+            { offset = 100, bytes = "FF" },
+        ]
+    )");
+    
+    auto result = loader_->load_configs(ConfigType::Delta, path, "fire_mod");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+    
+    const auto* delta = static_cast<DeltaConfig*>((*result)[0].get());
+    EXPECT_EQ(delta->key(), "fire_mod_FIRE_POWER");
+    EXPECT_EQ(delta->read_from_context(), "ff8.magic.k_magic_data");
+    EXPECT_EQ(delta->description(), "Stronger Fire");
+    ASSERT_EQ(delta->edits().size(), 2);
+    EXPECT_EQ(delta->edits()[0].offset, 0x2Au);
+    EXPECT_THAT(delta->bytes(delta->edits()[0]), ElementsAre(0x20, 0x00));
+    EXPECT_EQ(delta->edits()[1].offset, 100u);
+    EXPECT_THAT(delta->bytes(delta->edits()[1]), ElementsAre(0xFF));
+    EXPECT_EQ(delta->extent(), 101u);
+    EXPECT_TRUE(delta->is_valid());
+}
+
+TEST_F(DeltaConfigLoaderTest, InvalidDeltasAreSkipped) {
+    const auto path = create_test_file("invalid.toml", R"(
+        [delta.no_region]
+        edits = [{ offset = "0x0", bytes = "01" }]
+        
+        [delta.no_edits]
+        readFromContext = "region"
+        edits = []
+        
+        [delta.bad_hex]
+        readFromContext = "region"
+        edits = [{ offset = "0x0", bytes = "0G" }]
+        
+        [delta.odd_hex]
+        readFromContext = "region"
+        edits = [{ offset = "0x0", bytes = "01 2" }]
+        
+        [delta.good]
+        readFromContext = "region"
+        edits = [{ offset = "0x0", bytes = "0102" }]
+    )");
+    
+    auto result = loader_->load_configs(ConfigType::Delta, path, "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+    EXPECT_EQ((*result)[0]->name(), "good");
+}
+
+TEST_F(DeltaConfigLoaderTest, CacheRoundTrip) {
+    const auto path = create_test_file("cached.toml", R"(
+        [delta.cached]
+        readFromContext = "region"
+        edits = [{ offset = "0x10", bytes = "AA BB CC" }, { offset = "0x40", bytes = "DD" }]
+    )");
+    
+    auto loaded = loader_->load_configs(ConfigType::Delta, path, "test_task");
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_NE(loader_->cache_version(), 0u);
+    
+    app_hook::util::ByteWriter out;
+    ASSERT_TRUE(loader_->serialize_configs(*loaded, out));
+    
+    app_hook::util::ByteReader in(out.data());
+    auto restored = loader_->deserialize_configs(ConfigType::Delta, in, "test_task");
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->size(), 1);
+    EXPECT_EQ(in.remaining(), 0u);
+    
+    const auto* original = static_cast<DeltaConfig*>((*loaded)[0].get());
+    const auto* delta = static_cast<DeltaConfig*>((*restored)[0].get());
+    EXPECT_EQ(delta->key(), original->key());
+    EXPECT_EQ(delta->read_from_context(), "region");
+    EXPECT_EQ(delta->edits(), original->edits());
+    EXPECT_EQ(delta->pool(), original->pool());
+    
+    // A truncated snapshot is rejected
+    const auto data = out.data();
+    app_hook::util::ByteReader truncated(data.first(data.size() - 1));
+    EXPECT_FALSE(loader_->deserialize_configs(ConfigType::Delta, truncated, "test_task").has_value());
+}
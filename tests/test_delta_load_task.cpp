@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/delta_load.hpp"
+#include "../memory_plugin/include/config/delta_config.hpp"
+#include "../memory_plugin/include/memory/memory_region.hpp"
+#include "mock_plugin_host.hpp"
+#include <cstring>
+
+using namespace app_hook::memory;
+using namespace app_hook::config;
+using namespace app_hook::task;
+
+class DeltaLoadTaskTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_host_ = std::make_unique<MockPluginHost>();
+        MemoryRegion region(64, 32, 0x401000, "Delta target");
+        std::memset(region.data.get(), 0x11, 64);
+        context().store_data(kRegion, std::move(region));
+    }
+    
+    void TearDown() override {
+        (void)context().remove_data(kRegion);
+    }
+    
+    static app_hook::context::ModContext& context() {
+        return app_hook::context::ModContext::instance();
+    }
+    
+    static std::uint8_t* target() {
+        return context().get_data<MemoryRegion>(kRegion)->data.get();
+    }
+    
+    static DeltaConfig make_delta(std::initializer_list<std::pair<std::uint32_t, std::vector<std::uint8_t>>> edits) {
+        DeltaConfig config("delta_key", "delta_name");
+        config.set_read_from_context(kRegion);
+        for (const auto& [offset, bytes] : edits) {
+            config.add_edit(offset, bytes);
+        }
+        return config;
+    }
+    
+    static constexpr const char* kRegion = "delta_target_region";
+    std::unique_ptr<MockPluginHost> mock_host_;
+};
+
+TEST_F(DeltaLoadTaskTest, AppliesEditsInPlace) {
+    DeltaLoadTask task(make_delta({{2, {0xAA, 0xBB}}, {40, {0xCC}}}));
+    task.setHost(mock_host_.get());
+    
+    ASSERT_TRUE(task.execute().has_value());
+    EXPECT_EQ(target()[1], 0x11);
+    EXPECT_EQ(target()[2], 0xAA);
+    EXPECT_EQ(target()[3], 0xBB);
+    EXPECT_EQ(target()[4], 0x11);
+    EXPECT_EQ(target()[40], 0xCC);
+    EXPECT_EQ(task.name(), "DeltaLoad");
+}
+
+TEST_F(DeltaLoadTaskTest, EditPastTheRegionWritesNothing) {
+    DeltaLoadTask task(make_delta({{0, {0xAA}}, {63, {0xBB, 0xCC}}}));
+    task.setHost(mock_host_.get());
+    
+    auto result = task.execute();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::invalid_address);
+    EXPECT_EQ(target()[0], 0x11);
+}
+
+TEST_F(DeltaLoadTaskTest, MissingRegionFails) {
+    DeltaConfig config("delta_key", "delta_name");
+    config.set_read_from_context("delta_missing_region");
+    config.add_edit(0, std::vector<std::uint8_t>{0xAA});
+    DeltaLoadTask task(std::move(config));
+    
+    auto result = task.execute();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::invalid_address);
+}
+
+TEST_F(DeltaLoadTaskTest, DeltasStackOnTheSameRegion) {
+    DeltaLoadTask first(make_delta({{8, {0x01, 0x02, 0x03}}}));
+    DeltaLoadTask second(make_delta({{9, {0x20}}}));
+    
+    ASSERT_TRUE(first.execute().has_value());
+    ASSERT_TRUE(second.execute().has_value());
+    EXPECT_EQ(target()[8], 0x01);
+    EXPECT_EQ(target()[9], 0x20);
+    EXPECT_EQ(target()[10], 0x03);
+}
+
+TEST_F(DeltaLoadTaskTest, ReloadRestoresDroppedEdits) {
+    const auto config = make_delta({{4, {0xAA}}, {12, {0xBB}}});
+    DeltaLoadTask task(config);
+    task.setHost(mock_host_.get());
+    EXPECT_EQ(task.reload(config), ReloadOutcome::unchanged);
+    ASSERT_TRUE(task.execute().has_value());
+    
+    // Running again on the same region keeps the bytes saved the first time
+    ASSERT_TRUE(task.execute().has_value());
+    
+    EXPECT_EQ(task.reload(make_delta({{12, {0xCC}}})), ReloadOutcome::updated);
+    EXPECT_EQ(target()[4], 0x11);
+    EXPECT_EQ(target()[12], 0xCC);
+    
+    // Another target region needs the hooks rebuilt
+    DeltaConfig moved("delta_key", "delta_name");
+    moved.set_read_from_context("delta_other_region");
+    moved.add_edit(0, std::vector<std::uint8_t>{0xAA});
+    EXPECT_EQ(task.reload(moved), ReloadOutcome::restart_required);
+}
@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+#include "hook/hook_manager.hpp"
+#include "context/mod_context.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace app_hook::hook {
+
+namespace {
+
+/// @brief Value whose fields must always agree; a torn or stale read breaks them
+struct StressValue {
+    std::uint64_t id;
+    std::uint64_t check;
+    std::vector<std::uint64_t> payload;
+
+    explicit StressValue(std::uint64_t value) : id(value), check(~value), payload(value % 16 + 1, value) {}
+
+    [[nodiscard]] bool consistent() const noexcept {
+        return check == ~id && payload.size() == id % 16 + 1 &&
+               std::ranges::all_of(payload, [this](std::uint64_t word) { return word == id; });
+    }
+};
+
+/// @brief Task counting its runs and reading a context value the way real tasks resolve their inputs
+class StressTask final : public task::IHookTask {
+public:
+    StressTask(context::ModContext& context, context::ContextKey input)
+        : context_(context), input_(input) {}
+
+    task::TaskResult execute() override {
+        runs.fetch_add(1, std::memory_order_relaxed);
+        const auto* value = context_.get<StressValue>(input_);
+        if (!value || !value->consistent()) {
+            bad_reads.fetch_add(1, std::memory_order_relaxed);
+            return std::unexpected(task::TaskError::dependency_not_met);
+        }
+        return {};
+    }
+
+    task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+
+    std::string name() const override { return "stress"; }
+    std::string description() const override { return "Stress task"; }
+
+    std::atomic<std::uint64_t> runs{0};
+    std::atomic<std::uint64_t> bad_reads{0};
+
+private:
+    context::ModContext& context_;
+    context::ContextKey input_;
+};
+
+/// @brief Iteration multiplier, raised through APP_HOOK_STRESS_SCALE for long soak runs
+std::size_t stress_scale() {
+    if (const char* scale = std::getenv("APP_HOOK_STRESS_SCALE")) {
+        return std::max<std::size_t>(1, std::strtoul(scale, nullptr, 10));
+    }
+    return 1;
+}
+
+/// @brief Get a percentile of sorted samples
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    const auto index = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1));
+    return sorted[index];
+}
+
+} // namespace
+
+class DispatchStressTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t kHooks = 8;
+    static constexpr std::size_t kTasksPerHook = 4;
+    static constexpr std::size_t kInputs = 64;
+
+    void SetUp() override {
+        dispatchers_ = std::max(4u, std::thread::hardware_concurrency());
+        calls_per_thread_ = 20000 * stress_scale();
+
+        // Inputs are published once before dispatch starts, like a memory task's region
+        for (std::size_t i = 0; i < kInputs; ++i) {
+            const auto key = context_.intern(std::format("stress.input.{}", i));
+            ASSERT_TRUE(key.valid());
+            ASSERT_TRUE(context_.store(key, StressValue{i}));
+            inputs_.push_back(key);
+        }
+
+        for (std::size_t h = 0; h < kHooks; ++h) {
+            hooks_.push_back(std::make_unique<Hook>(0x401000 + h * 0x100));
+            for (std::size_t t = 0; t < kTasksPerHook; ++t) {
+                auto task = std::make_unique<StressTask>(context_, inputs_[(h * kTasksPerHook + t) % kInputs]);
+                tasks_.push_back(task.get());
+                hooks_.back()->add_task(std::move(task));
+            }
+            hooks_.back()->set_trampoline(&trampoline_target_);
+        }
+    }
+
+    /// @brief Churn the context while dispatch runs: new keys, overwrites and removals
+    void ChurnContext(std::size_t writer, const std::atomic<bool>& stop, std::atomic<std::uint64_t>& bad_reads) {
+        const auto churn = context_.intern(std::format("stress.churn.{}", writer));
+        std::uint64_t round = 0;
+        while (!stop.load(std::memory_order_acquire)) {
+            // Overwritten and removed values are only probed, never dereferenced by other threads
+            context_.store(churn, StressValue{round});
+            if (round % 4 == 0) {
+                context_.remove(churn);
+            }
+
+            // Fresh keys stay put once stored, so any thread may read them
+            auto key = std::format("stress.fresh.{}.{}", writer, round % 1024);
+            if (!context_.has_data(key)) {
+                context_.store_data(key, StressValue{round % 1024});
+            }
+            const auto* fresh = context_.get_data<StressValue>(key);
+            if (!fresh || !fresh->consistent()) {
+                bad_reads.fetch_add(1, std::memory_order_relaxed);
+            }
+            const auto* input = context_.get_data<StressValue>(std::format("stress.input.{}", round % kInputs));
+            if (!input || !input->consistent() || input->id != round % kInputs) {
+                bad_reads.fetch_add(1, std::memory_order_relaxed);
+            }
+            ++round;
+        }
+    }
+
+    context::ModContext context_;
+    std::vector<context::ContextKey> inputs_;
+    std::vector<std::unique_ptr<Hook>> hooks_;
+    std::vector<StressTask*> tasks_;
+    int trampoline_target_ = 0;
+    unsigned dispatchers_ = 0;
+    std::size_t calls_per_thread_ = 0;
+};
+
+TEST_F(DispatchStressTest, ConcurrentDispatchRunsEveryTaskOnce) {
+    constexpr unsigned kWriters = 2;
+    constexpr std::size_t kSampleEvery = 16;
+
+    std::atomic<bool> start{false};
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> wrong_trampolines{0};
+    std::atomic<std::uint64_t> context_bad_reads{0};
+    std::vector<std::vector<double>> latencies(dispatchers_);
+
+    std::vector<std::thread> writers;
+    for (unsigned w = 0; w < kWriters; ++w) {
+        writers.emplace_back([&, w] { ChurnContext(w, stop, context_bad_reads); });
+    }
+
+    std::vector<std::thread> dispatchers;
+    for (unsigned d = 0; d < dispatchers_; ++d) {
+        dispatchers.emplace_back([&, d] {
+            auto& samples = latencies[d];
+            samples.reserve(calls_per_thread_ / kSampleEvery + 1);
+            while (!start.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            for (std::size_t i = 0; i < calls_per_thread_; ++i) {
+                // Threads walk the hooks from different offsets so every hook is hit concurrently
+                auto* hook = hooks_[(i + d) % kHooks].get();
+                if (i % kSampleEvery == 0) {
+                    const auto begin = std::chrono::steady_clock::now();
+                    void* trampoline = dispatch_hook(hook);
+                    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+                    samples.push_back(elapsed.count());
+                    if (trampoline != &trampoline_target_) {
+                        wrong_trampolines.fetch_add(1, std::memory_order_relaxed);
+                    }
+                } else if (dispatch_hook(hook) != &trampoline_target_) {
+                    wrong_trampolines.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    const auto begin = std::chrono::steady_clock::now();
+    start.store(true, std::memory_order_release);
+    for (auto& thread : dispatchers) {
+        thread.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+    stop.store(true, std::memory_order_release);
+    for (auto& thread : writers) {
+        thread.join();
+    }
+
+    // Every dispatch ran every task of its hook exactly once
+    const std::uint64_t total_calls = std::uint64_t{dispatchers_} * calls_per_thread_;
+    std::uint64_t task_runs = 0;
+    std::uint64_t task_bad_reads = 0;
+    for (const auto* task : tasks_) {
+        task_runs += task->runs.load();
+        task_bad_reads += task->bad_reads.load();
+    }
+    EXPECT_EQ(task_runs, total_calls * kTasksPerHook);
+    EXPECT_EQ(task_bad_reads, 0u);
+    EXPECT_EQ(context_bad_reads.load(), 0u);
+    EXPECT_EQ(wrong_trampolines.load(), 0u);
+
+    std::uint64_t recorded_calls = 0;
+    for (const auto& hook : hooks_) {
+        const auto stats = hook->stats();
+        recorded_calls += stats.timing.calls;
+        EXPECT_EQ(stats.timing.failures, 0u);
+        for (const auto& task : stats.tasks) {
+            EXPECT_EQ(task.timing.calls, stats.timing.calls);
+        }
+    }
+    EXPECT_EQ(recorded_calls, total_calls);
+
+    std::vector<double> merged;
+    for (const auto& samples : latencies) {
+        merged.insert(merged.end(), samples.begin(), samples.end());
+    }
+    std::ranges::sort(merged);
+    const double throughput = static_cast<double>(total_calls) / elapsed.count();
+    RecordProperty("dispatch_threads", std::to_string(dispatchers_));
+    RecordProperty("dispatch_calls_per_s", std::format("{:.0f}", throughput));
+    RecordProperty("dispatch_p50_ns", std::format("{:.0f}", percentile(merged, 0.5)));
+    RecordProperty("dispatch_p99_ns", std::format("{:.0f}", percentile(merged, 0.99)));
+    RecordProperty("dispatch_p999_ns", std::format("{:.0f}", percentile(merged, 0.999)));
+    std::cout << std::format("[ stress   ] {} dispatch threads, {} context writers: {:.2f} M calls/s, "
+                             "p50 {:.0f} ns, p99 {:.0f} ns, p99.9 {:.0f} ns, max {:.0f} ns\n",
+                             dispatchers_, kWriters, throughput / 1e6, percentile(merged, 0.5),
+                             percentile(merged, 0.99), percentile(merged, 0.999),
+                             merged.empty() ? 0.0 : merged.back());
+}
+
+TEST_F(DispatchStressTest, ContendedOnceHookRunsExactlyOnce) {
+    for (std::size_t round = 0; round < 50 * stress_scale(); ++round) {
+        Hook hook(0x402000);
+        auto task = std::make_unique<StressTask>(context_, inputs_[round % kInputs]);
+        auto* counted = task.get();
+        hook.add_task(std::move(task));
+        hook.set_trampoline(&trampoline_target_);
+        hook.set_policy(round % 2 ? TriggerPolicy::once : TriggerPolicy::until_success);
+
+        // No owner: the winning call retires the hook without scheduling its removal
+        std::atomic<bool> start{false};
+        std::vector<std::thread> threads;
+        for (unsigned d = 0; d < dispatchers_; ++d) {
+            threads.emplace_back([&] {
+                while (!start.load(std::memory_order_acquire)) {
+                    std::this_thread::yield();
+                }
+                for (int i = 0; i < 64; ++i) {
+                    EXPECT_EQ(dispatch_hook(&hook), &trampoline_target_);
+                }
+            });
+        }
+        start.store(true, std::memory_order_release);
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        ASSERT_EQ(counted->runs.load(), 1u) << "round " << round;
+        EXPECT_TRUE(hook.retired());
+        EXPECT_EQ(hook.stats().timing.calls, 1u);
+    }
+}
+
+TEST_F(DispatchStressTest, ManualRunsRaceWithDispatch) {
+    HookManager manager;
+    std::vector<StressTask*> managed;
+    for (std::size_t h = 0; h < kHooks; ++h) {
+        auto task = std::make_unique<StressTask>(context_, inputs_[h]);
+        managed.push_back(task.get());
+        ASSERT_TRUE(manager.add_task_to_hook(0x403000 + h * 0x100, std::move(task)).has_value());
+    }
+
+    // Test harnesses run hooks by hand while the game thread still dispatches them
+    constexpr std::size_t kManualRuns = 2000;
+    std::thread manual([&] {
+        for (std::size_t i = 0; i < kManualRuns; ++i) {
+            EXPECT_EQ(manager.execute_all_tasks_manually(), kHooks);
+        }
+    });
+    std::vector<std::thread> dispatchers;
+    for (unsigned d = 0; d < dispatchers_; ++d) {
+        dispatchers.emplace_back([&, d] {
+            for (std::size_t i = 0; i < calls_per_thread_ / 4; ++i) {
+                dispatch_hook(manager.get_hook(0x403000 + ((i + d) % kHooks) * 0x100));
+            }
+        });
+    }
+    manual.join();
+    for (auto& thread : dispatchers) {
+        thread.join();
+    }
+
+    std::uint64_t runs = 0;
+    for (const auto* task : managed) {
+        runs += task->runs.load();
+        EXPECT_EQ(task->bad_reads.load(), 0u);
+    }
+    EXPECT_EQ(runs, kManualRuns * kHooks + std::uint64_t{dispatchers_} * (calls_per_thread_ / 4));
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "hook/hook_manager.hpp"
+#include "hook/frame_scheduler.hpp"
+#include "config/task_loader.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace app_hook::hook {
+
+// Task counting its runs, optionally taking some time
+class SlowTask : public task::IHookTask {
+public:
+    SlowTask(int& counter, std::chrono::microseconds duration = {}) : counter_(counter), duration_(duration) {}
+
+    task::TaskResult execute() override {
+        ++counter_;
+        if (duration_.count() != 0) {
+            std::this_thread::sleep_for(duration_);
+        }
+        return {};
+    }
+
+    std::string name() const override { return "slow"; }
+    std::string description() const override { return "Slow task"; }
+
+private:
+    int& counter_;
+    std::chrono::microseconds duration_;
+};
+
+class FrameSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "frame_scheduler_test";
+        std::filesystem::create_directories(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path create_test_file(const std::string& filename, const std::string& content) {
+        auto path = test_dir_ / filename;
+        std::ofstream file(path);
+        file << content;
+        return path;
+    }
+
+    // Anchor the manager's scheduler at kAnchor
+    static Hook& add_anchor(HookManager& manager, std::uint32_t budget_us = 2'000) {
+        manager.frame_scheduler().configure({kAnchor, budget_us});
+        EXPECT_TRUE(manager.add_task_to_hook(kAnchor, std::make_unique<FrameAnchorTask>(manager.frame_scheduler()))
+                        .has_value());
+        return *manager.get_hook(kAnchor);
+    }
+
+    static constexpr std::uintptr_t kAnchor = 0x4F0000;
+    std::filesystem::path test_dir_;
+    int counter_ = 0;
+};
+
+TEST_F(FrameSchedulerTest, ParsesDeferredExecutionAndFrameType) {
+    EXPECT_EQ(config::execution_from_string("deferred"), config::TaskExecution::deferred);
+    EXPECT_EQ(config::from_string("frame"), config::ConfigType::Frame);
+    EXPECT_EQ(config::to_string(config::ConfigType::Frame), "frame");
+}
+
+TEST_F(FrameSchedulerTest, LoadsOptions) {
+    auto options = FrameScheduler::load_options(create_test_file("frame.toml", R"(
+        [frame]
+        anchor = "0x4F0000"
+        budget_us = 500
+    )"));
+    ASSERT_TRUE(options.has_value());
+    EXPECT_EQ(options->anchor, kAnchor);
+    EXPECT_EQ(options->budget_us, 500u);
+
+    auto missing = FrameScheduler::load_options(create_test_file("none.toml", "[frame]\nbudget_us = 500\n"));
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error(), config::ConfigError::missing_required_field);
+
+    auto invalid = FrameScheduler::load_options(create_test_file("bad.toml", "[frame]\nanchor = \"0x4F0000\"\nbudget_us = 0\n"));
+    ASSERT_FALSE(invalid.has_value());
+    EXPECT_EQ(invalid.error(), config::ConfigError::invalid_format);
+}
+
+TEST_F(FrameSchedulerTest, DeferredTasksWaitForTheAnchor) {
+    HookManager manager;
+    auto& anchor = add_anchor(manager);
+    int inline_counter = 0;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<SlowTask>(inline_counter)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<SlowTask>(counter_),
+                                         TaskDispatch::deferred).has_value());
+    auto* hook = manager.get_hook(0x401000);
+    EXPECT_EQ(hook->program().deferred_entries(), 1u);
+
+    // Triggers before the frame run the inline task only, and queue one job
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(hook->execute_tasks());
+    }
+    EXPECT_EQ(inline_counter, 3);
+    EXPECT_EQ(counter_, 0);
+    EXPECT_EQ(manager.frame_scheduler().pending(), 1u);
+
+    EXPECT_TRUE(anchor.execute_tasks());
+    EXPECT_EQ(counter_, 1);
+    EXPECT_EQ(manager.frame_scheduler().pending(), 0u);
+
+    const auto stats = manager.frame_scheduler().stats();
+    EXPECT_EQ(stats.frames, 1u);
+    EXPECT_EQ(stats.deferred_runs, 1u);
+    EXPECT_EQ(hook->stats().tasks[1].timing.calls, 1u);
+}
+
+TEST_F(FrameSchedulerTest, DrainStopsAtTheBudget) {
+    HookManager manager;
+    auto& anchor = add_anchor(manager, 1);
+    for (std::uintptr_t address : {0x401000u, 0x402000u, 0x403000u}) {
+        ASSERT_TRUE(manager.add_task_to_hook(address, std::make_unique<SlowTask>(counter_, std::chrono::microseconds(200)),
+                                             TaskDispatch::deferred).has_value());
+        EXPECT_TRUE(manager.get_hook(address)->execute_tasks());
+    }
+    ASSERT_EQ(manager.frame_scheduler().pending(), 3u);
+
+    // Every frame makes progress, one job at a time past the budget
+    for (int frame = 1; frame <= 3; ++frame) {
+        EXPECT_TRUE(anchor.execute_tasks());
+        EXPECT_EQ(counter_, frame);
+    }
+    EXPECT_EQ(manager.frame_scheduler().stats().over_budget, 3u);
+}
+
+TEST_F(FrameSchedulerTest, WithoutAnchorDeferredTasksRunInline) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<SlowTask>(counter_),
+                                         TaskDispatch::deferred).has_value());
+
+    EXPECT_TRUE(manager.get_hook(0x401000)->execute_tasks());
+    EXPECT_EQ(counter_, 1);
+    EXPECT_EQ(manager.frame_scheduler().pending(), 0u);
+}
+
+TEST_F(FrameSchedulerTest, ShutdownDropsQueuedJobs) {
+    HookManager manager;
+    (void)add_anchor(manager);
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<SlowTask>(counter_),
+                                         TaskDispatch::deferred).has_value());
+    EXPECT_TRUE(manager.get_hook(0x401000)->execute_tasks());
+
+    EXPECT_EQ(manager.frame_scheduler().shutdown(), 1u);
+    EXPECT_EQ(manager.frame_scheduler().pending(), 0u);
+    EXPECT_EQ(counter_, 0);
+}
+
+TEST_F(FrameSchedulerTest, AnchorRecordsFrameworkTimePerFrame) {
+    FrameScheduler scheduler;
+    scheduler.add_framework_time(1'000);
+    EXPECT_EQ(scheduler.stats().frames, 0u);
+
+    scheduler.configure({kAnchor, 2'000});
+    scheduler.add_framework_time(1'000);
+    scheduler.on_frame();
+    scheduler.on_frame();
+
+    const auto stats = scheduler.stats();
+    EXPECT_EQ(stats.frames, 2u);
+    EXPECT_GT(stats.framework.max_ns, 0u);
+    EXPECT_EQ(stats.framework.min_ns, 0u);
+    EXPECT_EQ(stats.deferred_runs, 0u);
+}
+
+} // namespace app_hook::hook
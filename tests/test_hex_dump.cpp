@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "util/hex_dump.hpp"
+#include <array>
+#include <format>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace app_hook::util {
+
+TEST(HexDumpTest, TableCoversEveryByte) {
+    for (int value = 0; value < 256; ++value) {
+        char digits[2];
+        encode_hex_byte(static_cast<std::uint8_t>(value), digits);
+        EXPECT_EQ(std::string(digits, 2), std::format("{:02X}", value));
+    }
+}
+
+TEST(HexDumpTest, FormatsSpacedBytes) {
+    const std::array<std::uint8_t, 4> bytes{0x8D, 0x86, 0x00, 0xFF};
+    EXPECT_EQ(std::format("{}", HexDump{bytes}), "8D 86 00 FF");
+    EXPECT_EQ(HexDump{bytes}.formatted_size(), 11u);
+}
+
+TEST(HexDumpTest, FormatsPrefixedBytesWithLineBreaks) {
+    std::vector<std::uint8_t> bytes(5);
+    std::iota(bytes.begin(), bytes.end(), std::uint8_t{0x10});
+    
+    EXPECT_EQ(std::format("{}", HexDump{bytes, HexStyle::prefixed, 2}), "0x10 0x11\n0x12 0x13\n0x14");
+    EXPECT_EQ(HexDump(bytes, HexStyle::prefixed, 2).formatted_size(), 24u);
+}
+
+TEST(HexDumpTest, EmptyDumpFormatsToNothing) {
+    EXPECT_EQ(std::format("[{}]", HexDump{{}}), "[]");
+    EXPECT_EQ(HexDump{{}}.formatted_size(), 0u);
+}
+
+TEST(HexDumpTest, LongDumpsCrossTheStackBuffer) {
+    std::vector<std::uint8_t> bytes(1000);
+    std::iota(bytes.begin(), bytes.end(), std::uint8_t{0});
+    const HexDump dump{bytes, HexStyle::prefixed, 16};
+    
+    const auto text = std::format("{}", dump);
+    ASSERT_EQ(text.size(), dump.formatted_size());
+    
+    std::string expected;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        if (i > 0) {
+            expected += i % 16 == 0 ? '\n' : ' ';
+        }
+        expected += std::format("0x{:02X}", bytes[i]);
+    }
+    EXPECT_EQ(text, expected);
+}
+
+TEST(HexDumpTest, FormatsIntoCallerBuffer) {
+    const std::array<std::uint8_t, 3> bytes{0xDE, 0xAD, 0x01};
+    std::array<char, 16> buffer{};
+    char* end = HexDump{bytes}.format_to(buffer.data());
+    EXPECT_EQ(std::string(buffer.data(), end), "DE AD 01");
+}
+
+} // namespace app_hook::util
@@ -677,4 +677,169 @@ size = 100
     EXPECT_GT(manager.hook_count(), 0);
 }
 
-} // namespace app_hook::hook 
\ No newline at end of file
+TEST_F(HookFactoryTest, CreateHooksFromTasks_OnceMarksHook) {
+    CreateTasksTomlFile(R"(
+[metadata]
+version = "1.0.0"
+
+[tasks.once_task]
+name = "Once Task"
+type = "memory"
+config_file = "tasks/once_config.toml"
+once = true
+enabled = true
+)");
+    
+    CreateTaskConfigFile("once_config.toml", R"(
+[memory.once_config]
+size = 100
+)");
+    
+    HookManager manager;
+    std::string tasks_path = (test_dir_ / "tasks.toml").string();
+    
+    auto result = HookFactory::create_hooks_from_tasks(tasks_path, manager);
+    
+    ASSERT_TRUE(result.has_value());
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    EXPECT_TRUE(hook->once());
+    EXPECT_EQ(hook->policy(), TriggerPolicy::until_success);
+}
+
+TEST_F(HookFactoryTest, CreateHooksFromTasks_PolicySetsHookTrigger) {
+    CreateTasksTomlFile(R"(
+[metadata]
+version = "1.0.0"
+
+[tasks.sampled_task]
+name = "Sampled Task"
+type = "memory"
+config_file = "tasks/sampled_config.toml"
+policy = "every_n"
+every_n = 100
+once = true
+enabled = true
+)");
+    
+    CreateTaskConfigFile("sampled_config.toml", R"(
+[memory.sampled_config]
+size = 100
+)");
+    
+    HookManager manager;
+    std::string tasks_path = (test_dir_ / "tasks.toml").string();
+    
+    auto result = HookFactory::create_hooks_from_tasks(tasks_path, manager);
+    
+    // policy takes precedence over once
+    ASSERT_TRUE(result.has_value());
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    EXPECT_EQ(hook->policy(), TriggerPolicy::every_n);
+    EXPECT_EQ(hook->gate().period(), 100u);
+    EXPECT_FALSE(hook->once());
+}
+
+TEST_F(HookFactoryTest, CreateHooksFromTasks_EagerTaskInstallsNoHook) {
+    CreateTasksTomlFile(R"(
+[metadata]
+version = "1.0.0"
+
+[tasks.eager_task]
+name = "Eager Task"
+type = "memory"
+config_file = "tasks/eager_config.toml"
+execution = "eager"
+enabled = true
+)");
+    
+    CreateTaskConfigFile("eager_config.toml", R"(
+[memory.eager_config]
+size = 100
+)");
+    
+    HookManager manager;
+    std::string tasks_path = (test_dir_ / "tasks.toml").string();
+    
+    auto result = HookFactory::create_hooks_from_tasks(tasks_path, manager);
+    
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(manager.hook_count(), 0u);
+    EXPECT_EQ(manager.get_hook(0x401000), nullptr);
+    
+    // The task is kept so uninstall can roll it back
+    EXPECT_EQ(manager.detached_task_count(), 1u);
+}
+
+TEST_F(HookFactoryTest, CreateHooksFromTasks_ProfileTaskAddsProbes) {
+    CreateTasksTomlFile(R"(
+[metadata]
+version = "1.0.0"
+
+[tasks.profile_task]
+name = "Profile Task"
+type = "profile"
+config_file = "tasks/profile_config.toml"
+enabled = true
+)");
+    
+    CreateTaskConfigFile("profile_config.toml", R"(
+[profile]
+addresses = ["0x401000", 0x402000]
+)");
+    
+    HookManager manager;
+    std::string tasks_path = (test_dir_ / "tasks.toml").string();
+    
+    auto result = HookFactory::create_hooks_from_tasks(tasks_path, manager);
+    
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(manager.hook_count(), 0u);
+    EXPECT_EQ(manager.profiler().probe_count(), 2u);
+}
+
+TEST_F(HookFactoryTest, CreateHooksFromTasks_FrameTaskAnchorsDeferredTasks) {
+    CreateTasksTomlFile(R"(
+[metadata]
+version = "1.0.0"
+
+[tasks.frame_task]
+name = "Frame Task"
+type = "frame"
+config_file = "tasks/frame_config.toml"
+enabled = true
+
+[tasks.deferred_task]
+name = "Deferred Task"
+type = "memory"
+config_file = "tasks/deferred_config.toml"
+execution = "deferred"
+enabled = true
+)");
+    
+    CreateTaskConfigFile("frame_config.toml", R"(
+[frame]
+anchor = "0x4F0000"
+budget_us = 1000
+)");
+    CreateTaskConfigFile("deferred_config.toml", R"(
+[memory.deferred_config]
+size = 100
+)");
+    
+    HookManager manager;
+    std::string tasks_path = (test_dir_ / "tasks.toml").string();
+    
+    auto result = HookFactory::create_hooks_from_tasks(tasks_path, manager);
+    
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(manager.frame_scheduler().active());
+    EXPECT_EQ(manager.frame_scheduler().budget_us(), 1000u);
+    ASSERT_NE(manager.get_hook(0x4F0000), nullptr);
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    EXPECT_EQ(hook->program().deferred_entries(), 1u);
+}
+
+} // namespace app_hook::hook
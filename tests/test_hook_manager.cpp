@@ -0,0 +1,756 @@
+#include <gtest/gtest.h>
+#include "hook/hook_manager.hpp"
+#include "config/task_loader.hpp"
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace app_hook::hook {
+
+// Task that fails a configurable number of times before succeeding
+class FlakyTask : public task::IHookTask {
+public:
+    FlakyTask(int failures, int& counter) : failures_(failures), counter_(counter) {}
+    
+    task::TaskResult execute() override {
+        ++counter_;
+        if (failures_-- > 0) {
+            return std::unexpected(task::TaskError::dependency_not_met);
+        }
+        return {};
+    }
+    
+    std::string name() const override { return "flaky"; }
+    std::string description() const override { return "Flaky task"; }
+    
+private:
+    int failures_;
+    int& counter_;
+};
+
+// Counting task used to observe dispatch
+class CountingTask : public task::IHookTask {
+public:
+    CountingTask(std::string name, int& counter) : name_(std::move(name)), counter_(counter) {}
+    
+    task::TaskResult execute() override {
+        ++counter_;
+        return {};
+    }
+    
+    std::string name() const override { return name_; }
+    std::string description() const override { return "Counting task: " + name_; }
+    
+private:
+    std::string name_;
+    int& counter_;
+};
+
+// Final task providing a direct (non-virtual) thunk
+class DirectTask final : public task::IHookTask {
+public:
+    explicit DirectTask(int& counter) : counter_(counter) {}
+    
+    task::TaskResult execute() override {
+        ++counter_;
+        return {};
+    }
+    
+    task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    
+    std::string name() const override { return "direct"; }
+    std::string description() const override { return "Direct task"; }
+    
+private:
+    int& counter_;
+};
+
+// Task recording when it is rolled back
+class RollbackTask : public task::IHookTask {
+public:
+    RollbackTask(std::string name, std::vector<std::string>& rolled_back)
+        : name_(std::move(name)), rolled_back_(rolled_back) {}
+    
+    task::TaskResult execute() override { return {}; }
+    void rollback() override { rolled_back_.push_back(name_); }
+    
+    std::string name() const override { return name_; }
+    std::string description() const override { return "Rollback task: " + name_; }
+    
+private:
+    std::string name_;
+    std::vector<std::string>& rolled_back_;
+};
+
+// Task that reads the registers of the hooked code
+class RegisterTask : public CountingTask {
+public:
+    using CountingTask::CountingTask;
+    using CountingTask::execute;
+    
+    bool needs_registers() const noexcept override { return true; }
+    
+    // Doubles EAX and records ECX
+    task::TaskResult execute(task::CpuContext& context) override {
+        seen_ecx = context.ecx;
+        context.eax *= 2;
+        return execute();
+    }
+    
+    std::uint32_t seen_ecx = 0;
+};
+
+// Final register task reached through a direct thunk
+class DirectRegisterTask final : public task::IHookTask {
+public:
+    task::TaskResult execute() override { return std::unexpected(task::TaskError::dependency_not_met); }
+    task::TaskResult execute(task::CpuContext& context) override {
+        context.edx = 0x1234;
+        return {};
+    }
+    task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    bool needs_registers() const noexcept override { return true; }
+    
+    std::string name() const override { return "direct_registers"; }
+    std::string description() const override { return "Direct register task"; }
+};
+
+// Task writing registers of the hooked code, callee-saved ones and EFLAGS included
+class ContextWritingTask final : public task::IHookTask {
+public:
+    task::TaskResult execute() override { return std::unexpected(task::TaskError::dependency_not_met); }
+    task::TaskResult execute(task::CpuContext& context) override {
+        seen_esp = context.esp;
+        context.eax = 0xA0A0A0A0;
+        context.ebx = 0xB0B0B0B0;
+        context.edi = 0xD0D0D0D0;
+        context.eflags &= ~0x1u;  // CF
+        return {};
+    }
+    bool needs_registers() const noexcept override { return true; }
+    
+    std::string name() const override { return "context_writer"; }
+    std::string description() const override { return "Context writing task"; }
+    
+    std::uint32_t seen_esp = 0;
+};
+
+// Task whose configuration shrinks when compacted
+class CompactingTask : public CountingTask {
+public:
+    using CountingTask::CountingTask;
+    
+    void compact() override { bytes_ = 16; }
+    std::size_t config_bytes() const noexcept override { return bytes_; }
+    
+private:
+    std::size_t bytes_ = 64;
+};
+
+namespace {
+
+// Local functions hooked through MinHook; they differ so the linker keeps both
+__declspec(noinline) int batch_target_a(int value) {
+    return value * 3 + 1;
+}
+
+__declspec(noinline) int batch_target_b(int value) {
+    return value * 5 - 2;
+}
+
+// Data, not code: MinHook refuses to hook it
+std::uint8_t not_code[16] = {};
+
+// Registers as seen by a hooked routine, or by its caller after the return
+struct Registers {
+    std::uint32_t eax = 0;
+    std::uint32_t ecx = 0;
+    std::uint32_t edx = 0;
+    std::uint32_t ebx = 0;
+    std::uint32_t esi = 0;
+    std::uint32_t edi = 0;
+    std::uint32_t ebp = 0;
+    std::uint32_t esp = 0;
+    std::uint32_t eflags = 0;
+};
+
+// CF, PF, AF, ZF, SF and OF: the flags the caller sets before the call
+constexpr std::uint32_t kArithmeticFlags = 0x8D5;
+
+// Values the caller loads before the call (esp is left alone)
+constexpr Registers kLoaded{0x11111111, 0x22222222, 0x33333333, 0x44444444,
+                            0x55555555, 0x66666666, 0x77777777, 0, kArithmeticFlags};
+
+// Machine code routine to hook, and a caller running it with known registers.
+// The routine stores its registers in seen and returns; the caller loads
+// kLoaded, calls it, stores its registers in after and restores its own.
+class StubHarness {
+public:
+    StubHarness() {
+        page_ = static_cast<std::uint8_t*>(
+            VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+        if (!page_) {
+            return;
+        }
+        
+        std::vector<std::uint8_t> code;
+        emit_store(code, seen);
+        code.push_back(0xC3);                                       // ret
+        std::memcpy(page_, code.data(), code.size());
+        
+        code.assign({0x60, 0x9C});                                  // pushad, pushfd
+        emit(code, {0x68}, kLoaded.eflags | 0x2);                   // push flags
+        code.push_back(0x9D);                                       // popfd
+        const std::pair<std::uint8_t, std::uint32_t> loads[] = {
+            {0xB8, kLoaded.eax}, {0xB9, kLoaded.ecx}, {0xBA, kLoaded.edx}, {0xBB, kLoaded.ebx},
+            {0xBE, kLoaded.esi}, {0xBF, kLoaded.edi}, {0xBD, kLoaded.ebp}};
+        for (const auto& [opcode, value] : loads) {
+            emit(code, {opcode}, value);                            // mov reg, imm32
+        }
+        const auto next = reinterpret_cast<std::uintptr_t>(page_) + kCallerOffset + code.size() + 5;
+        emit(code, {0xE8}, static_cast<std::uint32_t>(routine() - next));  // call routine
+        emit_store(code, after);
+        code.insert(code.end(), {0x9D, 0x61, 0xC3});                // popfd, popad, ret
+        std::memcpy(page_ + kCallerOffset, code.data(), code.size());
+        FlushInstructionCache(GetCurrentProcess(), page_, 4096);
+    }
+    
+    ~StubHarness() {
+        if (page_) {
+            VirtualFree(page_, 0, MEM_RELEASE);
+        }
+    }
+    
+    // Non-copyable, non-movable (the code holds the addresses of seen and after)
+    StubHarness(const StubHarness&) = delete;
+    StubHarness& operator=(const StubHarness&) = delete;
+    
+    [[nodiscard]] bool ready() const noexcept { return page_ != nullptr; }
+    [[nodiscard]] std::uintptr_t routine() const noexcept { return reinterpret_cast<std::uintptr_t>(page_); }
+    
+    void run() { reinterpret_cast<void (*)()>(page_ + kCallerOffset)(); }
+    
+    Registers seen;
+    Registers after;
+    
+private:
+    static constexpr std::size_t kCallerOffset = 128;
+    
+    static void emit(std::vector<std::uint8_t>& code, std::initializer_list<std::uint8_t> opcode,
+                     std::uint32_t operand) {
+        code.insert(code.end(), opcode);
+        const auto at = code.size();
+        code.resize(at + 4);
+        std::memcpy(code.data() + at, &operand, 4);
+    }
+    
+    static void emit_address(std::vector<std::uint8_t>& code, std::initializer_list<std::uint8_t> opcode,
+                             const std::uint32_t& field) {
+        emit(code, opcode, static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&field)));
+    }
+    
+    static void emit_store(std::vector<std::uint8_t>& code, Registers& registers) {
+        emit_address(code, {0xA3}, registers.eax);                  // mov [registers.eax], eax
+        emit_address(code, {0x89, 0x0D}, registers.ecx);            // mov [registers.ecx], ecx, and so on
+        emit_address(code, {0x89, 0x15}, registers.edx);
+        emit_address(code, {0x89, 0x1D}, registers.ebx);
+        emit_address(code, {0x89, 0x35}, registers.esi);
+        emit_address(code, {0x89, 0x3D}, registers.edi);
+        emit_address(code, {0x89, 0x2D}, registers.ebp);
+        emit_address(code, {0x89, 0x25}, registers.esp);
+        code.push_back(0x9C);                                       // pushfd
+        emit_address(code, {0x8F, 0x05}, registers.eflags);         // pop [eflags]
+    }
+    
+    std::uint8_t* page_ = nullptr;
+};
+
+// Bytes of the stub a hook runs, from its start
+std::vector<std::uint8_t> stub_bytes(const Hook& hook, std::size_t size) {
+    const auto* code = static_cast<const std::uint8_t*>(hook.handler());
+    return {code, code + size};
+}
+
+} // namespace
+
+class HookManagerTest : public ::testing::Test {
+protected:
+    /// @brief Get the number of hook stubs allocated in the shared arena
+    static std::size_t stub_slots(const HookManager& manager) {
+        for (const auto& usage : manager.memory_usage()) {
+            if (usage.category == "hook.stubs") {
+                return usage.count;
+            }
+        }
+        return 0;
+    }
+    
+    int counter_ = 0;
+};
+
+TEST_F(HookManagerTest, DispatchExecutesTasksAndReturnsTrampoline) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("first", counter_));
+    hook.add_task(std::make_unique<CountingTask>("second", counter_));
+    
+    int trampoline_target = 0;
+    hook.set_trampoline(&trampoline_target);
+    
+    EXPECT_EQ(dispatch_hook(&hook), &trampoline_target);
+    EXPECT_EQ(counter_, 2);
+    
+    EXPECT_EQ(dispatch_hook(&hook), &trampoline_target);
+    EXPECT_EQ(counter_, 4);
+}
+
+TEST_F(HookManagerTest, DispatchWithoutTasks) {
+    Hook hook(0x401000);
+    EXPECT_EQ(dispatch_hook(&hook), nullptr);
+    EXPECT_EQ(hook.handler(), nullptr);
+}
+
+TEST_F(HookManagerTest, AddTaskGroupsByAddress) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<CountingTask>("a", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<CountingTask>("b", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x402000, std::make_unique<CountingTask>("c", counter_)).has_value());
+    
+    EXPECT_EQ(manager.hook_count(), 2u);
+    EXPECT_EQ(manager.total_task_count(), 3u);
+    EXPECT_EQ(manager.execute_all_tasks_manually(), 3u);
+    EXPECT_EQ(counter_, 3);
+}
+
+TEST_F(HookManagerTest, OnceHookRunsTasksOnlyOnce) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<CountingTask>("once", counter_)).has_value());
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    hook->set_once(true);
+    
+    dispatch_hook(hook);
+    dispatch_hook(hook);
+    dispatch_hook(hook);
+    
+    EXPECT_EQ(counter_, 1);
+    EXPECT_TRUE(hook->retired());
+}
+
+TEST_F(HookManagerTest, OnceHookRetriesUntilTasksSucceed) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<FlakyTask>(2, counter_)).has_value());
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    hook->set_once(true);
+    
+    dispatch_hook(hook);
+    EXPECT_FALSE(hook->retired());
+    dispatch_hook(hook);
+    EXPECT_FALSE(hook->retired());
+    dispatch_hook(hook);
+    EXPECT_TRUE(hook->retired());
+    dispatch_hook(hook);
+    
+    EXPECT_EQ(counter_, 3);
+}
+
+TEST_F(HookManagerTest, OncePolicyRetiresEvenWhenTasksFail) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<FlakyTask>(2, counter_)).has_value());
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    hook->set_policy(TriggerPolicy::once);
+    
+    dispatch_hook(hook);
+    EXPECT_TRUE(hook->retired());
+    dispatch_hook(hook);
+    
+    EXPECT_EQ(counter_, 1);
+    EXPECT_EQ(hook->stats().timing.failures, 1u);
+}
+
+TEST_F(HookManagerTest, EveryNPolicySamplesCalls) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("sampled", counter_));
+    int trampoline_target = 0;
+    hook.set_trampoline(&trampoline_target);
+    hook.set_policy(TriggerPolicy::every_n, 3);
+    
+    // Calls 1, 4 and 7 run the task; every call resumes the original function
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(dispatch_hook(&hook), &trampoline_target);
+    }
+    EXPECT_EQ(counter_, 3);
+    EXPECT_EQ(hook.stats().timing.calls, 3u);
+    EXPECT_FALSE(hook.once());
+}
+
+TEST_F(HookManagerTest, EveryOnePolicyRunsEveryCall) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("every", counter_));
+    hook.set_policy(TriggerPolicy::every_n, 1);
+    
+    EXPECT_EQ(hook.policy(), TriggerPolicy::always);
+    dispatch_hook(&hook);
+    dispatch_hook(&hook);
+    EXPECT_EQ(counter_, 2);
+}
+
+TEST_F(HookManagerTest, ProgramKeepsTaskOrderAndNames) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("first", counter_));
+    hook.add_task(std::make_unique<DirectTask>(counter_));
+    hook.add_task(std::make_unique<CountingTask>("third", counter_));
+    
+    const auto& program = hook.program();
+    ASSERT_EQ(program.size(), 3u);
+    EXPECT_EQ(program.name(0), "first");
+    EXPECT_EQ(program.name(1), "direct");
+    EXPECT_EQ(program.name(2), "third");
+    
+    EXPECT_TRUE(hook.execute_tasks());
+    EXPECT_EQ(counter_, 3);
+}
+
+TEST_F(HookManagerTest, ProgramUsesDirectThunk) {
+    auto task = std::make_unique<DirectTask>(counter_);
+    auto* raw = task.get();
+    
+    Hook hook(0x401000);
+    hook.add_task(std::move(task));
+    
+    const auto entry = hook.program().entries()[0];
+    EXPECT_EQ(entry.state, raw);
+    EXPECT_TRUE(entry.fn(entry.state, nullptr).has_value());
+    EXPECT_EQ(counter_, 1);
+}
+
+TEST_F(HookManagerTest, EmptyProgram) {
+    Hook hook(0x401000);
+    EXPECT_TRUE(hook.program().empty());
+    EXPECT_TRUE(hook.execute_tasks());
+}
+
+TEST_F(HookManagerTest, WorkerTasksRunOffTheCallingThread) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<CountingTask>("inline", counter_)).has_value());
+    
+    int worker_counter = 0;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<CountingTask>("async", worker_counter),
+                                         TaskDispatch::worker).has_value());
+    
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    EXPECT_EQ(hook->program().worker_entries(), 1u);
+    
+    EXPECT_TRUE(hook->execute_tasks());
+    EXPECT_EQ(counter_, 1);
+    
+    manager.worker_pool().wait_idle();
+    EXPECT_EQ(worker_counter, 1);
+    
+    const auto stats = hook->stats();
+    ASSERT_EQ(stats.tasks.size(), 2u);
+    EXPECT_EQ(stats.tasks[1].name, "async");
+    EXPECT_EQ(stats.tasks[1].timing.calls, 1u);
+}
+
+TEST_F(HookManagerTest, WorkerTaskFailureIsRecordedInStats) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<FlakyTask>(1, counter_),
+                                         TaskDispatch::worker).has_value());
+    
+    auto* hook = manager.get_hook(0x401000);
+    EXPECT_TRUE(hook->execute_tasks());
+    manager.worker_pool().wait_idle();
+    
+    EXPECT_EQ(counter_, 1);
+    EXPECT_EQ(hook->stats().tasks[0].timing.failures, 1u);
+}
+
+TEST_F(HookManagerTest, WorkerTasksWithoutOwnerRunInline) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("async", counter_), TaskDispatch::worker);
+    
+    EXPECT_TRUE(hook.execute_tasks());
+    EXPECT_EQ(counter_, 1);
+}
+
+TEST_F(HookManagerTest, UninstallRollsBackTasksNewestFirst) {
+    std::vector<std::string> rolled_back;
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x402000, std::make_unique<RollbackTask>("a", rolled_back)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<RollbackTask>("b", rolled_back)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x402000, std::make_unique<RollbackTask>("c", rolled_back)).has_value());
+    
+    manager.uninstall_all();
+    EXPECT_EQ(rolled_back, (std::vector<std::string>{"b", "c", "a"}));
+    EXPECT_EQ(manager.hook_count(), 0u);
+    
+    // Nothing is rolled back twice
+    manager.uninstall_all();
+    EXPECT_EQ(rolled_back.size(), 3u);
+}
+
+TEST_F(HookManagerTest, UninstallRollsBackDetachedTasksAfterHooks) {
+    std::vector<std::string> rolled_back;
+    HookManager manager;
+    auto* first = manager.add_detached_task(std::make_unique<RollbackTask>("eager1", rolled_back));
+    manager.add_detached_task(std::make_unique<RollbackTask>("eager2", rolled_back));
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<RollbackTask>("hooked", rolled_back)).has_value());
+    EXPECT_EQ(first->name(), "eager1");
+    EXPECT_EQ(manager.detached_task_count(), 2u);
+
+    manager.uninstall_all();
+    EXPECT_EQ(rolled_back, (std::vector<std::string>{"hooked", "eager2", "eager1"}));
+    EXPECT_EQ(manager.detached_task_count(), 0u);
+}
+
+TEST_F(HookManagerTest, DisableForExitLeavesTasksAlone) {
+    std::vector<std::string> rolled_back;
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<RollbackTask>("a", rolled_back)).has_value());
+    
+    // Nothing was installed: no MinHook call, no rollback, the hooks stay
+    EXPECT_FALSE(manager.disable_for_exit());
+    EXPECT_TRUE(rolled_back.empty());
+    EXPECT_EQ(manager.hook_count(), 1u);
+}
+
+TEST_F(HookManagerTest, CompactReportsReleasedConfigBytes) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<CompactingTask>("a", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x402000, std::make_unique<CompactingTask>("b", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(0x402000, std::make_unique<CountingTask>("plain", counter_)).has_value());
+    
+    EXPECT_EQ(manager.compact(), 96u);
+    EXPECT_EQ(manager.get_hook(0x402000)->config_bytes(), 16u);
+    
+    // Compacted tasks still run; a second pass has nothing left to give back
+    EXPECT_TRUE(manager.get_hook(0x402000)->execute_tasks());
+    EXPECT_EQ(counter_, 1);
+    EXPECT_EQ(manager.compact(), 0u);
+}
+
+TEST_F(HookManagerTest, BatchedInstallHooksLocalFunctions) {
+    // Called through volatile pointers so the calls reach the patched code
+    int (*volatile target_a)(int) = &batch_target_a;
+    int (*volatile target_b)(int) = &batch_target_b;
+    
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(reinterpret_cast<std::uintptr_t>(&batch_target_a),
+                                         std::make_unique<CountingTask>("a", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(reinterpret_cast<std::uintptr_t>(&batch_target_b),
+                                         std::make_unique<CountingTask>("b", counter_)).has_value());
+    const auto slots = stub_slots(manager);
+    ASSERT_TRUE(manager.install_all(InstallMode::batched).has_value());
+    EXPECT_EQ(stub_slots(manager), slots + 2);
+    
+    // Tasks run, then the original code
+    EXPECT_EQ(target_a(2), 7);
+    EXPECT_EQ(target_b(2), 8);
+    EXPECT_EQ(counter_, 2);
+    
+    manager.uninstall_all();
+    EXPECT_EQ(target_a(2), 7);
+    EXPECT_EQ(counter_, 2);
+    EXPECT_EQ(stub_slots(manager), 0u);
+}
+
+TEST_F(HookManagerTest, FailedBatchRollsBackEveryHook) {
+    int (*volatile target_a)(int) = &batch_target_a;
+    int (*volatile target_b)(int) = &batch_target_b;
+    const auto address_a = reinterpret_cast<std::uintptr_t>(&batch_target_a);
+    const auto address_b = reinterpret_cast<std::uintptr_t>(&batch_target_b);
+    
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(address_a, std::make_unique<CountingTask>("a", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(address_b, std::make_unique<CountingTask>("b", counter_)).has_value());
+    ASSERT_TRUE(manager.add_task_to_hook(reinterpret_cast<std::uintptr_t>(not_code),
+                                         std::make_unique<CountingTask>("data", counter_)).has_value());
+    const auto slots = stub_slots(manager);
+    
+    // Whichever order the hooks are created in, the batch fails as a whole
+    const auto result = manager.install_all(InstallMode::batched);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), HookError::minhook_create_failed);
+    EXPECT_EQ(stub_slots(manager), slots);
+    for (const auto address : {address_a, address_b}) {
+        EXPECT_EQ(manager.get_hook(address)->trampoline(), nullptr);
+        EXPECT_EQ(manager.get_hook(address)->handler(), nullptr);
+        EXPECT_EQ(MH_DisableHook(reinterpret_cast<LPVOID>(address)), MH_ERROR_NOT_CREATED);
+    }
+    
+    // The functions run unhooked
+    EXPECT_EQ(target_a(2), 7);
+    EXPECT_EQ(target_b(2), 8);
+    EXPECT_EQ(counter_, 0);
+}
+
+TEST_F(HookManagerTest, MinimalStubSavesOnlyCallerSavedRegisters) {
+    const auto minimal = hook_stub_code(StubKind::minimal);
+    const auto full = hook_stub_code(StubKind::full);
+    
+    // push eax/ecx/edx, pushfd ... popfd, pop edx/ecx/eax
+    EXPECT_EQ((std::vector<std::uint8_t>(minimal.begin(), minimal.begin() + 4)),
+              (std::vector<std::uint8_t>{0x50, 0x51, 0x52, 0x9C}));
+    EXPECT_EQ((std::vector<std::uint8_t>(minimal.end() - 9, minimal.end() - 5)),
+              (std::vector<std::uint8_t>{0x9D, 0x5A, 0x59, 0x58}));
+    
+    // pushad, pushfd ... popfd, popad
+    EXPECT_EQ(full[0], 0x60);
+    EXPECT_EQ(full[1], 0x9C);
+    EXPECT_EQ(full[full.size() - 6], 0x61);
+}
+
+TEST_F(HookManagerTest, FullStubPassesItsFrame) {
+    const auto full = hook_stub_code(StubKind::full);
+    
+    // pushfd, push esp, push Hook* ... add esp, 8
+    EXPECT_EQ(full[2], 0x54);
+    EXPECT_EQ(full[3], 0x68);
+    EXPECT_EQ((std::vector<std::uint8_t>(full.begin() + 13, full.begin() + 16)),
+              (std::vector<std::uint8_t>{0x83, 0xC4, 0x08}));
+}
+
+TEST_F(HookManagerTest, MinimalStubRunsInFrontOfTheRoutine) {
+    StubHarness harness;
+    ASSERT_TRUE(harness.ready());
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(harness.routine(), std::make_unique<CountingTask>("plain", counter_)).has_value());
+    ASSERT_TRUE(manager.install_all().has_value());
+    
+    // push eax/ecx/edx, pushfd, push Hook* ... popfd, pop edx/ecx/eax, jmp trampoline
+    const auto& hook = *manager.get_hook(harness.routine());
+    ASSERT_EQ(hook.stub_kind(), StubKind::minimal);
+    const auto stub = stub_bytes(hook, 22);
+    EXPECT_EQ((std::vector<std::uint8_t>(stub.begin(), stub.begin() + 5)),
+              (std::vector<std::uint8_t>{0x50, 0x51, 0x52, 0x9C, 0x68}));
+    EXPECT_EQ((std::vector<std::uint8_t>(stub.begin() + 17, stub.end())),
+              (std::vector<std::uint8_t>{0x9D, 0x5A, 0x59, 0x58, 0xE9}));
+    
+    harness.run();
+    EXPECT_EQ(counter_, 1);
+    
+    // The routine gets every register and flag its caller set, and the caller
+    // gets them back with its stack balanced
+    for (const auto* registers : {&harness.seen, &harness.after}) {
+        EXPECT_EQ(registers->eax, kLoaded.eax);
+        EXPECT_EQ(registers->ecx, kLoaded.ecx);
+        EXPECT_EQ(registers->edx, kLoaded.edx);
+        EXPECT_EQ(registers->ebx, kLoaded.ebx);
+        EXPECT_EQ(registers->esi, kLoaded.esi);
+        EXPECT_EQ(registers->edi, kLoaded.edi);
+        EXPECT_EQ(registers->ebp, kLoaded.ebp);
+        EXPECT_EQ(registers->eflags & kArithmeticFlags, kLoaded.eflags);
+    }
+    EXPECT_EQ(harness.after.esp, harness.seen.esp + 4);
+}
+
+TEST_F(HookManagerTest, FullStubRunsInFrontOfTheRoutine) {
+    StubHarness harness;
+    ASSERT_TRUE(harness.ready());
+    HookManager manager;
+    auto writer = std::make_unique<ContextWritingTask>();
+    auto* raw = writer.get();
+    ASSERT_TRUE(manager.add_task_to_hook(harness.routine(), std::move(writer)).has_value());
+    ASSERT_TRUE(manager.install_all().has_value());
+    
+    // pushad, pushfd, push esp, push Hook* ... popfd, popad, jmp trampoline
+    const auto& hook = *manager.get_hook(harness.routine());
+    ASSERT_EQ(hook.stub_kind(), StubKind::full);
+    const auto stub = stub_bytes(hook, 19);
+    EXPECT_EQ((std::vector<std::uint8_t>(stub.begin(), stub.begin() + 4)),
+              (std::vector<std::uint8_t>{0x60, 0x9C, 0x54, 0x68}));
+    EXPECT_EQ((std::vector<std::uint8_t>(stub.begin() + 16, stub.end())),
+              (std::vector<std::uint8_t>{0x9D, 0x61, 0xE9}));
+    
+    harness.run();
+    
+    // The task's writes reach the routine; the registers it left alone are kept
+    EXPECT_EQ(raw->seen_esp, harness.seen.esp);
+    EXPECT_EQ(harness.seen.eax, 0xA0A0A0A0u);
+    EXPECT_EQ(harness.seen.ebx, 0xB0B0B0B0u);
+    EXPECT_EQ(harness.seen.edi, 0xD0D0D0D0u);
+    EXPECT_EQ(harness.seen.eflags & kArithmeticFlags, kLoaded.eflags & ~0x1u);
+    EXPECT_EQ(harness.seen.ecx, kLoaded.ecx);
+    EXPECT_EQ(harness.seen.edx, kLoaded.edx);
+    EXPECT_EQ(harness.seen.esi, kLoaded.esi);
+    EXPECT_EQ(harness.seen.ebp, kLoaded.ebp);
+    EXPECT_EQ(harness.after.esp, harness.seen.esp + 4);
+}
+
+TEST_F(HookManagerTest, TasksReadAndWriteRegisters) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("plain", counter_));
+    auto registers = std::make_unique<RegisterTask>("registers", counter_);
+    auto* raw = registers.get();
+    hook.add_task(std::move(registers));
+    hook.add_task(std::make_unique<DirectRegisterTask>());
+    
+    int trampoline_target = 0;
+    hook.set_trampoline(&trampoline_target);
+    
+    task::CpuContext context{};
+    context.eax = 21;
+    context.ecx = 7;
+    EXPECT_EQ(dispatch_hook_with_context(&hook, &context), &trampoline_target);
+    EXPECT_EQ(counter_, 2);
+    EXPECT_EQ(raw->seen_ecx, 7u);
+    EXPECT_EQ(context.eax, 42u);
+    EXPECT_EQ(context.edx, 0x1234u);
+    
+    // Without a frame, tasks run their plain execute()
+    EXPECT_EQ(hook.run_tasks(), task_outcome_bit(2));
+    EXPECT_EQ(counter_, 4);
+}
+
+TEST_F(HookManagerTest, StubKindFollowsTasks) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<CountingTask>("plain", counter_));
+    EXPECT_EQ(hook.stub_kind(), StubKind::minimal);
+    
+    hook.add_task(std::make_unique<RegisterTask>("registers", counter_));
+    EXPECT_EQ(hook.stub_kind(), StubKind::full);
+    
+    // A task needing registers cannot be downgraded by another task's config
+    hook.set_stub_kind(StubKind::minimal);
+    EXPECT_EQ(hook.stub_kind(), StubKind::full);
+}
+
+TEST_F(HookManagerTest, RegisterTaskRunsBehindTheFullStub) {
+    StubHarness harness;
+    ASSERT_TRUE(harness.ready());
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(harness.routine(), std::make_unique<CountingTask>("plain", counter_)).has_value());
+    auto registers = std::make_unique<RegisterTask>("registers", counter_);
+    auto* raw = registers.get();
+    ASSERT_TRUE(manager.add_task_to_hook(harness.routine(), std::move(registers)).has_value());
+    ASSERT_TRUE(manager.install_all().has_value());
+    
+    // Nothing asked for the full stub but the task's needs_registers()
+    const auto stub = stub_bytes(*manager.get_hook(harness.routine()), 4);
+    EXPECT_EQ(stub, (std::vector<std::uint8_t>{0x60, 0x9C, 0x54, 0x68}));
+    
+    harness.run();
+    EXPECT_EQ(counter_, 2);
+    EXPECT_EQ(raw->seen_ecx, kLoaded.ecx);
+    EXPECT_EQ(harness.seen.eax, kLoaded.eax * 2);
+    EXPECT_EQ(harness.seen.ebx, kLoaded.ebx);
+    EXPECT_EQ(harness.after.esp, harness.seen.esp + 4);
+}
+
+TEST_F(HookManagerTest, ConfigSelectsFullStub) {
+    Hook hook(0x401000);
+    hook.set_stub_kind(StubKind::full);
+    EXPECT_EQ(hook.stub_kind(), StubKind::full);
+    
+    EXPECT_EQ(config::stub_from_string("minimal"), config::TaskStub::minimal);
+    EXPECT_EQ(config::stub_from_string("full"), config::TaskStub::full);
+    EXPECT_FALSE(config::stub_from_string("pushad").has_value());
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "allocation_counter.hpp"
+#include "hook/hook_manager.hpp"
+#include "context/mod_context.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace app_hook::hook {
+
+namespace {
+
+// Task doing nothing but counting, reached through the vtable
+class PlainTask : public task::IHookTask {
+public:
+    explicit PlainTask(int& counter) : counter_(counter) {}
+
+    task::TaskResult execute() override {
+        ++counter_;
+        return {};
+    }
+
+    std::string name() const override { return "a task name too long for the small string buffer"; }
+    std::string description() const override { return "Plain task"; }
+
+private:
+    int& counter_;
+};
+
+// Final task reading registers through a direct thunk
+class RegisterTask final : public task::IHookTask {
+public:
+    task::TaskResult execute() override { return {}; }
+    task::TaskResult execute(task::CpuContext& context) override {
+        ++context.eax;
+        return {};
+    }
+    task::TaskThunk thunk() noexcept override { return make_direct_thunk(this); }
+    bool needs_registers() const noexcept override { return true; }
+
+    std::string name() const override { return "registers"; }
+    std::string description() const override { return "Register task"; }
+};
+
+} // namespace
+
+class HotPathAllocationTest : public ::testing::Test {
+protected:
+    int counter_ = 0;
+};
+
+TEST_F(HotPathAllocationTest, CounterSeesAllocations) {
+    if (!test::allocation_tracking_enabled()) {
+        GTEST_SKIP() << "Allocation tracking is off in this build";
+    }
+    test::AllocationScope outer;
+    auto block = std::make_unique<std::vector<int>>(64);
+    {
+        test::AllocationScope inner;
+        std::string text(100, 'x');
+        EXPECT_EQ(inner.stop(), 1u);
+    }
+    EXPECT_EQ(outer.stop(), 2u);
+}
+
+TEST_F(HotPathAllocationTest, RepeatTriggersDoNotAllocate) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<PlainTask>(counter_));
+    hook.add_task(std::make_unique<PlainTask>(counter_));
+    int trampoline_target = 0;
+    hook.set_trampoline(&trampoline_target);
+
+    (void)dispatch_hook(&hook);
+    EXPECT_NO_ALLOCATIONS({
+        for (int i = 0; i < 100; ++i) {
+            (void)dispatch_hook(&hook);
+            (void)hook.execute_tasks();
+        }
+    });
+    EXPECT_EQ(counter_, 402);
+}
+
+TEST_F(HotPathAllocationTest, OwnedHookTriggersDoNotAllocate) {
+    HookManager manager;
+    ASSERT_TRUE(manager.add_task_to_hook(0x401000, std::make_unique<PlainTask>(counter_)).has_value());
+    auto* hook = manager.get_hook(0x401000);
+    ASSERT_NE(hook, nullptr);
+    int trampoline_target = 0;
+    hook->set_trampoline(&trampoline_target);
+
+    // Frame time accounting and the idle trace recorder stay off the heap
+    (void)dispatch_hook(hook);
+    EXPECT_NO_ALLOCATIONS({
+        for (int i = 0; i < 100; ++i) {
+            (void)dispatch_hook(hook);
+        }
+    });
+    hook->set_trampoline(nullptr);
+}
+
+TEST_F(HotPathAllocationTest, RegisterTasksDoNotAllocate) {
+    Hook hook(0x401000);
+    hook.add_task(std::make_unique<RegisterTask>());
+    int trampoline_target = 0;
+    hook.set_trampoline(&trampoline_target);
+
+    task::CpuContext context{};
+    EXPECT_NO_ALLOCATIONS({
+        for (int i = 0; i < 100; ++i) {
+            (void)dispatch_hook_with_context(&hook, &context);
+        }
+    });
+    EXPECT_EQ(context.eax, 100u);
+}
+
+TEST_F(HotPathAllocationTest, InternedContextLookupsDoNotAllocate) {
+    auto& context = context::ModContext::instance();
+    const auto key = context.intern("hot_path_allocation_value");
+    ASSERT_TRUE(context.store(key, 42));
+
+    int sum = 0;
+    EXPECT_NO_ALLOCATIONS({
+        for (int i = 0; i < 100; ++i) {
+            if (const auto* value = context.get<int>(key)) {
+                sum += *value;
+            }
+        }
+    });
+    EXPECT_EQ(sum, 4200);
+    EXPECT_TRUE(context.remove_data("hot_path_allocation_value"));
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,300 @@
+#include <gtest/gtest.h>
+#include "hook/hot_reload.hpp"
+#include "config/config_factory.hpp"
+#include "config/config_loader_base.hpp"
+#include "util/file_watcher.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace app_hook::hook {
+
+namespace {
+
+// Config holding one value read from a "key=value" line
+class ReloadTestConfig : public config::ConfigBase {
+public:
+    ReloadTestConfig(std::string key, std::string value)
+        : ConfigBase(config::ConfigType::Memory, key, key), value_(std::move(value)) {}
+
+    bool is_valid() const noexcept override { return true; }
+    const std::string& value() const noexcept { return value_; }
+
+private:
+    std::string value_;
+};
+
+// Loader parsing "key=value" lines; a line "!" is a parse error
+class ReloadTestLoader : public config::ConfigLoaderBase {
+public:
+    std::string get_name() const override { return "ReloadTestLoader"; }
+    std::string get_version() const override { return "1.0.0"; }
+    std::vector<config::ConfigType> supported_types() const override { return {config::ConfigType::Memory}; }
+
+    config::ConfigResult<std::vector<config::ConfigPtr>> load_configs(
+        config::ConfigType, const std::string& file_path, const std::string&) override {
+        std::ifstream file(file_path);
+        if (!file) {
+            return std::unexpected(config::ConfigError::file_not_found);
+        }
+        std::vector<config::ConfigPtr> configs;
+        for (std::string line; std::getline(file, line);) {
+            if (line == "!") {
+                return std::unexpected(config::ConfigError::parse_error);
+            }
+            const auto separator = line.find('=');
+            if (separator != std::string::npos) {
+                configs.push_back(std::make_shared<ReloadTestConfig>(line.substr(0, separator), line.substr(separator + 1)));
+            }
+        }
+        return configs;
+    }
+};
+
+// Task that takes reloaded values; a value starting with "grow" moves its output
+class ReloadTestTask : public task::IHookTask {
+public:
+    explicit ReloadTestTask(std::string value, std::string watched = {})
+        : value_(std::move(value)), watched_(std::move(watched)) {}
+
+    std::string name() const override { return "ReloadTest"; }
+    std::string description() const override { return "Reload test task"; }
+
+    task::TaskResult execute() override {
+        ++executions;
+        return {};
+    }
+
+    task::ReloadOutcome reload(const config::ConfigBase& updated) override {
+        const auto& config = static_cast<const ReloadTestConfig&>(updated);
+        if (config.value() == value_) {
+            return task::ReloadOutcome::unchanged;
+        }
+        value_ = config.value();
+        return value_.starts_with("grow") ? task::ReloadOutcome::dependents_stale : task::ReloadOutcome::updated;
+    }
+
+    std::vector<std::string> watched_files() const override {
+        return watched_.empty() ? std::vector<std::string>{} : std::vector<std::string>{watched_};
+    }
+
+    task::ReloadOutcome refresh_file(const std::string&) override {
+        ++refreshes;
+        return task::ReloadOutcome::dependents_stale;
+    }
+
+    const std::string& value() const noexcept { return value_; }
+
+    int executions = 0;
+    int refreshes = 0;
+
+private:
+    std::string value_;
+    std::string watched_;
+};
+
+} // namespace
+
+class HotReloadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "hot_reload_tests";
+        std::filesystem::create_directories(test_dir_);
+        (void)config::ConfigFactory::register_loader(std::make_unique<ReloadTestLoader>());
+        reloader_ = std::make_unique<HotReloader>(test_dir_ / "tasks.toml");
+    }
+
+    void TearDown() override {
+        reloader_.reset();
+        (void)config::ConfigFactory::unregister_loader("ReloadTestLoader");
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    std::filesystem::path Write(const std::string& name, const std::string& content) {
+        const auto path = test_dir_ / name;
+        std::ofstream file(path);
+        file << content;
+        return path;
+    }
+
+    void Track(const std::string& key, const std::string& file, std::vector<std::string> followers = {}) {
+        config::TaskInfo info;
+        info.name = key;
+        info.config_file = file;
+        info.type = config::ConfigType::Memory;
+        reloader_->track_task(info, key, test_dir_ / file, std::move(followers));
+    }
+
+    void TrackConfig(const std::string& task_key, const std::string& key, const std::string& value,
+                     ReloadTestTask& task) {
+        reloader_->track_config(task_key, std::make_shared<ReloadTestConfig>(key, value), &task);
+    }
+
+    std::filesystem::path test_dir_;
+    std::unique_ptr<HotReloader> reloader_;
+};
+
+TEST_F(HotReloadTest, ChangedConfigReachesItsTask) {
+    const auto file = Write("patch.toml", "a=1\nb=1\n");
+    ReloadTestTask a("1");
+    ReloadTestTask b("1");
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "a", "1", a);
+    TrackConfig("patch", "b", "1", b);
+
+    Write("patch.toml", "a=1\nb=2\n");
+    const auto report = reloader_->reload_file(file);
+
+    EXPECT_TRUE(report.matched);
+    EXPECT_EQ(report.updated, 1u);
+    EXPECT_EQ(report.unchanged, 1u);
+    EXPECT_EQ(report.rerun, 0u);
+    EXPECT_FALSE(report.needs_restart());
+    EXPECT_EQ(b.value(), "2");
+    EXPECT_EQ(a.executions + b.executions, 0);
+}
+
+TEST_F(HotReloadTest, MovedOutputRerunsFollowersTransitively) {
+    const auto file = Write("memory.toml", "region=64\n");
+    Write("load.toml", "binary=x\n");
+    Write("patch.toml", "code=y\n");
+    ReloadTestTask region("64");
+    ReloadTestTask load("x");
+    ReloadTestTask patch("y");
+    Track("memory", "memory.toml", {"load"});
+    TrackConfig("memory", "region", "64", region);
+    Track("load", "load.toml", {"patch"});
+    TrackConfig("load", "binary", "x", load);
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "code", "y", patch);
+
+    Write("memory.toml", "region=grow128\n");
+    const auto report = reloader_->reload_file(file);
+
+    EXPECT_EQ(report.updated, 1u);
+    EXPECT_EQ(report.rerun, 2u);
+    EXPECT_EQ(region.executions, 0);
+    EXPECT_EQ(load.executions, 1);
+    EXPECT_EQ(patch.executions, 1);
+}
+
+TEST_F(HotReloadTest, WatchedFileIsRefreshed) {
+    const auto binary = Write("mod.bin", "old");
+    Write("load.toml", "binary=x\n");
+    Write("patch.toml", "code=y\n");
+    ReloadTestTask load("x", binary.string());
+    ReloadTestTask patch("y");
+    Track("load", "load.toml", {"patch"});
+    TrackConfig("load", "binary", "x", load);
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "code", "y", patch);
+
+    const auto report = reloader_->reload_file(binary);
+
+    EXPECT_TRUE(report.matched);
+    EXPECT_EQ(load.refreshes, 1);
+    EXPECT_EQ(patch.executions, 1);
+    EXPECT_EQ(report.rerun, 1u);
+}
+
+TEST_F(HotReloadTest, AddedAndRemovedConfigsNeedRestart) {
+    const auto file = Write("patch.toml", "a=1\nb=1\n");
+    ReloadTestTask a("1");
+    ReloadTestTask b("1");
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "a", "1", a);
+    TrackConfig("patch", "b", "1", b);
+
+    Write("patch.toml", "a=1\nc=1\n");
+    const auto report = reloader_->reload_file(file);
+
+    EXPECT_EQ(report.unchanged, 1u);
+    EXPECT_EQ(report.restart_required, 2u);
+    EXPECT_TRUE(report.needs_restart());
+}
+
+TEST_F(HotReloadTest, ParseErrorKeepsAppliedConfigs) {
+    const auto file = Write("patch.toml", "a=1\n");
+    ReloadTestTask a("1");
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "a", "1", a);
+
+    Write("patch.toml", "a=2\n!\n");
+    const auto report = reloader_->reload_file(file);
+
+    EXPECT_TRUE(report.parse_failed);
+    EXPECT_EQ(a.value(), "1");
+
+    // The next good save applies
+    Write("patch.toml", "a=2\n");
+    EXPECT_EQ(reloader_->reload_file(file).updated, 1u);
+    EXPECT_EQ(a.value(), "2");
+}
+
+TEST_F(HotReloadTest, TaskListChangeNeedsRestart) {
+    const auto tasks = Write("tasks.toml", "");
+
+    const auto report = reloader_->reload_file(tasks);
+    EXPECT_TRUE(report.matched);
+    EXPECT_EQ(report.restart_required, 1u);
+}
+
+TEST_F(HotReloadTest, UnrelatedFileIsIgnored) {
+    Write("patch.toml", "a=1\n");
+    ReloadTestTask a("1");
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "a", "1", a);
+
+    const auto report = reloader_->reload_file(Write("notes.txt", "a=2\n"));
+    EXPECT_FALSE(report.matched);
+    EXPECT_EQ(report.updated + report.unchanged + report.rerun + report.restart_required, 0u);
+}
+
+TEST_F(HotReloadTest, PathsMatchAfterNormalization) {
+    const auto file = Write("patch.toml", "a=1\n");
+    ReloadTestTask a("1");
+    Track("patch", "patch.toml");
+    TrackConfig("patch", "a", "1", a);
+
+    Write("patch.toml", "a=2\n");
+    const auto report = reloader_->reload_file(test_dir_ / "sub" / ".." / "patch.toml");
+    EXPECT_EQ(report.updated, 1u);
+    EXPECT_TRUE(same_watch_path(normalize_watch_path(file), normalize_watch_path(test_dir_ / "." / "patch.toml")));
+}
+
+TEST(ChangeDebouncerTest, ReportsPathOnceAfterQuietTime) {
+    using namespace std::chrono_literals;
+    util::ChangeDebouncer debouncer(150ms);
+    const auto start = util::ChangeDebouncer::Clock::now();
+
+    // An editor saving in three writes
+    debouncer.touch("config/patch.toml", start);
+    debouncer.touch("config/patch.toml", start + 20ms);
+    debouncer.touch("config/patch.toml", start + 40ms);
+
+    EXPECT_TRUE(debouncer.take_due(start + 100ms).empty());
+    EXPECT_EQ(debouncer.time_to_next(start + 100ms), 90ms);
+
+    const auto due = debouncer.take_due(start + 190ms);
+    ASSERT_EQ(due.size(), 1u);
+    EXPECT_EQ(due[0], std::filesystem::path("config/patch.toml"));
+    EXPECT_TRUE(debouncer.empty());
+    EXPECT_EQ(debouncer.time_to_next(start + 190ms), std::chrono::milliseconds::max());
+}
+
+TEST(ChangeDebouncerTest, PathsBecomeDueIndependently) {
+    using namespace std::chrono_literals;
+    util::ChangeDebouncer debouncer(100ms);
+    const auto start = util::ChangeDebouncer::Clock::now();
+
+    debouncer.touch("config/memory.toml", start);
+    debouncer.touch("mods/text.bin", start + 80ms);
+
+    const auto first = debouncer.take_due(start + 100ms);
+    ASSERT_EQ(first.size(), 1u);
+    EXPECT_EQ(first[0], std::filesystem::path("config/memory.toml"));
+    EXPECT_EQ(debouncer.time_to_next(start + 100ms), 80ms);
+    EXPECT_EQ(debouncer.take_due(start + 180ms).size(), 1u);
+}
+
+} // namespace app_hook::hook
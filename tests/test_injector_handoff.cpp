@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "util/injector_handoff.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace app_hook::util {
+
+TEST(InjectorHandoffTest, RoundTripsPaths) {
+    const auto block = encode_handoff({"C:\\Games\\FF8\\config", "mods/xtender/tasks"});
+
+    const auto decoded = decode_handoff(block);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->config_dir, "C:\\Games\\FF8\\config");
+    EXPECT_EQ(decoded->plugin_dir, "mods/xtender/tasks");
+}
+
+TEST(InjectorHandoffTest, RoundTripsHotReloadFlag) {
+    InjectorHandoff handoff{"config", "tasks"};
+    EXPECT_FALSE(decode_handoff(encode_handoff(handoff))->hot_reload);
+    
+    handoff.hot_reload = true;
+    const auto block = encode_handoff(handoff);
+    const auto decoded = decode_handoff(block);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(decoded->hot_reload);
+    EXPECT_EQ(decoded->plugin_dir, "tasks");
+    
+    // The record is only written when the flag is set
+    EXPECT_EQ(block.size(), encode_handoff({"config", "tasks"}).size() + kHandoffRecordHeaderSize + 1);
+}
+
+TEST(InjectorHandoffTest, RoundTripsPackBundleFlag) {
+    InjectorHandoff handoff{"config", "tasks"};
+    EXPECT_FALSE(decode_handoff(encode_handoff(handoff))->pack_bundle);
+
+    handoff.pack_bundle = true;
+    const auto decoded = decode_handoff(encode_handoff(handoff));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(decoded->pack_bundle);
+    EXPECT_FALSE(decoded->hot_reload);
+}
+
+TEST(InjectorHandoffTest, RoundTripsTracePath) {
+    InjectorHandoff handoff{"config", "tasks"};
+    EXPECT_TRUE(decode_handoff(encode_handoff(handoff))->trace_path.empty());
+
+    handoff.trace_path = "C:\\traces\\battle.trace";
+    const auto decoded = decode_handoff(encode_handoff(handoff));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->trace_path, handoff.trace_path);
+    EXPECT_EQ(decoded->config_dir, "config");
+}
+
+TEST(InjectorHandoffTest, IgnoresBytesPastTheBlock) {
+    // Mappings are page sized, so the view is longer than the block
+    auto block = encode_handoff({"config", "tasks"});
+    block.resize(4096, 0xCC);
+
+    const auto decoded = decode_handoff(block);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->config_dir, "config");
+    EXPECT_EQ(decoded->plugin_dir, "tasks");
+}
+
+TEST(InjectorHandoffTest, SkipsUnknownRecords) {
+    auto block = encode_handoff({"config", "tasks"});
+    const std::vector<std::uint8_t> unknown{0x63, 0x00, 0x03, 0x00, 0x00, 0x00, 'a', 'b', 'c'};
+    block.insert(block.end(), unknown.begin(), unknown.end());
+    block[8] = static_cast<std::uint8_t>(block.size());
+
+    const auto decoded = decode_handoff(block);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->plugin_dir, "tasks");
+}
+
+TEST(InjectorHandoffTest, RejectsForeignData) {
+    std::vector<std::uint8_t> zeros(64, 0);
+    EXPECT_EQ(decode_handoff(zeros).error(), HandoffError::bad_magic);
+    EXPECT_EQ(decode_handoff(std::span<const std::uint8_t>{}).error(), HandoffError::truncated);
+}
+
+TEST(InjectorHandoffTest, RejectsOtherVersions) {
+    auto block = encode_handoff({"config", "tasks"});
+    block[4] = kHandoffVersion + 1;
+
+    EXPECT_EQ(decode_handoff(block).error(), HandoffError::unsupported_version);
+}
+
+TEST(InjectorHandoffTest, RejectsTruncatedBlocks) {
+    const auto block = encode_handoff({"config", "tasks"});
+
+    const std::span<const std::uint8_t> cut(block.data(), block.size() - 1);
+    EXPECT_EQ(decode_handoff(cut).error(), HandoffError::truncated);
+
+    // A record claiming more bytes than the block holds
+    auto corrupt = block;
+    corrupt[kHandoffHeaderSize + 2] = 0xFF;
+    EXPECT_EQ(decode_handoff(corrupt).error(), HandoffError::truncated);
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "util/live_metrics.hpp"
+#include "util/metrics_publisher.hpp"
+#include <atomic>
+#include <format>
+#include <string>
+#include <thread>
+
+namespace app_hook::util {
+
+namespace {
+
+// Mapping name no other test process uses
+std::string test_mapping_name(const char* suffix) {
+    return std::format("Local\\app_hook_metrics_test_{}_{}", GetCurrentProcessId(), suffix);
+}
+
+} // namespace
+
+TEST(LiveMetricsTest, SeqlockCellRoundTrips) {
+    SeqlockCell<HookMetrics> cell;
+    EXPECT_EQ(cell.load().calls, 0u);
+    EXPECT_EQ(cell.version(), 0u);
+
+    cell.store({0x401000, 2, 100, 5000, 90, 1});
+    const auto value = cell.load();
+    EXPECT_EQ(value.address, 0x401000u);
+    EXPECT_EQ(value.task_count, 2u);
+    EXPECT_EQ(value.calls, 100u);
+    EXPECT_EQ(value.total_ns, 5000u);
+    EXPECT_EQ(value.failures, 1u);
+    EXPECT_EQ(cell.version(), 1u);
+}
+
+TEST(LiveMetricsTest, ReaderNeverSeesTornValues) {
+    SeqlockCell<HookMetrics> cell;
+    std::atomic<bool> stop{false};
+
+    // Every field of a published value holds the same number
+    std::thread writer([&] {
+        for (std::uint64_t i = 1; !stop.load(std::memory_order_relaxed); ++i) {
+            const auto word = static_cast<std::uint32_t>(i);
+            cell.store({word, word, i, i, i, i});
+        }
+    });
+
+    for (int i = 0; i < 100000; ++i) {
+        const auto value = cell.load();
+        ASSERT_EQ(value.calls, value.total_ns);
+        ASSERT_EQ(value.calls, value.max_ns);
+        ASSERT_EQ(value.calls, value.failures);
+        ASSERT_EQ(static_cast<std::uint32_t>(value.calls), value.address);
+    }
+    stop = true;
+    writer.join();
+}
+
+TEST(LiveMetricsTest, NamesAreTruncatedAndTerminated) {
+    TaskMetrics task;
+    copy_metrics_name(task.name, std::string(100, 'x'));
+    EXPECT_EQ(std::string(task.name).size(), kMetricsNameSize - 1);
+
+    copy_metrics_name(task.name, "short");
+    EXPECT_EQ(std::string(task.name), "short");
+}
+
+TEST(LiveMetricsTest, PublishedFrameIsReadBack) {
+    MetricsPublisher publisher;
+    ASSERT_TRUE(publisher.open(test_mapping_name("frame")));
+    ASSERT_NE(publisher.block(), nullptr);
+    EXPECT_TRUE(metrics_block_valid(*publisher.block(), sizeof(MetricsBlock)));
+    EXPECT_FALSE(publisher.open(test_mapping_name("again")));
+
+    MetricsFrame frame;
+    frame.hooks.push_back({0x401000, 1, 10, 1000, 200, 0});
+    auto& task = frame.tasks.emplace_back();
+    task.hook_address = 0x401000;
+    task.calls = 10;
+    copy_metrics_name(task.name, "copy_magic");
+    auto& memory = frame.memory.emplace_back();
+    memory.bytes = 4096;
+    copy_metrics_name(memory.category, "memory_plugin.region_arena");
+    auto& plugin = frame.plugins.emplace_back();
+    plugin.loaded = 1;
+    copy_metrics_name(plugin.name, "memory_plugin");
+    publisher.publish(frame);
+
+    const auto read = read_metrics(*publisher.block());
+    EXPECT_EQ(read.summary.publishes, 1u);
+    EXPECT_EQ(read.summary.dropped, 0u);
+    ASSERT_EQ(read.hooks.size(), 1u);
+    EXPECT_EQ(read.hooks[0].calls, 10u);
+    ASSERT_EQ(read.tasks.size(), 1u);
+    EXPECT_EQ(std::string(read.tasks[0].name), "copy_magic");
+    ASSERT_EQ(read.memory.size(), 1u);
+    EXPECT_EQ(read.memory[0].bytes, 4096u);
+    ASSERT_EQ(read.plugins.size(), 1u);
+    EXPECT_EQ(read.plugins[0].loaded, 1u);
+}
+
+TEST(LiveMetricsTest, EntriesBeyondCapacityAreDropped) {
+    MetricsPublisher publisher;
+    ASSERT_TRUE(publisher.open(test_mapping_name("capacity")));
+
+    MetricsFrame frame;
+    frame.hooks.resize(kMetricsMaxHooks + 3);
+    publisher.publish(frame);
+
+    const auto read = read_metrics(*publisher.block());
+    EXPECT_EQ(read.hooks.size(), kMetricsMaxHooks);
+    EXPECT_EQ(read.summary.dropped, 3u);
+}
+
+TEST(LiveMetricsTest, BackgroundThreadPublishesUntilStopped) {
+    MetricsPublisher publisher;
+    ASSERT_TRUE(publisher.open(test_mapping_name("thread")));
+
+    std::atomic<int> collected{0};
+    ASSERT_TRUE(publisher.start([&collected](MetricsFrame& frame) {
+        frame.hooks.push_back({0x401000, 0, static_cast<std::uint64_t>(++collected), 0, 0, 0});
+    }, std::chrono::milliseconds(1)));
+
+    while (collected.load() < 3) {
+        std::this_thread::yield();
+    }
+    publisher.stop();
+    const auto stopped_at = collected.load();
+
+    const auto read = read_metrics(*publisher.block());
+    EXPECT_GE(read.summary.publishes, 3u);
+    ASSERT_EQ(read.hooks.size(), 1u);
+    EXPECT_EQ(read.hooks[0].calls, static_cast<std::uint64_t>(stopped_at));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(collected.load(), stopped_at);
+}
+
+} // namespace app_hook::util
@@ -309,4 +309,159 @@ TEST_F(LoadInMemoryConfigLoaderTest, InvalidOffsetSecurityType) {
     auto* config = static_cast<LoadInMemoryConfig*>(configs[0].get());
     // Should use default value (0) for invalid offset security
     EXPECT_EQ(config->offset_security(), 0);
-} 
\ No newline at end of file
+}
+
+TEST_F(LoadInMemoryConfigLoaderTest, LoadConfigsReadMode) {
+    std::string config_content = R"(
+        [load.mapped_data]
+        binary = "mapped.bin"
+        readMode = "mapped"
+        
+        [load.stream_data]
+        binary = "stream.bin"
+        preload = false
+    )";
+    
+    create_test_file("read_mode.toml", config_content);
+    
+    auto result = loader_->load_configs(ConfigType::Load, get_test_file_path("read_mode.toml"), "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 2);
+    
+    for (auto& config : *result) {
+        auto* load_config = static_cast<LoadInMemoryConfig*>(config.get());
+        if (load_config->name() == "mapped_data") {
+            EXPECT_EQ(load_config->read_mode(), BinaryReadMode::mapped);
+            EXPECT_FALSE(load_config->preload());  // Mapped binaries are never staged
+        } else {
+            EXPECT_EQ(load_config->read_mode(), BinaryReadMode::stream);
+            EXPECT_FALSE(load_config->preload());
+        }
+    }
+}
+
+TEST_F(LoadInMemoryConfigLoaderTest, LoadConfigsCompression) {
+    std::string config_content = R"(
+        [load.lz4_data]
+        binary = "table.bin.lz4"
+        compression = "lz4"
+        
+        [load.zstd_data]
+        binary = "kernel.bin.zst"
+        compression = "zstd"
+        
+        [load.raw_data]
+        binary = "raw.bin"
+        
+        [load.unknown_data]
+        binary = "unknown.bin"
+        compression = "brotli"
+    )";
+    
+    create_test_file("compression.toml", config_content);
+    
+    auto result = loader_->load_configs(ConfigType::Load, get_test_file_path("compression.toml"), "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 3);  // An unknown codec drops the entry
+    
+    for (auto& config : *result) {
+        auto* load_config = static_cast<LoadInMemoryConfig*>(config.get());
+        if (load_config->name() == "lz4_data") {
+            EXPECT_EQ(load_config->compression(), BinaryCompression::lz4);
+        } else if (load_config->name() == "zstd_data") {
+            EXPECT_EQ(load_config->compression(), BinaryCompression::zstd);
+        } else {
+            EXPECT_EQ(load_config->compression(), BinaryCompression::none);
+        }
+    }
+}
+
+TEST_F(LoadInMemoryConfigLoaderTest, LoadConfigsVerification) {
+    std::string config_content = R"(
+        [load.verified]
+        binary = "verified.bin"
+        verify = true
+        
+        [load.checksummed]
+        binary = "checksummed.bin"
+        checksum = "0xE3069283"
+    )";
+    
+    create_test_file("verify.toml", config_content);
+    
+    auto result = loader_->load_configs(ConfigType::Load, get_test_file_path("verify.toml"), "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 2);
+    
+    for (auto& config : *result) {
+        auto* load_config = static_cast<LoadInMemoryConfig*>(config.get());
+        EXPECT_TRUE(load_config->verify());  // A checksum implies verification
+        if (load_config->name() == "checksummed") {
+            EXPECT_EQ(load_config->checksum(), 0xE3069283u);
+        } else {
+            EXPECT_FALSE(load_config->checksum().has_value());
+        }
+    }
+}
+
+TEST_F(LoadInMemoryConfigLoaderTest, CacheRoundTrip) {
+    std::string config_content = R"(
+        [load.cached_data]
+        binary = "cached.bin"
+        offsetSecurity = "0x10"
+        readMode = "mapped"
+        compression = "zstd"
+        checksum = "0x1234ABCD"
+        readFromContext = "memory_region"
+        
+        [load.cached_data.writeInContext]
+        enabled = true
+        name = "loaded_data"
+    )";
+    
+    create_test_file("cached.toml", config_content);
+    
+    auto loaded = loader_->load_configs(ConfigType::Load, get_test_file_path("cached.toml"), "test_task");
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_NE(loader_->cache_version(), 0u);
+    
+    app_hook::util::ByteWriter out;
+    ASSERT_TRUE(loader_->serialize_configs(*loaded, out));
+    
+    app_hook::util::ByteReader in(out.data());
+    auto restored = loader_->deserialize_configs(ConfigType::Load, in, "test_task");
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->size(), 1);
+    EXPECT_EQ(in.remaining(), 0u);
+    
+    const auto* original = static_cast<LoadInMemoryConfig*>((*loaded)[0].get());
+    const auto* config = static_cast<LoadInMemoryConfig*>((*restored)[0].get());
+    EXPECT_EQ(config->key(), original->key());
+    EXPECT_EQ(config->name(), original->name());
+    EXPECT_EQ(config->binary_path(), original->binary_path());
+    EXPECT_EQ(config->offset_security(), original->offset_security());
+    EXPECT_EQ(config->read_mode(), BinaryReadMode::mapped);
+    EXPECT_EQ(config->compression(), BinaryCompression::zstd);
+    EXPECT_TRUE(config->verify());
+    EXPECT_EQ(config->checksum(), 0x1234ABCDu);
+    EXPECT_FALSE(config->preload());
+    EXPECT_EQ(config->read_from_context(), "memory_region");
+    EXPECT_EQ(config->write_in_context().name, "loaded_data");
+}
+
+TEST_F(LoadInMemoryConfigLoaderTest, CacheRejectsTruncatedSnapshot) {
+    create_test_file("truncated.toml", R"(
+        [load.data]
+        binary = "data.bin"
+    )");
+    
+    auto loaded = loader_->load_configs(ConfigType::Load, get_test_file_path("truncated.toml"), "test_task");
+    ASSERT_TRUE(loaded.has_value());
+    
+    app_hook::util::ByteWriter out;
+    ASSERT_TRUE(loader_->serialize_configs(*loaded, out));
+    
+    const auto data = out.data();
+    app_hook::util::ByteReader in(data.first(data.size() - 1));
+    EXPECT_FALSE(loader_->deserialize_configs(ConfigType::Load, in, "test_task").has_value());
+}
@@ -3,10 +3,14 @@
 #include "../memory_plugin/include/memory/load_in_memory.hpp"
 #include "../memory_plugin/include/config/load_in_memory_config.hpp"
 #include "../memory_plugin/include/memory/memory_region.hpp"
+#include "../memory_plugin/include/memory/region_arena.hpp"
 #include "mock_plugin_host.hpp"
+#include "util/crc32c.hpp"
+#include <zstd.h>
 #include <filesystem>
 #include <fstream>
 #include <cstring>
+#include <vector>
 
 using namespace app_hook::memory;
 using namespace app_hook::config;
@@ -280,4 +284,192 @@ TEST_F(LoadInMemoryTaskTest, ExecuteFileReadError) {
     
     EXPECT_FALSE(result.has_value());
     EXPECT_EQ(result.error(), TaskError::file_not_found);  // Will fail because file was deleted
-} 
\ No newline at end of file
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteMappedWithNonExistentFile) {
+    auto config = create_context_config();
+    config.set_binary_path((temp_dir_ / "missing.bin").string());
+    config.set_read_mode(BinaryReadMode::mapped);
+    
+    LoadInMemoryTask task(std::move(config));
+    task.setHost(mock_host_.get());
+    
+    auto result = task.execute();
+    
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::file_not_found);
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteMappedCopiesIntoContextRegion) {
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("mapped_target_region", MemoryRegion{64, 16, 0x401000, "Mapped target"});
+    
+    LoadInMemoryConfig config("mapped_key", "mapped_load");
+    config.set_binary_path(test_binary_path_);
+    config.set_read_from_context("mapped_target_region");
+    config.set_offset_security(4);
+    config.set_read_mode(BinaryReadMode::mapped);
+    
+    WriteContextConfig write_config;
+    write_config.enabled = true;
+    write_config.name = "mapped_loaded_data";
+    config.set_write_in_context(std::move(write_config));
+    
+    // No host: the task falls back to the singleton context
+    LoadInMemoryTask task(std::move(config));
+    auto result = task.execute();
+    ASSERT_TRUE(result.has_value());
+    
+    auto* target = context.get_data<MemoryRegion>("mapped_target_region");
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(target->data[16 + 4], 0xDE);
+    EXPECT_EQ(target->data[16 + 4 + 15], 0xF0);
+    
+    // The published region is a view into the target, not a copy
+    auto* loaded = context.get_data<MemoryRegion>("mapped_loaded_data");
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_TRUE(loaded->is_view());
+    EXPECT_EQ(loaded->parent_key, "mapped_target_region");
+    EXPECT_EQ(loaded->base(), target->data.get() + 16 + 4);
+    EXPECT_EQ(loaded->size, 16u);
+    EXPECT_EQ(loaded->base()[0], 0xDE);
+    
+    EXPECT_TRUE(context.remove_data("mapped_target_region"));
+    EXPECT_TRUE(context.remove_data("mapped_loaded_data"));
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteRejectsBinaryLargerThanRegion) {
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("small_target_region", MemoryRegion{24, 16, 0x401000, "Small target"});
+    
+    LoadInMemoryConfig config("small_key", "small_load");
+    config.set_binary_path(test_binary_path_);
+    config.set_read_from_context("small_target_region");
+    
+    LoadInMemoryTask task(std::move(config));
+    auto result = task.execute();
+    
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::invalid_address);
+    EXPECT_TRUE(context.remove_data("small_target_region"));
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteGrowsReservedRegion) {
+    auto& context = app_hook::context::ModContext::instance();
+    auto& arena = RegionArena::instance();
+    auto* base = arena.reserve("grow_target_region", 1024 * 1024, 16);
+    ASSERT_NE(base, nullptr);
+    context.store_data("grow_target_region",
+                       MemoryRegion::make_reserved_region(base, 16, 1024 * 1024, 16, 0x401000, "Growable target"));
+    
+    LoadInMemoryConfig config("grow_key", "grow_load");
+    config.set_binary_path(test_binary_path_);
+    config.set_read_from_context("grow_target_region");
+    config.set_offset_security(8);
+    
+    LoadInMemoryTask task(std::move(config));
+    ASSERT_TRUE(task.execute().has_value());
+    
+    // The region grew in place to hold the binary
+    auto* target = context.get_data<MemoryRegion>("grow_target_region");
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(target->base(), base);
+    EXPECT_EQ(target->size, 16u + 8 + 16);
+    EXPECT_EQ(base[16 + 8], 0xDE);
+    EXPECT_EQ(base[16 + 8 + 15], 0xF0);
+    EXPECT_TRUE(context.remove_data("grow_target_region"));
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteDecodesCompressedBinaryIntoContextRegion) {
+    std::vector<std::uint8_t> raw(48);
+    for (std::size_t i = 0; i < raw.size(); ++i) {
+        raw[i] = static_cast<std::uint8_t>(0xA0 + i % 4);
+    }
+    std::vector<std::uint8_t> compressed(ZSTD_compressBound(raw.size()));
+    compressed.resize(ZSTD_compress(compressed.data(), compressed.size(), raw.data(), raw.size(), 3));
+    
+    const auto compressed_path = (temp_dir_ / "compressed.bin.zst").string();
+    {
+        std::ofstream file(compressed_path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+    }
+    
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("compressed_target_region", MemoryRegion{80, 16, 0x401000, "Compressed target"});
+    
+    LoadInMemoryConfig config("compressed_key", "compressed_load");
+    config.set_binary_path(compressed_path);
+    config.set_read_from_context("compressed_target_region");
+    config.set_preload(false);
+    config.set_compression(BinaryCompression::zstd);
+    
+    WriteContextConfig write_config;
+    write_config.enabled = true;
+    write_config.name = "compressed_loaded_data";
+    config.set_write_in_context(std::move(write_config));
+    
+    LoadInMemoryTask task(std::move(config));
+    ASSERT_TRUE(task.execute().has_value());
+    
+    // The decoded bytes land in the region, and the view covers the decoded size
+    auto* target = context.get_data<MemoryRegion>("compressed_target_region");
+    ASSERT_NE(target, nullptr);
+    EXPECT_EQ(std::memcmp(target->data.get() + 16, raw.data(), raw.size()), 0);
+    
+    auto* loaded = context.get_data<MemoryRegion>("compressed_loaded_data");
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->size, raw.size());
+    
+    EXPECT_TRUE(context.remove_data("compressed_target_region"));
+    EXPECT_TRUE(context.remove_data("compressed_loaded_data"));
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteRejectsUndecodableBinary) {
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("undecodable_target_region", MemoryRegion{64, 16, 0x401000, "Undecodable target"});
+    
+    // The raw test pattern is not an LZ4 frame
+    LoadInMemoryConfig config("undecodable_key", "undecodable_load");
+    config.set_binary_path(test_binary_path_);
+    config.set_read_from_context("undecodable_target_region");
+    config.set_preload(false);
+    config.set_compression(BinaryCompression::lz4);
+    
+    LoadInMemoryTask task(std::move(config));
+    auto result = task.execute();
+    
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::file_read_error);
+    EXPECT_TRUE(context.remove_data("undecodable_target_region"));
+}
+
+TEST_F(LoadInMemoryTaskTest, ExecuteVerifiesInjectedBytes) {
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("verify_target_region", MemoryRegion{64, 16, 0x401000, "Verify target"});
+    
+    LoadInMemoryConfig config("verify_key", "verify_load");
+    config.set_binary_path(test_binary_path_);
+    config.set_read_from_context("verify_target_region");
+    config.set_preload(false);
+    config.set_verify(true);
+    
+    // Compared with the source read from disk
+    LoadInMemoryTask task(config);
+    EXPECT_TRUE(task.execute().has_value());
+    
+    // A checksum that does not match the file fails the task
+    auto* target = context.get_data<MemoryRegion>("verify_target_region");
+    ASSERT_NE(target, nullptr);
+    const auto actual = app_hook::util::crc32c({target->data.get() + 16, 16});
+    config.set_checksum(actual ^ 0x80000000u);
+    LoadInMemoryTask mismatched(config);
+    auto result = mismatched.execute();
+    EXPECT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::copy_failed);
+    
+    config.set_checksum(actual);
+    LoadInMemoryTask matched(std::move(config));
+    EXPECT_TRUE(matched.execute().has_value());
+    
+    EXPECT_TRUE(context.remove_data("verify_target_region"));
+}
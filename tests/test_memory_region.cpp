@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <format>
 #include "memory/memory_region.hpp"
 #include <array>
 #include <algorithm>
@@ -248,6 +249,19 @@ TEST_F(MemoryRegionTest, ToStringLargeDataWithNewlines) {
     EXPECT_EQ(newline_count, 1); // Should have 1 newline for 32 bytes (after first 16)
 }
 
+TEST_F(MemoryRegionTest, HexDumpMatchesToString) {
+    MemoryRegion region(20, 20, 0x401000, "Hex dump");
+    for (std::size_t i = 0; i < region.size; ++i) {
+        region.data[i] = static_cast<std::uint8_t>(0xF0 + i);
+    }
+    
+    const auto dump = region.hex(2, 100);
+    EXPECT_EQ(dump.bytes().size(), 18u);
+    EXPECT_EQ(dump.bytes().data(), region.data.get() + 2);
+    EXPECT_EQ(std::format("{}", dump), region.to_string(2, 100));
+    EXPECT_TRUE(region.hex(20, 4).bytes().empty());
+}
+
 TEST_F(MemoryRegionTest, ZeroSizeRegion) {
     MemoryRegion region(0, 0, 0x55555555, "Zero size");
     
@@ -261,4 +275,70 @@ TEST_F(MemoryRegionTest, ZeroSizeRegion) {
     EXPECT_EQ(result, "Invalid offset or null data");
 }
 
-} // namespace app_hook::memory 
\ No newline at end of file
+TEST_F(MemoryRegionTest, OwnedRegionStorage) {
+    MemoryRegion region(16, 8, 0x401000, "Owned");
+    
+    EXPECT_EQ(region.storage(), RegionStorage::owned);
+    EXPECT_FALSE(region.is_view());
+    EXPECT_EQ(region.base(), region.data.get());
+    EXPECT_TRUE(region.parent_key.empty());
+}
+
+TEST_F(MemoryRegionTest, ViewSharesParentBytes) {
+    MemoryRegion parent(32, 16, 0x401000, "Parent");
+    for (std::size_t i = 0; i < parent.size; ++i) {
+        parent.data[i] = static_cast<std::uint8_t>(i);
+    }
+    
+    auto view = MemoryRegion::make_view(parent.data.get() + 16, 8, "parent_key", "View");
+    
+    EXPECT_EQ(view.storage(), RegionStorage::view);
+    EXPECT_TRUE(view.is_view());
+    EXPECT_EQ(view.data, nullptr);
+    EXPECT_EQ(view.base(), parent.data.get() + 16);
+    EXPECT_EQ(view.size, 8u);
+    EXPECT_EQ(view.parent_key, "parent_key");
+    EXPECT_EQ(view.original_address, reinterpret_cast<std::uintptr_t>(parent.data.get() + 16));
+    
+    // Writes through the view land in the parent
+    view.span()[0] = 0xAA;
+    EXPECT_EQ(parent.data[16], 0xAA);
+    EXPECT_EQ(view.to_string(1, 1), "0x11");
+}
+
+TEST_F(MemoryRegionTest, ViewIsMovable) {
+    MemoryRegion parent(16, 16, 0x401000, "Parent");
+    auto view = MemoryRegion::make_view(parent.data.get(), 16, "parent_key", "View");
+    
+    MemoryRegion moved(std::move(view));
+    EXPECT_TRUE(moved.is_view());
+    EXPECT_EQ(moved.base(), parent.data.get());
+}
+
+TEST_F(MemoryRegionTest, ArenaRegionUsesExternalBytes) {
+    std::uint8_t block[64] = {};
+    block[0] = 0x5A;
+    auto region = MemoryRegion::make_arena_region(block, 64, 32, 0x401000, "Arena");
+    
+    EXPECT_EQ(region.storage(), RegionStorage::arena);
+    EXPECT_FALSE(region.is_view());
+    EXPECT_EQ(region.data.get(), nullptr);
+    EXPECT_EQ(region.base(), block);
+    EXPECT_EQ(region.original_size, 32u);
+    EXPECT_EQ(region.span()[0], 0x5A);
+    EXPECT_FALSE(region.can_grow_to(65));
+}
+
+TEST_F(MemoryRegionTest, ReservedRegionGrowsUpToCapacity) {
+    std::uint8_t block[64] = {};
+    auto region = MemoryRegion::make_reserved_region(block, 16, 64, 8, 0x401000, "Reserved");
+    
+    EXPECT_EQ(region.storage(), RegionStorage::reserved);
+    EXPECT_EQ(region.base(), block);
+    EXPECT_EQ(region.size, 16u);
+    EXPECT_EQ(region.capacity, 64u);
+    EXPECT_TRUE(region.can_grow_to(64));
+    EXPECT_FALSE(region.can_grow_to(65));
+}
+
+} // namespace app_hook::memory
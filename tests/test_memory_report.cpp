@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "util/memory_report.hpp"
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace app_hook::util {
+
+TEST(MemoryAccountingTest, CollectsSourcesInRegistrationOrder) {
+    MemoryAccounting accounting;
+    accounting.add_source("first", [] { return std::vector<MemoryUsage>{{"a", 1, 100}, {"b", 2, 200}}; });
+    accounting.add_source("second", [] { return std::vector<MemoryUsage>{{"c", 3, 300}}; });
+    
+    const auto report = accounting.report();
+    ASSERT_EQ(report.entries.size(), 3u);
+    EXPECT_EQ(report.entries[0].category, "a");
+    EXPECT_EQ(report.entries[2].category, "c");
+    EXPECT_EQ(report.total_bytes(), 600u);
+    ASSERT_NE(report.find("b"), nullptr);
+    EXPECT_EQ(report.find("b")->count, 2u);
+    EXPECT_EQ(report.find("missing"), nullptr);
+}
+
+TEST(MemoryAccountingTest, KeepsPeakAcrossReports) {
+    MemoryAccounting accounting;
+    std::size_t bytes = 4096;
+    accounting.add_source("arena", [&bytes] { return std::vector<MemoryUsage>{{"arena", 1, bytes}}; });
+    
+    EXPECT_EQ(accounting.report().find("arena")->peak_bytes, 4096u);
+    bytes = 1024;
+    const auto report = accounting.report();
+    EXPECT_EQ(report.find("arena")->bytes, 1024u);
+    EXPECT_EQ(report.find("arena")->peak_bytes, 4096u);
+}
+
+TEST(MemoryAccountingTest, SourcePeakOverridesObservedBytes) {
+    MemoryAccounting accounting;
+    accounting.add_source("stubs", [] {
+        MemoryUsage usage{"stubs", 1, 64};
+        usage.peak_bytes = 640;
+        return std::vector<MemoryUsage>{usage};
+    });
+    
+    EXPECT_EQ(accounting.report().find("stubs")->peak_bytes, 640u);
+}
+
+TEST(MemoryAccountingTest, ReplacesAndRemovesSourcesByName) {
+    MemoryAccounting accounting;
+    accounting.add_source("plugin", [] { return std::vector<MemoryUsage>{{"old", 1, 1}}; });
+    accounting.add_source("plugin", [] { return std::vector<MemoryUsage>{{"new", 1, 1}}; });
+    EXPECT_EQ(accounting.source_count(), 1u);
+    EXPECT_NE(accounting.report().find("new"), nullptr);
+    
+    EXPECT_TRUE(accounting.remove_source("plugin"));
+    EXPECT_FALSE(accounting.remove_source("plugin"));
+    EXPECT_TRUE(accounting.report().entries.empty());
+}
+
+TEST(MemoryAccountingTest, FailingSourceDoesNotHideOthers) {
+    MemoryAccounting accounting;
+    accounting.add_source("broken", []() -> std::vector<MemoryUsage> { throw std::runtime_error("boom"); });
+    accounting.add_source("fine", [] { return std::vector<MemoryUsage>{{"fine", 1, 8}}; });
+    
+    const auto report = accounting.report();
+    ASSERT_EQ(report.entries.size(), 1u);
+    EXPECT_EQ(report.entries[0].category, "fine");
+}
+
+TEST(MemoryAccountingTest, SourceMayQueryTheRegistry) {
+    MemoryAccounting accounting;
+    accounting.add_source("self", [&accounting] {
+        return std::vector<MemoryUsage>{{"sources", accounting.source_count(), 0}};
+    });
+    
+    EXPECT_EQ(accounting.report().find("sources")->count, 1u);
+}
+
+TEST(AddressSpaceTest, ReportsFreeSpaceAndLargestBlock) {
+    const auto space = query_address_space();
+    EXPECT_GT(space.free_bytes, 0u);
+    EXPECT_GT(space.committed_bytes, 0u);
+    EXPECT_GE(space.free_bytes, space.largest_free_block);
+    EXPECT_GE(space.fragmentation(), 0.0);
+    EXPECT_LT(space.fragmentation(), 1.0);
+}
+
+TEST(AddressSpaceTest, FragmentationOfEmptySpaceIsZero) {
+    EXPECT_EQ(AddressSpaceUsage{}.fragmentation(), 0.0);
+    
+    AddressSpaceUsage split;
+    split.free_bytes = 4 * 1024 * 1024;
+    split.largest_free_block = 1024 * 1024;
+    EXPECT_DOUBLE_EQ(split.fragmentation(), 0.75);
+}
+
+} // namespace app_hook::util
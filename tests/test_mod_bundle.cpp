@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include "config/config_cache.hpp"
+#include "config/config_factory.hpp"
+#include "config/config_loader_base.hpp"
+#include "config/mod_bundle.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace app_hook::config {
+
+namespace {
+
+// Loader counting its parses; caches the description only
+class DescriptionLoader : public ConfigLoaderBase {
+public:
+    explicit DescriptionLoader(int& parses) : parses_(parses) {}
+
+    std::string get_name() const override { return "DescriptionLoader"; }
+    std::string get_version() const override { return "1.0.0"; }
+    std::vector<ConfigType> supported_types() const override { return {ConfigType::Script}; }
+
+    ConfigResult<std::vector<ConfigPtr>> load_configs(
+        ConfigType type, const std::string& file_path, const std::string& task_name) override {
+        ++parses_;
+        std::ifstream file(file_path);
+        std::string description;
+        std::getline(file, description);
+        auto config = std::make_shared<ConfigBase>(type, task_name + "_script", task_name);
+        config->set_description(description);
+        return std::vector<ConfigPtr>{config};
+    }
+
+    std::uint32_t cache_version() const override { return 1; }
+
+    bool serialize_configs(const std::vector<ConfigPtr>& configs, util::ByteWriter& out) const override {
+        out.write_string(configs.at(0)->description());
+        return true;
+    }
+
+    ConfigResult<std::vector<ConfigPtr>> deserialize_configs(
+        ConfigType type, util::ByteReader& in, const std::string& task_name) override {
+        std::string description;
+        if (!in.read_string(description)) {
+            return std::unexpected(ConfigError::invalid_format);
+        }
+        auto config = std::make_shared<ConfigBase>(type, task_name + "_script", task_name);
+        config->set_description(description);
+        return std::vector<ConfigPtr>{config};
+    }
+
+private:
+    int& parses_;
+};
+
+} // namespace
+
+class ModBundleTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() / "app_hook_mod_bundle_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_ / "data");
+    }
+
+    void TearDown() override {
+        (void)ConfigFactory::unregister_loader("DescriptionLoader");
+        std::filesystem::remove_all(dir_);
+    }
+
+    void write_file(const std::filesystem::path& name, const std::string& content) {
+        std::ofstream file(dir_ / name, std::ios::binary | std::ios::trunc);
+        file << content;
+    }
+
+    std::filesystem::path bundle_path() const { return dir_ / ModBundle::kFileName; }
+
+    std::filesystem::path dir_;
+};
+
+TEST_F(ModBundleTest, RoundTripsEntriesAndAlignsBlobs) {
+    BundleWriter writer;
+    writer.add(BundleEntryKind::configs, "memory/patches.toml", {1, 2, 3}, "PatchLoader", 7, "patch_task");
+    writer.add(BundleEntryKind::blob, "data/field.bin", std::vector<std::uint8_t>(5000, 0xAB));
+    writer.add(BundleEntryKind::tasks, "tasks.toml", {9});
+    ASSERT_TRUE(writer.write(bundle_path(), {}));
+
+    auto bundle = ModBundle::open(dir_);
+    ASSERT_TRUE(bundle.has_value());
+    ASSERT_EQ((*bundle)->entries().size(), 3u);
+
+    const auto* configs = (*bundle)->find_file(BundleEntryKind::configs, dir_ / "memory" / "patches.toml");
+    ASSERT_NE(configs, nullptr);
+    EXPECT_EQ(configs->loader, "PatchLoader");
+    EXPECT_EQ(configs->version, 7u);
+    EXPECT_EQ(configs->task, "patch_task");
+    EXPECT_EQ(std::vector<std::uint8_t>(configs->data.begin(), configs->data.end()), (std::vector<std::uint8_t>{1, 2, 3}));
+
+    // Kinds do not share entries even under the same key
+    EXPECT_EQ((*bundle)->find(BundleEntryKind::blob, "memory/patches.toml"), nullptr);
+
+    const auto blob = (*bundle)->blob("data/./field.bin");
+    ASSERT_EQ(blob.size(), 5000u);
+    EXPECT_EQ(blob[4999], 0xAB);
+    EXPECT_TRUE((*bundle)->blob("data/missing.bin").empty());
+
+    // Views start on a page, so blobs start on a page of memory too
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(blob.data()) % ModBundle::kBlobAlignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(configs->data.data()) % ModBundle::kPayloadAlignment, 0u);
+    EXPECT_GE(std::filesystem::file_size(bundle_path()), 4096u + 5000u);
+}
+
+TEST_F(ModBundleTest, MissingOrCorruptBundleIsRejected) {
+    auto missing = ModBundle::open(dir_);
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error(), ConfigError::file_not_found);
+
+    write_file(ModBundle::kFileName, "this is not a bundle, only some text long enough for a header");
+    auto corrupt = ModBundle::open(dir_);
+    ASSERT_FALSE(corrupt.has_value());
+    EXPECT_EQ(corrupt.error(), ConfigError::invalid_format);
+
+    // A bundle cut short inside its data points past the end of the file
+    BundleWriter writer;
+    writer.add(BundleEntryKind::blob, "data/field.bin", std::vector<std::uint8_t>(100, 1));
+    ASSERT_TRUE(writer.write(bundle_path(), {}));
+    std::filesystem::resize_file(bundle_path(), std::filesystem::file_size(bundle_path()) - 10);
+    EXPECT_FALSE(ModBundle::open(dir_).has_value());
+}
+
+TEST_F(ModBundleTest, ConfigKeysAreRelativeToTheConfigDir) {
+    EXPECT_EQ(ModBundle::config_key("config", "config/memory/../tasks.toml"), "tasks.toml");
+    EXPECT_EQ(ModBundle::config_key("config", "config/memory/patches.toml"), "memory/patches.toml");
+    EXPECT_EQ(ModBundle::blob_key("mods/./field.bin"), "mods/field.bin");
+}
+
+TEST_F(ModBundleTest, PackedConfigsAreServedWithoutTheirFiles) {
+    int parses = 0;
+    ASSERT_TRUE(ConfigFactory::register_loader(std::make_unique<DescriptionLoader>(parses)));
+    write_file("script.toml", "packed description");
+    write_file("data/field.bin", "binary bytes");
+    const auto script = (dir_ / "script.toml").string();
+
+    {
+        ConfigCache cache(dir_);
+        ASSERT_TRUE(cache.load_configs(ConfigType::Script, script, "script_task").has_value());
+        ASSERT_TRUE(cache.save());
+        const std::vector<std::string> blobs = {(dir_ / "data/field.bin").string(), (dir_ / "data/gone.bin").string()};
+        ASSERT_TRUE(cache.write_bundle(blobs));
+    }
+    EXPECT_EQ(parses, 1);
+
+    // Only the bundle ships: neither the config nor its cache are on disk
+    std::filesystem::remove(dir_ / "script.toml");
+    std::filesystem::remove(dir_ / ConfigCache::kFileName);
+
+    auto bundle = ModBundle::open(dir_);
+    ASSERT_TRUE(bundle.has_value());
+    const auto blob = (*bundle)->blob((dir_ / "data/field.bin").string());
+    EXPECT_EQ(std::string(blob.begin(), blob.end()), "binary bytes");
+    EXPECT_TRUE((*bundle)->blob((dir_ / "data/gone.bin").string()).empty());
+
+    ConfigCache cache(dir_);
+    cache.attach_bundle(*bundle);
+    auto configs = cache.load_configs(ConfigType::Script, script, "script_task");
+    ASSERT_TRUE(configs.has_value());
+    ASSERT_EQ(configs->size(), 1u);
+    EXPECT_EQ((*configs)[0]->description(), "packed description");
+    EXPECT_EQ(parses, 1);
+    EXPECT_EQ(cache.hits(), 1u);
+}
+
+} // namespace app_hook::config
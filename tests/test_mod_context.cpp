@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "context/mod_context.hpp"
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <thread>
@@ -400,4 +402,271 @@ TEST_F(ModContextTest, KeyWithSpecialCharacters) {
     EXPECT_EQ(*retrieved, value);
 }
 
-} // namespace app_hook::context 
\ No newline at end of file
+TEST_F(ModContextTest, InternReturnsStableHandle) {
+    auto& context = ModContext::instance();
+    
+    const auto first = context.intern("test.intern.stable");
+    const auto second = context.intern("test.intern.stable");
+    ASSERT_TRUE(first.valid());
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, context.intern("test.intern.other"));
+    EXPECT_EQ(context.key_name(first), "test.intern.stable");
+    EXPECT_EQ(context.find_key("test.intern.stable"), first);
+    EXPECT_FALSE(context.find_key("test.intern.never_used").valid());
+}
+
+TEST_F(ModContextTest, HandleAndStringApisShareSlots) {
+    auto& context = ModContext::instance();
+    const std::string key = "test.intern.shared";
+    const auto handle = context.intern(key);
+    
+    ASSERT_TRUE(context.store(handle, 42));
+    auto* by_string = context.get_data<int>(key);
+    ASSERT_NE(by_string, nullptr);
+    EXPECT_EQ(*by_string, 42);
+    
+    context.store_data(key, 43);
+    auto* by_handle = context.get<int>(handle);
+    ASSERT_NE(by_handle, nullptr);
+    EXPECT_EQ(*by_handle, 43);
+    EXPECT_EQ(context.get<double>(handle), nullptr);
+}
+
+TEST_F(ModContextTest, HandleReadsMoveOnlyData) {
+    auto& context = ModContext::instance();
+    const auto handle = context.intern("test.intern.move_only");
+    
+    ASSERT_TRUE(context.store(handle, MoveOnlyData(7)));
+    auto* retrieved = context.get<MoveOnlyData>(handle);
+    ASSERT_NE(retrieved, nullptr);
+    EXPECT_EQ(retrieved->get_value(), 7);
+    EXPECT_NE(context.get<std::shared_ptr<MoveOnlyData>>(handle), nullptr);
+}
+
+TEST_F(ModContextTest, RemovedSlotKeepsHandle) {
+    auto& context = ModContext::instance();
+    const std::string key = "test.intern.removed";
+    const auto handle = context.intern(key);
+    
+    ASSERT_TRUE(context.store(handle, std::string("value")));
+    EXPECT_TRUE(context.remove(handle));
+    EXPECT_FALSE(context.remove(handle));
+    EXPECT_FALSE(context.has(handle));
+    EXPECT_FALSE(context.has_data(key));
+    EXPECT_EQ(context.get<std::string>(handle), nullptr);
+    
+    ASSERT_TRUE(context.store(handle, std::string("again")));
+    ASSERT_NE(context.get_data<std::string>(key), nullptr);
+    EXPECT_EQ(*context.get_data<std::string>(key), "again");
+}
+
+TEST_F(ModContextTest, InvalidHandleIsRejected) {
+    auto& context = ModContext::instance();
+    const ContextKey invalid;
+    
+    EXPECT_FALSE(invalid.valid());
+    EXPECT_FALSE(context.store(invalid, 1));
+    EXPECT_EQ(context.get<int>(invalid), nullptr);
+    EXPECT_FALSE(context.has(invalid));
+    EXPECT_TRUE(context.key_name(invalid).empty());
+}
+
+TEST_F(ModContextTest, HandleReadsDuringConcurrentInterning) {
+    auto& context = ModContext::instance();
+    const auto handle = context.intern("test.intern.hot");
+    ASSERT_TRUE(context.store(handle, 5));
+    
+    std::atomic<bool> ok{true};
+    std::thread reader([&] {
+        for (int i = 0; i < 10000; ++i) {
+            const auto* value = context.get<int>(handle);
+            if (!value || *value != 5) {
+                ok = false;
+            }
+        }
+    });
+    for (int i = 0; i < 1000; ++i) {
+        context.store_data("test.intern.grow." + std::to_string(i), i);
+    }
+    reader.join();
+    
+    EXPECT_TRUE(ok.load());
+}
+
+TEST_F(ModContextTest, ForEachKeyFiltersByPrefix) {
+    auto& context = ModContext::instance();
+    context.store_data("test.prefix.a", 1);
+    context.store_data("test.prefix.b", 2);
+    context.store_data("test.other.c", 3);
+    (void)context.intern("test.prefix.empty");  // interned but never stored
+    
+    std::vector<std::string> visited;
+    int sum = 0;
+    context.for_each_key("test.prefix.", [&](const std::string& key, ContextKey handle) {
+        visited.push_back(key);
+        sum += *context.get<int>(handle);
+    });
+    
+    std::sort(visited.begin(), visited.end());
+    EXPECT_EQ(visited, (std::vector<std::string>{"test.prefix.a", "test.prefix.b"}));
+    EXPECT_EQ(sum, 3);
+}
+
+TEST_F(ModContextTest, ForEachKeyAllowsRemoval) {
+    auto& context = ModContext::instance();
+    for (int i = 0; i < 10; ++i) {
+        context.store_data("test.remove_each." + std::to_string(i), i);
+    }
+    
+    context.for_each_key("test.remove_each.", [&](const std::string&, ContextKey handle) {
+        if (*context.get<int>(handle) % 2 == 0) {
+            EXPECT_TRUE(context.remove(handle));
+        }
+    });
+    
+    std::size_t remaining = 0;
+    context.for_each_key("test.remove_each.", [&](const std::string&, ContextKey) { ++remaining; });
+    EXPECT_EQ(remaining, 5u);
+}
+
+TEST_F(ModContextTest, ConcurrentReadersWithWriter) {
+    auto& context = ModContext::instance();
+    const std::string key = "test.readers.value";
+    context.store_data(key, std::string("stable"));
+    
+    std::atomic<bool> stop{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                const auto* value = context.get_data<std::string>(key);
+                if (!value || !context.has_data(key)) {
+                    ++failures;
+                }
+                context.for_each_key("test.readers.", [](const std::string&, ContextKey) {});
+            }
+        });
+    }
+    for (int i = 0; i < 500; ++i) {
+        context.store_data("test.readers.extra." + std::to_string(i), i);
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    EXPECT_EQ(failures.load(), 0);
+}
+
+namespace {
+
+struct Accounted {
+    std::size_t footprint_bytes() const noexcept { return 1000; }
+};
+
+} // namespace
+
+TEST_F(ModContextTest, UsageByTypeGroupsValues) {
+    ModContext context;
+    context.store_data("a", std::vector<std::uint32_t>(16));
+    context.store_data("b", std::vector<std::uint32_t>(4));
+    context.store_data("c", Accounted{});
+    context.store_data("d", std::make_shared<Accounted>());
+    context.store_data("e", std::make_unique<int>(1));
+    
+    const auto usage = context.usage_by_type();
+    const auto find = [&usage](const std::type_info& type) {
+        return std::find_if(usage.begin(), usage.end(), [&type](const auto& entry) { return *entry.type == type; });
+    };
+    
+    const auto vectors = find(typeid(std::vector<std::uint32_t>));
+    ASSERT_NE(vectors, usage.end());
+    EXPECT_EQ(vectors->count, 2u);
+    EXPECT_GE(vectors->bytes, 2 * sizeof(std::vector<std::uint32_t>) + 20 * sizeof(std::uint32_t));
+    
+    // A value with footprint_bytes() reports it, also when held by a shared_ptr
+    const auto accounted = find(typeid(Accounted));
+    ASSERT_NE(accounted, usage.end());
+    EXPECT_EQ(accounted->count, 2u);
+    EXPECT_EQ(accounted->bytes, 2000u + sizeof(std::shared_ptr<Accounted>));
+    
+    // Move-only values are grouped under their own type, not the shared_ptr wrapper
+    EXPECT_NE(find(typeid(std::unique_ptr<int>)), usage.end());
+}
+
+TEST_F(ModContextTest, UsageByTypeSkipsRemovedValues) {
+    ModContext context;
+    context.store_data("a", 1);
+    context.store_data("b", 2);
+    EXPECT_TRUE(context.remove_data("a"));
+    
+    const auto usage = context.usage_by_type();
+    ASSERT_EQ(usage.size(), 1u);
+    EXPECT_EQ(usage[0].count, 1u);
+    EXPECT_EQ(usage[0].bytes, sizeof(int));
+    EXPECT_GT(context.table_bytes(), 0u);
+}
+
+namespace {
+
+/// @brief Value counting its live instances
+struct Tracked {
+    explicit Tracked(int v, std::atomic<int>& live) : value(v), live_(&live) { ++*live_; }
+    Tracked(const Tracked& other) : value(other.value), live_(other.live_) { ++*live_; }
+    Tracked& operator=(const Tracked&) = delete;
+    ~Tracked() { --*live_; }
+
+    int value;
+    std::atomic<int>* live_;
+};
+
+} // namespace
+
+TEST_F(ModContextTest, ReplacedValuesAreFreedByLaterWrites) {
+    std::atomic<int> live{0};
+    {
+        ModContext context;
+        const auto key = context.intern("tracked");
+        for (int i = 0; i < 1000; ++i) {
+            ASSERT_TRUE(context.store(key, Tracked{i, live}));
+        }
+        
+        // Without readers, each write frees what the one before it replaced
+        EXPECT_LE(context.retired_count(), 2u);
+        EXPECT_LE(live.load(), 3);
+        EXPECT_TRUE(context.remove(key));
+    }
+    EXPECT_EQ(live.load(), 0);
+}
+
+TEST_F(ModContextTest, ReadGuardKeepsReplacedValuesAlive) {
+    std::atomic<int> live{0};
+    ModContext context;
+    const auto key = context.intern("tracked");
+    ASSERT_TRUE(context.store(key, Tracked{1, live}));
+    
+    const Tracked* first = nullptr;
+    {
+        const auto guard = context.read_guard();
+        first = context.get<Tracked>(key);
+        ASSERT_NE(first, nullptr);
+        
+        // Overwrites and removals never wait for the reader, and never free what it holds
+        for (int i = 2; i < 100; ++i) {
+            ASSERT_TRUE(context.store(key, Tracked{i, live}));
+        }
+        EXPECT_TRUE(context.remove(key));
+        EXPECT_EQ(first->value, 1);
+        EXPECT_GT(context.retired_count(), 2u);
+    }
+    
+    // Once the guard is gone, the next writes reclaim the backlog
+    ASSERT_TRUE(context.store(key, Tracked{100, live}));
+    ASSERT_TRUE(context.store(key, Tracked{101, live}));
+    ASSERT_TRUE(context.store(key, Tracked{102, live}));
+    EXPECT_LE(context.retired_count(), 2u);
+    EXPECT_LE(live.load(), 3);
+}
+
+} // namespace app_hook::context
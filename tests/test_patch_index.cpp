@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include "memory/patch_index.hpp"
+#include "config/patch_config_loader.hpp"
+#include "util/byte_stream.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace app_hook::memory {
+
+using config::CompiledPatchSet;
+
+class PatchIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "patch_index_test";
+        std::filesystem::create_directories(temp_dir_);
+        PatchIndex::instance().clear();
+    }
+
+    void TearDown() override {
+        PatchIndex::instance().clear();
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    std::string CreatePatchFile(const std::string& filename, const std::string& content) {
+        auto file_path = temp_dir_ / filename;
+        std::ofstream file(file_path);
+        file << content;
+        return file_path.string();
+    }
+
+    std::filesystem::path temp_dir_;
+};
+
+TEST_F(PatchIndexTest, OwnersSharingBytesConflict) {
+    CompiledPatchSet first;
+    ASSERT_TRUE(first.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(first.add_hex(0x401005, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(first.add_hex(0x402000, "A1 XX XX XX XX", 0));
+    CompiledPatchSet second;
+    ASSERT_TRUE(second.add_hex(0x401008, "8B 0D XX XX XX XX", 0));
+    ASSERT_TRUE(second.add_hex(0x401FFE, "8B 0D XX XX XX XX", 0));
+
+    PatchIndex index;
+    EXPECT_TRUE(index.claim("first", first.instructions()).empty());
+    EXPECT_EQ(index.size(), 2u);   // The touching instructions are one interval
+
+    const auto conflicts = index.claim("second", second.instructions());
+    ASSERT_EQ(conflicts.size(), 2u);
+    EXPECT_EQ(conflicts[0].address, 0x401008u);
+    EXPECT_EQ(conflicts[0].length, 2u);
+    EXPECT_EQ(conflicts[0].owner, "first");
+    EXPECT_EQ(conflicts[1].address, 0x402000u);
+    EXPECT_EQ(conflicts[1].length, 4u);
+    EXPECT_EQ(index.size(), 2u);
+
+    // Once the first owner is gone the bytes are free
+    index.release("first");
+    EXPECT_TRUE(index.claim("second", second.instructions()).empty());
+    EXPECT_EQ(index.size(), 2u);
+}
+
+TEST_F(PatchIndexTest, ClaimingAgainReplacesTheOwnersClaims) {
+    CompiledPatchSet before;
+    ASSERT_TRUE(before.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    CompiledPatchSet after;
+    ASSERT_TRUE(after.add_hex(0x401002, "8B 0D XX XX XX XX", 0));
+    CompiledPatchSet other;
+    ASSERT_TRUE(other.add_hex(0x401000, "B8 XX XX XX XX", 0));
+
+    PatchIndex index;
+    ASSERT_TRUE(index.claim("task", before.instructions()).empty());
+    EXPECT_TRUE(index.claim("task", after.instructions()).empty());
+    EXPECT_EQ(index.size(), 1u);
+
+    // A rejected claim leaves the owner's previous claims in place
+    CompiledPatchSet elsewhere;
+    ASSERT_TRUE(elsewhere.add_hex(0x403000, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(index.claim("other", elsewhere.instructions()).empty());
+    EXPECT_EQ(index.claim("other", other.instructions()).size(), 1u);
+    EXPECT_EQ(index.claim("third", elsewhere.instructions()).size(), 1u);
+}
+
+TEST_F(PatchIndexTest, KeptOverlapsClaimOnlyFreeIntervals) {
+    CompiledPatchSet first;
+    ASSERT_TRUE(first.add_hex(0x401000, "A1 XX XX XX XX", 0));
+    CompiledPatchSet second;
+    ASSERT_TRUE(second.add_hex(0x401004, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(second.add_hex(0x403000, "B8 XX XX XX XX", 0));
+
+    PatchIndex index;
+    ASSERT_TRUE(index.claim("first", first.instructions()).empty());
+    EXPECT_EQ(index.claim("second", second.instructions(), true).size(), 1u);
+    EXPECT_EQ(index.size(), 2u);
+
+    // The free interval now belongs to the second owner
+    CompiledPatchSet third;
+    ASSERT_TRUE(third.add_hex(0x403002, "B8 XX XX XX XX", 0));
+    const auto conflicts = index.claim("third", third.instructions());
+    ASSERT_EQ(conflicts.size(), 1u);
+    EXPECT_EQ(conflicts[0].owner, "second");
+}
+
+TEST_F(PatchIndexTest, LoaderRejectsOverlappingPatchFiles) {
+    ::memory_plugin::PatchConfigLoader loader;
+    const auto first = CreatePatchFile("first.toml", R"(
+[instructions.0x00401000]
+bytes = "8D 86 XX XX XX XX"
+offset = "0x0"
+)");
+    const auto second = CreatePatchFile("second.toml", R"(
+[instructions.0x00401004]
+bytes = "A1 XX XX XX XX"
+offset = "0x4"
+)");
+    const auto warned = CreatePatchFile("warned.toml", R"(
+[metadata]
+overlap = "warn"
+
+[instructions.0x00401004]
+bytes = "A1 XX XX XX XX"
+offset = "0x4"
+)");
+
+    ASSERT_TRUE(loader.load_configs(config::ConfigType::Patch, first, "first").has_value());
+    EXPECT_EQ(loader.load_configs(config::ConfigType::Patch, second, "second").error(),
+              config::ConfigError::invalid_format);
+
+    // Reloading the same task is not an overlap
+    EXPECT_TRUE(loader.load_configs(config::ConfigType::Patch, first, "first").has_value());
+
+    auto loaded = loader.load_configs(config::ConfigType::Patch, warned, "warned");
+    ASSERT_TRUE(loaded.has_value());
+    const auto* patch_config = static_cast<const config::PatchConfig*>((*loaded)[0].get());
+    EXPECT_TRUE(patch_config->allows_overlap());
+
+    // The policy survives the config cache
+    util::ByteWriter out;
+    ASSERT_TRUE(loader.serialize_configs(*loaded, out));
+    util::ByteReader in(out.data());
+    auto restored = loader.deserialize_configs(config::ConfigType::Patch, in, "warned");
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_TRUE(static_cast<const config::PatchConfig*>((*restored)[0].get())->allows_overlap());
+}
+
+} // namespace app_hook::memory
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "memory/patch_memory.hpp"
+#include "config/memory_config.hpp"
 #include "mock_plugin_host.hpp"
+#include "util/crc32c.hpp"
+#include <cstring>
 
 namespace app_hook::memory {
 
@@ -32,6 +35,273 @@ TEST_F(PatchMemoryTest, BasicInterface) {
     EXPECT_TRUE(true); // Placeholder assertion
 }
 
-// Additional tests would go here once the config infrastructure is available
+TEST_F(PatchMemoryTest, PatchesAreGroupedByPage) {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    const std::size_t page = info.dwPageSize;
+    
+    auto* code = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, page * 2, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READ));
+    ASSERT_NE(code, nullptr);
+    const auto base = reinterpret_cast<std::uintptr_t>(code);
+    
+    auto& context = app_hook::context::ModContext::instance();
+    MemoryRegion region(64, 64, 0x401000, "Patch target");
+    const auto region_base = reinterpret_cast<std::uintptr_t>(region.data.get());
+    context.store_data("patch_group_region", std::move(region));
+    
+    PatchConfig config("patch_group_test", "Patch group test");
+    config.set_read_from_context("patch_group_region");
+    config.set_patch_file_path("unused.toml");
+    
+    // Two patches on the first page, one on the second, listed out of order
+    std::vector<InstructionPatch> patches{
+        {base + page + 16, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 8},
+        {base + 32, {0x8B, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF}, 4},
+        {base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0},
+    };
+    PatchMemoryTask task(std::move(config), std::move(patches));
+    task.setHost(mock_host_.get());
+    
+    ASSERT_TRUE(task.execute().has_value());
+    EXPECT_EQ(task.page_groups(), 2u);
+    
+    std::uintptr_t resolved = 0;
+    std::memcpy(&resolved, code + 1, sizeof(std::uint32_t));
+    EXPECT_EQ(resolved, region_base);
+    std::memcpy(&resolved, code + 34, sizeof(std::uint32_t));
+    EXPECT_EQ(resolved, region_base + 4);
+    std::memcpy(&resolved, code + page + 17, sizeof(std::uint32_t));
+    EXPECT_EQ(resolved, region_base + 8);
+    
+    // Original protection is restored on both pages
+    MEMORY_BASIC_INFORMATION mbi{};
+    ASSERT_NE(VirtualQuery(code + page, &mbi, sizeof(mbi)), 0u);
+    EXPECT_EQ(mbi.Protect, static_cast<DWORD>(PAGE_EXECUTE_READ));
+    
+    (void)context.remove_data("patch_group_region");
+    VirtualFree(code, 0, MEM_RELEASE);
+}
+
+TEST_F(PatchMemoryTest, ConfigBytesCountCompiledPatches) {
+    PatchConfig empty("patch_size_empty", "Patch size empty");
+    PatchMemoryTask empty_task(empty);
+    
+    PatchConfig config("patch_size_test", "Patch size test");
+    std::vector<InstructionPatch> patches(64, InstructionPatch{0x401000, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0});
+    config.set_instructions(patches);
+    PatchMemoryTask task(std::move(config));
+    
+    // The config and the task's sorted copy each hold the instructions and their bytes
+    const auto compiled = 64 * (sizeof(CompiledInstruction) + 5);
+    EXPECT_GE(task.config_bytes(), empty_task.config_bytes() + 2 * compiled);
+    EXPECT_GE(task.config().footprint_bytes(), sizeof(PatchConfig) + compiled);
+}
+
+TEST_F(PatchMemoryTest, CompactKeepsOnlyTheSortedPatches) {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    const std::size_t page = info.dwPageSize;
+    
+    auto* code = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, page, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    ASSERT_NE(code, nullptr);
+    const auto base = reinterpret_cast<std::uintptr_t>(code);
+    
+    auto& context = app_hook::context::ModContext::instance();
+    MemoryRegion region(64, 64, 0x401000, "Compact target");
+    const auto region_base = reinterpret_cast<std::uintptr_t>(region.data.get());
+    context.store_data("patch_compact_region", std::move(region));
+    
+    PatchConfig config("patch_compact_test", "Patch compact test");
+    config.set_read_from_context("patch_compact_region");
+    config.set_instructions({{base + 16, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 4}, {base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0}});
+    PatchMemoryTask task(config);
+    task.setHost(mock_host_.get());
+    
+    const auto before = task.config_bytes();
+    task.compact();
+    EXPECT_TRUE(task.config().compiled().empty());
+    EXPECT_EQ(task.patches().size(), 2u);
+    EXPECT_LT(task.config_bytes(), before);
+    
+    // The inline patch list is gone from the config, yet the task still applies it
+    ASSERT_TRUE(task.execute().has_value());
+    std::uintptr_t resolved = 0;
+    std::memcpy(&resolved, code + 17, sizeof(std::uint32_t));
+    EXPECT_EQ(resolved, region_base + 4);
+    
+    // A reload diffs against the task's copy and leaves the config compact
+    EXPECT_EQ(task.reload(config), task::ReloadOutcome::unchanged);
+    config.set_instructions({{base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 8}});
+    EXPECT_EQ(task.reload(config), task::ReloadOutcome::updated);
+    EXPECT_TRUE(task.config().compiled().empty());
+    
+    task.rollback();
+    (void)context.remove_data("patch_compact_region");
+    VirtualFree(code, 0, MEM_RELEASE);
+}
+
+TEST_F(PatchMemoryTest, ReloadRewritesOnlyChangedInstructions) {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    const std::size_t page = info.dwPageSize;
+    
+    auto* code = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, page, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    ASSERT_NE(code, nullptr);
+    const auto base = reinterpret_cast<std::uintptr_t>(code);
+    
+    auto& context = app_hook::context::ModContext::instance();
+    MemoryRegion region(64, 64, 0x401000, "Reload target");
+    const auto region_base = reinterpret_cast<std::uintptr_t>(region.data.get());
+    context.store_data("patch_reload_region", std::move(region));
+    
+    PatchConfig config("patch_reload_test", "Patch reload test");
+    config.set_read_from_context("patch_reload_region");
+    config.set_instructions({{base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0}, {base + 16, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 4}});
+    PatchMemoryTask task(config);
+    task.setHost(mock_host_.get());
+    EXPECT_EQ(task.reload(config), task::ReloadOutcome::unchanged);
+    ASSERT_TRUE(task.execute().has_value());
+    
+    // Scribble over the first instruction: an untouched instruction must not be rewritten
+    code[0] = 0x90;
+    
+    PatchConfig updated("patch_reload_test", "Patch reload test");
+    updated.set_read_from_context("patch_reload_region");
+    updated.set_instructions({{base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0}, {base + 16, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 12}});
+    EXPECT_EQ(task.reload(updated), task::ReloadOutcome::updated);
+    EXPECT_EQ(task.page_groups(), 1u);
+    
+    EXPECT_EQ(code[0], 0x90);
+    std::uintptr_t resolved = 0;
+    std::memcpy(&resolved, code + 17, sizeof(std::uint32_t));
+    EXPECT_EQ(resolved, region_base + 12);
+    
+    // Another config type cannot be taken over
+    app_hook::config::CopyMemoryConfig other("patch_reload_test", "Other");
+    EXPECT_EQ(task.reload(other), task::ReloadOutcome::restart_required);
+    
+    (void)context.remove_data("patch_reload_region");
+    VirtualFree(code, 0, MEM_RELEASE);
+}
+
+TEST_F(PatchMemoryTest, ReloadRestoresTheTailOfAShortenedInstruction) {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    auto* code = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, info.dwPageSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    ASSERT_NE(code, nullptr);
+    std::memset(code, 0xCC, 32);
+    const auto base = reinterpret_cast<std::uintptr_t>(code);
+    
+    auto& context = app_hook::context::ModContext::instance();
+    MemoryRegion region(64, 64, 0x401000, "Shorten target");
+    const auto region_base = reinterpret_cast<std::uintptr_t>(region.data.get());
+    context.store_data("patch_shorten_region", std::move(region));
+    
+    PatchConfig config("patch_shorten_test", "Patch shorten test");
+    config.set_read_from_context("patch_shorten_region");
+    config.set_instructions({{base, {0xC7, 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0x01, 0x00, 0x00, 0x00}, 0}});
+    PatchMemoryTask task(config);
+    task.setHost(mock_host_.get());
+    ASSERT_TRUE(task.execute().has_value());
+    EXPECT_EQ(code[6], 0x01);
+    
+    // Same address, 5 bytes instead of 10: bytes 5 to 9 get the original code back
+    config.set_instructions({{base, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 8}});
+    EXPECT_EQ(task.reload(config), task::ReloadOutcome::updated);
+    EXPECT_EQ(code[0], 0xA1);
+    std::uintptr_t resolved = 0;
+    std::memcpy(&resolved, code + 1, sizeof(std::uint32_t));
+    EXPECT_EQ(resolved, region_base + 8);
+    for (int i = 5; i < 10; ++i) {
+        EXPECT_EQ(code[i], 0xCC) << "byte " << i;
+    }
+    
+    // The rollback still knows the original bytes of the new instruction
+    task.rollback();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(code[i], 0xCC) << "byte " << i;
+    }
+    
+    (void)context.remove_data("patch_shorten_region");
+    VirtualFree(code, 0, MEM_RELEASE);
+}
+
+TEST_F(PatchMemoryTest, RollbackRestoresRemovedAndAppliedCode) {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    auto* code = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, info.dwPageSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    ASSERT_NE(code, nullptr);
+    std::memset(code, 0xCC, 32);
+    const auto base = reinterpret_cast<std::uintptr_t>(code);
+    
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("patch_rollback_region", MemoryRegion(64, 64, 0x401000, "Rollback target"));
+    
+    PatchConfig config("patch_rollback_test", "Patch rollback test");
+    config.set_read_from_context("patch_rollback_region");
+    config.set_instructions({{base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0}, {base + 16, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 4}});
+    PatchMemoryTask task(config);
+    task.setHost(mock_host_.get());
+    ASSERT_TRUE(task.execute().has_value());
+    
+    // Dropping an instruction on reload puts its original code back
+    PatchConfig updated("patch_rollback_test", "Patch rollback test");
+    updated.set_read_from_context("patch_rollback_region");
+    updated.set_instructions({{base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0}});
+    EXPECT_EQ(task.reload(updated), task::ReloadOutcome::updated);
+    EXPECT_EQ(code[0], 0xB8);
+    EXPECT_EQ(code[16], 0xCC);
+    EXPECT_EQ(code[17], 0xCC);
+    
+    task.rollback();
+    for (std::size_t i = 0; i < 32; ++i) {
+        EXPECT_EQ(code[i], 0xCC) << "byte " << i;
+    }
+    EXPECT_TRUE(task.transaction().empty());
+    
+    (void)context.remove_data("patch_rollback_region");
+    VirtualFree(code, 0, MEM_RELEASE);
+}
+
+TEST_F(PatchMemoryTest, ExpectedOriginalRefusesOtherBuilds) {
+    SYSTEM_INFO info{};
+    GetSystemInfo(&info);
+    auto* code = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, info.dwPageSize, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    ASSERT_NE(code, nullptr);
+    std::memset(code, 0xCC, 32);
+    const auto base = reinterpret_cast<std::uintptr_t>(code);
+    
+    auto& context = app_hook::context::ModContext::instance();
+    context.store_data("patch_expected_region", MemoryRegion(64, 64, 0x401000, "Expected original target"));
+    
+    // The checksum covers the code under each instruction, in address order
+    const std::uint8_t original[5] = {0xCC, 0xCC, 0xCC, 0xCC, 0xCC};
+    const auto expected = app_hook::util::crc32c(original, app_hook::util::crc32c(original));
+    
+    PatchConfig config("patch_expected_test", "Patch expected test");
+    config.set_read_from_context("patch_expected_region");
+    config.set_instructions({{base + 16, {0xA1, 0xFF, 0xFF, 0xFF, 0xFF}, 4}, {base, {0xB8, 0xFF, 0xFF, 0xFF, 0xFF}, 0}});
+    config.set_expected_original(expected ^ 1);
+    
+    PatchMemoryTask wrong_build(config);
+    wrong_build.setHost(mock_host_.get());
+    EXPECT_EQ(wrong_build.original_checksum(), expected);
+    auto refused = wrong_build.execute();
+    ASSERT_FALSE(refused.has_value());
+    EXPECT_EQ(refused.error(), task::TaskError::patch_failed);
+    EXPECT_EQ(code[0], 0xCC);
+    EXPECT_EQ(code[16], 0xCC);
+    
+    config.set_expected_original(expected);
+    PatchMemoryTask right_build(config);
+    right_build.setHost(mock_host_.get());
+    ASSERT_TRUE(right_build.execute().has_value());
+    EXPECT_EQ(code[0], 0xB8);
+    EXPECT_EQ(code[16], 0xA1);
+    
+    right_build.rollback();
+    (void)context.remove_data("patch_expected_region");
+    VirtualFree(code, 0, MEM_RELEASE);
+}
 
-} // namespace app_hook::memory 
\ No newline at end of file
+} // namespace app_hook::memory
\ No newline at end of file
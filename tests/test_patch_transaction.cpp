@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "memory/patch_transaction.hpp"
+#include <windows.h>
+#include <cstring>
+
+namespace app_hook::memory {
+
+using config::CompiledPatchSet;
+
+class PatchTransactionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SYSTEM_INFO info{};
+        GetSystemInfo(&info);
+        page_ = info.dwPageSize;
+        code_ = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, page_ * 2, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+        ASSERT_NE(code_, nullptr);
+        for (std::size_t i = 0; i < page_ * 2; ++i) {
+            code_[i] = static_cast<std::uint8_t>(i);
+        }
+        base_ = reinterpret_cast<std::uintptr_t>(code_);
+    }
+
+    void TearDown() override {
+        VirtualFree(code_, 0, MEM_RELEASE);
+    }
+
+    /// @brief Check that a byte range holds its original pattern
+    bool Pristine(std::size_t offset, std::size_t length) const {
+        for (std::size_t i = offset; i < offset + length; ++i) {
+            if (code_[i] != static_cast<std::uint8_t>(i)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t page_ = 0;
+    std::uint8_t* code_ = nullptr;
+    std::uintptr_t base_ = 0;
+};
+
+TEST_F(PatchTransactionTest, RollbackRestoresOriginalBytes) {
+    CompiledPatchSet patches;
+    ASSERT_TRUE(patches.add_hex(base_ + 8, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(patches.add_hex(base_ + page_ + 4, "B8 XX XX XX XX", 4));
+
+    PatchTransaction transaction;
+    const auto groups = transaction.commit(patches, patches.instructions(), 0x10000000);
+    ASSERT_TRUE(groups.has_value());
+    EXPECT_EQ(*groups, 2u);
+    EXPECT_EQ(code_[8], 0xA1);
+    std::uint32_t resolved = 0;
+    std::memcpy(&resolved, code_ + page_ + 5, sizeof(resolved));
+    EXPECT_EQ(resolved, 0x10000004u);
+    EXPECT_EQ(transaction.saved_bytes(), 10u);
+
+    EXPECT_EQ(transaction.rollback(), 2u);
+    EXPECT_TRUE(Pristine(0, page_ * 2));
+    EXPECT_TRUE(transaction.empty());
+}
+
+TEST_F(PatchTransactionTest, LaterCommitsKeepTheFirstOriginal) {
+    CompiledPatchSet first;
+    ASSERT_TRUE(first.add_hex(base_ + 16, "A1 XX XX XX XX", 0));
+    CompiledPatchSet second;
+    ASSERT_TRUE(second.add_hex(base_ + 14, "8B 0D XX XX XX XX 90 90", 8));
+
+    PatchTransaction transaction;
+    ASSERT_TRUE(transaction.commit(first, first.instructions(), 0x10000000).has_value());
+    ASSERT_TRUE(transaction.commit(second, second.instructions(), 0x10000000).has_value());
+
+    // Only the bytes the first commit did not cover were saved again
+    EXPECT_EQ(transaction.saved_bytes(), 8u);
+    EXPECT_EQ(transaction.saved_ranges(), 3u);
+
+    transaction.rollback();
+    EXPECT_TRUE(Pristine(0, 64));
+}
+
+TEST_F(PatchTransactionTest, RestoreUndoesSelectedInstructions) {
+    CompiledPatchSet patches;
+    ASSERT_TRUE(patches.add_hex(base_, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(patches.add_hex(base_ + 32, "A1 XX XX XX XX", 0));
+
+    PatchTransaction transaction;
+    ASSERT_TRUE(transaction.commit(patches, patches.instructions(), 0x10000000).has_value());
+
+    EXPECT_EQ(transaction.restore(patches.instructions().subspan(1)), 1u);
+    EXPECT_TRUE(Pristine(32, 5));
+    EXPECT_EQ(code_[0], 0xB8);
+    EXPECT_EQ(transaction.saved_ranges(), 1u);
+
+    transaction.rollback();
+    EXPECT_TRUE(Pristine(0, 64));
+}
+
+TEST_F(PatchTransactionTest, NeighborsAreWrittenAsOneSpan) {
+    CompiledPatchSet patches;
+    ASSERT_TRUE(patches.add_hex(base_ + 64, "A1 XX XX XX XX", 0));
+    ASSERT_TRUE(patches.add_hex(base_ + 72, "B8 XX XX XX XX", 4));
+    ASSERT_TRUE(patches.add_hex(base_ + 75, "8B 0D XX XX XX XX", 8));   // Overrides the last bytes of the previous one
+
+    PatchTransaction transaction;
+    ASSERT_TRUE(transaction.commit(patches, patches.instructions(), 0x10000000).has_value());
+
+    // The gap between the first two instructions keeps its bytes
+    EXPECT_EQ(code_[64], 0xA1);
+    EXPECT_TRUE(Pristine(69, 3));
+    EXPECT_EQ(code_[72], 0xB8);
+    EXPECT_EQ(code_[75], 0x8B);
+    EXPECT_EQ(code_[76], 0x0D);
+    std::uint32_t resolved = 0;
+    std::memcpy(&resolved, code_ + 77, sizeof(resolved));
+    EXPECT_EQ(resolved, 0x10000008u);
+    EXPECT_TRUE(Pristine(81, 16));
+
+    // Instructions of a span are still restored one by one
+    EXPECT_EQ(transaction.restore(patches.instructions().first(1)), 1u);
+    EXPECT_TRUE(Pristine(64, 8));
+    EXPECT_EQ(code_[72], 0xB8);
+
+    transaction.rollback();
+    EXPECT_TRUE(Pristine(0, 128));
+}
+
+TEST_F(PatchTransactionTest, FailedCommitWritesNothing) {
+    // The second page is released: it cannot be made writable
+    ASSERT_TRUE(VirtualFree(code_ + page_, page_, MEM_DECOMMIT));
+
+    CompiledPatchSet patches;
+    ASSERT_TRUE(patches.add_hex(base_, "B8 XX XX XX XX", 0));
+    ASSERT_TRUE(patches.add_hex(base_ + page_ + 8, "A1 XX XX XX XX", 0));
+
+    PatchTransaction transaction;
+    const auto result = transaction.commit(patches, patches.instructions(), 0x10000000);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), task::TaskError::patch_failed);
+    EXPECT_TRUE(Pristine(0, page_));
+    EXPECT_TRUE(transaction.empty());
+
+    MEMORY_BASIC_INFORMATION mbi{};
+    ASSERT_NE(VirtualQuery(code_, &mbi, sizeof(mbi)), 0u);
+    EXPECT_EQ(mbi.Protect, static_cast<DWORD>(PAGE_EXECUTE_READWRITE));
+}
+
+} // namespace app_hook::memory
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/payload_codec.hpp"
+#include <lz4frame.h>
+#include <zstd.h>
+#include <cstdint>
+#include <vector>
+
+using namespace app_hook::memory;
+using app_hook::config::BinaryCompression;
+using app_hook::task::TaskError;
+
+class PayloadCodecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Text-table-like data compresses well, as real payloads do
+        for (std::size_t i = 0; i < 4096; ++i) {
+            raw_.push_back(static_cast<std::uint8_t>("FINAL FANTASY VIII "[i % 19]));
+        }
+    }
+    
+    std::vector<std::uint8_t> lz4(bool content_size = true) const {
+        LZ4F_preferences_t preferences{};
+        preferences.frameInfo.contentSize = content_size ? raw_.size() : 0;
+        std::vector<std::uint8_t> out(LZ4F_compressFrameBound(raw_.size(), &preferences));
+        const auto size = LZ4F_compressFrame(out.data(), out.size(), raw_.data(), raw_.size(), &preferences);
+        EXPECT_FALSE(LZ4F_isError(size));
+        out.resize(size);
+        return out;
+    }
+    
+    std::vector<std::uint8_t> zstd() const {
+        std::vector<std::uint8_t> out(ZSTD_compressBound(raw_.size()));
+        const auto size = ZSTD_compress(out.data(), out.size(), raw_.data(), raw_.size(), 3);
+        EXPECT_FALSE(ZSTD_isError(size));
+        out.resize(size);
+        return out;
+    }
+    
+    std::vector<std::uint8_t> raw_;
+};
+
+TEST_F(PayloadCodecTest, RawPayloadIsCopied) {
+    auto size = decoded_size(BinaryCompression::none, raw_);
+    ASSERT_TRUE(size.has_value());
+    EXPECT_EQ(*size, raw_.size());
+    
+    std::vector<std::uint8_t> target(raw_.size());
+    ASSERT_TRUE(decode_payload(BinaryCompression::none, raw_, target).has_value());
+    EXPECT_EQ(target, raw_);
+}
+
+TEST_F(PayloadCodecTest, Lz4FrameDecodesIntoTarget) {
+    const auto payload = lz4();
+    EXPECT_LT(payload.size(), raw_.size());
+    
+    auto size = decoded_size(BinaryCompression::lz4, payload);
+    ASSERT_TRUE(size.has_value());
+    ASSERT_EQ(*size, raw_.size());
+    
+    std::vector<std::uint8_t> target(*size);
+    ASSERT_TRUE(decode_payload(BinaryCompression::lz4, payload, target).has_value());
+    EXPECT_EQ(target, raw_);
+}
+
+TEST_F(PayloadCodecTest, Lz4FrameWithoutContentSizeIsRejected) {
+    auto size = decoded_size(BinaryCompression::lz4, lz4(false));
+    ASSERT_FALSE(size.has_value());
+    EXPECT_EQ(size.error(), TaskError::file_read_error);
+}
+
+TEST_F(PayloadCodecTest, ZstdFrameDecodesIntoTarget) {
+    const auto payload = zstd();
+    EXPECT_LT(payload.size(), raw_.size());
+    
+    auto size = decoded_size(BinaryCompression::zstd, payload);
+    ASSERT_TRUE(size.has_value());
+    ASSERT_EQ(*size, raw_.size());
+    
+    std::vector<std::uint8_t> target(*size);
+    ASSERT_TRUE(decode_payload(BinaryCompression::zstd, payload, target).has_value());
+    EXPECT_EQ(target, raw_);
+}
+
+TEST_F(PayloadCodecTest, TruncatedStreamsFail) {
+    auto lz4_payload = lz4();
+    lz4_payload.resize(lz4_payload.size() - 4);
+    std::vector<std::uint8_t> target(raw_.size());
+    EXPECT_FALSE(decode_payload(BinaryCompression::lz4, lz4_payload, target).has_value());
+    
+    auto zstd_payload = zstd();
+    zstd_payload.resize(zstd_payload.size() - 4);
+    EXPECT_FALSE(decode_payload(BinaryCompression::zstd, zstd_payload, target).has_value());
+}
+
+TEST_F(PayloadCodecTest, RawPayloadIsNotMistakenForAStream) {
+    EXPECT_FALSE(decoded_size(BinaryCompression::lz4, raw_).has_value());
+    EXPECT_FALSE(decoded_size(BinaryCompression::zstd, raw_).has_value());
+}
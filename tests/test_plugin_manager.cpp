@@ -1,9 +1,50 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "plugin/plugin_manager.hpp"
+#include "mock_plugin_host.hpp"
+#include <spdlog/spdlog.h>
 
 namespace app_hook::plugin {
 
+namespace {
+
+// Plugin code logging through the PLUGIN_LOG_* macros
+struct LoggingPlugin {
+    IPluginHost* host_ = nullptr;
+    int formatted = 0;
+    
+    // Format argument counting its own evaluations
+    int next() { return ++formatted; }
+    
+    void log_info() { PLUGIN_LOG_INFO("info {}", next()); }
+    void log_warn() { PLUGIN_LOG_WARN("warn {}", next()); }
+};
+
+// The same code built with trace and debug calls compiled out
+#pragma push_macro("PLUGIN_LOG_ACTIVE_LEVEL")
+#undef PLUGIN_LOG_ACTIVE_LEVEL
+#define PLUGIN_LOG_ACTIVE_LEVEL 2
+
+struct ReleasePlugin {
+    IPluginHost* host_ = nullptr;
+    int formatted = 0;
+    
+    int next() { return ++formatted; }
+    
+    void log_debug() { PLUGIN_LOG_DEBUG("debug {}", next()); }
+    void log_info() { PLUGIN_LOG_INFO("info {}", next()); }
+    
+    // Builds for types std::format rejects: the call is discarded, not just skipped
+    template <typename T>
+    void log_debug_value(const T& value) { PLUGIN_LOG_DEBUG("debug {}", value); }
+};
+
+#pragma pop_macro("PLUGIN_LOG_ACTIVE_LEVEL")
+
+struct Unformattable {};
+
+} // namespace
+
 class PluginManagerTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -85,6 +126,85 @@ TEST_F(PluginManagerTest, LoadPluginsFromNonExistentDirectory) {
     EXPECT_EQ(count, 0);
 }
 
+TEST_F(PluginManagerTest, MemoryReportIncludesHostAndPluginSources) {
+    PluginManager manager;
+    PluginHost host;
+    
+    // The host reports the shared context on its own
+    EXPECT_NE(host.get_memory_report().find("context.table"), nullptr);
+    
+    host.register_memory_source("test_plugin", [] {
+        return std::vector<::app_hook::util::MemoryUsage>{{"test_plugin.buffers", 2, 512}};
+    });
+    const auto report = host.get_memory_report();
+    ASSERT_NE(report.find("test_plugin.buffers"), nullptr);
+    EXPECT_EQ(report.find("test_plugin.buffers")->bytes, 512u);
+    
+    host.unregister_memory_source("test_plugin");
+    EXPECT_EQ(host.get_memory_report().find("test_plugin.buffers"), nullptr);
+    
+    manager.add_memory_source("hooks", [] {
+        return std::vector<::app_hook::util::MemoryUsage>{{"hook.stubs", 1, 64}};
+    });
+    EXPECT_NE(manager.memory_report().find("hook.stubs"), nullptr);
+}
+
+TEST_F(PluginManagerTest, MessagesBelowTheHostLevelAreNotFormatted) {
+    MockPluginHost host;
+    host.set_log_level(3);
+    LoggingPlugin plugin{&host};
+    
+    plugin.log_info();
+    EXPECT_EQ(plugin.formatted, 0);
+    EXPECT_TRUE(host.get_log_messages().empty());
+    
+    plugin.log_warn();
+    EXPECT_EQ(plugin.formatted, 1);
+    ASSERT_EQ(host.get_log_messages().size(), 1u);
+    EXPECT_EQ(host.get_log_messages()[0].first, 3);
+    EXPECT_TRUE(host.get_log_messages()[0].second.starts_with("warn 1"));
+    
+    // Without a host nothing is formatted either
+    LoggingPlugin detached;
+    detached.log_warn();
+    EXPECT_EQ(detached.formatted, 0);
+}
+
+TEST_F(PluginManagerTest, CompiledOutLevelsNeverReachTheHost) {
+    MockPluginHost host;  // Accepts every level
+    ReleasePlugin plugin{&host};
+    ASSERT_TRUE(host.is_enabled(1));
+    
+    plugin.log_debug();
+    plugin.log_debug_value(Unformattable{});
+    EXPECT_EQ(plugin.formatted, 0);
+    EXPECT_TRUE(host.get_log_messages().empty());
+    
+    plugin.log_info();
+    EXPECT_EQ(plugin.formatted, 1);
+    EXPECT_EQ(host.get_log_messages().size(), 1u);
+}
+
+TEST_F(PluginManagerTest, HostLevelFollowsTheLoggerOnSync) {
+    auto* logger = spdlog::default_logger_raw();
+    const auto saved = logger->level();
+    
+    // The host syncs when it is built
+    logger->set_level(spdlog::level::warn);
+    PluginHost host;
+    EXPECT_FALSE(host.is_enabled(2));
+    EXPECT_TRUE(host.is_enabled(3));
+    
+    // A later change is seen from the next sync on (PluginManager::initialize)
+    logger->set_level(spdlog::level::debug);
+    EXPECT_FALSE(host.is_enabled(1));
+    host.sync_log_level();
+    EXPECT_TRUE(host.is_enabled(1));
+    EXPECT_FALSE(host.is_enabled(0));
+    
+    logger->set_level(saved);
+}
+
 // Note: More comprehensive tests would require actual plugin DLLs
 // These tests verify the basic interface works and handles error cases
 
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include "plugin/plugin_manager.hpp"
+#include "plugin/plugin_manifest.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace app_hook::plugin {
+
+class PluginManifestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "plugin_manifest_tests";
+        std::filesystem::remove_all(test_dir_);
+        std::filesystem::create_directories(test_dir_);
+    }
+    
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(test_dir_, ec);
+    }
+    
+    void WriteFile(const std::filesystem::path& path, const std::string& content) {
+        std::ofstream file(path);
+        file << content;
+    }
+    
+    std::filesystem::path test_dir_;
+};
+
+TEST_F(PluginManifestTest, ManifestSitsNextToTheDll) {
+    EXPECT_EQ(manifest_path_for(test_dir_ / "memory_plugin.dll"), test_dir_ / "memory_plugin.plugin.toml");
+}
+
+TEST_F(PluginManifestTest, ReadsConfigTypesAndTaskCreators) {
+    WriteFile(test_dir_ / "memory_plugin.plugin.toml", R"(
+[plugin]
+name = "Memory Operations Plugin"
+config_types = ["memory", "patch"]
+task_creators = ["app_hook::config::CopyMemoryConfig"]
+)");
+    
+    auto manifest = load_plugin_manifest(test_dir_ / "memory_plugin.dll");
+    ASSERT_TRUE(manifest.has_value());
+    EXPECT_EQ(manifest->name, "Memory Operations Plugin");
+    EXPECT_EQ(manifest->dll_path, test_dir_ / "memory_plugin.dll");
+    EXPECT_TRUE(manifest->provides(config::ConfigType::Memory));
+    EXPECT_TRUE(manifest->provides(config::ConfigType::Patch));
+    EXPECT_FALSE(manifest->provides(config::ConfigType::Load));
+    ASSERT_EQ(manifest->task_creators.size(), 1u);
+    EXPECT_EQ(manifest->task_creators[0], "app_hook::config::CopyMemoryConfig");
+    
+    const config::ConfigType needed[] = {config::ConfigType::Audio, config::ConfigType::Patch};
+    EXPECT_TRUE(manifest->provides_any(needed));
+}
+
+TEST_F(PluginManifestTest, MissingManifestIsNotAnError) {
+    auto manifest = load_plugin_manifest(test_dir_ / "legacy_plugin.dll");
+    ASSERT_FALSE(manifest.has_value());
+    EXPECT_EQ(manifest.error(), config::ConfigError::file_not_found);
+}
+
+TEST_F(PluginManifestTest, RejectsUnknownConfigTypes) {
+    WriteFile(test_dir_ / "typo.plugin.toml", "[plugin]\nconfig_types = [\"memroy\"]\n");
+    WriteFile(test_dir_ / "empty.plugin.toml", "[plugin]\nname = \"Empty\"\n");
+    WriteFile(test_dir_ / "broken.plugin.toml", "[plugin\n");
+    
+    EXPECT_EQ(load_plugin_manifest(test_dir_ / "typo.dll").error(), config::ConfigError::invalid_format);
+    EXPECT_EQ(load_plugin_manifest(test_dir_ / "empty.dll").error(), config::ConfigError::missing_required_field);
+    EXPECT_EQ(load_plugin_manifest(test_dir_ / "broken.dll").error(), config::ConfigError::parse_error);
+}
+
+TEST_F(PluginManifestTest, SkipsPluginsNoEnabledTaskNeeds) {
+    WriteFile(test_dir_ / "tasks.toml", R"(
+[tasks.copy_magic]
+name = "Magic Expansion"
+type = "memory"
+config_file = "tasks/copy_magic.toml"
+
+[tasks.music]
+name = "Music"
+type = "audio"
+config_file = "tasks/music.toml"
+enabled = false
+)");
+    const auto plugin_dir = test_dir_ / "plugins";
+    std::filesystem::create_directories(plugin_dir);
+    WriteFile(plugin_dir / "audio_plugin.dll", "not a real DLL");
+    WriteFile(plugin_dir / "audio_plugin.plugin.toml", "[plugin]\nconfig_types = [\"audio\"]\n");
+    
+    PluginManager manager;
+    ASSERT_EQ(manager.initialize("data", [](std::unique_ptr<config::ConfigBase>) {}), PluginResult::Success);
+    
+    // The only audio task is disabled, so the DLL is never opened
+    EXPECT_EQ(manager.load_plugins_for_tasks(plugin_dir.string(), (test_dir_ / "tasks.toml").string()), 0u);
+    ASSERT_EQ(manager.skipped_plugins().size(), 1u);
+    EXPECT_EQ(manager.skipped_plugins()[0].dll_path.filename(), "audio_plugin.dll");
+}
+
+} // namespace app_hook::plugin
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "util/reference_scanner.hpp"
+#include "config/patch_config_loader.hpp"
+#include <cstring>
+#include <vector>
+
+namespace app_hook::util {
+
+namespace {
+
+constexpr std::uint32_t kTable = 0x00501000;
+constexpr std::uint32_t kTableSize = 0x400;
+
+void put_dword(std::vector<std::uint8_t>& code, std::size_t at, std::uint32_t value) {
+    std::memcpy(code.data() + at, &value, sizeof(value));
+}
+
+} // namespace
+
+TEST(ReferenceScannerTest, FindsDwordsInsideTheRangeOnly) {
+    std::vector<std::uint8_t> code(4096, 0x90);
+    put_dword(code, 3, kTable);                      // first byte of the table
+    put_dword(code, 100, kTable + kTableSize - 1);   // last byte
+    put_dword(code, 200, kTable + kTableSize);       // one past the end
+    put_dword(code, 300, kTable - 1);                // one before
+    put_dword(code, 1001, kTable + 0x10);            // unaligned, inside a vector step
+    put_dword(code, code.size() - 4, kTable + 0x20); // scalar tail
+
+    const auto references = find_references(code, kTable, kTableSize);
+    EXPECT_EQ(references, (std::vector<std::size_t>{3, 100, 1001, code.size() - 4}));
+}
+
+TEST(ReferenceScannerTest, OverlappingMatchesReportTheFirst) {
+    // 00 10 50 00 10 50 00: the dwords at 0 and 3 both decode into the table
+    std::vector<std::uint8_t> code = {0x00, 0x10, 0x50, 0x00, 0x10, 0x50, 0x00, 0x90};
+    const auto references = find_references(code, 0x00501000 - 0x100000, 0x00200000);
+    ASSERT_FALSE(references.empty());
+    EXPECT_EQ(references.front(), 0u);
+    for (std::size_t i = 1; i < references.size(); ++i) {
+        EXPECT_GE(references[i], references[i - 1] + 4);
+    }
+}
+
+TEST(ReferenceScannerTest, EmptyRangeOrShortImageFindsNothing) {
+    std::vector<std::uint8_t> code(64, 0);
+    put_dword(code, 8, kTable);
+    EXPECT_TRUE(find_references(code, kTable, 0).empty());
+    EXPECT_TRUE(find_references(std::span(code).first(3), 0, 0xFFFFFFFF).empty());
+}
+
+TEST(ReferenceScannerTest, CopyRebasedMovesAlignedPointersOnly) {
+    // 37 bytes: two SSE2 steps, a scalar dword and a trailing byte
+    std::vector<std::uint8_t> table(37, 0xAB);
+    put_dword(table, 0x00, kTable + 0x10);            // into the table itself
+    put_dword(table, 0x0C, 0x00600020);               // into the sibling
+    put_dword(table, 0x14, kTable + kTableSize);      // one past the end
+    put_dword(table, 0x20, kTable);                   // scalar dword
+    put_dword(table, 0x1D, kTable);                   // unaligned, left alone
+    const std::vector<std::uint8_t> original = table;
+
+    const MovedRange ranges[] = {{kTable, kTableSize, 0x02000000}, {0x00600000, 0x100, 0x03000000}};
+    std::vector<std::uint8_t> copy(table.size());
+    EXPECT_EQ(copy_rebased(table, copy.data(), ranges), 3u);
+
+    auto expected = original;
+    put_dword(expected, 0x00, 0x02000010);
+    put_dword(expected, 0x0C, 0x03000020);
+    put_dword(expected, 0x20, 0x02000000);
+    EXPECT_EQ(copy, expected);
+
+    // In place, and without ranges as a plain copy
+    EXPECT_EQ(copy_rebased(table, table.data(), ranges), 3u);
+    EXPECT_EQ(table, expected);
+    EXPECT_EQ(copy_rebased(original, copy.data(), {}), 0u);
+    EXPECT_EQ(copy, original);
+}
+
+TEST(ReferenceScannerTest, RelocationPatchesKeepHandWrittenInstructions) {
+    std::vector<std::uint8_t> code(256, 0x90);
+    const std::uintptr_t code_address = 0x00401000;
+    put_dword(code, 0x12, kTable + 0x08);  // mov eax, [table+8]
+    put_dword(code, 0x42, kTable + 0x40);  // inside the hand-written instruction
+    put_dword(code, 0x80, kTable + 0x44);  // excluded constant
+
+    config::CompiledPatchSet compiled;
+    ASSERT_TRUE(compiled.add_hex(code_address + 0x40, "8B 15 XX XX XX XX", 0x40));
+
+    memory_plugin::PatchConfigLoader loader;
+    const std::vector<std::uintptr_t> excluded = {code_address + 0x80};
+    EXPECT_EQ(loader.add_relocation_patches(code, code_address, kTable, kTableSize, excluded, compiled), 1);
+
+    ASSERT_EQ(compiled.size(), 2u);
+    const auto& generated = compiled.instructions()[1];
+    EXPECT_EQ(generated.address, code_address + 0x12);
+    EXPECT_EQ(generated.length, 4u);
+    EXPECT_EQ(generated.placeholder, 0u);
+    EXPECT_EQ(generated.offset, 0x08);
+}
+
+} // namespace app_hook::util
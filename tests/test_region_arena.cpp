@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/region_arena.hpp"
+#include <algorithm>
+
+using namespace app_hook::memory;
+
+class RegionArenaTest : public ::testing::Test {
+protected:
+    RegionArena arena_{1024 * 1024};
+};
+
+TEST_F(RegionArenaTest, EmptySizeIsRejected) {
+    EXPECT_EQ(arena_.allocate("empty", 0), nullptr);
+    EXPECT_EQ(arena_.block_count(), 0u);
+    EXPECT_EQ(arena_.reserved_bytes(), 0u);
+}
+
+TEST_F(RegionArenaTest, BlocksHonorAlignment) {
+    auto* small = arena_.allocate("small", 3, 16);
+    auto* aligned = arena_.allocate("aligned", 100, 64);
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(aligned, nullptr);
+    
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small) % 16, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned) % 64, 0u);
+}
+
+TEST_F(RegionArenaTest, ConsecutiveBlocksAreAdjacent) {
+    auto* table = arena_.allocate("table", 256, 16);
+    auto* text = arena_.allocate("text", 128, 16);
+    ASSERT_NE(table, nullptr);
+    ASSERT_NE(text, nullptr);
+    
+    EXPECT_EQ(text, table + 256);
+    EXPECT_EQ(arena_.used_bytes(), 384u);
+}
+
+TEST_F(RegionArenaTest, BlocksAreZeroedAndWritable) {
+    auto* block = arena_.allocate("zeroed", 4096);
+    ASSERT_NE(block, nullptr);
+    
+    EXPECT_TRUE(std::all_of(block, block + 4096, [](std::uint8_t b) { return b == 0; }));
+    std::fill_n(block, 4096, std::uint8_t{0xAB});
+    EXPECT_EQ(block[4095], 0xAB);
+}
+
+TEST_F(RegionArenaTest, SameKeyReusesBlock) {
+    auto* first = arena_.allocate("config", 512);
+    auto* again = arena_.allocate("config", 512);
+    
+    EXPECT_EQ(first, again);
+    EXPECT_EQ(arena_.block_count(), 1u);
+    EXPECT_EQ(arena_.used_bytes(), 512u);
+    
+    // A larger request outgrows the old block
+    auto* larger = arena_.allocate("config", 1024);
+    EXPECT_NE(larger, first);
+    EXPECT_EQ(arena_.block_count(), 1u);
+}
+
+TEST_F(RegionArenaTest, GrowsPastChunkSize) {
+    auto* first = arena_.allocate("first", 512 * 1024);
+    auto* huge = arena_.allocate("huge", 2 * 1024 * 1024);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(huge, nullptr);
+    
+    EXPECT_GE(arena_.reserved_bytes(), 3u * 1024 * 1024);
+    huge[2 * 1024 * 1024 - 1] = 1;
+}
+
+TEST_F(RegionArenaTest, CommitsOnDemand) {
+    ASSERT_NE(arena_.allocate("page", 100), nullptr);
+    
+    EXPECT_EQ(arena_.committed_bytes(), RegionArena::kCommitSize);
+    EXPECT_EQ(arena_.reserved_bytes(), 1024u * 1024);
+}
+
+TEST_F(RegionArenaTest, ReservationCommitsOnlyWhatIsFilled) {
+    auto* base = arena_.reserve("growable", 8 * 1024 * 1024, 100);
+    ASSERT_NE(base, nullptr);
+    
+    EXPECT_EQ(arena_.committed_bytes(), RegionArena::kPageSize);
+    EXPECT_EQ(arena_.reserved_bytes(), 8u * 1024 * 1024);
+    EXPECT_EQ(arena_.block_count(), 0u);
+    
+    // Growing commits whole pages and never moves the base
+    ASSERT_TRUE(arena_.grow(base, 3 * RegionArena::kPageSize + 1));
+    EXPECT_EQ(arena_.committed_bytes(), 4 * RegionArena::kPageSize);
+    base[3 * RegionArena::kPageSize] = 0x5A;
+    EXPECT_EQ(base[3 * RegionArena::kPageSize + 1], 0);
+    
+    EXPECT_FALSE(arena_.grow(base, 8 * 1024 * 1024 + 1));
+    EXPECT_FALSE(arena_.grow(base + 16, 100));
+}
+
+TEST_F(RegionArenaTest, ReservationIsReusedAndCleared) {
+    auto* first = arena_.reserve("growable", 1024 * 1024, 64);
+    ASSERT_NE(first, nullptr);
+    ASSERT_TRUE(arena_.grow(first, 2 * RegionArena::kPageSize));
+    first[RegionArena::kPageSize] = 0xAB;
+    
+    // The same key keeps its address; bytes grown into last time read as zero again
+    auto* again = arena_.reserve("growable", 1024 * 1024, 64);
+    EXPECT_EQ(again, first);
+    EXPECT_EQ(again[RegionArena::kPageSize], 0);
+    
+    // A larger capacity needs a new reservation
+    auto* larger = arena_.reserve("growable", 4 * 1024 * 1024, 64);
+    ASSERT_NE(larger, nullptr);
+    EXPECT_NE(larger, first);
+    
+    EXPECT_EQ(arena_.reserve("too_small", 64, 128), nullptr);
+}
+
+TEST_F(RegionArenaTest, ReleaseDropsEverything) {
+    ASSERT_NE(arena_.allocate("a", 100), nullptr);
+    ASSERT_NE(arena_.allocate("b", 100), nullptr);
+    ASSERT_NE(arena_.reserve("c", 1024 * 1024, 100), nullptr);
+    
+    arena_.release();
+    
+    EXPECT_EQ(arena_.block_count(), 0u);
+    EXPECT_EQ(arena_.used_bytes(), 0u);
+    EXPECT_EQ(arena_.reserved_bytes(), 0u);
+    EXPECT_NE(arena_.allocate("a", 100), nullptr);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "../memory_plugin/include/memory/region_snapshot.hpp"
+#include <algorithm>
+
+using namespace app_hook::memory;
+
+class RegionSnapshotTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t kPage = RegionArena::kPageSize;
+    
+    RegionArena arena_{1024 * 1024};
+    RegionSnapshots snapshots_{arena_};
+};
+
+TEST_F(RegionSnapshotTest, NeedsAWatchedRegion) {
+    EXPECT_EQ(snapshots_.capture("start").error(), SnapshotError::no_watched_regions);
+    
+    // Blocks and plain reservations are not watched
+    ASSERT_NE(arena_.allocate("block", 4096), nullptr);
+    ASSERT_NE(arena_.reserve("plain", 16 * kPage, 4 * kPage), nullptr);
+    EXPECT_TRUE(arena_.watched_ranges().empty());
+    EXPECT_EQ(snapshots_.capture("start").error(), SnapshotError::no_watched_regions);
+    EXPECT_EQ(snapshots_.restore("start").error(), SnapshotError::unknown_snapshot);
+}
+
+TEST_F(RegionSnapshotTest, FirstCaptureCopiesEverything) {
+    auto* kernel = arena_.reserve("kernel", 8 * kPage, 8 * kPage, true);
+    ASSERT_NE(kernel, nullptr);
+    ASSERT_EQ(arena_.watched_ranges().size(), 1u);
+    
+    auto stats = snapshots_.capture("start");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->regions, 1u);
+    EXPECT_EQ(stats->pages, 8u);
+    EXPECT_EQ(stats->bytes, 8 * kPage);
+    EXPECT_EQ(snapshots_.bytes(), 8 * kPage);
+    
+    // Nothing written since: capturing again copies nothing
+    stats = snapshots_.capture("start");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pages, 0u);
+}
+
+TEST_F(RegionSnapshotTest, RestoreCopiesOnlyWrittenPages) {
+    auto* kernel = arena_.reserve("kernel", 8 * kPage, 8 * kPage, true);
+    ASSERT_NE(kernel, nullptr);
+    std::fill_n(kernel, 8 * kPage, std::uint8_t{0x11});
+    ASSERT_TRUE(snapshots_.capture("start").has_value());
+    
+    kernel[2 * kPage + 5] = 0xAA;
+    kernel[6 * kPage] = 0xBB;
+    
+    auto stats = snapshots_.restore("start");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pages, 2u);
+    EXPECT_EQ(stats->bytes, 2 * kPage);
+    EXPECT_EQ(kernel[2 * kPage + 5], 0x11);
+    EXPECT_EQ(kernel[6 * kPage], 0x11);
+    
+    // The restored pages match the snapshot again
+    stats = snapshots_.restore("start");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pages, 0u);
+}
+
+TEST_F(RegionSnapshotTest, SnapshotsTrackTheirOwnPages) {
+    auto* kernel = arena_.reserve("kernel", 4 * kPage, 4 * kPage, true);
+    ASSERT_NE(kernel, nullptr);
+    ASSERT_TRUE(snapshots_.capture("vanilla").has_value());
+    
+    kernel[kPage] = 0x42;  // A mod toggled on
+    auto modded = snapshots_.capture("modded");
+    ASSERT_TRUE(modded.has_value());
+    EXPECT_EQ(modded->pages, 4u);
+    
+    // Back to vanilla: only the page the mod wrote
+    auto stats = snapshots_.restore("vanilla");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pages, 1u);
+    EXPECT_EQ(kernel[kPage], 0x00);
+    
+    // And forward again: the restore wrote that page, so "modded" copies it back
+    stats = snapshots_.restore("modded");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pages, 1u);
+    EXPECT_EQ(kernel[kPage], 0x42);
+    
+    EXPECT_EQ(snapshots_.names(), (std::vector<std::string>{"modded", "vanilla"}));
+    EXPECT_TRUE(snapshots_.drop("vanilla"));
+    EXPECT_FALSE(snapshots_.drop("vanilla"));
+    EXPECT_EQ(snapshots_.restore("vanilla").error(), SnapshotError::unknown_snapshot);
+}
+
+TEST_F(RegionSnapshotTest, GrownPagesAreCapturedWhole) {
+    auto* text = arena_.reserve("text", 16 * kPage, 2 * kPage, true);
+    ASSERT_NE(text, nullptr);
+    ASSERT_TRUE(snapshots_.capture("start").has_value());
+    
+    ASSERT_TRUE(arena_.grow(text, 5 * kPage));
+    text[4 * kPage] = 0x7F;
+    auto stats = snapshots_.capture("start");
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->pages, 3u);
+    EXPECT_EQ(snapshots_.bytes(), 5 * kPage);
+    
+    text[4 * kPage] = 0x00;
+    ASSERT_TRUE(snapshots_.restore("start").has_value());
+    EXPECT_EQ(text[4 * kPage], 0x7F);
+}
@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+#include "../lua_plugin/include/script/script_task.hpp"
+#include "../lua_plugin/include/config/script_config_loader.hpp"
+#include "../lua_plugin/include/script/chunk_cache.hpp"
+#include "../memory_plugin/include/memory/memory_region.hpp"
+#include "mock_plugin_host.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace app_hook::script;
+using namespace app_hook::config;
+using namespace app_hook::task;
+using app_hook::memory::MemoryRegion;
+
+class ScriptTaskTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_host_ = std::make_unique<MockPluginHost>();
+        temp_dir_ = std::filesystem::temp_directory_path() / "script_task_test";
+        std::filesystem::create_directories(temp_dir_);
+
+        MemoryRegion region(16, 0, 0x401000, "Script target");
+        std::memset(region.data.get(), 0, 16);
+        context().store_data(kRegion, std::move(region));
+    }
+
+    void TearDown() override {
+        ChunkCache::instance().clear();
+        (void)context().remove_data(kRegion);
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    static app_hook::context::ModContext& context() {
+        return app_hook::context::ModContext::instance();
+    }
+
+    static std::uint8_t* target() {
+        return context().get_data<MemoryRegion>(kRegion)->data.get();
+    }
+
+    std::string create_test_file(const std::string& filename, const std::string& content) {
+        auto file_path = temp_dir_ / filename;
+        std::ofstream file(file_path);
+        file << content;
+        return file_path.string();
+    }
+
+    ScriptConfig make_script(const std::string& source, const std::string& entry = {}) {
+        ScriptConfig config("script_key", "script_name");
+        config.set_script_path(create_test_file("script.lua", source));
+        config.set_entry(entry);
+        config.set_read_from_context(kRegion);
+        return config;
+    }
+
+    static constexpr const char* kRegion = "script_target_region";
+    std::unique_ptr<MockPluginHost> mock_host_;
+    std::filesystem::path temp_dir_;
+};
+
+TEST_F(ScriptTaskTest, LoaderParsesScripts) {
+    const auto path = create_test_file("scripts.toml", R"(
+        [script.DOUBLE_HP]
+        script = "mods/double_hp.lua"
+        function = "on_battle"
+        hookAddress = "0x4A1000"
+        readFromContext = "ff8.battle.k_stats"
+    )");
+
+    lua_plugin::ScriptConfigLoader loader;
+    loader.setHost(mock_host_.get());
+    auto result = loader.load_configs(ConfigType::Script, path, "battle");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+
+    const auto* config = dynamic_cast<const ScriptConfig*>(result->front().get());
+    ASSERT_NE(config, nullptr);
+    EXPECT_EQ(config->key(), "battle_DOUBLE_HP");
+    EXPECT_EQ(config->script_path(), "mods/double_hp.lua");
+    EXPECT_EQ(config->entry(), "on_battle");
+    EXPECT_EQ(config->get_hook_address(), 0x4A1000u);
+    EXPECT_EQ(config->read_from_context(), "ff8.battle.k_stats");
+    EXPECT_EQ(config->data_files(), std::vector<std::string>{"mods/double_hp.lua"});
+}
+
+TEST_F(ScriptTaskTest, WritesThroughTheRegionView) {
+    ScriptTask task(make_script(R"(
+        local bytes, size = app.region()
+        for i = 0, size - 1 do
+            bytes[i] = i * 2
+        end
+    )"));
+    task.setHost(mock_host_.get());
+    ASSERT_TRUE(task.prepare());
+
+    ASSERT_TRUE(task.execute().has_value());
+    EXPECT_EQ(target()[0], 0);
+    EXPECT_EQ(target()[5], 10);
+    EXPECT_EQ(target()[15], 30);
+}
+
+TEST_F(ScriptTaskTest, StateSurvivesBetweenTriggers) {
+    ScriptTask task(make_script(R"(
+        calls = 0
+        function on_trigger()
+            calls = calls + 1
+            local words = app.region(nil, "uint32_t*")
+            words[0] = calls
+        end
+    )", "on_trigger"));
+    task.setHost(mock_host_.get());
+
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(task.execute().has_value());
+    }
+    std::uint32_t calls = 0;
+    std::memcpy(&calls, target(), sizeof(calls));
+    EXPECT_EQ(calls, 3u);
+}
+
+TEST_F(ScriptTaskTest, ErrorsFailTheTask) {
+    ScriptTask raising(make_script("error('boom')"));
+    raising.setHost(mock_host_.get());
+    auto result = raising.execute();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::script_error);
+
+    ScriptTask declining(make_script("return false"));
+    declining.setHost(mock_host_.get());
+    ASSERT_FALSE(declining.execute().has_value());
+
+    ScriptTask broken(make_script("this is not lua"));
+    broken.setHost(mock_host_.get());
+    EXPECT_FALSE(broken.prepare());
+    result = broken.execute();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::script_error);
+}
+
+TEST_F(ScriptTaskTest, MissingEntryFailsToStart) {
+    ScriptTask task(make_script("x = 1", "on_trigger"));
+    task.setHost(mock_host_.get());
+    ASSERT_TRUE(task.prepare());
+
+    auto result = task.execute();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::script_error);
+}
+
+TEST_F(ScriptTaskTest, ChunkCacheSkipsCompilingUnchangedScripts) {
+    constexpr const char* kSource = "local bytes = app.region() bytes[0] = bytes[0] + 1";
+    auto& cache = ChunkCache::instance();
+    EXPECT_EQ(cache.load(temp_dir_, nullptr), 0u);
+
+    ScriptTask compiled(make_script(kSource));
+    compiled.setHost(mock_host_.get());
+    ASSERT_TRUE(compiled.prepare());
+    const auto script_path = compiled.config().script_path();
+    EXPECT_TRUE(std::filesystem::exists(cache.chunk_file(script_path)));
+
+    // Next launch: the chunk is loaded and runs like the source
+    cache.clear();
+    EXPECT_EQ(cache.load(temp_dir_, nullptr), 1u);
+    ASSERT_NE(cache.find(script_path), nullptr);
+    ScriptTask cached(make_script(kSource));
+    cached.setHost(mock_host_.get());
+    ASSERT_TRUE(cached.prepare());
+    ASSERT_TRUE(cached.execute().has_value());
+    EXPECT_EQ(target()[0], 1);
+
+    // An edited script makes its chunk stale
+    (void)create_test_file("script.lua", "return true");
+    cache.clear();
+    EXPECT_EQ(cache.load(temp_dir_, nullptr), 0u);
+    EXPECT_EQ(cache.find(script_path), nullptr);
+}
+
+TEST_F(ScriptTaskTest, ChunkFilesMatchTheirScriptOnly) {
+    auto& cache = ChunkCache::instance();
+    (void)cache.load(temp_dir_, nullptr);
+    const std::string source = "return 1";
+    ASSERT_TRUE(cache.store("a.lua", source, {0x1B, 0x4C, 0x4A}));
+
+    std::vector<std::uint8_t> bytes;
+    {
+        std::ifstream file(cache.chunk_file("a.lua"), std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    const auto hash = ChunkCache::hash_source(source);
+
+    EXPECT_EQ(ChunkCache::decode(bytes, "a.lua", hash).size(), 3u);
+    EXPECT_TRUE(ChunkCache::decode(bytes, "b.lua", hash).empty());
+    EXPECT_TRUE(ChunkCache::decode(bytes, "a.lua", hash + 1).empty());
+    EXPECT_TRUE(ChunkCache::decode(std::span(bytes).first(bytes.size() - 1), "a.lua", hash).empty());
+    EXPECT_NE(cache.chunk_file("a.lua"), cache.chunk_file("b.lua"));
+}
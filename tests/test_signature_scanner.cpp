@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include "util/pe_image.hpp"
+#include "util/signature_resolver.hpp"
+#include "util/signature_scanner.hpp"
+#include <windows.h>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace app_hook::util {
+
+namespace {
+
+// Noise without the bytes the tests use as fixed pattern bytes
+std::vector<std::uint8_t> make_noise(std::size_t size) {
+    std::vector<std::uint8_t> data(size);
+    std::mt19937 rng(1234);
+    for (auto& byte : data) {
+        byte = static_cast<std::uint8_t>(rng() % 0x80);
+    }
+    return data;
+}
+
+void place(std::vector<std::uint8_t>& data, std::size_t at, std::initializer_list<std::uint8_t> bytes) {
+    std::copy(bytes.begin(), bytes.end(), data.begin() + static_cast<std::ptrdiff_t>(at));
+}
+
+// Mapped module layout with one .text section, as the loader leaves it in memory
+class FakeModule {
+public:
+    static constexpr std::uint32_t kCodeRva = 0x1000;
+    static constexpr std::uint32_t kCodeSize = 0x2000;
+
+    explicit FakeModule(std::uint32_t timestamp = 0x5F000000) : memory_(kCodeRva + kCodeSize, 0) {
+        auto* dos = reinterpret_cast<IMAGE_DOS_HEADER*>(memory_.data());
+        dos->e_magic = IMAGE_DOS_SIGNATURE;
+        dos->e_lfanew = 0x80;
+        auto* nt = reinterpret_cast<IMAGE_NT_HEADERS*>(memory_.data() + dos->e_lfanew);
+        nt->Signature = IMAGE_NT_SIGNATURE;
+        nt->FileHeader.NumberOfSections = 1;
+        nt->FileHeader.TimeDateStamp = timestamp;
+        nt->FileHeader.SizeOfOptionalHeader = sizeof(nt->OptionalHeader);
+        nt->OptionalHeader.SizeOfImage = static_cast<DWORD>(memory_.size());
+        nt->OptionalHeader.CheckSum = 0x1234;
+        auto* section = IMAGE_FIRST_SECTION(nt);
+        std::memcpy(section->Name, ".text", 6);
+        section->VirtualAddress = kCodeRva;
+        section->Misc.VirtualSize = kCodeSize;
+        section->Characteristics = IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE;
+
+        const auto noise = make_noise(kCodeSize);
+        std::copy(noise.begin(), noise.end(), memory_.begin() + kCodeRva);
+    }
+
+    std::uint8_t* code() { return memory_.data() + kCodeRva; }
+    const void* base() const { return memory_.data(); }
+    std::uintptr_t address() const { return reinterpret_cast<std::uintptr_t>(memory_.data()); }
+
+private:
+    std::vector<std::uint8_t> memory_;
+};
+
+// A call-like sequence at +0x100 and a mov eax, [0x00C0FFEE] at +0x500
+void place_code(FakeModule& module) {
+    std::memcpy(module.code() + 0x100, "\xE8\xF1\xF2\xF3", 4);
+    std::memcpy(module.code() + 0x500, "\xA1\xEE\xFF\xC0\x00\xF5", 6);
+}
+
+} // namespace
+
+TEST(SignatureTest, ParsesBytesWildcardsAndMarkers) {
+    auto signature = Signature::parse("8B ?? 45 ? ^ C3");
+    ASSERT_TRUE(signature);
+    EXPECT_EQ(signature->size(), 5u);
+    EXPECT_EQ(signature->bytes, (std::vector<std::uint8_t>{0x8B, 0, 0x45, 0, 0xC3}));
+    EXPECT_EQ(signature->mask, (std::vector<std::uint8_t>{0xFF, 0, 0xFF, 0, 0xFF}));
+    EXPECT_EQ(signature->result_offset, 4u);
+    EXPECT_FALSE(signature->deref);
+
+    auto deref = Signature::parse("A1 & ?? ?? ?? ??");
+    ASSERT_TRUE(deref);
+    EXPECT_TRUE(deref->deref);
+    EXPECT_EQ(deref->result_offset, 1u);
+}
+
+TEST(SignatureTest, RejectsInvalidPatterns) {
+    EXPECT_FALSE(Signature::parse(""));
+    EXPECT_FALSE(Signature::parse("?? ??"));          // nothing fixed
+    EXPECT_FALSE(Signature::parse("8B 4"));           // half a byte
+    EXPECT_FALSE(Signature::parse("8B ZZ"));          // not hex
+    EXPECT_FALSE(Signature::parse("^ 8B ^ 45"));      // two markers
+    EXPECT_FALSE(Signature::parse("A1 & ?? ??"));     // "&" needs a dword
+    EXPECT_FALSE(Signature::parse("8B 45 ^"));        // marker past the end
+}
+
+TEST(SignatureScannerTest, FindsEverySignatureInOnePass) {
+    auto image = make_noise(100000);
+    place(image, 10, {0xE8, 0x90, 0x91, 0xC3});
+    place(image, 16383, {0xF1, 0xF2, 0xF3, 0xF4});        // straddles a block boundary
+    place(image, 50000, {0xB8, 0x81, 0x82, 0x83, 0x84});
+    place(image, image.size() - 3, {0xFA, 0xFB, 0xFC});   // in the scalar tail
+
+    SignatureScanner scanner;
+    const auto call = scanner.add(*Signature::parse("E8 ?? 91 C3"));
+    const auto boundary = scanner.add(*Signature::parse("F1 F2 F3 F4"));
+    const auto mov = scanner.add(*Signature::parse("B8 ?? ?? ?? 84"));
+    const auto tail = scanner.add(*Signature::parse("FA FB FC"));
+    const auto missing = scanner.add(*Signature::parse("FE FE FE"));
+
+    const auto matches = scanner.scan(image);
+    ASSERT_EQ(matches.size(), 5u);
+    EXPECT_EQ(matches[call].offset, 10u);
+    EXPECT_EQ(matches[boundary].offset, 16383u);
+    EXPECT_EQ(matches[mov].offset, 50000u);
+    EXPECT_EQ(matches[tail].offset, image.size() - 3);
+    EXPECT_TRUE(matches[tail].unique());
+    EXPECT_EQ(matches[missing].count, 0u);
+    EXPECT_EQ(matches[missing].offset, SignatureMatch::npos);
+}
+
+TEST(SignatureScannerTest, CountsRepeatedMatches) {
+    auto image = make_noise(4096);
+    place(image, 100, {0xCC, 0xCD, 0x90});
+    place(image, 3000, {0xCC, 0xCD, 0x91});
+
+    SignatureScanner scanner;
+    scanner.add(*Signature::parse("CC CD ??"));
+    scanner.add(*Signature::parse("CC CD 91"));
+    const auto matches = scanner.scan(image);
+    EXPECT_EQ(matches[0].count, 2u);
+    EXPECT_EQ(matches[0].offset, 100u);
+    EXPECT_FALSE(matches[0].unique());
+    EXPECT_EQ(matches[1].count, 1u);
+    EXPECT_EQ(matches[1].offset, 3000u);
+}
+
+TEST(PeImageTest, ReadsStampAndCodeSection) {
+    FakeModule module;
+    auto image = read_module_image(module.base());
+    ASSERT_TRUE(image);
+    EXPECT_EQ(image->base, module.address());
+    EXPECT_EQ(image->code_begin, module.address() + FakeModule::kCodeRva);
+    EXPECT_EQ(image->code_size, FakeModule::kCodeSize);
+    EXPECT_EQ(image->stamp.timestamp, 0x5F000000u);
+    EXPECT_EQ(image->stamp.checksum, 0x1234u);
+
+    std::vector<std::uint8_t> junk(512, 0);
+    EXPECT_FALSE(read_module_image(junk.data()));
+    EXPECT_FALSE(read_module_image(nullptr));
+}
+
+class SignatureResolverTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = std::filesystem::temp_directory_path() / "app_hook_signature_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(dir_);
+    }
+
+    std::filesystem::path cache_path() const { return dir_ / SignatureResolver::kFileName; }
+
+    std::filesystem::path dir_;
+};
+
+TEST_F(SignatureResolverTest, ResolvesPositionsAndDerefs) {
+    FakeModule module;
+    place_code(module);
+    SignatureResolver resolver(*read_module_image(module.base()), {});
+
+    const std::vector<std::string> patterns = {"E8 F1 ^ F2 F3", "A1 & ?? ?? ?? ?? F5", "FE FE FE", "not a pattern"};
+    const auto addresses = resolver.resolve(patterns);
+    ASSERT_EQ(addresses.size(), 4u);
+    EXPECT_EQ(addresses[0], module.address() + FakeModule::kCodeRva + 0x102);
+    EXPECT_EQ(addresses[1], 0x00C0FFEEu);
+    EXPECT_EQ(addresses[2], 0u);
+    EXPECT_EQ(addresses[3], 0u);
+    EXPECT_EQ(resolver.scans(), 1u);
+}
+
+TEST_F(SignatureResolverTest, CacheSkipsTheScanForTheSameBuild) {
+    const std::vector<std::string> patterns = {"E8 F1 ^ F2 F3", "A1 & ?? ?? ?? ?? F5"};
+    std::vector<std::uintptr_t> first;
+    {
+        FakeModule module;
+        place_code(module);
+        SignatureResolver resolver(*read_module_image(module.base()), cache_path());
+        first = resolver.resolve(patterns);
+        EXPECT_EQ(resolver.scans(), 1u);
+    }
+    ASSERT_TRUE(std::filesystem::exists(cache_path()));
+
+    // Same build loaded elsewhere: positions follow the new base
+    FakeModule module;
+    SignatureResolver resolver(*read_module_image(module.base()), cache_path());
+    const auto addresses = resolver.resolve(patterns);
+    EXPECT_EQ(resolver.scans(), 0u);
+    EXPECT_EQ(resolver.hits(), 2u);
+    EXPECT_EQ(addresses[0], module.address() + FakeModule::kCodeRva + 0x102);
+    EXPECT_EQ(addresses[1], first[1]);
+}
+
+TEST_F(SignatureResolverTest, CacheOfAnotherBuildIsIgnored) {
+    const std::vector<std::string> patterns = {"E8 F1 ^ F2 F3"};
+    {
+        FakeModule module;
+        place_code(module);
+        SignatureResolver resolver(*read_module_image(module.base()), cache_path());
+        EXPECT_NE(resolver.resolve(patterns)[0], 0u);
+    }
+
+    // A relinked executable without the code: the stale address is not reused
+    FakeModule rebuilt(0x60000000);
+    SignatureResolver resolver(*read_module_image(rebuilt.base()), cache_path());
+    EXPECT_EQ(resolver.resolve(patterns)[0], 0u);
+    EXPECT_EQ(resolver.hits(), 0u);
+    EXPECT_EQ(resolver.scans(), 1u);
+}
+
+} // namespace app_hook::util
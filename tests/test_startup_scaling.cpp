@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include "modpack_generator.hpp"
+#include "hook/hook_factory.hpp"
+#include "hook/hook_manager.hpp"
+#include "config/config_cache.hpp"
+#include "config/config_factory.hpp"
+#include "config/task_loader.hpp"
+#include "task/task_factory.hpp"
+#include "config/memory_config_loader.hpp"
+#include "config/patch_config_loader.hpp"
+#include "config/load_in_memory_config_loader.hpp"
+#include "memory/copy_memory.hpp"
+#include "memory/patch_memory.hpp"
+#include "memory/load_in_memory.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+namespace app_hook::hook {
+
+namespace {
+
+/// @brief Cost of one create_hooks_from_tasks run
+struct StartupSample {
+    std::size_t tasks = 0;
+    double cold_ms = 0;       ///< No config cache: every file parsed
+    double warm_ms = 0;       ///< Every file served from the config cache
+    std::size_t hook_bytes = 0;
+
+    [[nodiscard]] double cold_us_per_task() const noexcept { return cold_ms * 1000.0 / static_cast<double>(tasks); }
+};
+
+} // namespace
+
+class StartupScalingTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        root_ = std::filesystem::temp_directory_path() / "startup_scaling_tests";
+        std::filesystem::remove_all(root_);
+
+        (void)config::ConfigFactory::register_loader(std::make_unique<::memory_plugin::MemoryConfigLoader>());
+        (void)config::ConfigFactory::register_loader(std::make_unique<::memory_plugin::PatchConfigLoader>());
+        (void)config::ConfigFactory::register_loader(std::make_unique<::memory_plugin::LoadInMemoryConfigLoader>());
+
+        // Same creators as the memory plugin, without a host
+        auto& tasks = task::TaskFactory::instance();
+        tasks.register_task_creator(std::string{config::CopyMemoryConfig::kTypeId}, [](const config::ConfigBase& config) {
+            return task::make_task<memory::CopyMemoryTask>(static_cast<const config::CopyMemoryConfig&>(config));
+        });
+        tasks.register_task_creator(std::string{config::PatchConfig::kTypeId}, [](const config::ConfigBase& config) {
+            return task::make_task<memory::PatchMemoryTask>(static_cast<const config::PatchConfig&>(config));
+        });
+        tasks.register_task_creator(std::string{config::LoadInMemoryConfig::kTypeId}, [](const config::ConfigBase& config) {
+            return task::make_task<memory::LoadInMemoryTask>(static_cast<const config::LoadInMemoryConfig&>(config));
+        });
+    }
+
+    void TearDown() override {
+        for (const auto& name : config::ConfigFactory::get_registered_loaders()) {
+            (void)config::ConfigFactory::unregister_loader(name);
+        }
+        task::TaskFactory::instance().clear_creators();
+        std::filesystem::remove_all(root_);
+    }
+
+    /// @brief Generate a modpack of n tasks and time startup on it, cold then warm
+    StartupSample Measure(std::size_t n) {
+        test::ModpackSpec spec;
+        spec.tasks = n;
+        const auto layout = test::generate_modpack(root_ / std::to_string(n), spec);
+        std::filesystem::remove(layout.tasks_path.parent_path() / config::ConfigCache::kFileName);
+
+        StartupSample sample;
+        sample.tasks = layout.tasks;
+        for (const bool warm : {false, true}) {
+            HookManager manager;
+            const auto start = std::chrono::steady_clock::now();
+            const auto result = HookFactory::create_hooks_from_tasks(layout.tasks_path.string(), manager);
+            const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            EXPECT_TRUE(result.has_value()) << "modpack of " << n << " tasks";
+            EXPECT_EQ(manager.hook_count(), layout.hooks);
+            EXPECT_EQ(manager.total_task_count(), layout.task_objects);
+
+            (warm ? sample.warm_ms : sample.cold_ms) = elapsed.count();
+            if (!warm) {
+                for (const auto& usage : manager.memory_usage()) {
+                    sample.hook_bytes += usage.bytes;
+                }
+            }
+        }
+
+        RecordProperty(std::format("tasks_{}_cold_ms", n), std::format("{:.2f}", sample.cold_ms));
+        RecordProperty(std::format("tasks_{}_warm_ms", n), std::format("{:.2f}", sample.warm_ms));
+        RecordProperty(std::format("tasks_{}_hook_bytes", n), std::to_string(sample.hook_bytes));
+        std::cout << std::format("[ startup  ] {:>5} tasks, {:>5} hooks, {:>6} instructions: "
+                                 "cold {:>8.2f} ms, warm {:>8.2f} ms, {:>9} hook bytes\n",
+                                 layout.tasks, layout.hooks, layout.instructions,
+                                 sample.cold_ms, sample.warm_ms, sample.hook_bytes);
+        return sample;
+    }
+
+    std::filesystem::path root_;
+};
+
+TEST_F(StartupScalingTest, GeneratedModpackMatchesItsSpec) {
+    test::ModpackSpec spec;
+    spec.tasks = 7;
+    spec.chain_depth = 3;
+    spec.regions_per_memory = 2;
+    spec.instructions_per_patch = 5;
+    const auto layout = test::generate_modpack(root_ / "spec", spec);
+
+    // Rounded up to two groups of memory, three loads and a patch
+    EXPECT_EQ(layout.tasks, 10u);
+    EXPECT_EQ(layout.hooks, 4u);
+    EXPECT_EQ(layout.instructions, 10u);
+
+    auto tasks = config::TaskLoader::load_tasks(layout.tasks_path.string());
+    ASSERT_TRUE(tasks.has_value());
+    EXPECT_EQ(tasks->size(), layout.tasks);
+    auto order = config::TaskLoader::build_execution_order(*tasks);
+    ASSERT_TRUE(order.has_value());
+
+    // Declared in reverse, run head first
+    const auto position = [&](const std::string& key) { return std::ranges::find(*order, key) - order->begin(); };
+    EXPECT_LT(position("memory_1"), position("load_1_0"));
+    EXPECT_LT(position("load_1_2"), position("patch_1"));
+}
+
+TEST_F(StartupScalingTest, StartupGrowsLinearlyWithTasks) {
+    (void)Measure(10);  // Reported only: too small to compare
+    const auto medium = Measure(100);
+    const auto large = Measure(1000);
+
+    // Hook memory follows the number of hooks and tasks
+    EXPECT_GT(large.hook_bytes, medium.hook_bytes * 5);
+    EXPECT_LT(large.hook_bytes, medium.hook_bytes * 20);
+
+    // A quadratic step costs 10x more per task for 10x the tasks; allow noise,
+    // and ignore runs too short to time
+    if (medium.cold_ms > 5.0) {
+        EXPECT_LT(large.cold_us_per_task(), medium.cold_us_per_task() * 4.0)
+            << "per-task startup cost grew from " << medium.cold_us_per_task() << " us to "
+            << large.cold_us_per_task() << " us";
+    }
+}
+
+} // namespace app_hook::hook
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "util/startup_trace.hpp"
+#include <string>
+
+namespace app_hook::util {
+
+class StartupTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        StartupTrace::instance().set_enabled(true);
+        StartupTrace::instance().reset();
+    }
+
+    void TearDown() override {
+        StartupTrace::instance().set_enabled(true);
+        StartupTrace::instance().reset();
+    }
+};
+
+TEST_F(StartupTraceTest, ScopeRecordsSpan) {
+    {
+        TraceScope scope("load_plugin", "plugins", "tasks/memory_plugin.dll");
+    }
+
+    const auto events = StartupTrace::instance().events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_EQ(events[0].name, "load_plugin");
+    EXPECT_EQ(events[0].category, "plugins");
+    EXPECT_EQ(events[0].detail, "tasks/memory_plugin.dll");
+    EXPECT_GE(events[0].start_us, 0);
+    EXPECT_GE(events[0].duration_us, 0);
+    EXPECT_FALSE(events[0].instant);
+}
+
+TEST_F(StartupTraceTest, NestedScopesRecordInnerFirst) {
+    {
+        TraceScope outer("create_hooks", "startup");
+        TraceScope inner("create_task", "tasks");
+    }
+
+    const auto events = StartupTrace::instance().events();
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[0].name, "create_task");
+    EXPECT_EQ(events[1].name, "create_hooks");
+    EXPECT_LE(events[1].start_us, events[0].start_us);
+    EXPECT_GE(events[1].start_us + events[1].duration_us, events[0].start_us + events[0].duration_us);
+}
+
+TEST_F(StartupTraceTest, MarkRecordsInstant) {
+    StartupTrace::instance().mark("hooks_active", "startup");
+
+    const auto events = StartupTrace::instance().events();
+    ASSERT_EQ(events.size(), 1u);
+    EXPECT_TRUE(events[0].instant);
+    EXPECT_EQ(events[0].duration_us, 0);
+}
+
+TEST_F(StartupTraceTest, DisabledTraceRecordsNothing) {
+    StartupTrace::instance().set_enabled(false);
+    {
+        TraceScope scope("install_hooks", "startup");
+    }
+    StartupTrace::instance().mark("hooks_active", "startup");
+
+    EXPECT_FALSE(StartupTrace::instance().enabled());
+    EXPECT_TRUE(StartupTrace::instance().events().empty());
+}
+
+TEST_F(StartupTraceTest, ResetDropsSpans) {
+    StartupTrace::instance().mark("install_thread_started", "startup");
+    StartupTrace::instance().reset();
+
+    EXPECT_TRUE(StartupTrace::instance().events().empty());
+}
+
+TEST_F(StartupTraceTest, ChromeTraceHasCompleteAndInstantEvents) {
+    StartupTrace::instance().record({"load_config_file", "tasks", "config/tasks.toml", 1500, 250, 7});
+    StartupTrace::instance().mark("hooks_active", "startup");
+
+    const auto json = StartupTrace::instance().to_chrome_trace();
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"load_config_file\",\"cat\":\"tasks\",\"ph\":\"X\",\"ts\":1500,\"dur\":250"),
+              std::string::npos);
+    EXPECT_NE(json.find("\"tid\":7,\"args\":{\"detail\":\"config/tasks.toml\"}"), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"hooks_active\",\"cat\":\"startup\",\"ph\":\"i\",\"s\":\"p\""), std::string::npos);
+    EXPECT_NE(json.find("\"displayTimeUnit\":\"ms\""), std::string::npos);
+}
+
+TEST_F(StartupTraceTest, ChromeTraceEscapesStrings) {
+    StartupTrace::instance().record({"load_plugin", "plugins", "C:\\mods\\\"odd\".dll\n", 0, 1, 1});
+
+    const auto json = StartupTrace::instance().to_chrome_trace();
+    EXPECT_NE(json.find("\"detail\":\"C:\\\\mods\\\\\\\"odd\\\".dll\\n\""), std::string::npos);
+}
+
+} // namespace app_hook::util
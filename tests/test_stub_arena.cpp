@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "hook/stub_arena.hpp"
+#include <cstring>
+#include <set>
+
+namespace app_hook::hook {
+
+class StubArenaTest : public ::testing::Test {
+protected:
+    StubArena arena_;
+};
+
+TEST_F(StubArenaTest, SlotsAreCacheLineAlignedAndPacked) {
+    arena_.begin_write();
+    void* first = arena_.allocate(23);
+    void* second = arena_.allocate(23);
+    arena_.end_write();
+    
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % StubArena::kSlotSize, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(second) - reinterpret_cast<std::uintptr_t>(first),
+              StubArena::kSlotSize);
+    EXPECT_EQ(arena_.slot_count(), 2u);
+    EXPECT_EQ(arena_.committed_bytes(), StubArena::kPageSize);
+    EXPECT_EQ(arena_.reserved_bytes(), StubArena::kChunkSize);
+}
+
+TEST_F(StubArenaTest, RejectsOversizedStubs) {
+    EXPECT_EQ(arena_.allocate(0), nullptr);
+    EXPECT_EQ(arena_.allocate(StubArena::kSlotSize + 1), nullptr);
+}
+
+TEST_F(StubArenaTest, SlotsAreWritableDuringWriteAndReadableAfter) {
+    const unsigned char code[] = {0x90, 0x90, 0xC3};
+    
+    arena_.begin_write();
+    void* slot = arena_.allocate(sizeof(code));
+    ASSERT_NE(slot, nullptr);
+    std::memcpy(slot, code, sizeof(code));
+    arena_.end_write();
+    
+    EXPECT_EQ(std::memcmp(slot, code, sizeof(code)), 0);
+}
+
+TEST_F(StubArenaTest, DeallocatedSlotsAreReused) {
+    arena_.begin_write();
+    void* slot = arena_.allocate(16);
+    arena_.deallocate(slot);
+    EXPECT_EQ(arena_.slot_count(), 0u);
+    EXPECT_EQ(arena_.allocate(16), slot);
+    arena_.end_write();
+}
+
+TEST_F(StubArenaTest, TracksPeakSlotCount) {
+    arena_.begin_write();
+    void* first = arena_.allocate(16);
+    void* second = arena_.allocate(16);
+    arena_.deallocate(first);
+    arena_.deallocate(second);
+    (void)arena_.allocate(16);
+    arena_.end_write();
+    
+    EXPECT_EQ(arena_.slot_count(), 1u);
+    EXPECT_EQ(arena_.peak_slot_count(), 2u);
+}
+
+TEST_F(StubArenaTest, GrowsIntoNewChunks) {
+    const std::size_t slots_per_chunk = StubArena::kChunkSize / StubArena::kSlotSize;
+    std::set<void*> slots;
+    
+    arena_.begin_write();
+    for (std::size_t i = 0; i < slots_per_chunk + 1; ++i) {
+        void* slot = arena_.allocate(StubArena::kSlotSize);
+        ASSERT_NE(slot, nullptr);
+        slots.insert(slot);
+    }
+    arena_.end_write();
+    
+    EXPECT_EQ(slots.size(), slots_per_chunk + 1);
+    EXPECT_EQ(arena_.reserved_bytes(), 2 * StubArena::kChunkSize);
+    
+    arena_.release();
+    EXPECT_EQ(arena_.slot_count(), 0u);
+    EXPECT_EQ(arena_.reserved_bytes(), 0u);
+}
+
+} // namespace app_hook::hook
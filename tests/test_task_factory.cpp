@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "task/task_factory.hpp"
+#include "task/hook_task.hpp"
+#include "config/config_base.hpp"
+
+namespace app_hook::task {
+
+namespace {
+
+// Config declaring a stable type ID
+class TypedConfig : public config::ConfigBase {
+public:
+    static constexpr std::string_view kTypeId = "tests::TypedConfig";
+    static constexpr config::ConfigType kConfigType = config::ConfigType::Memory;
+    
+    explicit TypedConfig(std::string key) : ConfigBase(kConfigType, key, key) {}
+    
+    std::string_view type_id() const noexcept override { return kTypeId; }
+};
+
+// Config of the same type as TypedConfig, e.g. from a plugin DLL
+class OtherTypedConfig : public config::ConfigBase {
+public:
+    static constexpr std::string_view kTypeId = "tests::OtherTypedConfig";
+    
+    explicit OtherTypedConfig(std::string key) : ConfigBase(config::ConfigType::Memory, key, key) {}
+    
+    std::string_view type_id() const noexcept override { return kTypeId; }
+};
+
+// Config without a type ID, matched by RTTI name
+class LegacyFactoryConfig : public config::ConfigBase {
+public:
+    explicit LegacyFactoryConfig(std::string key) : ConfigBase(config::ConfigType::Patch, key, key) {}
+};
+
+class NamedTask : public IHookTask {
+public:
+    explicit NamedTask(std::string name) : name_(std::move(name)) {}
+    std::string name() const override { return name_; }
+    std::string description() const override { return name_; }
+    TaskResult execute() override { return {}; }
+    
+private:
+    std::string name_;
+};
+
+// Task created by a built-in creator
+class TypedTask : public IHookTask {
+public:
+    explicit TypedTask(const TypedConfig& config) : key_(config.key()) {}
+    std::string name() const override { return key_; }
+    std::string description() const override { return key_; }
+    TaskResult execute() override { return {}; }
+    void setHost(void* host) override { host_ = host; }
+    
+    void* host() const { return host_; }
+    
+private:
+    std::string key_;
+    void* host_ = nullptr;
+};
+
+} // namespace
+
+class TaskFactoryTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        TaskFactory::instance().clear_creators();
+    }
+};
+
+TEST_F(TaskFactoryTest, DispatchesByDeclaredTypeId) {
+    int calls = 0;
+    ASSERT_TRUE(TaskFactory::instance().register_task_creator(
+        std::string{TypedConfig::kTypeId}, [&calls](const config::ConfigBase& config) -> HookTaskPtr {
+            ++calls;
+            return std::make_unique<NamedTask>(static_cast<const TypedConfig&>(config).key());
+        }));
+    
+    auto task = TaskFactory::instance().create_task(TypedConfig("typed"));
+    ASSERT_NE(task, nullptr);
+    EXPECT_EQ(task->name(), "typed");
+    EXPECT_EQ(calls, 1);
+}
+
+TEST_F(TaskFactoryTest, TypeIdNeverFallsBackToNameMatching) {
+    // A creator whose name is a substring of the type ID must not be picked
+    ASSERT_TRUE(TaskFactory::instance().register_task_creator(
+        "TypedConfig", [](const config::ConfigBase&) -> HookTaskPtr { return std::make_unique<NamedTask>("wrong"); }));
+    
+    EXPECT_EQ(TaskFactory::instance().create_task(TypedConfig("typed")), nullptr);
+}
+
+TEST_F(TaskFactoryTest, ResolvesConfigsWithoutTypeIdByRttiName) {
+    int calls = 0;
+    ASSERT_TRUE(TaskFactory::instance().register_task_creator(
+        "LegacyFactoryConfig", [&calls](const config::ConfigBase& config) -> HookTaskPtr {
+            ++calls;
+            return std::make_unique<NamedTask>(config.key());
+        }));
+    
+    for (int i = 0; i < 3; ++i) {
+        auto task = TaskFactory::instance().create_task(LegacyFactoryConfig("legacy"));
+        ASSERT_NE(task, nullptr);
+    }
+    EXPECT_EQ(calls, 3);
+}
+
+TEST_F(TaskFactoryTest, RegisteringRefreshesCachedMisses) {
+    const LegacyFactoryConfig config("late");
+    EXPECT_EQ(TaskFactory::instance().create_task(config), nullptr);
+    
+    ASSERT_TRUE(TaskFactory::instance().register_task_creator(
+        "LegacyFactoryConfig", [](const config::ConfigBase& base) -> HookTaskPtr {
+            return std::make_unique<NamedTask>(base.key());
+        }));
+    
+    EXPECT_NE(TaskFactory::instance().create_task(config), nullptr);
+}
+
+TEST_F(TaskFactoryTest, BuiltinCreatorsSetTheHost) {
+    int host = 0;
+    auto& factory = TaskFactory::instance();
+    factory.register_builtin_creator<TypedConfig, TypedTask>(&host);
+    EXPECT_TRUE(factory.has_creator(std::string{TypedConfig::kTypeId}));
+    
+    auto task = factory.create_task(TypedConfig("builtin"));
+    ASSERT_NE(task, nullptr);
+    EXPECT_EQ(task->name(), "builtin");
+    EXPECT_EQ(static_cast<TypedTask&>(*task).host(), &host);
+    
+    factory.clear_creators();
+    EXPECT_EQ(factory.create_task(TypedConfig("builtin")), nullptr);
+}
+
+TEST_F(TaskFactoryTest, BuiltinCreatorsOnlyTakeTheirConfigClass) {
+    auto& factory = TaskFactory::instance();
+    factory.register_builtin_creator<TypedConfig, TypedTask>(nullptr);
+    ASSERT_TRUE(factory.register_task_creator(
+        std::string{OtherTypedConfig::kTypeId}, [](const config::ConfigBase& config) -> HookTaskPtr {
+            return std::make_unique<NamedTask>("named " + config.key());
+        }));
+    
+    // Same config type, another class: the named creator is used
+    auto task = factory.create_task(OtherTypedConfig("other"));
+    ASSERT_NE(task, nullptr);
+    EXPECT_EQ(task->name(), "named other");
+}
+
+} // namespace app_hook::task
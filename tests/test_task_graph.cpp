@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include "config/task_loader.hpp"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace app_hook::config {
+
+namespace {
+
+TaskInfo make_task(const std::string& key, std::vector<std::string> follow_by = {}) {
+    TaskInfo task;
+    task.name = key;
+    task.config_file = "config/" + key + ".toml";
+    task.type = ConfigType::Patch;
+    task.follow_by = std::move(follow_by);
+    return task;
+}
+
+// Position of a task in the execution order
+std::size_t position(const TaskGraph& graph, const std::string& key) {
+    const auto id = graph.find(key);
+    EXPECT_TRUE(id.has_value()) << key;
+    const auto order = graph.order();
+    return static_cast<std::size_t>(std::find(order.begin(), order.end(), *id) - order.begin());
+}
+
+} // namespace
+
+TEST(TaskGraphTest, KeyFromFileStripsDirectoryAndExtension) {
+    EXPECT_EQ(TaskGraph::key_from_file("config/sub/memory_task.toml"), "memory_task");
+    EXPECT_EQ(TaskGraph::key_from_file("patch.toml"), "patch");
+    EXPECT_EQ(TaskGraph::key_from_file("plain"), "plain");
+}
+
+TEST(TaskGraphTest, InternsTasksInDeclarationOrder) {
+    const std::vector<TaskInfo> tasks = {make_task("a"), make_task("b"), make_task("c")};
+    auto graph = TaskGraph::build(tasks);
+    ASSERT_TRUE(graph.has_value());
+    
+    ASSERT_EQ(graph->size(), 3u);
+    for (TaskGraph::TaskId id = 0; id < 3; ++id) {
+        EXPECT_EQ(&graph->task(id), &tasks[id]);
+        EXPECT_EQ(graph->find(graph->key(id)), id);
+    }
+    EXPECT_FALSE(graph->find("missing").has_value());
+}
+
+TEST(TaskGraphTest, OrdersParentsBeforeFollowers) {
+    // Declared with followers first to make sure order does not follow declaration
+    const std::vector<TaskInfo> tasks = {
+        make_task("leaf"),
+        make_task("middle", {"leaf"}),
+        make_task("root", {"middle", "side"}),
+        make_task("side", {"leaf"}),
+    };
+    auto graph = TaskGraph::build(tasks);
+    ASSERT_TRUE(graph.has_value());
+    ASSERT_EQ(graph->order().size(), 4u);
+    
+    EXPECT_LT(position(*graph, "root"), position(*graph, "middle"));
+    EXPECT_LT(position(*graph, "root"), position(*graph, "side"));
+    EXPECT_LT(position(*graph, "middle"), position(*graph, "leaf"));
+    EXPECT_LT(position(*graph, "side"), position(*graph, "leaf"));
+    
+    const auto leaf = *graph->find("leaf");
+    ASSERT_EQ(graph->parents(leaf).size(), 2u);
+    EXPECT_EQ(graph->key(graph->parents(leaf)[0]), "middle");
+    EXPECT_EQ(graph->key(graph->parents(leaf)[1]), "side");
+    EXPECT_EQ(graph->followers(*graph->find("root")).size(), 2u);
+}
+
+TEST(TaskGraphTest, LevelsGroupIndependentTasks) {
+    const std::vector<TaskInfo> tasks = {
+        make_task("root_a", {"child"}),
+        make_task("root_b"),
+        make_task("child", {"grandchild"}),
+        make_task("grandchild"),
+    };
+    auto graph = TaskGraph::build(tasks);
+    ASSERT_TRUE(graph.has_value());
+    
+    ASSERT_EQ(graph->level_count(), 3u);
+    ASSERT_EQ(graph->level(0).size(), 2u);
+    EXPECT_EQ(graph->key(graph->level(0)[0]), "root_a");
+    EXPECT_EQ(graph->key(graph->level(0)[1]), "root_b");
+    ASSERT_EQ(graph->level(1).size(), 1u);
+    EXPECT_EQ(graph->key(graph->level(1)[0]), "child");
+    ASSERT_EQ(graph->level(2).size(), 1u);
+    EXPECT_EQ(graph->key(graph->level(2)[0]), "grandchild");
+}
+
+TEST(TaskGraphTest, DetectsCycles) {
+    const std::vector<TaskInfo> tasks = {
+        make_task("a", {"b"}),
+        make_task("b", {"c"}),
+        make_task("c", {"a"}),
+        make_task("free"),
+    };
+    auto graph = TaskGraph::build(tasks);
+    ASSERT_FALSE(graph.has_value());
+    EXPECT_EQ(graph.error(), ConfigError::invalid_format);
+    
+    const std::vector<TaskInfo> self = {make_task("loop", {"loop"})};
+    EXPECT_FALSE(TaskGraph::build(self).has_value());
+}
+
+TEST(TaskGraphTest, IgnoresUnknownFollowersAndDuplicateKeys) {
+    std::vector<TaskInfo> tasks = {
+        make_task("parent", {"ghost", "child"}),
+        make_task("child"),
+        make_task("child"),
+    };
+    tasks[2].name = "duplicate";
+    auto graph = TaskGraph::build(tasks);
+    ASSERT_TRUE(graph.has_value());
+    
+    ASSERT_EQ(graph->size(), 2u);
+    EXPECT_EQ(graph->task(*graph->find("child")).name, "child");
+    ASSERT_EQ(graph->followers(*graph->find("parent")).size(), 1u);
+}
+
+TEST(TaskGraphTest, ScalesToThousandsOfTasks) {
+    // One root fanning out to a long chain of small patch tasks
+    constexpr int kTasks = 5000;
+    std::vector<TaskInfo> tasks;
+    tasks.reserve(kTasks);
+    for (int i = 0; i < kTasks; ++i) {
+        std::vector<std::string> follow_by;
+        if (i + 1 < kTasks) {
+            follow_by.push_back("task_" + std::to_string(i + 1));
+        }
+        tasks.push_back(make_task("task_" + std::to_string(i), std::move(follow_by)));
+    }
+    
+    auto graph = TaskGraph::build(tasks);
+    ASSERT_TRUE(graph.has_value());
+    ASSERT_EQ(graph->order().size(), static_cast<std::size_t>(kTasks));
+    EXPECT_EQ(graph->level_count(), static_cast<std::size_t>(kTasks));
+    for (int i = 0; i < kTasks; ++i) {
+        EXPECT_EQ(graph->order()[i], static_cast<TaskGraph::TaskId>(i));
+    }
+}
+
+TEST(TaskGraphTest, BuildExecutionOrderReturnsKeys) {
+    const std::vector<TaskInfo> tasks = {make_task("child"), make_task("parent", {"child"})};
+    auto order = TaskLoader::build_execution_order(tasks);
+    ASSERT_TRUE(order.has_value());
+    EXPECT_EQ(*order, (std::vector<std::string>{"parent", "child"}));
+}
+
+} // namespace app_hook::config
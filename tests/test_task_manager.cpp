@@ -450,4 +450,55 @@ TEST_F(TaskManagerTest, MixedTaskResults) {
     EXPECT_FALSE(manager.execute_all());
 }
 
-} // namespace app_hook::util 
\ No newline at end of file
+TEST_F(TaskManagerTest, DependenciesOrderTasksAndSkipFollowersOfFailures) {
+    TaskManager manager;
+    manager.set_thread_count(4);
+    
+    auto copy = std::make_unique<MockHookTask>("copy", "Copy");
+    auto patch = std::make_unique<MockHookTask>("patch", "Patch");
+    auto broken = std::make_unique<MockHookTask>("broken", "Broken", task::TaskError::file_not_found);
+    auto after_broken = std::make_unique<MockHookTask>("after_broken", "After broken");
+    MockHookTask* patch_ptr = patch.get();
+    MockHookTask* after_broken_ptr = after_broken.get();
+    
+    manager.add_task(std::move(copy));
+    manager.add_task(std::move(patch));
+    manager.add_task(std::move(broken));
+    manager.add_task(std::move(after_broken));
+    manager.add_dependency(0, 1);
+    manager.add_dependency(2, 3);
+    
+    const auto runs = manager.execute_all_timed();
+    ASSERT_EQ(runs.size(), 4u);
+    EXPECT_TRUE(runs[1].result.has_value());
+    EXPECT_EQ(patch_ptr->get_execute_count(), 1);
+    EXPECT_EQ(runs[2].result.error(), task::TaskError::file_not_found);
+    EXPECT_TRUE(runs[3].skipped);
+    EXPECT_EQ(runs[3].result.error(), task::TaskError::dependency_not_met);
+    EXPECT_EQ(after_broken_ptr->get_execute_count(), 0);
+}
+
+TEST_F(TaskManagerTest, DependenciesFromTaskGraph) {
+    std::vector<config::TaskInfo> infos(2);
+    infos[0].name = "parent";
+    infos[0].config_file = "parent.toml";
+    infos[0].type = config::ConfigType::Memory;
+    infos[0].follow_by = {"child"};
+    infos[1].name = "child";
+    infos[1].config_file = "child.toml";
+    infos[1].type = config::ConfigType::Patch;
+    auto graph = config::TaskGraph::build(infos);
+    ASSERT_TRUE(graph.has_value());
+    
+    TaskManager manager;
+    manager.add_task(std::make_unique<MockHookTask>("parent", "Parent", task::TaskError::copy_failed));
+    auto child = std::make_unique<MockHookTask>("child", "Child");
+    MockHookTask* child_ptr = child.get();
+    manager.add_task(std::move(child));
+    manager.add_dependencies(*graph);
+    
+    EXPECT_FALSE(manager.execute_all());
+    EXPECT_EQ(child_ptr->get_execute_count(), 0);
+}
+
+} // namespace app_hook::util
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "../memory_plugin/include/config/text_config_loader.hpp"
+#include "../memory_plugin/include/config/text_config.hpp"
+#include "../memory_plugin/include/config/text_encoder.hpp"
+#include "mock_plugin_host.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace memory_plugin;
+using namespace app_hook::config;
+using namespace testing;
+
+class TextConfigLoaderTest : public Test {
+protected:
+    void SetUp() override {
+        loader_ = std::make_unique<TextConfigLoader>();
+        mock_host_ = std::make_unique<MockPluginHost>();
+        loader_->setHost(mock_host_.get());
+
+        temp_dir_ = std::filesystem::temp_directory_path() / "text_loader_test";
+        std::filesystem::create_directories(temp_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(temp_dir_);
+    }
+
+    std::string create_test_file(const std::string& filename, const std::string& content) {
+        auto file_path = temp_dir_ / filename;
+        std::ofstream file(file_path, std::ios::binary);
+        file << content;
+        return file_path.string();
+    }
+
+    std::unique_ptr<TextConfigLoader> loader_;
+    std::unique_ptr<MockPluginHost> mock_host_;
+    std::filesystem::path temp_dir_;
+};
+
+TEST_F(TextConfigLoaderTest, SupportedTypes) {
+    EXPECT_EQ(loader_->supported_types(), std::vector<ConfigType>{ConfigType::Text});
+    EXPECT_EQ(from_string("text"), ConfigType::Text);
+    EXPECT_EQ(to_string(ConfigType::Text), "text");
+}
+
+TEST_F(TextConfigLoaderTest, EncoderMapsCharactersAndEscapes) {
+    auto encoder = TextEncoder::ascii();
+    const std::uint8_t e_acute[] = {0x1F, 0x45};
+    ASSERT_TRUE(encoder.map(U'\u00E9', e_acute));
+    const std::uint8_t sword = 0xF0;
+    ASSERT_TRUE(encoder.map(U'\U0001F5E1', {&sword, 1}));
+    EXPECT_FALSE(encoder.map(U'x', {}));
+
+    std::vector<std::uint8_t> out;
+    ASSERT_TRUE(encoder.encode("A\xC3\xA9{0A}{{\xF0\x9F\x97\xA1", out).has_value());
+    EXPECT_THAT(out, ElementsAre(0x41, 0x1F, 0x45, 0x0A, 0x7B, 0xF0));
+
+    // Unmapped characters, bad escapes and invalid UTF-8 report where they start
+    out.clear();
+    auto unmapped = encoder.encode("ab\xE2\x82\xAC", out);
+    ASSERT_FALSE(unmapped.has_value());
+    EXPECT_EQ(unmapped.error(), 2u);
+    EXPECT_EQ(encoder.encode("x{1}", out).error(), 1u);
+    EXPECT_EQ(encoder.encode("\xC0\x80", out).error(), 0u);
+}
+
+TEST_F(TextConfigLoaderTest, LoadStringsInOnePass) {
+    const auto path = create_test_file("names.toml", R"(
+        [text.NAMES]
+        readFromContext = "ff8.magic.k_magic_text"
+        writeInContext = { enabled = true, name = "ff8.magic.names" }
+        offset = "0x100"
+        strings = ["Fire", "", "Ice"]
+    )");
+
+    auto result = loader_->load_configs(ConfigType::Text, path, "magic_mod");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+
+    const auto* text = static_cast<TextConfig*>((*result)[0].get());
+    EXPECT_EQ(text->key(), "magic_mod_NAMES");
+    EXPECT_EQ(text->offset(), 0x100u);
+    EXPECT_EQ(text->offset_width(), 2);
+    EXPECT_THAT(text->offsets(), ElementsAre(0u, 5u, 6u));
+    EXPECT_THAT(text->data(), ElementsAre('F', 'i', 'r', 'e', 0, 0, 'I', 'c', 'e', 0));
+    EXPECT_EQ(text->table_bytes(), 6u);
+    EXPECT_EQ(text->entry(1), 11u);
+    EXPECT_TRUE(text->is_valid());
+}
+
+TEST_F(TextConfigLoaderTest, LoadSidecarStringsWithCharmap) {
+    create_test_file("ff8.charmap.toml", R"(
+        [charmap]
+        "A" = 0x45
+        "B" = 0x46
+        "\u00E9" = [0x1F, 0x45]
+    )");
+    create_test_file("strings.txt", "\xEF\xBB\xBF" "AB\r\n\xC3\xA9{02}\r\n");
+    const auto path = create_test_file("sidecar.toml", R"(
+        [text.SIDECAR]
+        readFromContext = "region"
+        file = "strings.txt"
+        charmap = "ff8.charmap.toml"
+        offsetWidth = 4
+        offsetsFrom = "data"
+        terminator = 0xFF
+    )");
+
+    auto result = loader_->load_configs(ConfigType::Text, path, "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+
+    const auto* text = static_cast<TextConfig*>((*result)[0].get());
+    EXPECT_THAT(text->offsets(), ElementsAre(0u, 3u));
+    EXPECT_THAT(text->data(), ElementsAre(0x45, 0x46, 0xFF, 0x1F, 0x45, 0x02, 0xFF));
+    EXPECT_EQ(text->entry(1), 3u);
+    EXPECT_EQ(text->sources().size(), 2u);
+}
+
+TEST_F(TextConfigLoaderTest, InvalidTablesAreSkipped) {
+    create_test_file("bad.charmap.toml", "[charmap]\n\"AB\" = 0x01\n");
+    const auto path = create_test_file("invalid.toml", R"(
+        [text.no_region]
+        strings = ["a"]
+
+        [text.no_strings]
+        readFromContext = "region"
+
+        [text.unmapped]
+        readFromContext = "region"
+        strings = ["caf\u00E9"]
+
+        [text.bad_width]
+        readFromContext = "region"
+        offsetWidth = 3
+        strings = ["a"]
+
+        [text.bad_charmap]
+        readFromContext = "region"
+        charmap = "bad.charmap.toml"
+        strings = ["a"]
+
+        [text.missing_file]
+        readFromContext = "region"
+        file = "missing.txt"
+
+        [text.good]
+        readFromContext = "region"
+        strings = ["a"]
+    )");
+
+    auto result = loader_->load_configs(ConfigType::Text, path, "test_task");
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+    EXPECT_EQ((*result)[0]->name(), "good");
+}
+
+TEST_F(TextConfigLoaderTest, TableTooLargeForNarrowOffsets) {
+    const std::string long_string(70'000, 'a');
+    const auto path = create_test_file("large.toml",
+        "[text.large]\nreadFromContext = \"region\"\nstrings = [\"" + long_string + "\", \"b\"]\n");
+
+    auto result = loader_->load_configs(ConfigType::Text, path, "test_task");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_TRUE(result->empty());
+}
+
+TEST_F(TextConfigLoaderTest, CacheRoundTrip) {
+    create_test_file("lines.txt", "one\ntwo\n");
+    const auto path = create_test_file("cached.toml", R"(
+        [text.cached]
+        readFromContext = "region"
+        file = "lines.txt"
+        offset = 16
+    )");
+
+    auto loaded = loader_->load_configs(ConfigType::Text, path, "test_task");
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_EQ(loaded->size(), 1);
+    ASSERT_NE(loader_->cache_version(), 0u);
+
+    app_hook::util::ByteWriter out;
+    ASSERT_TRUE(loader_->serialize_configs(*loaded, out));
+
+    app_hook::util::ByteReader in(out.data());
+    auto restored = loader_->deserialize_configs(ConfigType::Text, in, "test_task");
+    ASSERT_TRUE(restored.has_value());
+    ASSERT_EQ(restored->size(), 1);
+    EXPECT_EQ(in.remaining(), 0u);
+
+    const auto* original = static_cast<TextConfig*>((*loaded)[0].get());
+    const auto* text = static_cast<TextConfig*>((*restored)[0].get());
+    EXPECT_EQ(text->key(), original->key());
+    EXPECT_EQ(text->offset(), 16u);
+    EXPECT_EQ(text->offsets(), original->offsets());
+    EXPECT_EQ(text->data(), original->data());
+    EXPECT_EQ(text->sources(), original->sources());
+
+    // A truncated snapshot is rejected
+    const auto data = out.data();
+    app_hook::util::ByteReader truncated(data.first(data.size() - 1));
+    EXPECT_FALSE(loader_->deserialize_configs(ConfigType::Text, truncated, "test_task").has_value());
+
+    // An edited strings file makes the snapshot stale
+    create_test_file("lines.txt", "one\ntwo\nthree\n");
+    app_hook::util::ByteReader stale(out.data());
+    EXPECT_FALSE(loader_->deserialize_configs(ConfigType::Text, stale, "test_task").has_value());
+}
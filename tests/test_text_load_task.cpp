@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "../memory_plugin/include/memory/text_load.hpp"
+#include "../memory_plugin/include/memory/text_index.hpp"
+#include "../memory_plugin/include/memory/region_arena.hpp"
+#include "../memory_plugin/include/config/text_config.hpp"
+#include "../memory_plugin/include/config/text_encoder.hpp"
+#include "../memory_plugin/include/memory/memory_region.hpp"
+#include "mock_plugin_host.hpp"
+#include <cstring>
+
+using namespace app_hook::memory;
+using namespace app_hook::config;
+using namespace app_hook::task;
+using namespace testing;
+
+class TextLoadTaskTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        mock_host_ = std::make_unique<MockPluginHost>();
+        MemoryRegion region(64, 16, 0x401000, "Text target");
+        std::memset(region.data.get(), 0x11, 64);
+        context().store_data(kRegion, std::move(region));
+    }
+
+    void TearDown() override {
+        (void)context().remove_data(kRegion);
+        (void)context().remove_data(kView);
+        (void)context().remove_data(std::string(kView) + ".index");
+    }
+
+    static app_hook::context::ModContext& context() {
+        return app_hook::context::ModContext::instance();
+    }
+
+    static std::uint8_t* target() {
+        return context().get_data<MemoryRegion>(kRegion)->data.get();
+    }
+
+    static TextConfig make_text(std::initializer_list<std::string_view> strings, std::uint8_t width = 2) {
+        TextConfig config("text_key", "text_name");
+        config.set_read_from_context(kRegion);
+        config.set_write_in_context({true, kView});
+        config.set_offset_width(width);
+        const auto encoder = TextEncoder::ascii();
+        for (const auto string : strings) {
+            EXPECT_TRUE(encoder.encode(string, config.begin_string()).has_value());
+            config.end_string();
+        }
+        return config;
+    }
+
+    static constexpr const char* kRegion = "text_target_region";
+    static constexpr const char* kView = "text_target_names";
+    std::unique_ptr<MockPluginHost> mock_host_;
+};
+
+TEST_F(TextLoadTaskTest, WritesTableAfterOriginalBytes) {
+    TextLoadTask task(make_text({"Fire", "Ice"}));
+    task.setHost(mock_host_.get());
+
+    ASSERT_TRUE(task.execute().has_value());
+    const auto* block = target() + 16;
+    EXPECT_THAT(std::vector<std::uint8_t>(block, block + 13),
+                ElementsAre(4, 0, 9, 0, 'F', 'i', 'r', 'e', 0, 'I', 'c', 'e', 0));
+    EXPECT_EQ(target()[15], 0x11);
+    EXPECT_EQ(target()[29], 0x11);
+    EXPECT_EQ(task.name(), "TextLoad");
+
+    // The view covers the block and the index finds each string
+    const auto* view = context().get_data<MemoryRegion>(kView);
+    ASSERT_NE(view, nullptr);
+    EXPECT_EQ(view->base(), target() + 16);
+    EXPECT_EQ(view->size, 13u);
+    const auto* index = context().get_data<TextIndex>(std::string(kView) + ".index");
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->count(), 2u);
+    EXPECT_EQ(index->string(1), target() + 16 + 9);
+    EXPECT_THAT(index->bytes(0), ElementsAre('F', 'i', 'r', 'e'));
+    EXPECT_THAT(index->bytes(1), ElementsAre('I', 'c', 'e'));
+    EXPECT_EQ(index->string(2), nullptr);
+}
+
+TEST_F(TextLoadTaskTest, DataRelativeWideOffsetsAtFixedOffset) {
+    auto config = make_text({"ab", "c"}, 4);
+    config.set_offset(32);
+    config.set_offset_base(TextOffsetBase::data);
+    TextLoadTask task(std::move(config));
+
+    ASSERT_TRUE(task.execute().has_value());
+    const auto* block = target() + 32;
+    EXPECT_THAT(std::vector<std::uint8_t>(block, block + 13),
+                ElementsAre(0, 0, 0, 0, 3, 0, 0, 0, 'a', 'b', 0, 'c', 0));
+}
+
+TEST_F(TextLoadTaskTest, TablePastTheRegionWritesNothing) {
+    auto config = make_text({"Fire"});
+    config.set_offset(60);
+    TextLoadTask task(std::move(config));
+
+    auto result = task.execute();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), TaskError::invalid_address);
+    EXPECT_EQ(target()[60], 0x11);
+    EXPECT_EQ(context().get_data<TextIndex>(std::string(kView) + ".index"), nullptr);
+}
+
+TEST_F(TextLoadTaskTest, GrowsReservedRegion) {
+    auto& arena = RegionArena::instance();
+    auto* base = arena.reserve("text_grow_region", 1024 * 1024, 16);
+    ASSERT_NE(base, nullptr);
+    context().store_data("text_grow_region",
+                         MemoryRegion::make_reserved_region(base, 16, 1024 * 1024, 16, 0x401000, "Growable target"));
+
+    TextConfig config("grow_key", "grow_text");
+    config.set_read_from_context("text_grow_region");
+    const auto encoder = TextEncoder::ascii();
+    ASSERT_TRUE(encoder.encode(std::string(100, 'x'), config.begin_string()).has_value());
+    config.end_string();
+    TextLoadTask task(std::move(config));
+    ASSERT_TRUE(task.execute().has_value());
+
+    const auto* region = context().get_data<MemoryRegion>("text_grow_region");
+    ASSERT_NE(region, nullptr);
+    EXPECT_EQ(region->base(), base);
+    EXPECT_EQ(region->size, 16u + 2 + 101);
+    EXPECT_EQ(base[16], 2);
+    EXPECT_EQ(base[16 + 2 + 100], 0);
+    EXPECT_TRUE(context().remove_data("text_grow_region"));
+}
+
+TEST_F(TextLoadTaskTest, ReloadRewritesTheTable) {
+    const auto config = make_text({"Fire"});
+    TextLoadTask task(config);
+    task.setHost(mock_host_.get());
+    EXPECT_EQ(task.reload(config), ReloadOutcome::unchanged);
+    ASSERT_TRUE(task.execute().has_value());
+
+    EXPECT_EQ(task.reload(make_text({"Fira", "Ice"})), ReloadOutcome::updated);
+    EXPECT_EQ(target()[16], 4);
+    EXPECT_EQ(target()[16 + 4 + 3], 'a');
+    const auto* index = context().get_data<TextIndex>(std::string(kView) + ".index");
+    ASSERT_NE(index, nullptr);
+    EXPECT_EQ(index->count(), 2u);
+
+    // Another target region needs the hooks rebuilt
+    auto moved = make_text({"Fire"});
+    moved.set_read_from_context("text_other_region");
+    EXPECT_EQ(task.reload(moved), ReloadOutcome::restart_required);
+}
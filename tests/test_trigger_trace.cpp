@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include "hook/hook_manager.hpp"
+#include "hook/trigger_trace.hpp"
+#include <filesystem>
+#include <fstream>
+
+namespace app_hook::hook {
+
+// Task that fails when told to
+class OutcomeTask : public task::IHookTask {
+public:
+    explicit OutcomeTask(const bool& fail) : fail_(fail) {}
+
+    task::TaskResult execute() override {
+        if (fail_) {
+            return std::unexpected(task::TaskError::unknown_error);
+        }
+        return {};
+    }
+
+    std::string name() const override { return "outcome"; }
+    std::string description() const override { return "Outcome task"; }
+
+private:
+    const bool& fail_;
+};
+
+class TriggerTraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "trigger_trace_test";
+        std::filesystem::create_directories(test_dir_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    // Hook with two tasks, the second failing on demand
+    Hook& add_hook(HookManager& manager, std::uintptr_t address) {
+        EXPECT_TRUE(manager.add_task_to_hook(address, std::make_unique<OutcomeTask>(never_fail_)).has_value());
+        EXPECT_TRUE(manager.add_task_to_hook(address, std::make_unique<OutcomeTask>(fail_)).has_value());
+        auto* hook = manager.get_hook(address);
+        hook->set_trampoline(&trampoline_target_);
+        return *hook;
+    }
+
+    static TriggerTrace sample_trace() {
+        TriggerTrace trace;
+        trace.frequency = 1'000'000;
+        trace.dropped = 3;
+        trace.hooks = {{0x401000, 2, TriggerPolicy::always, 0, 1}, {0x402000, 1, TriggerPolicy::every_n, 0, 2}};
+        trace.records = {{10, 0x401000, 7, 5, 0}, {20, 0x402000, 8, 4, task_outcome_bit(0)},
+                         {30, 0x402000, 8, 0, kTriggerSkipped}, {40, 0x402000, 8, 4, 0}};
+        return trace;
+    }
+
+    std::filesystem::path test_dir_;
+    int trampoline_target_ = 0;
+    bool never_fail_ = false;
+    bool fail_ = false;
+};
+
+TEST_F(TriggerTraceTest, OutcomeBitsSaturateAtTheLastTask) {
+    EXPECT_EQ(task_outcome_bit(0), 1u);
+    EXPECT_EQ(task_outcome_bit(5), 1u << 5);
+    EXPECT_EQ(task_outcome_bit(30), 1u << 30);
+    EXPECT_EQ(task_outcome_bit(100), 1u << 30);
+    EXPECT_EQ(task_outcome_bit(100) & kTriggerSkipped, 0u);
+}
+
+TEST_F(TriggerTraceTest, RecordsDispatchedTriggers) {
+    HookManager manager;
+    auto& hook = add_hook(manager, 0x401000);
+
+    // Triggers before start() are not recorded
+    EXPECT_EQ(dispatch_hook(&hook), &trampoline_target_);
+    ASSERT_TRUE(manager.recorder().start(16));
+    EXPECT_FALSE(manager.recorder().start(16));
+
+    EXPECT_EQ(dispatch_hook(&hook), &trampoline_target_);
+    fail_ = true;
+    EXPECT_EQ(dispatch_hook(&hook), &trampoline_target_);
+
+    const auto trace = manager.recorder().stop({});
+    EXPECT_FALSE(manager.recorder().recording());
+    ASSERT_EQ(trace.records.size(), 2u);
+    EXPECT_EQ(trace.records[0].address, 0x401000u);
+    EXPECT_EQ(trace.records[0].outcome, 0u);
+    EXPECT_EQ(trace.records[1].outcome, task_outcome_bit(1));
+    EXPECT_LE(trace.records[0].time, trace.records[1].time);
+    EXPECT_EQ(trace.records[0].thread_id, trace.records[1].thread_id);
+    EXPECT_GT(trace.frequency, 0u);
+}
+
+TEST_F(TriggerTraceTest, RecordsSkippedTriggers) {
+    HookManager manager;
+    auto& hook = add_hook(manager, 0x401000);
+    hook.set_policy(TriggerPolicy::every_n, 2);
+    ASSERT_TRUE(manager.recorder().start(16));
+
+    for (int i = 0; i < 4; ++i) {
+        (void)dispatch_hook(&hook);
+    }
+
+    const auto trace = manager.recorder().stop({});
+    ASSERT_EQ(trace.records.size(), 4u);
+    EXPECT_EQ(trace.records[0].outcome, 0u);
+    EXPECT_EQ(trace.records[1].outcome, kTriggerSkipped);
+    EXPECT_EQ(trace.records[1].duration, 0u);
+    EXPECT_EQ(trace.records[2].outcome, 0u);
+    EXPECT_EQ(trace.records[3].outcome, kTriggerSkipped);
+}
+
+TEST_F(TriggerTraceTest, CountsTriggersPastTheCapacity) {
+    HookManager manager;
+    auto& hook = add_hook(manager, 0x401000);
+    ASSERT_TRUE(manager.recorder().start(2));
+
+    for (int i = 0; i < 5; ++i) {
+        (void)dispatch_hook(&hook);
+    }
+
+    const auto trace = manager.recorder().stop({});
+    EXPECT_EQ(trace.records.size(), 2u);
+    EXPECT_EQ(trace.dropped, 3u);
+}
+
+TEST_F(TriggerTraceTest, WriteTraceStoresTheHookTable) {
+    HookManager manager;
+    (void)add_hook(manager, 0x401000);
+    auto& every_other = add_hook(manager, 0x402000);
+    every_other.set_policy(TriggerPolicy::every_n, 2);
+    ASSERT_TRUE(manager.recorder().start(16));
+    (void)dispatch_hook(&every_other);
+
+    const auto path = test_dir_ / "session.trace";
+    ASSERT_TRUE(manager.write_trace(path).has_value());
+
+    auto trace = TriggerTrace::read(path);
+    ASSERT_TRUE(trace.has_value());
+    ASSERT_EQ(trace->hooks.size(), 2u);
+    EXPECT_EQ(trace->hooks[0].address, 0x401000u);
+    EXPECT_EQ(trace->hooks[0].tasks, 2u);
+    EXPECT_EQ(trace->hooks[1].policy, TriggerPolicy::every_n);
+    EXPECT_EQ(trace->hooks[1].period, 2u);
+    ASSERT_EQ(trace->records.size(), 1u);
+    EXPECT_EQ(trace->records[0].address, 0x402000u);
+}
+
+TEST_F(TriggerTraceTest, RoundTripsThroughAFile) {
+    const auto path = test_dir_ / "nested" / "sample.trace";
+    const auto written = sample_trace();
+    ASSERT_TRUE(written.write(path).has_value());
+
+    auto read = TriggerTrace::read(path);
+    ASSERT_TRUE(read.has_value());
+    EXPECT_EQ(read->frequency, written.frequency);
+    EXPECT_EQ(read->dropped, 3u);
+    ASSERT_EQ(read->hooks.size(), 2u);
+    EXPECT_EQ(read->hooks[1].period, 2u);
+    ASSERT_EQ(read->records.size(), 4u);
+    EXPECT_EQ(read->records[1].outcome, task_outcome_bit(0));
+    EXPECT_EQ(read->records[2].thread_id, 8u);
+    EXPECT_EQ(read->threads(), (std::vector<std::uint32_t>{7, 8}));
+}
+
+TEST_F(TriggerTraceTest, RejectsDamagedFiles) {
+    EXPECT_EQ(TriggerTrace::read(test_dir_ / "missing.trace").error(), TraceError::file_not_found);
+
+    const auto foreign = test_dir_ / "foreign.trace";
+    std::ofstream(foreign, std::ios::binary) << std::string(64, 'x');
+    EXPECT_EQ(TriggerTrace::read(foreign).error(), TraceError::bad_magic);
+
+    // A header declaring more records than the file holds
+    const auto path = test_dir_ / "cut.trace";
+    ASSERT_TRUE(sample_trace().write(path).has_value());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    EXPECT_EQ(TriggerTrace::read(path).error(), TraceError::truncated);
+
+    std::filesystem::resize_file(path, 10);
+    EXPECT_EQ(TriggerTrace::read(path).error(), TraceError::truncated);
+}
+
+TEST_F(TriggerTraceTest, ReplayReproducesTheRecording) {
+    const auto trace = sample_trace();
+    TraceReplayer replayer(trace);
+    auto* always = replayer.manager().get_hook(0x401000);
+    auto* every_other = replayer.manager().get_hook(0x402000);
+    ASSERT_NE(always, nullptr);
+    ASSERT_NE(every_other, nullptr);
+    EXPECT_EQ(always->task_count(), 2u);
+    EXPECT_EQ(every_other->policy(), TriggerPolicy::every_n);
+
+    const auto result = replayer.run();
+    EXPECT_EQ(result.threads, 2u);
+    EXPECT_EQ(result.triggers, 4u);
+    EXPECT_EQ(result.mismatches, 0u);
+    EXPECT_EQ(always->stats().tasks[0].timing.calls, 1u);
+    EXPECT_EQ(every_other->stats().tasks[0].timing.calls, 2u);
+    EXPECT_EQ(every_other->stats().tasks[0].timing.failures, 1u);
+
+    // Without a reset the every_n gate is mid-period, so the skips no longer line up
+    EXPECT_EQ(replayer.run().mismatches, 3u);
+
+    replayer.reset();
+    EXPECT_EQ(replayer.run().mismatches, 0u);
+    EXPECT_EQ(always->stats().tasks[0].timing.calls, 1u);
+}
+
+TEST_F(TriggerTraceTest, ReplayFlagsPolicyChanges) {
+    auto trace = sample_trace();
+    trace.hooks[1].policy = TriggerPolicy::always;
+    trace.hooks[1].period = 1;
+
+    TraceReplayer replayer(trace);
+    EXPECT_EQ(replayer.run().mismatches, 1u);
+}
+
+} // namespace app_hook::hook
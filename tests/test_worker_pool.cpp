@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include "util/worker_pool.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace app_hook::util {
+
+TEST(WorkerPoolTest, RunsSubmittedJobs) {
+    WorkerPool pool(2);
+    std::atomic<int> counter{0};
+    
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(pool.submit(static_cast<std::size_t>(i), [&counter] { ++counter; }));
+    }
+    pool.wait_idle();
+    
+    EXPECT_EQ(counter.load(), 100);
+    EXPECT_EQ(pool.pending(), 0u);
+}
+
+TEST(WorkerPoolTest, SameAffinityRunsInOrderOnOneThread) {
+    WorkerPool pool(4);
+    std::vector<int> order;
+    std::vector<std::thread::id> threads;
+    
+    for (int i = 0; i < 50; ++i) {
+        ASSERT_TRUE(pool.submit(0x401000, [&order, &threads, i] {
+            order.push_back(i);
+            threads.push_back(std::this_thread::get_id());
+        }));
+    }
+    pool.wait_idle();
+    
+    ASSERT_EQ(order.size(), 50u);
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_EQ(order[i], i);
+        EXPECT_EQ(threads[i], threads[0]);
+    }
+    EXPECT_NE(threads[0], std::this_thread::get_id());
+}
+
+TEST(WorkerPoolTest, StopRunsPendingJobsAndRejectsNewOnes) {
+    WorkerPool pool(1);
+    std::atomic<int> counter{0};
+    
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(pool.submit(0, [&counter] { ++counter; }));
+    }
+    pool.stop();
+    
+    EXPECT_EQ(counter.load(), 10);
+    EXPECT_FALSE(pool.submit(0, [&counter] { ++counter; }));
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(WorkerPoolTest, ThrowingJobDoesNotStopWorker) {
+    WorkerPool pool(1);
+    std::atomic<int> counter{0};
+    
+    ASSERT_TRUE(pool.submit(0, [] { throw std::runtime_error("job failed"); }));
+    ASSERT_TRUE(pool.submit(0, [&counter] { ++counter; }));
+    pool.wait_idle();
+    
+    EXPECT_EQ(counter.load(), 1);
+}
+
+TEST(WorkerPoolTest, ForEachIndexRunsEveryIndexOnce) {
+    WorkerPool pool(4);
+    std::vector<std::atomic<int>> hits(64);
+    
+    pool.for_each_index(hits.size(), [&hits](std::size_t i) { ++hits[i]; });
+    
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+    EXPECT_EQ(pool.pending(), 0u);
+}
+
+TEST(WorkerPoolTest, ForEachIndexReturnsWhenBodyThrows) {
+    WorkerPool pool(2);
+    std::atomic<int> counter{0};
+    
+    pool.for_each_index(8, [&counter](std::size_t i) {
+        if (i == 3) {
+            throw std::runtime_error("index failed");
+        }
+        ++counter;
+    });
+    
+    EXPECT_EQ(counter.load(), 7);
+}
+
+TEST(WorkerPoolTest, ForEachIndexRunsInlineWhenStopped) {
+    WorkerPool pool(1);
+    pool.stop();
+    std::vector<std::thread::id> threads(4);
+    
+    pool.for_each_index(threads.size(), [&threads](std::size_t i) { threads[i] = std::this_thread::get_id(); });
+    
+    for (const auto& id : threads) {
+        EXPECT_EQ(id, std::this_thread::get_id());
+    }
+}
+
+TEST(WorkerPoolTest, DefaultThreadCountIsBounded) {
+    WorkerPool pool;
+    EXPECT_GE(pool.thread_count(), 1u);
+    EXPECT_LE(pool.thread_count(), 4u);
+}
+
+} // namespace app_hook::util